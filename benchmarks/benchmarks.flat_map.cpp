@@ -1,21 +1,37 @@
 #include <algorithm>
 #include <cstdint>
+#include <functional>
 #include <iterator>
 #include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <random>
+#include <ranges>
+#include <sstream>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include <vault/algorithm/amac.hpp>
+#include <vault/algorithm/amac_coroutine.hpp>
+#include <vault/algorithm/amac_sinks.hpp>
+#include <vault/algorithm/parallel_amac.hpp>
+#include <vault/algorithm/perf_counters.hpp>
+#include <vault/executor/thread_executor.hpp>
 #include <vault/flat_map/aliases.hpp>
 #include <vault/flat_map/eytzinger_layout_policy.hpp>
 #include <vault/flat_map/implicit_btree_layout_policy.hpp>
+#include <vault/flat_map/layout_tuner.hpp>
+#include <vault/flat_map/numa_replicated_map.hpp>
 #include <vault/flat_map/sorted_layout_policy.hpp>
 
+#include "benchmarks.hpp"
+
 using namespace eytzinger;
 
 // ============================================================================
@@ -25,6 +41,7 @@ using namespace eytzinger;
 // --- Constants ---
 static constexpr size_t kNumNeedles     = 2048;
 static constexpr size_t kAMACBufferSize = 16;
+static constexpr size_t kScanLength     = 1024;
 
 // --- Random Data Generators ---
 
@@ -112,6 +129,59 @@ struct OpBatchFind {
   }
 };
 
+// Strategy: Batch Find with results in needle order, written out a cache
+// line at a time
+struct OpOrderedBatchFind {
+  static std::string name() { return "OrderedBatch/Find"; }
+
+  template <typename Map, typename Needles, typename Results>
+  static void run(const Map& map, const Needles& needles, Results& results)
+  {
+    using Result = typename Results::value_type;
+
+    results.resize(needles.size());
+    vault::amac::streaming_sink<Result> stream(results.data());
+
+    auto sequence = [&](const Result& r) { return r.first - needles.begin(); };
+    vault::amac::reorder_buffer<Result,
+      decltype(sequence),
+      std::reference_wrapper<decltype(stream)>>
+      in_order(sequence, std::ref(stream));
+
+    map.batch_find(vault::amac::coordinator<kAMACBufferSize>,
+      needles,
+      vault::amac::sink_iterator(in_order));
+  }
+};
+
+// Strategy: Batch Find with an adaptive number of jobs in flight
+struct OpAdaptiveBatchFind {
+  static std::string name() { return "AdaptiveBatch/Find"; }
+
+  template <typename Map, typename Needles, typename Results>
+  static void run(const Map& map, const Needles& needles, Results& results)
+  {
+    map.batch_find(vault::amac::adaptive_coordinator<32>,
+      needles,
+      std::back_inserter(results));
+  }
+};
+
+// Strategy: Batch Find on every core. The needles of one run are few, so
+// this mostly shows the cost of forking the workers.
+struct OpParallelBatchFind {
+  static std::string name() { return "ParallelBatch/Find"; }
+
+  template <typename Map, typename Needles, typename Results>
+  static void run(const Map& map, const Needles& needles, Results& results)
+  {
+    map.batch_find(vault::amac::parallel_coordinator<kAMACBufferSize>{
+                     vault::algorithm::thread_executor{}, 256},
+      needles,
+      std::back_inserter(results));
+  }
+};
+
 // Strategy: Batch Lower Bound
 struct OpBatchLowerBound {
   static std::string name() { return "Batch/LowerBound"; }
@@ -138,6 +208,19 @@ struct OpBatchUpperBound {
   }
 };
 
+// Strategy: Sorted Lower Bound (needles sorted, as in a merge join)
+struct OpSortedLowerBound {
+  static std::string name() { return "Sorted/LowerBound"; }
+
+  static constexpr bool sorted_needles = true;
+
+  template <typename Map, typename Needles, typename Results>
+  static void run(const Map& map, const Needles& needles, Results& results)
+  {
+    map.lower_bound_sorted(needles, std::back_inserter(results));
+  }
+};
+
 // ============================================================================
 //  3. Core Benchmark Templates
 // ============================================================================
@@ -163,6 +246,9 @@ static void BM_Lookup(benchmark::State& state)
 
   // 2. Prepare Needles
   auto needles = DataGenerator<KeyT>::generate(kNumNeedles, 123);
+  if constexpr (requires { Operation::sorted_needles; }) {
+    std::ranges::sort(needles);
+  }
 
   // Result storage to prevent optimization
   using NeedleIter = typename std::vector<KeyT>::const_iterator;
@@ -180,6 +266,275 @@ static void BM_Lookup(benchmark::State& state)
   state.SetItemsProcessed(state.iterations() * kNumNeedles);
 }
 
+/**
+ * @brief Benchmark for Range Scans of about kScanLength keys, either with
+ * iterators from lower_bound or with for_each_in_range.
+ */
+template <typename LayoutPolicy, typename KeyT, bool Bulk>
+static void BM_RangeScan(benchmark::State& state)
+{
+  const size_t n = state.range(0);
+
+  auto                              keys = DataGenerator<KeyT>::generate(n);
+  std::vector<std::pair<KeyT, int>> pairs;
+  pairs.reserve(keys.size());
+  for (const auto& k : keys) {
+    pairs.emplace_back(k, 1);
+  }
+
+  using MapType = layout_map<KeyT, int, std::less<KeyT>, LayoutPolicy>;
+  MapType map(pairs.begin(), pairs.end());
+
+  // Bounds of ranges at random positions, taken from the sorted keys.
+  std::ranges::sort(keys);
+  const size_t length = std::min(kScanLength, keys.size() - 1);
+
+  std::mt19937_64                       rng(123);
+  std::uniform_int_distribution<size_t> dist(0, keys.size() - 1 - length);
+  std::vector<std::pair<KeyT, KeyT>>    ranges;
+  for (size_t i = 0; i < 64; ++i) {
+    const size_t first = dist(rng);
+    ranges.emplace_back(keys[first], keys[first + length]);
+  }
+
+  size_t idx = 0;
+  for (auto _ : state) {
+    const auto& [lo, hi] = ranges[idx];
+    int         sum      = 0;
+    if constexpr (Bulk) {
+      map.for_each_in_range(
+        lo, hi, [&](const KeyT&, const int& v) { sum += v; });
+    } else {
+      for (auto it = map.lower_bound(lo), last = map.lower_bound(hi);
+        it != last;
+        ++it) {
+        sum += it->second;
+      }
+    }
+    benchmark::DoNotOptimize(sum);
+
+    if (++idx == ranges.size()) {
+      idx = 0;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * length);
+}
+
+/**
+ * @brief Benchmark for Lookups from every CPU, in one shared copy of the map
+ * or in the replica on the NUMA node of the thread.
+ *
+ * Run on a multi-socket host; with a single node both variants read the
+ * same copy.
+ */
+template <bool Replicated> static void BM_NumaLookup(benchmark::State& state)
+{
+  using MapType = numa_btree_map<int64_t, int>;
+
+  const size_t n = state.range(0);
+
+  // Built once per size and shared by the threads of the run, outside of
+  // the timed region of every one of them.
+  static std::mutex                                  mutex;
+  static std::map<size_t, std::unique_ptr<MapType>> maps;
+
+  const MapType* map = nullptr;
+  {
+    std::scoped_lock lock(mutex);
+    auto&            slot = maps[n];
+    if (!slot) {
+      auto keys = DataGenerator<int64_t>::generate(n);
+
+      std::vector<std::pair<int64_t, int>> pairs;
+      pairs.reserve(n);
+      for (const auto& k : keys) {
+        pairs.emplace_back(k, 0);
+      }
+      slot = std::make_unique<MapType>(
+        MapType::map_type(pairs.begin(), pairs.end()));
+    }
+    map = slot.get();
+  }
+
+  auto needles = DataGenerator<int64_t>::generate(
+    kNumNeedles, 123 + static_cast<uint64_t>(state.thread_index()));
+
+  for (auto _ : state) {
+    const auto& replica = Replicated ? map->local() : map->replica(0);
+    for (const auto& needle : needles) {
+      benchmark::DoNotOptimize(replica.find(needle));
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumNeedles);
+  state.counters["replicas"] = static_cast<double>(map->replica_count());
+}
+
+/**
+ * @brief Runs the layout tuner for maps of n random keys, and reports the
+ * fastest configuration on this host against the default of btree_map.
+ *
+ * The label holds the winning configuration as written by layout_config's
+ * operator<<.
+ */
+template <typename KeyT> static void BM_LayoutTuner(benchmark::State& state)
+{
+  const size_t n    = state.range(0);
+  auto         keys = DataGenerator<KeyT>::generate(n);
+
+  std::vector<layout_config> results;
+  for (auto _ : state) {
+    results = tune_layout<KeyT>(keys);
+  }
+
+  const auto default_config = std::ranges::find_if(results, [](const auto& c) {
+    return c.layout == layout_kind::btree
+      && c.block_size == detail::calculate_optimal_block_size<KeyT>()
+      && c.amac_fanout == 0;
+  });
+
+  std::ostringstream best;
+  best << results.front();
+  state.SetLabel(best.str());
+  state.counters["best_ns"]    = results.front().ns_per_lookup;
+  state.counters["default_ns"] = default_config->ns_per_lookup;
+}
+
+/**
+ * @brief AMAC lower bounds over an Eytzinger array, with the hand-written
+ * search_job of the policy or with the same descent as a coroutine_job.
+ *
+ * Both yield at the same nodes and end at the same index, so the
+ * difference is the cost of resuming a coroutine frame instead of calling
+ * step().
+ */
+template <typename KeyT, bool Coroutine>
+static void BM_AMACJob(benchmark::State& state)
+{
+  using Policy  = eytzinger::eytzinger_layout_policy<6>;
+  using MapType = layout_map<KeyT, int, std::less<KeyT>, Policy>;
+
+  const size_t n    = state.range(0);
+  auto         keys = DataGenerator<KeyT>::generate(n);
+  std::vector<std::pair<KeyT, int>> pairs;
+  pairs.reserve(keys.size());
+  for (const auto& k : keys) {
+    pairs.emplace_back(k, 0);
+  }
+
+  MapType     map(pairs.begin(), pairs.end());
+  const auto& haystack = map.unordered_keys();
+  const auto  needles  = DataGenerator<KeyT>::generate(kNumNeedles, 123);
+
+  // The descent of Policy::search_job, written as a coroutine.
+  auto descend = [&](const KeyT& needle)
+    -> vault::amac::coroutine_job<std::size_t> {
+    constexpr std::uintptr_t line = 64;
+
+    const KeyT* base = std::to_address(haystack.begin());
+    std::size_t i    = 0;
+    if (haystack.empty()) {
+      co_return i;
+    }
+    co_await vault::amac::prefetch(base);
+
+    const KeyT* node = base;
+    while (true) {
+      i = (i << 1) + 1 + static_cast<std::size_t>(*node < needle);
+      if (i >= haystack.size()) {
+        co_return i;
+      }
+      const KeyT* next = base + i;
+      if (reinterpret_cast<std::uintptr_t>(next) / line
+        != reinterpret_cast<std::uintptr_t>(node) / line) {
+        co_await vault::amac::prefetch(next);
+      }
+      node = next;
+    }
+  };
+
+  auto search = [&](auto needle) {
+    return Policy::lower_bound_job(haystack, std::less<KeyT>{}, needle);
+  };
+
+  std::size_t sum = 0;
+  for (auto _ : state) {
+    if constexpr (Coroutine) {
+      vault::amac::coordinator<kAMACBufferSize>(
+        needles | std::views::transform(descend),
+        [&](auto&& job) { sum += job.result(); });
+    } else {
+      vault::amac::coordinator<kAMACBufferSize>(
+        std::views::iota(needles.begin(), needles.end())
+          | std::views::transform(search),
+        [&](auto&& job) { sum += job.i; });
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumNeedles);
+}
+
+/**
+ * @brief Batch finds with a coordinator that records stats, exposed as
+ * counters per lookup: the average of jobs in flight, the steps and
+ * prefetches of a job, and the hardware counters perf_event_open allows.
+ *
+ * Run across TotalFanout values, they show where adding jobs in flight
+ * stops paying off and why.
+ */
+template <typename LayoutPolicy, uint8_t TotalFanout>
+static void BM_AMACStats(benchmark::State& state)
+{
+  using KeyT    = int64_t;
+  using MapType = layout_map<KeyT, int, std::less<KeyT>, LayoutPolicy>;
+  using perf    = vault::algorithm::perf_counters;
+
+  const size_t n    = state.range(0);
+  auto         keys = DataGenerator<KeyT>::generate(n);
+  std::vector<std::pair<KeyT, int>> pairs;
+  pairs.reserve(keys.size());
+  for (const auto& k : keys) {
+    pairs.emplace_back(k, 0);
+  }
+
+  MapType map(pairs.begin(), pairs.end());
+  auto    needles = DataGenerator<KeyT>::generate(kNumNeedles, 123);
+
+  using NeedleIter = typename std::vector<KeyT>::const_iterator;
+  using MapIter    = typename MapType::const_iterator;
+  std::vector<std::pair<NeedleIter, MapIter>> results;
+  results.reserve(kNumNeedles);
+
+  perf                           counters;
+  vault::amac::coordinator_stats stats{.hardware = &counters};
+
+  auto coordinator = [&](auto&& jobs, auto&& reporter) {
+    vault::amac::coordinator<TotalFanout>(jobs, reporter, stats);
+  };
+
+  for (auto _ : state) {
+    results.clear();
+    map.batch_find(
+      coordinator, std::as_const(needles), std::back_inserter(results));
+    benchmark::DoNotOptimize(results.data());
+  }
+
+  state.SetItemsProcessed(state.iterations() * kNumNeedles);
+  state.counters["live_jobs"]  = stats.average_live_jobs();
+  state.counters["steps"]      = stats.steps_per_job();
+  state.counters["prefetches"] = stats.prefetches_per_job();
+  for (auto e : {perf::cycles,
+         perf::instructions,
+         perf::l1d_misses,
+         perf::fill_buffer_full_cycles}) {
+    if (counters.available(e)) {
+      state.counters[std::string(perf::name(e))] = stats.hardware_per_job(e);
+    }
+  }
+}
+
 /**
  * @brief Benchmark for StringView Arena Lookups (Data Locality Test).
  */
@@ -233,14 +588,45 @@ static void BM_Construction(benchmark::State& state)
     pairs.emplace_back(k, 0);
   }
 
+  using Allocator = static_data::stats_allocator<std::pair<const KeyT, int>>;
+  using MapType   = layout_map<KeyT, int, std::less<KeyT>, LayoutPolicy, Allocator>;
+
+  static_data::allocation_stats stats;
+  for (auto _ : state) {
+    auto    local_pairs = pairs; // Copy to simulate fresh input
+    MapType map(local_pairs.begin(), local_pairs.end(), Allocator(stats));
+    benchmark::DoNotOptimize(map);
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+  report_allocations(state, stats);
+}
+
+/**
+ * @brief Benchmark: Construction Cost on all cores
+ */
+template <typename LayoutPolicy, typename KeyT>
+static void BM_ParallelConstruction(benchmark::State& state)
+{
+  const size_t n    = state.range(0);
+  auto         keys = DataGenerator<KeyT>::generate(n);
+
+  std::vector<std::pair<KeyT, int>> pairs;
+  pairs.reserve(n);
+  for (const auto& k : keys) {
+    pairs.emplace_back(k, 0);
+  }
+
   using MapType = layout_map<KeyT, int, std::less<KeyT>, LayoutPolicy>;
 
+  const auto executor = vault::algorithm::thread_executor{};
+
   for (auto _ : state) {
     auto    local_pairs = pairs; // Copy to simulate fresh input
-    MapType map(local_pairs.begin(), local_pairs.end());
+    MapType map(executor, local_pairs.begin(), local_pairs.end());
     benchmark::DoNotOptimize(map);
   }
   state.SetItemsProcessed(state.iterations() * n);
+  state.counters["threads"] = static_cast<double>(executor.concurrency());
 }
 
 // ============================================================================
@@ -262,14 +648,27 @@ static void BM_Construction(benchmark::State& state)
 
 #define REGISTER_CONSTRUCT(LayoutName, LayoutType, KeyName, KeyType)           \
   BENCHMARK_TEMPLATE(BM_Construction, LayoutType, KeyType)                     \
-  ARGS_CONSTRUCT->Name(LayoutName "/" KeyName "/Construct");
+  ARGS_CONSTRUCT->Name(LayoutName "/" KeyName "/Construct");                   \
+  BENCHMARK_TEMPLATE(BM_ParallelConstruction, LayoutType, KeyType)             \
+  ARGS_CONSTRUCT->Name(LayoutName "/" KeyName "/ParallelConstruct");
+
+#define REGISTER_SCAN(LayoutName, LayoutType, KeyName, KeyType)                \
+  BENCHMARK_TEMPLATE(BM_RangeScan, LayoutType, KeyType, false)                 \
+  ARGS_LOOKUP->Name(LayoutName "/" KeyName "/Scan/Iterator");                  \
+  BENCHMARK_TEMPLATE(BM_RangeScan, LayoutType, KeyType, true)                  \
+  ARGS_LOOKUP->Name(LayoutName "/" KeyName "/Scan/ForEachInRange");
 
 // Register all operations for a specific Layout + Key combination
 #define REGISTER_ALL_OPS(LayoutName, LayoutType, KeyName, KeyType)             \
   REGISTER_OP(LayoutName, LayoutType, KeyName, KeyType, OpSerialFind)          \
   REGISTER_OP(LayoutName, LayoutType, KeyName, KeyType, OpBatchFind)           \
+  REGISTER_OP(LayoutName, LayoutType, KeyName, KeyType, OpAdaptiveBatchFind)   \
+  REGISTER_OP(LayoutName, LayoutType, KeyName, KeyType, OpOrderedBatchFind)    \
+  REGISTER_OP(LayoutName, LayoutType, KeyName, KeyType, OpParallelBatchFind)   \
   REGISTER_OP(LayoutName, LayoutType, KeyName, KeyType, OpBatchLowerBound)     \
   REGISTER_OP(LayoutName, LayoutType, KeyName, KeyType, OpBatchUpperBound)     \
+  REGISTER_OP(LayoutName, LayoutType, KeyName, KeyType, OpSortedLowerBound)    \
+  REGISTER_SCAN(LayoutName, LayoutType, KeyName, KeyType)                      \
   REGISTER_CONSTRUCT(LayoutName, LayoutType, KeyName, KeyType)
 
 // Register for all standard integer types
@@ -345,4 +744,77 @@ BENCHMARK_TEMPLATE(BM_StringView_Arena, MapBTree)
   ->Unit(benchmark::kNanosecond)
   ->Name("ArenaView/BTree/SerialFind");
 
-BENCHMARK_MAIN();
+// --- E. NUMA Replicas ---
+
+BENCHMARK_TEMPLATE(BM_NumaLookup, false)
+  ->RangeMultiplier(16)
+  ->Range(1 << 16, 1 << 24)
+  ->ThreadPerCpu()
+  ->UseRealTime()
+  ->Unit(benchmark::kNanosecond)
+  ->Name("NUMA/BTree/int64/Shared");
+
+BENCHMARK_TEMPLATE(BM_NumaLookup, true)
+  ->RangeMultiplier(16)
+  ->Range(1 << 16, 1 << 24)
+  ->ThreadPerCpu()
+  ->UseRealTime()
+  ->Unit(benchmark::kNanosecond)
+  ->Name("NUMA/BTree/int64/Replicated");
+
+// --- F. Layout Tuner ---
+
+BENCHMARK_TEMPLATE(BM_LayoutTuner, int32_t)
+  ->RangeMultiplier(64)
+  ->Range(1 << 12, 1 << 24)
+  ->Iterations(1)
+  ->Unit(benchmark::kMillisecond)
+  ->Name("Tuner/int32");
+
+BENCHMARK_TEMPLATE(BM_LayoutTuner, int64_t)
+  ->RangeMultiplier(64)
+  ->Range(1 << 12, 1 << 24)
+  ->Iterations(1)
+  ->Unit(benchmark::kMillisecond)
+  ->Name("Tuner/int64");
+
+// --- G. Coroutine AMAC Jobs ---
+
+BENCHMARK_TEMPLATE(BM_AMACJob, int64_t, false)
+  ARGS_LOOKUP
+  ->Name("AMACJob/Eytzinger/int64/Handwritten");
+
+BENCHMARK_TEMPLATE(BM_AMACJob, int64_t, true)
+  ARGS_LOOKUP
+  ->Name("AMACJob/Eytzinger/int64/Coroutine");
+
+// --- H. AMAC Stats ---
+
+#define REGISTER_AMAC_STATS(LayoutName, LayoutType, Fanout)                    \
+  BENCHMARK_TEMPLATE(BM_AMACStats, LayoutType, Fanout)                         \
+  ARGS_LOOKUP->Name("AMACStats/" LayoutName "/int64/Fanout" #Fanout);
+
+REGISTER_AMAC_STATS("Eytzinger", EytzingerDefault, 4)
+REGISTER_AMAC_STATS("Eytzinger", EytzingerDefault, 8)
+REGISTER_AMAC_STATS("Eytzinger", EytzingerDefault, 16)
+REGISTER_AMAC_STATS("Eytzinger", EytzingerDefault, 32)
+REGISTER_AMAC_STATS("BTree", BTreeDefault, 4)
+REGISTER_AMAC_STATS("BTree", BTreeDefault, 8)
+REGISTER_AMAC_STATS("BTree", BTreeDefault, 16)
+REGISTER_AMAC_STATS("BTree", BTreeDefault, 32)
+
+// The context of every run names the block search kernels the B-tree layout
+// selected on this host, so results from different machines compare.
+int main(int argc, char** argv)
+{
+  benchmark::AddCustomContext(
+    "btree_block_search", std::string(eytzinger::block_search_isa()));
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
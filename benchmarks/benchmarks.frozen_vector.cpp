@@ -5,6 +5,11 @@
 
 #include <benchmark/benchmark.h>
 
+#include "benchmarks.hpp"
+
+#include <vault/allocators/hpallocator.hpp>
+#include <vault/allocators/hugepage_pool.hpp>
+#include <vault/frozen_vector/arena_storage_policy.hpp>
 #include <vault/frozen_vector/frozen_vector.hpp>
 #include <vault/frozen_vector/frozen_vector_builder.hpp>
 #include <vault/frozen_vector/local_shared_storage_policy.hpp>
@@ -145,6 +150,96 @@ template <typename VectorType> static void BM_InterleavedWork(benchmark::State&
   }
 }
 
+// ============================================================================
+// BENCHMARK: Periodic Rebuild (Huge Page Allocation Cost)
+// Purpose: A service that rebuilds its frozen data every few minutes maps,
+// faults in and frees every large buffer on every rebuild with hpallocator.
+// The pooled allocator hands the last rebuild's buffer back already faulted
+// in.
+// ============================================================================
+
+template <typename Alloc> static void BM_Rebuild(benchmark::State& state) {
+  using CountingAlloc = static_data::stats_allocator<int, Alloc>;
+
+  size_t                        N = state.range(0);
+  static_data::allocation_stats stats;
+  for (auto _ : state) {
+    frozen_vector_builder<int, shared_storage_policy<int>, CountingAlloc> builder(N, CountingAlloc(stats));
+    std::iota(builder.begin(), builder.end(), 0);
+    auto frozen = std::move(builder).freeze();
+    benchmark::DoNotOptimize(frozen.data());
+  }
+  state.SetBytesProcessed(state.iterations() * N * sizeof(int));
+  report_allocations(state, stats);
+}
+
+// ============================================================================
+// BENCHMARK: Bulk Build (Value-Initialized vs Uninitialized Growth)
+// Purpose: resize() zeroes every element before the caller overwrites it, so
+// every page is written twice. append_uninitialized() hands out storage that
+// is first written by the caller.
+// ============================================================================
+
+template <bool Uninitialized> static void BM_BulkBuild(benchmark::State& state) {
+  using Builder = frozen_vector_builder<int, shared_storage_policy<int>, static_data::hpallocator<int>>;
+
+  size_t N = state.range(0);
+  for (auto _ : state) {
+    Builder builder;
+    int*    data = nullptr;
+    if constexpr (Uninitialized) {
+      data = builder.append_uninitialized(N);
+    } else {
+      builder.resize(N);
+      data = builder.data();
+    }
+    std::iota(data, data + N, 0);
+    auto frozen = std::move(builder).freeze();
+    benchmark::DoNotOptimize(frozen.data());
+  }
+  state.SetBytesProcessed(state.iterations() * N * sizeof(int));
+}
+
+// ============================================================================
+// BENCHMARK: Many Small Vectors (Heap vs Arena)
+// Purpose: A request that builds a small frozen vector per row group pays a
+// heap block and a control block per vector, and frees them one by one. An
+// arena carves them all from a few slabs, freed with the last vector.
+// ============================================================================
+
+struct HeapStorage {
+  using Builder = frozen_vector_builder<int, shared_storage_policy<int>>;
+
+  static Builder make_builder() { return Builder(); }
+};
+
+struct ArenaStorage {
+  using Builder = frozen_vector_builder<int, arena_storage_policy<int>, arena_allocator<int>>;
+
+  std::shared_ptr<frozen_arena> arena = std::make_shared<frozen_arena>();
+
+  Builder make_builder() const { return Builder(arena_allocator<int>(arena)); }
+};
+
+template <typename Storage> static void BM_ManySmall(benchmark::State& state) {
+  size_t vector_count = state.range(0);
+  for (auto _ : state) {
+    Storage                         storage;
+    std::vector<frozen_vector<int>> vectors;
+    vectors.reserve(vector_count);
+    for (size_t v = 0; v < vector_count; ++v) {
+      auto builder = storage.make_builder();
+      builder.reserve(16);
+      for (int i = 0; i < 16; ++i) {
+        builder.push_back(i);
+      }
+      vectors.push_back(std::move(builder).freeze());
+    }
+    benchmark::DoNotOptimize(vectors.data());
+  }
+  state.SetItemsProcessed(state.iterations() * vector_count);
+}
+
 // ============================================================================
 // REGISTER BENCHMARKS
 // ============================================================================
@@ -161,4 +256,13 @@ BENCHMARK(BM_LocalShared_Construct)->Range(1024, 1024 * 1024);
 BENCHMARK_TEMPLATE(BM_InterleavedWork, AtomicVec);
 BENCHMARK_TEMPLATE(BM_InterleavedWork, LocalVec);
 
+BENCHMARK_TEMPLATE(BM_Rebuild, static_data::hpallocator<int>)->Range(1 << 20, 1 << 24);
+BENCHMARK_TEMPLATE(BM_Rebuild, static_data::pooled_hpallocator<int>)->Range(1 << 20, 1 << 24);
+
+BENCHMARK_TEMPLATE(BM_BulkBuild, false)->Range(1 << 20, 1 << 26);
+BENCHMARK_TEMPLATE(BM_BulkBuild, true)->Range(1 << 20, 1 << 26);
+
+BENCHMARK_TEMPLATE(BM_ManySmall, HeapStorage)->Range(1 << 10, 1 << 14);
+BENCHMARK_TEMPLATE(BM_ManySmall, ArenaStorage)->Range(1 << 10, 1 << 14);
+
 BENCHMARK_MAIN();
@@ -4,14 +4,18 @@
 #include <cmath>
 #include <numeric>
 #include <random>
+#include <span>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 #include <benchmark/benchmark.h>
 
 #include <boost/unordered/unordered_flat_map.hpp>
+#include <vault/algorithm/fsst_decode_cache.hpp>
 #include <vault/algorithm/fsst_dictionary.hpp>
+#include <vault/algorithm/fsst_segmented_dictionary.hpp>
 
 namespace {
 
@@ -114,10 +118,13 @@ namespace {
     });
   }
 
-  // Uses the typed dictionary template
-  template <template <class...> class MapType>
+  // Uses the typed dictionary template. With TypeErased, the generator and the
+  // deduplicator are wrapped in std::function first, as they were before the
+  // template factories existed.
+  template <template <class...> class MapType, bool TypeErased = false>
   auto build_with_map(const std::vector<std::string>&                      inputs,
-                      vault::algorithm::fsst_dictionary_base::sample_ratio ratio = {1.0}) {
+                      vault::algorithm::fsst_dictionary_base::sample_ratio ratio   = {1.0},
+                      vault::algorithm::fsst_dictionary_base::thread_count threads = {1}) {
     auto it  = inputs.begin();
     auto end = inputs.end();
 
@@ -138,12 +145,20 @@ namespace {
       return {iter->second, inserted};
     };
 
-    return vault::algorithm::fsst_dictionary<std::string>::build(std::move(gen), std::move(dedup), ratio);
+    using dictionary_t = vault::algorithm::fsst_dictionary<std::string>;
+    if constexpr (TypeErased) {
+      return dictionary_t::build(dictionary_t::Generator{std::move(gen)},
+                                 dictionary_t::Deduplicator{std::move(dedup)},
+                                 ratio,
+                                 threads);
+    } else {
+      return dictionary_t::build(std::move(gen), std::move(dedup), ratio, threads);
+    }
   }
 
 } // namespace
 
-template <template <typename, typename, typename, typename, typename...> typename MapType>
+template <template <typename, typename, typename, typename, typename...> typename MapType, bool TypeErased = false>
 static void BM_Construction_Map(benchmark::State& state) {
   auto const count     = static_cast<std::size_t>(state.range(0));
   auto const type      = static_cast<int>(state.range(1));
@@ -151,7 +166,7 @@ static void BM_Construction_Map(benchmark::State& state) {
   auto const raw_bytes = total_raw_size(input);
 
   for (auto _ : state) {
-    auto [dict, keys] = build_with_map<MapType>(input);
+    auto [dict, keys] = build_with_map<MapType, TypeErased>(input);
     benchmark::DoNotOptimize(dict);
     benchmark::DoNotOptimize(keys);
 
@@ -195,6 +210,116 @@ static void BM_Lookup_RandomOrder(benchmark::State& state) {
   state.SetBytesProcessed(state.iterations() * raw_bytes);
 }
 
+// Lookups whose keys follow a Zipf distribution (s = 1), as a few hot keys make
+// up most of real traffic. With Cached, they go through an fsst_decode_cache of
+// 1 MiB; the hit ratio is reported.
+template <bool Cached>
+static void BM_Lookup_Zipf(benchmark::State& state) {
+  constexpr auto lookup_count = std::size_t{1'000'000};
+
+  auto const count  = static_cast<std::size_t>(state.range(0));
+  auto const type   = static_cast<int>(state.range(1));
+  auto const input  = generate_data(count, type);
+  auto [dict, keys] = build_with_map<boost::unordered_flat_map>(input);
+  auto rng          = std::mt19937{std::random_device{}()};
+  std::shuffle(keys.begin(), keys.end(), rng);
+
+  auto weights = std::vector<double>{};
+  weights.reserve(keys.size());
+  for (std::size_t i = 1; i <= keys.size(); ++i) {
+    weights.push_back(1.0 / static_cast<double>(i));
+  }
+  auto rank_dist = std::discrete_distribution<std::size_t>(weights.begin(), weights.end());
+  auto lookups   = std::vector<vault::algorithm::fsst_key>{};
+  lookups.reserve(lookup_count);
+  for (std::size_t i = 0; i < lookup_count; ++i) {
+    lookups.push_back(keys[rank_dist(rng)]);
+  }
+
+  auto cache  = vault::algorithm::fsst_decode_cache{dict};
+  auto buffer = std::string{};
+  for (auto _ : state) {
+    for (const auto& key : lookups) {
+      if constexpr (Cached) {
+        benchmark::DoNotOptimize(cache.find(key));
+      } else {
+        benchmark::DoNotOptimize(try_find(dict, key, buffer));
+        benchmark::DoNotOptimize(buffer.data());
+      }
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * lookups.size());
+  if constexpr (Cached) {
+    auto const stats           = cache.stats();
+    state.counters["HitRatio"] = static_cast<double>(stats.hits) / static_cast<double>(stats.hits + stats.misses);
+  }
+}
+
+// The batched counterpart of BM_Lookup_RandomOrder: keys are decoded 1024 at a
+// time through try_find_many, which overlaps the cache misses of several keys.
+static void BM_Lookup_RandomOrder_Batched(benchmark::State& state) {
+  constexpr auto batch_size = std::size_t{1024};
+
+  auto const count     = static_cast<std::size_t>(state.range(0));
+  auto const type      = static_cast<int>(state.range(1));
+  auto const input     = generate_data(count, type);
+  auto const raw_bytes = total_raw_size(input);
+  auto [dict, keys]    = build_with_map<boost::unordered_flat_map>(input);
+  auto rng             = std::mt19937{std::random_device{}()};
+  std::shuffle(keys.begin(), keys.end(), rng);
+  auto const all_keys = std::span<vault::algorithm::fsst_key const>{keys};
+  for (auto _ : state) {
+    for (auto first = std::size_t{0}; first < all_keys.size(); first += batch_size) {
+      auto const batch = all_keys.subspan(first, std::min(batch_size, all_keys.size() - first));
+      try_find_many(dict, batch, [](std::size_t, std::string_view value) { benchmark::DoNotOptimize(value); });
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+  state.SetBytesProcessed(state.iterations() * raw_bytes);
+}
+
+// Counts the URLs with a given prefix, once by comparing compressed bytes
+// through a probe and once by decoding every value and comparing the text.
+template <bool Compressed>
+static void BM_Scan_StartsWith(benchmark::State& state) {
+  auto const count  = static_cast<std::size_t>(state.range(0));
+  auto const input  = generate_urls(count);
+  auto [dict, keys] = build_with_map<boost::unordered_flat_map>(input);
+  auto const prefix = std::string_view{"https://api.github.com/"};
+  auto const probe  = dict.compress_probe(prefix);
+  auto buffer       = std::string{};
+  for (auto _ : state) {
+    auto matches = std::size_t{0};
+    for (const auto& key : keys) {
+      if constexpr (Compressed) {
+        matches += dict.starts_with(key, probe);
+      } else {
+        matches += try_find(dict, key, buffer) && buffer.starts_with(prefix);
+      }
+    }
+    benchmark::DoNotOptimize(matches);
+  }
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+// Deduplication stays on the calling thread; only compression is spread over
+// the workers.
+static void BM_Construction_Parallel(benchmark::State& state) {
+  auto const threads   = vault::algorithm::fsst_dictionary_base::thread_count{static_cast<std::size_t>(state.range(0))};
+  auto const type      = static_cast<int>(state.range(1));
+  std::size_t count    = 1'000'000;
+  auto const input     = generate_data(count, type);
+  auto const raw_bytes = total_raw_size(input);
+
+  for (auto _ : state) {
+    auto [dict, keys] = build_with_map<boost::unordered_flat_map>(input, {1.0}, threads);
+    benchmark::DoNotOptimize(dict);
+    benchmark::DoNotOptimize(keys);
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetBytesProcessed(state.iterations() * raw_bytes);
+}
+
 static void BM_SamplingRatio(benchmark::State& state) {
   auto const                                           denom     = static_cast<double>(state.range(0));
   auto const                                           type      = static_cast<int>(state.range(1));
@@ -214,6 +339,39 @@ static void BM_SamplingRatio(benchmark::State& state) {
   state.SetBytesProcessed(state.iterations() * raw_bytes);
 }
 
+// Compresses a mix of random, hex, URL and Zipf strings into one dictionary,
+// and into a segmented dictionary with one segment per kind, each with a symbol
+// table trained on that kind only.
+template <bool Segmented>
+static void BM_Heterogeneous_Ratio(benchmark::State& state) {
+  auto const count  = static_cast<std::size_t>(state.range(0));
+  auto       inputs = std::vector<std::vector<std::string>>{};
+  auto       mixed  = std::vector<std::string>{};
+  for (auto type : {kRandom32, kHex32, kURL, kZipf}) {
+    inputs.push_back(generate_data(count, type));
+    mixed.insert(mixed.end(), inputs.back().begin(), inputs.back().end());
+  }
+  auto const raw_bytes = total_raw_size(mixed);
+
+  for (auto _ : state) {
+    auto compressed_bytes = std::size_t{0};
+    if constexpr (Segmented) {
+      auto dict = vault::algorithm::fsst_segmented_dictionary<std::string>{};
+      for (auto const& input : inputs) {
+        auto [segment, keys] = build_with_map<boost::unordered_flat_map>(input);
+        dict.append(std::move(segment), keys);
+      }
+      compressed_bytes = dict.size_in_bytes();
+    } else {
+      auto [dict, keys] = build_with_map<boost::unordered_flat_map>(mixed);
+      compressed_bytes  = dict.size_in_bytes();
+    }
+    state.counters["Ratio"] = static_cast<double>(raw_bytes) / static_cast<double>(compressed_bytes);
+  }
+  state.SetItemsProcessed(state.iterations() * mixed.size());
+  state.SetBytesProcessed(state.iterations() * raw_bytes);
+}
+
 static void CustomArgs(benchmark::internal::Benchmark* b) {
   std::vector<int64_t> counts = {10'000, 100'000, 1'000'000, 10'000'000};
   std::vector<int64_t> types  = {kRandom32, kHex32, kURL, kZipf};
@@ -224,6 +382,15 @@ static void CustomArgs(benchmark::internal::Benchmark* b) {
   }
 }
 
+static void ThreadArgs(benchmark::internal::Benchmark* b) {
+  std::vector<int64_t> types = {kRandom32, kHex32, kURL, kZipf};
+  for (int64_t threads = 1; threads <= 16; threads *= 2) {
+    for (auto t : types) {
+      b->Args({threads, t});
+    }
+  }
+}
+
 static void SamplingArgs(benchmark::internal::Benchmark* b) {
   std::vector<int64_t> types = {kRandom32, kHex32, kURL, kZipf};
   for (int64_t denom = 1; denom <= 8192; denom *= 2) {
@@ -235,8 +402,17 @@ static void SamplingArgs(benchmark::internal::Benchmark* b) {
 
 BENCHMARK_TEMPLATE(BM_Construction_Map, std::unordered_map)->Apply(CustomArgs);
 BENCHMARK_TEMPLATE(BM_Construction_Map, boost::unordered_flat_map)->Apply(CustomArgs);
+BENCHMARK_TEMPLATE(BM_Construction_Map, boost::unordered_flat_map, true)->Apply(CustomArgs);
 BENCHMARK(BM_Lookup_Sequential)->Apply(CustomArgs);
 BENCHMARK(BM_Lookup_RandomOrder)->Apply(CustomArgs);
+BENCHMARK(BM_Lookup_RandomOrder_Batched)->Apply(CustomArgs);
+BENCHMARK_TEMPLATE(BM_Lookup_Zipf, false)->Apply(CustomArgs);
+BENCHMARK_TEMPLATE(BM_Lookup_Zipf, true)->Apply(CustomArgs);
+BENCHMARK_TEMPLATE(BM_Scan_StartsWith, true)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_Scan_StartsWith, false)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_Heterogeneous_Ratio, false)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK_TEMPLATE(BM_Heterogeneous_Ratio, true)->RangeMultiplier(10)->Range(10'000, 1'000'000);
+BENCHMARK(BM_Construction_Parallel)->Apply(ThreadArgs)->UseRealTime();
 BENCHMARK(BM_SamplingRatio)->Apply(SamplingArgs);
 
 BENCHMARK_MAIN();
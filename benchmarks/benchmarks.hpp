@@ -1,6 +1,61 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
+#pragma once
+
+#include <string>
+
+#include <sys/resource.h>
+
 #include <benchmark/benchmark.h>
 
+#include <vault/allocators/stats_allocator.hpp>
+#include <vault/metrics/metrics.hpp>
+
 // clang-format off
 // clang-format on
+
+// Reports what the allocations recorded in stats cost per iteration, next to
+// the time: their count and bytes, the most bytes live at once, and the share
+// of the bytes that lie in whole huge pages.
+inline void report_allocations(benchmark::State& state, const static_data::allocation_stats& stats) {
+  const static_data::allocation_snapshot s = stats.snapshot();
+
+  state.counters["allocs"] = benchmark::Counter(static_cast<double>(s.allocations), benchmark::Counter::kAvgIterations);
+  state.counters["alloc_bytes"] = benchmark::Counter(
+    static_cast<double>(s.allocated_bytes), benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024
+  );
+  state.counters["peak_bytes"] =
+    benchmark::Counter(static_cast<double>(s.peak_bytes), benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+  state.counters["huge_page_coverage"] = s.huge_page_coverage();
+}
+
+// Reports what the vault::metrics recorded since before, per iteration: a
+// counter under its name, and a histogram as its samples, their mean and an
+// upper bound of their 99th percentile. Metrics that recorded nothing are
+// left out, so nothing is reported when metrics are disabled.
+inline void report_metrics(benchmark::State& state, const vault::metrics::metrics_snapshot& before) {
+  const vault::metrics::metrics_snapshot recorded = vault::metrics::snapshot().since(before);
+
+  for (const vault::metrics::metric_snapshot& metric : recorded.metrics) {
+    if (metric.count == 0) {
+      continue;
+    }
+    const std::string name{metric.name};
+    if (metric.kind == vault::metrics::metric_kind::counter) {
+      state.counters[name] = benchmark::Counter(static_cast<double>(metric.count), benchmark::Counter::kAvgIterations);
+    } else {
+      state.counters[name + ".count"] =
+        benchmark::Counter(static_cast<double>(metric.count), benchmark::Counter::kAvgIterations);
+      state.counters[name + ".mean"] = metric.mean();
+      state.counters[name + ".p99"]  = static_cast<double>(metric.quantile(0.99));
+    }
+  }
+}
+
+// The peak resident set size of the process so far, in bytes. It only grows,
+// so it is comparable across the sizes of one run rather than across runs.
+inline double peak_rss() {
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+  return static_cast<double>(usage.ru_maxrss) * 1024.0;
+}
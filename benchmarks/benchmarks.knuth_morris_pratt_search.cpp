@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <vault/algorithm/amac.hpp>
+#include <vault/algorithm/batch_knuth_morris_pratt_search.hpp>
+#include <vault/algorithm/internal.hpp>
+#include <vault/algorithm/knuth_morris_pratt_searcher.hpp>
+
+namespace {
+  using corpus_fn = std::string_view (*)();
+
+  // Substrings of the corpus at random offsets, so that every pattern
+  // occurs and the searches stop at a point spread evenly over the text.
+  auto sample_patterns(std::string_view corpus, std::size_t count)
+    -> std::vector<std::string>
+  {
+    auto rng    = std::mt19937{42};
+    auto offset = std::uniform_int_distribution<std::size_t>{
+      0, corpus.size() - 32};
+    auto length = std::uniform_int_distribution<std::size_t>{8, 24};
+
+    auto result = std::vector<std::string>{};
+    result.reserve(count);
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      result.emplace_back(corpus.substr(offset(rng), length(rng)));
+    }
+    return result;
+  }
+} // namespace
+
+// One knuth_morris_pratt_searcher after the other.
+void bm_search_one_at_a_time(benchmark::State& state, corpus_fn corpus_of)
+{
+  auto const corpus = corpus_of();
+  if (corpus.size() < 32) {
+    state.SkipWithError("corpus not found");
+    return;
+  }
+
+  auto const count    = static_cast<std::size_t>(state.range(0));
+  auto const patterns = sample_patterns(corpus, count);
+
+  for (auto _ : state) {
+    auto found = std::size_t{0};
+    for (auto const& pattern : patterns) {
+      auto const searcher =
+        vault::algorithm::knuth_morris_pratt_searcher{std::string_view{pattern}};
+      found += searcher(corpus).first != corpus.end() ? 1 : 0;
+    }
+    benchmark::DoNotOptimize(found);
+  }
+
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * count));
+}
+
+// All patterns as AMAC jobs on the given coordinator.
+template <typename Coordinator>
+void bm_search_batched(
+  benchmark::State& state, Coordinator coordinator, corpus_fn corpus_of)
+{
+  auto const corpus = corpus_of();
+  if (corpus.size() < 32) {
+    state.SkipWithError("corpus not found");
+    return;
+  }
+
+  auto const count    = static_cast<std::size_t>(state.range(0));
+  auto const patterns = sample_patterns(corpus, count);
+
+  using result_t = std::pair<std::vector<std::string>::const_iterator,
+    std::ranges::subrange<std::string_view::const_iterator>>;
+
+  auto results = std::vector<result_t>{};
+  results.reserve(count);
+
+  for (auto _ : state) {
+    results.clear();
+    vault::algorithm::batch_knuth_morris_pratt_search(
+      coordinator,
+      corpus,
+      patterns,
+      std::back_inserter(results));
+    benchmark::DoNotOptimize(results.data());
+  }
+
+  state.SetItemsProcessed(
+    static_cast<std::int64_t>(state.iterations() * count));
+}
+
+BENCHMARK_CAPTURE(bm_search_one_at_a_time,
+  democracy_in_america,
+  vault::internal::democracy_in_america)
+  ->Arg(64)
+  ->Arg(256);
+BENCHMARK_CAPTURE(bm_search_batched,
+  democracy_in_america_amac_4,
+  vault::amac::coordinator_fn<4>{},
+  vault::internal::democracy_in_america)
+  ->Arg(64)
+  ->Arg(256);
+BENCHMARK_CAPTURE(bm_search_batched,
+  democracy_in_america_amac_8,
+  vault::amac::coordinator_fn<8>{},
+  vault::internal::democracy_in_america)
+  ->Arg(64)
+  ->Arg(256);
+BENCHMARK_CAPTURE(bm_search_batched,
+  democracy_in_america_amac_16,
+  vault::amac::coordinator_fn<16>{},
+  vault::internal::democracy_in_america)
+  ->Arg(64)
+  ->Arg(256);
+
+BENCHMARK_CAPTURE(bm_search_one_at_a_time,
+  democracy_and_education,
+  vault::internal::democracy_and_education)
+  ->Arg(64)
+  ->Arg(256);
+BENCHMARK_CAPTURE(bm_search_batched,
+  democracy_and_education_amac_8,
+  vault::amac::coordinator_fn<8>{},
+  vault::internal::democracy_and_education)
+  ->Arg(64)
+  ->Arg(256);
@@ -0,0 +1,601 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include <vault/algorithm/amac.hpp>
+#include <vault/algorithm/fsst_dictionary.hpp>
+#include <vault/algorithm/internal.hpp>
+#include <vault/algorithm/proxy_sort.hpp>
+#include <vault/executor/thread_executor.hpp>
+#include <vault/flat_map/eytzinger_layout_policy.hpp>
+#include <vault/flat_map/implicit_btree_layout_policy.hpp>
+#include <vault/flat_map/layout_map.hpp>
+#include <vault/flat_map/layout_map_file.hpp>
+#include <vault/static_index/static_index.hpp>
+
+#include "benchmarks.hpp"
+
+// The whole pipeline rather than one container: every iteration tokenizes
+// a dataset, deduplicates the tokens, compresses them into an
+// fsst_dictionary, builds an index from token to dictionary key, writes
+// both to disk, opens them again with the page cache dropped, and serves
+// batched probes from every thread. A probe is found in the index, its
+// value decoded from the dictionary and compared with the probe, so each
+// component is on the path of every probe. Every run reports
+//
+//   <stage>           seconds per iteration of each stage,
+//   probes_per_second probes served per second of the probe stage,
+//   hit_ratio         share of the probes whose value matched,
+//   bytes_per_key     bytes on disk per distinct token, with
+//   index_bytes_per_key and dictionary_bytes_per_key its parts,
+//   peak_rss          the high-water mark of the process so far,
+//
+// and, with vault::metrics enabled, what the components recorded.
+//
+// The iteration time is that of the whole pipeline. peak_rss only grows
+// from one run to the next, so compare it across sizes of one combination
+// rather than across combinations.
+namespace {
+
+  using vault::algorithm::fsst_dictionary_base;
+  using vault::algorithm::fsst_key;
+
+  using dataset_fn = std::vector<std::string> (*)(std::size_t);
+
+  // The number of probes every iteration serves, drawn from the tokens, so
+  // that frequent tokens are probed as often as they occur.
+  constexpr auto probe_count = std::size_t{1} << 20;
+
+  // The probes a worker takes at a time.
+  constexpr auto probe_batch_size = std::size_t{4096};
+
+  constexpr auto amac_buffer_size = std::size_t{16};
+
+  // --- Datasets ---
+
+  // The lowercase words of both corpora in reading order, repeated if
+  // `count` exceeds the number of words. Natural text has a few thousand
+  // distinct words, so the dictionary and the index stay small while the
+  // probes follow the frequencies of the text.
+  auto corpus_words(std::size_t count) -> std::vector<std::string>
+  {
+    auto words = std::vector<std::string>{};
+    words.reserve(count);
+
+    auto tokenize = [&](std::string_view text) {
+      auto word = std::string{};
+      for (auto const c : text) {
+        if (words.size() == count) {
+          return;
+        }
+        if (std::isalpha(static_cast<unsigned char>(c))) {
+          word.push_back(static_cast<char>(
+            std::tolower(static_cast<unsigned char>(c))));
+        } else if (!word.empty()) {
+          words.push_back(std::move(word));
+          word.clear();
+        }
+      }
+    };
+
+    auto const first  = vault::internal::democracy_in_america();
+    auto const second = vault::internal::democracy_and_education();
+    if (first.empty() && second.empty()) {
+      return words;
+    }
+
+    while (words.size() < count) {
+      tokenize(first);
+      tokenize(second);
+    }
+    return words;
+  }
+
+  // Zero-padded identifiers with a shared prefix and suffix, all distinct,
+  // as in benchmarks.proxy_sort.cpp.
+  auto low_entropy_ids(std::size_t count) -> std::vector<std::string>
+  {
+    auto result = std::vector<std::string>{};
+    result.reserve(count);
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      auto suffix = std::to_string(i);
+      suffix.insert(
+        suffix.begin(), 7 - std::min(std::size_t{7}, suffix.size()), '0');
+      result.push_back("property_" + suffix + "_padding_data");
+    }
+    return result;
+  }
+
+  // URLs of a few hosts with random paths, as in
+  // benchmarks.fsst_dictionary.cpp, from a fixed seed.
+  auto urls(std::size_t count) -> std::vector<std::string>
+  {
+    constexpr auto prefixes = std::array<std::string_view, 3>{
+      "https://www.google.com/search?q=",
+      "https://api.github.com/users/",
+      "http://example.com/item/"};
+    constexpr auto suffixes =
+      std::array<std::string_view, 3>{"&sourceid=chrome", "?v=4", "/details"};
+
+    auto rng    = std::mt19937{42};
+    auto affix  = std::uniform_int_distribution<std::size_t>{0, 2};
+    auto letter = std::uniform_int_distribution<int>{'a', 'z'};
+
+    auto result = std::vector<std::string>{};
+    result.reserve(count);
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      auto s = std::string{prefixes[affix(rng)]};
+      for (auto k = 0; k < 10; ++k) {
+        s.push_back(static_cast<char>(letter(rng)));
+      }
+      s += suffixes[affix(rng)];
+      result.push_back(std::move(s));
+    }
+    return result;
+  }
+
+  // --- Indexes ---
+
+  // An index is a component with a built and a loaded form, which may
+  // differ, and a scratch space per worker. find_many writes the positions
+  // in `probes` of the probes it finds, and their dictionary keys.
+
+  // A static_index over the tokens, and the dictionary keys in its slots.
+  struct static_index_component {
+    using index_t = vault::containers::static_index<std::uint64_t>;
+
+    struct built_type {
+      index_t               index;
+      std::vector<fsst_key> payload;
+    };
+
+    using loaded_type = built_type;
+
+    struct scratch_type {
+      std::vector<std::optional<std::size_t>> slots;
+      std::vector<std::size_t>                positions;
+      std::vector<fsst_key>                   keys;
+    };
+
+    static auto build(std::span<std::string_view const> tokens,
+      std::span<fsst_key const>                         keys,
+      std::size_t threads) -> built_type
+    {
+      auto slots = std::vector<std::size_t>{};
+      slots.reserve(tokens.size());
+
+      auto builder = vault::containers::static_index_builder<std::uint64_t>{};
+      builder.add_n(tokens).with_options({.thread_count = threads});
+      auto [index, sink] = std::move(builder).build(
+        [&](std::size_t slot) { slots.push_back(slot); });
+
+      auto payload = std::vector<fsst_key>(index.slot_count());
+      for (auto i = std::size_t{0}; i < slots.size(); ++i) {
+        payload[slots[i]] = keys[i];
+      }
+      return {std::move(index), std::move(payload)};
+    }
+
+    static void save(built_type const& built, std::filesystem::path const& dir)
+    {
+      built.index.save(dir / "index");
+
+      auto out = std::ofstream{dir / "payload", std::ios::binary};
+      out.exceptions(std::ios::failbit | std::ios::badbit);
+      out.write(reinterpret_cast<char const*>(built.payload.data()),
+        static_cast<std::streamsize>(built.payload.size() * sizeof(fsst_key)));
+    }
+
+    static auto open(std::filesystem::path const& dir) -> loaded_type
+    {
+      auto payload = std::vector<fsst_key>(
+        std::filesystem::file_size(dir / "payload") / sizeof(fsst_key));
+
+      auto in = std::ifstream{dir / "payload", std::ios::binary};
+      in.exceptions(std::ios::failbit | std::ios::badbit);
+      in.read(reinterpret_cast<char*>(payload.data()),
+        static_cast<std::streamsize>(payload.size() * sizeof(fsst_key)));
+
+      return {index_t::open_mapped(dir / "index"), std::move(payload)};
+    }
+
+    static void find_many(loaded_type const& loaded,
+      std::span<std::string_view const>      probes,
+      scratch_type&                          scratch)
+    {
+      scratch.slots.resize(probes.size());
+      loaded.index.lookup_many(probes, scratch.slots.begin());
+
+      for (auto i = std::size_t{0}; i < probes.size(); ++i) {
+        if (scratch.slots[i]) {
+          scratch.positions.push_back(i);
+          scratch.keys.push_back(loaded.payload[*scratch.slots[i]]);
+        }
+      }
+    }
+  };
+
+  // A layout_map from the hash of a token to its dictionary key, mapped in
+  // place when loaded. A hash that collides is told apart when the value is
+  // compared with the probe.
+  template <typename Policy>
+  struct layout_map_component {
+    using built_type =
+      eytzinger::layout_map<std::uint64_t, fsst_key, std::less<>, Policy>;
+    using loaded_type =
+      eytzinger::mapped_layout_map<std::uint64_t, fsst_key, std::less<>, Policy>;
+
+    struct scratch_type {
+      std::vector<std::uint64_t> hashes;
+      std::vector<std::pair<std::vector<std::uint64_t>::const_iterator,
+        typename loaded_type::const_iterator>>
+                               results;
+      std::vector<std::size_t> positions;
+      std::vector<fsst_key>    keys;
+    };
+
+    static auto build(std::span<std::string_view const> tokens,
+      std::span<fsst_key const>                         keys,
+      std::size_t) -> built_type
+    {
+      auto pairs = std::vector<std::pair<std::uint64_t, fsst_key>>{};
+      pairs.reserve(tokens.size());
+      for (auto i = std::size_t{0}; i < tokens.size(); ++i) {
+        pairs.emplace_back(std::hash<std::string_view>{}(tokens[i]), keys[i]);
+      }
+      return built_type(pairs.begin(), pairs.end());
+    }
+
+    static void save(built_type const& built, std::filesystem::path const& dir)
+    {
+      eytzinger::save_layout_map(dir / "index", built);
+    }
+
+    static auto open(std::filesystem::path const& dir) -> loaded_type
+    {
+      return eytzinger::open_mapped_layout_map<built_type>(dir / "index");
+    }
+
+    static void find_many(loaded_type const& loaded,
+      std::span<std::string_view const>      probes,
+      scratch_type&                          scratch)
+    {
+      scratch.hashes.clear();
+      for (auto const probe : probes) {
+        scratch.hashes.push_back(std::hash<std::string_view>{}(probe));
+      }
+
+      scratch.results.clear();
+      loaded.batch_find(vault::amac::coordinator<amac_buffer_size>,
+        std::as_const(scratch.hashes),
+        std::back_inserter(scratch.results));
+
+      for (auto const& [needle, found] : scratch.results) {
+        if (found != loaded.end()) {
+          scratch.positions.push_back(static_cast<std::size_t>(
+            needle - scratch.hashes.cbegin()));
+          scratch.keys.push_back(found->second);
+        }
+      }
+    }
+  };
+
+  // --- Helpers ---
+
+  enum class stage : std::size_t {
+    tokenize,
+    deduplicate,
+    compress,
+    index,
+    persist,
+    load,
+    probe,
+  };
+
+  constexpr auto stage_count = std::size_t{7};
+
+  constexpr auto stage_names = std::array<char const*, stage_count>{
+    "tokenize", "deduplicate", "compress", "index", "persist", "load", "probe"};
+
+  // Drops the pages of the files in `dir` from the page cache, once they
+  // are written back, so that the next open reads them from the disk as a
+  // process that starts cold would. This needs no privileges, but is only
+  // advice to the kernel.
+  void evict_page_cache(std::filesystem::path const& dir)
+  {
+    for (auto const& entry : std::filesystem::directory_iterator{dir}) {
+      auto const fd = ::open(entry.path().c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+        continue;
+      }
+      ::fdatasync(fd);
+      ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+      ::close(fd);
+    }
+  }
+
+  auto directory_size(std::filesystem::path const& dir) -> std::size_t
+  {
+    auto total = std::size_t{0};
+    for (auto const& entry : std::filesystem::directory_iterator{dir}) {
+      total += static_cast<std::size_t>(entry.file_size());
+    }
+    return total;
+  }
+
+  // A directory of its own under the temporary directory, removed with
+  // everything in it on destruction.
+  struct scratch_directory {
+    std::filesystem::path path;
+
+    scratch_directory()
+        : path(std::filesystem::temp_directory_path()
+            / ("vault-pipeline-" + std::to_string(::getpid())))
+    {
+      std::filesystem::remove_all(path);
+      std::filesystem::create_directories(path / "index");
+    }
+
+    scratch_directory(scratch_directory const&)            = delete;
+    scratch_directory& operator=(scratch_directory const&) = delete;
+
+    ~scratch_directory()
+    {
+      auto error = std::error_code{};
+      std::filesystem::remove_all(path, error);
+    }
+  };
+
+  // The worker scratch of an index, padded so that workers do not share
+  // the cache lines of their counters.
+  template <typename Index>
+  struct alignas(64) worker_state {
+    typename Index::scratch_type scratch;
+    std::size_t                  matches = 0;
+  };
+} // namespace
+
+// Runs the pipeline over `state.range(0)` tokens of `dataset`, on
+// `state.range(1)` threads.
+template <typename Index>
+void bm_pipeline(benchmark::State& state, dataset_fn dataset)
+{
+  using clock = std::chrono::steady_clock;
+
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto const threads = static_cast<std::size_t>(state.range(1));
+
+  // The tokens to probe, the same in every iteration.
+  auto rng            = std::mt19937_64{7};
+  auto pick           = std::uniform_int_distribution<std::size_t>{0, count - 1};
+  auto probe_position = std::vector<std::size_t>(probe_count);
+  for (auto& position : probe_position) {
+    position = pick(rng);
+  }
+
+  auto seconds = std::array<double, stage_count>{};
+  auto timed   = [&](stage s, auto&& fn) {
+    auto const start = clock::now();
+    fn();
+    seconds[static_cast<std::size_t>(s)] +=
+      std::chrono::duration<double>(clock::now() - start).count();
+  };
+
+  auto distinct_count   = std::size_t{0};
+  auto index_bytes      = std::size_t{0};
+  auto dictionary_bytes = std::size_t{0};
+  auto matches          = std::size_t{0};
+
+  auto const executor = vault::algorithm::thread_executor{threads};
+  auto       workers  = std::vector<worker_state<Index>>(executor.concurrency());
+
+  auto const metrics_before = vault::metrics::snapshot();
+
+  for (auto _ : state) {
+    auto const dir = scratch_directory{};
+
+    auto tokens = std::vector<std::string>{};
+    timed(stage::tokenize, [&] { tokens = dataset(count); });
+    if (tokens.size() != count) {
+      state.SkipWithError("corpus not found");
+      return;
+    }
+
+    auto distinct = std::vector<std::string_view>{};
+    timed(stage::deduplicate, [&] {
+      distinct.assign(tokens.begin(), tokens.end());
+      vault::algorithm::proxy_sort(distinct);
+      distinct.erase(std::ranges::unique(distinct).begin(), distinct.end());
+    });
+
+    auto dictionary = fsst_dictionary_base{};
+    auto keys       = std::vector<fsst_key>{};
+    timed(stage::compress, [&] {
+      auto next = distinct.begin();
+      auto gen  = [&]() -> std::optional<std::string_view> {
+        return next == distinct.end() ? std::nullopt
+                                      : std::optional{*next++};
+      };
+      std::tie(dictionary, keys) = fsst_dictionary_base::build_from_unique(
+        gen, {1.0}, fsst_dictionary_base::thread_count{threads});
+    });
+
+    auto built = std::optional<typename Index::built_type>{};
+    timed(stage::index,
+      [&] { built.emplace(Index::build(distinct, keys, threads)); });
+
+    timed(stage::persist, [&] {
+      dictionary.save(dir.path / "dictionary");
+      Index::save(*built, dir.path / "index");
+    });
+
+    distinct_count   = distinct.size();
+    index_bytes      = directory_size(dir.path / "index");
+    dictionary_bytes = std::filesystem::file_size(dir.path / "dictionary");
+
+    // Only what was persisted serves the probes.
+    built.reset();
+    dictionary = fsst_dictionary_base{};
+    keys       = std::vector<fsst_key>{};
+    evict_page_cache(dir.path);
+    evict_page_cache(dir.path / "index");
+
+    auto loaded = std::optional<typename Index::loaded_type>{};
+    timed(stage::load, [&] {
+      dictionary = fsst_dictionary_base::open_mapped(dir.path / "dictionary");
+      loaded.emplace(Index::open(dir.path / "index"));
+    });
+
+    auto probes = std::vector<std::string_view>{};
+    probes.reserve(probe_count);
+    for (auto const position : probe_position) {
+      probes.emplace_back(tokens[position]);
+    }
+
+    timed(stage::probe, [&] {
+      executor(probes.size(),
+        probe_batch_size,
+        [&](std::size_t worker, std::size_t first, std::size_t last) {
+          auto& local = workers[worker];
+          auto  batch = std::span<std::string_view const>{probes}.subspan(
+            first, last - first);
+
+          local.scratch.positions.clear();
+          local.scratch.keys.clear();
+          Index::find_many(*loaded, batch, local.scratch);
+
+          try_find_many(dictionary,
+            local.scratch.keys,
+            [&](std::size_t i, std::string_view value) {
+              local.matches += value == batch[local.scratch.positions[i]];
+            });
+        });
+    });
+
+    matches = 0;
+    for (auto& worker : workers) {
+      matches += std::exchange(worker.matches, 0);
+    }
+  }
+
+  for (auto s = std::size_t{0}; s < stage_count; ++s) {
+    state.counters[stage_names[s]] =
+      benchmark::Counter(seconds[s], benchmark::Counter::kAvgIterations);
+  }
+
+  auto const iterations    = static_cast<double>(state.iterations());
+  auto const probe_seconds = seconds[static_cast<std::size_t>(stage::probe)];
+  auto const per_key =
+    1.0 / static_cast<double>(std::max(distinct_count, std::size_t{1}));
+
+  state.counters["probes_per_second"] =
+    static_cast<double>(probe_count) * iterations / probe_seconds;
+  state.counters["hit_ratio"] =
+    static_cast<double>(matches) / static_cast<double>(probe_count);
+  state.counters["distinct"] = static_cast<double>(distinct_count);
+  state.counters["bytes_per_key"] =
+    static_cast<double>(index_bytes + dictionary_bytes) * per_key;
+  state.counters["index_bytes_per_key"] =
+    static_cast<double>(index_bytes) * per_key;
+  state.counters["dictionary_bytes_per_key"] =
+    static_cast<double>(dictionary_bytes) * per_key;
+  state.counters["peak_rss"] = peak_rss();
+  report_metrics(state, metrics_before);
+  state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(count));
+}
+
+void bm_static_index(benchmark::State& state, dataset_fn dataset)
+{
+  bm_pipeline<static_index_component>(state, dataset);
+}
+
+void bm_eytzinger_map(benchmark::State& state, dataset_fn dataset)
+{
+  bm_pipeline<layout_map_component<eytzinger::eytzinger_layout_policy<6>>>(
+    state, dataset);
+}
+
+void bm_btree_map(benchmark::State& state, dataset_fn dataset)
+{
+  bm_pipeline<
+    layout_map_component<eytzinger::implicit_btree_layout_policy<16>>>(
+    state, dataset);
+}
+
+namespace {
+
+  // Token counts from 64Ki to 16Mi, on one thread and on every hardware
+  // thread.
+  void pipeline_args(benchmark::internal::Benchmark* b)
+  {
+    auto const hardware = std::max(1u, std::thread::hardware_concurrency());
+    for (auto count = std::int64_t{1} << 16; count <= std::int64_t{1} << 24;
+      count <<= 4) {
+      b->Args({count, 1});
+      if (hardware > 1) {
+        b->Args({count, static_cast<std::int64_t>(hardware)});
+      }
+    }
+  }
+} // namespace
+
+BENCHMARK_CAPTURE(bm_static_index, words, corpus_words)
+  ->Apply(pipeline_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_CAPTURE(bm_static_index, ids, low_entropy_ids)
+  ->Apply(pipeline_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_CAPTURE(bm_static_index, urls, urls)
+  ->Apply(pipeline_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+BENCHMARK_CAPTURE(bm_eytzinger_map, words, corpus_words)
+  ->Apply(pipeline_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_CAPTURE(bm_eytzinger_map, ids, low_entropy_ids)
+  ->Apply(pipeline_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_CAPTURE(bm_eytzinger_map, urls, urls)
+  ->Apply(pipeline_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+BENCHMARK_CAPTURE(bm_btree_map, words, corpus_words)
+  ->Apply(pipeline_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_CAPTURE(bm_btree_map, ids, low_entropy_ids)
+  ->Apply(pipeline_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_CAPTURE(bm_btree_map, urls, urls)
+  ->Apply(pipeline_args)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
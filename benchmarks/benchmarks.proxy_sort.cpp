@@ -8,6 +8,8 @@
 #include <vector>
 #include <benchmark/benchmark.h>
 
+#include <vault/algorithm/proxy_sort.hpp>
+
 // ------------------------------------------------------------------------
 // Types & Core Logic
 // ------------------------------------------------------------------------
@@ -31,17 +33,7 @@ pair_comparator(const std::pair<std::string_view, int>& a, const std::pair<std::
 }
 
 [[nodiscard]] inline auto build_proxy(std::string_view s) noexcept -> uint64_t {
-  auto       buffer   = uint64_t{0};
-  const auto copy_len = std::min<std::size_t>(s.size(), sizeof(uint64_t));
-
-  if (copy_len > 0) {
-    std::memcpy(&buffer, s.data(), copy_len);
-  }
-
-  if constexpr (std::endian::native == std::endian::little) {
-    return std::byteswap(buffer);
-  }
-  return buffer;
+  return vault::algorithm::string_proxy(s);
 }
 
 // ------------------------------------------------------------------------
@@ -65,8 +57,8 @@ pair_comparator(const std::pair<std::string_view, int>& a, const std::pair<std::
 }
 
 // Pre-allocate the maximum bounds to keep memory stable
-static const auto high_entropy_storage = generate_strings(256, true);
-static const auto low_entropy_storage  = generate_strings(256, false);
+static const auto high_entropy_storage = generate_strings(65536, true);
+static const auto low_entropy_storage  = generate_strings(65536, false);
 
 [[nodiscard]] inline auto get_shuffled_pairs(const std::vector<std::string>& storage, std::size_t n)
   -> std::vector<std::pair<std::string_view, int>> {
@@ -119,7 +111,7 @@ static void bm_baseline_high_entropy(benchmark::State& state) {
   }
 }
 
-BENCHMARK(bm_baseline_high_entropy)->Arg(32)->Arg(256);
+BENCHMARK(bm_baseline_high_entropy)->Arg(32)->Arg(256)->Arg(65536);
 
 static void bm_proxy_high_entropy(benchmark::State& state) {
   const auto n      = static_cast<std::size_t>(state.range(0));
@@ -137,7 +129,7 @@ static void bm_proxy_high_entropy(benchmark::State& state) {
   }
 }
 
-BENCHMARK(bm_proxy_high_entropy)->Arg(32)->Arg(256);
+BENCHMARK(bm_proxy_high_entropy)->Arg(32)->Arg(256)->Arg(65536);
 
 static void bm_baseline_low_entropy(benchmark::State& state) {
   const auto n      = static_cast<std::size_t>(state.range(0));
@@ -155,7 +147,7 @@ static void bm_baseline_low_entropy(benchmark::State& state) {
   }
 }
 
-BENCHMARK(bm_baseline_low_entropy)->Arg(32)->Arg(256);
+BENCHMARK(bm_baseline_low_entropy)->Arg(32)->Arg(256)->Arg(65536);
 
 static void bm_proxy_low_entropy(benchmark::State& state) {
   const auto n      = static_cast<std::size_t>(state.range(0));
@@ -173,4 +165,42 @@ static void bm_proxy_low_entropy(benchmark::State& state) {
   }
 }
 
-BENCHMARK(bm_proxy_low_entropy)->Arg(32)->Arg(256);
+BENCHMARK(bm_proxy_low_entropy)->Arg(32)->Arg(256)->Arg(65536);
+
+// vault::algorithm::proxy_sort on the same pairs as the baselines, with the
+// proxies built and the ties resolved inside the sort.
+static void bm_library_high_entropy(benchmark::State& state) {
+  const auto n      = static_cast<std::size_t>(state.range(0));
+  auto       source = get_shuffled_pairs(high_entropy_storage, n);
+  auto       work   = std::vector<std::pair<std::string_view, int>>(n);
+
+  for (auto _ : state) {
+    std::ranges::copy(source, work.begin());
+    benchmark::DoNotOptimize(work.data());
+
+    vault::algorithm::proxy_sort(work, &std::pair<std::string_view, int>::first);
+
+    benchmark::DoNotOptimize(work.data());
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK(bm_library_high_entropy)->Arg(32)->Arg(256)->Arg(65536);
+
+static void bm_library_low_entropy(benchmark::State& state) {
+  const auto n      = static_cast<std::size_t>(state.range(0));
+  auto       source = get_shuffled_pairs(low_entropy_storage, n);
+  auto       work   = std::vector<std::pair<std::string_view, int>>(n);
+
+  for (auto _ : state) {
+    std::ranges::copy(source, work.begin());
+    benchmark::DoNotOptimize(work.data());
+
+    vault::algorithm::proxy_sort(work, &std::pair<std::string_view, int>::first);
+
+    benchmark::DoNotOptimize(work.data());
+    benchmark::ClobberMemory();
+  }
+}
+
+BENCHMARK(bm_library_low_entropy)->Arg(32)->Arg(256)->Arg(65536);
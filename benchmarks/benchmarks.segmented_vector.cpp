@@ -1,13 +1,25 @@
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <deque>
+#include <functional>
+#include <memory>
 #include <memory_resource>
+#include <mutex>
+#include <numeric>
 #include <random>
+#include <ranges>
 #include <vector>
 
 #include <benchmark/benchmark.h>
 
+#include "benchmarks.hpp"
+
 // Include your header here
+#include <vault/allocators/hpallocator.hpp>
+#include <vault/allocators/recycling_allocator.hpp>
+#include <vault/frozen_vector/frozen_vector.hpp>
+#include <vault/segmented_vector/concurrent_segmented_vector.hpp>
 #include <vault/segmented_vector/segmented_vector.hpp>
 
 // -----------------------------------------------------------------------------
@@ -242,4 +254,249 @@ template <typename Container> static void BM_ForEachSegment(benchmark::State& st
 
 BENCHMARK_TEMPLATE(BM_ForEachSegment, segmented_vector<size_t>)->Range(1 << 12, 1 << 20);
 
+// -----------------------------------------------------------------------------
+// 5. Parallel Reduction (Segments Split Across Threads)
+// -----------------------------------------------------------------------------
+
+static void BM_ParallelReduce(benchmark::State& state) {
+  size_t                   N = state.range(0);
+  segmented_vector<size_t> c;
+  for (size_t i = 0; i < N; ++i) {
+    c.push_back(i);
+  }
+
+  const vault::algorithm::thread_executor executor{};
+  for (auto _ : state) {
+    size_t sum = c.parallel_reduce(size_t{0}, std::plus<>{}, executor);
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK(BM_ParallelReduce)->Range(1 << 12, 1 << 22)->UseRealTime();
+
+// -----------------------------------------------------------------------------
+// 6. Segmented Algorithms (Per-Block Loops vs. Iterator Loops)
+// -----------------------------------------------------------------------------
+// Unqualified calls find the segment-aware overloads of segmented_vector by
+// argument-dependent lookup, and std::vector's own through namespace std;
+// the Generic variants call the std algorithms through the iterators.
+
+template <typename Container> static Container MakeFilled(size_t N) {
+  Container c;
+  for (size_t i = 0; i < N; ++i) {
+    c.push_back(i);
+  }
+  return c;
+}
+
+template <typename Container, bool Generic> static void BM_Copy(benchmark::State& state) {
+  size_t              N = state.range(0);
+  Container           c = MakeFilled<Container>(N);
+  std::vector<size_t> out(N);
+
+  for (auto _ : state) {
+    if constexpr (Generic) {
+      std::copy(c.begin(), c.end(), out.begin());
+    } else {
+      copy(c.begin(), c.end(), out.begin());
+    }
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <typename Container, bool Generic> static void BM_Find(benchmark::State& state) {
+  size_t    N = state.range(0);
+  Container c = MakeFilled<Container>(N);
+
+  for (auto _ : state) {
+    // Searches for the last element, so every element is compared.
+    if constexpr (Generic) {
+      benchmark::DoNotOptimize(std::find(c.begin(), c.end(), N - 1));
+    } else {
+      benchmark::DoNotOptimize(find(c.begin(), c.end(), N - 1));
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+template <typename Container, bool Generic> static void BM_Accumulate(benchmark::State& state) {
+  size_t    N = state.range(0);
+  Container c = MakeFilled<Container>(N);
+
+  for (auto _ : state) {
+    size_t sum = 0;
+    if constexpr (Generic) {
+      sum = std::accumulate(c.begin(), c.end(), size_t{0});
+    } else {
+      sum = accumulate(c.begin(), c.end(), size_t{0});
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK_TEMPLATE(BM_Copy, segmented_vector<size_t>, false)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Copy, segmented_vector<size_t>, true)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Copy, std::vector<size_t>, false)->Range(1 << 12, 1 << 20);
+
+BENCHMARK_TEMPLATE(BM_Find, segmented_vector<size_t>, false)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Find, segmented_vector<size_t>, true)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Find, std::vector<size_t>, false)->Range(1 << 12, 1 << 20);
+
+BENCHMARK_TEMPLATE(BM_Accumulate, segmented_vector<size_t>, false)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Accumulate, segmented_vector<size_t>, true)->Range(1 << 12, 1 << 20);
+BENCHMARK_TEMPLATE(BM_Accumulate, std::vector<size_t>, false)->Range(1 << 12, 1 << 20);
+
+// -----------------------------------------------------------------------------
+// 7. Concurrent Append (Lock-Free vs. Mutex)
+// -----------------------------------------------------------------------------
+// Each iteration appends N elements into a fresh container from
+// state.range(1) producer threads, one at a time or in batches.
+
+static void BM_ConcurrentAppend_LockFree(benchmark::State& state) {
+  size_t                                  N = state.range(0);
+  const vault::algorithm::thread_executor executor(state.range(1));
+
+  for (auto _ : state) {
+    concurrent_segmented_vector<size_t> c;
+    executor(N, 4096, [&](size_t, size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        c.push_back(i);
+      }
+    });
+    benchmark::DoNotOptimize(c.size());
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void BM_ConcurrentAppend_LockFreeRange(benchmark::State& state) {
+  size_t                                  N = state.range(0);
+  const vault::algorithm::thread_executor executor(state.range(1));
+
+  for (auto _ : state) {
+    concurrent_segmented_vector<size_t> c;
+    executor(N, 4096, [&](size_t, size_t first, size_t last) {
+      // Batches of 64 share one reservation and one publication.
+      for (size_t i = first; i < last; i += 64) {
+        c.append_range(std::views::iota(i, std::min(i + 64, last)));
+      }
+    });
+    benchmark::DoNotOptimize(c.size());
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void BM_ConcurrentAppend_Mutex(benchmark::State& state) {
+  size_t                                  N = state.range(0);
+  const vault::algorithm::thread_executor executor(state.range(1));
+
+  for (auto _ : state) {
+    segmented_vector<size_t> c;
+    std::mutex               mutex;
+    executor(N, 4096, [&](size_t, size_t first, size_t last) {
+      for (size_t i = first; i < last; ++i) {
+        std::lock_guard lock(mutex);
+        c.push_back(i);
+      }
+    });
+    benchmark::DoNotOptimize(c.size());
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+BENCHMARK(BM_ConcurrentAppend_LockFree)->ArgsProduct({{1 << 20}, {1, 2, 4, 8}})->UseRealTime();
+BENCHMARK(BM_ConcurrentAppend_LockFreeRange)->ArgsProduct({{1 << 20}, {1, 2, 4, 8}})->UseRealTime();
+BENCHMARK(BM_ConcurrentAppend_Mutex)->ArgsProduct({{1 << 20}, {1, 2, 4, 8}})->UseRealTime();
+
+// -----------------------------------------------------------------------------
+// 8. Publishing (Freeze vs. Copy into a frozen_vector)
+// -----------------------------------------------------------------------------
+
+static void BM_Publish_Freeze(benchmark::State& state) {
+  size_t N = state.range(0);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto c = MakeFilled<segmented_vector<size_t>>(N);
+    state.ResumeTiming();
+
+    auto frozen = std::move(c).freeze();
+    benchmark::DoNotOptimize(frozen.size());
+
+    state.PauseTiming();
+    frozen = {};
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+static void BM_Publish_Copy(benchmark::State& state) {
+  size_t N = state.range(0);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto c = MakeFilled<segmented_vector<size_t>>(N);
+    state.ResumeTiming();
+
+    std::shared_ptr<size_t[]> data = std::make_shared_for_overwrite<size_t[]>(N);
+    copy(c.begin(), c.end(), data.get());
+    frozen::frozen_vector<size_t> frozen(std::move(data), N);
+    benchmark::DoNotOptimize(frozen.size());
+
+    state.PauseTiming();
+    frozen = {};
+    c.clear();
+    state.ResumeTiming();
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+}
+
+// A freeze is too quick for the timer to settle the iteration count while
+// every iteration refills the container, so the count is fixed.
+BENCHMARK(BM_Publish_Freeze)->Range(1 << 16, 1 << 24)->Iterations(16);
+BENCHMARK(BM_Publish_Copy)->Range(1 << 16, 1 << 24)->Iterations(16);
+
+// -----------------------------------------------------------------------------
+// 9. Huge-Page Blocks (Random Access and Refill)
+// -----------------------------------------------------------------------------
+// Past the last-level TLB reach of small pages, random reads miss the TLB on
+// almost every access. Huge-page sized blocks from hpallocator keep every
+// large block on 2 MiB pages.
+
+template <typename Allocator>
+using HugePageVector = segmented_vector<
+    size_t,
+    Allocator,
+    std::integral_constant<size_t, 4096 / sizeof(size_t)>,
+    huge_page_growth<>>;
+
+BENCHMARK_TEMPLATE(BM_RandomAccess, segmented_vector<size_t>)->RangeMultiplier(8)->Range(1 << 18, 1 << 24);
+BENCHMARK_TEMPLATE(BM_RandomAccess, HugePageVector<static_data::hpallocator<size_t>>)
+  ->RangeMultiplier(8)
+  ->Range(1 << 18, 1 << 24);
+
+// Fills and drops a vector per iteration, as a batch job that builds a fresh
+// buffer every round does. Recycled blocks are already faulted in.
+template <typename Allocator> static void BM_Refill(benchmark::State& state) {
+  using CountingAllocator = static_data::stats_allocator<size_t, Allocator>;
+
+  size_t                        N = state.range(0);
+  static_data::allocation_stats stats;
+
+  for (auto _ : state) {
+    HugePageVector<CountingAllocator> c{CountingAllocator(stats)};
+    for (size_t i = 0; i < N; ++i) {
+      c.push_back(i);
+    }
+    benchmark::DoNotOptimize(c.size());
+  }
+  state.SetItemsProcessed(state.iterations() * N);
+  report_allocations(state, stats);
+}
+
+BENCHMARK_TEMPLATE(BM_Refill, static_data::hpallocator<size_t>)->Range(1 << 18, 1 << 22);
+BENCHMARK_TEMPLATE(BM_Refill, static_data::recycling_allocator<size_t>)->Range(1 << 18, 1 << 22);
+
 BENCHMARK_MAIN();
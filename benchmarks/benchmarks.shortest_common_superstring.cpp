@@ -1,8 +1,17 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <memory_resource>
+#include <new>
 #include <random>
+#include <span>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <benchmark/benchmark.h>
@@ -13,7 +22,12 @@
 #include <range/v3/view/transform.hpp>
 
 #include <vault/algorithm/internal.hpp>
+#include <vault/algorithm/overlap_graph.hpp>
+#include <vault/algorithm/sharded_shortest_common_superstring.hpp>
 #include <vault/algorithm/shortest_common_superstring.hpp>
+#include <vault/algorithm/superstring_builder.hpp>
+
+#include "benchmarks.hpp"
 
 // ----------------------------------------------------------------------------
 // Benchmark                                  Time             CPU   Iterations
@@ -59,6 +73,9 @@ namespace {
 
   using namespace std::literals::string_literals;
 
+  // Every allocation through the global operator new in this binary.
+  constinit auto allocation_count = std::atomic<std::size_t>{0};
+
   // --- Helpers & Generators ---
 
   // Generates N random strings of fixed length L
@@ -78,6 +95,24 @@ namespace {
     return result;
   }
 
+  // Generates N random strings of fixed length L over {A, C, G, T}, whose
+  // overlap graph is close to complete.
+  auto generate_dna_strings(std::size_t count, std::size_t length)
+    -> std::vector<std::string>
+  {
+    auto rng  = std::mt19937{std::random_device{}()};
+    auto dist = std::uniform_int_distribution<std::size_t>{0, 3};
+
+    auto result = std::vector<std::string>(count);
+    for (auto& s : result) {
+      s.resize(length);
+      for (auto& c : s) {
+        c = "ACGT"[dist(rng)];
+      }
+    }
+    return result;
+  }
+
   // Fetches a subset of the variable-length dictionary
   auto get_variable_strings(std::size_t count) -> std::vector<std::string>
   {
@@ -105,6 +140,48 @@ namespace {
 
 } // namespace
 
+auto operator new(std::size_t size) -> void*
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (auto* const p = std::malloc(size != 0 ? size : 1)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+// std::pmr::new_delete_resource allocates through the aligned forms.
+auto operator new(std::size_t size, std::align_val_t alignment) -> void*
+{
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  auto const align = static_cast<std::size_t>(alignment);
+  auto const bytes =
+    (std::max(size, std::size_t{1}) + align - 1) / align * align;
+  if (auto* const p = std::aligned_alloc(align, bytes)) {
+    return p;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* p, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept
+{
+  std::free(p);
+}
+
 // ----------------------------------------------------------------------------
 // User's Original Benchmark
 // ----------------------------------------------------------------------------
@@ -148,6 +225,21 @@ void bm_baseline_variable(benchmark::State& state)
   }
 }
 
+// Same as bm_baseline_variable, writing 32-bit offset/length pairs instead of
+// subranges.
+void bm_baseline_variable_offsets(benchmark::State& state)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto       strings = get_variable_strings(count);
+
+  auto out = std::vector<vault::algorithm::superstring_offset<>>(count);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vault::algorithm::shortest_common_superstring(
+      strings, vault::algorithm::superstring_offsets<>(out.begin())));
+  }
+}
+
 void bm_baseline_fixed_32(benchmark::State& state)
 {
   auto const count   = static_cast<std::size_t>(state.range(0));
@@ -254,11 +346,442 @@ void bm_int_vectors_variable(benchmark::State& state)
   }
 }
 
+// ----------------------------------------------------------------------------
+// Overlap Engines
+// ----------------------------------------------------------------------------
+
+// Pairs with bm_baseline_variable/bm_baseline_fixed_32 to show where the
+// Aho-Corasick engine overtakes the all-pairs KMP engine.
+
+void bm_aho_corasick_variable(benchmark::State& state)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto       strings = get_variable_strings(count);
+
+  using bounds_t = vault::algorithm::greedy_shortest_common_superstring_fn::
+    superstring_bounds_t<decltype(strings)>;
+
+  auto out = std::vector<bounds_t>(count);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vault::algorithm::shortest_common_superstring(
+      vault::algorithm::aho_corasick_overlap_engine, strings, out.begin()));
+  }
+}
+
+void bm_aho_corasick_fixed_32(benchmark::State& state)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto       strings = generate_fixed_strings(count, 32);
+
+  using bounds_t = vault::algorithm::greedy_shortest_common_superstring_fn::
+    superstring_bounds_t<decltype(strings)>;
+
+  auto out = std::vector<bounds_t>(count);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(vault::algorithm::shortest_common_superstring(
+      vault::algorithm::aho_corasick_overlap_engine, strings, out.begin()));
+  }
+}
+
+// Isolates graph construction, which is the phase the engines differ in.
+// Random fixed-length strings are used because, unlike the dictionary
+// words, they are (with overwhelming probability) already free of
+// duplicates and contained strings, as the Aho-Corasick engine requires.
+template <typename Engine>
+void bm_overlap_engine(benchmark::State& state, Engine engine)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto       strings = generate_fixed_strings(count, 32)
+    | ::ranges::views::transform(
+        [](auto const& s) { return std::vector<char>(s.begin(), s.end()); })
+    | ::ranges::to<std::vector>();
+
+  auto edges = std::vector<vault::algorithm::overlap_edge>{};
+
+  for (auto _ : state) {
+    edges.clear();
+    engine(strings, std::equal_to<>{}, std::back_inserter(edges));
+    benchmark::DoNotOptimize(edges.data());
+  }
+
+  state.counters["edges"] = static_cast<double>(edges.size());
+}
+
+// Graph construction over kilobyte-long strings that rarely overlap by more
+// than a symbol or two, where the Karp-Rabin engine only compares the pairs
+// whose fingerprints match.
+template <typename Engine>
+void bm_long_overlap_engine(benchmark::State& state, Engine engine)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto       strings = generate_fixed_strings(count, 1024)
+    | ::ranges::views::transform(
+        [](auto const& s) { return std::vector<char>(s.begin(), s.end()); })
+    | ::ranges::to<std::vector>();
+
+  auto edges = std::vector<vault::algorithm::overlap_edge>{};
+
+  for (auto _ : state) {
+    edges.clear();
+    engine(strings, std::equal_to<>{}, std::back_inserter(edges));
+    benchmark::DoNotOptimize(edges.data());
+  }
+
+  state.counters["edges"] = static_cast<double>(edges.size());
+}
+
+// Graph construction with the KMP kernel spread over a varying number of
+// threads; compare against bm_overlap_engine/knuth_morris_pratt.
+void bm_parallel_overlap_engine(benchmark::State& state)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto const threads = static_cast<std::size_t>(state.range(1));
+  auto       strings = generate_fixed_strings(count, 32)
+    | ::ranges::views::transform(
+        [](auto const& s) { return std::vector<char>(s.begin(), s.end()); })
+    | ::ranges::to<std::vector>();
+
+  auto const engine =
+    vault::algorithm::parallel_knuth_morris_pratt_overlap_engine{
+      vault::algorithm::thread_executor{threads}};
+
+  auto edges = std::vector<vault::algorithm::overlap_edge>{};
+
+  for (auto _ : state) {
+    edges.clear();
+    engine(strings, std::equal_to<>{}, std::back_inserter(edges));
+    benchmark::DoNotOptimize(edges.data());
+  }
+
+  state.counters["threads"] = static_cast<double>(threads);
+}
+
+// ----------------------------------------------------------------------------
+// Overlap Graphs
+// ----------------------------------------------------------------------------
+
+// Isolates the greedy merge: the edges of the dictionary words are computed
+// once, and every iteration loads them into a fresh graph and drains it.
+template <vault::algorithm::overlap_graph Graph>
+void bm_overlap_graph(benchmark::State& state)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto       strings = get_variable_strings(count)
+    | ::ranges::views::transform(
+        [](auto const& s) { return std::vector<char>(s.begin(), s.end()); })
+    | ::ranges::to<std::vector>();
+
+  auto edges = std::vector<vault::algorithm::overlap_edge>{};
+  vault::algorithm::knuth_morris_pratt_overlap_engine(
+    strings, std::equal_to<>{}, std::back_inserter(edges));
+  std::ranges::sort(edges, {}, [](auto const& e) {
+    return std::pair{e.lhs, e.rhs};
+  });
+
+  for (auto _ : state) {
+    auto graph  = Graph{count, edges};
+    auto merged = std::size_t{0};
+
+    while (auto const edge = graph.pop()) {
+      graph.merge(edge->lhs, edge->rhs);
+      ++merged;
+    }
+
+    benchmark::DoNotOptimize(merged);
+  }
+
+  state.counters["edges"] = static_cast<double>(edges.size());
+}
+
+// End-to-end counterpart of bm_overlap_graph.
+template <vault::algorithm::overlap_graph Graph>
+void bm_overlap_graph_superstring(benchmark::State& state)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto       strings = get_variable_strings(count);
+
+  using scs_t =
+    vault::algorithm::basic_greedy_shortest_common_superstring_fn<Graph>;
+  using bounds_t = scs_t::template superstring_bounds_t<decltype(strings)>;
+
+  auto out = std::vector<bounds_t>(count);
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scs_t{}(
+      vault::algorithm::aho_corasick_overlap_engine, strings, out.begin()));
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Pruning
+// ----------------------------------------------------------------------------
+
+// Dense overlaps with at most k edges kept per string; k = 0 stands for no
+// pruning. Compare the superstring counter against k = 0 for the
+// compression given up.
+void bm_pruned_dna_32(benchmark::State& state)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto const k       = static_cast<std::size_t>(state.range(1));
+  auto       strings = generate_dna_strings(count, 32);
+
+  using bounds_t = vault::algorithm::greedy_shortest_common_superstring_fn::
+    superstring_bounds_t<decltype(strings)>;
+
+  auto out = std::vector<bounds_t>(count);
+
+  auto const engine = vault::algorithm::pruned_overlap_engine{
+    vault::algorithm::aho_corasick_overlap_engine,
+    k == 0 ? vault::algorithm::overlap_pruning{}
+           : vault::algorithm::overlap_pruning{k}};
+
+  auto superstring = std::size_t{0};
+  for (auto _ : state) {
+    auto result = vault::algorithm::shortest_common_superstring(
+      engine, strings, out.begin());
+    superstring = result.superstring.size();
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.counters["superstring"] = static_cast<double>(superstring);
+}
+
+// ----------------------------------------------------------------------------
+// Incremental Builder
+// ----------------------------------------------------------------------------
+
+// Appends 1% new dictionary words to a builder that already holds the
+// rest; compare against bm_builder_rebuild for the same count.
+void bm_builder_append(benchmark::State& state)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto const batch   = std::max(count / 100, std::size_t{1});
+  auto       strings = get_variable_strings(count);
+
+  auto const initial = std::span{strings}.first(count - batch);
+  auto const added   = std::span{strings}.last(batch);
+
+  auto base = vault::algorithm::superstring_builder<char>{};
+  base.add(initial);
+
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto builder = base;
+    state.ResumeTiming();
+
+    builder.add(added);
+    benchmark::DoNotOptimize(builder.total_overlap());
+  }
+}
+
+// Rebuilds the superstring of the same strings from scratch.
+void bm_builder_rebuild(benchmark::State& state)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto       strings = get_variable_strings(count);
+
+  for (auto _ : state) {
+    auto builder = vault::algorithm::superstring_builder<char>{};
+    builder.add(strings);
+    benchmark::DoNotOptimize(builder.total_overlap());
+  }
+}
+
+// ----------------------------------------------------------------------------
+// Sharding
+// ----------------------------------------------------------------------------
+
+// Sharded superstring of the dictionary words over a varying number of
+// shards. The "lost" counter is the relative growth of the superstring
+// against the exact greedy result for the same strings.
+void bm_sharded(benchmark::State& state)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto const shards  = static_cast<std::size_t>(state.range(1));
+  auto       strings = get_variable_strings(count);
+
+  using bounds_t = vault::algorithm::greedy_shortest_common_superstring_fn::
+    superstring_bounds_t<decltype(strings)>;
+
+  auto out = std::vector<bounds_t>(count);
+
+  auto const exact = vault::algorithm::shortest_common_superstring(
+    vault::algorithm::aho_corasick_overlap_engine, strings, out.begin())
+                       .superstring.size();
+
+  auto const scs = vault::algorithm::sharded_shortest_common_superstring{
+    vault::algorithm::superstring_sharding{.shard_count = shards},
+    vault::algorithm::thread_executor{},
+    vault::algorithm::aho_corasick_overlap_engine};
+
+  auto size = std::size_t{0};
+  for (auto _ : state) {
+    auto result = scs(strings, out.begin());
+    size        = result.superstring.size();
+    benchmark::DoNotOptimize(result);
+  }
+
+  state.counters["lost"] =
+    static_cast<double>(size) / static_cast<double>(exact) - 1.0;
+}
+
+// ----------------------------------------------------------------------------
+// Allocation
+// ----------------------------------------------------------------------------
+
+// Heap allocations per superstring, with the scratch space of the pipeline
+// on the heap or in an arena that is reset between iterations. peak_rss is
+// the high-water mark of the whole process so far, so it only grows from one
+// run to the next; compare it across sizes rather than across variants.
+void bm_allocations(benchmark::State& state, bool use_arena)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto       strings = get_variable_strings(count);
+
+  using bounds_t = vault::algorithm::greedy_shortest_common_superstring_fn::
+    superstring_bounds_t<decltype(strings)>;
+
+  auto out    = std::vector<bounds_t>(count);
+  auto buffer = std::vector<std::byte>(std::size_t{16} << 20);
+  auto arena =
+    std::pmr::monotonic_buffer_resource{buffer.data(), buffer.size()};
+
+  auto const scs = vault::algorithm::greedy_shortest_common_superstring_fn{
+    use_arena ? &arena : nullptr};
+
+  auto const before = allocation_count.load(std::memory_order_relaxed);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scs(
+      vault::algorithm::aho_corasick_overlap_engine, strings, out.begin()));
+    arena.release();
+  }
+  auto const allocations =
+    allocation_count.load(std::memory_order_relaxed) - before;
+
+  state.counters["allocs"] = benchmark::Counter(
+    static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+  state.counters["peak_rss"] = peak_rss();
+}
+
+// ----------------------------------------------------------------------------
+// Phases
+// ----------------------------------------------------------------------------
+
+// Where the time goes, as the average milliseconds per superstring spent in
+// each phase of the pipeline, along with what the filter and the graph saw.
+void bm_phases(benchmark::State& state)
+{
+  using vault::algorithm::superstring_phase;
+
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto       strings = get_variable_strings(count);
+
+  using bounds_t = vault::algorithm::greedy_shortest_common_superstring_fn::
+    superstring_bounds_t<decltype(strings)>;
+
+  auto out   = std::vector<bounds_t>(count);
+  auto stats = vault::algorithm::superstring_statistics{};
+
+  auto const scs = vault::algorithm::
+    greedy_shortest_common_superstring_with_statistics_fn{nullptr, stats};
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(scs(
+      vault::algorithm::aho_corasick_overlap_engine, strings, out.begin()));
+  }
+
+  auto per_iteration = [&](double value) {
+    return benchmark::Counter(value, benchmark::Counter::kAvgIterations);
+  };
+
+  auto milliseconds = [&](superstring_phase phase) {
+    return per_iteration(
+      std::chrono::duration<double, std::milli>(stats.time(phase)).count());
+  };
+
+  state.counters["filter_ms"]   = milliseconds(superstring_phase::filter);
+  state.counters["graph_ms"]    = milliseconds(superstring_phase::graph);
+  state.counters["merge_ms"]    = milliseconds(superstring_phase::merge);
+  state.counters["assembly_ms"] = milliseconds(superstring_phase::assembly);
+  state.counters["mapping_ms"]  = milliseconds(superstring_phase::mapping);
+  state.counters["removed"] =
+    per_iteration(static_cast<double>(stats.removed_strings));
+  state.counters["edges"]  = per_iteration(static_cast<double>(stats.edges));
+  state.counters["allocs"] =
+    per_iteration(static_cast<double>(stats.allocations));
+  state.counters["ratio"] = stats.compression_ratio();
+}
+
 // Register Benchmarks
 BENCHMARK(shortest_common_superstring)->RangeMultiplier(2)->Range(256, 10000);
 BENCHMARK(bm_baseline_variable)->RangeMultiplier(2)->Range(256, 4096);
+BENCHMARK(bm_baseline_variable_offsets)->RangeMultiplier(2)->Range(256, 4096);
 BENCHMARK(bm_baseline_fixed_32)->RangeMultiplier(2)->Range(256, 4096);
 BENCHMARK(bm_comparator_variable)->RangeMultiplier(2)->Range(256, 4096);
 BENCHMARK(bm_comparator_fixed_32)->RangeMultiplier(2)->Range(256, 4096);
 BENCHMARK(bm_projection_widgets)->RangeMultiplier(2)->Range(256, 4096);
 BENCHMARK(bm_int_vectors_variable)->RangeMultiplier(2)->Range(256, 4096);
+BENCHMARK(bm_aho_corasick_variable)->RangeMultiplier(2)->Range(256, 10000);
+BENCHMARK(bm_aho_corasick_fixed_32)->RangeMultiplier(2)->Range(256, 4096);
+BENCHMARK(bm_phases)->RangeMultiplier(2)->Range(256, 10000);
+BENCHMARK_CAPTURE(bm_overlap_engine,
+  knuth_morris_pratt,
+  vault::algorithm::knuth_morris_pratt_overlap_engine)
+  ->RangeMultiplier(2)
+  ->Range(256, 10000);
+BENCHMARK_CAPTURE(bm_overlap_engine,
+  aho_corasick,
+  vault::algorithm::aho_corasick_overlap_engine)
+  ->RangeMultiplier(2)
+  ->Range(256, 10000);
+BENCHMARK_CAPTURE(bm_overlap_engine,
+  karp_rabin,
+  vault::algorithm::karp_rabin_overlap_engine{})
+  ->RangeMultiplier(2)
+  ->Range(256, 10000);
+BENCHMARK_CAPTURE(bm_long_overlap_engine,
+  knuth_morris_pratt,
+  vault::algorithm::knuth_morris_pratt_overlap_engine)
+  ->RangeMultiplier(4)
+  ->Range(64, 1024);
+BENCHMARK_CAPTURE(bm_long_overlap_engine,
+  aho_corasick,
+  vault::algorithm::aho_corasick_overlap_engine)
+  ->RangeMultiplier(4)
+  ->Range(64, 1024);
+BENCHMARK_CAPTURE(bm_long_overlap_engine,
+  karp_rabin,
+  vault::algorithm::karp_rabin_overlap_engine{})
+  ->RangeMultiplier(4)
+  ->Range(64, 1024);
+BENCHMARK(bm_parallel_overlap_engine)
+  ->ArgsProduct({{2048, 4096}, {1, 2, 4, 8, 16, 32, 64}})
+  ->UseRealTime();
+BENCHMARK(bm_overlap_graph<vault::algorithm::bucket_queue_overlap_graph>)
+  ->RangeMultiplier(2)
+  ->Range(256, 10000);
+BENCHMARK(bm_overlap_graph<vault::algorithm::multi_index_overlap_graph>)
+  ->RangeMultiplier(2)
+  ->Range(256, 10000);
+BENCHMARK(
+  bm_overlap_graph_superstring<vault::algorithm::bucket_queue_overlap_graph>)
+  ->RangeMultiplier(2)
+  ->Range(256, 10000);
+BENCHMARK(
+  bm_overlap_graph_superstring<vault::algorithm::multi_index_overlap_graph>)
+  ->RangeMultiplier(2)
+  ->Range(256, 10000);
+BENCHMARK(bm_pruned_dna_32)->ArgsProduct({{1024, 4096}, {0, 1, 4, 16}});
+BENCHMARK(bm_builder_append)->RangeMultiplier(2)->Range(1024, 8192);
+BENCHMARK(bm_builder_rebuild)->RangeMultiplier(2)->Range(1024, 8192);
+BENCHMARK(bm_sharded)
+  ->ArgsProduct({{2048, 10000}, {1, 4, 16, 64}})
+  ->UseRealTime();
+BENCHMARK_CAPTURE(bm_allocations, heap, false)
+  ->RangeMultiplier(2)
+  ->Range(256, 10000);
+BENCHMARK_CAPTURE(bm_allocations, arena, true)
+  ->RangeMultiplier(2)
+  ->Range(256, 10000);
@@ -1,23 +1,39 @@
 #include <algorithm>
 #include <benchmark/benchmark.h>
-#include <boost/unordered/unordered_flat_set.hpp>
+#include <boost/container_hash/hash.hpp>
+#include <boost/unordered/unordered_flat_map.hpp>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <random>
 #include <string>
+#include <utility>
+#include <vault/flat_map/aliases.hpp>
 #include <vault/static_index/static_index.hpp>
 #include <vector>
 
+using vault::containers::key_128;
+using vault::containers::static_index;
+using vault::containers::static_index_build_options;
+using vault::containers::static_index_builder;
+
 // Configuration
 static const size_t key_len = 16;
 
+// The number of keys every iteration of a lookup benchmark looks up.
+static constexpr size_t num_needles = 4096;
+
 // Helper: Generate random keys
-std::vector<std::string> generate_keys(size_t count)
+std::vector<std::string> generate_keys(size_t count, uint64_t seed = 42)
 {
   std::vector<std::string> keys;
   keys.reserve(count);
 
-  std::mt19937_64                         rng(42);
+  std::mt19937_64                         rng(seed);
   std::uniform_int_distribution<uint64_t> dist;
 
   for (size_t i = 0; i < count; ++i) {
@@ -32,148 +48,326 @@ std::vector<std::string> generate_keys(size_t count)
   return keys;
 }
 
-// -----------------------------------------------------------------------------
-// Fixture: Boost Flat Set
-// -----------------------------------------------------------------------------
-class BoostFixture : public benchmark::Fixture {
-public:
-  boost::unordered_flat_set<std::string> map;
-  std::vector<std::string>               keys;
-  std::vector<std::string>               miss_keys;
+// Helper: Needles drawn from `keys` at random.
+std::vector<std::string> sample_hits(std::vector<std::string> const& keys)
+{
+  std::vector<std::string> needles;
+  needles.reserve(num_needles);
+
+  std::mt19937_64                       rng(7);
+  std::uniform_int_distribution<size_t> dist(0, keys.size() - 1);
+
+  for (size_t i = 0; i < num_needles; ++i) {
+    needles.push_back(keys[dist(rng)]);
+  }
+  return needles;
+}
+
+// Helper: Needles that are not keys.
+std::vector<std::string> sample_misses()
+{
+  // A different seed, so that none of these are keys of the index.
+  return generate_keys(num_needles, 1234);
+}
 
-  void SetUp(const benchmark::State& state) override
+// Projects the fingerprint of a key onto the high bits of its hash,
+// truncated to the width of the fingerprint.
+template <typename Fingerprint> struct truncated_high {
+  [[nodiscard]] Fingerprint operator()(
+    auto const&, key_128 const& key) const noexcept
   {
-    size_t num_keys = state.range(0);
-    keys            = generate_keys(num_keys);
-
-    // Prepare miss keys
-    miss_keys = keys;
-    if (!miss_keys.empty()) {
-      for (auto& k : miss_keys) {
-        k[0] ^= 0xFF;
-      }
-    }
+    return static_cast<Fingerprint>(key.high);
+  }
+};
 
-    // Build Map
-    map.clear();
-    map.reserve(num_keys);
-    for (const auto& k : keys) {
-      map.insert(k);
-    }
+template <typename Fingerprint>
+using index_type = static_index<Fingerprint, truncated_high<Fingerprint>>;
+
+template <typename Fingerprint>
+index_type<Fingerprint> build_index(
+  std::vector<std::string> const& keys, size_t thread_count = 1)
+{
+  static_index_builder<Fingerprint, truncated_high<Fingerprint>> builder;
+  builder.add_n(keys).with_options({.thread_count = thread_count});
+  return std::move(builder).build();
+}
+
+// An allocator that counts the bytes live in the container it serves.
+template <typename T> struct counting_allocator {
+  using value_type = T;
+
+  size_t* live_bytes;
+
+  explicit counting_allocator(size_t* counter) noexcept
+      : live_bytes(counter)
+  {}
+
+  template <typename U>
+  counting_allocator(counting_allocator<U> const& other) noexcept
+      : live_bytes(other.live_bytes)
+  {}
+
+  T* allocate(size_t n)
+  {
+    *live_bytes += n * sizeof(T);
+    return std::allocator<T>{}.allocate(n);
+  }
+
+  void deallocate(T* p, size_t n) noexcept
+  {
+    *live_bytes -= n * sizeof(T);
+    std::allocator<T>{}.deallocate(p, n);
   }
 
-  void TearDown(const benchmark::State&) override
+  template <typename U>
+  bool operator==(counting_allocator<U> const& other) const noexcept
   {
-    map.clear();
-    keys.clear();
-    miss_keys.clear();
+    return live_bytes == other.live_bytes;
   }
 };
 
+using flat_map_type = boost::unordered_flat_map<std::string,
+  size_t,
+  boost::hash<std::string>,
+  std::equal_to<std::string>,
+  counting_allocator<std::pair<std::string const, size_t>>>;
+
+using layout_map_type = eytzinger::eytzinger_map<std::string,
+  size_t,
+  std::less<>,
+  counting_allocator<std::pair<std::string const, size_t>>>;
+
+// Helper: Reports the size of a structure over `num_keys` keys. The maps
+// are charged for their tables but not for the heap buffers of their
+// keys, which favours them.
+void set_bits_per_key(benchmark::State& state, size_t bytes, size_t num_keys)
+{
+  state.counters["bits/key"] = benchmark::Counter(
+    static_cast<double>(bytes) * 8 / static_cast<double>(num_keys));
+}
+
+// Helper: Reports the time per needle as well as the throughput.
+void set_latency(benchmark::State& state)
+{
+  state.SetItemsProcessed(state.iterations() * num_needles);
+  state.counters["latency"] = benchmark::Counter(num_needles,
+    benchmark::Counter::kIsIterationInvariantRate
+      | benchmark::Counter::kInvert);
+}
+
 // -----------------------------------------------------------------------------
-// Fixture: Static Index
+// Construction
 // -----------------------------------------------------------------------------
-class StaticIndexFixture : public benchmark::Fixture {
-public:
-  vault::containers::static_index index;
-  std::vector<std::string>        keys;
-  std::vector<std::string>        miss_keys;
 
-  void SetUp(const benchmark::State& state) override
-  {
-    size_t num_keys = state.range(0);
-    keys            = generate_keys(num_keys);
-
-    // Prepare miss keys
-    miss_keys = keys;
-    if (!miss_keys.empty()) {
-      for (auto& k : miss_keys) {
-        k[0] ^= 0xFF;
-      }
+template <typename Fingerprint>
+static void BM_StaticIndex_Build(benchmark::State& state)
+{
+  auto const keys         = generate_keys(state.range(0));
+  auto const thread_count = static_cast<size_t>(state.range(1));
+
+  size_t bytes = 0;
+  for (auto _ : state) {
+    auto index = build_index<Fingerprint>(keys, thread_count);
+    bytes      = index.memory_usage_bytes();
+    benchmark::DoNotOptimize(index);
+  }
+
+  state.SetItemsProcessed(state.iterations() * keys.size());
+  set_bits_per_key(state, bytes, keys.size());
+}
+
+static void BM_FlatMap_Build(benchmark::State& state)
+{
+  auto const keys = generate_keys(state.range(0));
+
+  size_t bytes = 0;
+  for (auto _ : state) {
+    auto map = flat_map_type(flat_map_type::allocator_type(&bytes));
+    map.reserve(keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      map.emplace(keys[i], i);
     }
+    set_bits_per_key(state, bytes, keys.size());
+    benchmark::DoNotOptimize(map);
+  }
 
-    // Build Index
-    index.build(keys);
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+static void BM_LayoutMap_Build(benchmark::State& state)
+{
+  auto const keys = generate_keys(state.range(0));
+
+  std::vector<std::pair<std::string, size_t>> pairs;
+  pairs.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    pairs.emplace_back(keys[i], i);
   }
 
-  void TearDown(const benchmark::State&) override
-  {
-    // static_index destructor cleans up huge pages automatically
-    keys.clear();
-    miss_keys.clear();
+  size_t bytes = 0;
+  for (auto _ : state) {
+    auto map = layout_map_type(
+      pairs.begin(), pairs.end(), layout_map_type::allocator_type(&bytes));
+    set_bits_per_key(state, bytes, keys.size());
+    benchmark::DoNotOptimize(map);
   }
-};
+
+  state.SetItemsProcessed(state.iterations() * keys.size());
+}
 
 // -----------------------------------------------------------------------------
-// Benchmarks
+// Lookup
 // -----------------------------------------------------------------------------
 
-BENCHMARK_DEFINE_F(BoostFixture, Lookup)(benchmark::State& state)
+// Single lookups of keys that are in the index if `Hit`, and of keys that
+// are not otherwise. A missed key is only rejected by its fingerprint, so
+// misses also report the share of needles the fingerprint let through.
+template <typename Fingerprint, bool Hit>
+static void BM_StaticIndex_Lookup(benchmark::State& state)
 {
-  size_t num_keys = keys.size();
-  size_t i        = 0;
+  auto const keys    = generate_keys(state.range(0));
+  auto const index   = build_index<Fingerprint>(keys, 0);
+  auto const needles = Hit ? sample_hits(keys) : sample_misses();
+
+  size_t found = 0;
   for (auto _ : state) {
-    benchmark::DoNotOptimize(map.contains(keys[i++ & (num_keys - 1)]));
+    found = 0;
+    for (auto const& needle : needles) {
+      found += index[needle].has_value();
+    }
+    benchmark::DoNotOptimize(found);
   }
-  state.SetItemsProcessed(state.iterations());
-  state.SetLabel("Hit Rate: 100%");
+
+  set_latency(state);
+  set_bits_per_key(state, index.memory_usage_bytes(), keys.size());
+  state.counters["found"] = benchmark::Counter(
+    static_cast<double>(found) / static_cast<double>(needles.size()));
 }
 
-BENCHMARK_DEFINE_F(BoostFixture, Miss)(benchmark::State& state)
+// Batched lookups of keys that are in the index.
+template <typename Fingerprint>
+static void BM_StaticIndex_LookupMany(benchmark::State& state)
 {
-  size_t num_keys = keys.size();
-  size_t i        = 0;
+  auto const keys    = generate_keys(state.range(0));
+  auto const index   = build_index<Fingerprint>(keys, 0);
+  auto const needles = sample_hits(keys);
+
+  std::vector<std::optional<size_t>> results;
+  results.reserve(needles.size());
+
   for (auto _ : state) {
-    benchmark::DoNotOptimize(map.contains(miss_keys[i++ & (num_keys - 1)]));
+    results.clear();
+    index.lookup_many(needles, std::back_inserter(results));
+    benchmark::DoNotOptimize(results.data());
   }
-  state.SetItemsProcessed(state.iterations());
-  state.SetLabel("Hit Rate: 0%");
+
+  set_latency(state);
 }
 
-BENCHMARK_DEFINE_F(StaticIndexFixture, Lookup)(benchmark::State& state)
+template <bool Hit> static void BM_FlatMap_Lookup(benchmark::State& state)
 {
-  size_t num_keys = keys.size();
-  size_t i        = 0;
+  auto const keys = generate_keys(state.range(0));
+
+  size_t bytes = 0;
+  auto   map   = flat_map_type(flat_map_type::allocator_type(&bytes));
+  map.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    map.emplace(keys[i], i);
+  }
+
+  auto const needles = Hit ? sample_hits(keys) : sample_misses();
+
   for (auto _ : state) {
-    benchmark::DoNotOptimize(index.lookup(keys[i++ & (num_keys - 1)]));
+    size_t found = 0;
+    for (auto const& needle : needles) {
+      found += map.contains(needle);
+    }
+    benchmark::DoNotOptimize(found);
   }
-  state.SetItemsProcessed(state.iterations());
-  state.SetLabel("Hit Rate: 100%");
+
+  set_latency(state);
+  set_bits_per_key(state, bytes, keys.size());
 }
 
-BENCHMARK_DEFINE_F(StaticIndexFixture, Miss)(benchmark::State& state)
+template <bool Hit> static void BM_LayoutMap_Lookup(benchmark::State& state)
 {
-  size_t num_keys = keys.size();
-  size_t i        = 0;
+  auto const keys = generate_keys(state.range(0));
+
+  std::vector<std::pair<std::string, size_t>> pairs;
+  pairs.reserve(keys.size());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    pairs.emplace_back(keys[i], i);
+  }
+
+  size_t     bytes = 0;
+  auto const map   = layout_map_type(
+    pairs.begin(), pairs.end(), layout_map_type::allocator_type(&bytes));
+
+  auto const needles = Hit ? sample_hits(keys) : sample_misses();
+
   for (auto _ : state) {
-    benchmark::DoNotOptimize(index.lookup(miss_keys[i++ & (num_keys - 1)]));
+    size_t found = 0;
+    for (auto const& needle : needles) {
+      found += map.contains(needle);
+    }
+    benchmark::DoNotOptimize(found);
   }
-  state.SetItemsProcessed(state.iterations());
-  state.SetLabel("Hit Rate: 0%");
+
+  set_latency(state);
+  set_bits_per_key(state, bytes, keys.size());
 }
 
 // -----------------------------------------------------------------------------
 // Registration
 // -----------------------------------------------------------------------------
 
-BENCHMARK_REGISTER_F(BoostFixture, Lookup)
-  ->RangeMultiplier(8)
-  ->Range(1 << 16, 1 << 24)
-  ->Unit(benchmark::kNanosecond);
-
-BENCHMARK_REGISTER_F(StaticIndexFixture, Lookup)
-  ->RangeMultiplier(8)
-  ->Range(1 << 16, 1 << 24)
-  ->Unit(benchmark::kNanosecond);
-
-BENCHMARK_REGISTER_F(BoostFixture, Miss)
-  ->RangeMultiplier(8)
-  ->Range(1 << 16, 1 << 24)
-  ->Unit(benchmark::kNanosecond);
-
-BENCHMARK_REGISTER_F(StaticIndexFixture, Miss)
-  ->RangeMultiplier(8)
-  ->Range(1 << 16, 1 << 24)
-  ->Unit(benchmark::kNanosecond);
+// Key counts from L2 resident to DRAM bound.
+#define ARGS_LOOKUP                                                            \
+  ->RangeMultiplier(8)->Range(1 << 16, 1 << 24)->Unit(benchmark::kNanosecond)
+
+// Construction is slower, so the largest size is smaller. The second
+// argument is the number of threads, zero selecting one per core.
+#define ARGS_BUILD                                                             \
+  ->ArgsProduct({benchmark::CreateRange(1 << 16, 1 << 22, 4), {1, 0}})         \
+    ->Unit(benchmark::kMillisecond)
+
+#define REGISTER_FINGERPRINT(Label, Fingerprint)                               \
+  BENCHMARK_TEMPLATE(BM_StaticIndex_Build, Fingerprint)                        \
+  ARGS_BUILD->Name("StaticIndex/" Label "/Build");                             \
+  BENCHMARK_TEMPLATE(BM_StaticIndex_Lookup, Fingerprint, true)                 \
+  ARGS_LOOKUP->Name("StaticIndex/" Label "/Lookup/Hit");                       \
+  BENCHMARK_TEMPLATE(BM_StaticIndex_Lookup, Fingerprint, false)                \
+  ARGS_LOOKUP->Name("StaticIndex/" Label "/Lookup/Miss");                      \
+  BENCHMARK_TEMPLATE(BM_StaticIndex_LookupMany, Fingerprint)                   \
+  ARGS_LOOKUP->Name("StaticIndex/" Label "/LookupMany/Hit");
+
+REGISTER_FINGERPRINT("uint8", uint8_t)
+REGISTER_FINGERPRINT("uint16", uint16_t)
+REGISTER_FINGERPRINT("uint32", uint32_t)
+REGISTER_FINGERPRINT("uint64", uint64_t)
+
+BENCHMARK(BM_FlatMap_Build)
+  ->RangeMultiplier(4)
+  ->Range(1 << 16, 1 << 22)
+  ->Unit(benchmark::kMillisecond)
+  ->Name("FlatMap/Build");
+
+BENCHMARK_TEMPLATE(BM_FlatMap_Lookup, true)
+ARGS_LOOKUP->Name("FlatMap/Lookup/Hit");
+
+BENCHMARK_TEMPLATE(BM_FlatMap_Lookup, false)
+ARGS_LOOKUP->Name("FlatMap/Lookup/Miss");
+
+BENCHMARK(BM_LayoutMap_Build)
+  ->RangeMultiplier(4)
+  ->Range(1 << 16, 1 << 22)
+  ->Unit(benchmark::kMillisecond)
+  ->Name("LayoutMap/Build");
+
+BENCHMARK_TEMPLATE(BM_LayoutMap_Lookup, true)
+ARGS_LOOKUP->Name("LayoutMap/Lookup/Hit");
+
+BENCHMARK_TEMPLATE(BM_LayoutMap_Lookup, false)
+ARGS_LOOKUP->Name("LayoutMap/Lookup/Miss");
 
 BENCHMARK_MAIN();
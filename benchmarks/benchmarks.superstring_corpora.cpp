@@ -0,0 +1,220 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <vault/algorithm/internal.hpp>
+#include <vault/algorithm/sharded_shortest_common_superstring.hpp>
+#include <vault/algorithm/shortest_common_superstring.hpp>
+
+#include "benchmarks.hpp"
+
+// Superstrings of data shaped like ours rather than of random words: the
+// tokens of the corpora in data/, low-entropy identifiers and reads of a
+// random genome. Every run reports
+//
+//   bytes_per_second  input bytes consumed per second,
+//   ratio             superstring length over total input length,
+//   peak_rss          the high-water mark of the process so far.
+//
+// peak_rss only grows from one run to the next, so compare it across sizes
+// of one dataset rather than across datasets.
+namespace {
+
+  using dataset_fn = std::vector<std::string> (*)(std::size_t);
+
+  // The lowercase words of both corpora in reading order, repeated if
+  // `count` exceeds the number of words. Natural text has a few thousand
+  // distinct words, so most of these are removed by the filter.
+  auto corpus_words(std::size_t count) -> std::vector<std::string>
+  {
+    auto words = std::vector<std::string>{};
+    words.reserve(count);
+
+    auto tokenize = [&](std::string_view text) {
+      auto word = std::string{};
+      for (auto const c : text) {
+        if (words.size() == count) {
+          return;
+        }
+        if (std::isalpha(static_cast<unsigned char>(c))) {
+          word.push_back(static_cast<char>(
+            std::tolower(static_cast<unsigned char>(c))));
+        } else if (!word.empty()) {
+          words.push_back(std::move(word));
+          word.clear();
+        }
+      }
+    };
+
+    auto const first  = vault::internal::democracy_in_america();
+    auto const second = vault::internal::democracy_and_education();
+    if (first.empty() && second.empty()) {
+      return words;
+    }
+
+    while (words.size() < count) {
+      tokenize(first);
+      tokenize(second);
+    }
+    return words;
+  }
+
+  // Zero-padded identifiers with a shared prefix and suffix, as in
+  // benchmarks.proxy_sort.cpp. No identifier overlaps another, so the
+  // superstring is their concatenation, but every pair shares a long
+  // prefix and suffix that the engine has to rule out.
+  auto low_entropy_ids(std::size_t count) -> std::vector<std::string>
+  {
+    auto result = std::vector<std::string>{};
+    result.reserve(count);
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      auto suffix = std::to_string(i);
+      suffix.insert(
+        suffix.begin(), 7 - std::min(std::size_t{7}, suffix.size()), '0');
+      result.push_back("property_" + suffix + "_padding_data");
+    }
+    return result;
+  }
+
+  // 32-mers read at random offsets of a random genome, at about eight-fold
+  // coverage, so that most reads overlap several others by a long stretch.
+  auto genome_kmers(std::size_t count) -> std::vector<std::string>
+  {
+    constexpr auto const k = std::size_t{32};
+
+    auto rng    = std::mt19937{42};
+    auto base   = std::uniform_int_distribution<std::size_t>{0, 3};
+    auto genome = std::string(count * k / 8 + k, 'A');
+    for (auto& c : genome) {
+      c = "ACGT"[base(rng)];
+    }
+
+    auto offset =
+      std::uniform_int_distribution<std::size_t>{0, genome.size() - k};
+
+    auto result = std::vector<std::string>{};
+    result.reserve(count);
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      result.push_back(genome.substr(offset(rng), k));
+    }
+    return result;
+  }
+
+  auto total_length(std::vector<std::string> const& strings) -> std::size_t
+  {
+    auto total = std::size_t{0};
+    for (auto const& s : strings) {
+      total += s.size();
+    }
+    return total;
+  }
+
+  void report(benchmark::State& state,
+    std::size_t                 input_length,
+    std::size_t                 superstring_length)
+  {
+    state.SetBytesProcessed(static_cast<std::int64_t>(
+      state.iterations() * static_cast<std::int64_t>(input_length)));
+    state.counters["ratio"] = static_cast<double>(superstring_length)
+      / static_cast<double>(std::max(input_length, std::size_t{1}));
+    state.counters["peak_rss"] = peak_rss();
+  }
+} // namespace
+
+// The greedy superstring over all strings at once.
+void bm_corpus_greedy(benchmark::State& state, dataset_fn dataset)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto const strings = dataset(count);
+  if (strings.size() != count) {
+    state.SkipWithError("corpus not found");
+    return;
+  }
+
+  using bounds_t = vault::algorithm::greedy_shortest_common_superstring_fn::
+    superstring_bounds_t<decltype(strings)>;
+
+  auto out    = std::vector<bounds_t>(count);
+  auto length = std::size_t{0};
+
+  for (auto _ : state) {
+    auto result = vault::algorithm::greedy_shortest_common_superstring(
+      vault::algorithm::aho_corasick_overlap_engine, strings, out.begin());
+    length = result.superstring.size();
+    benchmark::DoNotOptimize(result);
+  }
+
+  report(state, total_length(strings), length);
+}
+
+// The sharded superstring, with about 1024 strings per shard so that the
+// work within a shard stays bounded as the input grows.
+void bm_corpus_sharded(benchmark::State& state, dataset_fn dataset)
+{
+  auto const count   = static_cast<std::size_t>(state.range(0));
+  auto const strings = dataset(count);
+  if (strings.size() != count) {
+    state.SkipWithError("corpus not found");
+    return;
+  }
+
+  using bounds_t = vault::algorithm::greedy_shortest_common_superstring_fn::
+    superstring_bounds_t<decltype(strings)>;
+
+  auto const scs = vault::algorithm::sharded_shortest_common_superstring{
+    vault::algorithm::superstring_sharding{
+      .shard_count = std::max(count / 1024, std::size_t{1})},
+    vault::algorithm::thread_executor{},
+    vault::algorithm::aho_corasick_overlap_engine};
+
+  auto out    = std::vector<bounds_t>(count);
+  auto length = std::size_t{0};
+
+  for (auto _ : state) {
+    auto result = scs(strings, out.begin());
+    length      = result.superstring.size();
+    benchmark::DoNotOptimize(result);
+  }
+
+  report(state, total_length(strings), length);
+}
+
+// Reads of a random genome share short overlaps with almost every other
+// read, so the overlap graph grows quadratically: the exact algorithm is only
+// run on the smaller sizes, and the sharded one stops where its second pass,
+// over the long shard superstrings, starts to dominate.
+BENCHMARK_CAPTURE(bm_corpus_greedy, words, corpus_words)
+  ->RangeMultiplier(4)
+  ->Range(1 << 10, 1 << 20)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(bm_corpus_greedy, ids, low_entropy_ids)
+  ->RangeMultiplier(4)
+  ->Range(1 << 10, 1 << 20)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(bm_corpus_greedy, kmers, genome_kmers)
+  ->RangeMultiplier(4)
+  ->Range(1 << 10, 1 << 12)
+  ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_CAPTURE(bm_corpus_sharded, words, corpus_words)
+  ->RangeMultiplier(4)
+  ->Range(1 << 10, 1 << 20)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(bm_corpus_sharded, ids, low_entropy_ids)
+  ->RangeMultiplier(4)
+  ->Range(1 << 10, 1 << 20)
+  ->Unit(benchmark::kMillisecond);
+BENCHMARK_CAPTURE(bm_corpus_sharded, kmers, genome_kmers)
+  ->RangeMultiplier(4)
+  ->Range(1 << 10, 1 << 16)
+  ->Unit(benchmark::kMillisecond);
@@ -1,8 +1,11 @@
 #include <benchmark/benchmark.h>
 
+#include <cstddef>
 #include <cstdint>
+#include <utility>
 #include <vector>
 
+#include <vault/unroll/parallel_unroll.hpp>
 #include <vault/unroll/unroll.hpp>
 
 namespace {
@@ -119,6 +122,132 @@ namespace {
 
   BENCHMARK(bm_pragma_unroll)->RangeMultiplier(8)->Range(1024, 8388608);
 
+  // A table larger than the last-level cache, and a random index into it.
+  auto generate_gather(std::size_t size) -> std::pair<std::vector<std::uint64_t>, std::vector<std::uint32_t>> {
+    auto table = std::vector<std::uint64_t>(std::size_t{1} << 23, 1);
+    auto index = std::vector<std::uint32_t>(size);
+    auto seed  = std::uint64_t{12345};
+
+    for (auto& i : index) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      i    = static_cast<std::uint32_t>((seed >> 33) % table.size());
+    }
+    return {std::move(table), std::move(index)};
+  }
+
+  // Enough work per element to fill the out-of-order window, so that the
+  // hardware alone no longer overlaps the misses of the loads far ahead.
+  [[nodiscard]] auto mix(std::uint64_t x) -> std::uint64_t {
+    for (auto round = 0; round < 4; ++round) {
+      x ^= x >> 33;
+      x *= 0xff51afd7ed558ccdULL;
+    }
+    return x;
+  }
+
+  // ============================================================================
+  // Benchmark 4: Standard Gather
+  // ============================================================================
+  static void bm_standard_gather(benchmark::State& state) {
+    auto [table, index] = generate_gather(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+      auto sum = std::uint64_t{0};
+      for (auto i = std::size_t{0}; i < index.size(); ++i) {
+        sum += mix(table[index[i]]);
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+
+  BENCHMARK(bm_standard_gather)->RangeMultiplier(8)->Range(4096, 8388608);
+
+  // ============================================================================
+  // Benchmark 5: Vault Unrolled Gather, prefetching every element ahead
+  // ============================================================================
+  static void bm_vault_prefetch_gather(benchmark::State& state) {
+    auto [table, index] = generate_gather(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+      auto sum = std::uint64_t{0};
+      vault::unroll_prefetch_loop<unroll_factor, 32, 1>(
+        std::size_t{0},
+        index.size(),
+        [&](auto i) { sum += mix(table[index[i]]); },
+        [&](std::size_t i) { return &table[index[i]]; });
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+
+  BENCHMARK(bm_vault_prefetch_gather)->RangeMultiplier(8)->Range(4096, 8388608);
+
+  // ============================================================================
+  // Benchmark 6: Vault Block Loop over the quote scan, vectorizable per block
+  // ============================================================================
+  static void bm_vault_block_count(benchmark::State& state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto data = generate_json_payload(size);
+
+    for (auto _ : state) {
+      auto quote_count = std::size_t{0};
+
+      vault::unroll_block_loop<32>(data.data(), data.data() + size, [&](auto block) {
+        auto count = std::size_t{0};
+        for (auto j = std::size_t{0}; j < block.size(); ++j) {
+          count += *block[j] == '"' ? 1 : 0;
+        }
+        quote_count += count;
+      });
+
+      benchmark::DoNotOptimize(quote_count);
+    }
+  }
+
+  BENCHMARK(bm_vault_block_count)->RangeMultiplier(8)->Range(1024, 8388608);
+
+  // ============================================================================
+  // Benchmark 7: Standard Loop over the quote scan
+  // ============================================================================
+  static void bm_standard_count(benchmark::State& state) {
+    auto size = static_cast<std::size_t>(state.range(0));
+    auto data = generate_json_payload(size);
+
+    for (auto _ : state) {
+      auto quote_count = std::size_t{0};
+      for (auto i = std::size_t{0}; i < size; ++i) {
+        quote_count += data[i] == '"' ? 1 : 0;
+      }
+      benchmark::DoNotOptimize(quote_count);
+    }
+  }
+
+  BENCHMARK(bm_standard_count)->RangeMultiplier(8)->Range(1024, 8388608);
+
+  // ============================================================================
+  // Benchmark 8: Vault Unrolled Fill, sequential and on every hardware thread
+  // ============================================================================
+  static void bm_vault_unroll_fill(benchmark::State& state) {
+    auto out = std::vector<std::uint64_t>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+      vault::unroll_loop<unroll_factor>(std::size_t{0}, out.size(), [&](std::size_t i) { out[i] = mix(i); });
+      benchmark::DoNotOptimize(out.data());
+    }
+  }
+
+  BENCHMARK(bm_vault_unroll_fill)->RangeMultiplier(8)->Range(32768, 8388608);
+
+  static void bm_vault_parallel_unroll_fill(benchmark::State& state) {
+    auto out = std::vector<std::uint64_t>(static_cast<std::size_t>(state.range(0)));
+
+    for (auto _ : state) {
+      vault::parallel_unroll_loop<unroll_factor>(std::size_t{0}, out.size(), [&](std::size_t i) { out[i] = mix(i); });
+      benchmark::DoNotOptimize(out.data());
+    }
+  }
+
+  BENCHMARK(bm_vault_parallel_unroll_fill)->RangeMultiplier(8)->Range(32768, 8388608)->UseRealTime();
+
 } // namespace
 
 BENCHMARK_MAIN();
@@ -83,6 +83,24 @@ vault_configure_project_option(
   ENUM ON OFF
 )
 
+vault_configure_project_option(
+  PROJECT     ${VAULT_SHORT_NAME_UPPER}
+  OPTION      METRICS
+  TYPE        BOOL
+  DEFAULT     OFF
+  DESCRIPTION "Record vault::metrics counters and timers in ${PROJECT_NAME} targets?"
+  ENUM ON OFF
+)
+
+vault_configure_project_option(
+  PROJECT     ${VAULT_SHORT_NAME_UPPER}
+  OPTION      BUILD_TIDY_PLUGIN
+  TYPE        BOOL
+  DEFAULT     OFF
+  DESCRIPTION "Build the vault clang-tidy plugin, which needs Clang and clang-tidy-20?"
+  ENUM ON OFF
+)
+
 vault_configure_project_option(
   PROJECT     ${VAULT_SHORT_NAME_UPPER}
   OPTION      CONFIG_FILE_PACKAGE
@@ -0,0 +1,280 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_ALGORITHM_AHO_CORASICK_AUTOMATON_HPP
+#define VAULT_ALGORITHM_AHO_CORASICK_AUTOMATON_HPP
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <vector>
+
+namespace vault::algorithm {
+
+  /**
+   * @brief An Aho-Corasick automaton over a set of patterns.
+   *
+   * The automaton is a trie of the patterns augmented with failure
+   * links. The failure link of a node is the deepest proper suffix of
+   * the node's string that is also a node of the trie (i.e. a prefix
+   * of some pattern). The automaton stores its own copy of one symbol
+   * per node, so the patterns need not outlive it.
+   *
+   * Children are kept in first-child/next-sibling lists and scanned
+   * linearly with `Comp`, which only has to be an equivalence
+   * relation on the symbols. This keeps the automaton usable with the
+   * same comparators as the KMP algorithms at the cost of an O(σ)
+   * transition, where σ is the number of distinct children of a node.
+   *
+   * @tparam Symbol The element type of the patterns.
+   * @tparam Comp Equivalence relation on symbols (default:
+   *   std::equal_to<>).
+   *
+   * @par Complexity
+   * @parblock
+   * - **Construction:** O(L · σ) time and O(L) space, where L is the
+   *   total length of the patterns.
+   * - **Transition:** O(σ) amortized per text symbol.
+   * @endparblock
+   */
+  template <std::copyable Symbol, typename Comp = std::equal_to<>>
+    requires std::predicate<Comp const&, Symbol const&, Symbol const&>
+  class aho_corasick_automaton {
+  public:
+    using node_type   = std::uint32_t;
+    using symbol_type = Symbol;
+
+    static constexpr auto const npos = std::numeric_limits<node_type>::max();
+
+  private:
+    std::vector<symbol_type> m_symbol;
+    std::vector<node_type>   m_depth;
+    std::vector<node_type>   m_first_child;
+    std::vector<node_type>   m_next_sibling;
+    std::vector<node_type>   m_failure;
+    std::vector<node_type>   m_terminal;
+    std::vector<node_type>   m_dictionary_suffix;
+    std::vector<node_type>   m_pattern_node;
+
+    [[no_unique_address]] Comp m_comp;
+
+    constexpr auto add_node(node_type parent, symbol_type const& symbol)
+      -> node_type
+    {
+      assert(m_symbol.size() < npos && "Too many automaton nodes.");
+
+      auto const node = static_cast<node_type>(m_symbol.size());
+
+      m_symbol.push_back(symbol);
+      m_depth.push_back(m_depth[parent] + 1);
+      m_first_child.push_back(npos);
+      m_next_sibling.push_back(m_first_child[parent]);
+      m_failure.push_back(0);
+      m_terminal.push_back(npos);
+      m_dictionary_suffix.push_back(npos);
+
+      m_first_child[parent] = node;
+      return node;
+    }
+
+    constexpr void build_failure_links()
+    {
+      // Breadth-first order guarantees that the failure link of every
+      // node is final before any of its children are visited.
+      auto queue = std::vector<node_type>{};
+      queue.reserve(m_symbol.size());
+
+      for (auto c = m_first_child[root()]; c != npos; c = m_next_sibling[c]) {
+        queue.push_back(c);
+      }
+
+      for (auto head = std::size_t{0}; head < queue.size(); ++head) {
+        auto const node = queue[head];
+
+        for (auto c = m_first_child[node]; c != npos; c = m_next_sibling[c]) {
+          m_failure[c] = transition(m_failure[node], m_symbol[c]);
+          queue.push_back(c);
+        }
+
+        auto const failure        = m_failure[node];
+        m_dictionary_suffix[node] = m_terminal[failure] != npos
+          ? failure
+          : m_dictionary_suffix[failure];
+      }
+    }
+
+  public:
+    /**
+     * @brief Builds the automaton for a range of patterns.
+     *
+     * Patterns are identified by their position in `patterns`. If the
+     * same pattern (under `comp`) occurs more than once, `terminal()`
+     * reports the first occurrence.
+     *
+     * @param patterns The patterns to index.
+     * @param comp Equivalence relation on symbols.
+     */
+    template <std::ranges::input_range Patterns>
+      requires std::ranges::input_range<
+        std::ranges::range_reference_t<Patterns>>
+    [[nodiscard]] constexpr explicit aho_corasick_automaton(
+      Patterns&& patterns, Comp comp = {})
+        : m_comp{std::move(comp)}
+    {
+      // The root has no symbol of its own, but the parallel arrays are
+      // simpler to maintain if it has a slot.
+      m_symbol.emplace_back();
+      m_depth.push_back(0);
+      m_first_child.push_back(npos);
+      m_next_sibling.push_back(npos);
+      m_failure.push_back(0);
+      m_terminal.push_back(npos);
+      m_dictionary_suffix.push_back(npos);
+
+      for (auto&& pattern : patterns) {
+        auto node = root();
+
+        for (auto&& symbol : pattern) {
+          auto const next = child(node, symbol);
+          node            = next != npos ? next : add_node(node, symbol);
+        }
+
+        auto const id = static_cast<node_type>(m_pattern_node.size());
+
+        if (m_terminal[node] == npos) {
+          m_terminal[node] = id;
+        }
+
+        m_pattern_node.push_back(node);
+      }
+
+      build_failure_links();
+    }
+
+    /// The root node, representing the empty string.
+    [[nodiscard]] static constexpr auto root() noexcept -> node_type
+    {
+      return 0;
+    }
+
+    /// The number of nodes in the trie, including the root.
+    [[nodiscard]] constexpr auto size() const noexcept -> std::size_t
+    {
+      return m_symbol.size();
+    }
+
+    /// The number of patterns the automaton was built from.
+    [[nodiscard]] constexpr auto pattern_count() const noexcept -> std::size_t
+    {
+      return m_pattern_node.size();
+    }
+
+    /// The length of the string spelled by the path from the root.
+    [[nodiscard]] constexpr auto depth(node_type node) const noexcept
+      -> std::size_t
+    {
+      return m_depth[node];
+    }
+
+    /// The symbol on the edge into `node`. Unspecified for the root.
+    [[nodiscard]] constexpr auto symbol(node_type node) const noexcept
+      -> symbol_type const&
+    {
+      return m_symbol[node];
+    }
+
+    /// The node for the longest proper suffix of `node` in the trie.
+    [[nodiscard]] constexpr auto failure(node_type node) const noexcept
+      -> node_type
+    {
+      return m_failure[node];
+    }
+
+    /// The first pattern that ends at `node`, or `npos`.
+    [[nodiscard]] constexpr auto terminal(node_type node) const noexcept
+      -> node_type
+    {
+      return m_terminal[node];
+    }
+
+    /**
+     * @brief The nearest node on the failure chain of `node` (excluding
+     * `node` itself) at which a pattern ends, or `npos`.
+     */
+    [[nodiscard]] constexpr auto dictionary_suffix(
+      node_type node) const noexcept -> node_type
+    {
+      return m_dictionary_suffix[node];
+    }
+
+    /// The node at which pattern `id` ends.
+    [[nodiscard]] constexpr auto pattern_node(std::size_t id) const noexcept
+      -> node_type
+    {
+      assert(id < m_pattern_node.size());
+      return m_pattern_node[id];
+    }
+
+    /// The first child of `node`, or `npos` if it is a leaf.
+    [[nodiscard]] constexpr auto first_child(node_type node) const noexcept
+      -> node_type
+    {
+      return m_first_child[node];
+    }
+
+    /// The next sibling of `node`, or `npos` if it is the last child.
+    [[nodiscard]] constexpr auto next_sibling(node_type node) const noexcept
+      -> node_type
+    {
+      return m_next_sibling[node];
+    }
+
+    /// The child of `node` labelled `symbol`, or `npos`.
+    template <typename T>
+      requires std::predicate<Comp const&, symbol_type const&, T const&>
+    [[nodiscard]] constexpr auto child(node_type node, T const& symbol) const
+      -> node_type
+    {
+      for (auto c = m_first_child[node]; c != npos; c = m_next_sibling[c]) {
+        if (std::invoke(m_comp, m_symbol[c], symbol)) {
+          return c;
+        }
+      }
+      return npos;
+    }
+
+    /**
+     * @brief The automaton transition: the state reached after reading
+     * `symbol` in state `node`.
+     */
+    template <typename T>
+      requires std::predicate<Comp const&, symbol_type const&, T const&>
+    [[nodiscard]] constexpr auto transition(
+      node_type node, T const& symbol) const -> node_type
+    {
+      while (true) {
+        if (auto const next = child(node, symbol); next != npos) {
+          return next;
+        }
+        if (node == root()) {
+          return root();
+        }
+        node = m_failure[node];
+      }
+    }
+  };
+
+  // --- Deduction Guides ---
+
+  template <std::ranges::input_range Patterns, typename Comp = std::equal_to<>>
+  aho_corasick_automaton(Patterns&&, Comp = {}) -> aho_corasick_automaton<
+    std::ranges::range_value_t<std::ranges::range_reference_t<Patterns>>,
+    Comp>;
+
+} // namespace vault::algorithm
+
+#endif // VAULT_ALGORITHM_AHO_CORASICK_AUTOMATON_HPP
@@ -4,15 +4,28 @@
 #define VAULT_AMAC_HPP
 
 #include <algorithm>
+#include <array>
 #include <cassert>
+#include <chrono>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <memory>
 #include <ranges>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
+#include <vault/algorithm/perf_counters.hpp>
+#include <vault/metrics/metrics.hpp>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
 /**
  * @defgroup vault_amac Asynchronous Memory Access Coordinator (AMAC)
  *
@@ -137,56 +150,278 @@ namespace vault::amac {
   };
 
   /**
-   * @brief Functional coordinator for managing a batch of AMAC jobs.
+   * @brief What a coordinator did over the batches it ran, for tuning
+   * its TotalFanout.
    * @ingroup vault_amac
    *
-   * @tparam TotalFanout The interleaving degree. Typical values are
-   *   8-16.
+   * Passing stats to a coordinator call turns on recording, which costs a
+   * few increments per step; calls without stats record nothing. Counts
+   * accumulate over every call the same stats are passed to.
+   *
+   * Reading them:
+   * - An average of live jobs well below the slot count means the
+   *   pipeline is rarely full: batches too short, or jobs that finish in
+   *   init().
+   * - Live jobs times prefetches per step well above the 10-12 line fill
+   *   buffers of a core, with many fill-buffer-full cycles, means the
+   *   prefetches queue up; a smaller TotalFanout is as fast.
+   * - Many cycles per step with few L1D misses means the steps are
+   *   compute bound, and interleaving more jobs does not help.
    */
-  template <uint8_t TotalFanout = 16> class coordinator_fn {
-    template <concepts::job_step_result J>
-    static constexpr void prefetch(J const& step_result)
+  struct coordinator_stats {
+    // Calls of the coordinator.
+    std::uint64_t batches = 0;
+
+    // Completed jobs.
+    std::uint64_t jobs = 0;
+
+    // Calls of init() and step().
+    std::uint64_t steps = 0;
+
+    // Non-null addresses prefetched.
+    std::uint64_t prefetches = 0;
+
+    // Passes over the active jobs, and the sum of the active jobs of each.
+    std::uint64_t rounds    = 0;
+    std::uint64_t live_jobs = 0;
+
+    // If not null, counters that run during every batch.
+    algorithm::perf_counters* hardware = nullptr;
+
+    [[nodiscard]] double average_live_jobs() const noexcept
     {
-      [&]<std::size_t... Is>(std::index_sequence<Is...>) {
-        (__builtin_prefetch(std::get<Is>(step_result), 0, 3), ...);
-      }(std::make_index_sequence<std::tuple_size_v<J>>{});
+      return rounds == 0
+        ? 0.0
+        : static_cast<double>(live_jobs) / static_cast<double>(rounds);
+    }
+
+    [[nodiscard]] double steps_per_job() const noexcept
+    {
+      return per_job(steps);
+    }
+
+    [[nodiscard]] double prefetches_per_job() const noexcept
+    {
+      return per_job(prefetches);
     }
 
     /**
-     * @brief Internal storage wrapper to manage job lifecycles.
-     *
-     * Provides manual move-assignment and destruction logic to ensure
-     * non-trivially relocatable jobs (like those containing
-     * std::string) do not suffer from double-free errors during range
-     * compaction.
-     *
-     * @tparam J The specific job type being stored.
+     * @brief The count of a hardware event per job, 0 if there are no
+     * counters or the event is not available.
      */
-    template <typename J> class alignas(J) job_slot {
-      std::byte storage[sizeof(J)];
+    [[nodiscard]] double hardware_per_job(
+      algorithm::perf_counters::event e) const noexcept
+    {
+      return hardware == nullptr ? 0.0 : per_job(hardware->total(e));
+    }
 
-    public:
-      [[nodiscard]] job_slot() = default;
+  private:
+    [[nodiscard]] double per_job(std::uint64_t count) const noexcept
+    {
+      return jobs == 0
+        ? 0.0
+        : static_cast<double>(count) / static_cast<double>(jobs);
+    }
+  };
+} // namespace vault::amac
 
-      job_slot(job_slot const&) = delete;
+namespace vault::amac::detail {
+  // Prefetches every address of a step result for reading.
+  template <concepts::job_step_result J>
+  constexpr void prefetch(J const& step_result)
+  {
+    [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+      (__builtin_prefetch(std::get<Is>(step_result), 0, 3), ...);
+    }(std::make_index_sequence<std::tuple_size_v<J>>{});
+  }
 
-      job_slot& operator=(job_slot&& other)
-      {
-        if (this != std::addressof(other)) {
-          *this->get() = std::move(*other.get());
-        }
+  /**
+   * @brief Internal storage wrapper to manage job lifecycles.
+   *
+   * Provides manual move-assignment and destruction logic to ensure
+   * non-trivially relocatable jobs (like those containing
+   * std::string) do not suffer from double-free errors during range
+   * compaction.
+   *
+   * @tparam J The specific job type being stored.
+   */
+  template <typename J> class alignas(J) job_slot {
+    std::byte storage[sizeof(J)];
+
+  public:
+    [[nodiscard]] job_slot() = default;
+
+    job_slot(job_slot const&) = delete;
 
-        return *this;
+    job_slot& operator=(job_slot&& other)
+    {
+      if (this != std::addressof(other)) {
+        *this->get() = std::move(*other.get());
       }
 
-      job_slot& operator=(job_slot const&) = delete;
+      return *this;
+    }
 
-      [[nodiscard]] J* get() noexcept
-      {
-        return reinterpret_cast<J*>(&storage[0]);
+    job_slot& operator=(job_slot const&) = delete;
+
+    [[nodiscard]] J* get() noexcept
+    {
+      return reinterpret_cast<J*>(&storage[0]);
+    }
+  };
+
+  /**
+   * @brief Destroys the jobs constructed in a run of slots.
+   *
+   * Every slot that the setup constructs holds a job, active or
+   * finished, until the end of the batch. The guard destroys them on
+   * the way out, also when a job or the reporter throws.
+   */
+  template <typename J> class slots_guard {
+    job_slot<J>* m_slots;
+
+  public:
+    std::size_t constructed = 0;
+
+    [[nodiscard]] explicit slots_guard(job_slot<J>* slots) noexcept
+        : m_slots(slots)
+    {}
+
+    slots_guard(slots_guard const&)            = delete;
+    slots_guard& operator=(slots_guard const&) = delete;
+
+    ~slots_guard()
+    {
+      for (std::size_t i = 0; i < constructed; ++i) {
+        std::destroy_at(m_slots[i].get());
       }
-    };
+    }
+  };
+
+  // The batches and jobs of every coordinator in the process, for
+  // vault::metrics.
+  inline const metrics::counter coordinator_batches{"amac.batches"};
+  inline const metrics::counter coordinator_jobs{"amac.jobs"};
+
+  // Counts the jobs of a batch, and records the batch and its jobs into
+  // vault::metrics when it is destroyed. With metrics disabled it is empty
+  // and trivially destructible.
+  template <bool Enabled = metrics::enabled> class batch_metrics {
+    std::uint64_t m_jobs = 0;
+
+  public:
+    [[nodiscard]] constexpr batch_metrics() noexcept = default;
+
+    batch_metrics(batch_metrics const&)            = delete;
+    batch_metrics& operator=(batch_metrics const&) = delete;
+
+    constexpr ~batch_metrics()
+    {
+      coordinator_batches.add();
+      coordinator_jobs.add(m_jobs);
+    }
+
+    constexpr void complete() noexcept
+    {
+      ++m_jobs;
+    }
+  };
+
+  template <> class batch_metrics<false> {
+  public:
+    constexpr void complete() const noexcept {}
+  };
+
+  // Records what a coordinator does into coordinator_stats, or, for
+  // void, only the batch and its jobs into vault::metrics, which is nothing
+  // at all with metrics disabled.
+  template <typename Stats> class stats_recorder;
+
+  template <> class stats_recorder<void> {
+    [[no_unique_address]] batch_metrics<> m_metrics;
+
+  public:
+    [[nodiscard]] constexpr stats_recorder() noexcept = default;
+
+    stats_recorder(stats_recorder const&)            = delete;
+    stats_recorder& operator=(stats_recorder const&) = delete;
+
+    template <typename R>
+    [[nodiscard]] constexpr R&& transition(R&& result) const noexcept
+    {
+      return std::forward<R>(result);
+    }
+
+    constexpr void complete() noexcept
+    {
+      m_metrics.complete();
+    }
 
+    constexpr void round(std::ptrdiff_t) const noexcept {}
+  };
+
+  static_assert(metrics::enabled
+    || (std::is_empty_v<stats_recorder<void>>
+      && std::is_trivially_destructible_v<stats_recorder<void>>));
+
+  template <> class stats_recorder<coordinator_stats> {
+    coordinator_stats& m_stats;
+    std::uint64_t      m_jobs_before;
+
+  public:
+    [[nodiscard]] explicit stats_recorder(coordinator_stats& stats) noexcept
+        : m_stats(stats)
+        , m_jobs_before(stats.jobs)
+    {
+      ++m_stats.batches;
+      if (m_stats.hardware != nullptr) {
+        m_stats.hardware->start();
+      }
+    }
+
+    stats_recorder(stats_recorder const&)            = delete;
+    stats_recorder& operator=(stats_recorder const&) = delete;
+
+    ~stats_recorder()
+    {
+      if (m_stats.hardware != nullptr) {
+        m_stats.hardware->stop();
+      }
+      coordinator_batches.add();
+      coordinator_jobs.add(m_stats.jobs - m_jobs_before);
+    }
+
+    template <concepts::job_step_result R>
+    [[nodiscard]] R&& transition(R&& result) noexcept
+    {
+      ++m_stats.steps;
+      [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+        m_stats.prefetches +=
+          ((std::get<Is>(result) != nullptr ? 1u : 0u) + ... + 0u);
+      }(std::make_index_sequence<
+        std::tuple_size_v<std::remove_cvref_t<R>>>{});
+      return std::forward<R>(result);
+    }
+
+    void complete() noexcept { ++m_stats.jobs; }
+
+    void round(std::ptrdiff_t live_jobs) noexcept
+    {
+      ++m_stats.rounds;
+      m_stats.live_jobs += static_cast<std::uint64_t>(live_jobs);
+    }
+  };
+} // namespace vault::amac::detail
+
+namespace vault::amac {
+  /**
+   * @brief Functional coordinator for managing a batch of AMAC jobs.
+   * @ingroup vault_amac
+   *
+   * @tparam TotalFanout The interleaving degree. Typical values are
+   *   8-16.
+   */
+  template <uint8_t TotalFanout = 16> class coordinator_fn {
   public:
     /**
      * @brief Executes a batch of jobs using the AMAC algorithm.
@@ -213,6 +448,30 @@ namespace vault::amac {
     template <std::ranges::input_range                         Jobs,
       concepts::job_reporter<std::ranges::range_value_t<Jobs>> Reporter>
     static constexpr void operator()(Jobs&& ijobs, Reporter&& reporter)
+    {
+      run(std::forward<Jobs>(ijobs),
+        std::forward<Reporter>(reporter),
+        detail::stats_recorder<void>{});
+    }
+
+    /**
+     * @brief Executes a batch of jobs, and adds what the coordinator did
+     * to `stats`.
+     */
+    template <std::ranges::input_range                         Jobs,
+      concepts::job_reporter<std::ranges::range_value_t<Jobs>> Reporter>
+    static void operator()(
+      Jobs&& ijobs, Reporter&& reporter, coordinator_stats& stats)
+    {
+      run(std::forward<Jobs>(ijobs),
+        std::forward<Reporter>(reporter),
+        detail::stats_recorder<coordinator_stats>{stats});
+    }
+
+  private:
+    template <typename Jobs, typename Reporter, typename Recorder>
+    static constexpr void run(
+      Jobs&& ijobs, Reporter&& reporter, Recorder&& recorder)
     {
       using job_t = std::ranges::range_value_t<Jobs>;
 
@@ -221,7 +480,13 @@ namespace vault::amac {
       static constexpr auto const JOB_COUNT =
         (TotalFanout + job_t::fanout() - 1) / job_t::fanout();
 
-      auto jobs = std::array<job_slot<job_t>, JOB_COUNT>{};
+      auto jobs  = std::array<detail::job_slot<job_t>, JOB_COUNT>{};
+      auto guard = detail::slots_guard<job_t>{jobs.data()};
+
+      auto report = [&](auto&& job) {
+        recorder.complete();
+        std::invoke(reporter, std::forward<decltype(job)>(job));
+      };
 
       auto [jobs_first, jobs_last] = std::invoke([&] {
         auto [jobs_first, jobs_last] = std::ranges::subrange(jobs);
@@ -229,13 +494,14 @@ namespace vault::amac {
         while (jobs_first != jobs_last and ijobs_cursor != ijobs_last) {
           auto&& job = *ijobs_cursor++;
 
-          if (auto addresses = job.init()) {
-            prefetch(addresses);
+          if (auto addresses = recorder.transition(job.init())) {
+            detail::prefetch(addresses);
             std::construct_at(
               jobs_first->get(), std::forward<decltype(job)>(job));
             ++jobs_first;
+            ++guard.constructed;
           } else {
-            std::invoke(reporter, std::move(job));
+            report(std::move(job));
           }
         }
 
@@ -246,45 +512,42 @@ namespace vault::amac {
       // but also takes the appropriate action depending on the jobs
       // state.
       auto is_inactive = [&](auto& job) {
-        if (auto addresses = job.get()->step()) {
-          return prefetch(addresses), false;
+        if (auto addresses = recorder.transition(job.get()->step())) {
+          return detail::prefetch(addresses), false;
         } else {
-          return std::invoke(reporter, std::move(*job.get())), true;
+          return report(std::move(*job.get())), true;
         }
       };
 
       // Loop over the active jobs. Remove any that are complete and
       // replace them with new jobs constructed from the remaining
       // needles. Repeat until all needles are consumed.
+      recorder.round(jobs_last - jobs_first);
       auto jobs_cursor = std::remove_if(jobs_first, jobs_last, is_inactive);
 
       do {
         while (jobs_cursor != jobs_last && ijobs_cursor != ijobs_last) {
           auto&& job = *ijobs_cursor++;
 
-          if (auto addresses = job.init()) {
-            prefetch(addresses);
+          if (auto addresses = recorder.transition(job.init())) {
+            detail::prefetch(addresses);
             *jobs_cursor->get() = std::forward<decltype(job)>(job);
             ++jobs_cursor;
           } else {
-            std::invoke(reporter, std::forward<decltype(job)>(job));
+            report(std::forward<decltype(job)>(job));
           }
         }
 
+        recorder.round(jobs_cursor - jobs_first);
         jobs_cursor = std::remove_if(jobs_first, jobs_cursor, is_inactive);
       } while (ijobs_cursor != ijobs_last);
 
       // Once the needles are consumed, step active jobs until they
       // are all complete.
       while (jobs_cursor != jobs_first) {
+        recorder.round(jobs_cursor - jobs_first);
         jobs_cursor = std::remove_if(jobs_first, jobs_cursor, is_inactive);
       }
-
-      // We manutally constructed the jobs, so we must manually
-      // destroy them.
-      for (; jobs_first != jobs_last; ++jobs_first) {
-        std::destroy_at(jobs_first->get());
-      }
     }
   };
 
@@ -299,7 +562,225 @@ namespace vault::amac {
    *   8-16.
    */
   template <uint8_t TotalFanout = 16>
-  constexpr inline auto const coordinator = coordinator_fn{};
+  constexpr inline auto const coordinator = coordinator_fn<TotalFanout>{};
+} // namespace vault::amac
+
+namespace vault::amac::detail {
+  // A timestamp in ticks of a constant-rate counter: the TSC on x86, the
+  // virtual counter on AArch64, and nanoseconds elsewhere. Only the
+  // ratio of two intervals is used, so the unit does not matter.
+  [[nodiscard]] inline std::uint64_t ticks() noexcept
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    std::uint64_t value;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch())
+        .count());
+#endif
+  }
+
+  /**
+   * @brief Chooses the number of in-flight jobs of an adaptive
+   * coordinator by hill climbing.
+   *
+   * After every window of completed jobs, the cost per job of the window
+   * is compared with that of the window before. While it improves, the
+   * slot count keeps moving in the same direction; once it gets worse,
+   * the direction reverses. The count therefore settles around the
+   * cheapest value and follows it if the cost of the jobs changes.
+   *
+   * @tparam MaxSlots The number of slots of the coordinator.
+   */
+  template <std::size_t MaxSlots> class slot_controller {
+    static_assert(MaxSlots > 0);
+
+    static constexpr auto const STEP =
+      std::max(MaxSlots / 8, std::size_t{1});
+
+    std::size_t    m_active    = MaxSlots;
+    std::ptrdiff_t m_direction = -1;
+    double         m_last_cost = std::numeric_limits<double>::infinity();
+
+  public:
+    // Completed jobs per measurement.
+    static constexpr auto const WINDOW = std::size_t{64};
+
+    [[nodiscard]] constexpr std::size_t active() const noexcept
+    {
+      return m_active;
+    }
+
+    /**
+     * @brief Records the cost per job of the last window and moves the
+     * slot count one step.
+     */
+    constexpr void observe(double cost) noexcept
+    {
+      if (cost > m_last_cost) {
+        m_direction = -m_direction;
+      }
+      m_last_cost = cost;
+
+      auto const step = m_direction * static_cast<std::ptrdiff_t>(STEP);
+      m_active        = static_cast<std::size_t>(
+        std::clamp(static_cast<std::ptrdiff_t>(m_active) + step,
+          std::ptrdiff_t{1},
+          static_cast<std::ptrdiff_t>(MaxSlots)));
+    }
+  };
+} // namespace vault::amac::detail
+
+namespace vault::amac {
+  /**
+   * @brief A coordinator that adjusts the number of in-flight jobs at
+   * run time.
+   * @ingroup vault_amac
+   *
+   * The best number of jobs depends on where the data lives (see
+   * @ref vault_amac): few while the haystack fits in L2 or L3, many once
+   * lookups miss to DRAM. Instead of fixing it at compile time, this
+   * coordinator measures the cycles per completed job over windows of
+   * 64 jobs and moves the number of active slots, between one and the
+   * number `TotalFanout` allows, towards the cheapest. The same call
+   * then performs well for small and huge haystacks alike.
+   *
+   * It is called like `coordinator<TotalFanout>`, so it can be the
+   * `Executor` of the batch lookups of `eytzinger::layout_map`. The
+   * measurement restarts with every call, at the maximum slot count,
+   * so it pays off for batches of some thousands of jobs.
+   *
+   * @tparam TotalFanout The largest interleaving degree.
+   */
+  template <uint8_t TotalFanout = 16> class adaptive_coordinator_fn {
+  public:
+    /**
+     * @brief Executes a batch of jobs, as `coordinator_fn` does, with an
+     * adaptive number of in-flight jobs.
+     *
+     * @param ijobs The input range of job objects to execute.
+     * @param reporter A callable invoked with the Job once it completes.
+     */
+    template <std::ranges::input_range                         Jobs,
+      concepts::job_reporter<std::ranges::range_value_t<Jobs>> Reporter>
+    static void operator()(Jobs&& ijobs, Reporter&& reporter)
+    {
+      run(std::forward<Jobs>(ijobs),
+        std::forward<Reporter>(reporter),
+        detail::stats_recorder<void>{});
+    }
+
+    /**
+     * @brief Executes a batch of jobs, and adds what the coordinator did
+     * to `stats`.
+     */
+    template <std::ranges::input_range                         Jobs,
+      concepts::job_reporter<std::ranges::range_value_t<Jobs>> Reporter>
+    static void operator()(
+      Jobs&& ijobs, Reporter&& reporter, coordinator_stats& stats)
+    {
+      run(std::forward<Jobs>(ijobs),
+        std::forward<Reporter>(reporter),
+        detail::stats_recorder<coordinator_stats>{stats});
+    }
+
+  private:
+    template <typename Jobs, typename Reporter, typename Recorder>
+    static void run(Jobs&& ijobs, Reporter&& reporter, Recorder&& recorder)
+    {
+      using job_t = std::ranges::range_value_t<Jobs>;
+
+      auto [ijobs_cursor, ijobs_last] = std::ranges::subrange(ijobs);
+
+      static constexpr auto const JOB_COUNT =
+        (TotalFanout + job_t::fanout() - 1) / job_t::fanout();
+
+      auto jobs  = std::array<detail::job_slot<job_t>, JOB_COUNT>{};
+      auto guard = detail::slots_guard<job_t>{jobs.data()};
+
+      auto controller   = detail::slot_controller<JOB_COUNT>{};
+      auto completed    = std::size_t{0};
+      auto window_start = detail::ticks();
+
+      auto report = [&](auto&& job) {
+        recorder.complete();
+        std::invoke(reporter, std::forward<decltype(job)>(job));
+
+        if (++completed == controller.WINDOW) {
+          auto const now = detail::ticks();
+          controller.observe(static_cast<double>(now - window_start)
+            / static_cast<double>(completed));
+          completed    = 0;
+          window_start = now;
+        }
+      };
+
+      auto is_inactive = [&](auto& job) {
+        if (auto addresses = recorder.transition(job.get()->step())) {
+          return detail::prefetch(addresses), false;
+        } else {
+          return report(std::move(*job.get())), true;
+        }
+      };
+
+      // The active jobs are [jobs_first, jobs_cursor). Slots are
+      // constructed in order the first time a job is placed in them, and
+      // assigned to afterwards.
+      auto const jobs_first  = std::ranges::begin(jobs);
+      auto       jobs_cursor = jobs_first;
+
+      while (ijobs_cursor != ijobs_last) {
+        auto const jobs_limit =
+          jobs_first + static_cast<std::ptrdiff_t>(controller.active());
+
+        while (jobs_cursor < jobs_limit && ijobs_cursor != ijobs_last) {
+          auto&& job = *ijobs_cursor++;
+
+          if (auto addresses = recorder.transition(job.init())) {
+            detail::prefetch(addresses);
+
+            auto const slot =
+              static_cast<std::size_t>(jobs_cursor - jobs_first);
+            if (slot < guard.constructed) {
+              *jobs_cursor->get() = std::forward<decltype(job)>(job);
+            } else {
+              std::construct_at(
+                jobs_cursor->get(), std::forward<decltype(job)>(job));
+              ++guard.constructed;
+            }
+            ++jobs_cursor;
+          } else {
+            report(std::forward<decltype(job)>(job));
+          }
+        }
+
+        recorder.round(jobs_cursor - jobs_first);
+        jobs_cursor = std::remove_if(jobs_first, jobs_cursor, is_inactive);
+      }
+
+      while (jobs_cursor != jobs_first) {
+        recorder.round(jobs_cursor - jobs_first);
+        jobs_cursor = std::remove_if(jobs_first, jobs_cursor, is_inactive);
+      }
+    }
+  };
+
+  /**
+   * @brief Global instance of the adaptive coordinator.
+   * @ingroup vault_amac
+   *
+   * Usage: `vault::amac::adaptive_coordinator<32>(jobs, reporter);`
+   *
+   * @tparam TotalFanout The largest interleaving degree.
+   */
+  template <uint8_t TotalFanout = 16>
+  constexpr inline auto const adaptive_coordinator =
+    adaptive_coordinator_fn<TotalFanout>{};
 } // namespace vault::amac
 
 template <std::size_t N>
@@ -0,0 +1,297 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_AMAC_COROUTINE_HPP
+#define VAULT_AMAC_COROUTINE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <optional>
+#include <utility>
+
+#include <vault/algorithm/amac.hpp>
+
+namespace vault::amac {
+  /**
+   * @brief An awaitable that suspends a coroutine job until the
+   * coordinator has prefetched up to N addresses.
+   * @ingroup vault_amac
+   *
+   * Awaiting it with only null addresses does not suspend.
+   */
+  template <std::size_t N> struct prefetch_awaitable {
+    job_step_result<N> addresses;
+
+    [[nodiscard]] constexpr bool await_ready() const noexcept
+    {
+      return !static_cast<bool>(addresses);
+    }
+
+    template <typename Promise>
+    constexpr void await_suspend(
+      std::coroutine_handle<Promise> handle) const noexcept
+    {
+      handle.promise().suspend_on(addresses);
+    }
+
+    constexpr void await_resume() const noexcept {}
+  };
+
+  /**
+   * @brief Suspends a coroutine job until `addresses` are prefetched:
+   * `co_await vault::amac::prefetch(node, &node->next);`.
+   * @ingroup vault_amac
+   */
+  template <typename... T>
+  [[nodiscard]] constexpr auto prefetch(T const*... addresses) noexcept
+    -> prefetch_awaitable<sizeof...(T)>
+  {
+    return {{static_cast<void const*>(addresses)...}};
+  }
+} // namespace vault::amac
+
+namespace vault::amac::detail {
+  /**
+   * @brief A per-thread cache of coroutine frames.
+   *
+   * Frames are cached by size, rounded up to a cache line, so after
+   * the first jobs of a batch the coordinator creates and destroys
+   * jobs without calling the global allocator. A frame freed on
+   * another thread than it was allocated on goes to the cache of that
+   * thread.
+   */
+  class coroutine_frame_pool {
+    static constexpr auto const LINE       = std::size_t{64};
+    static constexpr auto const CLASSES    = std::size_t{16};
+    static constexpr auto const MAX_CACHED = std::size_t{256};
+    static constexpr auto const ALIGNMENT  = std::align_val_t{LINE};
+
+    struct free_frame {
+      free_frame* next;
+    };
+
+    struct size_class {
+      free_frame* head  = nullptr;
+      std::size_t count = 0;
+    };
+
+    struct cache {
+      std::array<size_class, CLASSES> classes{};
+
+      cache() = default;
+
+      cache(cache const&)            = delete;
+      cache& operator=(cache const&) = delete;
+
+      ~cache()
+      {
+        for (auto& c : classes) {
+          while (c.head != nullptr) {
+            ::operator delete(std::exchange(c.head, c.head->next), ALIGNMENT);
+          }
+        }
+      }
+    };
+
+    [[nodiscard]] static cache& local() noexcept
+    {
+      thread_local cache instance;
+      return instance;
+    }
+
+    // The size class of a frame of `bytes`, CLASSES if it is too large
+    // to cache.
+    [[nodiscard]] static constexpr std::size_t class_of(
+      std::size_t bytes) noexcept
+    {
+      return (bytes + LINE - 1) / LINE - 1;
+    }
+
+  public:
+    [[nodiscard]] static void* allocate(std::size_t bytes)
+    {
+      auto const k = class_of(bytes);
+      if (k < CLASSES) {
+        auto& c = local().classes[k];
+        if (c.head != nullptr) {
+          --c.count;
+          return std::exchange(c.head, c.head->next);
+        }
+        return ::operator new((k + 1) * LINE, ALIGNMENT);
+      }
+      return ::operator new(bytes, ALIGNMENT);
+    }
+
+    static void deallocate(void* frame, std::size_t bytes) noexcept
+    {
+      auto const k = class_of(bytes);
+      if (k < CLASSES) {
+        auto& c = local().classes[k];
+        if (c.count < MAX_CACHED) {
+          c.head = ::new (frame) free_frame{c.head};
+          ++c.count;
+          return;
+        }
+      }
+      ::operator delete(frame, ALIGNMENT);
+    }
+  };
+} // namespace vault::amac::detail
+
+namespace vault::amac {
+  /**
+   * @brief An AMAC job written as a coroutine.
+   * @ingroup vault_amac
+   *
+   * Instead of a hand-coded state machine, a job is a coroutine that
+   * returns a `coroutine_job` and suspends with
+   * `co_await vault::amac::prefetch(addresses...)` wherever it is about
+   * to touch memory that may miss the cache. The coordinator prefetches
+   * the addresses and resumes it once it has interleaved the other
+   * jobs of its batch. The value of `co_return` is the `result()` the
+   * reporter reads:
+   *
+   * @code
+   * auto find = [&](int key) -> vault::amac::coroutine_job<node const*> {
+   *   for (auto* n = table[hash(key)]; n != nullptr; n = n->next) {
+   *     co_await vault::amac::prefetch(n);
+   *     if (n->key == key) {
+   *       co_return n;
+   *     }
+   *   }
+   *   co_return nullptr;
+   * };
+   * vault::amac::coordinator<16>(keys | std::views::transform(find),
+   *   [](auto&& job) { use(job.result()); });
+   * @endcode
+   *
+   * Frames come from a per-thread pool, so the coordinator loop does not
+   * allocate once the pool is warm. A coroutine that throws propagates
+   * the exception out of the coordinator.
+   *
+   * @tparam T The type of the result.
+   * @tparam N The most addresses one suspension prefetches, which is
+   *   the fanout() of the job.
+   */
+  template <typename T, std::size_t N = 1> class coroutine_job {
+  public:
+    struct promise_type {
+      job_step_result<N> addresses{};
+      std::optional<T>   value;
+
+      [[nodiscard]] static void* operator new(std::size_t bytes)
+      {
+        return detail::coroutine_frame_pool::allocate(bytes);
+      }
+
+      static void operator delete(void* frame, std::size_t bytes) noexcept
+      {
+        detail::coroutine_frame_pool::deallocate(frame, bytes);
+      }
+
+      [[nodiscard]] coroutine_job get_return_object() noexcept
+      {
+        return coroutine_job{handle_type::from_promise(*this)};
+      }
+
+      [[nodiscard]] std::suspend_always initial_suspend() const noexcept
+      {
+        return {};
+      }
+
+      [[nodiscard]] std::suspend_always final_suspend() const noexcept
+      {
+        return {};
+      }
+
+      template <std::convertible_to<T> U> void return_value(U&& result)
+      {
+        value.emplace(std::forward<U>(result));
+      }
+
+      [[noreturn]] void unhandled_exception() const { throw; }
+
+      template <std::size_t M>
+        requires(M <= N)
+      constexpr void suspend_on(job_step_result<M> const& awaited) noexcept
+      {
+        addresses = {};
+        std::copy(awaited.begin(), awaited.end(), addresses.begin());
+      }
+    };
+
+    using handle_type = std::coroutine_handle<promise_type>;
+
+  private:
+    handle_type m_handle;
+
+    explicit coroutine_job(handle_type handle) noexcept
+        : m_handle(handle)
+    {}
+
+    // Runs the coroutine to its next prefetch, or to its end.
+    [[nodiscard]] job_step_result<N> resume()
+    {
+      assert(m_handle && !m_handle.done() && "Resuming a finished job");
+      m_handle.resume();
+      return m_handle.done() ? job_step_result<N>{}
+                             : m_handle.promise().addresses;
+    }
+
+  public:
+    [[nodiscard]] static constexpr uint64_t fanout() { return N; }
+
+    coroutine_job(coroutine_job&& other) noexcept
+        : m_handle(std::exchange(other.m_handle, {}))
+    {}
+
+    coroutine_job& operator=(coroutine_job&& other) noexcept
+    {
+      if (this != &other) {
+        if (m_handle) {
+          m_handle.destroy();
+        }
+        m_handle = std::exchange(other.m_handle, {});
+      }
+      return *this;
+    }
+
+    coroutine_job(coroutine_job const&)            = delete;
+    coroutine_job& operator=(coroutine_job const&) = delete;
+
+    ~coroutine_job()
+    {
+      if (m_handle) {
+        m_handle.destroy();
+      }
+    }
+
+    [[nodiscard]] job_step_result<N> init() { return resume(); }
+
+    [[nodiscard]] job_step_result<N> step() { return resume(); }
+
+    /**
+     * @brief Whether the coroutine has run to its end.
+     */
+    [[nodiscard]] bool done() const noexcept
+    {
+      return m_handle && m_handle.done();
+    }
+
+    /**
+     * @brief The value of `co_return`, once the job is done.
+     */
+    [[nodiscard]] T const& result() const
+    {
+      assert(done() && "The job has not finished");
+      return *m_handle.promise().value;
+    }
+  };
+} // namespace vault::amac
+
+#endif // VAULT_AMAC_COROUTINE_HPP
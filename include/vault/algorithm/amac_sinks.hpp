@@ -0,0 +1,306 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_AMAC_SINKS_HPP
+#define VAULT_AMAC_SINKS_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace vault::amac {
+  /**
+   * @brief A reporter adaptor that passes results on in input order.
+   * @ingroup vault_amac
+   *
+   * The coordinator reports jobs in the order they complete. A reorder
+   * buffer takes them in that order, together with their position in the
+   * input as given by `sequence`, and invokes `sink` with each in input
+   * order, as soon as all those before it have arrived:
+   *
+   * @code
+   * auto in_order = vault::amac::reorder_buffer<job_t, Sequence, Sink>{
+   *   [](job_t const& job) { return job.index(); },
+   *   [&](job_t&& job) { consume(job); }};
+   * vault::amac::coordinator<16>(jobs, in_order);
+   * @endcode
+   *
+   * Only the results that arrive ahead of an earlier one are held, in a
+   * ring that starts at `capacity` entries and doubles when a result
+   * arrives further ahead than that. With jobs of similar length, such as
+   * the lookups of one map, results arrive at most a few times the number
+   * of jobs in flight ahead, so the ring stays at its initial size.
+   *
+   * Sequences must start at zero and be distinct. After the last result
+   * of a batch, nothing is held.
+   *
+   * @tparam T The type of a result, e.g. the job type.
+   * @tparam Sequence A callable that returns the input position of a T.
+   * @tparam Sink A callable invoked with every T in input order.
+   */
+  template <typename T, typename Sequence, typename Sink>
+    requires std::move_constructible<T>
+    && std::regular_invocable<Sequence&, T const&>
+    && std::invocable<Sink&, T&&>
+  class reorder_buffer {
+    Sequence                      m_sequence;
+    Sink                          m_sink;
+    std::vector<std::optional<T>> m_ring;
+    std::size_t                   m_next    = 0;
+    std::size_t                   m_pending = 0;
+
+    [[nodiscard]] std::optional<T>& entry(std::size_t sequence) noexcept
+    {
+      return m_ring[sequence & (m_ring.size() - 1)];
+    }
+
+    void grow(std::size_t distance)
+    {
+      auto ring = std::vector<std::optional<T>>(std::bit_ceil(distance + 1));
+      for (std::size_t s = m_next; s < m_next + m_ring.size(); ++s) {
+        if (auto& held = entry(s)) {
+          ring[s & (ring.size() - 1)] = std::move(held);
+        }
+      }
+      m_ring = std::move(ring);
+    }
+
+  public:
+    static constexpr auto const DEFAULT_CAPACITY = std::size_t{64};
+
+    [[nodiscard]] explicit reorder_buffer(Sequence sequence,
+      Sink                                         sink,
+      std::size_t                                  capacity = DEFAULT_CAPACITY)
+        : m_sequence(std::move(sequence))
+        , m_sink(std::move(sink))
+        , m_ring(std::bit_ceil(std::max(capacity, std::size_t{1})))
+    {}
+
+    /**
+     * @brief Takes a result, and passes it and every held result that
+     * follows it on to the sink if it is the next in input order.
+     */
+    void operator()(T&& value)
+    {
+      auto const sequence = static_cast<std::size_t>(
+        std::invoke(m_sequence, std::as_const(value)));
+      assert(sequence >= m_next && "A sequence was reported twice");
+
+      if (sequence != m_next) {
+        if (sequence - m_next >= m_ring.size()) {
+          grow(sequence - m_next);
+        }
+        entry(sequence).emplace(std::move(value));
+        ++m_pending;
+        return;
+      }
+
+      std::invoke(m_sink, std::move(value));
+      ++m_next;
+
+      while (m_pending > 0) {
+        auto& held = entry(m_next);
+        if (!held) {
+          break;
+        }
+        std::invoke(m_sink, std::move(*held));
+        held.reset();
+        --m_pending;
+        ++m_next;
+      }
+    }
+
+    void operator()(T const& value)
+      requires std::copy_constructible<T>
+    {
+      (*this)(T(value));
+    }
+
+    /**
+     * @brief The input position of the next result the sink receives.
+     */
+    [[nodiscard]] std::size_t next() const noexcept { return m_next; }
+
+    /**
+     * @brief The number of results held until those before them arrive.
+     */
+    [[nodiscard]] std::size_t pending() const noexcept { return m_pending; }
+
+    /**
+     * @brief The number of results the ring holds before it grows.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+      return m_ring.size();
+    }
+  };
+
+  /**
+   * @brief A sink that appends results to an array a cache line at a time,
+   * with stores that bypass the cache.
+   * @ingroup vault_amac
+   *
+   * Results are staged in a line-sized buffer and written out when it
+   * fills, so the destination sees whole-line writes in address order
+   * instead of scattered stores. On x86 the lines go out as non-temporal
+   * stores, which neither read the line for ownership nor evict the
+   * haystack of the lookups from the cache. Elsewhere they are copied.
+   *
+   * The destination must have room for every result. Results reach it by
+   * the time flush() or the destructor returns.
+   *
+   * @tparam T A result type that is copied as bytes: trivially copy
+   *   constructible and destructible, like a std::pair of iterators.
+   */
+  template <typename T>
+    requires std::is_trivially_copy_constructible_v<T>
+    && std::is_trivially_destructible_v<T>
+  class streaming_sink {
+    static constexpr auto const LINE = std::size_t{64};
+
+    // The line of the destination that is being staged, and the range of
+    // its bytes staged so far. Only the first line can start past zero.
+    std::byte*              m_line;
+    std::size_t             m_first;
+    std::size_t             m_last;
+    std::size_t             m_size = 0;
+    alignas(LINE) std::byte m_staging[LINE];
+
+    void write_line()
+    {
+#if defined(__SSE2__)
+      if (m_first == 0 && m_last == LINE) {
+        for (std::size_t i = 0; i < LINE; i += sizeof(__m128i)) {
+          _mm_stream_si128(reinterpret_cast<__m128i*>(m_line + i),
+            _mm_load_si128(reinterpret_cast<__m128i const*>(m_staging + i)));
+        }
+        return;
+      }
+#endif
+      std::memcpy(m_line + m_first, m_staging + m_first, m_last - m_first);
+    }
+
+  public:
+    /**
+     * @param out The first element of the destination.
+     */
+    [[nodiscard]] explicit streaming_sink(T* out) noexcept
+        : m_line(reinterpret_cast<std::byte*>(
+            reinterpret_cast<std::uintptr_t>(out) & ~(LINE - 1)))
+        , m_first(reinterpret_cast<std::uintptr_t>(out) & (LINE - 1))
+        , m_last(m_first)
+    {}
+
+    streaming_sink(streaming_sink const&)            = delete;
+    streaming_sink& operator=(streaming_sink const&) = delete;
+
+    ~streaming_sink() { flush(); }
+
+    /**
+     * @brief Appends a result.
+     */
+    void operator()(T const& value)
+    {
+      auto const* bytes     = reinterpret_cast<std::byte const*>(&value);
+      auto        remaining = sizeof(T);
+
+      while (remaining > 0) {
+        auto const n = std::min(remaining, LINE - m_last);
+        std::memcpy(m_staging + m_last, bytes, n);
+        m_last += n;
+        bytes += n;
+        remaining -= n;
+
+        if (m_last == LINE) {
+          write_line();
+          m_line += LINE;
+          m_first = 0;
+          m_last  = 0;
+        }
+      }
+      ++m_size;
+    }
+
+    /**
+     * @brief Writes the staged part of the current line and orders the
+     * streamed lines before any later store.
+     */
+    void flush()
+    {
+      if (m_last > m_first) {
+        write_line();
+        m_first = m_last;
+      }
+#if defined(__SSE2__)
+      _mm_sfence();
+#endif
+    }
+
+    /**
+     * @brief The number of results appended.
+     */
+    [[nodiscard]] std::size_t size() const noexcept { return m_size; }
+  };
+
+  /**
+   * @brief An output iterator that invokes a sink with every value
+   * assigned through it.
+   * @ingroup vault_amac
+   *
+   * It lets the sinks of this header stand in for the output iterator of
+   * the batch lookups of `eytzinger::layout_map`:
+   *
+   * @code
+   * map.batch_find(vault::amac::coordinator<16>, needles,
+   *   vault::amac::sink_iterator(in_order));
+   * @endcode
+   *
+   * The sink is referenced, not copied, so it must outlive the iterator.
+   */
+  template <typename Sink> class sink_iterator {
+    Sink* m_sink = nullptr;
+
+    struct proxy {
+      Sink* sink;
+
+      template <typename U>
+        requires std::invocable<Sink&, U&&>
+      proxy const& operator=(U&& value) const
+      {
+        std::invoke(*sink, std::forward<U>(value));
+        return *this;
+      }
+    };
+
+  public:
+    using difference_type = std::ptrdiff_t;
+
+    [[nodiscard]] sink_iterator() = default;
+
+    [[nodiscard]] explicit sink_iterator(Sink& sink) noexcept
+        : m_sink(std::addressof(sink))
+    {}
+
+    [[nodiscard]] proxy operator*() const noexcept { return {m_sink}; }
+
+    sink_iterator& operator++() noexcept { return *this; }
+
+    sink_iterator operator++(int) noexcept { return *this; }
+  };
+} // namespace vault::amac
+
+#endif // VAULT_AMAC_SINKS_HPP
@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_ALGORITHM_BATCH_KNUTH_MORRIS_PRATT_SEARCH_HPP
+#define VAULT_ALGORITHM_BATCH_KNUTH_MORRIS_PRATT_SEARCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <utility>
+
+#include <vault/algorithm/amac.hpp>
+#include <vault/algorithm/knuth_morris_pratt_failure_function.hpp>
+
+namespace vault::algorithm {
+
+  namespace detail {
+    // Searches one text for the first occurrence of one pattern, a
+    // block of text at a time. Every step prefetches the block the next
+    // step reads, so that the blocks of the other jobs in flight are
+    // scanned while it arrives.
+    template <typename PatternI, typename TextI, typename Comp>
+    class knuth_morris_pratt_search_job {
+      using SymbolI =
+        std::ranges::iterator_t<std::iter_reference_t<PatternI>>;
+
+      PatternI                      m_pattern;
+      SymbolI                       m_pattern_first;
+      std::span<int const>          m_failure_table;
+      TextI                         m_cursor;
+      TextI                         m_text_last;
+      std::iter_difference_t<TextI> m_stride;
+      std::ptrdiff_t                m_matched = 0;
+      Comp const*                   m_comp;
+
+      [[nodiscard]] auto length() const noexcept -> std::ptrdiff_t
+      {
+        return static_cast<std::ptrdiff_t>(m_failure_table.size());
+      }
+
+      [[nodiscard]] auto done() const noexcept -> bool
+      {
+        return m_matched == length() || m_cursor == m_text_last;
+      }
+
+      [[nodiscard]] auto next() const noexcept -> amac::job_step_result<1>
+      {
+        if (done()) {
+          return {nullptr};
+        }
+        return {std::addressof(*m_cursor)};
+      }
+
+    public:
+      [[nodiscard]] static constexpr auto fanout() -> std::uint64_t
+      {
+        return 1uz;
+      }
+
+      [[nodiscard]] knuth_morris_pratt_search_job(PatternI pattern,
+        std::span<int const>                              failure_table,
+        TextI                                             text_first,
+        TextI                                             text_last,
+        std::iter_difference_t<TextI>                     stride,
+        Comp const&                                       comp)
+          : m_pattern{pattern}
+          , m_pattern_first{std::ranges::begin(*pattern)}
+          , m_failure_table{failure_table}
+          , m_cursor{text_first}
+          , m_text_last{text_last}
+          , m_stride{stride}
+          , m_comp{std::addressof(comp)}
+      {}
+
+      [[nodiscard]] auto init() const noexcept -> amac::job_step_result<1>
+      {
+        return next();
+      }
+
+      [[nodiscard]] auto step() -> amac::job_step_result<1>
+      {
+        // The state is kept in locals while scanning, since stores
+        // through the text might otherwise alias it.
+        auto       cursor     = m_cursor;
+        auto       matched    = m_matched;
+        auto const length     = this->length();
+        auto const pattern    = m_pattern_first;
+        auto const table      = m_failure_table.data();
+        auto const& comp      = *m_comp;
+        auto const block_last = cursor
+          + std::min(m_stride, std::ranges::distance(cursor, m_text_last));
+
+        for (; cursor != block_last; ++cursor) {
+          auto const& symbol = *cursor;
+
+          while (matched > 0 && !std::invoke(comp, symbol, pattern[matched])) {
+            matched = table[matched - 1];
+          }
+
+          if (std::invoke(comp, symbol, pattern[matched])
+            && ++matched == length) {
+            ++cursor;
+            break;
+          }
+        }
+
+        m_cursor  = cursor;
+        m_matched = matched;
+
+        return next();
+      }
+
+      /// The iterator to the pattern this job searched for.
+      [[nodiscard]] auto pattern() const noexcept -> PatternI
+      {
+        return m_pattern;
+      }
+
+      /// The first occurrence, or an empty range at the end of the text.
+      [[nodiscard]] auto match() const noexcept
+        -> std::ranges::subrange<TextI>
+      {
+        if (m_matched == length()) {
+          return {m_cursor - length(), m_cursor};
+        }
+        return {m_text_last, m_text_last};
+      }
+    };
+  } // namespace detail
+
+  /**
+   * @brief Searches one text for the first occurrence of each of many
+   * patterns, interleaving the searches on an AMAC coordinator.
+   *
+   * Searching for one pattern at a time runs a single KMP automaton,
+   * whose every step depends on the previous one through a
+   * data-dependent branch. Here every pattern is an AMAC job that scans
+   * the text a block at a time, so the coordinator steps several
+   * independent automata in turn and their latencies overlap, and each
+   * job prefetches its next block of the text before yielding.
+   *
+   * Results are written as `std::pair{pattern, match}` in completion
+   * order, where `pattern` is an iterator into `patterns` and `match`
+   * is the first occurrence of the pattern in `text`, as
+   * `knuth_morris_pratt_searcher` would report it: an empty pattern
+   * matches at the beginning, and a pattern that does not occur yields
+   * an empty range at the end of the text.
+   *
+   * @code
+   * auto matches = std::vector<std::pair<iterator, subrange>>{};
+   * vault::algorithm::batch_knuth_morris_pratt_search(
+   *   vault::amac::coordinator<8>, text, patterns,
+   *   std::back_inserter(matches));
+   * @endcode
+   *
+   * @par Complexity
+   * @parblock
+   * O(n · N) time for n patterns and a text of length N, and O(M)
+   * space for the failure tables of patterns of total length M.
+   * @endparblock
+   */
+  constexpr inline struct batch_knuth_morris_pratt_search_fn {
+    /// The number of bytes of text a job scans per step.
+    static constexpr auto const block_bytes = std::size_t{4096};
+
+    /**
+     * @param executor An AMAC coordinator, e.g.
+     *   `vault::amac::coordinator<8>`.
+     * @param text The text to search.
+     * @param patterns The patterns to search for.
+     * @param out Receives one `std::pair{pattern, match}` per pattern.
+     * @param comp Equivalence relation on the symbols.
+     */
+    template <typename Executor,
+      std::ranges::random_access_range Text,
+      std::ranges::random_access_range Patterns,
+      typename Out,
+      typename Comp = std::equal_to<>>
+      requires std::ranges::random_access_range<
+                 std::ranges::range_reference_t<Patterns const>>
+      && std::indirect_binary_predicate<Comp const&,
+        std::ranges::iterator_t<Text const>,
+        std::ranges::iterator_t<
+          std::ranges::range_reference_t<Patterns const>>>
+    static void operator()(Executor&& executor,
+      Text const&                     text,
+      Patterns const&                 patterns,
+      Out                             out,
+      Comp                            comp = {})
+    {
+      using TextI    = std::ranges::iterator_t<Text const>;
+      using PatternI = std::ranges::iterator_t<Patterns const>;
+      using job_t =
+        detail::knuth_morris_pratt_search_job<PatternI, TextI, Comp>;
+
+      auto const tables = knuth_morris_pratt_failure_tables{patterns, comp};
+
+      auto const stride = static_cast<std::iter_difference_t<TextI>>(
+        std::max(block_bytes / sizeof(std::iter_value_t<TextI>),
+          std::size_t{1}));
+
+      auto const first = std::ranges::begin(patterns);
+
+      auto jobs = std::views::iota(std::size_t{0}, tables.size())
+        | std::views::transform([&](std::size_t i) {
+            return job_t{first + static_cast<std::ptrdiff_t>(i),
+              tables[i],
+              std::ranges::begin(text),
+              std::ranges::end(text),
+              stride,
+              comp};
+          });
+
+      auto reporter = [&](job_t&& job) {
+        *out++ = std::pair{job.pattern(), job.match()};
+      };
+
+      std::invoke(std::forward<Executor>(executor), jobs, reporter);
+    }
+  } const batch_knuth_morris_pratt_search{};
+
+} // namespace vault::algorithm
+
+#endif // VAULT_ALGORITHM_BATCH_KNUTH_MORRIS_PRATT_SEARCH_HPP
@@ -0,0 +1,205 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_ALGORITHM_FSST_DECODE_CACHE_HPP
+#define VAULT_ALGORITHM_FSST_DECODE_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <boost/unordered/unordered_flat_map.hpp>
+
+#include <vault/algorithm/fsst_dictionary.hpp>
+#include <vault/metrics/metrics.hpp>
+
+namespace vault::algorithm {
+
+  namespace detail {
+    // The lookups of every cache in the process, for vault::metrics.
+    inline const metrics::counter fsst_decode_cache_hits{"fsst_decode_cache.hits"};
+    inline const metrics::counter fsst_decode_cache_misses{"fsst_decode_cache.misses"};
+  } // namespace detail
+
+  /// @brief A bounded cache of decoded values over an fsst_dictionary.
+  ///
+  /// @details
+  /// Lookups that hit return a view of bytes decoded earlier instead of
+  /// decompressing again, which pays off when a few keys make up most of the
+  /// lookups. Values are evicted with the CLOCK algorithm, an approximation of
+  /// least-recently-used that only sets a bit on a hit, once the decoded bytes
+  /// would exceed the budget. Keys of inline values are decoded every time,
+  /// since that costs less than a lookup in the cache.
+  ///
+  /// A cache is not synchronized: give each thread its own, for instance as a
+  /// `thread_local`, so that the hot path takes no lock and the views it
+  /// returns cannot be evicted by another thread. The dictionary must outlive
+  /// the cache.
+  ///
+  /// @code
+  /// thread_local auto cache = vault::algorithm::fsst_decode_cache{dict};
+  /// if (auto const value = cache.find(key)) {
+  ///   consume(*value);
+  /// }
+  /// @endcode
+  class fsst_decode_cache {
+  public:
+    /// @brief Configuration for the number of bytes the cache may hold,
+    /// counting the decoded values and a fixed overhead per value.
+    struct byte_budget {
+      std::size_t value = std::size_t{1} << 20;
+    };
+
+    /// @brief Counters of the lookups since construction or `clear`.
+    struct statistics {
+      std::uint64_t hits      = 0;
+      std::uint64_t misses    = 0;
+      std::uint64_t evictions = 0;
+    };
+
+    /// @brief The bytes charged for every cached value in addition to its
+    /// length, an estimate of its slot and its entry in the index.
+    static constexpr auto const entry_overhead =
+      sizeof(fsst_key) + sizeof(std::string) + 2 * sizeof(std::uint64_t);
+
+    explicit fsst_decode_cache(fsst_dictionary_base const& dict,
+      byte_budget budget = byte_budget{std::size_t{1} << 20})
+        : m_dict(&dict)
+        , m_budget(budget.value)
+    {}
+
+    /// @brief Returns the value of `key`, decoding and caching it on a miss.
+    /// @return A view that is valid until the next call to `find` or `clear`
+    /// on this cache, or std::nullopt if `key` is not found.
+    [[nodiscard]] auto find(fsst_key key) -> std::optional<std::string_view>
+    {
+      if (fsst_dictionary_base::is_inline_key(key)) {
+        if (!try_find(*m_dict, key, m_scratch)) {
+          return std::nullopt;
+        }
+        return std::string_view{m_scratch};
+      }
+
+      if (auto const it = m_index.find(key.value); it != m_index.end()) {
+        auto& slot      = m_slots[it->second];
+        slot.referenced = true;
+        ++m_stats.hits;
+        detail::fsst_decode_cache_hits.add();
+        return std::string_view{slot.value};
+      }
+
+      ++m_stats.misses;
+      detail::fsst_decode_cache_misses.add();
+      if (!try_find(*m_dict, key, m_scratch)) {
+        return std::nullopt;
+      }
+
+      auto const cost = m_scratch.size() + entry_overhead;
+      if (cost > m_budget) {
+        return std::string_view{m_scratch};
+      }
+
+      while (m_used + cost > m_budget) {
+        evict_one();
+      }
+
+      auto const index = acquire_slot();
+      auto&      slot  = m_slots[index];
+      slot.key         = key;
+      slot.value.assign(m_scratch);
+      slot.referenced = false;
+      slot.occupied   = true;
+
+      m_index.emplace(key.value, index);
+      m_used += cost;
+      return std::string_view{slot.value};
+    }
+
+    /// @brief Drops every cached value and resets the counters.
+    void clear()
+    {
+      m_index.clear();
+      m_slots.clear();
+      m_free.clear();
+      m_hand  = 0;
+      m_used  = 0;
+      m_stats = {};
+    }
+
+    [[nodiscard]] auto stats() const noexcept -> statistics
+    {
+      return m_stats;
+    }
+
+    /// @brief The number of cached values.
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+      return m_index.size();
+    }
+
+    /// @brief The bytes charged against the budget.
+    [[nodiscard]] auto size_in_bytes() const noexcept -> std::size_t
+    {
+      return m_used;
+    }
+
+  private:
+    struct slot {
+      fsst_key    key{};
+      std::string value;
+      bool        referenced = false;
+      bool        occupied   = false;
+    };
+
+    auto acquire_slot() -> std::size_t
+    {
+      if (!m_free.empty()) {
+        auto const index = m_free.back();
+        m_free.pop_back();
+        return index;
+      }
+      m_slots.emplace_back();
+      return m_slots.size() - 1;
+    }
+
+    // Advances the hand past referenced slots, clearing their bits, and
+    // evicts the first slot that has not been hit since the hand last passed.
+    void evict_one()
+    {
+      while (true) {
+        if (m_hand >= m_slots.size()) {
+          m_hand = 0;
+        }
+
+        auto& slot = m_slots[m_hand];
+        if (slot.occupied && !slot.referenced) {
+          m_used -= slot.value.size() + entry_overhead;
+          m_index.erase(slot.key.value);
+          std::string{}.swap(slot.value);
+          slot.occupied = false;
+          m_free.push_back(m_hand++);
+          ++m_stats.evictions;
+          return;
+        }
+
+        slot.referenced = false;
+        ++m_hand;
+      }
+    }
+
+    fsst_dictionary_base const*                           m_dict;
+    std::size_t                                           m_budget;
+    std::size_t                                           m_used = 0;
+    std::size_t                                           m_hand = 0;
+    boost::unordered_flat_map<std::uint64_t, std::size_t> m_index;
+    std::vector<slot>                                     m_slots;
+    std::vector<std::size_t>                              m_free;
+    std::string                                           m_scratch;
+    statistics                                            m_stats;
+  };
+
+} // namespace vault::algorithm
+
+#endif // VAULT_ALGORITHM_FSST_DECODE_CACHE_HPP
@@ -4,21 +4,31 @@
 #define VAULT_ALGORITHM_FSST_DICTIONARY_HPP
 
 #include <algorithm> // for std::clamp
+#include <concepts>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <filesystem>
 #include <functional>
 #include <iterator>
 #include <memory>
 #include <optional>
+#include <random>
 #include <ranges>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/transform.hpp>
 
+#include <vault/metrics/metrics.hpp>
+
 namespace vault::algorithm {
 
   /// @brief A lightweight, opaque handle to a string stored in an
@@ -39,6 +49,71 @@ namespace vault::algorithm {
 
   static_assert(sizeof(fsst_key) == 8, "fsst_key must be exactly 8 bytes");
 
+  class fsst_dictionary_base;
+
+  /// @brief A query string prepared for comparison with the values of an
+  /// fsst_dictionary.
+  ///
+  /// @details
+  /// Created by `fsst_dictionary_base::compress_probe`, which compresses the
+  /// query with the dictionary's symbol table, so that `equals` and
+  /// `starts_with` can compare compressed bytes instead of decoding. A probe
+  /// used with another dictionary, or created by one that cannot compress
+  /// (such as a dictionary opened with `open_mapped`), still gives correct
+  /// answers, by decoding.
+  class fsst_probe {
+  public:
+    /// @brief The query string.
+    [[nodiscard]] auto text() const noexcept -> std::string_view
+    {
+      return m_text;
+    }
+
+  private:
+    friend class fsst_dictionary_base;
+
+    std::string                m_text;
+    std::vector<unsigned char> m_codes;
+    void const*                m_source = nullptr;
+  };
+
+  /// @brief A callable that yields views of the strings to store, then
+  /// `std::nullopt`. The viewed memory must stay valid until the build
+  /// returns.
+  template <typename G>
+  concept fsst_view_generator = std::invocable<G&>
+    && std::same_as<std::invoke_result_t<G&>, std::optional<std::string_view>>;
+
+  /// @brief A callable that yields the strings to store by value, then
+  /// `std::nullopt`.
+  template <typename G>
+  concept fsst_rvalue_generator = std::invocable<G&>
+    && std::same_as<std::invoke_result_t<G&>, std::optional<std::string>>;
+
+  template <typename G>
+  concept fsst_generator = fsst_view_generator<G> || fsst_rvalue_generator<G>;
+
+  /// @brief A callable that maps a string to `{index, inserted}`, handing out
+  /// consecutive indices to new strings.
+  template <typename D>
+  concept fsst_deduplicator = std::invocable<D&, std::string_view>
+    && std::convertible_to<std::invoke_result_t<D&, std::string_view>,
+      std::pair<std::uint64_t, bool>>;
+
+  template <typename E>
+  concept fsst_key_sink = std::invocable<E&, fsst_key>;
+
+  /// @brief A callable that returns a new generator on every call, each
+  /// yielding the same strings in the same order.
+  template <typename P>
+  concept fsst_pass_factory =
+    std::invocable<P&> && fsst_generator<std::invoke_result_t<P&>>;
+
+  namespace detail {
+    // Nanoseconds per dictionary built, for vault::metrics.
+    inline const metrics::histogram fsst_build_metric{"fsst_dictionary.build_ns"};
+  } // namespace detail
+
   /// @brief Base class for FSST dictionary implementation.
   ///
   /// @details
@@ -60,6 +135,16 @@ namespace vault::algorithm {
       std::size_t value = 9;
     };
 
+    /// @brief Configuration for the number of threads that compress strings
+    /// during construction. Zero selects `std::thread::hardware_concurrency()`.
+    /// @details
+    /// Only compression runs concurrently: the generator and the
+    /// deduplicator are always invoked on the calling thread, in input order,
+    /// and the resulting dictionary and keys do not depend on this value.
+    struct thread_count {
+      std::size_t value = 1;
+    };
+
     /// @brief Generator for Views (Zero-Copy).
     /// @details
     /// Returns a view into **stable, existing memory**.
@@ -76,6 +161,19 @@ namespace vault::algorithm {
     /// - `std::nullopt` signals the end of the sequence.
     using RValueGenerator = std::function<std::optional<std::string>()>;
 
+    /// @brief Source of repeatable passes over the input of a streaming build.
+    /// @details
+    /// Every call must return a new generator that yields the same strings in
+    /// the same order.
+    using RValueGeneratorFactory = std::function<RValueGenerator()>;
+
+    /// @brief Configuration for the number of strings a streaming build keeps
+    /// to train the encoder on. Strings of up to 7 bytes are stored inline and
+    /// are never sampled.
+    struct reservoir_size {
+      std::size_t value = 16384;
+    };
+
     /// @brief Deduplication callback strategy.
     /// @param s The string to look up or insert.
     /// @return A pair `{index, inserted}`. If `inserted` is true, the string is
@@ -111,6 +209,24 @@ namespace vault::algorithm {
     [[nodiscard]] bool        empty() const;
     [[nodiscard]] std::size_t size_in_bytes() const;
 
+    // --- Persistence ---
+
+    /// @brief Writes the symbol table and the compressed strings to `path`,
+    /// in a page-aligned layout that `open_mapped` maps back in place.
+    /// @details Keys issued when the dictionary was built stay valid for
+    /// every dictionary opened from the file, in this process or another.
+    /// @throws std::ios_base::failure if the file cannot be written.
+    void save(std::filesystem::path const& path) const;
+
+    /// @brief Maps a dictionary written by `save` read-only.
+    /// @details Nothing is retrained or copied except the symbol table: the
+    /// compressed strings are read from the page cache as they are looked
+    /// up, so every process that opens the same file shares one copy.
+    /// @throws std::system_error if the file cannot be opened or mapped, and
+    /// std::runtime_error if it is not an fsst_dictionary file.
+    [[nodiscard]] static auto open_mapped(std::filesystem::path const& path)
+      -> fsst_dictionary_base;
+
     // --- Helpers for Key Generation ---
 
     /// @brief Checks if a string is small enough to fit inline in an fsst_key.
@@ -122,6 +238,14 @@ namespace vault::algorithm {
     /// @throws std::length_error if s.size() > 7.
     [[nodiscard]] static fsst_key make_inline_key(std::string_view s);
 
+    /// @brief Checks if a key holds its string inline, rather than referring
+    /// to compressed data.
+    [[nodiscard]] static bool is_inline_key(fsst_key k) noexcept;
+
+    /// @brief The number of low bits of a pointer key that hold the offset of
+    /// its compressed data, which bounds `size_in_bytes()` to 1 TiB.
+    static constexpr auto const pointer_offset_bits = 40uz;
+
     /// @brief Converts an integer compression level (0-9) to a sampling ratio.
     [[nodiscard]] static constexpr inline auto level_to_ratio(
       compression_level level) -> sample_ratio
@@ -135,6 +259,33 @@ namespace vault::algorithm {
       return fsst_dictionary_base::compression_levels[clamped_level];
     }
 
+    // --- Compressed-Domain Comparison ---
+
+    /// @brief Compresses `query` with this dictionary's symbol table, for use
+    /// with `equals` and `starts_with`.
+    [[nodiscard]] auto compress_probe(std::string_view query) const
+      -> fsst_probe;
+
+    /// @brief Checks whether the value of `key` is the text of `probe`.
+    /// @details
+    /// FSST encodes deterministically, so a value equals the query exactly
+    /// when their encodings agree. The compressed bytes are compared first,
+    /// and the value is only decoded from the first symbol at which the two
+    /// encodings differ, to settle the comparison.
+    /// @return false if `key` is not found.
+    [[nodiscard]] auto equals(fsst_key key, fsst_probe const& probe) const
+      -> bool;
+
+    /// @brief Checks whether the value of `key` begins with the text of
+    /// `probe`.
+    /// @details
+    /// As `equals`. Near the end of the query, the encodings can differ even
+    /// when the value begins with it, because a symbol of the value may span
+    /// the end of the query; those few symbols are decoded.
+    /// @return false if `key` is not found.
+    [[nodiscard]] auto starts_with(fsst_key key, fsst_probe const& probe) const
+      -> bool;
+
     // --- Generic Lookup API ---
 
     /// @brief Tries to find and decompress the value for `key` into an existing
@@ -190,23 +341,49 @@ namespace vault::algorithm {
       return std::nullopt;
     }
 
+    /// @brief Decompresses a batch of keys, fetching the compressed bytes of
+    /// several keys ahead of decoding them.
+    /// @details
+    /// The keys are decoded as jobs on an AMAC coordinator (see amac.hpp), so
+    /// the cache misses on the compressed data of up to eight pointer keys
+    /// overlap instead of being paid one after another.
+    /// @param sink Invoked as `sink(i, value)` for every key that is found,
+    /// where `i` is the index of the key in `keys`. Calls are not necessarily
+    /// in index order, and `value` is only valid for the duration of the call.
+    /// @return The number of keys found.
+    template <std::invocable<std::size_t, std::string_view> Sink>
+    friend inline auto try_find_many(fsst_dictionary_base const& dict,
+      std::span<fsst_key const>                                  keys,
+      Sink&& sink) -> std::size_t
+    {
+      return dict.decompress_many(
+        keys, [&sink](std::size_t i, std::string_view value) {
+          std::invoke(sink, i, value);
+        });
+    }
+
     // --- Core Factories (View Based) ---
 
     [[nodiscard]] static auto build(Generator gen,
       Deduplicator                            dedup,
       std::function<void(fsst_key)>           emit_key,
-      sample_ratio ratio = sample_ratio{1.}) -> fsst_dictionary_base;
+      sample_ratio ratio   = sample_ratio{1.},
+      thread_count threads = thread_count{1}) -> fsst_dictionary_base;
 
     [[nodiscard]] static auto build_from_unique(Generator gen,
       std::function<void(fsst_key)>                       emit_key,
-      sample_ratio ratio = sample_ratio{1.}) -> fsst_dictionary_base;
+      sample_ratio ratio   = sample_ratio{1.},
+      thread_count threads = thread_count{1}) -> fsst_dictionary_base;
 
-    [[nodiscard]] static auto build(
-      Generator gen, Deduplicator dedup, sample_ratio ratio = sample_ratio{1.})
+    [[nodiscard]] static auto build(Generator gen,
+      Deduplicator                            dedup,
+      sample_ratio                            ratio   = sample_ratio{1.},
+      thread_count                            threads = thread_count{1})
       -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>;
 
-    [[nodiscard]] static auto build_from_unique(
-      Generator gen, sample_ratio ratio = sample_ratio{1.})
+    [[nodiscard]] static auto build_from_unique(Generator gen,
+      sample_ratio ratio   = sample_ratio{1.},
+      thread_count threads = thread_count{1})
       -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>;
 
     // --- R-Value Factories (String Based) ---
@@ -214,54 +391,167 @@ namespace vault::algorithm {
     [[nodiscard]] static auto build(RValueGenerator gen,
       Deduplicator                                  dedup,
       std::function<void(fsst_key)>                 emit_key,
-      sample_ratio ratio = sample_ratio{1.}) -> fsst_dictionary_base;
+      sample_ratio ratio   = sample_ratio{1.},
+      thread_count threads = thread_count{1}) -> fsst_dictionary_base;
 
     [[nodiscard]] static auto build_from_unique(RValueGenerator gen,
       std::function<void(fsst_key)>                             emit_key,
-      sample_ratio ratio = sample_ratio{1.}) -> fsst_dictionary_base;
+      sample_ratio ratio   = sample_ratio{1.},
+      thread_count threads = thread_count{1}) -> fsst_dictionary_base;
 
     [[nodiscard]] static auto build(RValueGenerator gen,
       Deduplicator                                  dedup,
-      sample_ratio                                  ratio = sample_ratio{1.})
+      sample_ratio                                  ratio = sample_ratio{1.},
+      thread_count threads = thread_count{1})
       -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>;
 
-    [[nodiscard]] static auto build_from_unique(
-      RValueGenerator gen, sample_ratio ratio = sample_ratio{1.})
+    [[nodiscard]] static auto build_from_unique(RValueGenerator gen,
+      sample_ratio ratio   = sample_ratio{1.},
+      thread_count threads = thread_count{1})
       -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>;
 
+    // --- Template Factories (No Type Erasure) ---
+    //
+    // The factories above for callables of any type. The generator, the
+    // deduplicator and the key sink are invoked directly, so the compiler can
+    // inline them into the loop that gathers the strings; the std::function
+    // overloads are thin wrappers around the same code.
+
+    template <fsst_generator G, fsst_deduplicator D, fsst_key_sink E>
+    [[nodiscard]] static auto build(G&& gen,
+      D&&                               dedup,
+      E&&                               emit_key,
+      sample_ratio ratio   = sample_ratio{1.},
+      thread_count threads = thread_count{1}) -> fsst_dictionary_base
+    {
+      return build_with(gen, dedup, emit_key, ratio, threads);
+    }
+
+    template <fsst_generator G, fsst_key_sink E>
+    [[nodiscard]] static auto build_from_unique(G&& gen,
+      E&&                                           emit_key,
+      sample_ratio ratio   = sample_ratio{1.},
+      thread_count threads = thread_count{1}) -> fsst_dictionary_base
+    {
+      auto unique = all_unique{};
+      return build_with(gen, unique, emit_key, ratio, threads);
+    }
+
+    template <fsst_generator G, fsst_deduplicator D>
+    [[nodiscard]] static auto build(G&& gen,
+      D&&                               dedup,
+      sample_ratio ratio   = sample_ratio{1.},
+      thread_count threads = thread_count{1})
+      -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>
+    {
+      auto keys = std::vector<fsst_key>{};
+      auto emit = [&keys](fsst_key k) { keys.push_back(k); };
+      auto dict = build_with(gen, dedup, emit, ratio, threads);
+      return {std::move(dict), std::move(keys)};
+    }
+
+    template <fsst_generator G>
+    [[nodiscard]] static auto build_from_unique(G&& gen,
+      sample_ratio ratio   = sample_ratio{1.},
+      thread_count threads = thread_count{1})
+      -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>
+    {
+      auto keys   = std::vector<fsst_key>{};
+      auto emit   = [&keys](fsst_key k) { keys.push_back(k); };
+      auto unique = all_unique{};
+      auto dict   = build_with(gen, unique, emit, ratio, threads);
+      return {std::move(dict), std::move(keys)};
+    }
+
+    // --- Streaming Factories (Bounded Memory) ---
+
+    /// @brief Builds a dictionary in two passes over `passes`, holding only
+    /// the training sample and the compressed output in memory.
+    /// @details
+    /// The first pass draws a uniform reservoir sample of the strings that
+    /// are not stored inline, and the encoder is trained on it. The second
+    /// pass compresses every string as it arrives and calls `emit_key` with
+    /// its key, so peak memory is the reservoir, the compressed data and the
+    /// deduplicator, rather than a copy of the input.
+    /// @note The view passed to `dedup` is only valid during the call, so the
+    /// deduplicator must own the strings it remembers.
+    /// @throws std::invalid_argument if the second pass yields a string that
+    /// needs compressing when the first pass yielded none.
+    [[nodiscard]] static auto build_streaming(RValueGeneratorFactory passes,
+      Deduplicator                                                   dedup,
+      std::function<void(fsst_key)>                                  emit_key,
+      reservoir_size sample = reservoir_size{16384}) -> fsst_dictionary_base;
+
+    /// @brief Builds a dictionary in two passes over `passes`, treating every
+    /// string as unique. See the deduplicating overload.
+    [[nodiscard]] static auto build_from_unique_streaming(
+      RValueGeneratorFactory        passes,
+      std::function<void(fsst_key)> emit_key,
+      reservoir_size sample = reservoir_size{16384}) -> fsst_dictionary_base;
+
+    // The streaming factories for callables of any type. As with the
+    // template factories above, the passes, the deduplicator and the key
+    // sink are invoked directly, and the std::function overloads are thin
+    // wrappers around the same code.
+
+    template <fsst_pass_factory P, fsst_deduplicator D, fsst_key_sink E>
+    [[nodiscard]] static auto build_streaming(P&& passes,
+      D&&                                         dedup,
+      E&&                                         emit_key,
+      reservoir_size sample = reservoir_size{16384}) -> fsst_dictionary_base
+    {
+      return compress_stream(passes, dedup, emit_key, sample);
+    }
+
+    template <fsst_pass_factory P, fsst_key_sink E>
+    [[nodiscard]] static auto build_from_unique_streaming(P&& passes,
+      E&&                                                     emit_key,
+      reservoir_size sample = reservoir_size{16384}) -> fsst_dictionary_base
+    {
+      auto unique = all_unique{};
+      return compress_stream(passes, unique, emit_key, sample);
+    }
+
     // --- Compression Level Overloads ---
 
     [[nodiscard]] static inline auto build(Generator gen,
       Deduplicator                                   dedup,
       std::function<void(fsst_key)>                  emit_key,
-      compression_level level) -> fsst_dictionary_base
+      compression_level                              level,
+      thread_count threads = thread_count{1}) -> fsst_dictionary_base
     {
       return build(std::move(gen),
         std::move(dedup),
         std::move(emit_key),
-        level_to_ratio(level));
+        level_to_ratio(level),
+        threads);
     }
 
     [[nodiscard]] static inline auto build_from_unique(Generator gen,
       std::function<void(fsst_key)>                              emit_key,
-      compression_level level) -> fsst_dictionary_base
+      compression_level                                          level,
+      thread_count threads = thread_count{1}) -> fsst_dictionary_base
     {
       return build_from_unique(
-        std::move(gen), std::move(emit_key), level_to_ratio(level));
+        std::move(gen), std::move(emit_key), level_to_ratio(level), threads);
     }
 
-    [[nodiscard]] static inline auto build(
-      Generator gen, Deduplicator dedup, compression_level level)
+    [[nodiscard]] static inline auto build(Generator gen,
+      Deduplicator                                   dedup,
+      compression_level                              level,
+      thread_count threads = thread_count{1})
       -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>
     {
-      return build(std::move(gen), std::move(dedup), level_to_ratio(level));
+      return build(
+        std::move(gen), std::move(dedup), level_to_ratio(level), threads);
     }
 
-    [[nodiscard]] static inline auto build_from_unique(
-      Generator gen, compression_level level)
+    [[nodiscard]] static inline auto build_from_unique(Generator gen,
+      compression_level                                          level,
+      thread_count threads = thread_count{1})
       -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>
     {
-      return build_from_unique(std::move(gen), level_to_ratio(level));
+      return build_from_unique(std::move(gen), level_to_ratio(level), threads);
     }
 
     // --- Range Interface (Generalized) ---
@@ -282,39 +572,37 @@ namespace vault::algorithm {
 
       if constexpr (is_contiguous_lvalue) {
         // Path A: Zero Copy (Views)
-        auto gen =
-          Generator{[it, end]() mutable -> std::optional<std::string_view> {
-            if (it == end) {
-              return std::nullopt;
-            }
-            auto&& val = *it;
-            ++it;
-            return std::string_view{
-              reinterpret_cast<const char*>(std::ranges::data(val)),
-              std::ranges::size(val)};
-          }};
+        auto gen = [it, end]() mutable -> std::optional<std::string_view> {
+          if (it == end) {
+            return std::nullopt;
+          }
+          auto&& val = *it;
+          ++it;
+          return std::string_view{
+            reinterpret_cast<const char*>(std::ranges::data(val)),
+            std::ranges::size(val)};
+        };
         return build(std::move(gen), std::forward<Args>(args)...);
 
       } else {
         // Path B: R-Value (Buffering)
-        auto gen =
-          RValueGenerator{[it, end]() mutable -> std::optional<std::string> {
-            if (it == end) {
-              return std::nullopt;
+        auto gen = [it, end]() mutable -> std::optional<std::string> {
+          if (it == end) {
+            return std::nullopt;
+          }
+          auto&& val = *it;
+          auto   s   = std::string();
+          if constexpr (std::ranges::contiguous_range<ValueType>) {
+            s.assign(reinterpret_cast<const char*>(std::ranges::data(val)),
+              std::ranges::size(val));
+          } else {
+            for (auto c : val) {
+              s.push_back(static_cast<char>(c));
             }
-            auto&& val = *it;
-            auto   s   = std::string();
-            if constexpr (std::ranges::contiguous_range<ValueType>) {
-              s.assign(reinterpret_cast<const char*>(std::ranges::data(val)),
-                std::ranges::size(val));
-            } else {
-              for (auto c : val) {
-                s.push_back(static_cast<char>(c));
-              }
-            }
-            ++it;
-            return s;
-          }};
+          }
+          ++it;
+          return s;
+        };
         return build(std::move(gen), std::forward<Args>(args)...);
       }
     }
@@ -334,38 +622,36 @@ namespace vault::algorithm {
       auto end = std::ranges::end(range);
 
       if constexpr (is_contiguous_lvalue) {
-        auto gen =
-          Generator{[it, end]() mutable -> std::optional<std::string_view> {
-            if (it == end) {
-              return std::nullopt;
-            }
-            auto&& val = *it;
-            ++it;
-            return std::string_view{
-              reinterpret_cast<const char*>(std::ranges::data(val)),
-              std::ranges::size(val)};
-          }};
+        auto gen = [it, end]() mutable -> std::optional<std::string_view> {
+          if (it == end) {
+            return std::nullopt;
+          }
+          auto&& val = *it;
+          ++it;
+          return std::string_view{
+            reinterpret_cast<const char*>(std::ranges::data(val)),
+            std::ranges::size(val)};
+        };
         return build_from_unique(std::move(gen), std::forward<Args>(args)...);
 
       } else {
-        auto gen =
-          RValueGenerator{[it, end]() mutable -> std::optional<std::string> {
-            if (it == end) {
-              return std::nullopt;
+        auto gen = [it, end]() mutable -> std::optional<std::string> {
+          if (it == end) {
+            return std::nullopt;
+          }
+          auto&& val = *it;
+          auto   s   = std::string();
+          if constexpr (std::ranges::contiguous_range<ValueType>) {
+            s.assign(reinterpret_cast<const char*>(std::ranges::data(val)),
+              std::ranges::size(val));
+          } else {
+            for (auto c : val) {
+              s.push_back(static_cast<char>(c));
             }
-            auto&& val = *it;
-            auto   s   = std::string();
-            if constexpr (std::ranges::contiguous_range<ValueType>) {
-              s.assign(reinterpret_cast<const char*>(std::ranges::data(val)),
-                std::ranges::size(val));
-            } else {
-              for (auto c : val) {
-                s.push_back(static_cast<char>(c));
-              }
-            }
-            ++it;
-            return s;
-          }};
+          }
+          ++it;
+          return s;
+        };
         return build_from_unique(std::move(gen), std::forward<Args>(args)...);
       }
     }
@@ -374,13 +660,181 @@ namespace vault::algorithm {
     class impl;
     std::shared_ptr<impl const> p_impl;
 
+    // Stands in for the deduplicator of the build_from_unique factories.
+    struct all_unique {};
+
+    // Set in the keys of strings stored inline, and never in an index.
+    static constexpr auto const inline_key_flag = std::uint64_t{1} << 63;
+
+    // Gathers the strings of `gen`, compresses the distinct ones and emits
+    // the keys of all of them in input order.
+    template <typename G, typename D, typename E>
+    [[nodiscard]] static auto build_with(G& gen,
+      D&                                    dedup,
+      E&                                    emit_key,
+      sample_ratio                          ratio,
+      thread_count threads) -> fsst_dictionary_base
+    {
+      if constexpr (fsst_rvalue_generator<G>) {
+        // Strings handed over by value are moved into a stable buffer, which
+        // lives until compression is done.
+        auto stable_buffer = std::deque<std::string>{};
+        auto view_gen = [&]() -> std::optional<std::string_view> {
+          auto opt_s = std::invoke(gen);
+          if (!opt_s) {
+            return std::nullopt;
+          }
+          return std::string_view{
+            stable_buffer.emplace_back(std::move(*opt_s))};
+        };
+        return build_with(view_gen, dedup, emit_key, ratio, threads);
+
+      } else {
+        auto const timer = metrics::scoped_timer{detail::fsst_build_metric};
+
+        auto instructions     = std::vector<std::uint64_t>{};
+        auto compression_ptrs = std::vector<unsigned char const*>{};
+        auto compression_lens = std::vector<std::size_t>{};
+
+        while (true) {
+          auto const opt_sv = std::invoke(gen);
+          if (!opt_sv) {
+            break;
+          }
+
+          auto const sv = *opt_sv;
+
+          if (is_inline_candidate(sv)) {
+            instructions.push_back(make_inline_key(sv).value);
+            continue;
+          }
+
+          auto idx    = static_cast<std::uint64_t>(compression_ptrs.size());
+          auto is_new = true;
+          if constexpr (!std::same_as<D, all_unique>) {
+            std::tie(idx, is_new) =
+              std::pair<std::uint64_t, bool>(std::invoke(dedup, sv));
+          }
+
+          if (is_new) {
+            compression_ptrs.push_back(
+              reinterpret_cast<unsigned char const*>(sv.data()));
+            compression_lens.push_back(sv.size());
+          }
+          instructions.push_back(idx);
+        }
+
+        auto [impl_ptr, large_keys] = compress_core(compression_ptrs.size(),
+          compression_lens.data(),
+          compression_ptrs.data(),
+          ratio.value,
+          threads.value);
+
+        auto result_dict = fsst_dictionary_base(std::move(impl_ptr));
+
+        for (auto const val : instructions) {
+          if (val & inline_key_flag) {
+            std::invoke(emit_key, fsst_key{val});
+          } else {
+            std::invoke(emit_key, large_keys[static_cast<std::size_t>(val)]);
+          }
+        }
+
+        return result_dict;
+      }
+    }
+
     [[nodiscard]] explicit fsst_dictionary_base(
       std::shared_ptr<impl const> implementation);
 
+    // The encoder of a streaming build, trained on the sample of its first
+    // pass, and the strings it has compressed since.
+    class stream_compressor {
+    public:
+      [[nodiscard]] explicit stream_compressor(
+        std::vector<std::string> sample);
+
+      // Compresses a string that is not stored inline and returns its key.
+      [[nodiscard]] auto compress(std::string_view sv) -> fsst_key;
+
+      [[nodiscard]] auto finish() && -> fsst_dictionary_base;
+
+    private:
+      std::shared_ptr<impl>      m_impl;
+      std::vector<unsigned char> m_blob;
+      std::vector<unsigned char> m_buffer;
+    };
+
+    // Samples the strings of one pass, trains the encoder on them, and
+    // compresses the strings of a second pass as they arrive.
+    template <typename P, typename D, typename E>
+    [[nodiscard]] static auto compress_stream(
+      P& passes, D& dedup, E& emit_key, reservoir_size sample)
+      -> fsst_dictionary_base
+    {
+      if (sample.value == 0) {
+        throw std::invalid_argument("reservoir_size must be positive");
+      }
+
+      // Pass 1: a uniform sample of the strings that will be compressed.
+      auto reservoir = std::vector<std::string>{};
+      {
+        auto gen  = std::invoke(passes);
+        auto rng  = std::mt19937{std::random_device{}()};
+        auto seen = std::size_t{0};
+
+        while (auto s = std::invoke(gen)) {
+          if (is_inline_candidate(*s)) {
+            continue;
+          }
+          if (reservoir.size() < sample.value) {
+            reservoir.emplace_back(std::move(*s));
+          } else if (auto const j =
+                       std::uniform_int_distribution<std::size_t>{0, seen}(rng);
+            j < sample.value) {
+            reservoir[j] = std::move(*s);
+          }
+          ++seen;
+        }
+      }
+
+      auto compressor  = stream_compressor{std::move(reservoir)};
+      auto unique_keys = std::vector<fsst_key>{};
+
+      // Pass 2: compress every string as it arrives.
+      auto gen = std::invoke(passes);
+      while (auto s = std::invoke(gen)) {
+        auto const sv = std::string_view{*s};
+
+        if (is_inline_candidate(sv)) {
+          std::invoke(emit_key, make_inline_key(sv));
+          continue;
+        }
+
+        if constexpr (!std::same_as<D, all_unique>) {
+          auto const [idx, is_new] =
+            std::pair<std::uint64_t, bool>(std::invoke(dedup, sv));
+          if (!is_new) {
+            std::invoke(emit_key, unique_keys[static_cast<std::size_t>(idx)]);
+            continue;
+          }
+        }
+
+        auto const key = compressor.compress(sv);
+        if constexpr (!std::same_as<D, all_unique>) {
+          unique_keys.push_back(key);
+        }
+        std::invoke(emit_key, key);
+      }
+
+      return std::move(compressor).finish();
+    }
+
     [[nodiscard]] static auto compress_core(std::size_t count,
       std::size_t*                                      lens,
       unsigned char const**                             ptrs,
-      float                                             sample_ratio)
+      float                                             sample_ratio,
+      std::size_t                                       threads)
       -> std::pair<std::shared_ptr<impl>, std::vector<fsst_key>>;
 
     // --- Private Helpers for Friend Access ---
@@ -391,6 +845,10 @@ namespace vault::algorithm {
       fsst_key k, void* dst, std::size_t capacity) const -> std::ptrdiff_t;
 
     [[nodiscard]] auto is_inline_key_internal(fsst_key k) const -> bool;
+
+    [[nodiscard]] auto decompress_many(std::span<fsst_key const> keys,
+      std::function<void(std::size_t, std::string_view)> const&  sink) const
+      -> std::size_t;
   };
 
   /// @brief Typed wrapper for FSST dictionary.
@@ -413,6 +871,12 @@ namespace vault::algorithm {
 
     // --- Shadow Factories (Return fsst_dictionary<T>) ---
 
+    [[nodiscard]] static auto open_mapped(std::filesystem::path const& path)
+      -> fsst_dictionary
+    {
+      return fsst_dictionary(fsst_dictionary_base::open_mapped(path));
+    }
+
     template <typename... Args> [[nodiscard]] static auto build(Args&&... args)
     {
       using BaseResult =
@@ -429,6 +893,21 @@ namespace vault::algorithm {
       }
     }
 
+    template <typename... Args>
+    [[nodiscard]] static auto build_streaming(Args&&... args) -> fsst_dictionary
+    {
+      return fsst_dictionary(
+        fsst_dictionary_base::build_streaming(std::forward<Args>(args)...));
+    }
+
+    template <typename... Args>
+    [[nodiscard]] static auto build_from_unique_streaming(Args&&... args)
+      -> fsst_dictionary
+    {
+      return fsst_dictionary(fsst_dictionary_base::build_from_unique_streaming(
+        std::forward<Args>(args)...));
+    }
+
     template <typename... Args>
     [[nodiscard]] static auto build_from_unique(Args&&... args)
     {
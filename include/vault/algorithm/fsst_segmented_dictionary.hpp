@@ -0,0 +1,182 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_ALGORITHM_FSST_SEGMENTED_DICTIONARY_HPP
+#define VAULT_ALGORITHM_FSST_SEGMENTED_DICTIONARY_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <vault/algorithm/fsst_dictionary.hpp>
+
+namespace vault::algorithm {
+
+  /// @brief A dictionary made of independently built fsst_dictionary
+  /// segments, each compressed with its own symbol table.
+  ///
+  /// @details
+  /// Segments are built like any fsst_dictionary, possibly on several threads
+  /// at once, and appended in any order; appending rewrites the keys of the
+  /// segment to name it. Data that arrives later becomes a new segment instead
+  /// of a rebuild, and data of a different shape gets a symbol table trained
+  /// on it rather than on a mix.
+  ///
+  /// The key of a value stored in segment `s` is the key the segment returned,
+  /// with `s` in the top `segment_bits` bits of the offset field. A segment
+  /// can therefore hold at most `max_segment_size` bytes of compressed data,
+  /// and the dictionary at most `max_segments` segments. Inline keys are the
+  /// same in every segment and are left unchanged.
+  ///
+  /// @code
+  /// using namespace vault::algorithm;
+  /// auto dict         = fsst_segmented_dictionary<std::string>{};
+  /// auto [part, keys] =
+  ///   fsst_dictionary<std::string>::build_from_unique(batch);
+  /// dict.append(std::move(part), keys);
+  /// auto value = dict[keys.front()];
+  /// @endcode
+  class fsst_segmented_dictionary_base {
+  public:
+    /// @brief The number of key bits that select a segment.
+    static constexpr auto const segment_bits = 10uz;
+
+    /// @brief The most segments a dictionary can hold.
+    static constexpr auto const max_segments = 1uz << segment_bits;
+
+    /// @brief The most bytes of compressed data a segment can hold.
+    static constexpr auto const max_segment_size = 1uz
+      << (fsst_dictionary_base::pointer_offset_bits - segment_bits);
+
+    /// @brief Appends `segment`, and rewrites `keys`, which must be keys
+    /// returned by the build of `segment`, to keys of this dictionary.
+    /// @details
+    /// Keys of earlier segments stay valid.
+    /// @return The index of the new segment.
+    /// @throws std::length_error if the dictionary already holds
+    /// `max_segments` segments, or if `segment` holds more than
+    /// `max_segment_size` bytes.
+    auto append(fsst_dictionary_base segment, std::span<fsst_key> keys)
+      -> std::size_t
+    {
+      if (m_segments.size() == max_segments) {
+        throw std::length_error("fsst_segmented_dictionary: too many segments");
+      }
+      if (segment.size_in_bytes() > max_segment_size) {
+        throw std::length_error("fsst_segmented_dictionary: segment too large");
+      }
+
+      auto const index = m_segments.size();
+      for (auto& key : keys) {
+        if (!fsst_dictionary_base::is_inline_key(key)) {
+          key.value |= static_cast<std::uint64_t>(index) << segment_shift;
+        }
+      }
+
+      m_segments.push_back(std::move(segment));
+      return index;
+    }
+
+    /// @brief The number of segments.
+    [[nodiscard]] auto segment_count() const noexcept -> std::size_t
+    {
+      return m_segments.size();
+    }
+
+    /// @brief Segment `i`, which is invalidated by the next `append`.
+    [[nodiscard]] auto segment(std::size_t i) const
+      -> fsst_dictionary_base const&
+    {
+      return m_segments.at(i);
+    }
+
+    [[nodiscard]] auto empty() const noexcept -> bool
+    {
+      return std::ranges::all_of(
+        m_segments, [](auto const& s) { return s.empty(); });
+    }
+
+    /// @brief The bytes of compressed data in all segments.
+    [[nodiscard]] auto size_in_bytes() const noexcept -> std::size_t
+    {
+      auto total = std::size_t{0};
+      for (auto const& s : m_segments) {
+        total += s.size_in_bytes();
+      }
+      return total;
+    }
+
+    /// @brief Tries to find and decompress the value for `key` into `out`.
+    /// @see try_find(fsst_dictionary_base const&, fsst_key, ByteContainer&)
+    template <typename ByteContainer>
+    friend inline auto try_find(fsst_segmented_dictionary_base const& dict,
+      fsst_key                                                      key,
+      ByteContainer&                                                out) -> bool
+    {
+      auto const [segment, local_key] = dict.resolve(key);
+      return segment != nullptr && try_find(*segment, local_key, out);
+    }
+
+    /// @brief Tries to find and decompress the value for `key` into a new
+    /// container.
+    template <typename ByteContainer>
+    friend inline auto try_find(
+      fsst_segmented_dictionary_base const& dict, fsst_key key)
+      -> std::optional<ByteContainer>
+    {
+      auto container = ByteContainer();
+      if (try_find(dict, key, container)) {
+        return container;
+      }
+      return std::nullopt;
+    }
+
+  private:
+    static constexpr auto const segment_shift =
+      fsst_dictionary_base::pointer_offset_bits - segment_bits;
+    static constexpr auto const segment_mask =
+      (std::uint64_t{1} << segment_bits) - 1;
+
+    // The segment that holds `key` and the key it has there, or a null
+    // segment if there is no such segment.
+    [[nodiscard]] auto resolve(fsst_key key) const
+      -> std::pair<fsst_dictionary_base const*, fsst_key>
+    {
+      if (fsst_dictionary_base::is_inline_key(key)) {
+        static auto const no_segment = fsst_dictionary_base{};
+        return {&no_segment, key};
+      }
+
+      auto const index = (key.value >> segment_shift) & segment_mask;
+      if (index >= m_segments.size()) {
+        return {nullptr, key};
+      }
+
+      auto const local = key.value & ~(segment_mask << segment_shift);
+      return {&m_segments[index], fsst_key{local}};
+    }
+
+    std::vector<fsst_dictionary_base> m_segments;
+  };
+
+  /// @brief Typed wrapper for a segmented FSST dictionary.
+  /// @tparam ByteContainer Type returned by operator[] (e.g. std::string).
+  template <typename ByteContainer>
+  class fsst_segmented_dictionary : public fsst_segmented_dictionary_base {
+  public:
+    /// @brief Decompresses and returns the value as ByteContainer.
+    [[nodiscard]] auto operator[](fsst_key key) const
+      -> std::optional<ByteContainer>
+    {
+      return try_find<ByteContainer>(*this, key);
+    }
+  };
+
+} // namespace vault::algorithm
+
+#endif // VAULT_ALGORITHM_FSST_SEGMENTED_DICTIONARY_HPP
@@ -4,11 +4,16 @@
 #define VAULT_ALGORITHM_KNUTH_MORRIS_PRATT_FAILURE_FUNCTION_HPP
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <ranges>
+#include <span>
+#include <utility>
 #include <vector>
 
 namespace vault::algorithm {
@@ -27,6 +32,70 @@ namespace vault::algorithm {
     && std::copy_constructible<T> && std::ranges::random_access_range<T>
     && std::integral<std::ranges::range_value_t<T>>;
 
+  /**
+   * @brief A failure table whose length is part of its type, such as
+   * `std::array<int, N>`.
+   *
+   * @tparam T The container type.
+   */
+  template <typename T>
+  concept fixed_size_knuth_morris_pratt_failure_table =
+    knuth_morris_pratt_failure_table<T> && std::default_initializable<T>
+    && requires { std::tuple_size<T>::value; };
+
+  namespace detail {
+    // Writes the failure table of the `length_of_pattern` symbols from
+    // `first` to `failure_function[0, length_of_pattern)`. The table is
+    // only written, never assumed to be initialized.
+    template <std::forward_iterator I,
+      std::random_access_iterator   T,
+      typename Comp,
+      typename Proj>
+    constexpr void fill_knuth_morris_pratt_failure_table(I first,
+      std::iter_difference_t<I>                            length_of_pattern,
+      T                                                    failure_function,
+      Comp&                                                comp,
+      Proj&                                                proj)
+    {
+      if (length_of_pattern == 0) {
+        return;
+      }
+
+      // Base case: The proper prefix of a single-character string is empty.
+      failure_function[0] = 0;
+
+      auto length_of_previous_longest_prefix = 0;
+
+      for (auto i = 1; i < length_of_pattern;) {
+        // Invariant check: The prefix length being tested must always be less
+        // than the current index.
+        assert(length_of_previous_longest_prefix < i
+          && "Candidate prefix length must be shorter than current substring.");
+        assert(length_of_previous_longest_prefix >= 0
+          && "Prefix length cannot be negative.");
+
+        auto&& lhs = std::invoke(proj, *std::ranges::next(first, i));
+        auto&& rhs = std::invoke(
+          proj, *std::ranges::next(first, length_of_previous_longest_prefix));
+
+        if (std::invoke(comp, lhs, rhs)) {
+          // Extension found: P[i] == P[len]
+          failure_function[i++] = static_cast<std::iter_value_t<T>>(
+            ++length_of_previous_longest_prefix);
+        } else if (length_of_previous_longest_prefix != 0) {
+          // Mismatch: Fall back to the previous longest prefix that is also a
+          // suffix.
+          length_of_previous_longest_prefix =
+            failure_function[length_of_previous_longest_prefix - 1];
+        } else {
+          // Mismatch and no previous prefix available: P[0...i] has no proper
+          // prefix-suffix.
+          failure_function[i++] = 0;
+        }
+      }
+    }
+  } // namespace detail
+
   /**
    * @brief Function object for computing the Knuth-Morris-Pratt (KMP) failure
    * function.
@@ -78,7 +147,7 @@ namespace vault::algorithm {
     [[nodiscard]] static constexpr auto operator()(
       I first, S last, Comp comp = {}, Proj proj = {}) -> std::vector<int>
     {
-      auto length_of_pattern = std::ranges::distance(first, last);
+      auto const length_of_pattern = std::ranges::distance(first, last);
 
       // The failure function is only defined for non-negative lengths.
       assert(length_of_pattern >= 0 && "Pattern length cannot be negative.");
@@ -87,47 +156,8 @@ namespace vault::algorithm {
       // size/value constructor rather than the initializer_list constructor.
       auto failure_function = std::vector<int>(length_of_pattern, 0);
 
-      if (length_of_pattern == 0) {
-        return failure_function;
-      }
-
-      // Base case invariant: The proper prefix of a single-character string is
-      // empty.
-      assert(failure_function[0] == 0
-        && "The first element of the failure table must be 0.");
-
-      auto length_of_previous_longest_prefix = 0;
-
-      for (auto i = 1; i < length_of_pattern;) {
-        // Invariant check: The prefix length being tested must always be less
-        // than the current index.
-        assert(length_of_previous_longest_prefix < i
-          && "Candidate prefix length must be shorter than current substring.");
-        assert(length_of_previous_longest_prefix >= 0
-          && "Prefix length cannot be negative.");
-
-        auto&& lhs = std::invoke(proj, *std::ranges::next(first, i));
-        auto&& rhs = std::invoke(
-          proj, *std::ranges::next(first, length_of_previous_longest_prefix));
-
-        if (std::invoke(comp, lhs, rhs)) {
-          // Extension found: P[i] == P[len]
-          failure_function[i++] = ++length_of_previous_longest_prefix;
-        } else if (length_of_previous_longest_prefix != 0) {
-          // Mismatch: Fall back to the previous longest prefix that is also a
-          // suffix.
-          length_of_previous_longest_prefix =
-            failure_function[length_of_previous_longest_prefix - 1];
-        } else {
-          // Mismatch and no previous prefix available: P[0...i] has no proper
-          // prefix-suffix.
-          failure_function[i++] = 0;
-        }
-      }
-
-      // Post-condition check
-      assert(std::cmp_equal(failure_function.size(), length_of_pattern)
-        && "Result size must match input pattern size.");
+      detail::fill_knuth_morris_pratt_failure_table(
+        first, length_of_pattern, failure_function.begin(), comp, proj);
 
       return failure_function;
     }
@@ -164,6 +194,438 @@ namespace vault::algorithm {
     }
   } const knuth_morris_pratt_failure_function{};
 
+  /**
+   * @brief Function object for computing the KMP failure table of a
+   * pattern of `N` symbols into a `std::array<int, N>`.
+   *
+   * Unlike `knuth_morris_pratt_failure_function`, the table does not
+   * allocate, so it can be computed in constant evaluation and kept in
+   * a `constexpr` variable.
+   *
+   * @code
+   * constexpr auto table =
+   *   vault::algorithm::fixed_knuth_morris_pratt_failure_function<4>("abab"sv);
+   * static_assert(table == std::array{0, 0, 1, 2});
+   * @endcode
+   *
+   * @tparam N The length of the pattern.
+   */
+  template <std::size_t N> struct fixed_knuth_morris_pratt_failure_function_fn {
+    /**
+     * @param pattern A pattern of exactly `N` symbols.
+     * @param comp Comparison predicate.
+     * @param proj Projection to apply to elements.
+     */
+    template <std::ranges::forward_range Pattern,
+      typename Comp = std::equal_to<>,
+      typename Proj = std::identity>
+      requires std::indirect_binary_predicate<Comp,
+        std::projected<std::ranges::iterator_t<Pattern>, Proj>,
+        std::projected<std::ranges::iterator_t<Pattern>, Proj>>
+    [[nodiscard]] static constexpr auto operator()(
+      Pattern&& pattern, Comp comp = {}, Proj proj = {}) -> std::array<int, N>
+    {
+      assert(std::cmp_equal(std::ranges::distance(pattern), N)
+        && "Pattern length must match the table size.");
+
+      auto failure_function = std::array<int, N>{};
+
+      detail::fill_knuth_morris_pratt_failure_table(std::ranges::begin(pattern),
+        static_cast<std::ranges::range_difference_t<Pattern>>(N),
+        failure_function.begin(),
+        comp,
+        proj);
+
+      return failure_function;
+    }
+  };
+
+  template <std::size_t N>
+  constexpr inline auto const fixed_knuth_morris_pratt_failure_function =
+    fixed_knuth_morris_pratt_failure_function_fn<N>{};
+
+  /**
+   * @brief The KMP failure tables of a set of patterns, packed into one
+   * contiguous buffer.
+   *
+   * Table `i` occupies `[offset(i), offset(i + 1))` of the buffer, so a
+   * set of n tables costs two allocations instead of n, and the tables
+   * of neighbouring patterns are neighbours in memory. Tables are
+   * handed out as `std::span<int const>`, which satisfies
+   * `knuth_morris_pratt_failure_table`.
+   *
+   * The layout is fixed at construction. `assign` computes one table in
+   * place and touches no other, so distinct tables may be assigned
+   * concurrently.
+   *
+   * @code
+   * auto tables = vault::algorithm::knuth_morris_pratt_failure_tables{
+   *   patterns, comp};
+   * auto overlap = vault::algorithm::knuth_morris_pratt_overlap(
+   *   text, patterns[i], tables[i], comp);
+   * @endcode
+   */
+  class knuth_morris_pratt_failure_tables {
+    std::vector<int>         m_data;
+    std::vector<std::size_t> m_offsets{0};
+
+  public:
+    [[nodiscard]] knuth_morris_pratt_failure_tables() = default;
+
+    /**
+     * @brief Lays out one table per length in `lengths`, without
+     * computing any of them.
+     *
+     * Every table reads as zeros until it is assigned.
+     */
+    template <std::ranges::input_range Lengths>
+      requires std::integral<std::ranges::range_value_t<Lengths>>
+    [[nodiscard]] explicit knuth_morris_pratt_failure_tables(
+      Lengths&& lengths)
+    {
+      if constexpr (std::ranges::sized_range<Lengths>) {
+        m_offsets.reserve(std::ranges::size(lengths) + 1);
+      }
+
+      for (auto const length : lengths) {
+        assert(length >= 0 && "Pattern length cannot be negative.");
+        m_offsets.push_back(
+          m_offsets.back() + static_cast<std::size_t>(length));
+      }
+
+      m_data.resize(m_offsets.back());
+    }
+
+    /**
+     * @brief Lays out and computes the tables of `patterns`.
+     */
+    template <std::ranges::forward_range Patterns,
+      typename Comp = std::equal_to<>,
+      typename Proj = std::identity>
+      requires std::ranges::forward_range<
+        std::ranges::range_reference_t<Patterns>>
+    [[nodiscard]] knuth_morris_pratt_failure_tables(
+      Patterns const& patterns, Comp comp = {}, Proj proj = {})
+        : knuth_morris_pratt_failure_tables(
+            patterns | std::views::transform([](auto const& p) {
+              return std::ranges::distance(p);
+            }))
+    {
+      auto i = std::size_t{0};
+      for (auto const& pattern : patterns) {
+        assign(i++, pattern, comp, proj);
+      }
+    }
+
+    /// The number of tables.
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+      return m_offsets.size() - 1;
+    }
+
+    /// The position of table `i` in the buffer.
+    [[nodiscard]] auto offset(std::size_t i) const noexcept -> std::size_t
+    {
+      assert(i < m_offsets.size());
+      return m_offsets[i];
+    }
+
+    /// The failure table of pattern `i`.
+    [[nodiscard]] auto operator[](std::size_t i) const noexcept
+      -> std::span<int const>
+    {
+      assert(i < size());
+      return std::span<int const>{m_data}.subspan(
+        m_offsets[i], m_offsets[i + 1] - m_offsets[i]);
+    }
+
+    /// Invokes `fn` with the failure table of pattern `i`.
+    template <typename F>
+      requires std::invocable<F, std::span<int const>>
+    auto visit(std::size_t i, F&& fn) const
+      -> std::invoke_result_t<F, std::span<int const>>
+    {
+      return std::invoke(std::forward<F>(fn), (*this)[i]);
+    }
+
+    /**
+     * @brief Computes table `i` from `pattern`, whose length must be
+     * the one table `i` was laid out with.
+     */
+    template <std::ranges::forward_range Pattern,
+      typename Comp = std::equal_to<>,
+      typename Proj = std::identity>
+      requires std::indirect_binary_predicate<Comp,
+        std::projected<std::ranges::iterator_t<Pattern const>, Proj>,
+        std::projected<std::ranges::iterator_t<Pattern const>, Proj>>
+    void assign(
+      std::size_t i, Pattern const& pattern, Comp comp = {}, Proj proj = {})
+    {
+      assert(i < size());
+
+      auto const length = std::ranges::distance(pattern);
+      assert(std::cmp_equal(length, m_offsets[i + 1] - m_offsets[i])
+        && "Pattern length does not match the table layout.");
+
+      detail::fill_knuth_morris_pratt_failure_table(std::ranges::begin(pattern),
+        length,
+        std::ranges::next(m_data.begin(), m_offsets[i]),
+        comp,
+        proj);
+    }
+  };
+
+  namespace detail {
+    // Reads entry `i` of a compact failure table of the given width.
+    struct compact_failure_table_entry_fn {
+      std::byte const* data  = nullptr;
+      std::size_t      width = 1;
+
+      [[nodiscard]] auto operator()(std::size_t i) const noexcept
+        -> std::uint32_t
+      {
+        switch (width) {
+        case 1: return reinterpret_cast<std::uint8_t const*>(data)[i];
+        case 2: return reinterpret_cast<std::uint16_t const*>(data)[i];
+        default: return reinterpret_cast<std::uint32_t const*>(data)[i];
+        }
+      }
+    };
+  } // namespace detail
+
+  /**
+   * @brief A failure table stored with entries of 1, 2 or 4 bytes, as
+   * handed out by `compact_knuth_morris_pratt_failure_tables`.
+   */
+  using compact_knuth_morris_pratt_failure_table =
+    std::ranges::transform_view<
+      std::ranges::iota_view<std::size_t, std::size_t>,
+      detail::compact_failure_table_entry_fn>;
+
+  /**
+   * @brief The KMP failure tables of a set of patterns, packed into one
+   * contiguous buffer with entries as narrow as each pattern allows.
+   *
+   * The entries of a table are shorter than its pattern, so the table of
+   * a pattern of at most 256 symbols is stored as `std::uint8_t`, of at
+   * most 65536 symbols as `std::uint16_t`, and as `std::uint32_t`
+   * otherwise. For the short strings a superstring is typically built
+   * from, this takes a quarter of the memory of
+   * `knuth_morris_pratt_failure_tables`, so more of the tables stay in
+   * cache while the overlaps of all pairs are computed.
+   *
+   * Tables are handed out as `compact_knuth_morris_pratt_failure_table`,
+   * which satisfies `knuth_morris_pratt_failure_table` and reads entries
+   * as `std::uint32_t`, or through `visit` as a `std::span` of the
+   * entry type. As with `knuth_morris_pratt_failure_tables`, the
+   * layout is fixed at construction and distinct tables may be assigned
+   * concurrently.
+   *
+   * @code
+   * auto tables = vault::algorithm::compact_knuth_morris_pratt_failure_tables{
+   *   patterns, comp};
+   * auto overlap = vault::algorithm::knuth_morris_pratt_overlap(
+   *   text, patterns[i], tables[i], comp);
+   * @endcode
+   */
+  class compact_knuth_morris_pratt_failure_tables {
+    // Table `i` occupies `[offset(i), m_offsets[i + 1])`, after padding
+    // its start in `[m_offsets[i], offset(i))` to the entry width. A
+    // pattern of length L takes at most 256 bytes if L <= 256, between
+    // 514 and 131073 bytes with padding if L <= 65536, and more than
+    // that otherwise, so the width follows from the distance between
+    // consecutive offsets.
+    std::vector<std::byte>   m_data;
+    std::vector<std::size_t> m_offsets{0};
+
+    [[nodiscard]] static constexpr auto width_of_length(
+      std::size_t length) noexcept -> std::size_t
+    {
+      return length <= 256 ? 1 : length <= 65536 ? 2 : 4;
+    }
+
+    [[nodiscard]] static constexpr auto width_of_extent(
+      std::size_t bytes) noexcept -> std::size_t
+    {
+      return bytes <= 256 ? 1 : bytes <= 131073 ? 2 : 4;
+    }
+
+    [[nodiscard]] static constexpr auto align_up(
+      std::size_t offset, std::size_t width) noexcept -> std::size_t
+    {
+      return (offset + width - 1) / width * width;
+    }
+
+    [[nodiscard]] auto width(std::size_t i) const noexcept -> std::size_t
+    {
+      return width_of_extent(m_offsets[i + 1] - m_offsets[i]);
+    }
+
+    [[nodiscard]] auto length(std::size_t i) const noexcept -> std::size_t
+    {
+      return (m_offsets[i + 1] - offset(i)) / width(i);
+    }
+
+  public:
+    [[nodiscard]] compact_knuth_morris_pratt_failure_tables() = default;
+
+    /**
+     * @brief Lays out one table per length in `lengths`, without
+     * computing any of them.
+     *
+     * Every table reads as zeros until it is assigned.
+     */
+    template <std::ranges::input_range Lengths>
+      requires std::integral<std::ranges::range_value_t<Lengths>>
+    [[nodiscard]] explicit compact_knuth_morris_pratt_failure_tables(
+      Lengths&& lengths)
+    {
+      if constexpr (std::ranges::sized_range<Lengths>) {
+        m_offsets.reserve(std::ranges::size(lengths) + 1);
+      }
+
+      for (auto const length : lengths) {
+        assert(length >= 0 && "Pattern length cannot be negative.");
+        auto const l = static_cast<std::size_t>(length);
+        auto const w = width_of_length(l);
+        m_offsets.push_back(align_up(m_offsets.back(), w) + l * w);
+      }
+
+      m_data.resize(m_offsets.back());
+    }
+
+    /**
+     * @brief Lays out and computes the tables of `patterns`.
+     */
+    template <std::ranges::forward_range Patterns,
+      typename Comp = std::equal_to<>,
+      typename Proj = std::identity>
+      requires std::ranges::forward_range<
+        std::ranges::range_reference_t<Patterns>>
+    [[nodiscard]] compact_knuth_morris_pratt_failure_tables(
+      Patterns const& patterns, Comp comp = {}, Proj proj = {})
+        : compact_knuth_morris_pratt_failure_tables(
+            patterns | std::views::transform([](auto const& p) {
+              return std::ranges::distance(p);
+            }))
+    {
+      auto i = std::size_t{0};
+      for (auto const& pattern : patterns) {
+        assign(i++, pattern, comp, proj);
+      }
+    }
+
+    /// The number of tables.
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+      return m_offsets.size() - 1;
+    }
+
+    /// The size of the buffer holding all tables, in bytes.
+    [[nodiscard]] auto size_bytes() const noexcept -> std::size_t
+    {
+      return m_data.size();
+    }
+
+    /// The position of table `i` in the buffer, in bytes.
+    [[nodiscard]] auto offset(std::size_t i) const noexcept -> std::size_t
+    {
+      assert(i < m_offsets.size());
+      return i == size() ? m_offsets[i] : align_up(m_offsets[i], width(i));
+    }
+
+    /// The failure table of pattern `i`.
+    [[nodiscard]] auto operator[](std::size_t i) const noexcept
+      -> compact_knuth_morris_pratt_failure_table
+    {
+      assert(i < size());
+      return compact_knuth_morris_pratt_failure_table{
+        std::views::iota(std::size_t{0}, length(i)),
+        detail::compact_failure_table_entry_fn{
+          m_data.data() + offset(i), width(i)}};
+    }
+
+    /**
+     * @brief Invokes `fn` with the failure table of pattern `i` as a
+     * `std::span` of its actual entry type.
+     *
+     * Unlike `operator[]`, which decides the width on every access, this
+     * decides it once, so it suits inner loops. `fn` must return the
+     * same type for all three entry types.
+     */
+    template <typename F>
+      requires std::invocable<F, std::span<std::uint8_t const>>
+      && std::invocable<F, std::span<std::uint16_t const>>
+      && std::invocable<F, std::span<std::uint32_t const>>
+    auto visit(std::size_t i, F&& fn) const
+      -> std::invoke_result_t<F, std::span<std::uint8_t const>>
+    {
+      assert(i < size());
+
+      auto const* const data = m_data.data() + offset(i);
+      auto const        n    = length(i);
+
+      switch (width(i)) {
+      case 1:
+        return std::invoke(std::forward<F>(fn),
+          std::span{reinterpret_cast<std::uint8_t const*>(data), n});
+      case 2:
+        return std::invoke(std::forward<F>(fn),
+          std::span{reinterpret_cast<std::uint16_t const*>(data), n});
+      default:
+        return std::invoke(std::forward<F>(fn),
+          std::span{reinterpret_cast<std::uint32_t const*>(data), n});
+      }
+    }
+
+    /**
+     * @brief Computes table `i` from `pattern`, whose length must be
+     * the one table `i` was laid out with.
+     */
+    template <std::ranges::forward_range Pattern,
+      typename Comp = std::equal_to<>,
+      typename Proj = std::identity>
+      requires std::indirect_binary_predicate<Comp,
+        std::projected<std::ranges::iterator_t<Pattern const>, Proj>,
+        std::projected<std::ranges::iterator_t<Pattern const>, Proj>>
+    void assign(
+      std::size_t i, Pattern const& pattern, Comp comp = {}, Proj proj = {})
+    {
+      assert(i < size());
+
+      auto const length = std::ranges::distance(pattern);
+      assert(std::cmp_equal(length, this->length(i))
+        && "Pattern length does not match the table layout.");
+
+      auto const first = std::ranges::begin(pattern);
+      auto* const data = m_data.data() + offset(i);
+
+      switch (width(i)) {
+      case 1:
+        detail::fill_knuth_morris_pratt_failure_table(first,
+          length,
+          reinterpret_cast<std::uint8_t*>(data),
+          comp,
+          proj);
+        break;
+      case 2:
+        detail::fill_knuth_morris_pratt_failure_table(first,
+          length,
+          reinterpret_cast<std::uint16_t*>(data),
+          comp,
+          proj);
+        break;
+      default:
+        detail::fill_knuth_morris_pratt_failure_table(first,
+          length,
+          reinterpret_cast<std::uint32_t*>(data),
+          comp,
+          proj);
+        break;
+      }
+    }
+  };
+
 } // namespace vault::algorithm
 
 #endif // VAULT_ALGORITHM_KNUTH_MORRIS_PRATT_FAILURE_FUNCTION_HPP
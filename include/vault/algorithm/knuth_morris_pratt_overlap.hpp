@@ -5,15 +5,116 @@
 
 #include <algorithm>
 #include <concepts>
+#include <cstddef>
+#include <cstring>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <ranges>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <vault/algorithm/knuth_morris_pratt_failure_function.hpp>
 
 namespace vault::algorithm {
 
+  /**
+   * @brief Bounds on the overlap `knuth_morris_pratt_overlap` looks for.
+   *
+   * Overlaps longer than `max_score` are not considered, and a longest
+   * overlap shorter than `min_score` is reported as no overlap at all.
+   * Both save work: only the last `max_score` symbols of the text are
+   * scanned, and the scan stops as soon as the rest of the text can no
+   * longer produce `min_score` symbols.
+   */
+  struct overlap_bounds {
+    std::ptrdiff_t min_score = 0;
+    std::ptrdiff_t max_score = std::numeric_limits<std::ptrdiff_t>::max();
+  };
+
+  namespace detail {
+    template <typename Comp, typename T>
+    concept is_standard_equal_to = std::same_as<Comp, std::equal_to<T>>
+      || std::same_as<Comp, std::equal_to<>>
+      || std::same_as<Comp, std::ranges::equal_to>;
+
+    // Symbols whose equality is equality of their object representation.
+    template <typename T>
+    concept overlap_byte = sizeof(T) == 1
+      && (std::same_as<T, std::byte>
+        || (std::integral<T> && !std::same_as<T, bool>));
+
+    // The operands for which knuth_morris_pratt_overlap compares bytes
+    // in bulk instead of running the KMP automaton.
+    template <typename ILHS,
+      typename IRHS,
+      typename Comp,
+      typename ProjLHS,
+      typename ProjRHS>
+    concept byte_overlap_operands = std::contiguous_iterator<ILHS>
+      && std::contiguous_iterator<IRHS>
+      && overlap_byte<std::iter_value_t<ILHS>>
+      && std::same_as<std::iter_value_t<ILHS>, std::iter_value_t<IRHS>>
+      && is_standard_equal_to<Comp, std::iter_value_t<ILHS>>
+      && std::same_as<ProjLHS, std::identity>
+      && std::same_as<ProjRHS, std::identity>;
+
+    // The longest suffix of lhs[0, n) that is a prefix of rhs[0, m), for
+    // byte strings, within bounds, or -1 if the search gave up.
+    //
+    // Every overlap starts at an occurrence of rhs[0] in the last
+    // min(n, m, max_score) bytes of lhs. Those are found with memchr from the
+    // left, so the first one whose tail matches rhs under memcmp is the
+    // longest overlap. Periodic inputs can make this quadratic, so the
+    // search gives up once it has verified a few times as many bytes as
+    // the window holds, and the caller falls back to KMP.
+    [[nodiscard]] inline auto byte_overlap(std::byte const* lhs,
+      std::size_t                                           n,
+      std::byte const*                                      rhs,
+      std::size_t                                           m,
+      overlap_bounds const& bounds) noexcept -> std::ptrdiff_t
+    {
+      auto const max_score =
+        static_cast<std::size_t>(std::max(bounds.max_score, std::ptrdiff_t{0}));
+      auto const window = std::min({n, m, max_score});
+      if (window == 0) {
+        return 0;
+      }
+
+      auto const* first  = lhs + (n - window);
+      auto const* last   = lhs + n;
+      auto        budget = 4 * window + 64;
+
+      while (first != last) {
+        auto const* candidate = static_cast<std::byte const*>(
+          std::memchr(first,
+            static_cast<int>(rhs[0]),
+            static_cast<std::size_t>(last - first)));
+        if (candidate == nullptr) {
+          return 0;
+        }
+
+        auto const length = static_cast<std::size_t>(last - candidate);
+        if (std::cmp_less(length, bounds.min_score)) {
+          return 0;
+        }
+        if (std::memcmp(candidate + 1, rhs + 1, length - 1) == 0) {
+          return static_cast<std::ptrdiff_t>(length);
+        }
+
+        if (length > budget) {
+          return -1;
+        }
+        budget -= length;
+        first = candidate + 1;
+      }
+
+      return 0;
+    }
+  } // namespace detail
+
   /**
    * @brief Function object for computing the overlap between a text (LHS) and a
    * pattern (RHS) using the Knuth-Morris-Pratt algorithm.
@@ -88,8 +189,8 @@ namespace vault::algorithm {
     };
 
     /**
-     * @brief Computes the overlap between two ranges using a pre-computed
-     * failure table.
+     * @brief Computes the longest overlap within `bounds` between two ranges
+     * using a pre-computed failure table.
      *
      * @tparam ILHS Input iterator type for the Text (LHS).
      * @tparam SLHS Sentinel type for the Text (LHS).
@@ -108,16 +209,30 @@ namespace vault::algorithm {
      * @param rhs_last Sentinel for the end of the pattern.
      * @param failure_table A valid KMP failure table computed for the pattern
      * (RHS).
+     * @param bounds The range of overlap lengths of interest.
      * @param comp Comparison function object.
      * @param proj_lhs Projection to apply to LHS elements before comparison.
      * @param proj_rhs Projection to apply to RHS elements before comparison.
      *
-     * @return result structure containing the overlap score and iterators.
+     * @return result structure containing the overlap score and iterators. If
+     * the longest overlap of at most `bounds.max_score` symbols is shorter than
+     * `bounds.min_score`, the score is 0.
+     *
+     * Only the last `min(N, M, bounds.max_score)` symbols of the text are
+     * scanned, since no overlap can start before them.
+     *
+     * Byte strings stored contiguously and compared with a standard
+     * `equal_to` and no projections are matched with `memchr` and
+     * `memcmp` over those symbols instead, which the C library vectorizes.
+     * The result is the same.
      *
      * @par Complexity
      * @parblock
-     * - **Time:** O(N), where N is `std::distance(lhs_first, lhs_last)`. The
-     * algorithm performs at most 2N comparisons.
+     * - **Time:** O(W) comparisons, where W is `min(N, M, bounds.max_score)`
+     * with N the length of the text and M that of the pattern. The algorithm
+     * performs at most 2W comparisons, and fewer when `bounds.min_score`
+     * cuts the scan short. The byte path does at most O(W) work before
+     * handing over to the automaton.
      * - **Space:** O(1) auxiliary space (excluding the storage for the provided
      * failure table).
      * @endparblock
@@ -138,6 +253,7 @@ namespace vault::algorithm {
       IRHS                                              rhs_first,
       SRHS                                              rhs_last,
       FailureTable&&                                    failure_table,
+      overlap_bounds const&                             bounds,
       Comp                                              comp     = {},
       ProjLHS                                           proj_lhs = {},
       ProjRHS proj_rhs = {}) -> result<ILHS, IRHS, FailureTable>
@@ -150,10 +266,54 @@ namespace vault::algorithm {
       auto lhs_length = std::ranges::distance(lhs_first, lhs_last);
       auto rhs_length = std::ranges::distance(rhs_first, rhs_last);
 
-      auto lhs_cursor = lhs_first;
+      auto make_result = [&](auto score, ILHS lhs_end) {
+        return result<ILHS, IRHS, FailureTable>{
+          static_cast<std::iter_difference_t<IRHS>>(score),
+          // Iterator to where the overlap begins in LHS
+          std::ranges::prev(lhs_end, score),
+          lhs_end, // Iterator to the end of LHS
+          rhs_first,
+          // Iterator to the end of the matched prefix in RHS
+          std::ranges::next(rhs_first, score),
+          std::forward<FailureTable>(failure_table)};
+      };
+
+      constexpr auto const is_byte_string =
+        detail::byte_overlap_operands<ILHS, IRHS, Comp, ProjLHS, ProjRHS>;
+
+      if constexpr (is_byte_string) {
+        if !consteval {
+          auto const score = detail::byte_overlap(
+            reinterpret_cast<std::byte const*>(std::to_address(lhs_first)),
+            static_cast<std::size_t>(lhs_length),
+            reinterpret_cast<std::byte const*>(std::to_address(rhs_first)),
+            static_cast<std::size_t>(rhs_length),
+            bounds);
+
+          if (score >= 0) {
+            return make_result(
+              score, std::ranges::next(lhs_first, lhs_length));
+          }
+        }
+      }
+
+      // Symbols before the last `window` cannot be part of an overlap
+      // within bounds.
+      auto window = static_cast<std::iter_difference_t<ILHS>>(
+        std::min({static_cast<std::ptrdiff_t>(lhs_length),
+          static_cast<std::ptrdiff_t>(rhs_length),
+          std::max(bounds.max_score, std::ptrdiff_t{0})}));
+
+      auto lhs_cursor = std::ranges::next(lhs_first, lhs_length - window);
 
       // Iterating through the text (LHS)
-      for (; lhs_cursor != lhs_last; ++lhs_cursor) {
+      for (; lhs_cursor != lhs_last; ++lhs_cursor, --window) {
+
+        // Even if every remaining symbol matched, the overlap would be
+        // too short.
+        if (rhs_index + window < bounds.min_score) {
+          return make_result(0, std::ranges::next(lhs_cursor, lhs_last));
+        }
 
         // Helper to perform the comparison with projections
         auto check_match = [&](auto const& iter_rhs) {
@@ -183,14 +343,78 @@ namespace vault::algorithm {
       }
 
       // Reconstruct iterators for the result
-      return result<ILHS, IRHS, FailureTable>{rhs_index,
-        // Iterator to where the overlap begins in LHS
-        std::next(lhs_first, lhs_length - rhs_index),
-        lhs_cursor, // Iterator to the end of LHS
+      return make_result(
+        rhs_index < bounds.min_score ? decltype(rhs_index){0} : rhs_index,
+        lhs_cursor);
+    }
+
+    /**
+     * @brief Computes the overlap between two ranges using a pre-computed
+     * failure table.
+     *
+     * @tparam ILHS Input iterator type for the Text (LHS).
+     * @tparam SLHS Sentinel type for the Text (LHS).
+     * @tparam IRHS Input iterator type for the Pattern (RHS).
+     * @tparam SRHS Sentinel type for the Pattern (RHS).
+     * @tparam FailureTable Type of the pre-computed failure table.
+     * @tparam Comp Binary predicate type. Defaults to `std::equal_to<>`.
+     * @tparam ProjLHS Projection type for LHS elements. Defaults to
+     * `std::identity`.
+     * @tparam ProjRHS Projection type for RHS elements. Defaults to
+     * `std::identity`.
+     *
+     * @param lhs_first Iterator to the beginning of the text.
+     * @param lhs_last Sentinel for the end of the text.
+     * @param rhs_first Iterator to the beginning of the pattern.
+     * @param rhs_last Sentinel for the end of the pattern.
+     * @param failure_table A valid KMP failure table computed for the pattern
+     * (RHS).
+     * @param comp Comparison function object.
+     * @param proj_lhs Projection to apply to LHS elements before comparison.
+     * @param proj_rhs Projection to apply to RHS elements before comparison.
+     *
+     * @return result structure containing the overlap score and iterators.
+     *
+     * @par Complexity
+     * @parblock
+     * - **Time:** O(min(N, M)), where N is the length of the text and M that
+     * of the pattern. The algorithm performs at most 2 min(N, M) comparisons.
+     * - **Space:** O(1) auxiliary space (excluding the storage for the provided
+     * failure table).
+     * @endparblock
+     *
+     * @see operator()(ILHS, SLHS, IRHS, SRHS, FailureTable&&,
+     *   overlap_bounds const&, Comp, ProjLHS, ProjRHS)
+     */
+    template <std::forward_iterator    ILHS,
+      std::sentinel_for<ILHS>          SLHS,
+      std::forward_iterator            IRHS,
+      std::sentinel_for<IRHS>          SRHS,
+      knuth_morris_pratt_failure_table FailureTable,
+      typename Comp    = std::equal_to<>,
+      typename ProjLHS = std::identity,
+      typename ProjRHS = std::identity>
+      requires std::indirect_binary_predicate<Comp,
+        std::projected<ILHS, ProjLHS>,
+        std::projected<IRHS, ProjRHS>>
+    [[nodiscard]] static constexpr auto operator()(ILHS lhs_first,
+      SLHS                                              lhs_last,
+      IRHS                                              rhs_first,
+      SRHS                                              rhs_last,
+      FailureTable&&                                    failure_table,
+      Comp                                              comp     = {},
+      ProjLHS                                           proj_lhs = {},
+      ProjRHS proj_rhs = {}) -> result<ILHS, IRHS, FailureTable>
+    {
+      return operator()(lhs_first,
+        lhs_last,
         rhs_first,
-        // Iterator to the end of the matched prefix in RHS
-        std::next(rhs_first, rhs_index),
-        std::forward<FailureTable>(failure_table)};
+        rhs_last,
+        std::forward<FailureTable>(failure_table),
+        overlap_bounds{},
+        comp,
+        proj_lhs,
+        proj_rhs);
     }
 
     /**
@@ -312,6 +536,42 @@ namespace vault::algorithm {
         proj_rhs);
     }
 
+    /**
+     * @brief Range overload with pre-computed failure table and bounds.
+     *
+     * @see operator()(ILHS, SLHS, IRHS, SRHS, FailureTable&&,
+     *   overlap_bounds const&, Comp, ProjLHS, ProjRHS)
+     */
+    template <std::ranges::forward_range LHS,
+      std::ranges::forward_range         RHS,
+      knuth_morris_pratt_failure_table   FailureTable,
+      typename Comp    = std::equal_to<>,
+      typename ProjLHS = std::identity,
+      typename ProjRHS = std::identity>
+      requires std::indirect_binary_predicate<Comp,
+        std::projected<std::ranges::iterator_t<LHS>, ProjLHS>,
+        std::projected<std::ranges::iterator_t<RHS>, ProjRHS>>
+    [[nodiscard]] static constexpr auto operator()(LHS&& lhs,
+      RHS&&                                              rhs,
+      FailureTable&&                                     failure_table,
+      overlap_bounds const&                              bounds,
+      Comp                                               comp     = {},
+      ProjLHS                                            proj_lhs = {},
+      ProjRHS proj_rhs = {}) -> result<std::ranges::iterator_t<LHS>,
+      std::ranges::iterator_t<RHS>,
+      FailureTable>
+    {
+      return operator()(std::ranges::begin(lhs),
+        std::ranges::end(lhs),
+        std::ranges::begin(rhs),
+        std::ranges::end(rhs),
+        std::forward<FailureTable>(failure_table),
+        bounds,
+        comp,
+        proj_lhs,
+        proj_rhs);
+    }
+
     /**
      * @brief Range overload without pre-computed failure table.
      *
@@ -4,18 +4,65 @@
 #define VAULT_ALGORITHM_KNUTH_MORRIS_PRATT_SEARCHER_HPP
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <concepts>
+#include <cstddef>
+#include <cstring>
 #include <functional>
 #include <iterator>
 #include <ranges>
+#include <string_view>
+#include <tuple>
 #include <utility>
 #include <vector>
 
 #include <vault/algorithm/knuth_morris_pratt_failure_function.hpp>
+#include <vault/algorithm/knuth_morris_pratt_overlap.hpp>
 
 namespace vault::algorithm {
 
+  namespace detail {
+    // The operands for which knuth_morris_pratt_searcher looks for the
+    // first symbol of the pattern with memchr while it is in state 0.
+    template <typename I,
+      typename S,
+      typename PatternI,
+      typename Comp,
+      typename ProjText,
+      typename ProjPattern>
+    concept byte_search_operands = std::sized_sentinel_for<S, I>
+      && byte_overlap_operands<I, PatternI, Comp, ProjText, ProjPattern>;
+
+    // The failure table of `pattern`, computed in place for tables of a
+    // fixed size and through knuth_morris_pratt_failure_function
+    // otherwise.
+    template <typename FailureTable,
+      typename Pattern,
+      typename Comp,
+      typename Proj>
+    [[nodiscard]] constexpr auto make_knuth_morris_pratt_failure_table(
+      Pattern const& pattern, Comp& comp, Proj& proj) -> FailureTable
+    {
+      if constexpr (fixed_size_knuth_morris_pratt_failure_table<FailureTable>) {
+        auto const length = std::ranges::distance(pattern);
+        assert(std::cmp_equal(length, std::tuple_size_v<FailureTable>)
+          && "Pattern length must match the table size.");
+
+        auto failure_table = FailureTable{};
+        fill_knuth_morris_pratt_failure_table(std::ranges::begin(pattern),
+          length,
+          std::ranges::begin(failure_table),
+          comp,
+          proj);
+        return failure_table;
+      } else {
+        return FailureTable{
+          knuth_morris_pratt_failure_function(pattern, comp, proj)};
+      }
+    }
+  } // namespace detail
+
   /**
    * @brief A function object searcher implementing the Knuth-Morris-Pratt (KMP)
    * algorithm.
@@ -27,7 +74,9 @@ namespace vault::algorithm {
    * @tparam Pattern The range type of the pattern (Must satisfy
    * `std::ranges::forward_range`).
    * @tparam FailureTable The container type for the failure function (default:
-   * std::vector<int>).
+   * std::vector<int>). A fixed-size table such as `std::array<int, N>` makes
+   * the pattern length a constant and lets the searcher be built in constant
+   * evaluation; string literals deduce one.
    * @tparam Comp Binary predicate for comparison (default: std::equal_to<>).
    * @tparam ProjPattern Projection applied to pattern elements (default:
    * std::identity).
@@ -126,8 +175,8 @@ namespace vault::algorithm {
     [[nodiscard]] constexpr knuth_morris_pratt_searcher(
       Pattern pattern, Comp comp = {}, ProjPattern proj_pattern = {})
         : m_pattern{std::move(pattern)}
-        , m_failure_table{knuth_morris_pratt_failure_function(
-            m_pattern, comp, proj_pattern)}
+        , m_failure_table{detail::make_knuth_morris_pratt_failure_table<
+            FailureTable>(m_pattern, comp, proj_pattern)}
         , m_comp{std::move(comp)}
         , m_proj_pattern{std::move(proj_pattern)}
     {
@@ -138,6 +187,11 @@ namespace vault::algorithm {
     /**
      * @brief Searches for the pattern in the given range [first, last).
      *
+     * Byte strings stored contiguously and compared with a standard
+     * `equal_to` and no projections skip ahead with `memchr` to the next
+     * occurrence of the first pattern symbol whenever the automaton is
+     * in its initial state, and only run the automaton from there.
+     *
      * @tparam I Input iterator type for the Text.
      * @tparam S Sentinel type for the Text.
      * @tparam ProjText Projection type for the Text elements (default:
@@ -166,10 +220,43 @@ namespace vault::algorithm {
       auto pattern_index  = 0;
       auto pattern_first  = std::ranges::begin(m_pattern);
       auto pattern_cursor = pattern_first;
-      auto pattern_length =
-        std::ranges::distance(pattern_first, std::ranges::end(m_pattern));
+      auto pattern_length = std::invoke([&] {
+        if constexpr (fixed_size_knuth_morris_pratt_failure_table<
+                        FailureTable>) {
+          return static_cast<std::ranges::range_difference_t<Pattern const>>(
+            std::tuple_size_v<FailureTable>);
+        } else {
+          return std::ranges::distance(
+            pattern_first, std::ranges::end(m_pattern));
+        }
+      });
+
+      constexpr auto const is_byte_search =
+        detail::byte_search_operands<I,
+          S,
+          std::ranges::iterator_t<Pattern const>,
+          Comp,
+          ProjText,
+          ProjPattern>;
 
       for (auto cursor = first; cursor != last; ++cursor) {
+        if constexpr (is_byte_search) {
+          if !consteval {
+            if (pattern_index == 0) {
+              auto const* text = std::to_address(cursor);
+              auto const* hit  = std::memchr(text,
+                static_cast<unsigned char>(*pattern_first),
+                static_cast<std::size_t>(last - cursor));
+
+              if (hit == nullptr) {
+                return {last, last};
+              }
+
+              cursor += static_cast<std::byte const*>(hit)
+                - reinterpret_cast<std::byte const*>(text);
+            }
+          }
+        }
 
         auto check_match = [&]() {
           return std::invoke(m_comp,
@@ -245,6 +332,26 @@ namespace vault::algorithm {
       Comp,
       ProjPattern>;
 
+  template <typename CharT,
+    std::size_t M,
+    typename Comp        = std::equal_to<>,
+    typename ProjPattern = std::identity>
+  knuth_morris_pratt_searcher(CharT const (&)[M], Comp = {}, ProjPattern = {})
+    -> knuth_morris_pratt_searcher<std::basic_string_view<CharT>,
+      std::array<int, M - 1>,
+      Comp,
+      ProjPattern>;
+
+  /**
+   * @brief A searcher whose failure table is a `std::array<int, N>`.
+   */
+  template <std::ranges::forward_range Pattern,
+    std::size_t                        N,
+    typename Comp        = std::equal_to<>,
+    typename ProjPattern = std::identity>
+  using fixed_knuth_morris_pratt_searcher =
+    knuth_morris_pratt_searcher<Pattern, std::array<int, N>, Comp, ProjPattern>;
+
   /**
    * @brief Helper factory to create a searcher with automatic type deduction.
    */
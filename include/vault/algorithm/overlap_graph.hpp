@@ -0,0 +1,263 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_ALGORITHM_OVERLAP_GRAPH_HPP
+#define VAULT_ALGORITHM_OVERLAP_GRAPH_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index_container.hpp>
+
+namespace vault::algorithm {
+
+  /**
+   * @brief An edge of the overlap graph: the last `score` symbols of
+   * string `lhs` match the first `score` symbols of string `rhs`.
+   */
+  struct overlap_edge {
+    std::size_t lhs;
+    std::size_t rhs;
+    std::size_t score;
+
+    [[nodiscard]] friend constexpr auto operator==(
+      overlap_edge const&, overlap_edge const&) -> bool = default;
+  };
+
+  /**
+   * @brief Verifies that G can drive the greedy merge of the
+   * superstring algorithm.
+   *
+   * An overlap graph is constructed from the number of strings and
+   * their nonzero overlap edges, sorted by `(lhs, rhs)`. `pop()`
+   * removes and returns the edge with the highest score, breaking ties
+   * in favour of the edge that was inserted first, or returns nothing
+   * once the graph is exhausted. `merge(lhs, rhs)` is called after
+   * every popped edge and must leave the graph as if the chains headed
+   * by `lhs` and `rhs` had been joined:
+   *
+   * - every out-edge of `lhs` and every in-edge of `rhs` is removed;
+   * - every out-edge `(rhs, x)` with `x != lhs` becomes `(lhs, x)` with
+   *   the same score, inserted after all edges present so far.
+   *
+   * The relative order of the moved edges is up to the graph, so two
+   * graphs may break some ties differently. Each graph is
+   * deterministic on its own.
+   */
+  template <typename G>
+  concept overlap_graph =
+    std::constructible_from<G, std::size_t, std::vector<overlap_edge>>
+    && requires(G& graph, std::size_t lhs, std::size_t rhs) {
+         { graph.pop() } -> std::same_as<std::optional<overlap_edge>>;
+         graph.merge(lhs, rhs);
+       };
+
+  /**
+   * @brief Overlap graph stored as a bucket queue over flat arrays.
+   *
+   * Scores are bounded by the length of the longest string, so edges
+   * are kept in one FIFO bucket per score and the queue only ever
+   * scans downwards from the best score seen so far. Edge records live
+   * in a single append-only array. The out-edges of every chain head
+   * are a contiguous range of that array: initially because the edges
+   * arrive sorted by `lhs`, and after a merge because the moved edges
+   * are appended together.
+   *
+   * Nothing is ever erased. A record is live while both of its ends
+   * are active chain heads and it lies in the current out-edge range
+   * of its `lhs`; stale records are skipped when they reach the front
+   * of their bucket. A merge therefore costs O(out-degree of `rhs`),
+   * at the price of keeping the records of moved edges until the
+   * graph is destroyed. Moved edges keep their relative order, so ties
+   * are broken by `(lhs, rhs)` order of the original edges.
+   *
+   * @par Complexity
+   * @parblock
+   * - **Construction:** O(n + E + S), where E is the number of edges
+   *   and S the highest score.
+   * - **pop:** amortized O(1) per record plus O(S) in total.
+   * - **Space:** 32 bytes per record and about 16 bytes per string.
+   * @endparblock
+   */
+  class bucket_queue_overlap_graph {
+    std::vector<overlap_edge> m_edges;
+
+    std::vector<std::vector<std::size_t>> m_buckets;
+    std::vector<std::size_t>              m_bucket_heads;
+    std::size_t                           m_top = 0;
+
+    std::vector<std::size_t> m_out_first;
+    std::vector<std::size_t> m_out_last;
+    std::vector<bool>        m_is_active;
+
+    [[nodiscard]] auto is_live(std::size_t id) const -> bool
+    {
+      auto const& edge = m_edges[id];
+      return m_is_active[edge.lhs] && m_is_active[edge.rhs]
+        && m_out_first[edge.lhs] <= id && id < m_out_last[edge.lhs];
+    }
+
+    void push_bucket(std::size_t id)
+    {
+      auto const score = m_edges[id].score;
+      if (score >= m_buckets.size()) {
+        m_buckets.resize(score + 1);
+        m_bucket_heads.resize(score + 1, 0);
+      }
+      m_buckets[score].push_back(id);
+      m_top = std::max(m_top, score);
+    }
+
+  public:
+    /**
+     * @param string_count The number of strings.
+     * @param edges The nonzero overlap edges, sorted by `(lhs, rhs)`.
+     */
+    [[nodiscard]] explicit bucket_queue_overlap_graph(
+      std::size_t string_count, std::vector<overlap_edge> edges)
+        : m_edges{std::move(edges)}
+        , m_out_first(string_count, 0)
+        , m_out_last(string_count, 0)
+        , m_is_active(string_count, true)
+    {
+      assert(std::ranges::is_sorted(m_edges, {}, &overlap_edge::lhs));
+
+      for (auto id = std::size_t{0}; id < m_edges.size(); ++id) {
+        auto const lhs = m_edges[id].lhs;
+        assert(lhs < string_count && m_edges[id].rhs < string_count);
+
+        if (id == 0 || m_edges[id - 1].lhs != lhs) {
+          m_out_first[lhs] = id;
+        }
+        m_out_last[lhs] = id + 1;
+
+        push_bucket(id);
+      }
+    }
+
+    [[nodiscard]] auto pop() -> std::optional<overlap_edge>
+    {
+      for (; m_top > 0; --m_top) {
+        auto& bucket = m_buckets[m_top];
+        auto& head   = m_bucket_heads[m_top];
+
+        while (head < bucket.size()) {
+          if (auto const id = bucket[head++]; is_live(id)) {
+            return m_edges[id];
+          }
+        }
+
+        // Nothing can be pushed above the best live score again, so
+        // the bucket is dead for good.
+        bucket = {};
+        head   = 0;
+      }
+      return std::nullopt;
+    }
+
+    void merge(std::size_t lhs, std::size_t rhs)
+    {
+      m_is_active[rhs] = false;
+
+      auto const first = m_edges.size();
+
+      for (auto id = m_out_first[rhs]; id < m_out_last[rhs]; ++id) {
+        auto const edge = m_edges[id];
+        if (edge.rhs != lhs && m_is_active[edge.rhs]) {
+          m_edges.push_back(overlap_edge{lhs, edge.rhs, edge.score});
+          push_bucket(m_edges.size() - 1);
+        }
+      }
+
+      m_out_first[lhs] = first;
+      m_out_last[lhs]  = m_edges.size();
+    }
+  };
+
+  /**
+   * @brief Overlap graph stored in a `boost::multi_index_container`.
+   *
+   * Edges are ordered by score and hashed by both ends, and are
+   * erased eagerly. This is the original representation of the graph
+   * and is kept for comparison with `bucket_queue_overlap_graph`. Moved
+   * edges are inserted in hash order, so ties between them may be
+   * broken differently than by the bucket queue.
+   */
+  class multi_index_overlap_graph {
+    struct tag_lhs {};
+
+    struct tag_rhs {};
+
+    struct tag_score {};
+
+    using index_t = boost::multi_index_container<overlap_edge,
+      boost::multi_index::indexed_by<
+        boost::multi_index::ordered_non_unique<
+          boost::multi_index::tag<tag_score>,
+          boost::multi_index::
+            member<overlap_edge, std::size_t, &overlap_edge::score>,
+          std::greater<std::size_t>>,
+        boost::multi_index::hashed_non_unique<boost::multi_index::tag<tag_lhs>,
+          boost::multi_index::
+            member<overlap_edge, std::size_t, &overlap_edge::lhs>>,
+        boost::multi_index::hashed_non_unique<boost::multi_index::tag<tag_rhs>,
+          boost::multi_index::
+            member<overlap_edge, std::size_t, &overlap_edge::rhs>>>>;
+
+    index_t m_index;
+
+  public:
+    /**
+     * @param string_count The number of strings.
+     * @param edges The nonzero overlap edges, sorted by `(lhs, rhs)`.
+     */
+    [[nodiscard]] explicit multi_index_overlap_graph(
+      std::size_t, std::vector<overlap_edge> edges)
+    {
+      for (auto const& e : edges) {
+        m_index.emplace(e.lhs, e.rhs, e.score);
+      }
+    }
+
+    [[nodiscard]] auto pop() -> std::optional<overlap_edge>
+    {
+      auto& by_score = m_index.get<tag_score>();
+      if (by_score.empty()) {
+        return std::nullopt;
+      }
+
+      auto const edge = *by_score.begin();
+      by_score.erase(by_score.begin());
+      return edge;
+    }
+
+    void merge(std::size_t lhs, std::size_t rhs)
+    {
+      m_index.get<tag_lhs>().erase(lhs);
+      m_index.get<tag_rhs>().erase(rhs);
+
+      auto& lhs_index = m_index.get<tag_lhs>();
+      auto  range     = lhs_index.equal_range(rhs);
+
+      auto it = range.first;
+      while (it != range.second) {
+        auto current = it++;
+        if (current->rhs != lhs) {
+          m_index.emplace(lhs, current->rhs, current->score);
+        }
+        lhs_index.erase(current);
+      }
+    }
+  };
+
+} // namespace vault::algorithm
+
+#endif // VAULT_ALGORITHM_OVERLAP_GRAPH_HPP
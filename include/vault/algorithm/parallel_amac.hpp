@@ -0,0 +1,183 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_PARALLEL_AMAC_HPP
+#define VAULT_PARALLEL_AMAC_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <vault/algorithm/amac.hpp>
+#include <vault/executor/thread_executor.hpp>
+
+namespace vault::amac {
+  /**
+   * @brief How a parallel coordinator hands completed jobs to its
+   * reporter.
+   * @ingroup vault_amac
+   */
+  enum class report_mode : std::uint8_t {
+    /**
+     * Workers buffer completed jobs and pass them to the reporter in
+     * batches under a lock, so the reporter is never invoked
+     * concurrently. Any reporter that works with the serial
+     * coordinator works here, e.g. one that writes to an output
+     * iterator.
+     */
+    serialized,
+
+    /**
+     * Workers invoke the reporter directly, concurrently with each
+     * other. A reporter invocable as `reporter(worker, job)` also
+     * receives the index of the worker, in
+     * `[0, executor.concurrency())`, to address per-worker output.
+     */
+    concurrent,
+  };
+
+  /**
+   * @brief Runs AMAC pipelines on several threads.
+   * @ingroup vault_amac
+   *
+   * The input range of jobs is cut into chunks of `grain` jobs, which
+   * the workers of a chunked executor take from a shared counter, so a
+   * worker that finishes early takes the chunks a slower one has not
+   * reached yet. Each worker runs its chunks through an independent
+   * `coordinator<TotalFanout>` pipeline.
+   *
+   * A parallel coordinator is called like `coordinator<TotalFanout>`,
+   * so it can be the `Executor` of the batch lookups of
+   * `eytzinger::layout_map`. Jobs are reported in no particular order.
+   * Ranges that are not random-access run on the calling thread.
+   *
+   * @tparam TotalFanout The interleaving degree of every worker.
+   * @tparam Mode How completed jobs reach the reporter.
+   * @tparam Executor The chunked executor that runs the workers.
+   */
+  template <uint8_t             TotalFanout = 16,
+    report_mode                 Mode        = report_mode::serialized,
+    algorithm::chunked_executor Executor    = algorithm::thread_executor>
+  class parallel_coordinator {
+    Executor    m_executor;
+    std::size_t m_grain;
+
+    // Completed jobs a worker buffers before it takes the lock of a
+    // serialized reporter.
+    static constexpr auto const FLUSH_SIZE = std::size_t{256};
+
+  public:
+    static constexpr auto const DEFAULT_GRAIN = std::size_t{1024};
+
+    /**
+     * @param executor The executor that runs the workers.
+     * @param grain The number of jobs per chunk. Each chunk fills and
+     *   drains a pipeline, so it should be well above TotalFanout.
+     */
+    [[nodiscard]] explicit parallel_coordinator(
+      Executor executor = Executor{}, std::size_t grain = DEFAULT_GRAIN)
+        : m_executor(std::move(executor))
+        , m_grain(std::max(grain, std::size_t{1}))
+    {}
+
+    [[nodiscard]] auto concurrency() const noexcept -> std::size_t
+    {
+      return m_executor.concurrency();
+    }
+
+    /**
+     * @brief Executes a batch of jobs on the workers of the executor.
+     *
+     * @param ijobs The input range of jobs to execute.
+     * @param reporter A callable invoked with every job once it
+     *   completes, as selected by Mode.
+     *
+     * If a job or the reporter throws, the remaining chunks are
+     * abandoned and the exception is rethrown on the calling thread.
+     */
+    template <std::ranges::input_range Jobs, typename Reporter>
+      requires concepts::job<std::ranges::range_value_t<Jobs>>
+      && (std::invocable<Reporter&, std::ranges::range_value_t<Jobs>&&>
+        || (Mode == report_mode::concurrent
+          && std::invocable<Reporter&,
+            std::size_t,
+            std::ranges::range_value_t<Jobs>&&>))
+    void operator()(Jobs&& ijobs, Reporter&& reporter) const
+    {
+      using job_t = std::ranges::range_value_t<Jobs>;
+
+      if constexpr (!std::ranges::random_access_range<Jobs>
+        || !std::ranges::sized_range<Jobs>) {
+        coordinator<TotalFanout>(std::forward<Jobs>(ijobs), [&](auto&& job) {
+          report(reporter, 0, std::forward<decltype(job)>(job));
+        });
+      } else {
+        auto const first = std::ranges::begin(ijobs);
+        auto const count = static_cast<std::size_t>(std::ranges::size(ijobs));
+
+        auto chunk = [&](std::size_t lo, std::size_t hi) {
+          return std::ranges::subrange(first + static_cast<std::ptrdiff_t>(lo),
+            first + static_cast<std::ptrdiff_t>(hi));
+        };
+
+        if constexpr (Mode == report_mode::concurrent) {
+          m_executor(count,
+            m_grain,
+            [&](std::size_t worker, std::size_t lo, std::size_t hi) {
+              coordinator<TotalFanout>(chunk(lo, hi), [&](auto&& job) {
+                report(reporter, worker, std::forward<decltype(job)>(job));
+              });
+            });
+        } else {
+          auto buffers = std::vector<std::vector<job_t>>(concurrency());
+          auto mutex   = std::mutex{};
+
+          auto flush = [&](std::vector<job_t>& buffer) {
+            for (auto& job : buffer) {
+              report(reporter, 0, std::move(job));
+            }
+            buffer.clear();
+          };
+
+          m_executor(count,
+            m_grain,
+            [&](std::size_t worker, std::size_t lo, std::size_t hi) {
+              auto& buffer = buffers[worker];
+              coordinator<TotalFanout>(chunk(lo, hi), [&](auto&& job) {
+                buffer.push_back(std::forward<decltype(job)>(job));
+                if (buffer.size() == FLUSH_SIZE) {
+                  auto const lock = std::lock_guard{mutex};
+                  flush(buffer);
+                }
+              });
+            });
+
+          // The workers have joined, so the rest needs no lock.
+          for (auto& buffer : buffers) {
+            flush(buffer);
+          }
+        }
+      }
+    }
+
+  private:
+    template <typename Reporter, typename J>
+    static void report(Reporter& reporter, std::size_t worker, J&& job)
+    {
+      if constexpr (Mode == report_mode::concurrent
+        && std::invocable<Reporter&, std::size_t, J&&>) {
+        std::invoke(reporter, worker, std::forward<J>(job));
+      } else {
+        std::invoke(reporter, std::forward<J>(job));
+      }
+    }
+  };
+} // namespace vault::amac
+
+#endif // VAULT_PARALLEL_AMAC_HPP
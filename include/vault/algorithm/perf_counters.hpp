@@ -0,0 +1,228 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_ALGORITHM_PERF_COUNTERS_HPP
+#define VAULT_ALGORITHM_PERF_COUNTERS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+namespace vault::algorithm {
+
+  /**
+   * @brief Hardware event counters of the calling thread.
+   *
+   * On Linux the counters are opened with perf_event_open, for user-space
+   * events of the calling thread only. A counter the kernel refuses, e.g.
+   * under a restrictive `perf_event_paranoid` or in a VM without a PMU, is
+   * not available and reads zero; on other systems none are.
+   *
+   * Counts accumulate over the intervals between start() and stop(), so
+   * one set of counters can measure many batches:
+   *
+   * @code
+   * auto counters = vault::algorithm::perf_counters{};
+   * counters.start();
+   * run_batch();
+   * counters.stop();
+   * auto misses = counters.total(perf_counters::l1d_misses);
+   * @endcode
+   */
+  class perf_counters {
+  public:
+    enum event : std::uint8_t {
+      // Core cycles.
+      cycles,
+
+      // Retired instructions.
+      instructions,
+
+      // Loads that missed the L1 data cache.
+      l1d_misses,
+
+      // Cycles in which a load miss could not get a line fill buffer,
+      // because all were tracking earlier misses. Counted on Intel CPUs
+      // only (L1D_PEND_MISS.FB_FULL), as other vendors expose no
+      // equivalent event.
+      fill_buffer_full_cycles,
+
+      event_count,
+    };
+
+    [[nodiscard]] static constexpr std::string_view name(event e) noexcept
+    {
+      switch (e) {
+      case cycles:
+        return "cycles";
+      case instructions:
+        return "instructions";
+      case l1d_misses:
+        return "l1d_misses";
+      case fill_buffer_full_cycles:
+        return "fill_buffer_full_cycles";
+      case event_count:
+        break;
+      }
+      return "unknown";
+    }
+
+  private:
+    std::array<int, event_count>           m_fds;
+    std::array<std::uint64_t, event_count> m_totals{};
+
+#if defined(__linux__)
+    [[nodiscard]] static int open_event(
+      std::uint32_t type, std::uint64_t config) noexcept
+    {
+      perf_event_attr attr{};
+      attr.size           = sizeof(attr);
+      attr.type           = type;
+      attr.config         = config;
+      attr.disabled       = 1;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+
+      return static_cast<int>(::syscall(
+        SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+    }
+#endif
+
+    [[nodiscard]] static bool is_intel() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+      unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+      if (__get_cpuid(0, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+      }
+      // "GenuineIntel"
+      return ebx == 0x756e6547 && edx == 0x49656e69 && ecx == 0x6c65746e;
+#else
+      return false;
+#endif
+    }
+
+    void close() noexcept
+    {
+#if defined(__linux__)
+      for (auto& fd : m_fds) {
+        if (fd >= 0) {
+          ::close(fd);
+        }
+        fd = -1;
+      }
+#endif
+    }
+
+  public:
+    /**
+     * @brief Opens every counter the system allows, stopped and at zero.
+     */
+    [[nodiscard]] perf_counters() noexcept
+    {
+      m_fds.fill(-1);
+#if defined(__linux__)
+      m_fds[cycles] = open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+      m_fds[instructions] =
+        open_event(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+      m_fds[l1d_misses] = open_event(PERF_TYPE_HW_CACHE,
+        PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8)
+          | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16));
+      if (is_intel()) {
+        // Event 0x48, umask 0x02.
+        m_fds[fill_buffer_full_cycles] = open_event(PERF_TYPE_RAW, 0x0248);
+      }
+#endif
+    }
+
+    perf_counters(perf_counters&& other) noexcept
+        : m_fds(std::exchange(other.m_fds, {-1, -1, -1, -1}))
+        , m_totals(other.m_totals)
+    {}
+
+    perf_counters& operator=(perf_counters&& other) noexcept
+    {
+      if (this != &other) {
+        close();
+        m_fds    = std::exchange(other.m_fds, {-1, -1, -1, -1});
+        m_totals = other.m_totals;
+      }
+      return *this;
+    }
+
+    perf_counters(perf_counters const&)            = delete;
+    perf_counters& operator=(perf_counters const&) = delete;
+
+    ~perf_counters() { close(); }
+
+    /**
+     * @brief Whether `e` is counted on this system.
+     */
+    [[nodiscard]] bool available(event e) const noexcept
+    {
+      return m_fds[e] >= 0;
+    }
+
+    /**
+     * @brief Starts an interval.
+     */
+    void start() noexcept
+    {
+#if defined(__linux__)
+      for (int fd : m_fds) {
+        if (fd >= 0) {
+          ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+          ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+      }
+#endif
+    }
+
+    /**
+     * @brief Ends an interval and adds its counts to the totals.
+     */
+    void stop() noexcept
+    {
+#if defined(__linux__)
+      for (int fd : m_fds) {
+        if (fd >= 0) {
+          ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+      }
+      for (std::size_t e = 0; e < event_count; ++e) {
+        std::uint64_t value = 0;
+        if (m_fds[e] >= 0
+          && ::read(m_fds[e], &value, sizeof(value))
+            == static_cast<ssize_t>(sizeof(value))) {
+          m_totals[e] += value;
+        }
+      }
+#endif
+    }
+
+    /**
+     * @brief The count of `e` over all intervals since the last reset.
+     */
+    [[nodiscard]] std::uint64_t total(event e) const noexcept
+    {
+      return m_totals[e];
+    }
+
+    void reset() noexcept { m_totals = {}; }
+  };
+
+} // namespace vault::algorithm
+
+#endif // VAULT_ALGORITHM_PERF_COUNTERS_HPP
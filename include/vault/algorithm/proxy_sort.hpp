@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_ALGORITHM_PROXY_SORT_HPP
+#define VAULT_ALGORITHM_PROXY_SORT_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace vault::algorithm {
+
+  /**
+   * @brief The first 8 bytes of a string as a big-endian integer, padded
+   * with zero bytes.
+   *
+   * Proxies order like the strings they come from, byte by byte as
+   * unsigned chars. Two strings whose proxies are equal may still differ,
+   * and only then must the strings themselves be compared.
+   */
+  [[nodiscard]] inline auto string_proxy(std::string_view s) noexcept
+    -> std::uint64_t
+  {
+    auto       buffer   = std::uint64_t{0};
+    auto const copy_len = std::min(s.size(), sizeof(buffer));
+    if (copy_len > 0) {
+      std::memcpy(&buffer, s.data(), copy_len);
+    }
+    if constexpr (std::endian::native == std::endian::little) {
+      return std::byteswap(buffer);
+    }
+    return buffer;
+  }
+
+  namespace detail {
+
+    struct proxy_entry {
+      std::uint64_t proxy;
+      std::size_t   index;
+    };
+
+    // Sequences shorter than this are sorted by comparison, where the
+    // histograms of a radix sort would cost more than they save.
+    inline constexpr auto proxy_radix_threshold = std::size_t{256};
+
+    // Runs of equal proxies shorter than this are resolved by comparing
+    // the keys rather than by the proxies of their next bytes.
+    inline constexpr auto proxy_refine_threshold = std::size_t{16};
+
+    /**
+     * @brief Stably sorts `entries` by proxy, with an LSD radix sort of
+     * one byte per pass.
+     *
+     * The histograms of all eight bytes are counted in one pass, and the
+     * passes over bytes that every entry shares are skipped, so keys with
+     * a common prefix cost fewer passes. `scratch` is resized to hold a
+     * copy of the entries.
+     */
+    inline void radix_sort_proxies(
+      std::span<proxy_entry> entries, std::vector<proxy_entry>& scratch)
+    {
+      constexpr auto digits = sizeof(std::uint64_t);
+
+      auto counts = std::array<std::array<std::size_t, 256>, digits>{};
+      for (auto const& entry : entries) {
+        for (auto digit = std::size_t{0}; digit < digits; ++digit) {
+          ++counts[digit][(entry.proxy >> (8 * digit)) & 0xff];
+        }
+      }
+
+      scratch.resize(entries.size());
+      auto* source = entries.data();
+      auto* target = scratch.data();
+      for (auto digit = std::size_t{0}; digit < digits; ++digit) {
+        auto& count = counts[digit];
+        if (std::ranges::find(count, entries.size()) != count.end()) {
+          continue;
+        }
+
+        auto offset = std::size_t{0};
+        for (auto& bucket : count) {
+          offset = std::exchange(bucket, offset) + offset;
+        }
+
+        for (auto const& entry : std::span{source, entries.size()}) {
+          target[count[(entry.proxy >> (8 * digit)) & 0xff]++] = entry;
+        }
+        std::swap(source, target);
+      }
+
+      if (source != entries.data()) {
+        std::ranges::copy(std::span{source, entries.size()}, entries.begin());
+      }
+    }
+
+    /**
+     * @brief Stably sorts `entries`, whose keys share their first `depth`
+     * bytes and are at least `depth` bytes long, by their keys.
+     *
+     * The entries are sorted by the proxies of the 8 bytes after `depth`.
+     * Within a run of equal proxies, a key that ends inside those bytes
+     * is a prefix of any longer key of the run, padded with zero bytes
+     * that are its own, so the run is ordered by the length of each key
+     * inside the window. The keys that go on past it are refined on the
+     * next 8 bytes, in the manner of an MSD radix sort.
+     */
+    template <typename Key>
+    void refine_proxies(std::span<proxy_entry> entries,
+      std::size_t                             depth,
+      Key const&                              key,
+      std::vector<proxy_entry>&               scratch)
+    {
+      // Keys may be projected by value, so each is viewed only within the
+      // expression that projects it.
+      if (entries.size() < proxy_refine_threshold) {
+        std::ranges::stable_sort(entries,
+          [&](proxy_entry const& a, proxy_entry const& b) {
+            return std::string_view{key(a.index)}.substr(depth)
+                 < std::string_view{key(b.index)}.substr(depth);
+          });
+        return;
+      }
+
+      if (depth > 0) {
+        for (auto& entry : entries) {
+          entry.proxy =
+            string_proxy(std::string_view{key(entry.index)}.substr(depth));
+        }
+      }
+
+      if (entries.size() < proxy_radix_threshold) {
+        std::ranges::stable_sort(entries, {}, &proxy_entry::proxy);
+      } else {
+        radix_sort_proxies(entries, scratch);
+      }
+
+      constexpr auto window = sizeof(std::uint64_t);
+
+      // Keys that go on past the window are tagged window + 1.
+      auto const tag = [&](proxy_entry const& e) {
+        return std::min(std::string_view{key(e.index)}.size() - depth, window + 1);
+      };
+
+      for (auto run = entries.begin(); run != entries.end();) {
+        auto const run_end = std::ranges::find_if(run + 1,
+          entries.end(),
+          [&](proxy_entry const& e) { return e.proxy != run->proxy; });
+        if (run_end - run > 1) {
+          std::ranges::stable_sort(run, run_end, {}, tag);
+
+          auto const longer = std::ranges::find_if(
+            run, run_end, [&](proxy_entry const& e) { return tag(e) > window; });
+          if (run_end - longer > 1) {
+            refine_proxies(
+              std::span{longer, run_end}, depth + window, key, scratch);
+          }
+        }
+        run = run_end;
+      }
+    }
+
+  } // namespace detail
+
+  /**
+   * @brief Function object that sorts a sequence by a string key, through
+   * the string_proxy of every key.
+   *
+   * The elements are the payload: any movable type, with the key its
+   * projection. The proxies and the indices of the elements are radix
+   * sorted, and runs of equal proxies are refined on the proxies of the
+   * next 8 bytes of their keys, so keys are read a word at a time rather
+   * than on every comparison, and long shared prefixes are read once.
+   * The elements are then moved into their order through a buffer, once
+   * each.
+   *
+   * The sort is stable, and orders the keys like std::string_view does.
+   * It allocates 16 bytes per element twice, plus one element each.
+   */
+  constexpr inline struct proxy_sort_fn {
+    /**
+     * @brief Sorts [first, last) by `proj` of the elements.
+     *
+     * @tparam Proj Projection from an element to its key, which must be
+     * convertible to `std::string_view`. Defaults to `std::identity`.
+     *
+     * @return An iterator equal to `last`.
+     *
+     * @complexity
+     * O(N * L / 8) for keys of length L, plus comparison sorts of short
+     * runs of equal proxies.
+     */
+    template <std::random_access_iterator I,
+      std::sentinel_for<I>                S,
+      typename Proj = std::identity>
+      requires std::permutable<I>
+            && std::convertible_to<std::indirect_result_t<Proj&, I>,
+                 std::string_view>
+            && std::constructible_from<std::iter_value_t<I>,
+                 std::iter_rvalue_reference_t<I>>
+    static auto operator()(I first, S last, Proj proj = {}) -> I
+    {
+      auto const count =
+        static_cast<std::size_t>(std::ranges::distance(first, last));
+
+      auto const key = [&](std::size_t index) -> decltype(auto) {
+        return std::invoke(
+          proj, first[static_cast<std::iter_difference_t<I>>(index)]);
+      };
+
+      auto entries = std::vector<detail::proxy_entry>(count);
+      for (auto index = std::size_t{0}; index < count; ++index) {
+        entries[index] = {string_proxy(key(index)), index};
+      }
+
+      auto scratch = std::vector<detail::proxy_entry>{};
+      detail::refine_proxies(std::span{entries}, 0, key, scratch);
+
+      auto buffer = std::vector<std::iter_value_t<I>>{};
+      buffer.reserve(count);
+      for (auto const& entry : entries) {
+        buffer.emplace_back(std::ranges::iter_move(
+          first + static_cast<std::iter_difference_t<I>>(entry.index)));
+      }
+      return std::ranges::move(buffer, first).out;
+    }
+
+    /**
+     * @brief Sorts `range` by `proj` of its elements.
+     *
+     * @see operator()(I first, S last, Proj proj)
+     */
+    template <std::ranges::random_access_range R,
+      typename Proj = std::identity>
+      requires std::permutable<std::ranges::iterator_t<R>>
+            && std::convertible_to<
+                 std::indirect_result_t<Proj&, std::ranges::iterator_t<R>>,
+                 std::string_view>
+            && std::constructible_from<std::ranges::range_value_t<R>,
+                 std::ranges::range_rvalue_reference_t<R>>
+    static auto operator()(R&& range, Proj proj = {})
+      -> std::ranges::borrowed_iterator_t<R>
+    {
+      return operator()(
+        std::ranges::begin(range), std::ranges::end(range), std::move(proj));
+    }
+  } const proxy_sort{};
+
+} // namespace vault::algorithm
+
+#endif // VAULT_ALGORITHM_PROXY_SORT_HPP
@@ -0,0 +1,359 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_ALGORITHM_SHARDED_SHORTEST_COMMON_SUPERSTRING_HPP
+#define VAULT_ALGORITHM_SHARDED_SHORTEST_COMMON_SUPERSTRING_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <range/v3/range/conversion.hpp>
+
+#include <vault/algorithm/overlap_graph.hpp>
+#include <vault/algorithm/shortest_common_superstring.hpp>
+#include <vault/executor/thread_executor.hpp>
+
+namespace vault::algorithm {
+
+  /**
+   * @brief How `sharded_shortest_common_superstring` partitions its
+   * input.
+   */
+  struct superstring_sharding {
+    /// The number of shards. Zero selects the executor's concurrency.
+    std::size_t shard_count = 0;
+
+    /// The length of the k-mers whose hashes place a string in a shard.
+    std::size_t key_length = 4;
+  };
+
+  /**
+   * @brief Computes a common superstring by running the greedy
+   * algorithm on shards of the input in parallel, and then once more on
+   * the shard results.
+   *
+   * Every string goes to the shard of its minimizer, the smallest hash
+   * of any of its k-mers. Two strings that overlap by at least
+   * `key_length` symbols share the k-mers of the overlap, so the longer
+   * the overlap the more likely the two strings land in the same
+   * shard. Strings shorter than `key_length` are hashed whole.
+   *
+   * Each shard is reduced to a superstring by
+   * `greedy_shortest_common_superstring` on the executor. A second
+   * greedy pass then merges the shard superstrings by their
+   * boundaries. An overlap across shards is made of input strings, so
+   * only a prefix and a suffix of each shard superstring, as long as
+   * the longest input string, are compared, and the shard results are
+   * spliced together along the overlaps chosen between them. The
+   * second pass thus compares O(shards² · longest) symbols at most,
+   * however long the shard results are.
+   *
+   * Overlaps that cross shards are only found between the ends of
+   * shard results, and a shard result that occurs within another is
+   * kept whole, so the result is usually longer than that of the
+   * greedy algorithm over all strings at once; in exchange the
+   * all-pairs work drops by roughly a factor of the shard count, and
+   * the shards run concurrently.
+   *
+   * The hash of the symbols only affects which strings are grouped
+   * together, never the validity of the result. It should agree with
+   * the comparator, i.e. equivalent symbols should hash alike, for the
+   * grouping to be useful.
+   *
+   * @code
+   * auto scs = vault::algorithm::sharded_shortest_common_superstring{
+   *   vault::algorithm::superstring_sharding{.shard_count = 64}};
+   * auto result = scs(strings, std::back_inserter(bounds));
+   * @endcode
+   *
+   * @tparam Executor A `chunked_executor` that runs the shards.
+   * @tparam Engine The overlap engine used within and across shards.
+   * @tparam Hash Hash function for the symbols (default: `std::hash` of
+   *   the symbol type).
+   */
+  template <chunked_executor Executor = thread_executor,
+    typename Engine = knuth_morris_pratt_overlap_engine_fn,
+    typename Hash   = detail::std_symbol_hash_fn>
+  class sharded_shortest_common_superstring {
+    superstring_sharding       m_sharding;
+    Executor                   m_executor;
+    Engine                     m_engine;
+    [[no_unique_address]] Hash m_hash;
+
+    template <typename S>
+    [[nodiscard]] auto minimizer(S const& s) const -> std::size_t
+    {
+      auto const length = static_cast<std::size_t>(std::ranges::distance(s));
+      auto const k      = std::clamp(m_sharding.key_length,
+        std::size_t{1},
+        std::max(length, std::size_t{1}));
+
+      auto best  = std::numeric_limits<std::size_t>::max();
+      auto first = std::ranges::begin(s);
+
+      for (auto i = std::size_t{0}; i + k <= length; ++i, ++first) {
+        auto h    = std::size_t{14695981039346656037ULL};
+        auto last = first;
+        for (auto j = std::size_t{0}; j < k; ++j, ++last) {
+          h = (h ^ static_cast<std::size_t>(std::invoke(m_hash, *last)))
+            * std::size_t{1099511628211ULL};
+        }
+        best = std::min(best, h);
+      }
+
+      return best;
+    }
+
+  public:
+    /**
+     * @param sharding The partitioning of the input.
+     * @param executor The executor that runs the shards.
+     * @param engine The overlap engine.
+     * @param hash The hash function for the symbols.
+     */
+    [[nodiscard]] explicit sharded_shortest_common_superstring(
+      superstring_sharding sharding = {},
+      Executor             executor = {},
+      Engine               engine   = {},
+      Hash                 hash     = {})
+        : m_sharding{sharding}
+        , m_executor{std::move(executor)}
+        , m_engine{std::move(engine)}
+        , m_hash{std::move(hash)}
+    {}
+
+    [[nodiscard]] auto shard_count() const noexcept -> std::size_t
+    {
+      return m_sharding.shard_count != 0
+        ? m_sharding.shard_count
+        : std::max(std::size_t{m_executor.concurrency()}, std::size_t{1});
+    }
+
+    /**
+     * @brief Computes the superstring.
+     *
+     * @param strings The input strings.
+     * @param out Receives one subrange of the superstring per input
+     *   string, in input order.
+     * @param comp Equivalence relation on the string elements.
+     */
+    template <std::ranges::forward_range R,
+      typename Out,
+      typename Comp = std::equal_to<>>
+      requires inner_element_comparator<Comp, R>
+      && superstring_bounds_output<Out,
+        std::iter_value_t<detail::inner_iterator_t<R>>>
+    [[nodiscard]] auto operator()(R&& strings, Out out, Comp comp = {}) const
+      -> greedy_shortest_common_superstring_fn::result<
+        std::ranges::iterator_t<R>,
+        Out,
+        detail::superstring_container_t<R, std::identity>>
+    {
+      using InputString  = std::ranges::range_reference_t<R>;
+      using SuperStringT = detail::superstring_container_t<R, std::identity>;
+      using bounds_t = std::ranges::subrange<typename SuperStringT::iterator>;
+      using result_t = greedy_shortest_common_superstring_fn::
+        result<std::ranges::iterator_t<R>, Out, SuperStringT>;
+
+      using ReductionString =
+        std::conditional_t<std::is_lvalue_reference_v<InputString>,
+          std::ranges::ref_view<std::remove_reference_t<InputString>>,
+          std::remove_cvref_t<InputString>>;
+      using Piece =
+        std::ranges::subrange<std::ranges::iterator_t<ReductionString const>>;
+
+      auto const working_set =
+        strings | ::ranges::to<std::vector<ReductionString>>();
+      auto const count = working_set.size();
+
+      if (count == 0) {
+        return result_t{std::ranges::end(strings), out, {}, 0};
+      }
+
+      // Partition
+      auto const shards = shard_count();
+      auto       shard  = std::vector<std::size_t>(count);
+      auto       pieces = std::vector<std::vector<Piece>>(shards);
+      auto       member = std::vector<std::vector<std::size_t>>(shards);
+
+      for (auto i = std::size_t{0}; i < count; ++i) {
+        shard[i] = minimizer(working_set[i]) % shards;
+        pieces[shard[i]].emplace_back(working_set[i]);
+        member[shard[i]].push_back(i);
+      }
+
+      // First pass: one greedy superstring per shard.
+      auto offset             = std::vector<std::size_t>(count, 0);
+      auto shard_superstrings = std::vector<SuperStringT>(shards);
+
+      m_executor(shards,
+        1,
+        [&](std::size_t, std::size_t first, std::size_t last) {
+          for (auto s = first; s < last; ++s) {
+            if (pieces[s].empty()) {
+              continue;
+            }
+
+            auto bounds = std::vector<bounds_t>{};
+            auto result = greedy_shortest_common_superstring(
+              m_engine, pieces[s], std::back_inserter(bounds), comp);
+
+            for (auto k = std::size_t{0}; k < bounds.size(); ++k) {
+              offset[member[s][k]] = static_cast<std::size_t>(
+                bounds[k].begin() - result.superstring.begin());
+            }
+            shard_superstrings[s] = std::move(result.superstring);
+          }
+        });
+
+      // Second pass: merge the shard results by their boundaries.
+      //
+      // An overlap across shards is made of strings at the ends of two
+      // shard results, so it is no longer than the longest input string.
+      // Only a suffix and a prefix window of that length are compared,
+      // suffix windows first, and the edges from a suffix onto the
+      // prefix of another shard are kept.
+      auto longest = std::size_t{0};
+      for (auto const& str : working_set) {
+        longest = std::max(
+          longest, static_cast<std::size_t>(std::ranges::distance(str)));
+      }
+
+      using Window =
+        std::ranges::subrange<typename SuperStringT::const_iterator>;
+
+      auto windows = std::vector<Window>(2 * shards);
+      for (auto s = std::size_t{0}; s < shards; ++s) {
+        auto const& str = shard_superstrings[s];
+        auto const  width =
+          std::min(longest, std::max(str.size(), std::size_t{1}) - 1);
+        auto const first = std::ranges::next(str.begin(), str.size() - width);
+
+        windows[s]          = Window{first, str.end()};
+        windows[shards + s] = Window{str.begin(), str.begin() + width};
+      }
+
+      auto edges = std::vector<overlap_edge>{};
+      auto push  = [&](overlap_edge const& e) {
+        if (e.lhs < shards && e.rhs >= shards && e.rhs - shards != e.lhs) {
+          edges.push_back(overlap_edge{e.lhs, e.rhs - shards, e.score});
+        }
+      };
+
+      // A pruned engine could keep the overlaps between windows at the
+      // same end in place of these, so the windows go to the engine it
+      // wraps; there are only twice as many as shards.
+      if constexpr (pruning_overlap_engine<Engine>) {
+        detail::run_overlap_engine(m_engine.engine(),
+          windows,
+          comp,
+          detail::edge_sink_iterator{push},
+          1);
+      } else {
+        detail::run_overlap_engine(
+          m_engine, windows, comp, detail::edge_sink_iterator{push}, 1);
+      }
+
+      std::ranges::sort(edges, {}, [](overlap_edge const& e) {
+        return std::pair{e.lhs, e.rhs};
+      });
+
+      constexpr auto npos = std::numeric_limits<std::size_t>::max();
+
+      auto graph     = bucket_queue_overlap_graph{shards, std::move(edges)};
+      auto is_head   = std::vector<bool>(shards, true);
+      auto successor = std::vector<std::size_t>(shards, npos);
+      auto successor_overlap = std::vector<std::size_t>(shards, 0);
+      auto chain_tail        = std::vector<std::size_t>(shards);
+      std::iota(chain_tail.begin(), chain_tail.end(), std::size_t{0});
+
+      while (auto const entry = graph.pop()) {
+        auto const lhs = entry->lhs;
+        auto const rhs = entry->rhs;
+
+        auto const tail         = chain_tail[lhs];
+        successor[tail]         = rhs;
+        successor_overlap[tail] = entry->score;
+        chain_tail[lhs]         = chain_tail[rhs];
+        is_head[rhs]            = false;
+
+        graph.merge(lhs, rhs);
+      }
+
+      // Splice the shard results together along the chosen overlaps,
+      // recording where each of them starts.
+      auto superstring = SuperStringT{};
+      auto start       = std::vector<std::size_t>(shards, 0);
+
+      auto superstring_size = std::size_t{0};
+      for (auto s = std::size_t{0}; s < shards; ++s) {
+        superstring_size +=
+          shard_superstrings[s].size() - successor_overlap[s];
+      }
+      superstring.reserve(superstring_size);
+
+      for (auto head = std::size_t{0}; head < shards; ++head) {
+        if (!is_head[head]) {
+          continue;
+        }
+
+        auto skip = std::size_t{0};
+        for (auto s = head; s != npos; s = successor[s]) {
+          auto& str = shard_superstrings[s];
+
+          start[s] = superstring.size() - skip;
+          superstring.insert(superstring.end(),
+            std::make_move_iterator(std::ranges::next(str.begin(), skip)),
+            std::make_move_iterator(str.end()));
+          skip = successor_overlap[s];
+        }
+      }
+
+      assert(superstring.size() == superstring_size);
+
+      auto const super_begin = superstring.begin();
+
+      auto total_length = std::size_t{0};
+      for (auto i = std::size_t{0}; i < count; ++i) {
+        auto const length = static_cast<std::size_t>(
+          std::ranges::distance(working_set[i]));
+
+        total_length += length;
+        detail::write_superstring_bounds(
+          out, super_begin, start[shard[i]] + offset[i], length);
+      }
+
+      auto const total_overlap = total_length - superstring.size();
+
+      return result_t{std::ranges::end(strings),
+        out,
+        std::move(superstring),
+        total_overlap};
+    }
+  };
+
+  template <chunked_executor Executor>
+  sharded_shortest_common_superstring(superstring_sharding, Executor)
+    -> sharded_shortest_common_superstring<Executor>;
+
+  template <chunked_executor Executor, typename Engine>
+  sharded_shortest_common_superstring(superstring_sharding, Executor, Engine)
+    -> sharded_shortest_common_superstring<Executor, Engine>;
+
+  template <chunked_executor Executor, typename Engine, typename Hash>
+  sharded_shortest_common_superstring(
+    superstring_sharding, Executor, Engine, Hash)
+    -> sharded_shortest_common_superstring<Executor, Engine, Hash>;
+
+} // namespace vault::algorithm
+
+#endif // VAULT_ALGORITHM_SHARDED_SHORTEST_COMMON_SUPERSTRING_HPP
@@ -4,29 +4,33 @@
 #define VAULT_ALGORITHM_SHORTEST_COMMON_SUPERSTRING_HPP
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <chrono>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <numeric>
 #include <ranges>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
-#include <boost/multi_index_container.hpp>
-
 #include <range/v3/range/conversion.hpp>
-#include <range/v3/view/addressof.hpp>
-#include <range/v3/view/indirect.hpp>
 #include <range/v3/view/transform.hpp>
-#include <range/v3/view/zip.hpp>
 
+#include <vault/algorithm/aho_corasick_automaton.hpp>
 #include <vault/algorithm/knuth_morris_pratt_failure_function.hpp>
 #include <vault/algorithm/knuth_morris_pratt_overlap.hpp>
-#include <vault/algorithm/knuth_morris_pratt_searcher.hpp>
+#include <vault/algorithm/overlap_graph.hpp>
+#include <vault/executor/thread_executor.hpp>
+#include <vault/metrics/metrics.hpp>
 
 namespace vault::algorithm {
 
@@ -45,6 +49,16 @@ namespace vault::algorithm {
     template <typename R, typename Proj>
     using superstring_container_t =
       std::vector<inner_projected_value_t<Proj, R>>;
+
+    // The strings that survive filtering are packed into one buffer of
+    // this type, and handed to the overlap engine as subranges of it.
+    template <typename R, typename Proj>
+    using superstring_pool_t =
+      std::pmr::vector<inner_projected_value_t<Proj, R>>;
+
+    template <typename R, typename Proj>
+    using superstring_pieces_t = std::pmr::vector<std::ranges::subrange<
+      typename superstring_pool_t<R, Proj>::iterator>>;
   } // namespace detail
 
   // --- reusable concepts ---
@@ -76,42 +90,1194 @@ namespace vault::algorithm {
     std::ranges::subrange<typename std::vector<ValueType>::iterator>>;
 
   /**
-   * @brief Computes an approximation of the Shortest Common Superstring (SCS)
-   * using a Greedy strategy.
+   * @brief The location of a string in a superstring as an offset and a
+   * length, stored in `Width`.
+   *
+   * Unlike a subrange this does not refer to a particular superstring
+   * object, so it can be persisted as is, and at 32 bits it takes half
+   * the space of a pair of iterators.
+   */
+  template <std::unsigned_integral Width = std::uint32_t>
+  struct superstring_offset {
+    using width_type = Width;
+
+    Width offset;
+    Width length;
+
+    [[nodiscard]] friend constexpr auto operator==(
+      superstring_offset const&, superstring_offset const&) -> bool = default;
+  };
+
+  /**
+   * @brief Output adaptor that has the superstring algorithms write one
+   * `superstring_offset<Width>` per input string to `out`, instead of
+   * a subrange.
+   *
+   * @see superstring_offsets
+   */
+  template <std::unsigned_integral Width,
+    std::output_iterator<superstring_offset<Width>> Out>
+  struct superstring_offset_output {
+    using width_type = Width;
+
+    Out out;
+  };
+
+  namespace detail {
+    template <typename Out>
+    constexpr inline auto const is_superstring_offset_output_v = false;
+
+    template <typename Width, typename Out>
+    constexpr inline auto const is_superstring_offset_output_v<
+      superstring_offset_output<Width, Out>> = true;
+
+    template <std::unsigned_integral Width>
+    struct superstring_offsets_fn {
+      template <std::output_iterator<superstring_offset<Width>> Out>
+      [[nodiscard]] static constexpr auto operator()(Out out)
+        -> superstring_offset_output<Width, Out>
+      {
+        return superstring_offset_output<Width, Out>{std::move(out)};
+      }
+    };
+  } // namespace detail
+
+  /**
+   * @brief Wraps an output iterator so that a superstring algorithm
+   * writes `superstring_offset<Width>` values to it.
+   *
+   * Offsets and lengths must fit in `Width`; this is asserted.
+   *
+   * @code
+   * auto offsets = frozen::frozen_vector_builder<
+   *   vault::algorithm::superstring_offset<std::uint32_t>>{};
+   * auto result = vault::algorithm::shortest_common_superstring(strings,
+   *   vault::algorithm::superstring_offsets<std::uint32_t>(
+   *     std::back_inserter(offsets)));
+   * auto table = std::move(offsets).freeze();
+   * @endcode
+   */
+  template <std::unsigned_integral Width = std::uint32_t>
+  constexpr inline auto const superstring_offsets =
+    detail::superstring_offsets_fn<Width>{};
+
+  // Verifies that Out can receive the locations of the input strings in
+  // a superstring of ValueType: either an output iterator of subranges
+  // or a superstring_offset_output.
+  template <typename Out, typename ValueType>
+  concept superstring_bounds_output =
+    vector_subrange_output_iterator<Out, ValueType>
+    || detail::is_superstring_offset_output_v<Out>;
+
+  namespace detail {
+    // Writes the location of one string to a superstring_bounds_output.
+    template <typename Out, typename I>
+    constexpr void write_superstring_bounds(
+      Out& out, I super_begin, std::size_t offset, std::size_t length)
+    {
+      if constexpr (is_superstring_offset_output_v<Out>) {
+        using width_t = typename Out::width_type;
+
+        assert(std::in_range<width_t>(offset + length)
+          && "Superstring offset does not fit in the offset width.");
+
+        *out.out++ = superstring_offset<width_t>{
+          static_cast<width_t>(offset), static_cast<width_t>(length)};
+      } else {
+        auto const first = std::ranges::next(super_begin, offset);
+        *out++ = std::ranges::subrange(first, std::ranges::next(first, length));
+      }
+    }
+  } // namespace detail
+
+  /**
+   * @brief Verifies that E computes the overlap graph of a set of
+   * strings.
+   *
+   * An overlap engine is invoked with a random access range of
+   * strings, a comparator and an output iterator. It must write one
+   * `overlap_edge` for every ordered pair `(i, j)`, `i != j`, whose
+   * longest suffix-prefix overlap is nonzero. Edges may be written in
+   * any order.
+   *
+   * Engines that can use them to save work also accept `overlap_bounds`
+   * as a fourth argument. They then write the longest overlap of each
+   * pair of at most `max_score` symbols, if it has at least `min_score`,
+   * which is no longer the whole graph unless the bounds are the
+   * defaults.
+   */
+  template <typename E, typename Strings, typename Comp>
+  concept overlap_engine = std::invocable<E const&,
+    Strings const&,
+    Comp const&,
+    overlap_edge*>;
+
+  // Verifies that E is an overlap engine that accepts overlap_bounds.
+  template <typename E, typename Strings, typename Comp>
+  concept bounded_overlap_engine = overlap_engine<E, Strings, Comp>
+    && std::invocable<E const&,
+      Strings const&,
+      Comp const&,
+      overlap_edge*,
+      overlap_bounds const&>;
+
+  namespace detail {
+    // Writes the nonzero KMP overlaps of rows [first, last) of the
+    // overlap matrix.
+    template <typename Strings,
+      typename FailureTables,
+      typename Comp,
+      typename Out>
+    constexpr auto knuth_morris_pratt_overlap_rows(Strings const& strings,
+      FailureTables const&                                       ftables,
+      Comp const&                                                comp,
+      overlap_bounds const&                                      bounds,
+      std::size_t                                                first,
+      std::size_t                                                last,
+      Out                                                        out) -> Out
+    {
+      auto const count = std::ranges::size(strings);
+
+      for (auto i = first; i < last; ++i) {
+        for (auto j = std::size_t{0}; j < count; ++j) {
+          if (i == j) {
+            continue;
+          }
+
+          auto const score =
+            ftables.visit(j, [&](auto const& table) -> std::ptrdiff_t {
+              return knuth_morris_pratt_overlap(
+                strings[i], strings[j], table, bounds, comp)
+                .score;
+            });
+
+          if (score > 0) {
+            *out++ = overlap_edge{i, j, static_cast<std::size_t>(score)};
+          }
+        }
+      }
+
+      return out;
+    }
+  } // namespace detail
+
+  /**
+   * @brief Overlap engine that runs `knuth_morris_pratt_overlap` for
+   * every ordered pair of strings.
+   *
+   * @par Complexity
+   * O(n² · L) time, where n is the number of strings and L the mean
+   * string length; O(n · L) auxiliary space for the failure tables,
+   * which are packed into a single buffer with entries as narrow as
+   * each string allows.
+   */
+  constexpr inline struct knuth_morris_pratt_overlap_engine_fn {
+    template <std::ranges::random_access_range Strings,
+      typename Comp,
+      std::output_iterator<overlap_edge> Out>
+    static constexpr auto operator()(Strings const& strings,
+      Comp const&                                  comp,
+      Out                                          out,
+      overlap_bounds const&                        bounds = {}) -> Out
+    {
+      auto const ftables =
+        compact_knuth_morris_pratt_failure_tables{strings, comp};
+
+      return detail::knuth_morris_pratt_overlap_rows(strings,
+        ftables,
+        comp,
+        bounds,
+        0,
+        std::ranges::size(strings),
+        std::move(out));
+    }
+  } const knuth_morris_pratt_overlap_engine{};
+
+  /**
+   * @brief Overlap engine that distributes the rows of the KMP overlap
+   * matrix over a chunked executor.
+   *
+   * Failure tables and rows are computed in parallel. Each worker
+   * appends to its own edge buffer; the buffers are concatenated once
+   * all rows are done. The superstring pipeline sorts the edges before
+   * loading them, so the result is identical to that of
+   * `knuth_morris_pratt_overlap_engine` for any executor.
+   *
+   * @code
+   * auto engine = vault::algorithm::parallel_knuth_morris_pratt_overlap_engine{
+   *   vault::algorithm::thread_executor{64}};
+   * auto result = vault::algorithm::shortest_common_superstring(
+   *   engine, strings, std::back_inserter(bounds));
+   * @endcode
+   *
+   * @tparam Executor A `chunked_executor`.
+   */
+  template <chunked_executor Executor = thread_executor>
+  class parallel_knuth_morris_pratt_overlap_engine {
+    Executor    m_executor;
+    std::size_t m_grain;
+
+  public:
+    /**
+     * @param executor The executor that runs the rows.
+     * @param grain The number of rows handed to a worker at a time.
+     */
+    [[nodiscard]] explicit parallel_knuth_morris_pratt_overlap_engine(
+      Executor executor = {}, std::size_t grain = 16)
+        : m_executor{std::move(executor)}
+        , m_grain{grain}
+    {}
+
+    [[nodiscard]] auto executor() const noexcept -> Executor const&
+    {
+      return m_executor;
+    }
+
+    template <std::ranges::random_access_range Strings,
+      typename Comp,
+      std::output_iterator<overlap_edge> Out>
+    auto operator()(Strings const& strings,
+      Comp const&                  comp,
+      Out                          out,
+      overlap_bounds const&        bounds = {}) const -> Out
+    {
+      auto const count = std::ranges::size(strings);
+
+      // The layout is computed up front, so that the workers can fill
+      // their tables in place without synchronizing.
+      auto ftables = compact_knuth_morris_pratt_failure_tables{
+        strings | std::views::transform([](auto const& s) {
+          return std::ranges::distance(s);
+        })};
+      m_executor(count,
+        m_grain,
+        [&](std::size_t, std::size_t first, std::size_t last) {
+          for (auto i = first; i < last; ++i) {
+            ftables.assign(i, strings[i], comp);
+          }
+        });
+
+      auto buffers = std::vector<std::vector<overlap_edge>>(
+        m_executor.concurrency());
+
+      m_executor(count,
+        m_grain,
+        [&](std::size_t worker, std::size_t first, std::size_t last) {
+          detail::knuth_morris_pratt_overlap_rows(strings,
+            ftables,
+            comp,
+            bounds,
+            first,
+            last,
+            std::back_inserter(buffers[worker]));
+        });
+
+      for (auto const& buffer : buffers) {
+        out = std::ranges::copy(buffer, std::move(out)).out;
+      }
+
+      return out;
+    }
+  };
+
+  template <chunked_executor Executor>
+  parallel_knuth_morris_pratt_overlap_engine(Executor, std::size_t = 16)
+    -> parallel_knuth_morris_pratt_overlap_engine<Executor>;
+
+  /**
+   * @brief Overlap engine that computes all suffix-prefix overlaps at
+   * once with an Aho-Corasick automaton over the strings.
+   *
+   * This is Gusfield's all-pairs suffix-prefix algorithm. The failure
+   * chain of the node at which string `i` ends enumerates every
+   * suffix of `i` that is a prefix of some string. A depth-first
+   * traversal of the trie then keeps, for each `i`, a stack of the
+   * suffix lengths that lie on the current root path, so that on
+   * reaching the end of string `j` the top of the stack of `i` is the
+   * longest overlap of `i` onto `j`. Only strings with a non-empty
+   * stack are visited at the end of `j`, so every visit produces an
+   * edge.
+   *
+   * The strings must be free of duplicates and of strings contained in
+   * other strings, which is what the superstring pipeline guarantees
+   * after its filtering phase.
+   *
+   * @par Complexity
+   * O(L · σ + E) time and O(L + E) space, where L is the total length
+   * of the strings, σ the alphabet size seen at a trie node and E the
+   * number of nonzero edges.
+   */
+  constexpr inline struct aho_corasick_overlap_engine_fn {
+    template <std::ranges::random_access_range Strings,
+      typename Comp,
+      std::output_iterator<overlap_edge> Out>
+    static constexpr auto operator()(
+      Strings const& strings, Comp const& comp, Out out) -> Out
+    {
+      using symbol_t = std::ranges::range_value_t<
+        std::ranges::range_reference_t<Strings const&>>;
+      using automaton_t = aho_corasick_automaton<symbol_t, Comp>;
+      using node_t      = typename automaton_t::node_type;
+
+      auto const automaton = automaton_t{strings, comp};
+      auto const count     = std::ranges::size(strings);
+
+      // suffixes[v] lists the strings that have the string of node v
+      // as a proper suffix, in CSR form.
+      auto suffix_offsets = std::vector<std::size_t>(automaton.size() + 1, 0);
+
+      auto for_each_suffix = [&](std::size_t i, auto&& fn) {
+        auto const end = automaton.pattern_node(i);
+        for (auto v = automaton.failure(end); v != automaton.root();
+          v      = automaton.failure(v)) {
+          fn(v);
+        }
+      };
+
+      // The stack of string i below holds at most one entry per node on
+      // its failure chain, so all stacks fit in one CSR buffer as well.
+      auto stack_offsets = std::vector<std::size_t>(count + 1, 0);
+
+      for (auto i = std::size_t{0}; i < count; ++i) {
+        for_each_suffix(i, [&](node_t v) {
+          ++suffix_offsets[v + 1];
+          ++stack_offsets[i + 1];
+        });
+      }
+
+      for (auto v = std::size_t{0}; v < automaton.size(); ++v) {
+        suffix_offsets[v + 1] += suffix_offsets[v];
+      }
+      for (auto i = std::size_t{0}; i < count; ++i) {
+        stack_offsets[i + 1] += stack_offsets[i];
+      }
+
+      auto suffixes = std::vector<std::size_t>(suffix_offsets.back());
+      auto cursors  = suffix_offsets;
+
+      for (auto i = std::size_t{0}; i < count; ++i) {
+        for_each_suffix(i, [&](node_t v) { suffixes[cursors[v]++] = i; });
+      }
+
+      // The strings ending at each node. Since the input is free of
+      // duplicates this is at most one string, but nothing below
+      // depends on that.
+      auto ends_offsets = std::vector<std::size_t>(automaton.size() + 1, 0);
+      for (auto j = std::size_t{0}; j < count; ++j) {
+        ++ends_offsets[automaton.pattern_node(j) + 1];
+      }
+      for (auto v = std::size_t{0}; v < automaton.size(); ++v) {
+        ends_offsets[v + 1] += ends_offsets[v];
+      }
+      auto ends = std::vector<std::size_t>(ends_offsets.back());
+      cursors   = ends_offsets;
+      for (auto j = std::size_t{0}; j < count; ++j) {
+        ends[cursors[automaton.pattern_node(j)]++] = j;
+      }
+
+      // Per-string stacks of suffix lengths along the current root
+      // path, and the set of strings whose stack is non-empty.
+      auto stacks          = std::vector<std::size_t>(stack_offsets.back());
+      auto stack_size      = std::vector<std::size_t>(count, 0);
+      auto active          = std::vector<std::size_t>{};
+      auto active_position = std::vector<std::size_t>(count, 0);
+
+      auto stack_top = [&](std::size_t i) -> std::size_t& {
+        return stacks[stack_offsets[i] + stack_size[i] - 1];
+      };
+
+      auto enter = [&](node_t v) {
+        for (auto k = suffix_offsets[v]; k < suffix_offsets[v + 1]; ++k) {
+          auto const i = suffixes[k];
+          if (stack_size[i]++ == 0) {
+            active_position[i] = active.size();
+            active.push_back(i);
+          }
+          stack_top(i) = automaton.depth(v);
+        }
+
+        for (auto k = ends_offsets[v]; k < ends_offsets[v + 1]; ++k) {
+          auto const j = ends[k];
+          for (auto const i : active) {
+            if (i != j) {
+              *out++ = overlap_edge{i, j, stack_top(i)};
+            }
+          }
+        }
+      };
+
+      auto leave = [&](node_t v) {
+        for (auto k = suffix_offsets[v]; k < suffix_offsets[v + 1]; ++k) {
+          auto const i = suffixes[k];
+          if (--stack_size[i] == 0) {
+            auto const last            = active.back();
+            active[active_position[i]] = last;
+            active_position[last]      = active_position[i];
+            active.pop_back();
+          }
+        }
+      };
+
+      // Iterative depth-first traversal; the trie can be as deep as the
+      // longest string.
+      auto path = std::vector<node_t>{automaton.root()};
+      enter(automaton.root());
+
+      while (!path.empty()) {
+        auto const v = path.back();
+        auto const c = automaton.first_child(v);
+
+        if (c != automaton_t::npos) {
+          path.push_back(c);
+          enter(c);
+          continue;
+        }
+
+        // Leaf: unwind until a node with an unvisited sibling is found.
+        while (!path.empty()) {
+          auto const u = path.back();
+          path.pop_back();
+          leave(u);
+
+          if (path.empty()) {
+            break;
+          }
+
+          auto const s = automaton.next_sibling(u);
+          if (s != automaton_t::npos) {
+            path.push_back(s);
+            enter(s);
+            break;
+          }
+        }
+      }
+
+      return out;
+    }
+  } const aho_corasick_overlap_engine{};
+
+  namespace detail {
+    // Hashes a symbol with the std::hash of its type.
+    struct std_symbol_hash_fn {
+      template <typename T>
+      [[nodiscard]] static constexpr auto operator()(T const& t)
+        -> std::size_t
+      {
+        return std::hash<T>{}(t);
+      }
+    };
+
+    // The splitmix64 finalizer. Polynomial fingerprints modulo 2^64 are
+    // weak in their low bits, which are the ones that pick a bucket.
+    [[nodiscard]] constexpr auto mix_fingerprint(std::uint64_t x) noexcept
+      -> std::uint64_t
+    {
+      x = (x ^ (x >> 30)) * std::uint64_t{0xbf58476d1ce4e5b9};
+      x = (x ^ (x >> 27)) * std::uint64_t{0x94d049bb133111eb};
+      return x ^ (x >> 31);
+    }
+  } // namespace detail
+
+  /**
+   * @brief Overlap engine that joins Karp-Rabin fingerprints of
+   * prefixes and suffixes, and compares only the pairs that match.
+   *
+   * Every prefix of every string is fingerprinted and entered into a
+   * hash table, keyed by its length and fingerprint, which is laid out
+   * in CSR form. Each string then looks up the fingerprints of its own
+   * suffixes, longest first. A string `j` found under a suffix of
+   * length L is compared with `comp` over those L symbols, and the
+   * first length that holds is the overlap onto `j`. Pairs that share
+   * no fingerprint are never compared at all, so on long strings that
+   * rarely overlap, such as log templates, the work is close to linear
+   * in the input instead of in the number of pairs times their length.
+   *
+   * Fingerprints are polynomials modulo 2^64 over `hash(symbol)`, so
+   * `Hash` must agree with `Comp`: symbols that compare equal must hash
+   * alike, or overlaps are missed. A collision only costs a comparison.
+   *
+   * @code
+   * auto result = vault::algorithm::shortest_common_superstring(
+   *   vault::algorithm::karp_rabin_overlap_engine{}, templates,
+   *   std::back_inserter(bounds));
+   * @endcode
+   *
+   * @tparam Hash Hash function for the symbols (default: `std::hash` of
+   *   the symbol type).
+   *
+   * @par Complexity
+   * O(T + C · L) expected time and O(T) space, where T is the total
+   * length of the strings, C the number of fingerprint matches and L
+   * the mean length of a match.
+   */
+  template <typename Hash = detail::std_symbol_hash_fn>
+  class karp_rabin_overlap_engine {
+    static constexpr auto const npos = static_cast<std::size_t>(-1);
+    static constexpr auto const base = std::uint64_t{0x100000001b3};
+
+    struct entry {
+      std::uint64_t key;
+      std::size_t   string;
+    };
+
+    [[no_unique_address]] Hash m_hash;
+
+    [[nodiscard]] static constexpr auto key_of(
+      std::uint64_t fingerprint, std::size_t length) noexcept -> std::uint64_t
+    {
+      return detail::mix_fingerprint(
+        fingerprint ^ (length * std::uint64_t{0x9e3779b97f4a7c15}));
+    }
+
+  public:
+    [[nodiscard]] explicit karp_rabin_overlap_engine(Hash hash = {})
+        : m_hash{std::move(hash)}
+    {}
+
+    template <std::ranges::random_access_range Strings,
+      typename Comp,
+      std::output_iterator<overlap_edge> Out>
+      requires std::ranges::bidirectional_range<
+        std::ranges::range_reference_t<Strings const&>>
+    auto operator()(Strings const& strings,
+      Comp const&                  comp,
+      Out                          out,
+      overlap_bounds const&        bounds = {}) const -> Out
+    {
+      auto const count = std::ranges::size(strings);
+
+      auto symbol_hash = [&](auto const& symbol) {
+        return static_cast<std::uint64_t>(std::invoke(m_hash, symbol));
+      };
+
+      auto for_each_prefix = [&](std::size_t j, auto&& fn) {
+        auto fingerprint = std::uint64_t{0};
+        auto length      = std::size_t{0};
+        for (auto const& symbol : strings[j]) {
+          fingerprint = fingerprint * base + symbol_hash(symbol);
+          fn(key_of(fingerprint, ++length));
+        }
+      };
+
+      // Build: one entry per prefix, bucketed by the low bits of the key.
+      auto total = std::size_t{0};
+      for (auto const& s : strings) {
+        total += static_cast<std::size_t>(std::ranges::distance(s));
+      }
+
+      auto const bucket_count = std::bit_ceil(std::max(total, std::size_t{1}));
+      auto const mask         = bucket_count - 1;
+
+      auto offsets = std::vector<std::size_t>(bucket_count + 1, 0);
+      for (auto j = std::size_t{0}; j < count; ++j) {
+        for_each_prefix(
+          j, [&](std::uint64_t key) { ++offsets[(key & mask) + 1]; });
+      }
+      for (auto b = std::size_t{0}; b < bucket_count; ++b) {
+        offsets[b + 1] += offsets[b];
+      }
+
+      auto entries = std::vector<entry>(total);
+      auto cursors = offsets;
+      for (auto j = std::size_t{0}; j < count; ++j) {
+        for_each_prefix(j, [&](std::uint64_t key) {
+          entries[cursors[key & mask]++] = entry{key, j};
+        });
+      }
+
+      // Probe: suffix fingerprints grow from the back of the string, so
+      // they are computed shortest first and looked up longest first.
+      auto found       = std::vector<std::size_t>(count, npos);
+      auto suffix_keys = std::vector<std::uint64_t>{};
+
+      for (auto i = std::size_t{0}; i < count; ++i) {
+        auto const& s      = strings[i];
+        auto const  first  = std::ranges::begin(s);
+        auto const  length = static_cast<std::size_t>(std::ranges::distance(s));
+        auto const  last   = std::ranges::next(first, length);
+
+        auto const longest = std::min(length,
+          static_cast<std::size_t>(
+            std::max(bounds.max_score, std::ptrdiff_t{0})));
+        auto const shortest = static_cast<std::size_t>(
+          std::max(bounds.min_score, std::ptrdiff_t{1}));
+
+        suffix_keys.resize(longest);
+
+        auto fingerprint = std::uint64_t{0};
+        auto power       = std::uint64_t{1};
+        auto cursor      = last;
+        for (auto l = std::size_t{1}; l <= longest; ++l) {
+          fingerprint += symbol_hash(*--cursor) * power;
+          power *= base;
+          suffix_keys[l - 1] = key_of(fingerprint, l);
+        }
+
+        for (auto l = longest; l >= shortest; --l) {
+          auto const key    = suffix_keys[l - 1];
+          auto const bucket = key & mask;
+          auto const suffix =
+            std::ranges::subrange(std::ranges::prev(last, l), last);
+
+          for (auto k = offsets[bucket]; k < offsets[bucket + 1]; ++k) {
+            auto const j = entries[k].string;
+            if (entries[k].key != key || j == i || found[j] == i) {
+              continue;
+            }
+
+            auto const& t = strings[j];
+            if (std::cmp_less(std::ranges::distance(t), l)) {
+              continue;
+            }
+
+            auto const prefix = std::ranges::subrange(std::ranges::begin(t),
+              std::ranges::next(std::ranges::begin(t), l));
+            if (std::ranges::equal(suffix, prefix, comp)) {
+              found[j] = i;
+              *out++   = overlap_edge{i, j, l};
+            }
+          }
+        }
+      }
+
+      return out;
+    }
+  };
+
+  template <typename Hash>
+  karp_rabin_overlap_engine(Hash) -> karp_rabin_overlap_engine<Hash>;
+
+  /**
+   * @brief Limits on the edges an overlap graph keeps.
+   *
+   * An edge survives pruning if its score is at least `min_overlap`
+   * and it is among the `edges_per_string` best out-edges of its
+   * `lhs` or among the `edges_per_string` best in-edges of its `rhs`.
+   * Edges are ranked by score, then by `(lhs, rhs)`, so pruning does
+   * not depend on the order in which an engine produces them.
+   */
+  struct overlap_pruning {
+    std::size_t edges_per_string = std::numeric_limits<std::size_t>::max();
+    std::size_t min_overlap      = 1;
+
+    /**
+     * @brief The approximate number of bytes held per retained edge
+     * between its discovery and the end of the greedy merge.
+     */
+    static constexpr auto const bytes_per_edge = 4 * sizeof(overlap_edge);
+
+    /**
+     * @brief The pruning with the most edges per string whose overlap
+     * graph fits in roughly `bytes` for `string_count` strings.
+     *
+     * Each string retains at most `2 · edges_per_string` edges. At
+     * least one edge per string is always kept.
+     */
+    [[nodiscard]] static constexpr auto within_budget(
+      std::size_t string_count, std::size_t bytes) noexcept -> overlap_pruning
+    {
+      auto const per_string =
+        bytes / (2 * bytes_per_edge * std::max(string_count, std::size_t{1}));
+      return overlap_pruning{std::max(per_string, std::size_t{1})};
+    }
+  };
+
+  namespace detail {
+    // Keeps the best `k` out-edges and in-edges of every string,
+    // in O(n · k) space, however many edges are pushed.
+    class top_k_overlap_edges {
+      std::size_t m_k;
+      std::size_t m_min_overlap;
+
+      std::vector<overlap_edge> m_out;
+      std::vector<std::size_t>  m_out_size;
+      std::vector<overlap_edge> m_in;
+      std::vector<std::size_t>  m_in_size;
+
+      // Heap order puts the worst retained edge at the front.
+      static constexpr auto better = [](overlap_edge const& a,
+                                       overlap_edge const& b) {
+        return a.score != b.score
+          ? a.score > b.score
+          : std::pair{a.lhs, a.rhs} < std::pair{b.lhs, b.rhs};
+      };
+
+      void push_bounded(std::vector<overlap_edge>& heaps,
+        std::vector<std::size_t>&                  sizes,
+        std::size_t                                slot,
+        overlap_edge const&                        edge)
+      {
+        auto const first = std::ranges::next(heaps.begin(), slot * m_k);
+        auto&      size  = sizes[slot];
+
+        if (size < m_k) {
+          first[size++] = edge;
+          std::ranges::push_heap(first, first + size, better);
+        } else if (better(edge, *first)) {
+          std::ranges::pop_heap(first, first + size, better);
+          first[size - 1] = edge;
+          std::ranges::push_heap(first, first + size, better);
+        }
+      }
+
+    public:
+      [[nodiscard]] top_k_overlap_edges(
+        std::size_t string_count, overlap_pruning const& pruning)
+          : m_k{std::min(pruning.edges_per_string, string_count)}
+          , m_min_overlap{std::max(pruning.min_overlap, std::size_t{1})}
+          , m_out(string_count * m_k)
+          , m_out_size(string_count, 0)
+          , m_in(string_count * m_k)
+          , m_in_size(string_count, 0)
+      {}
+
+      void push(overlap_edge const& edge)
+      {
+        if (m_k == 0 || edge.score < m_min_overlap) {
+          return;
+        }
+        push_bounded(m_out, m_out_size, edge.lhs, edge);
+        push_bounded(m_in, m_in_size, edge.rhs, edge);
+      }
+
+      // Writes every retained edge exactly once, in no particular
+      // order.
+      template <std::output_iterator<overlap_edge> Out>
+      auto flush(Out out) const -> Out
+      {
+        auto const out_edges = [&](std::size_t lhs) {
+          auto const first = std::ranges::next(m_out.begin(), lhs * m_k);
+          return std::ranges::subrange(first, first + m_out_size[lhs]);
+        };
+
+        for (auto lhs = std::size_t{0}; lhs < m_out_size.size(); ++lhs) {
+          out = std::ranges::copy(out_edges(lhs), std::move(out)).out;
+        }
+
+        for (auto rhs = std::size_t{0}; rhs < m_in_size.size(); ++rhs) {
+          auto const first = std::ranges::next(m_in.begin(), rhs * m_k);
+          for (auto const& edge :
+            std::ranges::subrange(first, first + m_in_size[rhs])) {
+            auto const kept = out_edges(edge.lhs);
+            if (std::ranges::find(kept, edge) == kept.end()) {
+              *out++ = edge;
+            }
+          }
+        }
+
+        return out;
+      }
+    };
+
+    // Output iterator that forwards every edge to a function.
+    template <typename F>
+    class edge_sink_iterator {
+      F* m_fn = nullptr;
+
+    public:
+      using difference_type = std::ptrdiff_t;
+
+      edge_sink_iterator() = default;
+
+      explicit edge_sink_iterator(F& fn) noexcept
+          : m_fn{std::addressof(fn)}
+      {}
+
+      auto operator*() const noexcept -> edge_sink_iterator const&
+      {
+        return *this;
+      }
+
+      auto operator=(overlap_edge const& edge) const
+        -> edge_sink_iterator const&
+      {
+        std::invoke(*m_fn, edge);
+        return *this;
+      }
+
+      auto operator++() noexcept -> edge_sink_iterator&
+      {
+        return *this;
+      }
+
+      auto operator++(int) noexcept -> edge_sink_iterator
+      {
+        return *this;
+      }
+    };
+
+    // Runs `engine` into `sink`. Engines that accept bounds skip the
+    // overlaps shorter than `min_overlap` themselves.
+    template <typename Engine, typename Strings, typename Comp, typename Sink>
+    void run_overlap_engine(Engine const& engine,
+      Strings const&                      strings,
+      Comp const&                         comp,
+      Sink                                sink,
+      std::size_t                         min_overlap)
+    {
+      if constexpr (std::invocable<Engine const&,
+                      Strings const&,
+                      Comp const&,
+                      Sink,
+                      overlap_bounds const&>) {
+        auto const bounds = overlap_bounds{
+          .min_score = static_cast<std::ptrdiff_t>(std::min<std::size_t>(
+            min_overlap, std::numeric_limits<std::ptrdiff_t>::max()))};
+        std::invoke(engine, strings, comp, std::move(sink), bounds);
+      } else {
+        std::invoke(engine, strings, comp, std::move(sink));
+      }
+    }
+  } // namespace detail
+
+  /**
+   * @brief Overlap engine adaptor that keeps only the edges allowed by
+   * an `overlap_pruning`.
+   *
+   * Edges are pruned as the underlying engine produces them, so the
+   * adaptor needs O(n · k) space for n strings and k edges per string
+   * on top of whatever the underlying engine needs itself. Note that
+   * `parallel_knuth_morris_pratt_overlap_engine` buffers all edges
+   * before writing them, while the sequential engines do not.
+   *
+   * Engines that accept `overlap_bounds` are passed `min_overlap` as
+   * their minimum score, so they can skip the shorter overlaps instead
+   * of computing them only for the adaptor to drop them.
+   *
+   * Pruning can remove the edge the greedy merge would have taken
+   * next. When its graph runs dry with more than one chain left, the
+   * superstring pipeline therefore runs the underlying engine again on
+   * the ends of the remaining chains, prunes the overlaps from the tail
+   * of one chain onto the head of another, and continues merging with
+   * the edges that survive, until no chains overlap. Overlaps that
+   * could not be merged are dropped before pruning, so they never take
+   * the place of those that could.
+   *
+   * @code
+   * auto engine = vault::algorithm::pruned_overlap_engine{
+   *   vault::algorithm::aho_corasick_overlap_engine,
+   *   vault::algorithm::overlap_pruning{.edges_per_string = 8}};
+   * @endcode
+   *
+   * @tparam Engine The underlying overlap engine.
+   */
+  template <typename Engine>
+  class pruned_overlap_engine {
+    Engine          m_engine;
+    overlap_pruning m_pruning;
+
+  public:
+    [[nodiscard]] explicit pruned_overlap_engine(
+      Engine engine, overlap_pruning pruning = {})
+        : m_engine{std::move(engine)}
+        , m_pruning{pruning}
+    {}
+
+    [[nodiscard]] auto engine() const noexcept -> Engine const&
+    {
+      return m_engine;
+    }
+
+    [[nodiscard]] auto pruning() const noexcept -> overlap_pruning const&
+    {
+      return m_pruning;
+    }
+
+    template <std::ranges::random_access_range Strings,
+      typename Comp,
+      std::output_iterator<overlap_edge> Out>
+    auto operator()(Strings const& strings, Comp const& comp, Out out) const
+      -> Out
+    {
+      auto const count = std::ranges::size(strings);
+
+      if (count == 0 || m_pruning.edges_per_string >= count - 1) {
+        // Every edge would be kept; only the threshold applies.
+        auto filter = [&](overlap_edge const& edge) {
+          if (edge.score >= m_pruning.min_overlap) {
+            *out++ = edge;
+          }
+        };
+        detail::run_overlap_engine(m_engine,
+          strings,
+          comp,
+          detail::edge_sink_iterator{filter},
+          m_pruning.min_overlap);
+        return out;
+      }
+
+      auto kept = detail::top_k_overlap_edges{count, m_pruning};
+      auto push = [&](overlap_edge const& edge) { kept.push(edge); };
+      detail::run_overlap_engine(m_engine,
+        strings,
+        comp,
+        detail::edge_sink_iterator{push},
+        m_pruning.min_overlap);
+
+      return kept.flush(std::move(out));
+    }
+  };
+
+  template <typename Engine>
+  pruned_overlap_engine(Engine, overlap_pruning = {})
+    -> pruned_overlap_engine<Engine>;
+
+  /**
+   * @brief Verifies that E is an overlap engine that may omit edges
+   * according to an `overlap_pruning`, such as `pruned_overlap_engine`,
+   * and exposes the engine whose edges it prunes.
+   */
+  template <typename E>
+  concept pruning_overlap_engine = requires(E const& engine) {
+    { engine.pruning() } -> std::convertible_to<overlap_pruning const&>;
+    engine.engine();
+  };
+
+  /// The phases of the greedy superstring pipeline, in the order they run.
+  enum class superstring_phase : std::uint8_t {
+    filter,   ///< Dropping strings contained in or equal to others.
+    graph,    ///< Packing the survivors and building the overlap graph.
+    merge,    ///< Linking chains along the overlap graph.
+    assembly, ///< Writing the chains out into the superstring.
+    mapping,  ///< Locating every input string in the superstring.
+  };
+
+  /**
+   * @brief What the greedy superstring pipeline did, accumulated over
+   * every call made by a
+   * `basic_greedy_shortest_common_superstring_fn<Graph,
+   * superstring_statistics>` that was given it.
+   *
+   * Assign `{}` to start over. A function object without statistics, such
+   * as `greedy_shortest_common_superstring_fn`, has no code to record
+   * them, reads no clock unless metrics are on, and counts no
+   * allocations.
+   *
+   * @code
+   * auto stats = vault::algorithm::superstring_statistics{};
+   * auto scs   = vault::algorithm::
+   *   greedy_shortest_common_superstring_with_statistics_fn{nullptr, stats};
+   * auto result = scs(strings, out);
+   * auto filter = stats.time(vault::algorithm::superstring_phase::filter);
+   * @endcode
    */
-  class greedy_shortest_common_superstring_fn {
-    struct index_entry_t {
-      std::size_t lhs;
-      std::size_t rhs;
-      std::size_t score;
+  struct superstring_statistics {
+    /// Wall time spent in each phase, indexed by `superstring_phase`.
+    std::array<std::chrono::nanoseconds, 5> phase_time{};
+
+    /// The number of input strings.
+    std::size_t strings = 0;
+
+    /// Strings dropped because they occur in, or equal, another string.
+    std::size_t removed_strings = 0;
+
+    /// Edges loaded into overlap graphs, including those found by the
+    /// extra rounds of a pruning engine.
+    std::size_t edges = 0;
+
+    /// The most edges loaded into one overlap graph.
+    std::size_t peak_edges = 0;
+
+    /// Allocations of scratch space from the function object's memory
+    /// resource. The superstring, the overlap graph and the engines
+    /// allocate as usual and are not counted.
+    std::size_t allocations = 0;
+
+    /// The total length of the input strings.
+    std::size_t input_length = 0;
+
+    /// The total length of the superstrings.
+    std::size_t superstring_length = 0;
+
+    [[nodiscard]] auto time(superstring_phase phase) const noexcept
+      -> std::chrono::nanoseconds
+    {
+      return phase_time[static_cast<std::size_t>(phase)];
+    }
+
+    /// Superstring length over input length; 1 without any overlap.
+    [[nodiscard]] auto compression_ratio() const noexcept -> double
+    {
+      return input_length == 0 ? 1.0
+                               : static_cast<double>(superstring_length)
+          / static_cast<double>(input_length);
+    }
+  };
+
+  namespace detail {
+    // Nanoseconds per call spent in each phase, indexed by
+    // `superstring_phase`.
+    inline const std::array<metrics::histogram, 5> superstring_phase_metrics{
+      metrics::histogram{"superstring.filter_ns"},
+      metrics::histogram{"superstring.graph_ns"},
+      metrics::histogram{"superstring.merge_ns"},
+      metrics::histogram{"superstring.assembly_ns"},
+      metrics::histogram{"superstring.mapping_ns"},
     };
 
-    struct tag_lhs {};
+    // Stands in for the statistics of a function object without any.
+    struct no_superstring_statistics {};
+
+    // Where a function object records its statistics: a pointer to them,
+    // or nothing at all.
+    template <bool Recorded>
+    using superstring_statistics_handle = std::conditional_t<Recorded,
+      superstring_statistics*,
+      no_superstring_statistics>;
+
+    // Charges the wall time since the previous lap to a phase, if there
+    // are statistics to charge it to, and records it if metrics are on.
+    // Without either, it reads no clock.
+    template <bool Recorded>
+    class superstring_phase_clock {
+      using clock_t = std::chrono::steady_clock;
+
+      static constexpr auto timed = Recorded || metrics::enabled;
+
+      [[no_unique_address]] superstring_statistics_handle<Recorded>
+                          m_statistics;
+      clock_t::time_point m_last;
+
+    public:
+      [[nodiscard]] explicit superstring_phase_clock(
+        superstring_statistics_handle<Recorded> statistics) noexcept
+          : m_statistics{statistics}
+          , m_last{timed ? clock_t::now() : clock_t::time_point{}}
+      {}
+
+      void lap([[maybe_unused]] superstring_phase phase) noexcept
+      {
+        if constexpr (timed) {
+          auto const now     = clock_t::now();
+          auto const elapsed =
+            std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last);
+          if constexpr (Recorded) {
+            m_statistics->phase_time[static_cast<std::size_t>(phase)] +=
+              elapsed;
+          }
+          superstring_phase_metrics[static_cast<std::size_t>(phase)].record(
+            static_cast<std::uint64_t>(elapsed.count()));
+          m_last = now;
+        }
+      }
+    };
+
+    // Forwards to `upstream`, counting allocations.
+    class counting_memory_resource : public std::pmr::memory_resource {
+      std::pmr::memory_resource* m_upstream;
+      std::size_t*               m_count;
+
+      auto do_allocate(std::size_t bytes, std::size_t alignment)
+        -> void* override
+      {
+        ++*m_count;
+        return m_upstream->allocate(bytes, alignment);
+      }
+
+      void do_deallocate(
+        void* p, std::size_t bytes, std::size_t alignment) override
+      {
+        m_upstream->deallocate(p, bytes, alignment);
+      }
 
-    struct tag_rhs {};
+      [[nodiscard]] auto do_is_equal(
+        std::pmr::memory_resource const& other) const noexcept -> bool override
+      {
+        return this == &other;
+      }
 
-    struct tag_score {};
+    public:
+      [[nodiscard]] counting_memory_resource(
+        std::pmr::memory_resource* upstream, std::size_t* count) noexcept
+          : m_upstream{upstream}
+          , m_count{count}
+      {}
+    };
+  } // namespace detail
 
-    using overlap_graph_t = boost::multi_index_container<index_entry_t,
-      boost::multi_index::indexed_by<
-        boost::multi_index::ordered_non_unique<
-          boost::multi_index::tag<tag_score>,
-          boost::multi_index::
-            member<index_entry_t, std::size_t, &index_entry_t::score>,
-          std::greater<std::size_t>>,
-        boost::multi_index::hashed_non_unique<boost::multi_index::tag<tag_lhs>,
-          boost::multi_index::
-            member<index_entry_t, std::size_t, &index_entry_t::lhs>>,
-        boost::multi_index::hashed_non_unique<boost::multi_index::tag<tag_rhs>,
-          boost::multi_index::
-            member<index_entry_t, std::size_t, &index_entry_t::rhs>>>>;
+  /**
+   * @brief Computes an approximation of the Shortest Common Superstring (SCS)
+   * using a Greedy strategy.
+   *
+   * @tparam Graph The representation of the overlap graph used by the
+   *   greedy merge, e.g. `bucket_queue_overlap_graph` or
+   *   `multi_index_overlap_graph`. Graphs may break ties between equal
+   *   overlaps differently, but never change the greedy criterion.
+   * @tparam Statistics `superstring_statistics` to record what every call
+   *   does, or `void` to compile without any recording.
+   */
+  template <overlap_graph Graph = bucket_queue_overlap_graph,
+    typename Statistics         = void>
+    requires std::is_void_v<Statistics>
+    || std::same_as<Statistics, superstring_statistics>
+  class basic_greedy_shortest_common_superstring_fn {
+    static constexpr auto const npos = static_cast<std::size_t>(-1);
 
     static constexpr auto strlen_fn = []<typename T>(
                                         T const& t) -> std::size_t {
       return std::ranges::distance(t);
     };
 
+    static constexpr auto records_statistics = !std::is_void_v<Statistics>;
+
+    std::pmr::memory_resource* m_resource = nullptr;
+    [[no_unique_address]] detail::superstring_statistics_handle<
+      records_statistics> m_statistics{};
+
+    // Applies update to the statistics, if there are any.
+    template <typename Update>
+    constexpr void record_statistics([[maybe_unused]] Update&& update) const
+    {
+      if constexpr (records_statistics) {
+        std::invoke(update, *m_statistics);
+      }
+    }
+
   public:
+    [[nodiscard]] constexpr basic_greedy_shortest_common_superstring_fn()
+      requires(!records_statistics)
+    = default;
+
+    /**
+     * @param resource The memory resource for the scratch space of the
+     *   pipeline: the working set, the packed survivors and the chain
+     *   bookkeeping. The superstring, the overlap graph and the engines
+     *   allocate as usual.
+     */
+    [[nodiscard]]
+    constexpr explicit basic_greedy_shortest_common_superstring_fn(
+      std::pmr::memory_resource* resource) noexcept
+      requires(!records_statistics)
+        : m_resource{resource}
+    {}
+
+    /**
+     * @param resource As above, or null for the default resource.
+     * @param statistics Receives what every call does. It must outlive
+     *   the function object.
+     */
+    [[nodiscard]] constexpr basic_greedy_shortest_common_superstring_fn(
+      std::pmr::memory_resource* resource,
+      superstring_statistics&    statistics) noexcept
+      requires records_statistics
+        : m_resource{resource}
+        , m_statistics{&statistics}
+    {}
+
+    /// The resource scratch space is allocated from.
+    [[nodiscard]] auto resource() const noexcept -> std::pmr::memory_resource*
+    {
+      return m_resource != nullptr ? m_resource
+                                   : std::pmr::get_default_resource();
+    }
+
+    /// The statistics calls are recorded in.
+    [[nodiscard]] auto statistics() const noexcept -> superstring_statistics&
+      requires records_statistics
+    {
+      return *m_statistics;
+    }
+
     // --- Type Aliases for Convenience ---
 
     /**
@@ -143,20 +1309,49 @@ namespace vault::algorithm {
     // Overload 1: Raw / No Projection
     // =========================================================================
 
-    template <std::ranges::forward_range R,
+    /**
+     * @brief Computes the superstring, building the overlap graph with
+     * `engine`.
+     *
+     * The exact engines, `knuth_morris_pratt_overlap_engine`,
+     * `parallel_knuth_morris_pratt_overlap_engine`,
+     * `aho_corasick_overlap_engine` and `karp_rabin_overlap_engine` (with
+     * a hash that agrees with `comp`), write the whole overlap graph, so
+     * they only affect how it is computed and all give the same result.
+     * A `pruned_overlap_engine` is a heuristic: it keeps only some of
+     * the edges, and with a `min_overlap` above 1 none shorter than it,
+     * so the merge can take other edges than greedy over the whole graph
+     * would, and the superstring can be longer.
+     *
+     * @param engine An overlap engine, e.g.
+     *   `knuth_morris_pratt_overlap_engine` or
+     *   `aho_corasick_overlap_engine`.
+     * @param strings The input strings.
+     * @param out Receives one subrange of the superstring per input
+     *   string, in input order.
+     * @param comp Equivalence relation on the string elements.
+     */
+    template <typename Engine,
+      std::ranges::forward_range R,
       typename Out,
       typename Comp = std::equal_to<>>
       requires inner_element_comparator<Comp, R>
-      && vector_subrange_output_iterator<Out,
+      && superstring_bounds_output<Out,
         std::iter_value_t<detail::inner_iterator_t<R>>>
+      && overlap_engine<Engine,
+        detail::superstring_pieces_t<R, std::identity>,
+        Comp>
     [[nodiscard]]
-    auto operator()(R&& strings, Out out, Comp comp = {}) const
-      -> result<std::ranges::iterator_t<R>,
+    auto operator()(Engine const& engine, R&& strings, Out out, Comp comp = {})
+      const -> result<std::ranges::iterator_t<R>,
         Out,
         detail::superstring_container_t<R, std::identity>>
     {
       using InputString  = std::ranges::range_reference_t<R>;
       using SuperStringT = detail::superstring_container_t<R, std::identity>;
+      using PoolT        = detail::superstring_pool_t<R, std::identity>;
+      using PiecesT      = detail::superstring_pieces_t<R, std::identity>;
+      using IndicesT     = std::pmr::vector<std::size_t>;
 
       if (std::ranges::empty(strings)) {
         return result<std::ranges::iterator_t<R>, Out, SuperStringT>{
@@ -169,156 +1364,362 @@ namespace vault::algorithm {
           std::ranges::ref_view<std::remove_reference_t<InputString>>,
           std::remove_cvref_t<InputString>>;
 
-      auto working_set = strings | ::ranges::to<std::vector<ReductionString>>();
+      auto clock =
+        detail::superstring_phase_clock<records_statistics>{m_statistics};
+
+      // Scratch allocations are counted by routing them through a
+      // counting resource, which only a function object with statistics
+      // has.
+      [[maybe_unused]] auto counting = std::invoke([&] {
+        if constexpr (records_statistics) {
+          return detail::counting_memory_resource{
+            this->resource(), &m_statistics->allocations};
+        } else {
+          return detail::no_superstring_statistics{};
+        }
+      });
 
-      auto ftables = working_set | ::ranges::views::transform([&](auto&& s) {
-        return knuth_morris_pratt_failure_function(s, comp);
-      }) | ::ranges::to<std::vector>();
+      auto* const resource =
+        std::invoke([&]() -> std::pmr::memory_resource* {
+          if constexpr (records_statistics) {
+            return &counting;
+          } else {
+            return this->resource();
+          }
+        });
 
-      auto string_ptrs =
-        ::ranges::to<std::vector>(::ranges::views::addressof(working_set));
-      auto ftable_ptrs =
-        ::ranges::to<std::vector>(::ranges::views::addressof(ftables));
+      auto working_set = std::pmr::vector<ReductionString>(resource);
+      if constexpr (std::ranges::sized_range<R>) {
+        working_set.reserve(std::ranges::size(strings));
+      }
+      for (auto&& s : strings) {
+        working_set.emplace_back(std::forward<decltype(s)>(s));
+      }
 
       auto total_overlap = std::size_t{0};
 
       // Filtering Substrings
-      std::invoke([&] {
-        std::ranges::sort(::ranges::views::zip(string_ptrs, ftable_ptrs),
-          {},
-          [](auto const& pair) { return strlen_fn(*pair.first); });
-
-        auto out_strings = string_ptrs.begin();
-        auto out_ftables = ftable_ptrs.begin();
-        auto in_strings  = string_ptrs.begin();
-        auto in_ftables  = ftable_ptrs.begin();
-
-        while (in_strings != string_ptrs.end()) {
-          auto searcher =
-            knuth_morris_pratt_searcher{**in_strings, **in_ftables, comp};
-
-          auto is_superstring = [&](auto* haystrand_ptr) {
-            return std::search(std::ranges::begin(*haystrand_ptr),
-                     std::ranges::end(*haystrand_ptr),
-                     searcher)
-              != std::ranges::end(*haystrand_ptr);
-          };
+      //
+      // A string is dropped if it occurs inside a longer string, or if
+      // an equal string comes after it in length order. Both are found
+      // with a single Aho-Corasick automaton over the working set:
+      // equal strings (under `comp`) end at the same trie node, and the
+      // strings occurring inside a string `t` are the patterns on the
+      // failure chains of the nodes along the trie path of `t`.
+      //
+      // Every dropped string records where it lies in the string that
+      // made it redundant (its anchor), so that its position in the
+      // superstring can be derived from that of the anchor later on.
+      auto const working_count = working_set.size();
+
+      auto anchor        = IndicesT(working_count, npos, resource);
+      auto anchor_offset = IndicesT(working_count, 0, resource);
+
+      auto order = IndicesT(working_count, resource);
+      std::iota(order.begin(), order.end(), std::size_t{0});
+
+      auto survivors = std::invoke([&] {
+        using symbol_t    = std::iter_value_t<detail::inner_iterator_t<R>>;
+        using automaton_t = aho_corasick_automaton<symbol_t, Comp>;
+        using node_t      = typename automaton_t::node_type;
+
+        auto const automaton = automaton_t{working_set, comp};
+
+        // container[v] is set for every pattern node v that occurs as a
+        // proper substring of some string, and names that string along
+        // with the offset of the occurrence. Whenever a node is set, its
+        // whole dictionary suffix chain is set as well, so marking can
+        // stop at the first node that is already set.
+        auto const node_count = automaton.size();
+        auto container        = IndicesT(node_count, npos, resource);
+        auto container_offset = IndicesT(node_count, 0, resource);
+
+        auto mark_chain = [&](node_t v, std::size_t t, std::size_t end) {
+          for (; v != automaton_t::npos && container[v] == npos;
+            v = automaton.dictionary_suffix(v)) {
+            container[v]        = t;
+            container_offset[v] = end - automaton.depth(v);
+          }
+        };
 
-          if (std::ranges::none_of(std::ranges::next(in_strings),
-                string_ptrs.end(),
-                is_superstring)) {
-            *out_strings++ = *in_strings;
-            *out_ftables++ = *in_ftables;
-          } else {
-            total_overlap += strlen_fn(**in_strings);
+        for (auto t = std::size_t{0}; t < working_count; ++t) {
+          auto const length = strlen_fn(working_set[t]);
+          auto       node   = automaton.root();
+          auto       depth  = std::size_t{0};
+
+          for (auto const& symbol : working_set[t]) {
+            node = automaton.child(node, symbol);
+            assert(node != automaton_t::npos && "Pattern not in its own trie.");
+
+            auto const is_proper = ++depth < length;
+
+            if (is_proper && automaton.terminal(node) != automaton_t::npos) {
+              mark_chain(node, t, depth);
+            } else {
+              mark_chain(automaton.dictionary_suffix(node), t, depth);
+            }
           }
-          ++in_strings;
-          ++in_ftables;
         }
 
-        string_ptrs.erase(out_strings, string_ptrs.end());
-        ftable_ptrs.erase(out_ftables, ftable_ptrs.end());
-      });
+        // The order is the same as that of the pairwise search this
+        // replaces, so that ties in the greedy merge resolve the same
+        // way.
+        std::ranges::sort(
+          order, {}, [&](std::size_t i) { return strlen_fn(working_set[i]); });
 
-      // Materialize Survivors
-      auto reduced_strings = string_ptrs | ::ranges::views::indirect
-        | ::ranges::views::transform(
-          [](auto&& r) { return r | ::ranges::to<SuperStringT>(); })
-        | ::ranges::to<std::vector>();
+        auto last_rank = IndicesT(automaton.size(), resource);
+        for (auto rank = std::size_t{0}; rank < working_count; ++rank) {
+          last_rank[automaton.pattern_node(order[rank])] = rank;
+        }
 
-      auto is_active_string = std::vector<bool>(reduced_strings.size(), true);
-      auto index            = overlap_graph_t{};
+        auto result = IndicesT(resource);
+        for (auto rank = std::size_t{0}; rank < working_count; ++rank) {
+          auto const i    = order[rank];
+          auto const node = automaton.pattern_node(i);
 
-      // Build Graph
-      for (auto i = std::size_t{0}; i < reduced_strings.size(); ++i) {
-        for (auto j = std::size_t{0}; j < reduced_strings.size(); ++j) {
-          if (i == j) {
+          if (container[node] != npos) {
+            anchor[i]        = container[node];
+            anchor_offset[i] = container_offset[node];
+          } else if (last_rank[node] != rank) {
+            anchor[i] = order[last_rank[node]];
+          } else {
+            result.push_back(i);
             continue;
           }
-          auto score = knuth_morris_pratt_overlap(
-            reduced_strings[i], reduced_strings[j], *ftable_ptrs[j], comp)
-                         .score;
-          if (score > 0) {
-            index.emplace(i, j, static_cast<std::size_t>(score));
-          }
+
+          total_overlap += strlen_fn(working_set[i]);
+        }
+        return result;
+      });
+
+      record_statistics([&](superstring_statistics& statistics) {
+        statistics.strings += working_count;
+        statistics.removed_strings += working_count - survivors.size();
+        for (auto const& s : working_set) {
+          statistics.input_length += strlen_fn(s);
         }
+      });
+      clock.lap(superstring_phase::filter);
+
+      // Materialize Survivors
+      //
+      // The survivors are copied back to back into a single buffer of
+      // exactly the right size, and are seen by the engine and the
+      // merge as subranges of it.
+      auto pool = PoolT(resource);
+
+      auto pool_size = std::size_t{0};
+      for (auto const i : survivors) {
+        pool_size += strlen_fn(working_set[i]);
       }
+      pool.reserve(pool_size);
 
-      // Greedy Merge
-      while (!index.empty()) {
-        auto const entry = *index.get<tag_score>().begin();
-        index.get<tag_score>().erase(index.get<tag_score>().begin());
+      for (auto const i : survivors) {
+        std::ranges::copy(working_set[i], std::back_inserter(pool));
+      }
+
+      auto const string_count    = survivors.size();
+      auto       reduced_strings = PiecesT(resource);
+      reduced_strings.reserve(string_count);
+
+      for (auto first = pool.begin(); auto const i : survivors) {
+        auto const last = std::ranges::next(first, strlen_fn(working_set[i]));
+        reduced_strings.emplace_back(first, last);
+        first = last;
+      }
 
-        auto const lhs     = entry.lhs;
-        auto const rhs     = entry.rhs;
-        auto const overlap = entry.score;
+      // Build Graph
+      //
+      // Edges are loaded in (lhs, rhs) order whatever order the engine
+      // produced them in. Ties between equal scores are broken by
+      // insertion order, so this keeps the merge deterministic and
+      // independent of the engine.
+      auto record_edges = [&](std::size_t count) {
+        record_statistics([&](superstring_statistics& statistics) {
+          statistics.edges += count;
+          statistics.peak_edges = std::max(statistics.peak_edges, count);
+        });
+      };
+
+      auto graph = std::invoke([&] {
+        auto edges = std::vector<overlap_edge>{};
+        std::invoke(engine, reduced_strings, comp, std::back_inserter(edges));
+        record_edges(edges.size());
+
+        std::ranges::sort(edges, {}, [](overlap_edge const& e) {
+          return std::pair{e.lhs, e.rhs};
+        });
+
+        return Graph{string_count, std::move(edges)};
+      });
 
-        auto& lhs_str = reduced_strings[lhs];
-        auto& rhs_str = reduced_strings[rhs];
+      clock.lap(superstring_phase::graph);
 
-        auto suffix_begin =
-          std::ranges::next(std::ranges::begin(rhs_str), overlap);
-        auto suffix_end = std::ranges::end(rhs_str);
+      // Greedy Merge
+      //
+      // Merging only links chains together. The string at the tail of
+      // the `lhs` chain is followed by the head of the `rhs` chain,
+      // overlapping it by `overlap` symbols; nothing is copied until
+      // the final assembly.
+      auto is_active_string  = std::pmr::vector<bool>(
+        string_count, true, resource);
+      auto successor         = IndicesT(string_count, npos, resource);
+      auto successor_overlap = IndicesT(string_count, 0, resource);
+      auto chain_tail        = IndicesT(string_count, resource);
+      std::iota(chain_tail.begin(), chain_tail.end(), std::size_t{0});
+
+      while (true) {
+        while (auto const entry = graph.pop()) {
+          auto const lhs     = entry->lhs;
+          auto const rhs     = entry->rhs;
+          auto const overlap = entry->score;
+
+          auto const tail         = chain_tail[lhs];
+          successor[tail]         = rhs;
+          successor_overlap[tail] = overlap;
+          chain_tail[lhs]         = chain_tail[rhs];
+
+          total_overlap += overlap;
+          is_active_string[rhs] = false;
+
+          graph.merge(lhs, rhs);
+        }
 
-        lhs_str.insert(lhs_str.end(),
-          std::make_move_iterator(suffix_begin),
-          std::make_move_iterator(suffix_end));
+        if constexpr (!pruning_overlap_engine<Engine>) {
+          break;
+        } else {
+          // A pruned graph can run dry while chains still overlap.
+          // Look for overlaps between the remaining chains, from the
+          // tail of one chain to the head of another, and carry on.
+          // Only those can be merged, so the others are dropped before
+          // pruning rather than left to crowd them out of the top k.
+          // Each round merges at least one pair or ends the loop.
+          auto ends       = PiecesT(resource);
+          auto end_string = IndicesT(resource);
+          auto end_chain  = IndicesT(resource);
+          auto is_head    = std::pmr::vector<bool>(resource);
+          auto is_tail    = std::pmr::vector<bool>(resource);
+
+          auto add_end = [&](std::size_t i, std::size_t head, bool tail) {
+            ends.push_back(reduced_strings[i]);
+            end_string.push_back(i);
+            end_chain.push_back(head);
+            is_head.push_back(i == head);
+            is_tail.push_back(tail);
+          };
 
-        total_overlap += overlap;
-        is_active_string[rhs] = false;
+          for (auto head = std::size_t{0}; head < string_count; ++head) {
+            if (is_active_string[head]) {
+              add_end(head, head, chain_tail[head] == head);
+              if (chain_tail[head] != head) {
+                add_end(chain_tail[head], head, true);
+              }
+            }
+          }
 
-        index.get<tag_lhs>().erase(lhs);
-        index.get<tag_rhs>().erase(rhs);
+          if (std::ranges::count(is_head, true) < 2) {
+            break;
+          }
 
-        auto& lhs_index = index.get<tag_lhs>();
-        auto  range     = lhs_index.equal_range(rhs);
+          auto kept =
+            detail::top_k_overlap_edges{ends.size(), engine.pruning()};
+          auto push = [&](overlap_edge const& e) {
+            if (is_tail[e.lhs] && is_head[e.rhs]
+              && end_chain[e.lhs] != end_chain[e.rhs]) {
+              kept.push(e);
+            }
+          };
+          detail::run_overlap_engine(engine.engine(),
+            ends,
+            comp,
+            detail::edge_sink_iterator{push},
+            engine.pruning().min_overlap);
+
+          auto found = std::vector<overlap_edge>{};
+          kept.flush(std::back_inserter(found));
+
+          auto edges = std::vector<overlap_edge>{};
+          edges.reserve(found.size());
+          for (auto const& e : found) {
+            edges.push_back(
+              overlap_edge{end_chain[e.lhs], end_string[e.rhs], e.score});
+          }
 
-        auto it = range.first;
-        while (it != range.second) {
-          auto current = it++;
-          if (current->rhs != lhs) {
-            index.emplace(lhs, current->rhs, current->score);
+          if (edges.empty()) {
+            break;
           }
-          lhs_index.erase(current);
+          record_edges(edges.size());
+
+          std::ranges::sort(edges, {}, [](overlap_edge const& e) {
+            return std::pair{e.lhs, e.rhs};
+          });
+
+          graph = Graph{string_count, std::move(edges)};
         }
       }
 
+      clock.lap(superstring_phase::merge);
+
       // Final Assembly
+      //
+      // Every chain is written head to tail, skipping the symbols each
+      // string shares with its predecessor, into a single allocation of
+      // exactly the right size. The position at which each survivor
+      // starts is recorded on the way.
       auto final_superstring = SuperStringT{};
+      auto position          = IndicesT(working_count, 0, resource);
 
-      auto estimated_size = std::size_t{0};
-      for (auto i = std::size_t{0}; i < reduced_strings.size(); ++i) {
-        if (is_active_string[i]) {
-          estimated_size += reduced_strings[i].size();
-        }
+      auto superstring_size = std::size_t{0};
+      for (auto i = std::size_t{0}; i < string_count; ++i) {
+        superstring_size += reduced_strings[i].size() - successor_overlap[i];
       }
-      final_superstring.reserve(estimated_size);
+      final_superstring.reserve(superstring_size);
+
+      for (auto head = std::size_t{0}; head < string_count; ++head) {
+        if (!is_active_string[head]) {
+          continue;
+        }
+
+        auto skip = std::size_t{0};
+        for (auto i = head; i != npos; i = successor[i]) {
+          auto const& str = reduced_strings[i];
+
+          position[survivors[i]] = final_superstring.size() - skip;
 
-      for (auto i = std::size_t{0}; i < reduced_strings.size(); ++i) {
-        if (is_active_string[i]) {
           final_superstring.insert(final_superstring.end(),
-            std::make_move_iterator(reduced_strings[i].begin()),
-            std::make_move_iterator(reduced_strings[i].end()));
+            std::make_move_iterator(std::ranges::next(str.begin(), skip)),
+            std::make_move_iterator(str.end()));
+          skip = successor_overlap[i];
         }
       }
 
-      // Position Mapping using Subranges
-      auto super_begin = std::ranges::begin(final_superstring);
-      auto super_end   = std::ranges::end(final_superstring);
+      assert(final_superstring.size() == superstring_size);
 
-      for (auto&& substring : strings) {
-        auto searcher = knuth_morris_pratt_searcher{substring, comp};
-        auto match    = std::search(super_begin, super_end, searcher);
-
-        if (match == super_end) {
-          *out++ = std::ranges::subrange(super_end, super_end);
-        } else {
-          auto length = std::ranges::distance(substring);
-          *out++ =
-            std::ranges::subrange(match, std::ranges::next(match, length));
+      record_statistics([&](superstring_statistics& statistics) {
+        statistics.superstring_length += superstring_size;
+      });
+      clock.lap(superstring_phase::assembly);
+
+      // Position Mapping
+      //
+      // Anchors are strictly longer than the strings they anchor, or
+      // are survivors, so resolving in decreasing length order sees
+      // every anchor before the strings that refer to it.
+      for (auto const i : order | std::views::reverse) {
+        if (anchor[i] != npos) {
+          position[i] = position[anchor[i]] + anchor_offset[i];
         }
       }
 
+      auto const super_begin = std::ranges::begin(final_superstring);
+
+      for (auto i = std::size_t{0}; i < working_count; ++i) {
+        detail::write_superstring_bounds(
+          out, super_begin, position[i], strlen_fn(working_set[i]));
+      }
+
+      clock.lap(superstring_phase::mapping);
+
       return result<std::ranges::iterator_t<R>, Out, SuperStringT>{
         std::ranges::end(strings),
         out,
@@ -326,20 +1727,47 @@ namespace vault::algorithm {
         total_overlap};
     }
 
+    /**
+     * @brief Computes the superstring with the default overlap engine.
+     */
+    template <std::ranges::forward_range R,
+      typename Out,
+      typename Comp = std::equal_to<>>
+      requires inner_element_comparator<Comp, R>
+      && superstring_bounds_output<Out,
+        std::iter_value_t<detail::inner_iterator_t<R>>>
+    [[nodiscard]]
+    auto operator()(R&& strings, Out out, Comp comp = {}) const
+      -> result<std::ranges::iterator_t<R>,
+        Out,
+        detail::superstring_container_t<R, std::identity>>
+    {
+      return operator()(knuth_morris_pratt_overlap_engine,
+        std::forward<R>(strings),
+        std::move(out),
+        std::move(comp));
+    }
+
     // =========================================================================
     // Overload 2: With Projection
     // =========================================================================
 
-    template <std::ranges::forward_range R,
+    template <typename Engine,
+      std::ranges::forward_range R,
       typename Out,
       typename Proj,
       typename Comp = std::equal_to<>>
       requires inner_element_projector<Proj, R>
       && projected_inner_element_comparator<Comp, Proj, R>
-      && vector_subrange_output_iterator<Out,
+      && superstring_bounds_output<Out,
         detail::inner_projected_value_t<Proj, R>>
+      && overlap_engine<Engine, detail::superstring_pieces_t<R, Proj>, Comp>
     [[nodiscard]]
-    auto operator()(R&& strings, Out out, Proj proj, Comp comp = {}) const
+    auto operator()(Engine const& engine,
+      R&&                         strings,
+      Out                         out,
+      Proj                        proj,
+      Comp                        comp = {}) const
       -> result<std::ranges::iterator_t<R>,
         Out,
         detail::superstring_container_t<R, Proj>>
@@ -356,7 +1784,7 @@ namespace vault::algorithm {
         cached_strings.push_back(std::move(projected_s));
       }
 
-      auto res = operator()(cached_strings, out, comp);
+      auto res = operator()(engine, cached_strings, out, comp);
 
       return result<std::ranges::iterator_t<R>,
         Out,
@@ -365,8 +1793,37 @@ namespace vault::algorithm {
         std::move(res.superstring),
         res.total_overlap};
     }
+
+    template <std::ranges::forward_range R,
+      typename Out,
+      typename Proj,
+      typename Comp = std::equal_to<>>
+      requires inner_element_projector<Proj, R>
+      && projected_inner_element_comparator<Comp, Proj, R>
+      && superstring_bounds_output<Out,
+        detail::inner_projected_value_t<Proj, R>>
+    [[nodiscard]]
+    auto operator()(R&& strings, Out out, Proj proj, Comp comp = {}) const
+      -> result<std::ranges::iterator_t<R>,
+        Out,
+        detail::superstring_container_t<R, Proj>>
+    {
+      return operator()(knuth_morris_pratt_overlap_engine,
+        std::forward<R>(strings),
+        std::move(out),
+        std::move(proj),
+        std::move(comp));
+    }
   };
 
+  using greedy_shortest_common_superstring_fn =
+    basic_greedy_shortest_common_superstring_fn<>;
+
+  /// Records what every call does into a `superstring_statistics`.
+  using greedy_shortest_common_superstring_with_statistics_fn =
+    basic_greedy_shortest_common_superstring_fn<bucket_queue_overlap_graph,
+      superstring_statistics>;
+
   constexpr inline auto greedy_shortest_common_superstring =
     greedy_shortest_common_superstring_fn{};
   constexpr inline auto shortest_common_superstring =
@@ -0,0 +1,459 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_ALGORITHM_SUPERSTRING_BUILDER_HPP
+#define VAULT_ALGORITHM_SUPERSTRING_BUILDER_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <range/v3/range/conversion.hpp>
+
+#include <vault/algorithm/aho_corasick_automaton.hpp>
+#include <vault/algorithm/knuth_morris_pratt_failure_function.hpp>
+#include <vault/algorithm/knuth_morris_pratt_overlap.hpp>
+#include <vault/algorithm/overlap_graph.hpp>
+
+namespace vault::algorithm {
+
+  /**
+   * @brief Builds a common superstring incrementally, one batch of
+   * strings at a time.
+   *
+   * The builder keeps everything the greedy algorithm has learned so
+   * far: the strings, their KMP failure tables, which strings are
+   * contained in others, and the chains formed by the greedy merge.
+   * Adding a batch only computes what the new strings contribute:
+   *
+   * 1. The new strings are checked for containment in the strings
+   *    kept so far and in each other, with one Aho-Corasick automaton
+   *    over the batch. Contained strings are anchored to their
+   *    container and take no further part.
+   * 2. Overlaps are computed between the new strings and the ends of
+   *    the existing chains, and among the new strings. Overlaps
+   *    between existing chains are known to be zero, since the
+   *    previous merge ran until no chains overlapped.
+   * 3. The greedy merge runs on those edges alone.
+   *
+   * Strings that are already placed are never moved. In particular, an
+   * existing string that turns out to be contained in a new one keeps
+   * its place, so the result can be somewhat longer than that of
+   * `greedy_shortest_common_superstring` over all strings at once. The
+   * superstring is materialized on demand and is always a valid common
+   * superstring of every string added so far.
+   *
+   * @code
+   * auto builder = vault::algorithm::superstring_builder<char>{};
+   * builder.add(initial_strings);
+   * builder.add(more_strings);
+   * auto [superstring, offsets] = builder.materialize();
+   * @endcode
+   *
+   * @tparam T The element type of the strings.
+   * @tparam Comp Equivalence relation on elements (default:
+   *   std::equal_to<>).
+   *
+   * @par Complexity
+   * @parblock
+   * Adding m strings to a builder holding n strings in c chains costs
+   * O(N + m · (m + c) · L) time, where N is the total length of the
+   * strings kept and L the mean string length, against O((n + m)² · L)
+   * for rebuilding from scratch with the KMP engine. The containment
+   * check reads all N symbols kept once per batch, however small the
+   * batch, so adding strings in few large batches is cheaper than in
+   * many small ones.
+   * @endparblock
+   */
+  template <std::copyable T, typename Comp = std::equal_to<>>
+    requires std::predicate<Comp const&, T const&, T const&>
+  class superstring_builder {
+  public:
+    using value_type  = T;
+    using string_type = std::vector<T>;
+
+    struct result {
+      string_type              superstring;
+      std::vector<std::size_t> offsets;
+    };
+
+  private:
+    static constexpr auto const npos = static_cast<std::size_t>(-1);
+
+    std::vector<string_type> m_strings;
+
+    // The failure tables of each batch, packed as in the one-shot
+    // algorithm. Batch `b` starts at string `m_batch_first[b]`.
+    std::vector<compact_knuth_morris_pratt_failure_tables> m_ftables;
+    std::vector<std::size_t>                               m_batch_first;
+
+    // Strings contained in another string point at it; survivors have
+    // no anchor. Anchors are always survivors.
+    std::vector<std::size_t> m_anchor;
+    std::vector<std::size_t> m_anchor_offset;
+
+    // Chains over the survivors, as in the one-shot algorithm. The tail
+    // of a chain is only kept up to date at its head.
+    std::vector<std::size_t> m_successor;
+    std::vector<std::size_t> m_successor_overlap;
+    std::vector<std::size_t> m_chain_tail;
+
+    std::vector<std::size_t> m_survivors;
+    std::vector<std::size_t> m_heads;
+
+    std::size_t m_total_overlap = 0;
+
+    [[no_unique_address]] Comp m_comp;
+
+    // The failure table of a string added by an earlier batch.
+    [[nodiscard]] auto ftable(std::size_t i) const
+      -> compact_knuth_morris_pratt_failure_table
+    {
+      auto const batch = static_cast<std::size_t>(
+        std::ranges::upper_bound(m_batch_first, i) - m_batch_first.begin() - 1);
+      return m_ftables[batch][i - m_batch_first[batch]];
+    }
+
+  public:
+    [[nodiscard]] explicit superstring_builder(Comp comp = {})
+        : m_comp{std::move(comp)}
+    {}
+
+    /// The number of strings added so far.
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+      return m_strings.size();
+    }
+
+    /// The `i`-th string added.
+    [[nodiscard]] auto operator[](std::size_t i) const noexcept
+      -> string_type const&
+    {
+      return m_strings[i];
+    }
+
+    /// The number of symbols saved against plain concatenation.
+    [[nodiscard]] auto total_overlap() const noexcept -> std::size_t
+    {
+      return m_total_overlap;
+    }
+
+    /// The number of chains, i.e. of independent pieces of the result.
+    [[nodiscard]] auto chain_count() const noexcept -> std::size_t
+    {
+      return m_heads.size();
+    }
+
+    /**
+     * @brief Adds a batch of strings and merges them into the chains.
+     *
+     * The batch is worked out aside and committed only once nothing
+     * can throw any more, so if an exception is thrown the builder is
+     * left unchanged.
+     *
+     * @param strings A range of ranges of `T`.
+     */
+    template <std::ranges::input_range Strings>
+      requires std::ranges::input_range<std::ranges::range_reference_t<Strings>>
+      && std::convertible_to<
+        std::ranges::range_reference_t<std::ranges::range_reference_t<Strings>>,
+        T>
+    void add(Strings&& strings)
+    {
+      auto added = std::vector<string_type>{};
+      for (auto&& s : strings) {
+        added.push_back(s | ::ranges::to<string_type>());
+      }
+
+      auto const first = m_strings.size();
+      auto const size  = added.size();
+      auto const count = first + size;
+
+      if (size == 0) {
+        return;
+      }
+
+      auto ftables = compact_knuth_morris_pratt_failure_tables{added, m_comp};
+
+      auto string_at = [&](std::size_t i) -> string_type const& {
+        return i < first ? m_strings[i] : added[i - first];
+      };
+      auto ftable_at = [&](std::size_t i) {
+        return i < first ? ftable(i) : ftables[i - first];
+      };
+
+      // Containment
+      //
+      // A single Aho-Corasick automaton over the batch finds the new
+      // strings that occur in the survivors kept so far, in one pass
+      // over those, and then the ones that occur in a longer new
+      // string, as in the one-shot algorithm. Equal new strings end at
+      // the same trie node, and the first of them is kept.
+      using automaton_t = aho_corasick_automaton<T, Comp>;
+      using node_t      = typename automaton_t::node_type;
+
+      auto const automaton = automaton_t{added, m_comp};
+
+      auto container        = std::vector<std::size_t>(automaton.size(), npos);
+      auto container_offset = std::vector<std::size_t>(automaton.size(), 0);
+
+      auto mark_chain = [&](node_t v, std::size_t c, std::size_t end) {
+        for (; v != automaton_t::npos && container[v] == npos;
+          v = automaton.dictionary_suffix(v)) {
+          container[v]        = c;
+          container_offset[v] = end - automaton.depth(v);
+        }
+      };
+
+      for (auto const c : m_survivors) {
+        auto node = automaton.root();
+        auto end  = std::size_t{0};
+
+        for (auto const& symbol : m_strings[c]) {
+          node = automaton.transition(node, symbol);
+          ++end;
+
+          mark_chain(automaton.terminal(node) != automaton_t::npos
+              ? node
+              : automaton.dictionary_suffix(node),
+            c,
+            end);
+        }
+      }
+
+      for (auto t = std::size_t{0}; t < size; ++t) {
+        auto node  = automaton.root();
+        auto depth = std::size_t{0};
+
+        for (auto const& symbol : added[t]) {
+          node = automaton.child(node, symbol);
+          assert(node != automaton_t::npos && "Pattern not in its own trie.");
+
+          auto const is_proper = ++depth < added[t].size();
+
+          if (is_proper && automaton.terminal(node) != automaton_t::npos) {
+            mark_chain(node, first + t, depth);
+          } else {
+            mark_chain(automaton.dictionary_suffix(node), first + t, depth);
+          }
+        }
+      }
+
+      // Longest first, so that the container of a string, being longer,
+      // is settled before the string itself and can be replaced by its
+      // own anchor if it turns out to be contained as well.
+      auto order = ::ranges::to<std::vector>(std::views::iota(first, count));
+      std::ranges::stable_sort(order, std::greater<>{}, [&](std::size_t i) {
+        return added[i - first].size();
+      });
+
+      auto anchor        = std::vector<std::size_t>(size, npos);
+      auto anchor_offset = std::vector<std::size_t>(size, 0);
+      auto kept          = std::vector<std::size_t>(automaton.size(), npos);
+      auto fresh         = std::vector<std::size_t>{};
+      auto overlap_total = std::size_t{0};
+
+      for (auto const i : order) {
+        auto const node = automaton.pattern_node(i - first);
+
+        auto c      = container[node];
+        auto offset = container_offset[node];
+
+        if (c == npos) {
+          c      = kept[node];
+          offset = 0;
+        }
+        if (c == npos && added[i - first].empty() && !m_survivors.empty()) {
+          c = m_survivors.front();
+        }
+        if (c == npos) {
+          kept[node] = i;
+          fresh.push_back(i);
+          continue;
+        }
+
+        if (c >= first && anchor[c - first] != npos) {
+          offset += anchor_offset[c - first];
+          c = anchor[c - first];
+        }
+
+        anchor[i - first]        = c;
+        anchor_offset[i - first] = offset;
+        overlap_total += added[i - first].size();
+      }
+
+      std::ranges::sort(fresh);
+
+      // Greedy Merge
+      //
+      // Every existing chain and every new survivor is a node of the
+      // overlap graph, in string order. Existing chains are entered at
+      // their head and left at their tail. Edges run into, out of and
+      // among the new strings; those between existing chains are known
+      // to be zero, since the previous merge ran until no chains
+      // overlapped.
+      auto const chains = m_heads.size();
+      auto const nodes  = chains + fresh.size();
+
+      auto head_of = [&](std::size_t v) {
+        return v < chains ? m_heads[v] : fresh[v - chains];
+      };
+      auto tail_of = [&](std::size_t v) {
+        return v < chains ? m_chain_tail[m_heads[v]] : fresh[v - chains];
+      };
+
+      auto edges    = std::vector<overlap_edge>{};
+      auto add_edge = [&](std::size_t lhs, std::size_t rhs) {
+        auto const tail  = tail_of(lhs);
+        auto const head  = head_of(rhs);
+        auto const score = static_cast<std::size_t>(
+          knuth_morris_pratt_overlap(
+            string_at(tail), string_at(head), ftable_at(head), m_comp)
+            .score);
+
+        if (score > 0) {
+          edges.push_back(overlap_edge{lhs, rhs, score});
+        }
+      };
+
+      for (auto h = std::size_t{0}; h < chains; ++h) {
+        for (auto j = chains; j < nodes; ++j) {
+          add_edge(h, j);
+          add_edge(j, h);
+        }
+      }
+
+      for (auto i = chains; i < nodes; ++i) {
+        for (auto j = chains; j < nodes; ++j) {
+          if (i != j) {
+            add_edge(i, j);
+          }
+        }
+      }
+
+      std::ranges::sort(edges, {}, [](overlap_edge const& e) {
+        return std::pair{e.lhs, e.rhs};
+      });
+
+      auto graph     = bucket_queue_overlap_graph{nodes, std::move(edges)};
+      auto is_head   = std::vector<bool>(nodes, true);
+      auto successor = std::vector<std::size_t>(nodes, npos);
+      auto successor_overlap = std::vector<std::size_t>(nodes, 0);
+      auto chain_tail        = std::vector<std::size_t>(nodes);
+      std::iota(chain_tail.begin(), chain_tail.end(), std::size_t{0});
+
+      while (auto const entry = graph.pop()) {
+        auto const [lhs, rhs, score] = *entry;
+
+        auto const tail         = chain_tail[lhs];
+        successor[tail]         = rhs;
+        successor_overlap[tail] = score;
+        chain_tail[lhs]         = chain_tail[rhs];
+
+        overlap_total += score;
+        is_head[rhs] = false;
+
+        graph.merge(lhs, rhs);
+      }
+
+      auto heads = std::vector<std::size_t>{};
+      for (auto v = std::size_t{0}; v < nodes; ++v) {
+        if (is_head[v]) {
+          heads.push_back(head_of(v));
+        }
+      }
+
+      // Commit
+      //
+      // Everything that allocates happens first; what follows only
+      // moves and assigns, and cannot throw.
+      m_strings.reserve(count);
+      m_ftables.reserve(m_ftables.size() + 1);
+      m_batch_first.reserve(m_batch_first.size() + 1);
+      m_anchor.reserve(count);
+      m_anchor_offset.reserve(count);
+      m_successor.reserve(count);
+      m_successor_overlap.reserve(count);
+      m_chain_tail.reserve(count);
+      m_survivors.reserve(m_survivors.size() + fresh.size());
+
+      for (auto k = std::size_t{0}; k < size; ++k) {
+        m_strings.push_back(std::move(added[k]));
+        m_anchor.push_back(anchor[k]);
+        m_anchor_offset.push_back(anchor_offset[k]);
+        m_successor.push_back(npos);
+        m_successor_overlap.push_back(0);
+        m_chain_tail.push_back(first + k);
+      }
+      m_ftables.push_back(std::move(ftables));
+      m_batch_first.push_back(first);
+
+      for (auto v = std::size_t{0}; v < nodes; ++v) {
+        if (successor[v] != npos) {
+          m_successor[tail_of(v)]         = head_of(successor[v]);
+          m_successor_overlap[tail_of(v)] = successor_overlap[v];
+        }
+      }
+
+      for (auto v = std::size_t{0}; v < nodes; ++v) {
+        if (is_head[v]) {
+          m_chain_tail[head_of(v)] = tail_of(chain_tail[v]);
+        }
+      }
+
+      m_survivors.insert(m_survivors.end(), fresh.begin(), fresh.end());
+      m_heads = std::move(heads);
+      m_total_overlap += overlap_total;
+    }
+
+    /**
+     * @brief Writes out the superstring of all strings added so far.
+     *
+     * @return The superstring, and for every string in insertion order
+     *   the offset at which it occurs.
+     */
+    [[nodiscard]] auto materialize() const -> result
+    {
+      auto superstring = string_type{};
+      auto offsets     = std::vector<std::size_t>(m_strings.size(), 0);
+
+      auto size = std::size_t{0};
+      for (auto const i : m_survivors) {
+        size += m_strings[i].size() - m_successor_overlap[i];
+      }
+      superstring.reserve(size);
+
+      for (auto const head : m_heads) {
+        auto skip = std::size_t{0};
+        for (auto i = head; i != npos; i = m_successor[i]) {
+          auto const& str = m_strings[i];
+
+          offsets[i] = superstring.size() - skip;
+          superstring.insert(superstring.end(),
+            std::ranges::next(str.begin(), skip),
+            str.end());
+          skip = m_successor_overlap[i];
+        }
+      }
+
+      assert(superstring.size() == size);
+
+      for (auto i = std::size_t{0}; i < m_strings.size(); ++i) {
+        if (m_anchor[i] != npos) {
+          offsets[i] = offsets[m_anchor[i]] + m_anchor_offset[i];
+        }
+      }
+
+      return result{std::move(superstring), std::move(offsets)};
+    }
+  };
+
+} // namespace vault::algorithm
+
+#endif // VAULT_ALGORITHM_SUPERSTRING_BUILDER_HPP
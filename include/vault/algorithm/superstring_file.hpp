@@ -0,0 +1,298 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_ALGORITHM_SUPERSTRING_FILE_HPP
+#define VAULT_ALGORITHM_SUPERSTRING_FILE_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cerrno>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <vault/algorithm/shortest_common_superstring.hpp>
+#include <vault/frozen_vector/frozen_vector.hpp>
+
+namespace vault::algorithm {
+
+  static_assert(std::endian::native == std::endian::little,
+    "The superstring file format is little-endian.");
+
+  /**
+   * @brief The header of a superstring file.
+   *
+   * A superstring file holds a superstring and the offset table that
+   * locates the original strings in it:
+   *
+   * | Position             | Contents                                  |
+   * |----------------------|-------------------------------------------|
+   * | 0                    | this header, 64 bytes                     |
+   * | superstring_position | `superstring_size` bytes                  |
+   * | offsets_position     | `offset_count` `superstring_offset<W>`    |
+   *
+   * Both sections start on a 64-byte boundary, so that a mapping of the
+   * file can be read in place. All integers are little-endian, and `W`
+   * is an unsigned integer of `offset_width` bytes.
+   */
+  struct superstring_file_header {
+    static constexpr auto const current_version = std::uint32_t{1};
+    static constexpr auto const alignment       = std::uint64_t{64};
+
+    std::array<char, 8> magic = {'V', 'A', 'U', 'L', 'T', 'S', 'C', 'S'};
+    std::uint32_t       version              = current_version;
+    std::uint32_t       offset_width         = 0;
+    std::uint64_t       superstring_size     = 0;
+    std::uint64_t       offset_count         = 0;
+    std::uint64_t       superstring_position = 0;
+    std::uint64_t       offsets_position     = 0;
+    std::array<std::byte, 16> reserved{};
+  };
+
+  static_assert(sizeof(superstring_file_header) == 64);
+
+  /**
+   * @brief A superstring and its offset table, read in place from a
+   * memory-mapped superstring file.
+   *
+   * Both vectors share ownership of the mapping, which is released when
+   * the last of them, or of their copies, is destroyed.
+   */
+  template <std::unsigned_integral Width = std::uint32_t>
+  struct mapped_superstring {
+    frozen::frozen_vector<char>                      superstring;
+    frozen::frozen_vector<superstring_offset<Width>> offsets;
+
+    /// The number of strings.
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+      return offsets.size();
+    }
+
+    /// String `i`, as a view of the mapping.
+    [[nodiscard]] auto operator[](std::size_t i) const noexcept
+      -> std::string_view
+    {
+      assert(i < size());
+      return {superstring.data() + offsets[i].offset, offsets[i].length};
+    }
+  };
+
+  namespace detail {
+    [[nodiscard]] constexpr auto align_superstring_file_position(
+      std::uint64_t position) noexcept -> std::uint64_t
+    {
+      constexpr auto const alignment = superstring_file_header::alignment;
+      return (position + alignment - 1) / alignment * alignment;
+    }
+
+    [[noreturn]] inline void throw_superstring_file_error(
+      std::filesystem::path const& path, char const* what)
+    {
+      throw std::runtime_error(
+        "superstring file " + path.string() + ": " + what);
+    }
+
+    template <std::unsigned_integral Width>
+    struct open_mapped_superstring_fn {
+      /**
+       * @brief Maps the superstring file at `path` read-only.
+       *
+       * Nothing is copied: pages are read from the file as the returned
+       * vectors are first touched, and are shared with every other
+       * process that maps the same file. The offset table alone is read
+       * once here, to check that every string lies in the superstring.
+       *
+       * @throws std::system_error if the file cannot be opened or
+       *   mapped, and std::runtime_error if it is not a superstring file
+       *   of this version with `Width`-byte offsets.
+       */
+      [[nodiscard]] static auto operator()(std::filesystem::path const& path)
+        -> mapped_superstring<Width>
+      {
+        auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+          throw std::system_error(errno, std::generic_category(), path.string());
+        }
+
+        struct stat status{};
+        if (::fstat(fd, &status) != 0) {
+          auto const error = errno;
+          ::close(fd);
+          throw std::system_error(error, std::generic_category(), path.string());
+        }
+
+        auto const file_size = static_cast<std::uint64_t>(status.st_size);
+        if (file_size < sizeof(superstring_file_header)) {
+          ::close(fd);
+          throw_superstring_file_error(path, "truncated header");
+        }
+
+        auto* const address = ::mmap(nullptr,
+          static_cast<std::size_t>(file_size),
+          PROT_READ,
+          MAP_SHARED,
+          fd,
+          0);
+        auto const error = errno;
+        ::close(fd);
+
+        if (address == MAP_FAILED) {
+          throw std::system_error(error, std::generic_category(), path.string());
+        }
+
+        auto const mapping = std::shared_ptr<std::byte const>(
+          static_cast<std::byte const*>(address),
+          [file_size](std::byte const* p) {
+            ::munmap(const_cast<std::byte*>(p),
+              static_cast<std::size_t>(file_size));
+          });
+
+        auto header = superstring_file_header{};
+        std::memcpy(&header, mapping.get(), sizeof(header));
+
+        if (header.magic != superstring_file_header{}.magic) {
+          throw_superstring_file_error(path, "bad magic");
+        }
+        if (header.version != superstring_file_header::current_version) {
+          throw_superstring_file_error(path, "unsupported version");
+        }
+        if (header.offset_width != sizeof(Width)) {
+          throw_superstring_file_error(path, "offset width mismatch");
+        }
+
+        // The offset count is bounded by dividing rather than by
+        // multiplying, which could wrap.
+        if (header.superstring_position % superstring_file_header::alignment
+            != 0
+          || header.offsets_position % superstring_file_header::alignment != 0
+          || header.superstring_position > file_size
+          || header.superstring_size > file_size - header.superstring_position
+          || header.offsets_position > file_size
+          || header.offset_count > (file_size - header.offsets_position)
+              / sizeof(superstring_offset<Width>)) {
+          throw_superstring_file_error(path, "section out of bounds");
+        }
+
+        auto const* const superstring = reinterpret_cast<char const*>(
+          mapping.get() + header.superstring_position);
+        auto const* const offsets =
+          reinterpret_cast<superstring_offset<Width> const*>(
+            mapping.get() + header.offsets_position);
+
+        auto const in_bounds = [&](superstring_offset<Width> const& o) {
+          return o.offset <= header.superstring_size
+            && o.length <= header.superstring_size - o.offset;
+        };
+        if (!std::all_of(
+              offsets, offsets + header.offset_count, in_bounds)) {
+          throw_superstring_file_error(path, "offset out of bounds");
+        }
+
+        return mapped_superstring<Width>{
+          {std::shared_ptr<char const[]>(mapping, superstring),
+            static_cast<std::size_t>(header.superstring_size)},
+          {std::shared_ptr<superstring_offset<Width> const[]>(mapping, offsets),
+            static_cast<std::size_t>(header.offset_count)}};
+      }
+    };
+  } // namespace detail
+
+  /**
+   * @brief Writes a superstring and its offset table to a superstring
+   * file.
+   *
+   * @code
+   * auto offsets = std::vector<vault::algorithm::superstring_offset<>>{};
+   * auto result  = vault::algorithm::shortest_common_superstring(strings,
+   *   vault::algorithm::superstring_offsets(std::back_inserter(offsets)));
+   * vault::algorithm::save_superstring(path, result.superstring, offsets);
+   * @endcode
+   *
+   * @throws std::ios_base::failure if the file cannot be written.
+   */
+  constexpr inline struct save_superstring_fn {
+    /**
+     * @param path The file to create or overwrite.
+     * @param superstring The superstring, as bytes.
+     * @param offsets The locations of the strings in `superstring`.
+     */
+    template <std::ranges::contiguous_range Superstring,
+      std::ranges::contiguous_range        Offsets>
+      requires(sizeof(std::ranges::range_value_t<Superstring>) == 1)
+      && requires {
+           typename std::ranges::range_value_t<Offsets>::width_type;
+         }
+      && std::same_as<std::ranges::range_value_t<Offsets>,
+        superstring_offset<
+          typename std::ranges::range_value_t<Offsets>::width_type>>
+    static void operator()(std::filesystem::path const& path,
+      Superstring const&                                superstring,
+      Offsets const&                                    offsets)
+    {
+      using offset_t = std::ranges::range_value_t<Offsets>;
+
+      auto header             = superstring_file_header{};
+      header.offset_width     = sizeof(typename offset_t::width_type);
+      header.superstring_size = std::ranges::size(superstring);
+      header.offset_count     = std::ranges::size(offsets);
+      header.superstring_position =
+        detail::align_superstring_file_position(sizeof(header));
+      header.offsets_position = detail::align_superstring_file_position(
+        header.superstring_position + header.superstring_size);
+
+      auto file = std::ofstream{};
+      file.exceptions(std::ios::failbit | std::ios::badbit);
+      file.open(path, std::ios::binary | std::ios::trunc);
+
+      auto position = std::uint64_t{0};
+      auto write    = [&](void const* data, std::uint64_t size) {
+        file.write(
+          static_cast<char const*>(data), static_cast<std::streamsize>(size));
+        position += size;
+      };
+      auto pad_to = [&](std::uint64_t target) {
+        static constexpr auto const zeros =
+          std::array<char, superstring_file_header::alignment>{};
+        assert(target - position <= zeros.size());
+        write(zeros.data(), target - position);
+      };
+
+      write(&header, sizeof(header));
+      pad_to(header.superstring_position);
+      write(std::ranges::data(superstring), header.superstring_size);
+      pad_to(header.offsets_position);
+      write(std::ranges::data(offsets), header.offset_count * sizeof(offset_t));
+    }
+  } const save_superstring{};
+
+  /**
+   * @brief Maps a superstring file written with `Width`-byte offsets.
+   *
+   * @code
+   * auto table = vault::algorithm::open_mapped_superstring<>(path);
+   * auto word  = table[42];
+   * @endcode
+   */
+  template <std::unsigned_integral Width = std::uint32_t>
+  constexpr inline auto const open_mapped_superstring =
+    detail::open_mapped_superstring_fn<Width>{};
+
+} // namespace vault::algorithm
+
+#endif // VAULT_ALGORITHM_SUPERSTRING_FILE_HPP
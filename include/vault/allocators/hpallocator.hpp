@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <limits>
 #include <memory>
@@ -14,6 +15,35 @@
 
 namespace static_data {
 
+#if __has_include(<sys/mman.h>)
+  namespace detail {
+    /**
+     * @brief Maps bytes of anonymous memory aligned to alignment, a power of two no smaller than a
+     * page, by over-mapping and trimming the ends.
+     * * @throws std::bad_alloc if the memory cannot be mapped.
+     */
+    [[nodiscard]] inline void* map_aligned(std::size_t bytes, std::size_t alignment) {
+      const std::size_t span = bytes + alignment;
+      void*             raw  = ::mmap(nullptr, span, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (raw == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+
+      const auto        base    = reinterpret_cast<std::uintptr_t>(raw);
+      const auto        aligned = (base + alignment - 1) & ~(std::uintptr_t{alignment} - 1);
+      const std::size_t head    = aligned - base;
+      const std::size_t tail    = span - head - bytes;
+      if (head > 0) {
+        ::munmap(raw, head);
+      }
+      if (tail > 0) {
+        ::munmap(reinterpret_cast<void*>(aligned + bytes), tail);
+      }
+      return reinterpret_cast<void*>(aligned);
+    }
+  } // namespace detail
+#endif
+
   /**
    * @brief A stateless, C++23 conformant allocator optimized for large static datasets.
    * * This allocator guarantees 2 MiB alignment and synchronous kernel page collapsing
@@ -0,0 +1,283 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <vault/allocators/hpallocator.hpp>
+#include <vault/metrics/metrics.hpp>
+
+namespace static_data {
+
+  namespace detail {
+    // The regions handed out by every pool in the process, for vault::metrics.
+    inline const vault::metrics::counter hugepage_pool_reuses{"hugepage_pool.reuses"};
+    inline const vault::metrics::counter hugepage_pool_maps{"hugepage_pool.maps"};
+  } // namespace detail
+
+  struct hugepage_pool_options {
+    // The most bytes that freed regions may hold in the free lists. A region freed beyond it is
+    // unmapped.
+    std::size_t max_pooled_bytes = std::size_t{1} << 30; // 1 GiB
+
+    // Whether new regions are faulted in when they are mapped rather than on first touch.
+    bool populate = false;
+  };
+
+  struct hugepage_pool_stats {
+    std::size_t allocations       = 0; // Regions handed out.
+    std::size_t reuses            = 0; // Regions handed out from a free list.
+    std::size_t maps              = 0; // Regions mapped from the kernel.
+    std::size_t unmaps            = 0; // Regions returned to the kernel.
+    std::size_t mapped_bytes      = 0; // Bytes mapped, in use or pooled.
+    std::size_t pooled_bytes      = 0; // Bytes held in the free lists.
+    std::size_t peak_mapped_bytes = 0; // The most bytes ever mapped at once.
+  };
+
+  /**
+   * @brief A thread-safe pool of 2 MiB aligned, huge-page backed regions, kept in size-class
+   * free lists when freed.
+   * * hpallocator maps and advises every large allocation anew and returns it to libc when it is
+   * freed, so a service that rebuilds its large structures periodically pays the page faults and
+   * the huge page collapse on every rebuild. The pool maps regions itself, and keeps those that
+   * are freed to hand out again already faulted in, up to max_pooled_bytes.
+   * * Sizes are rounded up to whole huge pages, and then to a size class: exact page counts up to
+   * 8 pages, then 4 classes per doubling, so no region is more than 25% larger than asked for and
+   * sizes that drift a little between rebuilds still share a class.
+   * * With populate, new regions are prefaulted after the huge page advice with
+   * MADV_POPULATE_WRITE, or by touching every page on kernels without it, so that the kernel
+   * faults in huge pages rather than small ones.
+   */
+  class hugepage_pool {
+  public:
+    static constexpr std::size_t huge_page_size = 2 * 1024 * 1024; // 2 MiB
+
+  private:
+    hugepage_pool_options                                 m_options;
+    mutable std::mutex                                    m_mutex;
+    std::unordered_map<std::size_t, std::vector<void*>> m_free_lists;
+    hugepage_pool_stats                                   m_stats;
+
+    static void* map_region(std::size_t bytes, bool populate) {
+      void* ptr = detail::map_aligned(bytes, huge_page_size);
+#if defined(MADV_HUGEPAGE)
+      ::madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+      if (populate) {
+        prefault(ptr, bytes);
+      }
+      return ptr;
+    }
+
+    static void prefault(void* ptr, std::size_t bytes) noexcept {
+#if defined(MADV_POPULATE_WRITE)
+      if (::madvise(ptr, bytes, MADV_POPULATE_WRITE) == 0) {
+        return;
+      }
+#endif
+      const auto page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+      auto*      p    = static_cast<volatile char*>(ptr);
+      for (std::size_t offset = 0; offset < bytes; offset += page) {
+        p[offset] = 0;
+      }
+    }
+
+    static void unmap_region(void* ptr, std::size_t bytes) noexcept { ::munmap(ptr, bytes); }
+
+  public:
+    [[nodiscard]] explicit hugepage_pool(hugepage_pool_options options = {}) noexcept : m_options(options) {}
+
+    hugepage_pool(const hugepage_pool&)            = delete;
+    hugepage_pool& operator=(const hugepage_pool&) = delete;
+
+    /**
+     * @brief Unmaps the pooled regions. Every region handed out must have been deallocated.
+     */
+    ~hugepage_pool() { trim(); }
+
+    /**
+     * @brief The bytes of the size class of an allocation of bytes bytes.
+     */
+    [[nodiscard]] static constexpr std::size_t size_class(std::size_t bytes) noexcept {
+      const std::size_t pages = std::max<std::size_t>((bytes + huge_page_size - 1) / huge_page_size, 1);
+      const int         shift = std::max(static_cast<int>(std::bit_width(pages - 1)), 3) - 3;
+      return ((((pages - 1) >> shift) + 1) << shift) * huge_page_size;
+    }
+
+    /**
+     * @brief Hands out a region of at least bytes bytes, aligned to a huge page: a pooled region
+     * of its size class if there is one, or else a new mapping.
+     * * @throws std::bad_alloc if the region cannot be mapped.
+     */
+    [[nodiscard]] void* allocate(std::size_t bytes) {
+      const std::size_t size = size_class(bytes);
+      {
+        std::lock_guard lock(m_mutex);
+        auto            it = m_free_lists.find(size);
+        if (it != m_free_lists.end() && !it->second.empty()) {
+          void* ptr = it->second.back();
+          it->second.pop_back();
+          m_stats.pooled_bytes -= size;
+          ++m_stats.allocations;
+          ++m_stats.reuses;
+          detail::hugepage_pool_reuses.add();
+          return ptr;
+        }
+      }
+
+      void* ptr = map_region(size, m_options.populate);
+
+      std::lock_guard lock(m_mutex);
+      ++m_stats.allocations;
+      ++m_stats.maps;
+      detail::hugepage_pool_maps.add();
+      m_stats.mapped_bytes += size;
+      m_stats.peak_mapped_bytes = std::max(m_stats.peak_mapped_bytes, m_stats.mapped_bytes);
+      return ptr;
+    }
+
+    /**
+     * @brief Returns a region allocated with the same bytes to its free list, or unmaps it if
+     * the free lists are full.
+     */
+    void deallocate(void* ptr, std::size_t bytes) noexcept {
+      const std::size_t size = size_class(bytes);
+      {
+        std::lock_guard lock(m_mutex);
+        if (m_stats.pooled_bytes + size <= m_options.max_pooled_bytes) {
+          try {
+            m_free_lists[size].push_back(ptr);
+            m_stats.pooled_bytes += size;
+            return;
+          } catch (...) {
+            // Unmapped below, as if the free lists were full.
+          }
+        }
+        ++m_stats.unmaps;
+        m_stats.mapped_bytes -= size;
+      }
+      unmap_region(ptr, size);
+    }
+
+    /**
+     * @brief Unmaps every pooled region.
+     */
+    void trim() noexcept {
+      std::unordered_map<std::size_t, std::vector<void*>> free_lists;
+      {
+        std::lock_guard lock(m_mutex);
+        free_lists.swap(m_free_lists);
+        for (const auto& [size, regions] : free_lists) {
+          m_stats.unmaps += regions.size();
+          m_stats.mapped_bytes -= size * regions.size();
+        }
+        m_stats.pooled_bytes = 0;
+      }
+      for (const auto& [size, regions] : free_lists) {
+        for (void* ptr : regions) {
+          unmap_region(ptr, size);
+        }
+      }
+    }
+
+    [[nodiscard]] hugepage_pool_stats stats() const noexcept {
+      std::lock_guard lock(m_mutex);
+      return m_stats;
+    }
+
+    [[nodiscard]] const hugepage_pool_options& options() const noexcept { return m_options; }
+  };
+
+  /**
+   * @brief The pool that default-constructed pooled allocators share, with the default options.
+   */
+  [[nodiscard]] inline std::shared_ptr<hugepage_pool> default_hugepage_pool() {
+    static const std::shared_ptr<hugepage_pool> pool = std::make_shared<hugepage_pool>();
+    return pool;
+  }
+
+  /**
+   * @brief hpallocator with its large allocations served by a hugepage_pool.
+   * * Allocations below hpallocator::huge_page_threshold go to hpallocator; larger ones are
+   * regions of the pool, which deallocation returns to it rather than to libc. Allocators
+   * compare equal when they share a pool.
+   * * @tparam T The type of elements to allocate.
+   */
+  template <typename T>
+  class pooled_hpallocator {
+    static_assert(alignof(T) <= hugepage_pool::huge_page_size, "Pooled regions are aligned to one huge page.");
+
+    template <typename>
+    friend class pooled_hpallocator;
+
+    std::shared_ptr<hugepage_pool> m_pool;
+
+    [[nodiscard]] static constexpr bool is_pooled(std::size_t n) noexcept {
+      return n * sizeof(T) >= hpallocator<T>::huge_page_threshold;
+    }
+
+  public:
+    using value_type                             = T;
+    using size_type                              = std::size_t;
+    using difference_type                        = std::ptrdiff_t;
+    using is_always_equal                        = std::false_type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    /**
+     * @brief An allocator that shares the default_hugepage_pool().
+     */
+    [[nodiscard]] pooled_hpallocator() : m_pool(default_hugepage_pool()) {}
+
+    [[nodiscard]] explicit pooled_hpallocator(std::shared_ptr<hugepage_pool> pool) noexcept : m_pool(std::move(pool)) {}
+
+    template <typename U>
+    [[nodiscard]] pooled_hpallocator(const pooled_hpallocator<U>& other) noexcept : m_pool(other.m_pool) {}
+
+    /**
+     * @brief Allocates uninitialized storage.
+     * * @throws std::bad_array_new_length if size calculation overflows.
+     * @throws std::bad_alloc if memory allocation fails.
+     */
+    [[nodiscard]] T* allocate(std::size_t n) {
+      if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+      }
+      if (!is_pooled(n)) {
+        return hpallocator<T>{}.allocate(n);
+      }
+      return static_cast<T*>(m_pool->allocate(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+      if (p == nullptr) {
+        return;
+      }
+      if (!is_pooled(n)) {
+        hpallocator<T>{}.deallocate(p, n);
+        return;
+      }
+      m_pool->deallocate(p, n * sizeof(T));
+    }
+
+    [[nodiscard]] const std::shared_ptr<hugepage_pool>& pool() const noexcept { return m_pool; }
+  };
+
+  template <typename T, typename U>
+  [[nodiscard]] bool operator==(const pooled_hpallocator<T>& lhs, const pooled_hpallocator<U>& rhs) noexcept {
+    return lhs.pool() == rhs.pool();
+  }
+
+} // namespace static_data
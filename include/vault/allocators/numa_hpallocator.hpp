@@ -0,0 +1,236 @@
+#pragma once
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include <vault/allocators/hpallocator.hpp>
+
+#if defined(__linux__) && __has_include(<linux/mempolicy.h>) && __has_include(<sys/syscall.h>)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(SYS_mbind) && defined(SYS_get_mempolicy) && defined(SYS_getcpu)
+#define VAULT_ALLOCATORS_HAS_MEMPOLICY 1
+#endif
+#endif
+
+namespace static_data {
+
+  /**
+   * @brief The NUMA node of the CPU the calling thread runs on, or 0 where it cannot be told.
+   */
+  [[nodiscard]] inline unsigned current_numa_node() noexcept {
+#if defined(VAULT_ALLOCATORS_HAS_MEMPOLICY)
+    unsigned cpu  = 0;
+    unsigned node = 0;
+    if (::syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+      return node;
+    }
+#endif
+    return 0;
+  }
+
+  /**
+   * @brief The NUMA node of the page that holds ptr, or -1 if the page is not faulted in or the
+   * kernel cannot tell.
+   */
+  [[nodiscard]] inline int numa_node_of(const void* ptr) noexcept {
+#if defined(VAULT_ALLOCATORS_HAS_MEMPOLICY)
+    int node = -1;
+    if (::syscall(SYS_get_mempolicy, &node, nullptr, 0, ptr, MPOL_F_NODE | MPOL_F_ADDR) == 0) {
+      return node;
+    }
+#else
+    (void)ptr;
+#endif
+    return -1;
+  }
+
+  /**
+   * @brief Where the pages of an allocation are placed among the NUMA nodes.
+   * * first_touch() leaves it to the kernel: every page goes to the node of the thread that first
+   * writes it, which under a thread pool is effectively random. on_node() binds the pages to one
+   * node, on_current_node() to the node of the thread that allocates, and interleaved() spreads
+   * them page by page across every node the process may use.
+   * * The policy is set with mbind before any page is touched. Where the kernel refuses it, e.g.
+   * without NUMA support or under a seccomp filter, the pages are placed on first touch.
+   */
+  class numa_placement {
+  public:
+    enum class mode : std::uint8_t {
+      first_touch,
+      node,
+      current_node,
+      interleave,
+    };
+
+  private:
+    mode     m_mode = mode::first_touch;
+    unsigned m_node = 0;
+
+    constexpr numa_placement(mode m, unsigned node) noexcept : m_mode(m), m_node(node) {}
+
+#if defined(VAULT_ALLOCATORS_HAS_MEMPOLICY)
+    static constexpr std::size_t max_nodes = 1024;
+    using node_mask = std::array<unsigned long, max_nodes / (sizeof(unsigned long) * CHAR_BIT)>;
+
+    static constexpr std::size_t mask_bits = max_nodes;
+
+    [[nodiscard]] static bool bind(void* ptr, std::size_t bytes, int policy, const node_mask& mask) noexcept {
+      // The kernel reads one bit fewer than maxnode.
+      return ::syscall(SYS_mbind, ptr, bytes, policy, mask.data(), mask_bits + 1, 0) == 0;
+    }
+#endif
+
+  public:
+    [[nodiscard]] constexpr numa_placement() noexcept = default;
+
+    [[nodiscard]] static constexpr numa_placement first_touch() noexcept { return {}; }
+
+    [[nodiscard]] static constexpr numa_placement on_node(unsigned node) noexcept { return {mode::node, node}; }
+
+    [[nodiscard]] static constexpr numa_placement on_current_node() noexcept { return {mode::current_node, 0}; }
+
+    [[nodiscard]] static constexpr numa_placement interleaved() noexcept { return {mode::interleave, 0}; }
+
+    [[nodiscard]] constexpr mode kind() const noexcept { return m_mode; }
+
+    /**
+     * @brief The node of on_node(), 0 for the other placements.
+     */
+    [[nodiscard]] constexpr unsigned node() const noexcept { return m_node; }
+
+    /**
+     * @brief Sets the placement of the untouched pages of [ptr, ptr + bytes), where ptr is page
+     * aligned. Returns whether the kernel took it; first_touch() always succeeds.
+     */
+    bool apply(void* ptr, std::size_t bytes) const noexcept {
+      if (m_mode == mode::first_touch) {
+        return true;
+      }
+#if defined(VAULT_ALLOCATORS_HAS_MEMPOLICY)
+      node_mask mask{};
+      constexpr std::size_t word_bits = sizeof(unsigned long) * CHAR_BIT;
+
+      if (m_mode == mode::interleave) {
+        if (::syscall(SYS_get_mempolicy, nullptr, mask.data(), mask_bits + 1, nullptr, MPOL_F_MEMS_ALLOWED) != 0) {
+          return false;
+        }
+        return bind(ptr, bytes, MPOL_INTERLEAVE, mask);
+      }
+
+      const unsigned node = m_mode == mode::node ? m_node : current_numa_node();
+      if (node >= max_nodes) {
+        return false;
+      }
+      mask[node / word_bits] |= 1UL << (node % word_bits);
+      return bind(ptr, bytes, MPOL_BIND, mask);
+#else
+      (void)ptr;
+      (void)bytes;
+      return false;
+#endif
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(const numa_placement&, const numa_placement&) noexcept = default;
+  };
+
+  /**
+   * @brief hpallocator with the huge-page allocations placed on NUMA nodes.
+   * * Allocations of at least hpallocator::huge_page_threshold are mapped 2 MiB aligned, given
+   * their numa_placement with mbind, and then advised for huge pages, so that the huge pages are
+   * allocated on the chosen nodes when they are first touched. They are mapped rather than taken
+   * from libc so that the policy, which stays with the address range, never applies to heap
+   * memory that libc hands out again. Unlike hpallocator, they are not collapsed at allocation:
+   * a synchronous collapse would place the pages before the first touch, on the node of the
+   * allocating thread. Smaller allocations share pages with other blocks of the heap, so they are
+   * served by hpallocator and placed on first touch.
+   * * Memory from any numa_hpallocator can be freed by any other, but not by hpallocator. The
+   * placement only decides where new allocations go. Allocators compare equal when their
+   * placements are equal.
+   * * @tparam T The type of elements to allocate.
+   */
+  template <typename T>
+  class numa_hpallocator {
+    static_assert(!std::is_const_v<T>, "The C++ Standard forbids allocators for const types.");
+    static_assert(!std::is_volatile_v<T>, "The C++ Standard forbids allocators for volatile types.");
+
+    template <typename>
+    friend class numa_hpallocator;
+
+    numa_placement m_placement;
+
+    // Large allocations get mappings of their own, so that their placement covers no other
+    // memory, and outlives none of it.
+    [[nodiscard]] static constexpr bool is_mapped(std::size_t n) noexcept {
+      return n * sizeof(T) >= hpallocator<T>::huge_page_threshold && alignof(T) <= hpallocator<T>::huge_page_threshold;
+    }
+
+  public:
+    using value_type                             = T;
+    using size_type                              = std::size_t;
+    using difference_type                        = std::ptrdiff_t;
+    using is_always_equal                        = std::false_type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    static constexpr std::size_t huge_page_threshold = hpallocator<T>::huge_page_threshold;
+
+    [[nodiscard]] constexpr numa_hpallocator() noexcept = default;
+
+    [[nodiscard]] constexpr explicit numa_hpallocator(numa_placement placement) noexcept : m_placement(placement) {}
+
+    template <typename U>
+    [[nodiscard]] constexpr numa_hpallocator(const numa_hpallocator<U>& other) noexcept
+      : m_placement(other.m_placement) {}
+
+    /**
+     * @brief Allocates uninitialized storage.
+     * * @throws std::bad_array_new_length if size calculation overflows.
+     * @throws std::bad_alloc if memory allocation fails.
+     */
+    [[nodiscard]] T* allocate(std::size_t n) {
+      if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+      }
+
+      if (!is_mapped(n)) {
+        return hpallocator<T>{}.allocate(n);
+      }
+
+      const std::size_t bytes = n * sizeof(T);
+      void*             ptr   = detail::map_aligned(bytes, huge_page_threshold);
+      m_placement.apply(ptr, bytes);
+#if defined(MADV_HUGEPAGE)
+      ::madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+      return static_cast<T*>(ptr);
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+      if (p == nullptr) {
+        return;
+      }
+      if (!is_mapped(n)) {
+        hpallocator<T>{}.deallocate(p, n);
+        return;
+      }
+      ::munmap(p, n * sizeof(T));
+    }
+
+    [[nodiscard]] constexpr numa_placement placement() const noexcept { return m_placement; }
+  };
+
+  template <typename T, typename U>
+  [[nodiscard]] constexpr bool operator==(const numa_hpallocator<T>& lhs, const numa_hpallocator<U>& rhs) noexcept {
+    return lhs.placement() == rhs.placement();
+  }
+
+} // namespace static_data
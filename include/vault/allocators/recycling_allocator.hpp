@@ -0,0 +1,269 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <vault/allocators/hpallocator.hpp>
+#include <vault/metrics/metrics.hpp>
+
+namespace static_data {
+
+  namespace detail {
+    // The takes of cacheable sizes from every segment_cache in the process, for vault::metrics.
+    inline const vault::metrics::counter segment_cache_hits{"segment_cache.hits"};
+    inline const vault::metrics::counter segment_cache_misses{"segment_cache.misses"};
+  } // namespace detail
+
+  /**
+   * @brief A thread-safe cache of freed blocks, handed back out to allocations of the same size.
+   * * Only blocks of at least min_bytes are cached, and at most capacity bytes of them: a block
+   * that would exceed it displaces the oldest cached blocks. Small blocks are released at once,
+   * since the upstream allocator serves them cheaply from its free lists.
+   * * Every block carries the function that releases it to its upstream allocator, and is only
+   * handed out again to a request with the same release function and size, so a block is always
+   * released the way it was allocated.
+   */
+  class segment_cache {
+  public:
+    using release_fn = void (*)(void* ptr, std::size_t bytes) noexcept;
+
+    static constexpr std::size_t default_capacity  = std::size_t{256} * 1024 * 1024; // 256 MiB
+    static constexpr std::size_t default_min_bytes = std::size_t{2} * 1024 * 1024;   // 2 MiB
+
+  private:
+    struct entry {
+      void*       ptr;
+      std::size_t bytes;
+      release_fn  release;
+    };
+
+    mutable std::mutex m_mutex;
+    std::vector<entry> m_entries;
+    std::size_t        m_cached_bytes = 0;
+    std::size_t        m_capacity;
+    std::size_t        m_min_bytes;
+
+    static void release_all(const std::vector<entry>& entries) noexcept {
+      for (const entry& e : entries) {
+        e.release(e.ptr, e.bytes);
+      }
+    }
+
+    // Removes the oldest entries until at most max_bytes remain cached. They are moved to
+    // evicted, to be released once the lock is dropped, or released at once if that fails.
+    void evict(std::size_t max_bytes, std::vector<entry>& evicted) noexcept {
+      std::size_t count = 0;
+      while (m_cached_bytes > max_bytes) {
+        m_cached_bytes -= m_entries[count++].bytes;
+      }
+      if (count == 0) {
+        return;
+      }
+
+      const auto last = m_entries.begin() + static_cast<std::ptrdiff_t>(count);
+      try {
+        evicted.assign(m_entries.begin(), last);
+      } catch (...) {
+        std::for_each(m_entries.begin(), last, [](const entry& e) { e.release(e.ptr, e.bytes); });
+      }
+      m_entries.erase(m_entries.begin(), last);
+    }
+
+  public:
+    [[nodiscard]] explicit segment_cache(
+      std::size_t capacity = default_capacity, std::size_t min_bytes = default_min_bytes
+    ) noexcept
+      : m_capacity(capacity), m_min_bytes(min_bytes) {}
+
+    segment_cache(const segment_cache&)            = delete;
+    segment_cache& operator=(const segment_cache&) = delete;
+
+    ~segment_cache() { release_all(m_entries); }
+
+    /**
+     * @brief Takes a cached block of bytes bytes released by release, or returns nullptr.
+     * The most recently cached block is taken first, as the likeliest to be resident.
+     */
+    [[nodiscard]] void* take(std::size_t bytes, release_fn release) noexcept {
+      if (bytes < m_min_bytes) {
+        return nullptr;
+      }
+
+      std::lock_guard lock(m_mutex);
+      for (std::size_t i = m_entries.size(); i > 0; --i) {
+        entry& e = m_entries[i - 1];
+        if (e.bytes == bytes && e.release == release) {
+          void* ptr = e.ptr;
+          m_cached_bytes -= bytes;
+          m_entries.erase(m_entries.begin() + static_cast<std::ptrdiff_t>(i - 1));
+          detail::segment_cache_hits.add();
+          return ptr;
+        }
+      }
+      detail::segment_cache_misses.add();
+      return nullptr;
+    }
+
+    /**
+     * @brief Caches a block, or releases it if it is too small or larger than the capacity.
+     */
+    void give(void* ptr, std::size_t bytes, release_fn release) noexcept {
+      if (bytes < m_min_bytes || bytes > m_capacity) {
+        release(ptr, bytes);
+        return;
+      }
+
+      std::vector<entry> evicted;
+      {
+        std::lock_guard lock(m_mutex);
+        try {
+          m_entries.push_back({ptr, bytes, release});
+        } catch (...) {
+          release(ptr, bytes);
+          return;
+        }
+        m_cached_bytes += bytes;
+        evict(m_capacity, evicted);
+      }
+      release_all(evicted);
+    }
+
+    /**
+     * @brief Releases cached blocks, oldest first, until at most max_bytes remain cached.
+     */
+    void trim(std::size_t max_bytes = 0) noexcept {
+      std::vector<entry> evicted;
+      {
+        std::lock_guard lock(m_mutex);
+        evict(max_bytes, evicted);
+      }
+      release_all(evicted);
+    }
+
+    [[nodiscard]] std::size_t cached_bytes() const noexcept {
+      std::lock_guard lock(m_mutex);
+      return m_cached_bytes;
+    }
+
+    [[nodiscard]] std::size_t cached_count() const noexcept {
+      std::lock_guard lock(m_mutex);
+      return m_entries.size();
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return m_capacity; }
+
+    [[nodiscard]] std::size_t min_bytes() const noexcept { return m_min_bytes; }
+  };
+
+  /**
+   * @brief The cache that default-constructed recycling allocators share, with the default
+   * capacity. Its blocks are released at exit, or with the last allocator that outlives it.
+   */
+  [[nodiscard]] inline std::shared_ptr<segment_cache> default_segment_cache() {
+    static const std::shared_ptr<segment_cache> cache = std::make_shared<segment_cache>();
+    return cache;
+  }
+
+  /**
+   * @brief An allocator that recycles large freed blocks through a segment_cache.
+   * * Blocks of at least the cache's min_bytes are returned to the cache instead of the upstream
+   * allocator, and an allocation of the same size takes one back before asking upstream. A
+   * segmented_vector with a capped growth policy allocates every large block with the same size,
+   * so one that is cleared and refilled, or a series of short-lived ones, reuses blocks that are
+   * already faulted in and, with hpallocator upstream, already backed by huge pages.
+   * * Allocators compare equal when they share a cache; a block may be deallocated through any
+   * allocator equal to the one that allocated it.
+   * * @tparam T The type of elements to allocate.
+   * @tparam Upstream A stateless allocator of T that provides and finally frees the blocks.
+   */
+  template <typename T, typename Upstream = hpallocator<T>>
+  class recycling_allocator {
+    static_assert(
+      std::is_same_v<typename std::allocator_traits<Upstream>::value_type, T>,
+      "Upstream::value_type must match the allocator's value_type T."
+    );
+    static_assert(
+      std::allocator_traits<Upstream>::is_always_equal::value && std::is_default_constructible_v<Upstream>,
+      "The upstream allocator must be stateless, as the cache releases blocks through a fresh one."
+    );
+
+    template <typename, typename>
+    friend class recycling_allocator;
+
+    using UpstreamTraits = std::allocator_traits<Upstream>;
+
+    std::shared_ptr<segment_cache> m_cache;
+
+    static void release(void* ptr, std::size_t bytes) noexcept {
+      Upstream upstream;
+      UpstreamTraits::deallocate(upstream, static_cast<T*>(ptr), bytes / sizeof(T));
+    }
+
+  public:
+    using value_type                             = T;
+    using size_type                              = std::size_t;
+    using difference_type                        = std::ptrdiff_t;
+    using is_always_equal                        = std::false_type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    template <typename U>
+    struct rebind {
+      using other = recycling_allocator<U, typename UpstreamTraits::template rebind_alloc<U>>;
+    };
+
+    /**
+     * @brief An allocator that shares the default_segment_cache().
+     */
+    [[nodiscard]] recycling_allocator() : m_cache(default_segment_cache()) {}
+
+    [[nodiscard]] explicit recycling_allocator(std::shared_ptr<segment_cache> cache) noexcept
+      : m_cache(std::move(cache)) {}
+
+    template <typename U, typename UpstreamU>
+    [[nodiscard]] recycling_allocator(const recycling_allocator<U, UpstreamU>& other) noexcept
+      : m_cache(other.m_cache) {}
+
+    /**
+     * @brief Allocates uninitialized storage, from the cache if it holds a block of the size.
+     * * @throws std::bad_array_new_length if size calculation overflows.
+     * @throws std::bad_alloc if memory allocation fails.
+     */
+    [[nodiscard]] T* allocate(std::size_t n) {
+      if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+      }
+      if (void* ptr = m_cache->take(n * sizeof(T), &release)) {
+        return static_cast<T*>(ptr);
+      }
+      Upstream upstream;
+      return UpstreamTraits::allocate(upstream, n);
+    }
+
+    /**
+     * @brief Returns storage to the cache, which releases it upstream if it does not keep it.
+     */
+    void deallocate(T* p, std::size_t n) noexcept {
+      if (p == nullptr) {
+        return;
+      }
+      m_cache->give(p, n * sizeof(T), &release);
+    }
+
+    [[nodiscard]] const std::shared_ptr<segment_cache>& cache() const noexcept { return m_cache; }
+  };
+
+  template <typename T, typename UT, typename U, typename UU>
+  [[nodiscard]] bool operator==(const recycling_allocator<T, UT>& lhs, const recycling_allocator<U, UU>& rhs) noexcept {
+    return lhs.cache() == rhs.cache();
+  }
+
+} // namespace static_data
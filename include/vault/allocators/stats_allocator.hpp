@@ -0,0 +1,275 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+// Allocation statistics are recorded unless this is defined to 0, in which case stats_allocator
+// forwards to its upstream allocator and holds no state.
+#if !defined(VAULT_ALLOCATION_STATS)
+#define VAULT_ALLOCATION_STATS 1
+#endif
+
+namespace static_data {
+
+  /**
+   * @brief A copy of the counters of an allocation_stats at one point.
+   */
+  struct allocation_snapshot {
+    static constexpr std::size_t size_class_count = 65;
+
+    std::size_t allocations               = 0; // Allocations made.
+    std::size_t deallocations             = 0; // Allocations freed.
+    std::size_t allocated_bytes           = 0; // Bytes allocated.
+    std::size_t allocated_huge_page_bytes = 0; // Bytes allocated in whole, aligned huge pages.
+    std::size_t live_bytes                = 0; // Bytes allocated and not yet freed.
+    std::size_t live_huge_page_bytes      = 0; // Live bytes in whole, aligned huge pages.
+    std::size_t peak_bytes                = 0; // The most live bytes at once.
+
+    // Allocations by size class: class k counts sizes in [2^(k-1), 2^k).
+    std::array<std::size_t, size_class_count> size_classes{};
+
+    /**
+     * @brief The share of the allocated bytes that lie in whole, aligned huge pages.
+     */
+    [[nodiscard]] double huge_page_coverage() const noexcept {
+      return allocated_bytes == 0 ? 0.0
+                                  : static_cast<double>(allocated_huge_page_bytes) / static_cast<double>(allocated_bytes);
+    }
+  };
+
+  /**
+   * @brief Thread-safe counters of the allocations made through stats_allocator.
+   * * The huge page figure counts the bytes of every allocation that lie in whole 2 MiB pages,
+   * aligned to 2 MiB: the part that transparent huge pages can back. Whether the kernel backs
+   * them is its choice, see process_huge_page_bytes() for what it did.
+   */
+  class allocation_stats {
+  public:
+    static constexpr std::size_t huge_page_size = 2 * 1024 * 1024; // 2 MiB
+
+  private:
+    std::atomic<std::size_t> m_allocations{0};
+    std::atomic<std::size_t> m_deallocations{0};
+    std::atomic<std::size_t> m_allocated_bytes{0};
+    std::atomic<std::size_t> m_allocated_huge_page_bytes{0};
+    std::atomic<std::size_t> m_live_bytes{0};
+    std::atomic<std::size_t> m_live_huge_page_bytes{0};
+    std::atomic<std::size_t> m_peak_bytes{0};
+
+    std::array<std::atomic<std::size_t>, allocation_snapshot::size_class_count> m_size_classes{};
+
+  public:
+    [[nodiscard]] allocation_stats() noexcept = default;
+
+    allocation_stats(const allocation_stats&)            = delete;
+    allocation_stats& operator=(const allocation_stats&) = delete;
+
+    /**
+     * @brief The bytes of [ptr, ptr + bytes) in whole, aligned huge pages.
+     */
+    [[nodiscard]] static std::size_t huge_page_bytes(const void* ptr, std::size_t bytes) noexcept {
+      if (bytes < huge_page_size) {
+        return 0;
+      }
+      const auto begin = reinterpret_cast<std::uintptr_t>(ptr);
+      const auto first = (begin + huge_page_size - 1) & ~(std::uintptr_t{huge_page_size} - 1);
+      const auto last  = (begin + bytes) & ~(std::uintptr_t{huge_page_size} - 1);
+      return last > first ? last - first : 0;
+    }
+
+    void record_allocation(const void* ptr, std::size_t bytes) noexcept {
+      m_allocations.fetch_add(1, std::memory_order_relaxed);
+      m_allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+      m_size_classes[std::bit_width(bytes)].fetch_add(1, std::memory_order_relaxed);
+
+      const std::size_t huge = huge_page_bytes(ptr, bytes);
+      m_allocated_huge_page_bytes.fetch_add(huge, std::memory_order_relaxed);
+      m_live_huge_page_bytes.fetch_add(huge, std::memory_order_relaxed);
+
+      const std::size_t live = m_live_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+      std::size_t       peak = m_peak_bytes.load(std::memory_order_relaxed);
+      while (live > peak && !m_peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+      }
+    }
+
+    void record_deallocation(const void* ptr, std::size_t bytes) noexcept {
+      m_deallocations.fetch_add(1, std::memory_order_relaxed);
+      m_live_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+      m_live_huge_page_bytes.fetch_sub(huge_page_bytes(ptr, bytes), std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief The counters, each read atomically, though not all at the same instant.
+     */
+    [[nodiscard]] allocation_snapshot snapshot() const noexcept {
+      allocation_snapshot s;
+      s.allocations               = m_allocations.load(std::memory_order_relaxed);
+      s.deallocations             = m_deallocations.load(std::memory_order_relaxed);
+      s.allocated_bytes           = m_allocated_bytes.load(std::memory_order_relaxed);
+      s.allocated_huge_page_bytes = m_allocated_huge_page_bytes.load(std::memory_order_relaxed);
+      s.live_bytes                = m_live_bytes.load(std::memory_order_relaxed);
+      s.live_huge_page_bytes      = m_live_huge_page_bytes.load(std::memory_order_relaxed);
+      s.peak_bytes                = m_peak_bytes.load(std::memory_order_relaxed);
+      for (std::size_t k = 0; k < s.size_classes.size(); ++k) {
+        s.size_classes[k] = m_size_classes[k].load(std::memory_order_relaxed);
+      }
+      return s;
+    }
+
+    /**
+     * @brief Zeroes the cumulative counters, and restarts the peak at the live bytes. The live
+     * counts still describe the allocations that are not freed.
+     */
+    void reset() noexcept {
+      m_allocations.store(0, std::memory_order_relaxed);
+      m_deallocations.store(0, std::memory_order_relaxed);
+      m_allocated_bytes.store(0, std::memory_order_relaxed);
+      m_allocated_huge_page_bytes.store(0, std::memory_order_relaxed);
+      m_peak_bytes.store(m_live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      for (auto& count : m_size_classes) {
+        count.store(0, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  /**
+   * @brief The statistics of every allocation made through a stats_allocator.
+   */
+  [[nodiscard]] inline allocation_stats& global_allocation_stats() noexcept {
+    static allocation_stats stats;
+    return stats;
+  }
+
+  /**
+   * @brief The anonymous memory of the process that the kernel backs with transparent huge pages,
+   * from /proc/self/smaps_rollup, or 0 where it cannot be read.
+   */
+  [[nodiscard]] inline std::size_t process_huge_page_bytes() {
+    std::ifstream file("/proc/self/smaps_rollup");
+    std::string   key;
+    while (file >> key) {
+      if (key == "AnonHugePages:") {
+        std::size_t kib = 0;
+        file >> kib;
+        return kib * 1024;
+      }
+      file.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    }
+    return 0;
+  }
+
+  namespace detail {
+    // What stats_allocator holds in place of its statistics when they are disabled.
+    struct no_allocation_stats {};
+  } // namespace detail
+
+  /**
+   * @brief An allocator adaptor that counts the allocations of Upstream.
+   * * Every allocation is recorded in global_allocation_stats(), and in the allocation_stats the
+   * allocator was constructed with, which must outlive it. Rebound copies share both, so the
+   * statistics of one container cover its allocations of every type.
+   * * With VAULT_ALLOCATION_STATS defined to 0, nothing is recorded and the adaptor holds only
+   * Upstream.
+   * * @tparam T The type of elements to allocate.
+   * @tparam Upstream The allocator of T that allocates.
+   */
+  template <typename T, typename Upstream = std::allocator<T>>
+  class stats_allocator {
+    static_assert(
+      std::is_same_v<typename std::allocator_traits<Upstream>::value_type, T>,
+      "Upstream::value_type must match the allocator's value_type T."
+    );
+
+    template <typename, typename>
+    friend class stats_allocator;
+
+    using UpstreamTraits = std::allocator_traits<Upstream>;
+
+    using stats_pointer = std::conditional_t<VAULT_ALLOCATION_STATS != 0, allocation_stats*, detail::no_allocation_stats>;
+
+    [[no_unique_address]] Upstream      m_upstream;
+    [[no_unique_address]] stats_pointer m_stats{};
+
+  public:
+    static constexpr bool enabled = VAULT_ALLOCATION_STATS != 0;
+
+    using value_type                             = T;
+    using size_type                              = typename UpstreamTraits::size_type;
+    using difference_type                        = typename UpstreamTraits::difference_type;
+    using is_always_equal                        = std::bool_constant<!enabled && UpstreamTraits::is_always_equal::value>;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    template <typename U>
+    struct rebind {
+      using other = stats_allocator<U, typename UpstreamTraits::template rebind_alloc<U>>;
+    };
+
+    /**
+     * @brief An allocator that records in the global statistics only.
+     */
+    [[nodiscard]] stats_allocator() = default;
+
+    [[nodiscard]] explicit stats_allocator(allocation_stats& stats, const Upstream& upstream = Upstream()) noexcept
+      : m_upstream(upstream) {
+#if VAULT_ALLOCATION_STATS
+      m_stats = &stats;
+#else
+      (void)stats;
+#endif
+    }
+
+    template <typename U, typename UpstreamU>
+    [[nodiscard]] stats_allocator(const stats_allocator<U, UpstreamU>& other) noexcept
+      : m_upstream(other.m_upstream), m_stats(other.m_stats) {}
+
+    [[nodiscard]] T* allocate(std::size_t n) {
+      T* ptr = UpstreamTraits::allocate(m_upstream, n);
+#if VAULT_ALLOCATION_STATS
+      global_allocation_stats().record_allocation(ptr, n * sizeof(T));
+      if (m_stats != nullptr) {
+        m_stats->record_allocation(ptr, n * sizeof(T));
+      }
+#endif
+      return ptr;
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+#if VAULT_ALLOCATION_STATS
+      global_allocation_stats().record_deallocation(p, n * sizeof(T));
+      if (m_stats != nullptr) {
+        m_stats->record_deallocation(p, n * sizeof(T));
+      }
+#endif
+      UpstreamTraits::deallocate(m_upstream, p, n);
+    }
+
+    /**
+     * @brief The statistics of this allocator, or nullptr if it records in the global ones only.
+     */
+    [[nodiscard]] allocation_stats* stats() const noexcept {
+#if VAULT_ALLOCATION_STATS
+      return m_stats;
+#else
+      return nullptr;
+#endif
+    }
+
+    [[nodiscard]] const Upstream& upstream() const noexcept { return m_upstream; }
+  };
+
+  template <typename T, typename UT, typename U, typename UU>
+  [[nodiscard]] bool operator==(const stats_allocator<T, UT>& lhs, const stats_allocator<U, UU>& rhs) noexcept {
+    return lhs.stats() == rhs.stats() && lhs.upstream() == rhs.upstream();
+  }
+
+} // namespace static_data
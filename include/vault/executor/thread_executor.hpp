@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#ifndef VAULT_EXECUTOR_THREAD_EXECUTOR_HPP
+#define VAULT_EXECUTOR_THREAD_EXECUTOR_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace vault::algorithm {
+
+  /**
+   * @brief Verifies that E can execute a chunked loop over an index
+   * range.
+   *
+   * A chunked executor is invoked as `executor(count, grain, fn)` and
+   * must call `fn(worker, first, last)` for a set of disjoint chunks
+   * `[first, last)` that together cover `[0, count)`. `worker` is in
+   * `[0, executor.concurrency())` and no two concurrent calls share a
+   * worker index, so it can be used to address per-worker scratch
+   * space. Chunks are at most `grain` indices long.
+   */
+  template <typename E>
+  concept chunked_executor = requires(E const& executor) {
+    { executor.concurrency() } -> std::convertible_to<std::size_t>;
+    executor(std::size_t{},
+      std::size_t{},
+      [](std::size_t, std::size_t, std::size_t) {});
+  };
+
+  /**
+   * @brief Chunked executor that runs everything on the calling
+   * thread.
+   */
+  struct inline_executor {
+    [[nodiscard]] static constexpr auto concurrency() noexcept -> std::size_t
+    {
+      return 1;
+    }
+
+    template <std::invocable<std::size_t, std::size_t, std::size_t> F>
+    static constexpr void operator()(
+      std::size_t count, std::size_t grain, F&& fn)
+    {
+      grain = std::max(grain, std::size_t{1});
+      for (auto first = std::size_t{0}; first < count; first += grain) {
+        std::invoke(fn, std::size_t{0}, first, std::min(first + grain, count));
+      }
+    }
+  };
+
+  /**
+   * @brief Chunked executor that forks a fixed number of threads per
+   * call and joins them before returning.
+   *
+   * Chunks are handed out dynamically from a shared counter, which
+   * balances uneven per-index costs (e.g. the rows of an overlap
+   * matrix over strings of different lengths). The calling thread
+   * participates as worker 0. If any invocation of `fn` throws, the
+   * remaining chunks are abandoned and the first exception is
+   * rethrown once all threads have joined.
+   */
+  class thread_executor {
+    std::size_t m_thread_count;
+
+  public:
+    /**
+     * @param thread_count The number of workers, including the calling
+     *   thread. Zero selects `std::thread::hardware_concurrency()`.
+     */
+    [[nodiscard]] explicit thread_executor(std::size_t thread_count = 0)
+        : m_thread_count{thread_count != 0
+              ? thread_count
+              : std::max(std::size_t{1},
+                  std::size_t{std::thread::hardware_concurrency()})}
+    {}
+
+    [[nodiscard]] auto concurrency() const noexcept -> std::size_t
+    {
+      return m_thread_count;
+    }
+
+    template <std::invocable<std::size_t, std::size_t, std::size_t> F>
+    void operator()(std::size_t count, std::size_t grain, F&& fn) const
+    {
+      grain = std::max(grain, std::size_t{1});
+
+      auto const chunk_count = (count + grain - 1) / grain;
+      auto const workers     = std::min(m_thread_count, chunk_count);
+
+      if (workers <= 1) {
+        inline_executor{}(count, grain, fn);
+        return;
+      }
+
+      auto next_chunk = std::atomic<std::size_t>{0};
+      auto failure    = std::exception_ptr{};
+      auto mutex      = std::mutex{};
+
+      auto work = [&](std::size_t worker) {
+        try {
+          while (true) {
+            auto const chunk =
+              next_chunk.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= chunk_count) {
+              return;
+            }
+            auto const first = chunk * grain;
+            std::invoke(fn, worker, first, std::min(first + grain, count));
+          }
+        } catch (...) {
+          next_chunk.store(chunk_count, std::memory_order_relaxed);
+          auto const lock = std::lock_guard{mutex};
+          if (!failure) {
+            failure = std::current_exception();
+          }
+        }
+      };
+
+      {
+        auto threads = std::vector<std::jthread>{};
+        threads.reserve(workers - 1);
+
+        for (auto worker = std::size_t{1}; worker < workers; ++worker) {
+          threads.emplace_back(work, worker);
+        }
+
+        work(0);
+      }
+
+      if (failure) {
+        std::rethrow_exception(failure);
+      }
+    }
+  };
+
+} // namespace vault::algorithm
+
+#endif // VAULT_EXECUTOR_THREAD_EXECUTOR_HPP
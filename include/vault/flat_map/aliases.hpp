@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <bit>
 #include <cassert> // Added for assertions
+#include <cstdint>
 #include <new>
 #include <type_traits>
 
@@ -59,7 +60,13 @@ namespace eytzinger::detail {
       "Key alignment requirements exceed cache line size, optimization "
       "impossible");
 
-    // 2. SIMD Optimization Check
+    // 2. String keys are searched through their 8-byte proxies, so a block
+    // holds 64 bytes of proxies and takes the 64-bit SIMD path.
+    if constexpr (ProxiedKey<K>) {
+      return 64 / sizeof(std::uint64_t);
+    }
+
+    // 3. SIMD Optimization Check
     // If K is integral and fits within the 64-byte AVX2 width, we force B to
     // match that width to enable the specialized SIMD paths.
     if constexpr (std::is_integral_v<K>) {
@@ -76,7 +83,7 @@ namespace eytzinger::detail {
       }
     }
 
-    // 3. Default Cache Line Alignment
+    // 4. Default Cache Line Alignment
     constexpr std::size_t cache_line = get_cache_line_size();
 
     // Ensure stride respects both size and alignment.
@@ -0,0 +1,279 @@
+#ifndef COMPRESSED_BTREE_KEYS_HPP
+#define COMPRESSED_BTREE_KEYS_HPP
+
+#include "implicit_btree_layout_policy.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <vector>
+
+namespace eytzinger {
+
+  /**
+   * @brief Sorted 64-bit keys in the implicit B-tree layout, compressed by
+   * frame of reference.
+   *
+   * Every block stores its smallest key as a base and its keys as Delta-bit
+   * offsets from that base, so a block of deltas fills one cache line and
+   * holds 64 / sizeof(Delta) keys instead of 8. This gives a wider tree of
+   * fewer levels. A block is searched by subtracting its base from the key
+   * and running the narrow block kernels on the deltas.
+   *
+   * Blocks whose keys span more than Delta can hold keep their keys at full
+   * width. In the B-tree layout these are mostly the blocks near the root,
+   * since a leaf block holds B consecutive keys.
+   *
+   * Block k has its header and its line of deltas both at index k, so a
+   * search knows where both are as soon as it knows the block. Each level
+   * then costs two misses in parallel, not a header miss followed by a
+   * data miss. Wide blocks leave their delta line unused.
+   *
+   * Lookups return the rank of a key in sorted order, so values can be kept
+   * in a separate array in that order.
+   */
+  template <std::unsigned_integral Delta = uint16_t>
+    requires(sizeof(Delta) < sizeof(uint64_t))
+  class compressed_btree_keys {
+  public:
+    using key_type  = uint64_t;
+    using size_type = std::size_t;
+
+    // Keys per block: one cache line of deltas.
+    static constexpr inline std::size_t B = 64 / sizeof(Delta);
+
+    using layout_policy = implicit_btree_layout_policy<B>;
+
+  private:
+    static constexpr inline key_type max_delta =
+      std::numeric_limits<Delta>::max();
+
+    // A block at full width is searched as whole 64-bit blocks.
+    static constexpr inline std::size_t wide_B     = 8;
+    static constexpr inline std::size_t wide_lines = B / wide_B;
+
+    struct alignas(64) delta_line {
+      Delta deltas[B];
+    };
+
+    struct alignas(64) wide_line {
+      key_type keys[wide_B];
+    };
+
+    struct block_header {
+      key_type      base = 0;
+      std::uint32_t line = 0; // First line in wide_, if wide.
+      bool          wide = false;
+    };
+
+    std::size_t               size_ = 0;
+    std::vector<block_header> headers_;
+    std::vector<delta_line>   deltas_; // One per block, like headers_.
+    std::vector<wide_line>    wide_;
+
+    // The number of keys of block `k` ordered before `key`: those less
+    // than it for a lower bound, those not greater for an upper bound.
+    template <search_bound Bound>
+    [[nodiscard]] std::size_t search_block(
+      std::size_t k, key_type key, std::size_t count) const
+    {
+      auto const& h = headers_[k];
+
+      if (h.wide) {
+        const key_type* keys = wide_[h.line].keys;
+        if (count < B) {
+          return Bound == search_bound::upper
+            ? scalar_block_searcher::upper_bound_n(
+                keys, count, key, std::less<>{}, std::identity{})
+            : scalar_block_searcher::lower_bound_n(
+                keys, count, key, std::less<>{}, std::identity{});
+        }
+
+        std::size_t i = 0;
+        for (std::size_t l = 0; l < wide_lines; ++l) {
+          std::size_t c = Bound == search_bound::upper
+            ? block_searcher<key_type, std::less<>, wide_B>::upper_bound(
+                keys + (l * wide_B), key, std::less<>{}, std::identity{})
+            : block_searcher<key_type, std::less<>, wide_B>::lower_bound(
+                keys + (l * wide_B), key, std::less<>{}, std::identity{});
+          i += c;
+          if (c < wide_B) {
+            break;
+          }
+        }
+        return i;
+      }
+
+      // Every key of the block is at least its base, and at most
+      // max_delta above it.
+      if (key < h.base) {
+        return 0;
+      }
+      if (key - h.base > max_delta) {
+        return count;
+      }
+
+      const Delta* deltas = deltas_[k].deltas;
+      const auto   d      = static_cast<Delta>(key - h.base);
+      if (count < B) {
+        return Bound == search_bound::upper
+          ? scalar_block_searcher::upper_bound_n(
+              deltas, count, d, std::less<>{}, std::identity{})
+          : scalar_block_searcher::lower_bound_n(
+              deltas, count, d, std::less<>{}, std::identity{});
+      }
+      return Bound == search_bound::upper
+        ? block_searcher<Delta, std::less<>, B>::upper_bound(
+            deltas, d, std::less<>{}, std::identity{})
+        : block_searcher<Delta, std::less<>, B>::lower_bound(
+            deltas, d, std::less<>{}, std::identity{});
+    }
+
+    template <search_bound Bound>
+    [[nodiscard]] std::size_t search(key_type key) const
+    {
+      std::size_t k      = 0;
+      std::size_t result = size_;
+
+      while (k * B < size_) {
+        std::size_t block_start = k * B;
+        std::size_t count       = std::min(B, size_ - block_start);
+
+        std::size_t child = detail::btree_child_block_index(k, 0, B);
+        if (child < headers_.size()) {
+          LAYOUT_PREFETCH(&headers_[child]);
+          LAYOUT_PREFETCH(&deltas_[child]);
+        }
+
+        std::size_t i = search_block<Bound>(k, key, count);
+        if (i < count) {
+          result = block_start + i;
+        }
+        k = detail::btree_child_block_index(k, i, B);
+      }
+
+      return result == size_
+        ? size_
+        : detail::btree_index_to_sorted_rank(result, size_, B);
+    }
+
+  public:
+    [[nodiscard]] compressed_btree_keys() = default;
+
+    /**
+     * @brief Builds the keys from a range sorted in ascending order.
+     */
+    template <std::ranges::input_range R>
+      requires std::convertible_to<std::ranges::range_value_t<R>, key_type>
+    [[nodiscard]] static compressed_btree_keys build(R&& sorted_keys)
+    {
+      std::vector<key_type> keys;
+      for (auto&& key : sorted_keys) {
+        keys.push_back(static_cast<key_type>(key));
+      }
+      assert(std::ranges::is_sorted(keys) && "Keys must be sorted");
+
+      layout_policy::permute(keys);
+
+      compressed_btree_keys self;
+      self.size_ = keys.size();
+      self.headers_.resize((keys.size() + B - 1) / B);
+      self.deltas_.resize(self.headers_.size());
+
+      for (std::size_t k = 0; k < self.headers_.size(); ++k) {
+        auto const first = keys.begin() + static_cast<std::ptrdiff_t>(k * B);
+        auto const count = std::min(B, keys.size() - (k * B));
+        auto&      h     = self.headers_[k];
+
+        // The keys of a block are sorted, and a partial block is padded
+        // with its largest key.
+        h.base = first[0];
+        h.wide = first[count - 1] - h.base > max_delta;
+
+        if (h.wide) {
+          h.line = static_cast<std::uint32_t>(self.wide_.size());
+          self.wide_.resize(self.wide_.size() + wide_lines);
+          for (std::size_t i = 0; i < B; ++i) {
+            self.wide_[h.line + (i / wide_B)].keys[i % wide_B] =
+              first[std::min(i, count - 1)];
+          }
+        } else {
+          auto& line = self.deltas_[k];
+          for (std::size_t i = 0; i < B; ++i) {
+            line.deltas[i] =
+              static_cast<Delta>(first[std::min(i, count - 1)] - h.base);
+          }
+        }
+      }
+
+      return self;
+    }
+
+    // --- Lookup ---
+
+    /**
+     * @brief The rank of the first key not less than `key`, or size().
+     */
+    [[nodiscard]] size_type lower_bound(key_type key) const
+    {
+      return search<search_bound::lower>(key);
+    }
+
+    /**
+     * @brief The rank of the first key greater than `key`, or size().
+     */
+    [[nodiscard]] size_type upper_bound(key_type key) const
+    {
+      return search<search_bound::upper>(key);
+    }
+
+    [[nodiscard]] bool contains(key_type key) const
+    {
+      auto const rank = lower_bound(key);
+      return rank != size_ && (*this)[rank] == key;
+    }
+
+    /**
+     * @brief The key of sorted rank `rank`.
+     */
+    [[nodiscard]] key_type operator[](size_type rank) const
+    {
+      assert(rank < size_ && "Rank out of bounds");
+      auto const  index = detail::btree_sorted_rank_to_index(rank, size_, B);
+      auto const  k     = index / B;
+      auto const& h     = headers_[k];
+      auto const  i     = index % B;
+
+      return h.wide ? wide_[h.line + (i / wide_B)].keys[i % wide_B]
+                    : h.base + deltas_[k].deltas[i];
+    }
+
+    // --- Observers ---
+
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief The number of blocks that keep their keys at full width.
+     */
+    [[nodiscard]] size_type wide_block_count() const noexcept
+    {
+      return wide_.size() / wide_lines;
+    }
+
+    [[nodiscard]] size_type memory_usage_bytes() const noexcept
+    {
+      return (headers_.size() * sizeof(block_header))
+        + (deltas_.size() * sizeof(delta_line))
+        + (wide_.size() * sizeof(wide_line));
+    }
+  };
+
+} // namespace eytzinger
+
+#endif // COMPRESSED_BTREE_KEYS_HPP
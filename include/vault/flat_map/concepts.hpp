@@ -2,7 +2,10 @@
 #define CONCEPTS_HPP
 
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <string_view>
 
 namespace eytzinger {
   // Enum to toggle between lower_bound and upper_bound behavior in search jobs
@@ -56,6 +59,30 @@ namespace eytzinger {
       { P::prev_index(idx, n) } -> std::convertible_to<std::ptrdiff_t>;
     };
 
+  // A policy that searches string keys through an array of their proxies
+  // in layout order, touching the strings only where proxies tie. Both
+  // searches return the index of the result in layout order, or n.
+  template <typename P, typename I>
+  concept ProxiedLayoutPolicy = requires(const std::uint64_t* proxies,
+    I                                                        keys,
+    std::size_t                                              n,
+    std::string_view                                         needle) {
+    {
+      P::proxied_lower_bound(proxies, keys, n, needle)
+    } -> std::convertible_to<std::size_t>;
+    {
+      P::proxied_upper_bound(proxies, keys, n, needle)
+    } -> std::convertible_to<std::size_t>;
+  };
+
+  // A policy that visits a range of sorted ranks in sorted order faster
+  // than a walk with next_index, calling a function with the index of each.
+  template <typename P, typename I>
+  concept ScanningLayoutPolicy = requires(I first,
+    std::size_t                             n,
+    std::size_t                             rank,
+    void (*f)(std::size_t)) { P::for_each_sorted(first, n, rank, rank, f); };
+
   template <typename P, typename I, typename C>
   concept OrderedForwardLayoutPolicy =
     OrderedLayoutPolicy<P, I, C> && ForwardLayoutPolicy<P>;
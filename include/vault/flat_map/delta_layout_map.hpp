@@ -0,0 +1,292 @@
+#ifndef DELTA_LAYOUT_MAP_HPP
+#define DELTA_LAYOUT_MAP_HPP
+
+#include "layout_map.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace eytzinger {
+
+  struct delta_layout_map_options {
+    // The number of buffered updates at which the delta is merged into the
+    // base.
+    std::size_t merge_threshold = 4096;
+
+    // Whether those merges run on a background thread.
+    bool background_merge = false;
+  };
+
+  /**
+   * @brief A mutable map over a frozen layout_map.
+   *
+   * Inserts and erases go to a small sorted delta in front of the base
+   * map, and lookups check the delta before the base. Once the delta
+   * holds merge_threshold updates it is merged with the base into a new
+   * layout, which replaces the base.
+   *
+   * A background merge works on the base and on the delta as they were
+   * when it started. The delta is frozen and stays searchable, and new
+   * updates go to a fresh delta in front of it. The owner installs the
+   * merged base on its next update, or in merge(), in a single pointer
+   * swap.
+   *
+   * Const members may be called concurrently, with each other but not
+   * with updates, as for a standard container. Pointers returned by find
+   * are invalidated by any update.
+   */
+  template <typename Map> class delta_layout_map {
+  public:
+    using map_type    = Map;
+    using key_type    = typename Map::key_type;
+    using mapped_type = typename Map::mapped_type;
+    using key_compare = typename Map::key_compare;
+    using size_type   = std::size_t;
+
+  private:
+    // An update of a key. An erase has no value.
+    struct delta_entry {
+      key_type                   key;
+      std::optional<mapped_type> value;
+    };
+
+    using delta_type = std::vector<delta_entry>;
+
+    std::shared_ptr<const Map>              base_;
+    std::shared_ptr<const delta_type>       frozen_;
+    delta_type                              delta_;
+    std::future<std::shared_ptr<const Map>> merge_;
+    std::size_t                             size_ = 0;
+    delta_layout_map_options                options_;
+    [[no_unique_address]] key_compare       compare_;
+
+    template <typename K0>
+    [[nodiscard]] const delta_entry* find_in(
+      const delta_type& delta, const K0& key) const
+    {
+      auto it =
+        std::ranges::lower_bound(delta, key, compare_, &delta_entry::key);
+      return it != delta.end() && !compare_(key, it->key) ? &*it : nullptr;
+    }
+
+    // The merge of `delta` into the items of `base`, as a new layout.
+    [[nodiscard]] static std::shared_ptr<const Map> merged(
+      std::shared_ptr<const Map>        base,
+      std::shared_ptr<const delta_type> delta,
+      key_compare                       compare)
+    {
+      std::vector<std::pair<key_type, mapped_type>> items;
+      items.reserve(base->size() + delta->size());
+
+      auto d     = delta->begin();
+      auto apply = [&] {
+        if (d->value) {
+          items.emplace_back(d->key, *d->value);
+        }
+        ++d;
+      };
+
+      for (auto&& [key, value] : *base) {
+        while (d != delta->end() && compare(d->key, key)) {
+          apply();
+        }
+        if (d != delta->end() && !compare(key, d->key)) {
+          apply();
+        } else {
+          items.emplace_back(key, value);
+        }
+      }
+      while (d != delta->end()) {
+        apply();
+      }
+
+      return std::make_shared<const Map>(
+        std::sorted_unique, items, compare, base->get_allocator());
+    }
+
+    // Buffers an update after which the map holds `size` items.
+    //
+    // A finished merge is installed first, so that if it failed the update
+    // is not applied at all. The size is set as soon as the update is
+    // written, so that it stays right if the merge started after it throws.
+    void record(
+      const key_type& key, std::optional<mapped_type> value, size_type size)
+    {
+      if (merge_.valid()
+        && merge_.wait_for(std::chrono::seconds(0))
+          == std::future_status::ready) {
+        install();
+      }
+
+      auto it =
+        std::ranges::lower_bound(delta_, key, compare_, &delta_entry::key);
+      if (it != delta_.end() && !compare_(key, it->key)) {
+        it->value = std::move(value);
+      } else {
+        delta_.insert(it, delta_entry{key, std::move(value)});
+      }
+      size_ = size;
+
+      if (delta_.size() >= options_.merge_threshold && !merge_.valid()) {
+        if (options_.background_merge) {
+          merge_async();
+        } else {
+          merge();
+        }
+      }
+    }
+
+    // Swaps in the base of a finished merge. If the merge failed, the
+    // frozen delta goes back under the current one, so no update is lost.
+    void install()
+    {
+      try {
+        base_ = merge_.get();
+      } catch (...) {
+        for (const auto& entry : *frozen_) {
+          auto it = std::ranges::lower_bound(
+            delta_, entry.key, compare_, &delta_entry::key);
+          if (it == delta_.end() || compare_(entry.key, it->key)) {
+            delta_.insert(it, entry);
+          }
+        }
+        frozen_.reset();
+        throw;
+      }
+      frozen_.reset();
+    }
+
+  public:
+    [[nodiscard]] explicit delta_layout_map(
+      Map base = Map(), delta_layout_map_options options = {})
+        : base_(std::make_shared<const Map>(std::move(base)))
+        , size_(base_->size())
+        , options_(options)
+        , compare_(base_->key_comp())
+    {}
+
+    // --- Lookup ---
+
+    /**
+     * @brief The value of `key`, or nullptr if it is not in the map.
+     */
+    template <typename K0 = key_type>
+    [[nodiscard]] const mapped_type* find(const K0& key) const
+    {
+      for (const delta_type* delta : {&delta_, frozen_.get()}) {
+        if (delta == nullptr) {
+          continue;
+        }
+        if (const auto* entry = find_in(*delta, key)) {
+          return entry->value ? &*entry->value : nullptr;
+        }
+      }
+
+      auto it = base_->find(key);
+      return it == base_->end() ? nullptr : &(*it).second;
+    }
+
+    template <typename K0 = key_type>
+    [[nodiscard]] bool contains(const K0& key) const
+    {
+      return find(key) != nullptr;
+    }
+
+    template <typename K0 = key_type>
+    [[nodiscard]] const mapped_type& at(const K0& key) const
+    {
+      const auto* value = find(key);
+      if (value == nullptr) {
+        throw std::out_of_range("delta_layout_map::at: key not found");
+      }
+      return *value;
+    }
+
+    // --- Updates ---
+
+    /**
+     * @brief Sets the value of `key`. Returns whether the key is new.
+     */
+    bool insert_or_assign(const key_type& key, mapped_type value)
+    {
+      const bool inserted = !contains(key);
+      record(key, std::move(value), size_ + (inserted ? 1 : 0));
+      return inserted;
+    }
+
+    /**
+     * @brief Removes `key`. Returns whether it was in the map.
+     */
+    bool erase(const key_type& key)
+    {
+      if (!contains(key)) {
+        return false;
+      }
+      record(key, std::nullopt, size_ - 1);
+      return true;
+    }
+
+    // --- Merging ---
+
+    /**
+     * @brief Merges every buffered update into the base, waiting for a
+     * background merge to finish first.
+     */
+    void merge()
+    {
+      if (merge_.valid()) {
+        install();
+      }
+      if (!delta_.empty()) {
+        base_ = merged(
+          base_, std::make_shared<const delta_type>(delta_), compare_);
+        delta_.clear();
+      }
+    }
+
+    /**
+     * @brief Starts merging the buffered updates into the base on a
+     * background thread, unless a merge is running already.
+     */
+    void merge_async()
+    {
+      if (merge_.valid() || delta_.empty()) {
+        return;
+      }
+      frozen_ = std::make_shared<const delta_type>(std::exchange(delta_, {}));
+      merge_ =
+        std::async(std::launch::async, &merged, base_, frozen_, compare_);
+    }
+
+    [[nodiscard]] bool merging() const noexcept { return merge_.valid(); }
+
+    // --- Observers ---
+
+    [[nodiscard]] size_type size() const noexcept { return size_; }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    /**
+     * @brief The number of updates not merged into the base yet.
+     */
+    [[nodiscard]] size_type delta_size() const noexcept
+    {
+      return delta_.size() + (frozen_ ? frozen_->size() : 0);
+    }
+
+    /**
+     * @brief The base map, without the buffered updates.
+     */
+    [[nodiscard]] const Map& base() const noexcept { return *base_; }
+  };
+
+} // namespace eytzinger
+
+#endif // DELTA_LAYOUT_MAP_HPP
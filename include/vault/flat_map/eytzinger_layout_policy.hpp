@@ -2,14 +2,18 @@
 #define EYTZINGER_LAYOUT_POLICY_HPP
 
 #include "concepts.hpp"
+#include "utilities.hpp"
 
 #include <algorithm>
 #include <bit>
 #include <cassert>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <ranges>
 #include <stdexcept>
+#include <string_view>
 #include <vector>
 
 #include <vault/algorithm/amac.hpp>
@@ -146,6 +150,16 @@ namespace eytzinger {
       {
         operator()(std::ranges::begin(range), std::ranges::end(range));
       }
+
+      // Scatters the sorted range on the workers of `executor`.
+      template <vault::algorithm::chunked_executor E,
+        std::ranges::random_access_range          R>
+      static void operator()(const E& executor, R&& range)
+      {
+        detail::parallel_permute<eytzinger_layout_policy>(executor,
+          std::ranges::begin(range),
+          static_cast<std::size_t>(std::ranges::distance(range)));
+      }
     };
 
     static constexpr inline permute_fn permute{};
@@ -248,6 +262,49 @@ namespace eytzinger {
     static constexpr inline next_index_fn next_index{};
     static constexpr inline prev_index_fn prev_index{};
 
+    /**
+     * @brief Calls `f(index)` for the elements of sorted ranks
+     * [first_rank, last_rank), in sorted order.
+     *
+     * An in-order walk visits the nodes of every level in ascending index
+     * order, so each level is read as a forward stream, but up to log(n)
+     * streams are interleaved and too many for the hardware prefetcher to
+     * follow. The walk prefetches a few nodes ahead of the current one,
+     * which keeps the stream of its level, and the leaves in particular,
+     * in cache.
+     */
+    struct for_each_sorted_fn {
+      template <std::contiguous_iterator I, typename F>
+      static constexpr void operator()(I first,
+        std::size_t                      n,
+        std::size_t                      first_rank,
+        std::size_t                      last_rank,
+        F                                f)
+      {
+        assert(first_rank <= last_rank && last_rank <= n);
+        if (first_rank == last_rank) {
+          return;
+        }
+
+        constexpr auto ahead = static_cast<std::ptrdiff_t>(
+          std::max<std::size_t>(1, 128 / sizeof(std::iter_value_t<I>)));
+
+        const auto end = static_cast<std::ptrdiff_t>(n);
+        auto       i   = static_cast<std::ptrdiff_t>(
+          sorted_rank_to_index(first_rank, n));
+
+        for (std::size_t rank = first_rank; rank < last_rank; ++rank) {
+          if (i + ahead < end) {
+            EYTZINGER_PREFETCH(std::to_address(first + (i + ahead)));
+          }
+          f(static_cast<std::size_t>(i));
+          i = next_index(i, n);
+        }
+      }
+    };
+
+    static constexpr inline for_each_sorted_fn for_each_sorted{};
+
     struct lower_bound_fn {
       template <std::random_access_iterator I,
         std::sentinel_for<I>                S,
@@ -338,6 +395,48 @@ namespace eytzinger {
     static constexpr inline lower_bound_fn lower_bound{};
     static constexpr inline upper_bound_fn upper_bound{};
 
+    // Searches string keys through their proxies, which are stored in the
+    // same layout. The descent reads the dense proxy array, and follows a
+    // key out to its string only when its proxy ties with the needle's.
+    template <search_bound Bound> struct proxied_bound_fn {
+      template <std::random_access_iterator KeyIter>
+      [[nodiscard]] static std::size_t operator()(const std::uint64_t* proxies,
+        KeyIter                                                       keys,
+        std::size_t                                                   n,
+        std::string_view                                              needle)
+      {
+        assert(proxies != nullptr || n == 0);
+        const std::uint64_t p = string_proxy(needle);
+        std::size_t         i = 0;
+        while (i < n) {
+          const std::size_t future_i = ((i + 1) << L) - 1;
+          if (future_i < n) {
+            EYTZINGER_PREFETCH(&proxies[future_i]);
+          }
+          bool go_right = proxies[i] < p;
+          if (proxies[i] == p) {
+            std::string_view key{keys[i]};
+            go_right = Bound == search_bound::upper ? !(needle < key)
+                                                    : key < needle;
+          }
+          i = (i << 1) + 1 + static_cast<std::size_t>(go_right);
+        }
+        std::size_t result_idx = restore_lower_bound_index(i);
+        return (result_idx == static_cast<std::size_t>(-1)) ? n : result_idx;
+      }
+    };
+
+    static constexpr inline proxied_bound_fn<search_bound::lower>
+      proxied_lower_bound{};
+    static constexpr inline proxied_bound_fn<search_bound::upper>
+      proxied_upper_bound{};
+
+    // A descent of the tree that the AMAC coordinator interleaves with
+    // others. Each step compares against one node and prefetches the node
+    // the next step compares against, so the misses of many descents are in
+    // flight together. Nodes that share the cache line of the node just
+    // compared are descended through without yielding, which makes the top
+    // levels of the tree a single step.
     template <typename HaystackIter,
       typename NeedleIter,
       typename Comp,
@@ -374,23 +473,34 @@ namespace eytzinger {
 
       [[nodiscard]] vault::amac::job_step_result<1> step()
       {
-        bool const go_right = [&] {
-          // Dereference needle_iter for comparison
-          if constexpr (Bound == search_bound::upper) {
-            return !std::invoke(comp, *needle_iter, begin_it[i]);
-          } else {
-            return std::invoke(comp, begin_it[i], *needle_iter);
-          }
-        }();
+        constexpr std::uintptr_t line = 64;
 
-        i = (i << 1) + 1 + static_cast<std::size_t>(go_right);
+        const auto* base = std::to_address(begin_it);
+        const auto* node = base + i;
 
-        if (i >= n) {
-          return {nullptr};
-        }
+        while (true) {
+          bool const go_right = [&] {
+            // Dereference needle_iter for comparison
+            if constexpr (Bound == search_bound::upper) {
+              return !std::invoke(comp, *needle_iter, *node);
+            } else {
+              return std::invoke(comp, *node, *needle_iter);
+            }
+          }();
+
+          i = (i << 1) + 1 + static_cast<std::size_t>(go_right);
+
+          if (i >= n) {
+            return {nullptr};
+          }
 
-        const std::size_t future_i = ((i + 1) << L) - 1;
-        return {std::to_address(begin_it + future_i)};
+          const auto* next = base + i;
+          if (reinterpret_cast<std::uintptr_t>(next) / line
+            != reinterpret_cast<std::uintptr_t>(node) / line) {
+            return {next};
+          }
+          node = next;
+        }
       }
 
       // Accessor for the reporter
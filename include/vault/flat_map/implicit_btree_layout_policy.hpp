@@ -2,14 +2,19 @@
 #define IMPLICIT_BTREE_LAYOUT_POLICY_HPP
 
 #include "concepts.hpp"
+#include "utilities.hpp"
 
 #include <algorithm>
 #include <cassert>
 #include <concepts>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <memory>
 #include <ranges>
 #include <stdexcept>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 #include <vault/algorithm/amac.hpp>
@@ -24,24 +29,41 @@
 #define LAYOUT_PREFETCH(ptr)
 #endif
 
-#if defined(__AVX2__)
-#define LAYOUT_USE_AVX2 1
+// Block search kernels are compiled for every instruction set of the target
+// architecture and the best one the host supports is picked at run time, so
+// they do not depend on the flags the including code is built with.
+#if defined(__x86_64__) || defined(__aarch64__)
+#define LAYOUT_USE_SIMD 1
 #endif
 
 namespace eytzinger {
 
   // --- Concepts ---
 
+  // The searches of the policy take their comparator by std::ref, which
+  // is seen through.
   template <typename Comp, typename T>
-  concept IsStandardLess = std::same_as<Comp, std::less<T>>
-    || std::same_as<Comp, std::less<void>> || std::same_as<Comp, std::less<>>
-    || std::same_as<Comp, std::ranges::less>;
+  concept IsStandardLess = std::same_as<std::unwrap_reference_t<Comp>,
+                             std::less<T>>
+    || std::same_as<std::unwrap_reference_t<Comp>, std::less<>>
+    || std::same_as<std::unwrap_reference_t<Comp>, std::ranges::less>;
 
   template <typename Comp, typename T>
-  concept IsStandardGreater = std::same_as<Comp, std::greater<T>>
-    || std::same_as<Comp, std::greater<void>>
-    || std::same_as<Comp, std::greater<>>
-    || std::same_as<Comp, std::ranges::greater>;
+  concept IsStandardGreater = std::same_as<std::unwrap_reference_t<Comp>,
+                                std::greater<T>>
+    || std::same_as<std::unwrap_reference_t<Comp>, std::greater<>>
+    || std::same_as<std::unwrap_reference_t<Comp>, std::ranges::greater>;
+
+  // Names of the floating-point key types, after those of the integers,
+  // for the block search kernels.
+  using float32_t = float;
+  using float64_t = double;
+
+  // --- Kernel Selection ---
+
+  // The instruction set of the block search kernels chosen for this host:
+  // "avx512", "avx2", "neon" or "scalar".
+  [[nodiscard]] std::string_view block_search_isa() noexcept;
 
   // --- Internal Declarations (Implemented in .cpp) ---
 
@@ -58,7 +80,7 @@ namespace eytzinger {
     [[nodiscard]] std::ptrdiff_t btree_prev_index(
       std::ptrdiff_t i, std::size_t n, std::size_t B);
 
-#ifdef LAYOUT_USE_AVX2
+#ifdef LAYOUT_USE_SIMD
     // Fast Path Full-Loop Implementations
     [[nodiscard]] std::size_t search_loop_lb_uint64_less(
       const uint64_t* base, std::size_t n, uint64_t key, std::size_t B);
@@ -115,6 +137,20 @@ namespace eytzinger {
     [[nodiscard]] std::size_t simd_lb_uint8_greater(
       const uint8_t* b, uint8_t k);
     std::size_t simd_ub_uint8_greater(const uint8_t* b, uint8_t k);
+
+    [[nodiscard]] std::size_t simd_lb_float64_less(
+      const float64_t* b, float64_t k);
+    std::size_t simd_ub_float64_less(const float64_t* b, float64_t k);
+    [[nodiscard]] std::size_t simd_lb_float64_greater(
+      const float64_t* b, float64_t k);
+    std::size_t simd_ub_float64_greater(const float64_t* b, float64_t k);
+
+    [[nodiscard]] std::size_t simd_lb_float32_less(
+      const float32_t* b, float32_t k);
+    std::size_t simd_ub_float32_less(const float32_t* b, float32_t k);
+    [[nodiscard]] std::size_t simd_lb_float32_greater(
+      const float32_t* b, float32_t k);
+    std::size_t simd_ub_float32_greater(const float32_t* b, float32_t k);
 #endif
   } // namespace detail
 
@@ -196,7 +232,7 @@ namespace eytzinger {
     }
   };
 
-#ifdef LAYOUT_USE_AVX2
+#ifdef LAYOUT_USE_SIMD
 #define DEFINE_SIMD_SPECIALIZATION(TYPE, BLOCK_SIZE, CONCEPT, SUFFIX)          \
   template <typename Comp>                                                     \
     requires CONCEPT<Comp, TYPE##_t>                                           \
@@ -249,6 +285,17 @@ namespace eytzinger {
   DEFINE_SIMD_SPECIALIZATION(int8, 64, IsStandardGreater, greater)
   DEFINE_SIMD_SPECIALIZATION(uint8, 64, IsStandardGreater, greater)
 
+  // Floating-point keys compare as IEEE ordered comparisons do, as the
+  // scalar search does: a NaN needle is ordered before no key and after
+  // no key, so its lower bound is the first slot and its upper bound is
+  // past the last. NaN keys have no place in a sorted block, and -0.0 and
+  // 0.0 are equal.
+  DEFINE_SIMD_SPECIALIZATION(float64, 8, IsStandardLess, less)
+  DEFINE_SIMD_SPECIALIZATION(float64, 8, IsStandardGreater, greater)
+
+  DEFINE_SIMD_SPECIALIZATION(float32, 16, IsStandardLess, less)
+  DEFINE_SIMD_SPECIALIZATION(float32, 16, IsStandardGreater, greater)
+
 #undef DEFINE_SIMD_SPECIALIZATION
 #endif
 
@@ -403,6 +450,61 @@ namespace eytzinger {
     static constexpr inline next_index_fn next_index{};
     static constexpr inline prev_index_fn prev_index{};
 
+    /**
+     * @brief Calls `f(index)` for the elements of sorted ranks
+     * [first_rank, last_rank), in sorted order.
+     *
+     * Most keys live in leaf blocks, whose keys are consecutive in sorted
+     * order and the leaves themselves adjacent in memory. A leaf is visited
+     * as one run while the next one is prefetched, and the tree is only
+     * walked to step between leaves through the keys of their ancestors.
+     */
+    struct for_each_sorted_fn {
+      template <std::contiguous_iterator I, typename F>
+      static constexpr void operator()(I first,
+        std::size_t                      n,
+        std::size_t                      first_rank,
+        std::size_t                      last_rank,
+        F                                f)
+      {
+        assert(first_rank <= last_rank && last_rank <= n);
+        std::size_t remaining = last_rank - first_rank;
+        if (remaining == 0) {
+          return;
+        }
+
+        std::size_t i = sorted_rank_to_index(first_rank, n);
+
+        while (true) {
+          std::size_t block = i / B;
+          std::size_t last  = i;
+
+          if (detail::btree_child_block_index(block, 0, B) * B >= n) {
+            std::size_t next_leaf = (block + 1) * B;
+            if (next_leaf < n) {
+              LAYOUT_PREFETCH(std::to_address(first + next_leaf));
+            }
+
+            last = std::min({next_leaf, n, i + remaining}) - 1;
+            for (std::size_t j = i; j <= last; ++j) {
+              f(j);
+            }
+          } else {
+            f(i);
+          }
+
+          remaining -= last - i + 1;
+          if (remaining == 0) {
+            return;
+          }
+          i = static_cast<std::size_t>(
+            next_index(static_cast<std::ptrdiff_t>(last), n));
+        }
+      }
+    };
+
+    static constexpr inline for_each_sorted_fn for_each_sorted{};
+
     struct permute_fn {
       template <std::random_access_iterator I, std::sentinel_for<I> S>
       static constexpr void operator()(I first, S last)
@@ -429,6 +531,16 @@ namespace eytzinger {
         operator()(std::ranges::begin(range), std::ranges::end(range));
       }
 
+      // Scatters the sorted range on the workers of `executor`.
+      template <vault::algorithm::chunked_executor E,
+        std::ranges::random_access_range          R>
+      static void operator()(const E& executor, R&& range)
+      {
+        detail::parallel_permute<implicit_btree_layout_policy>(executor,
+          std::ranges::begin(range),
+          static_cast<std::size_t>(std::ranges::distance(range)));
+      }
+
     private:
       template <typename SrcIter, typename TempVec>
       static constexpr void fill_in_order(TempVec& temp,
@@ -500,7 +612,7 @@ namespace eytzinger {
         const auto* base = std::to_address(first);
         assert(base != nullptr && "Search base pointer is null");
 
-#ifdef LAYOUT_USE_AVX2
+#ifdef LAYOUT_USE_SIMD
         if constexpr (B == 8 && std::is_same_v<T, uint64_t>
           && IsStandardLess<Comp, T> && std::is_same_v<Proj, std::identity>) {
           std::size_t idx =
@@ -550,7 +662,7 @@ namespace eytzinger {
         const auto* base = std::to_address(first);
         assert(base != nullptr && "Search base pointer is null");
 
-#ifdef LAYOUT_USE_AVX2
+#ifdef LAYOUT_USE_SIMD
         if constexpr (B == 8 && std::is_same_v<T, uint64_t>
           && IsStandardLess<Comp, T> && std::is_same_v<Proj, std::identity>) {
           std::size_t idx =
@@ -587,6 +699,66 @@ namespace eytzinger {
     static constexpr inline lower_bound_fn lower_bound{};
     static constexpr inline upper_bound_fn upper_bound{};
 
+    // Searches string keys through their proxies, which are stored in the
+    // same layout. Each block is searched on its proxies with the 64-bit
+    // block kernels; only the keys whose proxies tie with the needle's are
+    // compared as strings.
+    template <search_bound Bound> struct proxied_bound_fn {
+      template <std::random_access_iterator KeyIter>
+      [[nodiscard]] static std::size_t operator()(const std::uint64_t* proxies,
+        KeyIter                                                       keys,
+        std::size_t                                                   n,
+        std::string_view                                              needle)
+      {
+        assert(proxies != nullptr || n == 0);
+        const std::uint64_t p          = string_proxy(needle);
+        std::size_t         k          = 0;
+        std::size_t         result_idx = n;
+
+        while (k * B < n) {
+          std::size_t block_start = k * B;
+          std::size_t count       = std::min(B, n - block_start);
+
+          std::size_t child_start =
+            detail::btree_child_block_index(k, 0, B) * B;
+          if (child_start < n) {
+            LAYOUT_PREFETCH(&proxies[child_start]);
+          }
+
+          const std::uint64_t* block = proxies + block_start;
+          std::size_t          i     = 0;
+          if (count == B) {
+            i = block_searcher<std::uint64_t, std::less<>, B>::lower_bound(
+              block, p, std::less<>{}, std::identity{});
+          } else {
+            i = scalar_block_searcher::lower_bound_n(
+              block, count, p, std::less<>{}, std::identity{});
+          }
+
+          // Keys whose proxies tie with the needle's are ordered by the
+          // strings themselves.
+          for (; i < count && block[i] == p; ++i) {
+            std::string_view key{keys[block_start + i]};
+            if (Bound == search_bound::upper ? needle < key
+                                             : !(key < needle)) {
+              break;
+            }
+          }
+
+          if (i < count) {
+            result_idx = block_start + i;
+          }
+          k = detail::btree_child_block_index(k, i, B);
+        }
+        return result_idx;
+      }
+    };
+
+    static constexpr inline proxied_bound_fn<search_bound::lower>
+      proxied_lower_bound{};
+    static constexpr inline proxied_bound_fn<search_bound::upper>
+      proxied_upper_bound{};
+
     template <typename HaystackIter,
       typename NeedleIter,
       typename Comp,
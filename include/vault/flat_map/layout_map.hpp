@@ -2,21 +2,28 @@
 #define LAYOUT_MAP_HPP
 
 #include <algorithm>
+#include <bit>
 #include <cassert>
 #include <concepts>
+#include <cstdint>
 #include <initializer_list>
 #include <iterator>
 #include <memory>
 #include <ranges>
 #include <stdexcept>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <vault/algorithm/amac.hpp>
+#include <vault/algorithm/proxy_sort.hpp>
+#include <vault/executor/thread_executor.hpp>
 
 #include "concepts.hpp"
 #include "eytzinger_layout_policy.hpp"
 #include "layout_iterator.hpp"
+#include "utilities.hpp"
 
 namespace std {
   static constexpr inline struct sorted_unique_t {
@@ -25,6 +32,11 @@ namespace std {
 
 namespace eytzinger {
 
+  // Tags key and value containers that are already in the layout of the
+  // policy, as unordered_keys() and unordered_values() return them.
+  static constexpr inline struct layout_ordered_t {
+  } const layout_ordered{};
+
   template <typename K,
     typename V,
     std::strict_weak_order<K, K> Compare = std::less<>,
@@ -64,9 +76,32 @@ namespace eytzinger {
     using reference = std::pair<const key_type&, const mapped_type&>;
 
   private:
-    key_storage_type              keys_;
-    value_storage_type            values_;
-    [[no_unique_address]] Compare compare_;
+    struct no_proxies {};
+
+    // String keys in the standard order are searched through an array of
+    // their string_proxy in layout order, if the policy can.
+    static constexpr inline bool uses_proxies = ProxiedKey<K>
+      && (std::same_as<Compare, std::less<>>
+        || std::same_as<Compare, std::less<K>>
+        || std::same_as<Compare, std::ranges::less>)
+      && ProxiedLayoutPolicy<LayoutPolicy,
+        std::ranges::iterator_t<const key_storage_type>>;
+
+    // String keys in the standard order are sorted by proxy_sort, which
+    // reads every key once instead of on every comparison.
+    static constexpr inline bool sorts_by_proxy = ProxiedKey<K>
+      && !std::is_pointer_v<K>
+      && (std::same_as<Compare, std::less<>>
+        || std::same_as<Compare, std::less<K>>
+        || std::same_as<Compare, std::ranges::less>);
+
+    using proxy_storage_type = std::
+      conditional_t<uses_proxies, std::vector<std::uint64_t>, no_proxies>;
+
+    key_storage_type                         keys_;
+    value_storage_type                       values_;
+    [[no_unique_address]] proxy_storage_type proxies_;
+    [[no_unique_address]] Compare            compare_;
 
   public:
     [[nodiscard]] constexpr allocator_type get_allocator() const noexcept
@@ -74,6 +109,8 @@ namespace eytzinger {
       return allocator_type(keys_.get_allocator());
     }
 
+    [[nodiscard]] constexpr key_compare key_comp() const { return compare_; }
+
     [[nodiscard]] constexpr layout_map()
         : layout_map(Compare(), Allocator())
     {}
@@ -98,6 +135,7 @@ namespace eytzinger {
       const layout_map& other, const Allocator& alloc)
         : keys_(other.keys_, key_allocator_type(alloc))
         , values_(other.values_, value_allocator_type(alloc))
+        , proxies_(other.proxies_)
         , compare_(other.compare_)
     {
       assert(
@@ -108,6 +146,7 @@ namespace eytzinger {
       layout_map&& other, const Allocator& alloc)
         : keys_(std::move(other.keys_), key_allocator_type(alloc))
         , values_(std::move(other.values_), value_allocator_type(alloc))
+        , proxies_(std::move(other.proxies_))
         , compare_(std::move(other.compare_))
     {
       assert(
@@ -130,6 +169,34 @@ namespace eytzinger {
       assert(keys_.size() == values_.size());
       sort_and_unique_zipped();
       policy_type::permute(std::views::zip(keys_, values_));
+      build_proxies();
+      assert(keys_.size() == values_.size());
+    }
+
+    /**
+     * @brief Builds the map from [first, last) like the constructor above,
+     * but sorts the entries and moves them into the layout on the workers
+     * of `executor`.
+     */
+    template <vault::algorithm::chunked_executor Executor,
+      std::input_iterator                        It>
+    [[nodiscard]] layout_map(const Executor& executor,
+      It                                     first,
+      It                                     last,
+      const Compare&                         comp  = Compare(),
+      const Allocator&                       alloc = Allocator())
+        : keys_(key_allocator_type(alloc))
+        , values_(value_allocator_type(alloc))
+        , compare_(comp)
+    {
+      for (; first != last; ++first) {
+        keys_.push_back(first->first);
+        values_.push_back(first->second);
+      }
+      assert(keys_.size() == values_.size());
+      sort_and_unique_zipped(executor);
+      policy_type::permute(executor, std::views::zip(keys_, values_));
+      build_proxies();
       assert(keys_.size() == values_.size());
     }
 
@@ -165,6 +232,7 @@ namespace eytzinger {
       }
       assert(keys_.size() == values_.size());
       policy_type::permute(std::views::zip(keys_, values_));
+      build_proxies();
     }
 
     template <std::ranges::forward_range R>
@@ -188,6 +256,32 @@ namespace eytzinger {
       }
       sort_and_unique_zipped();
       policy_type::permute(std::views::zip(keys_, values_));
+      build_proxies();
+      assert(keys_.size() == values_.size());
+    }
+
+    /**
+     * @brief Builds the map from parallel key and value containers like
+     * the constructor above, on the workers of `executor`.
+     */
+    template <vault::algorithm::chunked_executor Executor>
+    [[nodiscard]] layout_map(const Executor& executor,
+      std::in_place_t,
+      key_storage_type&&   k_cont,
+      value_storage_type&& v_cont,
+      const Compare&       comp  = Compare(),
+      const Allocator&     alloc = Allocator())
+        : keys_(std::move(k_cont), key_allocator_type(alloc))
+        , values_(std::move(v_cont), value_allocator_type(alloc))
+        , compare_(comp)
+    {
+      if (keys_.size() != values_.size()) {
+        throw std::invalid_argument(
+          "layout_map: key and value containers must have same size");
+      }
+      sort_and_unique_zipped(executor);
+      policy_type::permute(executor, std::views::zip(keys_, values_));
+      build_proxies();
       assert(keys_.size() == values_.size());
     }
 
@@ -202,6 +296,29 @@ namespace eytzinger {
             alloc)
     {}
 
+    /**
+     * @brief Adopts key and value containers that are already in the
+     * layout of the policy, without sorting or permuting them.
+     *
+     * This is how a map is rebuilt from the unordered_keys() and
+     * unordered_values() of another one, for example from a file, see
+     * layout_map_file.hpp.
+     */
+    [[nodiscard]] constexpr layout_map(layout_ordered_t,
+      key_storage_type&&   k_cont,
+      value_storage_type&& v_cont,
+      const Compare&       comp = Compare())
+        : keys_(std::move(k_cont))
+        , values_(std::move(v_cont))
+        , compare_(comp)
+    {
+      if (keys_.size() != values_.size()) {
+        throw std::invalid_argument(
+          "layout_map: key and value containers must have same size");
+      }
+      build_proxies();
+    }
+
     constexpr layout_map& operator=(const layout_map&)     = default;
     constexpr layout_map& operator=(layout_map&&) noexcept = default;
 
@@ -280,12 +397,19 @@ namespace eytzinger {
       if (keys_.empty()) {
         return end();
       }
-      auto kit = policy_type::lower_bound(keys_, key, compare_);
-      if (kit == keys_.end()) {
-        return end();
+      if constexpr (uses_proxies
+        && std::convertible_to<const K0&, std::string_view>) {
+        auto idx = policy_type::proxied_lower_bound(
+          proxies_.data(), keys_.begin(), keys_.size(), std::string_view{key});
+        return const_iterator(*this, static_cast<std::ptrdiff_t>(idx));
+      } else {
+        auto kit = policy_type::lower_bound(keys_, key, compare_);
+        if (kit == keys_.end()) {
+          return end();
+        }
+        auto idx = std::distance(keys_.begin(), kit);
+        return const_iterator(*this, static_cast<std::ptrdiff_t>(idx));
       }
-      auto idx = std::distance(keys_.begin(), kit);
-      return const_iterator(*this, static_cast<std::ptrdiff_t>(idx));
     }
 
     template <typename K0 = key_type>
@@ -295,12 +419,19 @@ namespace eytzinger {
       if (keys_.empty()) {
         return end();
       }
-      auto kit = policy_type::upper_bound(keys_, key, compare_);
-      if (kit == keys_.end()) {
-        return end();
+      if constexpr (uses_proxies
+        && std::convertible_to<const K0&, std::string_view>) {
+        auto idx = policy_type::proxied_upper_bound(
+          proxies_.data(), keys_.begin(), keys_.size(), std::string_view{key});
+        return const_iterator(*this, static_cast<std::ptrdiff_t>(idx));
+      } else {
+        auto kit = policy_type::upper_bound(keys_, key, compare_);
+        if (kit == keys_.end()) {
+          return end();
+        }
+        auto idx = std::distance(keys_.begin(), kit);
+        return const_iterator(*this, static_cast<std::ptrdiff_t>(idx));
       }
-      auto idx = std::distance(keys_.begin(), kit);
-      return const_iterator(*this, static_cast<std::ptrdiff_t>(idx));
     }
 
     template <typename K0 = key_type>
@@ -439,6 +570,93 @@ namespace eytzinger {
       executor(std::views::transform(needle_cursors, job_factory), reporter);
     }
 
+    // --- Sorted Batch Interface ---
+
+    /**
+     * @brief Lower bounds of needles sorted by key_compare.
+     *
+     * Writes the same pairs as batch_lower_bound, in needle order. The
+     * lower bound of a needle is never before that of the previous one, so
+     * each search first walks a few keys on from the previous result in
+     * sorted order, and searches from the root only when that falls short.
+     * When there are so many needles that a walk over the whole map costs
+     * no more than a search per needle, the needles are merged with the
+     * keys in a single in-order pass instead.
+     */
+    template <std::ranges::forward_range Needles, typename OutputIt>
+      requires std::output_iterator<OutputIt,
+        std::pair<std::ranges::iterator_t<std::remove_reference_t<Needles>>,
+          const_iterator>>
+    void lower_bound_sorted(Needles&& needles, OutputIt output) const
+    {
+      assert(std::ranges::is_sorted(needles, compare_)
+        && "Needles must be sorted by key_compare");
+
+      constexpr std::size_t finger_steps = 4;
+
+      const auto n = static_cast<std::ptrdiff_t>(keys_.size());
+      const auto m = static_cast<std::size_t>(std::ranges::distance(needles));
+
+      const bool merge =
+        m * static_cast<std::size_t>(std::bit_width(keys_.size()))
+        >= keys_.size();
+
+      // The index of the lower bound of the previous needle, n for end().
+      std::ptrdiff_t idx = n == 0
+        ? n
+        : static_cast<std::ptrdiff_t>(
+            policy_type::sorted_rank_to_index(0, keys_.size()));
+
+      for (auto it = std::ranges::begin(needles);
+        it != std::ranges::end(needles);
+        ++it) {
+        for (std::size_t steps = 0;
+          idx != n && compare_(keys_[idx], *it);
+          ++steps) {
+          if (!merge && steps == finger_steps) {
+            idx = lower_bound(*it).get_index();
+            break;
+          }
+          idx = policy_type::next_index(idx, keys_.size());
+        }
+
+        *output++ = std::pair{it, const_iterator{*this, idx}};
+      }
+    }
+
+    // --- Range Scans ---
+
+    /**
+     * @brief Calls `f(key, value)` for every key in [lo, hi), in sorted
+     * order.
+     *
+     * Unlike iterating from lower_bound(lo), the layout policy walks the
+     * range in the order that suits its layout, visiting whole blocks or
+     * prefetching ahead where it can.
+     */
+    template <typename K0 = key_type, typename F>
+      requires std::invocable<F&, const key_type&, const mapped_type&>
+    constexpr void for_each_in_range(const K0& lo, const K0& hi, F f) const
+    {
+      const auto first = rank_of(lower_bound(lo));
+      const auto last  = rank_of(lower_bound(hi));
+      if (first < last) {
+        for_each_rank(first, last, f);
+      }
+    }
+
+    /**
+     * @brief Writes every element to `out` in sorted order, as value_type.
+     */
+    template <std::output_iterator<value_type> O>
+    constexpr O copy_sorted(O out) const
+    {
+      for_each_rank(0, size(), [&](const key_type& k, const mapped_type& v) {
+        *out++ = value_type{k, v};
+      });
+      return out;
+    }
+
     [[nodiscard]] constexpr size_type size() const noexcept
     {
       assert(keys_.size() == values_.size());
@@ -501,13 +719,67 @@ namespace eytzinger {
     }
 
   private:
+    [[nodiscard]] constexpr std::size_t rank_of(const_iterator it) const
+    {
+      const auto idx = static_cast<std::size_t>(it.get_index());
+      return idx == size() ? size()
+                           : policy_type::index_to_sorted_rank(idx, size());
+    }
+
+    template <typename F>
+    constexpr void for_each_rank(
+      std::size_t first_rank, std::size_t last_rank, F&& f) const
+    {
+      if constexpr (ScanningLayoutPolicy<policy_type,
+                      std::ranges::iterator_t<const key_storage_type>>) {
+        policy_type::for_each_sorted(keys_.begin(),
+          keys_.size(),
+          first_rank,
+          last_rank,
+          [&](std::size_t i) { f(keys_[i], values_[i]); });
+      } else {
+        auto i = static_cast<std::ptrdiff_t>(
+          policy_type::sorted_rank_to_index(first_rank, keys_.size()));
+        for (std::size_t rank = first_rank; rank < last_rank; ++rank) {
+          f(keys_[i], values_[i]);
+          i = policy_type::next_index(i, keys_.size());
+        }
+      }
+    }
+
+  private:
+    constexpr void build_proxies()
+    {
+      if constexpr (uses_proxies) {
+        proxies_.resize(keys_.size());
+        std::ranges::transform(keys_, proxies_.begin(),
+          [](const key_type& key) { return string_proxy(key); });
+      }
+    }
+
     constexpr void sort_and_unique_zipped()
+    {
+      sort_and_unique_zipped(vault::algorithm::inline_executor{});
+    }
+
+    template <vault::algorithm::chunked_executor Executor>
+    constexpr void sort_and_unique_zipped(const Executor& executor)
     {
       assert(keys_.size() == values_.size());
       auto z = std::views::zip(keys_, values_);
-      std::ranges::sort(z, [this](const auto& a, const auto& b) {
+      auto comp = [this](const auto& a, const auto& b) {
         return compare_(std::get<0>(a), std::get<0>(b));
-      });
+      };
+      if constexpr (sorts_by_proxy) {
+        detail::parallel_sort(
+          executor, z.begin(), z.size(), comp, [](auto lo, auto hi) {
+            vault::algorithm::proxy_sort(lo, hi, [](const auto& kv) -> const K& {
+              return std::get<0>(kv);
+            });
+          });
+      } else {
+        detail::parallel_sort(executor, z.begin(), z.size(), comp);
+      }
       auto [first_erase, _] =
         std::ranges::unique(z, [this](const auto& a, const auto& b) {
           const auto& k1 = std::get<0>(a);
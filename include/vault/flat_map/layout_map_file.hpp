@@ -0,0 +1,210 @@
+#ifndef LAYOUT_MAP_FILE_HPP
+#define LAYOUT_MAP_FILE_HPP
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include <vault/frozen_vector/frozen_vector.hpp>
+
+#include "eytzinger_layout_policy.hpp"
+#include "implicit_btree_layout_policy.hpp"
+#include "layout_map.hpp"
+#include "sorted_layout_policy.hpp"
+
+namespace eytzinger {
+
+  /**
+   * @brief Keys and values that can be written to a file as bytes and
+   * used in place when mapped back: trivially copyable, and not pointing
+   * into memory of the process that wrote them.
+   */
+  template <typename T>
+  concept MappableType = std::is_trivially_copyable_v<T>
+    && !std::is_pointer_v<T> && !ProxiedKey<T>;
+
+  /**
+   * @brief Storage of a layout_map over a mapped file, which ignores the
+   * allocator.
+   */
+  template <typename T, typename>
+  using mapped_vector = frozen::frozen_vector<T>;
+
+  /**
+   * @brief A layout_map whose keys and values stay in a mapped file, see
+   * open_mapped_layout_map.
+   */
+  template <typename K,
+    typename V,
+    typename Compare      = std::less<>,
+    typename LayoutPolicy = eytzinger_layout_policy<6>>
+  using mapped_layout_map = layout_map<K,
+    V,
+    Compare,
+    LayoutPolicy,
+    std::allocator<std::pair<const K, V>>,
+    mapped_vector,
+    mapped_vector>;
+
+  namespace detail {
+
+    static_assert(std::endian::native == std::endian::little,
+      "The layout_map file format is little-endian.");
+
+    // The policy of a file, as a kind and its template parameter.
+    template <typename Policy> struct layout_policy_tag;
+
+    template <std::size_t Arity>
+    struct layout_policy_tag<sorted_layout_policy<Arity>> {
+      static constexpr std::uint32_t kind      = 1;
+      static constexpr std::uint64_t parameter = Arity;
+    };
+
+    template <std::size_t L>
+    struct layout_policy_tag<eytzinger_layout_policy<L>> {
+      static constexpr std::uint32_t kind      = 2;
+      static constexpr std::uint64_t parameter = L;
+    };
+
+    template <std::size_t B>
+    struct layout_policy_tag<implicit_btree_layout_policy<B>> {
+      static constexpr std::uint32_t kind      = 3;
+      static constexpr std::uint64_t parameter = B;
+    };
+
+    // The key or value type of a file. Only the size, the alignment and
+    // the kind of arithmetic type can be told apart.
+    template <typename T>
+    constexpr auto mapped_type_tag = static_cast<std::uint32_t>(sizeof(T)
+      | (std::countr_zero(alignof(T)) << 20)
+      | (std::uint32_t{std::is_signed_v<T>} << 28)
+      | (std::uint32_t{std::is_floating_point_v<T>} << 29));
+
+    struct layout_file_header {
+      std::array<char, 8> magic   = {'V', 'A', 'U', 'L', 'T', 'L', 'M', 'F'};
+      std::uint32_t       version = 1;
+
+      // The layout_policy_tag of the policy.
+      std::uint32_t policy_kind      = 0;
+      std::uint64_t policy_parameter = 0;
+
+      std::uint32_t key_type   = 0;
+      std::uint32_t value_type = 0;
+
+      std::uint64_t size            = 0;
+      std::uint64_t keys_position   = 0;
+      std::uint64_t values_position = 0;
+
+      std::array<std::byte, 8> reserved{};
+    };
+
+    static_assert(sizeof(layout_file_header) == 64);
+
+    // Writes `header` and the key and value arrays, each page-aligned so
+    // that it can be used in place, to `path`.
+    void write_layout_file(const std::filesystem::path& path,
+      layout_file_header                                header,
+      std::span<const std::byte>                        keys,
+      std::span<const std::byte>                        values);
+
+    struct mapped_layout_file {
+      std::shared_ptr<const unsigned char> data;
+      layout_file_header                   header;
+    };
+
+    // Maps `path` read-only, and checks that it holds a map of `expected`
+    // policy and types, with both arrays within the file.
+    [[nodiscard]] mapped_layout_file map_layout_file(
+      const std::filesystem::path& path, const layout_file_header& expected);
+
+  } // namespace detail
+
+  /**
+   * @brief Writes the keys and values of `map`, in the layout of its
+   * policy, to `path`.
+   *
+   * The file records the policy and its parameter, and the size and
+   * alignment of the key and value types. open_mapped_layout_map checks
+   * them, but not the comparator, which must match as well.
+   */
+  template <typename Map>
+    requires MappableType<typename Map::key_type>
+    && MappableType<typename Map::mapped_type>
+    && std::ranges::contiguous_range<const typename Map::key_storage_type>
+    && std::ranges::contiguous_range<const typename Map::value_storage_type>
+  void save_layout_map(const std::filesystem::path& path, const Map& map)
+  {
+    using tag = detail::layout_policy_tag<typename Map::policy_type>;
+
+    detail::layout_file_header header;
+    header.policy_kind      = tag::kind;
+    header.policy_parameter = tag::parameter;
+    header.key_type   = detail::mapped_type_tag<typename Map::key_type>;
+    header.value_type = detail::mapped_type_tag<typename Map::mapped_type>;
+    header.size       = map.size();
+
+    detail::write_layout_file(path,
+      header,
+      std::as_bytes(std::span(map.unordered_keys())),
+      std::as_bytes(std::span(map.unordered_values())));
+  }
+
+  /**
+   * @brief Opens a file written by save_layout_map from a map of type
+   * `Map` as a map over the file mapped in place.
+   *
+   * Nothing is copied or permuted, so opening costs the same for any size,
+   * and processes that open the same file share its pages in the page
+   * cache. The mapping lives as long as the returned map or any copy of
+   * it.
+   *
+   * Throws std::system_error if the file cannot be mapped, and
+   * std::runtime_error if it is not a map of the policy and types of
+   * `Map`.
+   */
+  template <typename Map>
+    requires MappableType<typename Map::key_type>
+    && MappableType<typename Map::mapped_type>
+  [[nodiscard]] mapped_layout_map<typename Map::key_type,
+    typename Map::mapped_type,
+    typename Map::key_compare,
+    typename Map::policy_type>
+  open_mapped_layout_map(const std::filesystem::path& path,
+    const typename Map::key_compare& comp = typename Map::key_compare())
+  {
+    using K   = typename Map::key_type;
+    using V   = typename Map::mapped_type;
+    using tag = detail::layout_policy_tag<typename Map::policy_type>;
+
+    detail::layout_file_header expected;
+    expected.policy_kind      = tag::kind;
+    expected.policy_parameter = tag::parameter;
+    expected.key_type         = detail::mapped_type_tag<K>;
+    expected.value_type       = detail::mapped_type_tag<V>;
+
+    auto mapping = detail::map_layout_file(path, expected);
+    auto size    = static_cast<std::size_t>(mapping.header.size);
+
+    // Views into the mapping that share its ownership.
+    auto keys = std::shared_ptr<const K[]>(mapping.data,
+      reinterpret_cast<const K*>(
+        mapping.data.get() + mapping.header.keys_position));
+    auto values = std::shared_ptr<const V[]>(mapping.data,
+      reinterpret_cast<const V*>(
+        mapping.data.get() + mapping.header.values_position));
+
+    return {layout_ordered,
+      frozen::frozen_vector<K>(std::move(keys), size),
+      frozen::frozen_vector<V>(std::move(values), size),
+      comp};
+  }
+
+} // namespace eytzinger
+
+#endif // LAYOUT_MAP_FILE_HPP
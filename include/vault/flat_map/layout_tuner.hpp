@@ -0,0 +1,228 @@
+#ifndef LAYOUT_TUNER_HPP
+#define LAYOUT_TUNER_HPP
+
+#include "aliases.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <vault/algorithm/amac.hpp>
+
+namespace eytzinger {
+
+  enum class layout_kind : std::uint8_t { sorted, eytzinger, btree };
+
+  [[nodiscard]] constexpr std::string_view to_string(layout_kind kind) noexcept
+  {
+    switch (kind) {
+    case layout_kind::sorted:
+      return "sorted";
+    case layout_kind::eytzinger:
+      return "eytzinger";
+    case layout_kind::btree:
+      return "btree";
+    }
+    return "unknown";
+  }
+
+  /**
+   * @brief A layout configuration and its measured lookup cost.
+   */
+  struct layout_config {
+    layout_kind layout = layout_kind::btree;
+
+    // B of implicit_btree_layout_policy, 0 for other layouts.
+    std::size_t block_size = 0;
+
+    // L of eytzinger_layout_policy, 0 for other layouts.
+    std::size_t prefetch_distance = 0;
+
+    // The fanout of the AMAC coordinator for batch_find, 0 for one find
+    // per key.
+    std::size_t amac_fanout = 0;
+
+    double ns_per_lookup = std::numeric_limits<double>::infinity();
+  };
+
+  /**
+   * @brief Writes `config` as one line of `key=value` fields.
+   */
+  inline std::ostream& operator<<(std::ostream& os, const layout_config& config)
+  {
+    return os << "layout=" << to_string(config.layout)
+              << " block_size=" << config.block_size
+              << " prefetch_distance=" << config.prefetch_distance
+              << " amac_fanout=" << config.amac_fanout
+              << " ns_per_lookup=" << config.ns_per_lookup;
+  }
+
+  struct layout_tuning_options {
+    // Lookups per measurement, of keys drawn at random from the map.
+    std::size_t needles = std::size_t{1} << 14;
+
+    // Measurements per configuration, of which the fastest counts.
+    std::size_t repetitions = 5;
+
+    std::uint64_t seed = 42;
+  };
+
+  namespace detail {
+
+    // The candidates of every tunable parameter.
+    using tuned_prefetch_distances =
+      std::index_sequence<2, 3, 4, 5, 6, 7, 8>;
+    using tuned_block_sizes = std::index_sequence<8, 16, 32, 64>;
+    using tuned_amac_fanouts =
+      std::integer_sequence<std::uint8_t, 4, 8, 16, 32>;
+
+    // The fastest of `repetitions` runs of `lookup`, in ns per needle.
+    template <typename F>
+    [[nodiscard]] double time_lookups(
+      std::size_t needles, std::size_t repetitions, F&& lookup)
+    {
+      using clock = std::chrono::steady_clock;
+
+      // A first run warms the caches and the branch predictors.
+      lookup();
+
+      double best = std::numeric_limits<double>::infinity();
+      for (std::size_t r = 0; r < repetitions; ++r) {
+        auto start = clock::now();
+        lookup();
+        std::chrono::duration<double, std::nano> elapsed =
+          clock::now() - start;
+        best = std::min(best, elapsed.count() / static_cast<double>(needles));
+      }
+      return best;
+    }
+
+    // Measures `Policy` with one find per key and with batch_find at every
+    // AMAC fanout, and appends the results to `out`.
+    template <typename Policy,
+      typename K,
+      typename Compare,
+      std::uint8_t... Fanouts>
+    void tune_policy(layout_config base,
+      const std::vector<std::pair<K, int>>&          items,
+      const std::vector<K>&                          needles,
+      const layout_tuning_options&                   options,
+      std::vector<layout_config>&                    out,
+      std::integer_sequence<std::uint8_t, Fanouts...>)
+    {
+      using map_type = layout_map<K, int, Compare, Policy>;
+
+      const map_type map(items.begin(), items.end());
+
+      using result_type = std::pair<typename std::vector<K>::const_iterator,
+        typename map_type::const_iterator>;
+      std::vector<result_type> results;
+      results.reserve(needles.size());
+
+      std::size_t hits = 0;
+
+      base.amac_fanout   = 0;
+      base.ns_per_lookup = time_lookups(
+        needles.size(), options.repetitions, [&] {
+          for (const auto& needle : needles) {
+            hits += map.find(needle) != map.end() ? 1 : 0;
+          }
+        });
+      out.push_back(base);
+
+      auto tune_fanout = [&]<std::uint8_t F>(
+                           std::integral_constant<std::uint8_t, F>) {
+        base.amac_fanout   = F;
+        base.ns_per_lookup = time_lookups(
+          needles.size(), options.repetitions, [&] {
+            results.clear();
+            map.batch_find(vault::amac::coordinator<F>,
+              needles,
+              std::back_inserter(results));
+            hits += results.size();
+          });
+        out.push_back(base);
+      };
+      (tune_fanout(std::integral_constant<std::uint8_t, Fanouts>{}), ...);
+
+      // Keeps the lookups from being optimized away.
+      [[maybe_unused]] volatile std::size_t sink = hits;
+    }
+
+  } // namespace detail
+
+  /**
+   * @brief Measures the lookup cost of every layout configuration for maps
+   * of `keys` on this machine.
+   *
+   * Tries sorted_layout_policy, eytzinger_layout_policy with prefetch
+   * distances 2 to 8, and implicit_btree_layout_policy with blocks of 8 to
+   * 64 keys. Each is timed with one find per key, and with batch_find at
+   * AMAC fanouts of 4 to 32. Results are ordered from fastest to slowest,
+   * so the first is the configuration to use.
+   *
+   * The defaults of aliases.hpp are derived from sizeof(K) alone. The best
+   * configuration also depends on the size of the map against the caches
+   * and on the memory latency of the host, so measuring on the target
+   * machine, at the size of the production map, can pick a better one.
+   */
+  template <typename K, typename Compare = std::less<>>
+  [[nodiscard]] std::vector<layout_config> tune_layout(
+    std::span<const K> keys, const layout_tuning_options& options = {})
+  {
+    std::vector<layout_config> results;
+    if (keys.empty() || options.needles == 0) {
+      return results;
+    }
+
+    std::vector<std::pair<K, int>> items;
+    items.reserve(keys.size());
+    for (const auto& key : keys) {
+      items.emplace_back(key, 0);
+    }
+
+    std::mt19937_64                            rng(options.seed);
+    std::uniform_int_distribution<std::size_t> pick(0, keys.size() - 1);
+    std::vector<K>                             needles;
+    needles.reserve(options.needles);
+    for (std::size_t i = 0; i < options.needles; ++i) {
+      needles.push_back(keys[pick(rng)]);
+    }
+
+    const detail::tuned_amac_fanouts fanouts;
+
+    detail::tune_policy<sorted_layout_policy<2>, K, Compare>(
+      {.layout = layout_kind::sorted}, items, needles, options, results,
+      fanouts);
+
+    [&]<std::size_t... L>(std::index_sequence<L...>) {
+      (detail::tune_policy<eytzinger_layout_policy<L>, K, Compare>(
+         {.layout = layout_kind::eytzinger, .prefetch_distance = L},
+         items, needles, options, results, fanouts),
+        ...);
+    }(detail::tuned_prefetch_distances{});
+
+    [&]<std::size_t... B>(std::index_sequence<B...>) {
+      (detail::tune_policy<implicit_btree_layout_policy<B>, K, Compare>(
+         {.layout = layout_kind::btree, .block_size = B},
+         items, needles, options, results, fanouts),
+        ...);
+    }(detail::tuned_block_sizes{});
+
+    std::ranges::stable_sort(results, {}, &layout_config::ns_per_lookup);
+    return results;
+  }
+
+} // namespace eytzinger
+
+#endif // LAYOUT_TUNER_HPP
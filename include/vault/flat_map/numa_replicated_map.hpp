@@ -0,0 +1,131 @@
+#ifndef NUMA_REPLICATED_MAP_HPP
+#define NUMA_REPLICATED_MAP_HPP
+
+#include "aliases.hpp"
+
+#include <cassert>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <vault/allocators/hpallocator.hpp>
+
+namespace eytzinger {
+
+  namespace detail {
+    // The number of NUMA nodes of the host, 1 where it cannot be told.
+    [[nodiscard]] std::size_t numa_node_count() noexcept;
+
+    // The NUMA node of the CPU the calling thread runs on.
+    [[nodiscard]] std::size_t numa_current_node() noexcept;
+
+    // Restricts the calling thread to the CPUs of `node`. Returns whether
+    // it could.
+    bool numa_bind_current_thread(std::size_t node) noexcept;
+  } // namespace detail
+
+  /**
+   * @brief A frozen map with one copy per NUMA node.
+   *
+   * On a host with several sockets, a lookup in memory of another node
+   * costs a remote access at every level of the search. This keeps a
+   * replica of the map on every node and hands each thread the replica of
+   * the node it runs on.
+   *
+   * Every replica is copied by a thread bound to the CPUs of its node, so
+   * the pages of the copy are first touched, and placed, there. With
+   * hpallocator as the allocator of the map, large arrays also go to huge
+   * pages, see numa_btree_map.
+   *
+   * Finding the node of the calling thread costs about as much as a
+   * lookup in a small map, so callers should fetch local() once for a
+   * batch of lookups. A thread that migrates meanwhile still gets correct
+   * results, only from a remote replica.
+   */
+  template <typename Map> class numa_replicated_map {
+  public:
+    using map_type  = Map;
+    using size_type = std::size_t;
+
+  private:
+    std::vector<std::unique_ptr<const Map>> replicas_;
+
+  public:
+    /**
+     * @brief Replicates `map` on every NUMA node of the host.
+     *
+     * On a host of one node, `map` itself is kept.
+     */
+    [[nodiscard]] explicit numa_replicated_map(Map map)
+    {
+      const std::size_t nodes = detail::numa_node_count();
+
+      if (nodes <= 1) {
+        replicas_.push_back(std::make_unique<const Map>(std::move(map)));
+        return;
+      }
+
+      replicas_.resize(nodes);
+
+      std::vector<std::exception_ptr> errors(nodes);
+      std::vector<std::jthread>       threads;
+      threads.reserve(nodes);
+
+      for (std::size_t node = 0; node < nodes; ++node) {
+        threads.emplace_back([&, node] {
+          try {
+            detail::numa_bind_current_thread(node);
+            replicas_[node] = std::make_unique<const Map>(std::as_const(map));
+          } catch (...) {
+            errors[node] = std::current_exception();
+          }
+        });
+      }
+      threads.clear();
+
+      for (const auto& error : errors) {
+        if (error) {
+          std::rethrow_exception(error);
+        }
+      }
+    }
+
+    /**
+     * @brief The replica on the NUMA node of the calling thread.
+     */
+    [[nodiscard]] const Map& local() const noexcept
+    {
+      return replica(detail::numa_current_node() % replicas_.size());
+    }
+
+    /**
+     * @brief The replica on NUMA node `node`.
+     */
+    [[nodiscard]] const Map& replica(size_type node) const noexcept
+    {
+      assert(node < replicas_.size() && "NUMA node out of range");
+      return *replicas_[node];
+    }
+
+    [[nodiscard]] size_type replica_count() const noexcept
+    {
+      return replicas_.size();
+    }
+  };
+
+  /**
+   * @brief A btree_map replicated on every NUMA node, in huge pages.
+   */
+  template <typename K, typename V, typename Compare = std::less<>>
+  using numa_btree_map = numa_replicated_map<btree_map<K,
+    V,
+    Compare,
+    static_data::hpallocator<std::pair<const K, V>>>>;
+
+} // namespace eytzinger
+
+#endif // NUMA_REPLICATED_MAP_HPP
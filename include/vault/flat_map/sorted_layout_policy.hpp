@@ -97,6 +97,21 @@ namespace eytzinger {
       }
     };
 
+    struct for_each_sorted_fn {
+      template <std::random_access_iterator I, typename F>
+      static constexpr void operator()(I,
+        std::size_t n,
+        std::size_t first_rank,
+        std::size_t last_rank,
+        F           f)
+      {
+        assert(first_rank <= last_rank && last_rank <= n);
+        for (std::size_t i = first_rank; i < last_rank; ++i) {
+          f(i);
+        }
+      }
+    };
+
     struct prev_index_fn {
       [[nodiscard]] static constexpr std::ptrdiff_t operator()(
         std::ptrdiff_t i, std::size_t n_sz) noexcept
@@ -160,12 +175,13 @@ namespace eytzinger {
       }
     };
 
-    static constexpr inline permute_fn        permute{};
-    static constexpr inline get_nth_sorted_fn get_nth_sorted{};
-    static constexpr inline next_index_fn     next_index{};
-    static constexpr inline prev_index_fn     prev_index{};
-    static constexpr inline lower_bound_fn    lower_bound{};
-    static constexpr inline upper_bound_fn    upper_bound{};
+    static constexpr inline permute_fn         permute{};
+    static constexpr inline get_nth_sorted_fn  get_nth_sorted{};
+    static constexpr inline next_index_fn      next_index{};
+    static constexpr inline prev_index_fn      prev_index{};
+    static constexpr inline for_each_sorted_fn for_each_sorted{};
+    static constexpr inline lower_bound_fn     lower_bound{};
+    static constexpr inline upper_bound_fn     upper_bound{};
 
     // --- Batch Support ---
 
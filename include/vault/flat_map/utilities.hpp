@@ -1,8 +1,18 @@
 #ifndef UTILITIES_HPP
 #define UTILITIES_HPP
 
+#include <algorithm>
+#include <bit>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+#include <vault/executor/thread_executor.hpp>
 
 namespace eytzinger {
 
@@ -28,6 +38,33 @@ namespace eytzinger {
     [[nodiscard]] constexpr operator I() const noexcept { return index_; }
   };
 
+  /**
+   * @brief The first 8 bytes of a string as a big-endian integer, padded
+   * with zero bytes.
+   *
+   * Proxies order like the strings they come from. Two strings whose
+   * proxies are equal may still differ, and only then must the strings
+   * themselves be compared.
+   */
+  [[nodiscard]] inline std::uint64_t string_proxy(std::string_view s) noexcept
+  {
+    std::uint64_t buffer   = 0;
+    std::size_t   copy_len = std::min(s.size(), sizeof(buffer));
+    if (copy_len > 0) {
+      std::memcpy(&buffer, s.data(), copy_len);
+    }
+    if constexpr (std::endian::native == std::endian::little) {
+      return std::byteswap(buffer);
+    }
+    return buffer;
+  }
+
+  /**
+   * @brief Keys that a layout can search through their string_proxy.
+   */
+  template <typename K>
+  concept ProxiedKey = std::convertible_to<const K&, std::string_view>;
+
   template <typename T> struct layout_policy {
     using type = typename T::policy_type;
   };
@@ -36,4 +73,115 @@ namespace eytzinger {
 
 } // namespace eytzinger
 
+namespace eytzinger::detail {
+
+  // Ranges of sorted ranks shorter than this are not split across workers.
+  inline constexpr std::size_t parallel_build_grain = std::size_t{1} << 16;
+
+  /**
+   * @brief Sorts [first, first + n) on the workers of `executor`.
+   *
+   * Each worker sorts one slice with `slice_sort(slice_first, slice_last)`,
+   * which must order like `comp`, and the slices are then merged pairwise
+   * with `comp`, with the merges of each round running in parallel.
+   */
+  template <vault::algorithm::chunked_executor E,
+    std::random_access_iterator              I,
+    typename Comp,
+    typename SliceSort>
+  void parallel_sort(
+    const E& executor, I first, std::size_t n, Comp comp, SliceSort slice_sort)
+  {
+    const std::size_t slices = std::min(executor.concurrency(),
+      std::max(std::size_t{1}, n / parallel_build_grain));
+
+    if (slices <= 1) {
+      slice_sort(first, first + static_cast<std::ptrdiff_t>(n));
+      return;
+    }
+
+    auto bound = [&](std::size_t slice) {
+      return first + static_cast<std::ptrdiff_t>(n * slice / slices);
+    };
+
+    executor(slices, 1, [&](std::size_t, std::size_t lo, std::size_t hi) {
+      for (std::size_t slice = lo; slice < hi; ++slice) {
+        slice_sort(bound(slice), bound(slice + 1));
+      }
+    });
+
+    for (std::size_t width = 1; width < slices; width *= 2) {
+      const std::size_t merges = (slices + (2 * width) - 1) / (2 * width);
+      executor(merges, 1, [&](std::size_t, std::size_t lo, std::size_t hi) {
+        for (std::size_t merge = lo; merge < hi; ++merge) {
+          const std::size_t left  = merge * 2 * width;
+          const std::size_t mid   = std::min(left + width, slices);
+          const std::size_t right = std::min(left + (2 * width), slices);
+          if (mid < right) {
+            std::ranges::inplace_merge(
+              bound(left), bound(mid), bound(right), comp);
+          }
+        }
+      });
+    }
+  }
+
+  /**
+   * @brief Sorts [first, first + n) on the workers of `executor`, with
+   * every slice sorted by `comp`.
+   */
+  template <vault::algorithm::chunked_executor E,
+    std::random_access_iterator              I,
+    typename Comp>
+  void parallel_sort(const E& executor, I first, std::size_t n, Comp comp)
+  {
+    parallel_sort(executor, first, n, comp, [&comp](I lo, I hi) {
+      std::ranges::sort(lo, hi, comp);
+    });
+  }
+
+  /**
+   * @brief Moves the sorted range [first, first + n) into the layout of
+   * Policy on the workers of `executor`.
+   *
+   * The layout index of a sorted rank is known without the others, so
+   * workers scatter disjoint ranges of ranks independently. Each finds the
+   * index of its first rank once and walks on in sorted order.
+   */
+  template <typename Policy,
+    vault::algorithm::chunked_executor E,
+    std::random_access_iterator        I>
+  void parallel_permute(const E& executor, I first, std::size_t n)
+  {
+    if (n <= 1) {
+      return;
+    }
+
+    std::vector<std::iter_value_t<I>> temp(n);
+
+    executor(n,
+      parallel_build_grain,
+      [&](std::size_t, std::size_t lo, std::size_t hi) {
+        auto idx =
+          static_cast<std::ptrdiff_t>(Policy::sorted_rank_to_index(lo, n));
+        for (std::size_t rank = lo; rank < hi; ++rank) {
+          temp[static_cast<std::size_t>(idx)] =
+            std::ranges::iter_move(first + static_cast<std::ptrdiff_t>(rank));
+          if (rank + 1 < hi) {
+            idx = Policy::next_index(idx, n);
+          }
+        }
+      });
+
+    executor(n,
+      parallel_build_grain,
+      [&](std::size_t, std::size_t lo, std::size_t hi) {
+        std::ranges::move(temp.begin() + static_cast<std::ptrdiff_t>(lo),
+          temp.begin() + static_cast<std::ptrdiff_t>(hi),
+          first + static_cast<std::ptrdiff_t>(lo));
+      });
+  }
+
+} // namespace eytzinger::detail
+
 #endif // UTILITIES_HPP
@@ -5,12 +5,18 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <bit>
 #include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <ranges>
 #include <shared_mutex>
+#include <span>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -22,6 +28,8 @@
 #include <boost/smart_ptr/make_local_shared.hpp>
 #include <boost/smart_ptr/make_local_shared_array.hpp>
 
+#include <vault/flatbuffers/mapped_buffer.hpp>
+
 namespace vault::fb::concepts {
   template <typename T>
   concept table = std::is_base_of_v<flatbuffers::Table, T>;
@@ -31,12 +39,76 @@ namespace vault::fb::concepts {
     { history.with_read_lock(std::identity{}) } -> std::same_as<int const&>;
     { history.with_write_lock(std::identity{}) } -> std::same_as<int&>;
   };
+
+  template <template <typename> typename T>
+  concept lock_free_history = requires(T<int>& history, std::pair<const uint8_t*, std::array<std::byte, 16>> const& entry) {
+    { std::as_const(history).contains(entry) } -> std::same_as<bool>;
+    history.insert(entry);
+  };
+
+  template <template <typename> typename T>
+  concept history_policy = synchronized_history<T> || lock_free_history<T>;
+
+  // A history that can share the ownership of the buffer its tables read from.
+  template <template <typename> typename T>
+  concept owning_history = std::constructible_from<T<int>, std::shared_ptr<void const>>;
 } // namespace vault::fb::concepts
 
 namespace vault::fb::traits {
   template <auto Accessor>
   struct nested_type;
-}
+
+  /**
+   * The verification of a single field, for tables created with `create_lazy`.
+   * The generated traits specialize it with a static
+   * `bool verify(flatbuffers::Verifier&, const Table&)` that checks the field
+   * as the generated `Verify` would, except that sub-tables are checked down
+   * to their vtables only. Fields without a specialization always fail to
+   * verify in lazy tables.
+   *
+   * A specialization whose verification takes time in the size of the field
+   * declares `static constexpr bool memoize = true`, and lazy tables record
+   * those fields in their history once verified. Other fields are checked in
+   * constant time, faster than a lookup in the history, on every read.
+   */
+  template <auto Accessor>
+  struct field_verifier {};
+
+  /// Verifies the start and the vtable of a sub-table, but none of its fields.
+  template <vault::fb::concepts::table Sub>
+  [[nodiscard]] bool verify_shallow(flatbuffers::Verifier& verifier, Sub const* table) {
+    // Generated tables derive privately from flatbuffers::Table.
+    return !table || (verifier.VerifyTableStart(reinterpret_cast<uint8_t const*>(table)) && verifier.EndTable());
+  }
+
+  /// Verifies a vector of tables and the start and the vtable of each of them.
+  template <vault::fb::concepts::table Sub>
+  [[nodiscard]] bool verify_shallow(flatbuffers::Verifier& verifier, flatbuffers::Vector<flatbuffers::Offset<Sub>> const* tables) {
+    if (!tables) {
+      return true;
+    } else if (!verifier.VerifyVector(tables)) {
+      return false;
+    }
+
+    for (flatbuffers::uoffset_t n = 0; n < tables->size(); ++n) {
+      if (!verify_shallow(verifier, tables->Get(n))) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+} // namespace vault::fb::traits
+
+namespace vault::fb::concepts {
+  template <auto Accessor, typename T>
+  concept lazily_verifiable = requires(flatbuffers::Verifier& verifier, T const& table) {
+    { traits::field_verifier<Accessor>::verify(verifier, table) } -> std::same_as<bool>;
+  };
+
+  template <auto Accessor>
+  concept memoized_field = traits::field_verifier<Accessor>::memoize;
+} // namespace vault::fb::concepts
 
 namespace vault::fb {
   using accessor_id = std::array<std::byte, 16>;
@@ -46,13 +118,20 @@ namespace vault::fb {
     using history_t = HistoryT;
 
     struct impl_t {
-      std::shared_mutex mutex;
-      history_t         history;
+      std::shared_mutex           mutex;
+      history_t                   history;
+      std::shared_ptr<void const> owner;
     };
 
     std::shared_ptr<impl_t> impl = std::make_shared<impl_t>();
 
   public:
+    synchronized_t() = default;
+
+    explicit synchronized_t(std::shared_ptr<void const> owner) {
+      impl->owner = std::move(owner);
+    }
+
     template <std::invocable<history_t const&> ActionT>
     std::invoke_result_t<ActionT, history_t const&> with_read_lock(ActionT action) const {
       auto lock = std::shared_lock{impl->mutex};
@@ -68,21 +147,125 @@ namespace vault::fb {
 
   template <typename HistoryT>
   class unsynchronized_t {
-    boost::local_shared_ptr<HistoryT> impl = boost::make_local_shared<HistoryT>();
+    struct impl_t {
+      HistoryT                    history;
+      std::shared_ptr<void const> owner;
+    };
+
+    boost::local_shared_ptr<impl_t> impl = boost::make_local_shared<impl_t>();
 
   public:
+    unsynchronized_t() = default;
+
+    explicit unsynchronized_t(std::shared_ptr<void const> owner) {
+      impl->owner = std::move(owner);
+    }
+
     template <std::invocable<HistoryT const&> ActionT>
     std::invoke_result_t<ActionT, HistoryT const&> with_read_lock(ActionT action) const {
-      return std::invoke(action, *impl);
+      return std::invoke(action, impl->history);
     }
 
     template <std::invocable<HistoryT&> ActionT>
     std::invoke_result_t<ActionT, HistoryT&> with_write_lock(ActionT action) {
-      return std::invoke(action, *impl);
+      return std::invoke(action, impl->history);
     }
   };
 
-  // std::vector<std::pair<const uint8_t*, accessor_id>>
+  /**
+   * A lock-free history: a fixed-capacity, open-addressed set of the verified
+   * (data pointer, accessor id) pairs, with linear probing.
+   *
+   * Readers only load the state of the slots they probe, so concurrent readers
+   * of one root buffer share the slots' cache lines without writing to them. A
+   * slot goes from empty to claimed to published, and never back, so a probe
+   * that meets an empty slot has seen every entry before it. A slot that is
+   * claimed but not yet published is skipped, which at worst verifies a nested
+   * buffer once more. Once the set is full, new entries are dropped and their
+   * buffers are verified on every access.
+   *
+   * The history type is unused: the entries are always the pairs that `table`
+   * records.
+   */
+  template <typename HistoryT>
+  class lock_free_t {
+  public:
+    static constexpr std::size_t capacity = 128;
+
+  private:
+    using entry_t = std::pair<const uint8_t*, std::array<std::byte, 16>>;
+
+    enum : uint8_t { empty, claimed, published };
+
+    struct slot_t {
+      std::atomic<uint8_t>      state{empty};
+      const uint8_t*            data = nullptr;
+      std::array<std::byte, 16> id{};
+    };
+
+    struct impl_t {
+      std::array<slot_t, capacity> slots;
+      std::shared_ptr<void const>  owner;
+    };
+
+    static_assert(std::has_single_bit(capacity));
+
+    std::shared_ptr<impl_t> impl = std::make_shared<impl_t>();
+
+    [[nodiscard]] static auto home(entry_t const& entry) noexcept -> std::size_t {
+      auto word = std::uint64_t{};
+      std::memcpy(&word, entry.second.data(), sizeof(word));
+
+      // The finalizer of MurmurHash3 over the pointer and the first half of the id.
+      auto h = std::bit_cast<std::uintptr_t>(entry.first) ^ (word * 0x9e3779b97f4a7c15ULL);
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return static_cast<std::size_t>(h);
+    }
+
+  public:
+    lock_free_t() = default;
+
+    explicit lock_free_t(std::shared_ptr<void const> owner) {
+      impl->owner = std::move(owner);
+    }
+
+    [[nodiscard]] auto contains(entry_t const& entry) const noexcept -> bool {
+      auto const first = home(entry);
+
+      for (auto probe = std::size_t{0}; probe < capacity; ++probe) {
+        auto const& slot  = impl->slots[(first + probe) & (capacity - 1)];
+        auto const  state = slot.state.load(std::memory_order_acquire);
+
+        if (state == empty) {
+          return false;
+        } else if (state == published && slot.data == entry.first && slot.id == entry.second) {
+          return true;
+        }
+      }
+
+      return false;
+    }
+
+    void insert(entry_t const& entry) noexcept {
+      auto const first = home(entry);
+
+      for (auto probe = std::size_t{0}; probe < capacity; ++probe) {
+        auto& slot  = impl->slots[(first + probe) & (capacity - 1)];
+        auto  state = slot.state.load(std::memory_order_acquire);
+
+        if (state == empty && slot.state.compare_exchange_strong(state, claimed, std::memory_order_acquire)) {
+          slot.data = entry.first;
+          slot.id   = entry.second;
+          slot.state.store(published, std::memory_order_release);
+          return;
+        } else if (state == published && slot.data == entry.first && slot.id == entry.second) {
+          return;
+        }
+      }
+    }
+  };
 
   namespace detail {
     template <auto Value>
@@ -91,6 +274,16 @@ namespace vault::fb {
     template <auto Accessor>
     inline auto const id = std::bit_cast<accessor_id>(lvalue<Accessor>);
 
+    // The ids of the fields verified by lazy tables, kept apart from the ids of
+    // their nested buffers by the top byte of the `this` adjustment of the
+    // member pointer, which is zero for the accessors of generated tables.
+    template <auto Accessor>
+    inline auto const field_id = [] {
+      auto field   = id<Accessor>;
+      field.back() = ~field.back();
+      return field;
+    }();
+
     template <typename ExplicitType, auto Accessor>
     struct nested_type {
       using type = ExplicitType;
@@ -111,11 +304,23 @@ namespace vault::fb {
 
   template <typename T, template <typename> typename H = synchronized_t>
   class table {
-    static_assert(concepts::table<T> && concepts::synchronized_history<H>);
+    static_assert(concepts::table<T> && concepts::history_policy<H>);
   };
 
+  namespace detail {
+    template <typename R, template <typename> typename H>
+    struct field_type {
+      using type = R;
+    };
+
+    template <concepts::table Sub, template <typename> typename H>
+    struct field_type<Sub const*, H> {
+      using type = table<Sub, H>;
+    };
+  } // namespace detail
+
   template <typename T, template <typename> typename H>
-    requires concepts::table<T> && concepts::synchronized_history<H>
+    requires concepts::table<T> && concepts::history_policy<H>
   class table<T, H> {
     using history_t = H<std::vector<std::pair<const uint8_t*, accessor_id>>>;
 
@@ -125,6 +330,12 @@ namespace vault::fb {
     template <auto Accessor, typename ExplicitType>
     using nested_table_t = table<nested_t<Accessor, ExplicitType>, H>;
 
+    template <auto Accessor>
+    using list_element_t = std::remove_cvref_t<decltype(*(std::declval<T>().*Accessor)()->Get(0))>;
+
+    template <auto Accessor>
+    using field_t = typename detail::field_type<decltype((std::declval<T const&>().*Accessor)()), H>::type;
+
     template <concepts::table NestedT>
     static bool verify(uint8_t const* data, size_t size) {
       // clang-format off
@@ -146,6 +357,20 @@ namespace vault::fb {
       return verifier.template VerifySizePrefixedBuffer<T>(nullptr);
     }
 
+    // Verifies the root offset and the start and the vtable of the root table,
+    // as `VerifyBuffer` does before it verifies the fields.
+    template <concepts::table NestedT>
+    static bool verify_root(uint8_t const* data, size_t size) {
+      // clang-format off
+      auto verifier = flatbuffers::Verifier{data, size,
+        flatbuffers::Verifier::Options{.check_nested_flatbuffers = false}
+      };
+      // clang-format on
+
+      auto const offset = verifier.VerifyOffset(size_t{0});
+      return offset != 0 && traits::verify_shallow(verifier, reinterpret_cast<NestedT const*>(data + offset));
+    }
+
   public:
     [[nodiscard]]
     static auto create(const uint8_t* data, size_t size) -> std::optional<table<T, H>> {
@@ -163,6 +388,34 @@ namespace vault::fb {
       return create(std::ranges::data(bytes), std::ranges::size(bytes));
     }
 
+    /**
+     * Creates a table whose fields are verified on first access, through
+     * `field`, `get_nested` and `get_list`, rather than all at once. Only the
+     * root offset and the vtable of the root table are verified here, so the
+     * cost of a read grows with the fields it touches rather than with the
+     * buffer. The fields whose verification is not constant time are recorded
+     * in the history once verified, as nested buffers are, and the sub-tables
+     * and nested buffers reached from the table are lazy as well.
+     *
+     * The fields of a lazy table must only be read through `field`: reading
+     * them through `operator->` or `get` skips their verification.
+     */
+    [[nodiscard]]
+    static auto create_lazy(const uint8_t* data, size_t size) -> std::optional<table<T, H>> {
+      if (!data || size == 0) [[unlikely]] {
+        return std::nullopt;
+      } else if (verify_root<T>(data, size)) {
+        return table{flatbuffers::GetRoot<T>(data), history_t{}, std::span{data, size}};
+      }
+
+      return std::nullopt;
+    }
+
+    [[nodiscard]]
+    static auto create_lazy(std::span<uint8_t const> bytes) -> std::optional<table<T, H>> {
+      return create_lazy(std::ranges::data(bytes), std::ranges::size(bytes));
+    }
+
     [[nodiscard]]
     static auto create_size_prefixed(const uint8_t* data, size_t size) -> std::optional<table<T, H>> {
       if (!data) {
@@ -179,6 +432,33 @@ namespace vault::fb {
       return create_size_prefixed(std::ranges::data(bytes), std::ranges::size(bytes));
     }
 
+    /**
+     * Creates a table from a mapped file, as `create`, `create_lazy` and
+     * `create_size_prefixed` do from its bytes. The table and every table
+     * reached from it share the ownership of the mapping through their
+     * history, so it stays mapped while any of them is alive.
+     */
+    [[nodiscard]]
+    static auto create(mapped_buffer const& buffer) -> std::optional<table<T, H>>
+      requires concepts::owning_history<H>
+    {
+      return owning(create(buffer.bytes()), buffer);
+    }
+
+    [[nodiscard]]
+    static auto create_lazy(mapped_buffer const& buffer) -> std::optional<table<T, H>>
+      requires concepts::owning_history<H>
+    {
+      return owning(create_lazy(buffer.bytes()), buffer);
+    }
+
+    [[nodiscard]]
+    static auto create_size_prefixed(mapped_buffer const& buffer) -> std::optional<table<T, H>>
+      requires concepts::owning_history<H>
+    {
+      return owning(create_size_prefixed(buffer.bytes()), buffer);
+    }
+
     [[nodiscard]] auto operator->() const noexcept -> const T* {
       return table_;
     }
@@ -187,11 +467,44 @@ namespace vault::fb {
       return table_;
     }
 
+    /// Whether the fields of the table are verified on first access.
+    [[nodiscard]] auto is_lazy() const noexcept -> bool {
+      return !buffer_.empty();
+    }
+
+    /**
+     * Reads a field, verifying it first if the table is lazy and the field has
+     * not been read before. A sub-table is returned as a table sharing this
+     * table's history, and is empty if it is absent.
+     *
+     * Returns an empty optional if the field fails its verification.
+     */
+    template <auto Accessor>
+    [[nodiscard]] auto field() const -> std::optional<field_t<Accessor>> {
+      if (is_lazy() && not verify_field<Accessor>()) {
+        return std::nullopt;
+      }
+
+      auto const value = (table_->*Accessor)();
+
+      if constexpr (std::same_as<field_t<Accessor>, std::remove_const_t<decltype(value)>>) {
+        return value;
+      } else if (value) {
+        return field_t<Accessor>(value, history_, buffer_);
+      } else {
+        return std::nullopt;
+      }
+    }
+
     template <auto Accessor, typename ExplicitType = void>
     [[nodiscard]] auto get_nested() const -> std::optional<nested_table_t<Accessor, ExplicitType>> {
       using nested_type = nested_t<Accessor, ExplicitType>;
       using table_type  = nested_table_t<Accessor, ExplicitType>;
 
+      if (is_lazy() && not verify_field<Accessor>()) {
+        return std::nullopt;
+      }
+
       const auto* vec = (table_->*Accessor)();
 
       if (not vec or not vec->size()) {
@@ -199,34 +512,69 @@ namespace vault::fb {
       }
 
       auto const needle = std::pair{vec->data(), detail::id<Accessor>};
+      auto const nested = is_lazy() ? std::span{vec->data(), vec->size()} : std::span<uint8_t const>{};
+
+      if constexpr (concepts::lock_free_history<H>) {
+        if (not history_.contains(needle)) {
+          if (not verify_nested<nested_type>(vec->data(), vec->size())) {
+            return std::nullopt;
+          }
+          history_.insert(needle);
+        }
+      } else {
+        auto [hsize, already_verified] = history_.with_read_lock([&](auto const& history) {
+          return std::pair{std::ranges::size(history), std::ranges::contains(history, needle)};
+        });
+
+        if (already_verified) {
+          return table_type(flatbuffers::GetRoot<nested_type>(vec->data()), history_, nested);
+        } else if (not verify_nested<nested_type>(vec->data(), vec->size())) {
+          return std::nullopt;
+        }
 
-      auto [hsize, already_verified] = history_.with_read_lock([&](auto const& history) {
-        return std::pair{std::ranges::size(history), std::ranges::contains(history, needle)};
-      });
-
-      if (already_verified) {
-        return table_type(flatbuffers::GetRoot<nested_type>(vec->data()), history_);
-      } else if (not verify<nested_type>(vec->data(), vec->size())) {
-        return std::nullopt;
+        history_.with_write_lock([&](auto& history) {
+          if (not std::ranges::contains(std::views::drop(history, hsize), needle)) {
+            history.emplace_back(needle);
+          }
+        });
       }
 
-      history_.with_write_lock([&](auto& history) {
-        if (not std::ranges::contains(std::views::drop(history, hsize), needle)) {
-          history.emplace_back(needle);
-        }
-      });
-
-      return table_type(flatbuffers::GetRoot<nested_type>(vec->data()), history_);
+      return table_type(flatbuffers::GetRoot<nested_type>(vec->data()), history_, nested);
     }
 
+    /**
+     * The tables of a vector of tables. Those of a lazy table are verified down
+     * to their vtables on the first call, and the list is empty if that fails.
+     */
     template <auto Accessor>
-      requires concepts::table<std::remove_cvref_t<decltype(*(std::declval<T>().*Accessor)()->Get(0))>>
+      requires concepts::table<list_element_t<Accessor>>
     [[nodiscard]] auto get_list() const {
-      auto const* fb_vector = (table_->*Accessor)();
+      auto const* fb_vector = (is_lazy() && not verify_field<Accessor>()) ? nullptr : (table_->*Accessor)();
 
       // clang-format off
       auto nth_table = [&, fb_vector](std::size_t n) {
-	return vault::fb::table { fb_vector->Get(n), history_ };
+	return vault::fb::table { fb_vector->Get(n), history_, buffer_ };
+      };
+
+      return std::views::iota(0U, fb_vector ? fb_vector->size() : 0U)
+	| std::views::transform(nth_table);
+      // clang-format on
+    }
+
+    /**
+     * The raw pointers to the tables of a vector of tables, without a history
+     * each, for scans and for the job factories of `vault::amac::coordinator`.
+     * Those of a lazy table are verified down to their vtables only, so their
+     * fields must be read through `for_each_in_list` or `get_list` instead.
+     */
+    template <auto Accessor>
+      requires concepts::table<list_element_t<Accessor>>
+    [[nodiscard]] auto get_raw_list() const {
+      auto const* fb_vector = (is_lazy() && not verify_field<Accessor>()) ? nullptr : (table_->*Accessor)();
+
+      // clang-format off
+      auto nth_table = [fb_vector](std::size_t n) {
+	return fb_vector->Get(n);
       };
 
       return std::views::iota(0U, fb_vector ? fb_vector->size() : 0U)
@@ -234,16 +582,123 @@ namespace vault::fb {
       // clang-format on
     }
 
+    /**
+     * Calls `func` with each table of a vector of tables, in order.
+     *
+     * `func` takes either the `table` of an element, which is one table rebound
+     * from element to element, so that the scan copies the history once rather
+     * than once per element, or the raw pointer to the element.
+     *
+     * A non-zero `Distance` prefetches the table that many elements ahead,
+     * whose offset is in a cache line the scan reads anyway. Out-of-order cores
+     * already overlap the loads of independent elements, so it pays only for
+     * bodies that chase pointers out of each element; nested lookups are better
+     * run as jobs over `get_raw_list`.
+     */
+    template <auto Accessor, std::size_t Distance = 0, typename Func>
+      requires concepts::table<list_element_t<Accessor>>
+            && (std::invocable<Func&, table<list_element_t<Accessor>, H> const&>
+                || std::invocable<Func&, list_element_t<Accessor> const*>)
+    void for_each_in_list(Func&& func) const {
+      using element_t = table<list_element_t<Accessor>, H>;
+
+      auto const* fb_vector = (is_lazy() && not verify_field<Accessor>()) ? nullptr : (table_->*Accessor)();
+      if (not fb_vector or fb_vector->size() == 0) {
+        return;
+      }
+
+      auto const size     = fb_vector->size();
+      auto const prefetch = [&](flatbuffers::uoffset_t n) {
+        if (Distance > 0 && n + Distance < size) {
+          __builtin_prefetch(fb_vector->Get(n + Distance));
+        }
+      };
+
+      if constexpr (std::invocable<Func&, element_t const&>) {
+        auto element = element_t(fb_vector->Get(0), history_, buffer_);
+        for (flatbuffers::uoffset_t n = 0; n < size; ++n) {
+          prefetch(n);
+          element.table_ = fb_vector->Get(n);
+          std::invoke(func, std::as_const(element));
+        }
+      } else {
+        for (flatbuffers::uoffset_t n = 0; n < size; ++n) {
+          prefetch(n);
+          std::invoke(func, fb_vector->Get(n));
+        }
+      }
+    }
+
   private:
-    [[nodiscard]] table(const T* table, history_t history)
+    [[nodiscard]] table(const T* table, history_t history, std::span<uint8_t const> buffer = {})
       : table_(table)
-      , history_(std::move(history)) {
+      , history_(std::move(history))
+      , buffer_(buffer) {
 
       assert(table != nullptr && "Initializing table with nullptr is invalid");
     }
 
-    const T*          table_;
-    mutable history_t history_;
+    // Hands a freshly created root a history that owns the mapping it reads.
+    [[nodiscard]] static auto owning(std::optional<table<T, H>> root, mapped_buffer const& buffer)
+      -> std::optional<table<T, H>> {
+      if (root) {
+        root->history_ = history_t{buffer.owner()};
+      }
+
+      return root;
+    }
+
+    template <concepts::table NestedT>
+    [[nodiscard]] auto verify_nested(uint8_t const* data, size_t size) const -> bool {
+      return is_lazy() ? verify_root<NestedT>(data, size) : verify<NestedT>(data, size);
+    }
+
+    template <auto Accessor>
+    [[nodiscard]] auto verify_field() const -> bool {
+      if constexpr (not concepts::lazily_verifiable<Accessor, T>) {
+        return false;
+      } else {
+        // clang-format off
+        auto verifier = flatbuffers::Verifier{buffer_.data(), buffer_.size(),
+          flatbuffers::Verifier::Options{.check_nested_flatbuffers = false}
+        };
+        // clang-format on
+
+        if constexpr (not concepts::memoized_field<Accessor>) {
+          return traits::field_verifier<Accessor>::verify(verifier, *table_);
+        } else {
+          auto const needle = std::pair{reinterpret_cast<const uint8_t*>(table_), detail::field_id<Accessor>};
+
+          if constexpr (concepts::lock_free_history<H>) {
+            if (history_.contains(needle)) {
+              return true;
+            }
+          } else if (history_.with_read_lock([&](auto const& history) { return std::ranges::contains(history, needle); })) {
+            return true;
+          }
+
+          if (not traits::field_verifier<Accessor>::verify(verifier, *table_)) {
+            return false;
+          }
+
+          if constexpr (concepts::lock_free_history<H>) {
+            history_.insert(needle);
+          } else {
+            history_.with_write_lock([&](auto& history) {
+              if (not std::ranges::contains(history, needle)) {
+                history.emplace_back(needle);
+              }
+            });
+          }
+
+          return true;
+        }
+      }
+    }
+
+    const T*                 table_;
+    mutable history_t        history_;
+    std::span<uint8_t const> buffer_;
 
     template <typename, template <typename> typename>
     friend class table;
@@ -252,4 +707,7 @@ namespace vault::fb {
   template <typename T, template <typename> typename H, typename V>
   table(T*, H<V>) -> table<T, H>;
 
+  template <typename T, template <typename> typename H, typename V>
+  table(T*, H<V>, std::span<uint8_t const>) -> table<T, H>;
+
 } // namespace vault::fb
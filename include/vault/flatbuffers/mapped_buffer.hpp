@@ -0,0 +1,153 @@
+/**
+ * @file mapped_buffer.hpp
+ * @brief Read-only memory mappings of FlatBuffer files, shared by the tables read from them.
+ */
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace vault::fb {
+  /// How a mapping is going to be read, passed to the kernel with madvise.
+  enum class map_access {
+    normal,    // Default read-ahead.
+    random,    // No read-ahead, for tables read a few fields at a time.
+    will_need, // Read the whole mapping in ahead of use.
+  };
+
+  struct map_options {
+    map_access access = map_access::random;
+
+    // Asks for transparent huge pages, which the kernel honours for read-only file
+    // mappings where it supports huge pages in the page cache.
+    bool huge_pages = false;
+  };
+
+  /**
+   * A read-only, shared mapping of a whole file. Copies share the mapping, which is
+   * unmapped with the last of them and of the tables created from it, so the tables
+   * never outlive their bytes. The pages are those of the page cache, so processes
+   * that map the same file share them.
+   *
+   * The file may be replaced once it is mapped, but must not be truncated or written in
+   * place while the mapping is alive.
+   */
+  class mapped_buffer {
+    struct mapping_t {
+      void*       base = nullptr;
+      std::size_t size = 0;
+
+      mapping_t(void* base, std::size_t size) noexcept
+        : base(base)
+        , size(size) {}
+
+      mapping_t(mapping_t const&)            = delete;
+      mapping_t& operator=(mapping_t const&) = delete;
+
+      ~mapping_t() {
+        ::munmap(base, size);
+      }
+    };
+
+    std::shared_ptr<mapping_t const> mapping_;
+
+    [[noreturn]] static void throw_errno(const char* what) {
+      throw std::system_error(errno, std::generic_category(), what);
+    }
+
+  public:
+    /// An empty buffer, from which no table can be created.
+    mapped_buffer() noexcept = default;
+
+    /**
+     * Maps the file at `path`. An empty file gives an empty buffer.
+     *
+     * @throws std::system_error if the file cannot be opened or mapped.
+     */
+    [[nodiscard]]
+    static auto open(std::filesystem::path const& path, map_options options = {}) -> mapped_buffer {
+      auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+        throw_errno("vault::fb::mapped_buffer::open: open");
+      }
+
+      // The mapping holds its own reference to the file, which is closed on return.
+      struct file_t {
+        int fd;
+
+        ~file_t() {
+          ::close(fd);
+        }
+      } const file{fd};
+
+      struct stat st;
+      if (::fstat(fd, &st) != 0) {
+        throw_errno("vault::fb::mapped_buffer::open: fstat");
+      }
+
+      auto buffer = mapped_buffer{};
+      auto size   = static_cast<std::size_t>(st.st_size);
+      if (size == 0) {
+        return buffer;
+      }
+
+      auto* base = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+      if (base == MAP_FAILED) {
+        throw_errno("vault::fb::mapped_buffer::open: mmap");
+      }
+
+      try {
+        buffer.mapping_ = std::make_shared<mapping_t const>(base, size);
+      } catch (...) {
+        ::munmap(base, size);
+        throw;
+      }
+
+      // These are hints, so a kernel that rejects one is ignored.
+      switch (options.access) {
+      case map_access::normal:
+        break;
+      case map_access::random:
+        ::madvise(base, size, MADV_RANDOM);
+        break;
+      case map_access::will_need:
+        ::madvise(base, size, MADV_WILLNEED);
+        break;
+      }
+#if defined(MADV_HUGEPAGE)
+      if (options.huge_pages) {
+        ::madvise(base, size, MADV_HUGEPAGE);
+      }
+#endif
+
+      return buffer;
+    }
+
+    [[nodiscard]] auto data() const noexcept -> const uint8_t* {
+      return mapping_ ? static_cast<const uint8_t*>(mapping_->base) : nullptr;
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t {
+      return mapping_ ? mapping_->size : 0;
+    }
+
+    [[nodiscard]] auto bytes() const noexcept -> std::span<uint8_t const> {
+      return {data(), size()};
+    }
+
+    /// The shared ownership of the mapping, which keeps it mapped.
+    [[nodiscard]] auto owner() const noexcept -> std::shared_ptr<void const> {
+      return mapping_;
+    }
+  };
+} // namespace vault::fb
@@ -0,0 +1,206 @@
+#ifndef FROZEN_ARENA_STORAGE_POLICY_HPP
+#define FROZEN_ARENA_STORAGE_POLICY_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace frozen {
+
+  /**
+   * @brief A bump allocator over a list of slabs, freed together when the
+   * arena is destroyed.
+   *
+   * Arena storage is handed out as std::shared_ptr aliases of the arena's own
+   * shared_ptr, so every frozen_vector carved from it shares one control block
+   * and keeps the whole arena alive: destroying a request's worth of vectors
+   * frees one slab list instead of a heap block and a control block apiece.
+   *
+   * An arena is not thread-safe to allocate from. The vectors carved from it
+   * may be read, copied and destroyed on any thread.
+   */
+  class frozen_arena {
+  public:
+    static constexpr std::size_t default_slab_size = 64 * 1024;
+
+    explicit frozen_arena(std::size_t slab_size = default_slab_size) noexcept
+        : slab_size_(std::max<std::size_t>(slab_size, 1))
+    {}
+
+    frozen_arena(const frozen_arena&)            = delete;
+    frozen_arena& operator=(const frozen_arena&) = delete;
+
+    /**
+     * @brief Returns bytes bytes aligned to alignment, a power of 2 no larger
+     * than alignof(std::max_align_t). Requests larger than a quarter of a slab
+     * get a slab of their own, so they do not waste the rest of the current
+     * one.
+     *
+     * @throws std::bad_alloc if a slab cannot be allocated.
+     */
+    [[nodiscard]] void* allocate(std::size_t bytes, std::size_t alignment)
+    {
+      assert(
+          alignment <= alignof(std::max_align_t) &&
+          "Arena slabs are aligned to max_align_t"
+      );
+
+      const std::size_t offset = (used_ + alignment - 1) & ~(alignment - 1);
+      if (!slabs_.empty() && offset <= capacity_ && bytes <= capacity_ - offset) {
+        used_ = offset + bytes;
+        return slabs_.back().get() + offset;
+      }
+
+      if (bytes > slab_size_ / 4) {
+        // Kept behind the current slab, which may still serve small requests.
+        auto  slab = std::make_unique_for_overwrite<std::byte[]>(bytes);
+        void* ptr  = slab.get();
+        slabs_.insert(
+            slabs_.empty() ? slabs_.end() : std::prev(slabs_.end()),
+            std::move(slab)
+        );
+        allocated_bytes_ += bytes;
+        return ptr;
+      }
+
+      slabs_.push_back(std::make_unique_for_overwrite<std::byte[]>(slab_size_));
+      allocated_bytes_ += slab_size_;
+      capacity_ = slab_size_;
+      used_     = bytes;
+      return slabs_.back().get();
+    }
+
+    /**
+     * @brief The bytes of the slabs allocated so far.
+     */
+    [[nodiscard]] std::size_t allocated_bytes() const noexcept
+    {
+      return allocated_bytes_;
+    }
+
+    [[nodiscard]] std::size_t slab_count() const noexcept
+    {
+      return slabs_.size();
+    }
+
+  private:
+    std::vector<std::unique_ptr<std::byte[]>> slabs_;
+    std::size_t                               slab_size_;
+    std::size_t                               capacity_        = 0;
+    std::size_t                               used_            = 0;
+    std::size_t                               allocated_bytes_ = 0;
+  };
+
+  /**
+   * @brief The allocator of a frozen_vector_builder with
+   * arena_storage_policy: the arena its storage is carved from.
+   *
+   * As a standard allocator, deallocate() does nothing: the memory is freed
+   * with the arena.
+   */
+  template <typename T> class arena_allocator {
+  public:
+    using value_type                             = T;
+    using size_type                              = std::size_t;
+    using difference_type                        = std::ptrdiff_t;
+    using is_always_equal                        = std::false_type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    /**
+     * @brief An allocator with an arena of its own, with the default slab
+     * size.
+     */
+    arena_allocator()
+        : arena_(std::make_shared<frozen_arena>())
+    {}
+
+    explicit arena_allocator(std::shared_ptr<frozen_arena> arena) noexcept
+        : arena_(std::move(arena))
+    {
+      assert(arena_ && "An arena allocator needs an arena");
+    }
+
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& other) noexcept
+        : arena_(other.arena())
+    {}
+
+    [[nodiscard]] T* allocate(std::size_t n) const
+    {
+      if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+      }
+      return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept {}
+
+    [[nodiscard]] const std::shared_ptr<frozen_arena>& arena() const noexcept
+    {
+      return arena_;
+    }
+
+    template <typename U>
+    [[nodiscard]] bool operator==(const arena_allocator<U>& other) const noexcept
+    {
+      return arena_ == other.arena();
+    }
+
+  private:
+    std::shared_ptr<frozen_arena> arena_;
+  };
+
+  /**
+   * @brief Storage carved from a frozen_arena, for trivially destructible
+   * elements, since nothing runs their destructors.
+   *
+   * The handles are std::shared_ptr aliases of the arena, so the frozen
+   * vectors have the default handle type and mix freely with vectors of
+   * shared_storage_policy. A builder that grows abandons its old storage to
+   * the arena, so reserve() the final size up front where it is known.
+   */
+  template <typename T> struct arena_storage_policy {
+    static_assert(
+        std::is_trivially_destructible_v<T>,
+        "Arena storage never runs the destructors of its elements."
+    );
+
+    using mutable_handle_type = std::shared_ptr<T[]>;
+
+    [[nodiscard]]
+    static mutable_handle_type
+    allocate(std::size_t n, const arena_allocator<T>& a)
+    {
+      if (n == 0) {
+        return mutable_handle_type();
+      }
+      T* data = a.allocate(n);
+      std::uninitialized_default_construct_n(data, n);
+      return mutable_handle_type(a.arena(), data);
+    }
+
+    [[nodiscard]]
+    static mutable_handle_type copy(
+        const mutable_handle_type& src, std::size_t n, const arena_allocator<T>& a
+    )
+    {
+      if (!src || n == 0) {
+        return mutable_handle_type();
+      }
+      auto new_data = allocate(n, a);
+      std::copy(src.get(), src.get() + n, new_data.get());
+      return new_data;
+    }
+  };
+
+} // namespace frozen
+
+#endif // FROZEN_ARENA_STORAGE_POLICY_HPP
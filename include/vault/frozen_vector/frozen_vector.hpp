@@ -49,6 +49,16 @@ namespace frozen {
       }
     }
 
+    // Shares the elements of a vector with another handle type, e.g. to
+    // publish a vector built with local counts under thread-safe ones.
+    template <typename OtherHandle>
+      requires(!std::is_same_v<OtherHandle, Handle>) &&
+              std::constructible_from<Handle, const OtherHandle&>
+    explicit frozen_vector(const frozen_vector<T, OtherHandle>& other)
+        : data_(other.handle())
+        , size_(other.size())
+    {}
+
     // Iterators
     [[nodiscard]] const_iterator begin() const noexcept
     {
@@ -120,6 +130,8 @@ namespace frozen {
 
     [[nodiscard]] const_pointer data() const noexcept { return get_raw_ptr(); }
 
+    [[nodiscard]] const handle_type& handle() const noexcept { return data_; }
+
   private:
     Handle    data_;
     size_type size_;
@@ -5,6 +5,7 @@
 #include <cassert>
 #include <compare>
 #include <concepts>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <memory>
@@ -12,6 +13,8 @@
 #include <type_traits>
 #include <utility>
 
+#include <vault/executor/thread_executor.hpp>
+
 #include "concepts.hpp"
 #include "frozen_vector.hpp"
 #include "shared_storage_policy.hpp"
@@ -23,7 +26,7 @@ namespace frozen {
       typename T,
       typename ptr_policy = shared_storage_policy<T>,
       typename alloc      = std::allocator<T>>
-    requires std::is_default_constructible_v<T> && std::is_move_assignable_v<T>
+    requires std::is_move_assignable_v<T>
   class frozen_vector_builder {
   public:
     using value_type             = T;
@@ -53,6 +56,7 @@ namespace frozen {
     explicit frozen_vector_builder(
         size_type count, const allocator_type& a = allocator_type()
     )
+      requires std::is_default_constructible_v<T>
         : allocator_(a)
         , size_(count)
         , capacity_(count)
@@ -132,7 +136,10 @@ namespace frozen {
         }
 
         if (capacity_ >= other.size_) {
-          assert(data_ && "Capacity exists but data is null");
+          assert(
+              (data_ || other.size_ == 0) &&
+              "Capacity exists but data is null"
+          );
           std::copy(other.begin(), other.end(), begin());
           size_ = other.size_;
         } else {
@@ -245,6 +252,11 @@ namespace frozen {
       auto local_data = std::move(data_);
 
       try {
+        // Policies whose storage changes on freezing, e.g. a mapping made
+        // read-only, seal it before the handle is converted.
+        if constexpr (requires { ptr_policy::seal(local_data, size_); }) {
+          ptr_policy::seal(local_data, size_);
+        }
         auto frozen_ptr = traits::freeze(std::move(local_data));
 
         size_type final_size = size_;
@@ -291,6 +303,55 @@ namespace frozen {
       check_invariants();
     }
 
+    // Appends the elements of rg on the workers of executor. Each worker
+    // copies whole chunks of about a huge page into storage that is not
+    // touched beforehand, so with a first-touch NUMA policy every page is
+    // placed on the node of the thread that writes it. If a copy throws, the
+    // size is left unchanged.
+    template <
+        std::ranges::random_access_range R,
+        vault::algorithm::chunked_executor Executor =
+            vault::algorithm::thread_executor>
+      requires std::ranges::sized_range<R> &&
+               std::convertible_to<std::ranges::range_reference_t<R>, T>
+    void parallel_append_range(R&& rg, const Executor& executor = Executor{})
+    {
+      auto first = std::ranges::begin(rg);
+      parallel_fill_tail(
+          static_cast<size_type>(std::ranges::size(rg)),
+          executor,
+          [&](pointer out, size_type from, size_type to) {
+            std::copy(
+                first + static_cast<difference_type>(from),
+                first + static_cast<difference_type>(to),
+                out
+            );
+          }
+      );
+    }
+
+    // Appends gen(i) for every i in [0, count) on the workers of executor,
+    // as parallel_append_range() does.
+    template <
+        typename Generator,
+        vault::algorithm::chunked_executor Executor =
+            vault::algorithm::thread_executor>
+      requires std::convertible_to<
+          std::invoke_result_t<Generator&, size_type>,
+          T>
+    void parallel_generate(
+        size_type count, Generator gen, const Executor& executor = Executor{}
+    )
+    {
+      parallel_fill_tail(
+          count, executor, [&](pointer out, size_type from, size_type to) {
+            for (size_type i = from; i < to; ++i) {
+              *out++ = std::invoke(gen, i);
+            }
+          }
+      );
+    }
+
     void shrink_to_fit()
     {
       if (size_ < capacity_) {
@@ -348,6 +409,7 @@ namespace frozen {
     }
 
     void resize(size_type count)
+      requires std::is_default_constructible_v<T>
     {
       if (count > size_) {
         if (count > capacity_) {
@@ -360,6 +422,38 @@ namespace frozen {
       check_invariants();
     }
 
+    // Grows the size by n and returns the first of the new elements, for the
+    // caller to write before freezing, e.g. with read() or from a parallel
+    // loop. The new elements are default-initialized by the storage policy,
+    // so for trivial types their pages are not touched until written, where
+    // resize() would write every element twice.
+    [[nodiscard]] pointer append_uninitialized(size_type n)
+    {
+      ensure_capacity(size_ + n);
+      pointer first = data_.get() + size_;
+      size_ += n;
+      check_invariants();
+      return first;
+    }
+
+    // Grows the capacity to at least count, and calls op(data(), count) with
+    // the first min(size(), count) elements kept and the rest default-
+    // initialized, as append_uninitialized() leaves them. op writes the
+    // elements it keeps and returns their number, at most count, which
+    // becomes the size.
+    template <typename Operation>
+      requires std::is_invocable_r_v<size_type, Operation&, pointer, size_type>
+    void resize_and_overwrite(size_type count, Operation op)
+    {
+      if (count > capacity_) {
+        reserve(count);
+      }
+      const size_type new_size = std::move(op)(data_.get(), count);
+      assert(new_size <= count && "resize_and_overwrite kept too many elements");
+      size_ = new_size;
+      check_invariants();
+    }
+
     void clear() noexcept
     {
       size_ = 0;
@@ -528,6 +622,35 @@ namespace frozen {
       }
     }
 
+    // The elements of a chunk of parallel work: about a huge page, so that
+    // no two workers first touch the same huge page mid-chunk.
+    static constexpr size_type parallel_grain =
+        std::max<size_type>(1, (size_type{2} << 20) / sizeof(T));
+
+    // Grows the capacity for count more elements and calls
+    // fill(out, from, to) on the workers of executor to write the elements
+    // [from, to) of them at out. The size grows once every chunk is written.
+    template <typename Executor, typename Fill>
+    void parallel_fill_tail(
+        size_type count, const Executor& executor, Fill&& fill
+    )
+    {
+      if (count == 0) {
+        return;
+      }
+      ensure_capacity(size_ + count);
+      pointer tail = data_.get() + size_;
+      executor(
+          count,
+          parallel_grain,
+          [&](std::size_t, std::size_t from, std::size_t to) {
+            fill(tail + from, from, to);
+          }
+      );
+      size_ += count;
+      check_invariants();
+    }
+
     void reallocate(size_type new_cap)
     {
       assert(
@@ -1,6 +1,7 @@
 #ifndef FROZEN_LOCAL_SHARED_PTR_HPP
 #define FROZEN_LOCAL_SHARED_PTR_HPP
 
+#include <atomic>
 #include <cassert>
 #include <compare>
 #include <concepts>
@@ -16,11 +17,21 @@ namespace frozen {
 
   template <typename T> class local_shared_ptr;
   template <typename T> class local_weak_ptr;
+  template <typename T> class concurrent_shared_ptr;
 
   namespace detail {
+    // Biased reference counting: ref_count counts the local_shared_ptr
+    // owners, which all live on the thread that created the block, and is
+    // never touched atomically. Once the block is promoted, i.e. a
+    // concurrent_shared_ptr is made from it, shared_count counts the
+    // concurrent owners, plus one for all local owners together, and the
+    // object dies when it reaches zero. The weak count is atomic from then
+    // on, as any thread may drop the last owner.
     struct local_control_block_base {
-      long ref_count{1};
-      long weak_count{1};
+      long              ref_count{1};
+      long              weak_count{1};
+      bool              promoted{false};
+      std::atomic<long> shared_count{0};
 
       virtual ~local_control_block_base()    = default;
       virtual void on_zero_shared() noexcept = 0;
@@ -29,14 +40,56 @@ namespace frozen {
       void release_ref() noexcept
       {
         if (--ref_count == 0) {
+          if (promoted) {
+            release_shared();
+          } else {
+            on_zero_shared();
+            release_weak();
+          }
+        }
+      }
+
+      // Adds a concurrent owner. Called on the owner thread, with a local
+      // owner alive.
+      void promote() noexcept
+      {
+        if (!promoted) {
+          promoted = true;
+          shared_count.store(1, std::memory_order_relaxed);
+        }
+        shared_count.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      void add_shared() noexcept
+      {
+        shared_count.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      void release_shared() noexcept
+      {
+        if (shared_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
           on_zero_shared();
           release_weak();
         }
       }
 
+      void add_weak() noexcept
+      {
+        if (promoted) {
+          std::atomic_ref<long>(weak_count).fetch_add(
+            1, std::memory_order_relaxed);
+        } else {
+          ++weak_count;
+        }
+      }
+
       void release_weak() noexcept
       {
-        if (--weak_count == 0) {
+        const bool last = promoted
+          ? std::atomic_ref<long>(weak_count).fetch_sub(
+              1, std::memory_order_acq_rel) == 1
+          : --weak_count == 0;
+        if (last) {
           on_zero_weak();
         }
       }
@@ -143,7 +196,7 @@ namespace frozen {
         , cb_(other.cb_)
     {
       if (cb_) {
-        cb_->weak_count++;
+        cb_->add_weak();
       }
     }
 
@@ -152,7 +205,7 @@ namespace frozen {
         , cb_(other.cb_)
     {
       if (cb_) {
-        cb_->weak_count++;
+        cb_->add_weak();
       }
     }
 
@@ -164,7 +217,7 @@ namespace frozen {
         , cb_(other.cb_)
     {
       if (cb_) {
-        cb_->weak_count++;
+        cb_->add_weak();
       }
     }
 
@@ -195,6 +248,7 @@ namespace frozen {
       std::swap(cb_, r.cb_);
     }
 
+    // The local owners; concurrent owners made by share() are not counted.
     [[nodiscard]] long use_count() const noexcept
     {
       return cb_ ? cb_->ref_count : 0;
@@ -202,6 +256,10 @@ namespace frozen {
 
     [[nodiscard]] bool expired() const noexcept { return use_count() == 0; }
 
+    // An owner of the object, or an empty pointer once the last local owner
+    // is gone. That holds even while concurrent_shared_ptr owners keep the
+    // object alive: they may live on other threads, so the local count
+    // cannot be revived from them.
     [[nodiscard]] local_shared_ptr<T> lock() const noexcept
     {
       return expired() ? local_shared_ptr<T>() : local_shared_ptr<T>(*this);
@@ -232,8 +290,12 @@ namespace frozen {
         : ptr_(p)
     {
       if (p) {
+        // std::allocator of a const element type is ill-formed, and freezing
+        // a unique builder into a local_shared_ptr<const T[]> takes this path.
+        // The block rebinds the allocator anyway, as the unique_ptr
+        // constructor does.
         using Deleter = std::default_delete<T>;
-        using Alloc   = std::allocator<element_type>;
+        using Alloc   = std::allocator<void>;
         cb_ =
           new detail::local_control_block_split<element_type*, Deleter, Alloc>(
             p, Deleter{}, Alloc{});
@@ -377,6 +439,7 @@ namespace frozen {
       return ptr_[i];
     }
 
+    // The local owners; concurrent owners made by share() are not counted.
     [[nodiscard]] long use_count() const noexcept
     {
       return cb_ ? cb_->ref_count : 0;
@@ -387,6 +450,13 @@ namespace frozen {
       return ptr_ != nullptr;
     }
 
+    // A thread-safe owner of the same object, made in O(1) on the owner
+    // thread. The local owners keep their non-atomic counts.
+    [[nodiscard]] concurrent_shared_ptr<T> share() const noexcept
+    {
+      return concurrent_shared_ptr<T>(*this);
+    }
+
     template <typename U>
     bool owner_before(const local_shared_ptr<U>& other) const noexcept
     {
@@ -422,6 +492,134 @@ namespace frozen {
 
     friend class local_weak_ptr<T>;
     template <typename U> friend class local_shared_ptr;
+    template <typename U> friend class concurrent_shared_ptr;
+  };
+
+  // --- concurrent_shared_ptr ---
+
+  /**
+   * @brief A thread-safe owner of an object of a local_shared_ptr, sharing
+   * its control block.
+   *
+   * Made from a local_shared_ptr on its owner thread, it can then be copied,
+   * moved and destroyed on any thread, with atomic counts; the local owners
+   * keep counting non-atomically. Publishing a locally built frozen vector to
+   * other threads thus takes one atomic increment instead of a deep copy.
+   * A concurrent_shared_ptr cannot be turned back into a local one, as other
+   * threads must not touch the local count.
+   */
+  template <typename T> class concurrent_shared_ptr {
+  public:
+    using element_type = std::remove_extent_t<T>;
+
+    constexpr concurrent_shared_ptr() noexcept = default;
+
+    constexpr concurrent_shared_ptr(std::nullptr_t) noexcept {}
+
+    template <typename U>
+      requires std::convertible_to<typename local_shared_ptr<U>::element_type*,
+                 element_type*>
+    explicit concurrent_shared_ptr(const local_shared_ptr<U>& local) noexcept
+        : ptr_(local.ptr_)
+        , cb_(local.cb_)
+    {
+      if (cb_) {
+        cb_->promote();
+      }
+    }
+
+    concurrent_shared_ptr(const concurrent_shared_ptr& other) noexcept
+        : ptr_(other.ptr_)
+        , cb_(other.cb_)
+    {
+      if (cb_) {
+        cb_->add_shared();
+      }
+    }
+
+    template <typename U>
+      requires std::convertible_to<
+        typename concurrent_shared_ptr<U>::element_type*,
+        element_type*>
+    concurrent_shared_ptr(const concurrent_shared_ptr<U>& other) noexcept
+        : ptr_(other.ptr_)
+        , cb_(other.cb_)
+    {
+      if (cb_) {
+        cb_->add_shared();
+      }
+    }
+
+    concurrent_shared_ptr(concurrent_shared_ptr&& other) noexcept
+        : ptr_(std::exchange(other.ptr_, nullptr))
+        , cb_(std::exchange(other.cb_, nullptr))
+    {}
+
+    template <typename U>
+      requires std::convertible_to<
+        typename concurrent_shared_ptr<U>::element_type*,
+        element_type*>
+    concurrent_shared_ptr(concurrent_shared_ptr<U>&& other) noexcept
+        : ptr_(std::exchange(other.ptr_, nullptr))
+        , cb_(std::exchange(other.cb_, nullptr))
+    {}
+
+    ~concurrent_shared_ptr()
+    {
+      if (cb_) {
+        cb_->release_shared();
+      }
+    }
+
+    concurrent_shared_ptr& operator=(const concurrent_shared_ptr& r) noexcept
+    {
+      concurrent_shared_ptr(r).swap(*this);
+      return *this;
+    }
+
+    concurrent_shared_ptr& operator=(concurrent_shared_ptr&& r) noexcept
+    {
+      concurrent_shared_ptr(std::move(r)).swap(*this);
+      return *this;
+    }
+
+    void swap(concurrent_shared_ptr& other) noexcept
+    {
+      std::swap(ptr_, other.ptr_);
+      std::swap(cb_, other.cb_);
+    }
+
+    void reset() noexcept { concurrent_shared_ptr().swap(*this); }
+
+    [[nodiscard]] element_type* get() const noexcept { return ptr_; }
+
+    [[nodiscard]] element_type& operator*() const noexcept { return *ptr_; }
+
+    [[nodiscard]] element_type* operator->() const noexcept { return ptr_; }
+
+    [[nodiscard]] element_type& operator[](std::ptrdiff_t i) const noexcept
+    {
+      assert(ptr_ != nullptr);
+      return ptr_[i];
+    }
+
+    // The concurrent owners, plus one while any local owner is alive. As
+    // with std::shared_ptr, the value may be stale by the time it is read.
+    [[nodiscard]] long use_count() const noexcept
+    {
+      return cb_ ? cb_->shared_count.load(std::memory_order_relaxed) : 0;
+    }
+
+    [[nodiscard]] explicit operator bool() const noexcept
+    {
+      return ptr_ != nullptr;
+    }
+
+  private:
+    element_type*                     ptr_ = nullptr;
+    detail::local_control_block_base* cb_  = nullptr;
+
+    template <typename U> friend class concurrent_shared_ptr;
   };
 
   // --- Casting & Non-members ---
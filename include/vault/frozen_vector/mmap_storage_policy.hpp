@@ -0,0 +1,496 @@
+#ifndef FROZEN_MMAP_STORAGE_POLICY_HPP
+#define FROZEN_MMAP_STORAGE_POLICY_HPP
+
+#include <cassert>
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "frozen_vector.hpp"
+
+namespace frozen {
+
+  // ============================================================================
+  // MAPPED REGIONS
+  // ============================================================================
+
+  // How a mapping is going to be read, passed to the kernel with madvise.
+  enum class mmap_access {
+    normal,     // Default read-ahead.
+    sequential, // Aggressive read-ahead; pages behind the reader may be dropped.
+    random,     // No read-ahead.
+    will_need,  // Read the whole mapping in ahead of use.
+  };
+
+  struct mmap_options {
+    mmap_access access = mmap_access::normal;
+
+    // Asks for transparent huge pages. The kernel honours it for anonymous
+    // mappings, and for read-only file mappings where it supports huge pages in
+    // the page cache.
+    bool huge_pages = false;
+  };
+
+  namespace detail {
+
+    [[noreturn]] inline void throw_errno(const char* what)
+    {
+      throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // An open file descriptor, closed with its last owner.
+    class file_descriptor {
+    public:
+      explicit file_descriptor(int fd) noexcept
+          : fd_(fd)
+      {}
+
+      file_descriptor(const file_descriptor&)            = delete;
+      file_descriptor& operator=(const file_descriptor&) = delete;
+
+      ~file_descriptor() { ::close(fd_); }
+
+      [[nodiscard]] int get() const noexcept { return fd_; }
+
+    private:
+      int fd_;
+    };
+
+  } // namespace detail
+
+  /**
+   * @brief A mapping of anonymous memory or of a file, unmapped on
+   * destruction.
+   *
+   * A writable file mapping keeps its file open, so that seal() can cut the
+   * file to the bytes that were written.
+   */
+  class mapped_region {
+  public:
+    mapped_region(
+        void*                                         base,
+        std::size_t                                   bytes,
+        std::shared_ptr<const detail::file_descriptor> file = nullptr
+    ) noexcept
+        : base_(base)
+        , bytes_(bytes)
+        , file_(std::move(file))
+    {}
+
+    mapped_region(const mapped_region&)            = delete;
+    mapped_region& operator=(const mapped_region&) = delete;
+
+    ~mapped_region() { ::munmap(base_, bytes_); }
+
+    [[nodiscard]] void* base() const noexcept { return base_; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return bytes_; }
+
+    [[nodiscard]] bool file_backed() const noexcept { return file_ != nullptr; }
+
+    /**
+     * @brief Passes the access hints to the kernel. They are hints, so a
+     * kernel that rejects one is ignored.
+     */
+    void advise(const mmap_options& options) const noexcept
+    {
+      int advice = MADV_NORMAL;
+      switch (options.access) {
+      case mmap_access::normal:
+        break;
+      case mmap_access::sequential:
+        advice = MADV_SEQUENTIAL;
+        break;
+      case mmap_access::random:
+        advice = MADV_RANDOM;
+        break;
+      case mmap_access::will_need:
+        advice = MADV_WILLNEED;
+        break;
+      }
+      ::madvise(base_, bytes_, advice);
+#if defined(MADV_HUGEPAGE)
+      if (options.huge_pages) {
+        ::madvise(base_, bytes_, MADV_HUGEPAGE);
+      }
+#endif
+    }
+
+    /**
+     * @brief Makes the region read-only, after cutting a file it maps to its
+     * first used_bytes. The pages are neither copied nor remapped.
+     *
+     * @throws std::system_error if the file cannot be cut or the protection
+     * changed.
+     */
+    void seal(std::size_t used_bytes)
+    {
+      if (file_ && ::ftruncate(file_->get(), static_cast<off_t>(used_bytes)) != 0) {
+        detail::throw_errno("frozen::mapped_region::seal: ftruncate");
+      }
+      if (::mprotect(base_, bytes_, PROT_READ) != 0) {
+        detail::throw_errno("frozen::mapped_region::seal: mprotect");
+      }
+    }
+
+  private:
+    void*                                          base_;
+    std::size_t                                    bytes_;
+    std::shared_ptr<const detail::file_descriptor> file_;
+  };
+
+  namespace detail {
+
+    // Takes ownership of a fresh mapping, unmapping it if that fails.
+    [[nodiscard]] inline std::shared_ptr<mapped_region> adopt_mapping(
+        void*                                   base,
+        std::size_t                             bytes,
+        std::shared_ptr<const file_descriptor> file = nullptr
+    )
+    {
+      try {
+        return std::make_shared<mapped_region>(base, bytes, std::move(file));
+      } catch (...) {
+        ::munmap(base, bytes);
+        throw;
+      }
+    }
+
+  } // namespace detail
+
+  // ============================================================================
+  // HANDLE
+  // ============================================================================
+
+  /**
+   * @brief A reference-counted handle to an array of T in a mapped_region.
+   *
+   * mmap_handle<T> is the mutable handle of a builder, and mmap_handle<const T>
+   * the handle of the frozen_vector it freezes into. Copies share the mapping,
+   * which is unmapped with the last of them.
+   */
+  template <typename T> class mmap_handle {
+  public:
+    using element_type = T;
+
+    template <typename U>
+    using rebind = mmap_handle<std::remove_extent_t<U>>;
+
+    mmap_handle() noexcept = default;
+
+    mmap_handle(std::nullptr_t) noexcept {}
+
+    mmap_handle(std::shared_ptr<mapped_region> region, T* data) noexcept
+        : region_(std::move(region))
+        , data_(data)
+    {}
+
+    template <typename U>
+      requires std::is_convertible_v<U*, T*>
+    mmap_handle(mmap_handle<U>&& other) noexcept
+        : region_(std::move(other.region_))
+        , data_(std::exchange(other.data_, nullptr))
+    {}
+
+    template <typename U>
+      requires std::is_convertible_v<U*, T*>
+    mmap_handle(const mmap_handle<U>& other) noexcept
+        : region_(other.region_)
+        , data_(other.data_)
+    {}
+
+    [[nodiscard]] T* get() const noexcept { return data_; }
+
+    [[nodiscard]] T& operator[](std::size_t i) const noexcept
+    {
+      return data_[i];
+    }
+
+    [[nodiscard]] explicit operator bool() const noexcept
+    {
+      return data_ != nullptr;
+    }
+
+    [[nodiscard]] long use_count() const noexcept
+    {
+      return region_.use_count();
+    }
+
+    [[nodiscard]] const std::shared_ptr<mapped_region>& region() const noexcept
+    {
+      return region_;
+    }
+
+  private:
+    template <typename> friend class mmap_handle;
+
+    std::shared_ptr<mapped_region> region_;
+    T*                             data_ = nullptr;
+  };
+
+  // ============================================================================
+  // ALLOCATOR
+  // ============================================================================
+
+  /**
+   * @brief The allocator of a frozen_vector_builder with mmap_storage_policy:
+   * where its mappings come from.
+   *
+   * A default-constructed allocator maps anonymous memory. One constructed
+   * with a path maps that file, created if need be, and the builder writes its
+   * elements straight into the page cache, so freezing persists them with no
+   * further copy. A builder reallocates by mapping the file anew, so reserve()
+   * the final size up front where it is known.
+   *
+   * As a standard allocator, allocate() always maps anonymous memory: the
+   * file holds one array.
+   */
+  template <typename T> class mmap_allocator {
+  public:
+    using value_type      = T;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using is_always_equal = std::false_type;
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    mmap_allocator() noexcept = default;
+
+    explicit mmap_allocator(mmap_options options) noexcept
+        : options_(options)
+    {}
+
+    /**
+     * @throws std::system_error if the file cannot be opened.
+     */
+    explicit mmap_allocator(
+        const std::filesystem::path& path, mmap_options options = {}
+    )
+        : options_(options)
+    {
+      const int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+      if (fd < 0) {
+        detail::throw_errno("frozen::mmap_allocator: open");
+      }
+      file_ = std::make_shared<const detail::file_descriptor>(fd);
+    }
+
+    template <typename U>
+    mmap_allocator(const mmap_allocator<U>& other) noexcept
+        : file_(other.file_)
+        , options_(other.options_)
+    {}
+
+    [[nodiscard]] T* allocate(std::size_t n)
+    {
+      return static_cast<T*>(map_anonymous(checked_bytes(n)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept
+    {
+      ::munmap(p, n * sizeof(T));
+    }
+
+    /**
+     * @brief Maps n writable elements: the first n of the file, which is
+     * resized to hold exactly them, or else anonymous memory.
+     *
+     * @throws std::system_error if the file cannot be resized or mapped.
+     */
+    [[nodiscard]] mmap_handle<T> map(std::size_t n) const
+    {
+      const std::size_t bytes = checked_bytes(n);
+      if (!file_) {
+        void* base   = map_anonymous(bytes);
+        auto  region = detail::adopt_mapping(base, bytes);
+        region->advise(options_);
+        return mmap_handle<T>(std::move(region), static_cast<T*>(base));
+      }
+
+      if (::ftruncate(file_->get(), static_cast<off_t>(bytes)) != 0) {
+        detail::throw_errno("frozen::mmap_allocator::map: ftruncate");
+      }
+      void* base = ::mmap(
+          nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, file_->get(), 0
+      );
+      if (base == MAP_FAILED) {
+        detail::throw_errno("frozen::mmap_allocator::map: mmap");
+      }
+      auto region = detail::adopt_mapping(base, bytes, file_);
+      region->advise(options_);
+      return mmap_handle<T>(std::move(region), static_cast<T*>(base));
+    }
+
+    [[nodiscard]] const mmap_options& options() const noexcept
+    {
+      return options_;
+    }
+
+    [[nodiscard]] bool file_backed() const noexcept { return file_ != nullptr; }
+
+    template <typename U>
+    [[nodiscard]] bool operator==(const mmap_allocator<U>& other) const noexcept
+    {
+      return file_ == other.file_;
+    }
+
+  private:
+    template <typename> friend class mmap_allocator;
+
+    std::shared_ptr<const detail::file_descriptor> file_;
+    mmap_options                                   options_;
+
+    [[nodiscard]] static std::size_t checked_bytes(std::size_t n)
+    {
+      if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+      }
+      return n * sizeof(T);
+    }
+
+    [[nodiscard]] static void* map_anonymous(std::size_t bytes)
+    {
+      void* base = ::mmap(
+          nullptr,
+          bytes,
+          PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS,
+          -1,
+          0
+      );
+      if (base == MAP_FAILED) {
+        throw std::bad_alloc();
+      }
+      return base;
+    }
+  };
+
+  // ============================================================================
+  // STORAGE POLICY
+  // ============================================================================
+
+  /**
+   * @brief Storage in a mapping from an mmap_allocator, for trivially copyable
+   * elements.
+   *
+   * The builder writes into a writable mapping. Freezing seals it: a file is
+   * cut to the elements written, and the pages are made read-only in place, so
+   * the frozen_vector reads the very pages the builder wrote. Builders are
+   * move-only, as two of them must not write one file.
+   */
+  template <typename T> struct mmap_storage_policy {
+    static_assert(
+        std::is_trivially_copyable_v<T>,
+        "Mapped storage holds trivially copyable elements only."
+    );
+
+    using mutable_handle_type = mmap_handle<T>;
+
+    [[nodiscard]]
+    static mutable_handle_type
+    allocate(std::size_t n, const mmap_allocator<T>& a)
+    {
+      if (n == 0) {
+        return mutable_handle_type();
+      }
+      return a.map(n);
+    }
+
+    static void seal(mutable_handle_type& handle, std::size_t n)
+    {
+      if (handle) {
+        handle.region()->seal(n * sizeof(T));
+      }
+    }
+  };
+
+  // ============================================================================
+  // READ-ONLY FILES
+  // ============================================================================
+
+  /**
+   * @brief Maps the array of T that a file holds from offset to its end,
+   * read-only.
+   *
+   * The file may be replaced once it is mapped, but must not be truncated or
+   * written in place while the vector is alive.
+   *
+   * @throws std::system_error if the file cannot be opened or mapped.
+   * @throws std::invalid_argument if offset is misaligned for T, or the bytes
+   * after it are not a whole number of elements.
+   */
+  template <typename T>
+  [[nodiscard]] frozen_vector<T, mmap_handle<const T>> map_file(
+      const std::filesystem::path& path,
+      mmap_options                 options = {},
+      std::size_t                  offset  = 0
+  )
+  {
+    static_assert(
+        std::is_trivially_copyable_v<T>,
+        "Mapped storage holds trivially copyable elements only."
+    );
+
+    if (offset % alignof(T) != 0) {
+      throw std::invalid_argument("frozen::map_file: misaligned offset");
+    }
+
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      detail::throw_errno("frozen::map_file: open");
+    }
+    const detail::file_descriptor file(fd);
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      detail::throw_errno("frozen::map_file: fstat");
+    }
+    const auto file_bytes = static_cast<std::size_t>(st.st_size);
+    if (offset > file_bytes || (file_bytes - offset) % sizeof(T) != 0) {
+      throw std::invalid_argument("frozen::map_file: partial element");
+    }
+
+    const std::size_t count = (file_bytes - offset) / sizeof(T);
+    if (count == 0) {
+      return {};
+    }
+
+    // mmap takes page-aligned offsets, so the mapping starts at the page that
+    // holds the first element.
+    const auto        page  = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const std::size_t start = offset - offset % page;
+    const std::size_t bytes = file_bytes - start;
+
+    void* base = ::mmap(
+        nullptr, bytes, PROT_READ, MAP_SHARED, fd, static_cast<off_t>(start)
+    );
+    if (base == MAP_FAILED) {
+      detail::throw_errno("frozen::map_file: mmap");
+    }
+    auto region = detail::adopt_mapping(base, bytes);
+    region->advise(options);
+
+    const auto* data = reinterpret_cast<const T*>(
+        static_cast<const std::byte*>(base) + (offset - start)
+    );
+    return frozen_vector<T, mmap_handle<const T>>(
+        mmap_handle<const T>(std::move(region), data), count
+    );
+  }
+
+} // namespace frozen
+
+#endif // FROZEN_MMAP_STORAGE_POLICY_HPP
@@ -1,12 +1,18 @@
 #ifndef VAULT_MAP_VIEW_HPP
 #define VAULT_MAP_VIEW_HPP
 
+#include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <functional> // For std::equal_to
+#include <iterator>
 #include <memory>    // For std::addressof
+#include <span>
 #include <stdexcept> // For std::out_of_range
 #include <utility>   // For std::pair
 
+#include <vault/algorithm/amac.hpp>
+
 namespace lib {
 
   // =============================================================================
@@ -22,6 +28,82 @@ namespace lib {
     bool inserted; ///< True if a new element was inserted.
   };
 
+  // =============================================================================
+  // Prehashed Keys
+  // =============================================================================
+
+  /**
+   * @brief A lookup key together with its hash, computed once.
+   * * Refers to the key, which must outlive it. The hash must be what the hash
+   * function of the containers it is looked up in gives for the key:
+   * map_view::prehash() computes it with the hash function of the viewed
+   * container, and the key may then be looked up in any view over containers
+   * with an equal hash function.
+   */
+  template <typename Key> class prehashed_key {
+  public:
+    constexpr prehashed_key(const Key& key, std::size_t hash) noexcept
+        : key_{std::addressof(key)}
+        , hash_{hash}
+    {}
+
+    [[nodiscard]] constexpr auto key() const noexcept -> const Key&
+    {
+      return *key_;
+    }
+
+    [[nodiscard]] constexpr auto hash() const noexcept -> std::size_t
+    {
+      return hash_;
+    }
+
+  private:
+    const Key*  key_;
+    std::size_t hash_;
+  };
+
+  /**
+   * @brief Transparent hasher adaptor that returns the cached hash of a
+   * prehashed_key, and forwards any other key to Hash.
+   * * Used with prehashed_equal as the hasher of an unordered container, a
+   * lookup by prehashed_key does not hash the key again.
+   */
+  template <typename Hash> struct prehashed_hash : Hash {
+    using is_transparent = void;
+    using Hash::operator();
+
+    template <typename Key>
+    [[nodiscard]] constexpr auto operator()(
+      const prehashed_key<Key>& key) const noexcept -> std::size_t
+    {
+      return key.hash();
+    }
+  };
+
+  /**
+   * @brief Transparent equality adaptor that compares the key of a
+   * prehashed_key, and forwards any other keys to Equal.
+   */
+  template <typename Equal = std::equal_to<>>
+  struct prehashed_equal : Equal {
+    using is_transparent = void;
+    using Equal::operator();
+
+    template <typename Key, typename Other>
+    [[nodiscard]] constexpr auto operator()(
+      const prehashed_key<Key>& lhs, const Other& rhs) const -> bool
+    {
+      return Equal::operator()(lhs.key(), rhs);
+    }
+
+    template <typename Other, typename Key>
+    [[nodiscard]] constexpr auto operator()(
+      const Other& lhs, const prehashed_key<Key>& rhs) const -> bool
+    {
+      return Equal::operator()(lhs, rhs.key());
+    }
+  };
+
   // =============================================================================
   // Concepts
   // =============================================================================
@@ -71,6 +153,81 @@ namespace lib {
 
   } // namespace concepts
 
+  namespace detail {
+
+    /**
+     * @brief Output iterator that writes the (needle, iterator) pairs of a
+     * container's batch_find into an array of value pointers, at the index
+     * of each needle, so the results may be reported in any order.
+     */
+    template <typename Container, typename ViewKey, typename Value>
+    struct find_many_output {
+      using difference_type = std::ptrdiff_t;
+
+      Container*     container;
+      const ViewKey* needles;
+      Value**        out;
+
+      auto operator*() noexcept -> find_many_output& { return *this; }
+      auto operator++() noexcept -> find_many_output& { return *this; }
+      auto operator++(int) noexcept -> find_many_output { return *this; }
+
+      template <typename NeedleIt, typename It>
+      auto operator=(const std::pair<NeedleIt, It>& result) -> find_many_output&
+      {
+        out[std::to_address(result.first) - needles] =
+          (result.second != container->end())
+          ? std::addressof(result.second->second)
+          : nullptr;
+        return *this;
+      }
+    };
+
+    /**
+     * @brief The hash of key by the container's hash function, or 0 for
+     * containers that do not hash.
+     */
+    template <typename Container, typename Key>
+    [[nodiscard]] auto hash_key(Container& c, const Key& key) -> std::size_t
+    {
+      if constexpr (requires {
+                      {
+                        c.hash_function()(key)
+                      } -> std::convertible_to<std::size_t>;
+                    }) {
+        return c.hash_function()(key);
+      } else {
+        return 0;
+      }
+    }
+
+    /**
+     * @brief Finds a prehashed key. Compile-time branch: containers whose
+     * hasher and equality accept a prehashed_key (see prehashed_hash) look
+     * it up without hashing, those with a (key, hash) lookup are given the
+     * hash, and the rest hash the key again.
+     */
+    template <typename Container, typename Key>
+    [[nodiscard]] auto find_prehashed(
+      Container& c, const prehashed_key<Key>& key)
+    {
+      if constexpr (requires(const typename Container::key_type& stored) {
+                      {
+                        c.hash_function()(key)
+                      } -> std::convertible_to<std::size_t>;
+                      { c.key_eq()(key, stored) } -> std::convertible_to<bool>;
+                      c.find(key);
+                    }) {
+        return c.find(key);
+      } else if constexpr (requires { c.find(key.key(), key.hash()); }) {
+        return c.find(key.key(), key.hash());
+      } else {
+        return c.find(key.key());
+      }
+    }
+
+  } // namespace detail
+
   // =============================================================================
   // map_view (Read-Only, Heterogeneous Optimized)
   // =============================================================================
@@ -82,6 +239,11 @@ namespace lib {
    * * container's native .contains() or .at() if available for the ViewKey.
    * * Otherwise, it generates an optimal fallback using .find().
    * *
+   * * Every single-key lookup is an indirect call. Large probe batches should
+   * * use find_many(), which makes one indirect call per batch, or visit(),
+   * * which hands the concrete container to a generic lambda. A key probed in
+   * * several views can be hashed once, with prehash().
+   * *
    * * @tparam ViewKey The type used for lookup (e.g., std::string_view).
    * * @tparam Value The value type (can be const or non-const).
    */
@@ -120,6 +282,73 @@ namespace lib {
       return vtable_ptr_->count(container_ptr_, key);
     }
 
+    /**
+     * @brief Hashes key once with the hash function of the viewed container,
+     * for lookups in this and other views.
+     */
+    [[nodiscard]] auto prehash(const ViewKey& key) const
+      -> prehashed_key<ViewKey>
+    {
+      return {key, vtable_ptr_->hash(container_ptr_, key)};
+    }
+
+    [[nodiscard]] auto contains(const prehashed_key<ViewKey>& key) const -> bool
+    {
+      return vtable_ptr_->find_prehashed(container_ptr_, key) != nullptr;
+    }
+
+    [[nodiscard]] auto find(const prehashed_key<ViewKey>& key) const -> Value*
+    {
+      return vtable_ptr_->find_prehashed(container_ptr_, key);
+    }
+
+    /**
+     * @brief Looks up a batch of keys with a single indirect call.
+     * * Writes to out[i] what find(keys[i]) returns. Compile-time branch: the
+     * container's native .find_many() is used if available, then its AMAC
+     * .batch_find() (e.g. eytzinger::layout_map), and otherwise an inlined
+     * loop over .find().
+     * * @pre out.size() >= keys.size()
+     */
+    auto find_many(std::span<const ViewKey> keys, std::span<Value*> out) const
+      -> void
+    {
+      assert(out.size() >= keys.size()
+        && "map_view::find_many - output is smaller than the keys");
+      vtable_ptr_->find_many(container_ptr_, keys, out.data());
+    }
+
+    /**
+     * @brief The viewed container, if it is a Container, or nullptr.
+     */
+    template <typename Container>
+    [[nodiscard]] auto target() const noexcept -> Container*
+    {
+      return (vtable_ptr_ == &vtable_storage<Container>)
+        ? static_cast<Container*>(container_ptr_)
+        : nullptr;
+    }
+
+    /**
+     * @brief Invokes f with the viewed container, if it is one of
+     * Containers, so that f runs against the concrete type, with its calls
+     * inlined.
+     * * @return Whether the container was one of Containers and f was
+     * invoked.
+     */
+    template <typename... Containers, typename F>
+      requires(std::invocable<F&, Containers&> && ...)
+    auto visit(F&& f) const -> bool
+    {
+      return ([&] {
+        if (auto* c = target<Containers>()) {
+          f(*c);
+          return true;
+        }
+        return false;
+      }() || ...);
+    }
+
     [[nodiscard]] auto size() const noexcept -> size_type
     {
       return vtable_ptr_->size(container_ptr_);
@@ -136,6 +365,9 @@ namespace lib {
       bool (*contains)(void*, const ViewKey&);
       Value* (*find)(void*, const ViewKey&);
       size_type (*count)(void*, const ViewKey&);
+      std::size_t (*hash)(void*, const ViewKey&);
+      Value* (*find_prehashed)(void*, const prehashed_key<ViewKey>&);
+      void (*find_many)(void*, std::span<const ViewKey>, Value**);
       size_type (*size)(void*) noexcept;
       bool (*empty)(void*) noexcept;
     };
@@ -181,6 +413,39 @@ namespace lib {
             return (c.find(key) != c.end()) ? 1 : 0;
           }
         },
+        .hash = [](void* ptr, const ViewKey& key) -> std::size_t {
+          return detail::hash_key(*static_cast<Container*>(ptr), key);
+        },
+        .find_prehashed =
+          [](void* ptr, const prehashed_key<ViewKey>& key) -> Value* {
+          auto& c  = *static_cast<Container*>(ptr);
+          auto  it = detail::find_prehashed(c, key);
+          return (it != c.end()) ? std::addressof(it->second) : nullptr;
+        },
+        .find_many =
+          [](void* ptr, std::span<const ViewKey> keys, Value** out) -> void {
+          auto& c = *static_cast<Container*>(ptr);
+          using output_t = detail::find_many_output<Container, ViewKey, Value>;
+          // Compile-time branch: Use native .find_many(), then the AMAC
+          // batch lookup, before a loop the compiler can inline
+          if constexpr (requires {
+                          c.find_many(keys, std::span<Value*>{out, keys.size()});
+                        }) {
+            c.find_many(keys, std::span<Value*>{out, keys.size()});
+          } else if constexpr (requires {
+                                 c.batch_find(vault::amac::coordinator<>,
+                                   keys,
+                                   output_t{&c, keys.data(), out});
+                               }) {
+            c.batch_find(
+              vault::amac::coordinator<>, keys, output_t{&c, keys.data(), out});
+          } else {
+            for (std::size_t i = 0; i < keys.size(); ++i) {
+              auto it = c.find(keys[i]);
+              out[i]  = (it != c.end()) ? std::addressof(it->second) : nullptr;
+            }
+          }
+        },
         .size = [](void* ptr) noexcept -> size_type {
           return static_cast<Container*>(ptr)->size();
         },
@@ -232,6 +497,30 @@ namespace lib {
       return vtable_ptr_->find(container_ptr_, key);
     }
 
+    // --- Prehashed Lookup ---
+
+    /**
+     * @brief Hashes key once with the hash function of the viewed container,
+     * for lookups in this and other views.
+     */
+    [[nodiscard]] auto prehash(const StoredKey& key) const
+      -> prehashed_key<StoredKey>
+    {
+      return {key, vtable_ptr_->hash(container_ptr_, key)};
+    }
+
+    [[nodiscard]] auto contains(const prehashed_key<StoredKey>& key) const
+      -> bool
+    {
+      return vtable_ptr_->find_prehashed(container_ptr_, key) != nullptr;
+    }
+
+    [[nodiscard]] auto find(const prehashed_key<StoredKey>& key) const
+      -> Value*
+    {
+      return vtable_ptr_->find_prehashed(container_ptr_, key);
+    }
+
     // --- Capacity ---
 
     [[nodiscard]] auto size() const noexcept -> size_type
@@ -276,6 +565,9 @@ namespace lib {
       bool (*contains)(void*, const StoredKey&);
       Value* (*find)(void*, const StoredKey&);
 
+      std::size_t (*hash)(void*, const StoredKey&);
+      Value* (*find_prehashed)(void*, const prehashed_key<StoredKey>&);
+
       bool (*empty)(void*) noexcept;
       size_type (*size)(void*) noexcept;
       size_type (*max_size)(void*) noexcept;
@@ -317,6 +609,15 @@ namespace lib {
         auto  it = c.find(key);
         return (it != c.end()) ? std::addressof(it->second) : nullptr;
       },
+      .hash = [](void* ptr, const StoredKey& key) -> std::size_t {
+        return detail::hash_key(*static_cast<Container*>(ptr), key);
+      },
+      .find_prehashed =
+        [](void* ptr, const prehashed_key<StoredKey>& key) -> Value* {
+        auto& c  = *static_cast<Container*>(ptr);
+        auto  it = detail::find_prehashed(c, key);
+        return (it != c.end()) ? std::addressof(it->second) : nullptr;
+      },
       .empty = [](void* ptr) noexcept -> bool {
         return static_cast<Container*>(ptr)->empty();
       },
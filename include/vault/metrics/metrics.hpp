@@ -0,0 +1,396 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Metrics are recorded if this is defined to 1, which the METRICS project option does for every
+// target that links vault::metrics. Otherwise every metric is an empty object whose operations do
+// nothing, no clock is read, and snapshot() is empty. Every translation unit of a program must see
+// the same value.
+#if !defined(VAULT_METRICS)
+#define VAULT_METRICS 0
+#endif
+
+namespace vault::metrics {
+
+  inline constexpr bool enabled = VAULT_METRICS != 0;
+
+  enum class metric_kind : std::uint8_t {
+    counter,   // A total, such as the hits of a cache.
+    histogram, // A distribution, such as the nanoseconds of a phase.
+  };
+
+  /**
+   * @brief The totals of one metric at one point, over every thread.
+   *
+   * For a counter, count and sum are both its total, and the buckets are empty. For a histogram,
+   * count is the number of samples, sum their sum, and bucket k counts the samples in
+   * [2^(k-1), 2^k), with bucket 0 counting the zeros.
+   */
+  struct metric_snapshot {
+    static constexpr std::size_t bucket_count = 65;
+
+    std::string_view                        name;
+    metric_kind                             kind  = metric_kind::counter;
+    std::uint64_t                           count = 0;
+    std::uint64_t                           sum   = 0;
+    std::array<std::uint64_t, bucket_count> buckets{};
+
+    [[nodiscard]] double mean() const noexcept {
+      return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+    }
+
+    /**
+     * @brief An upper bound of the q-quantile of the samples of a histogram: the largest value of
+     * the bucket that holds it, so at most twice the quantile itself.
+     */
+    [[nodiscard]] std::uint64_t quantile(double q) const noexcept {
+      auto const rank = static_cast<std::uint64_t>(std::clamp(q, 0.0, 1.0) * static_cast<double>(count));
+
+      auto seen = std::uint64_t{0};
+      for (auto k = std::size_t{0}; k < bucket_count; ++k) {
+        seen += buckets[k];
+        if (seen > rank || (seen == count && buckets[k] != 0)) {
+          return k == 0 ? 0 : k == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << k) - 1;
+        }
+      }
+      return 0;
+    }
+  };
+
+  /**
+   * @brief The totals of every metric at one point.
+   */
+  struct metrics_snapshot {
+    std::vector<metric_snapshot> metrics;
+
+    /**
+     * @brief The metric named name, or nullptr if there is none.
+     */
+    [[nodiscard]] const metric_snapshot* find(std::string_view name) const noexcept {
+      auto const it = std::ranges::find(metrics, name, &metric_snapshot::name);
+      return it == metrics.end() ? nullptr : &*it;
+    }
+
+    /**
+     * @brief What was recorded between earlier and this snapshot. Metrics registered after
+     * earlier are taken whole.
+     */
+    [[nodiscard]] metrics_snapshot since(const metrics_snapshot& earlier) const {
+      auto result = *this;
+      for (auto& metric : result.metrics) {
+        if (const auto* before = earlier.find(metric.name)) {
+          metric.count -= before->count;
+          metric.sum -= before->sum;
+          for (auto k = std::size_t{0}; k < metric_snapshot::bucket_count; ++k) {
+            metric.buckets[k] -= before->buckets[k];
+          }
+        }
+      }
+      return result;
+    }
+  };
+
+  namespace detail {
+
+    // The values of a histogram: its count, its sum and its buckets.
+    inline constexpr std::size_t histogram_slots = 2 + metric_snapshot::bucket_count;
+
+    // The values a thread records. The first histogram_slots take the samples of the metrics that
+    // did not fit, and of those used before they were constructed, and are never reported.
+    inline constexpr std::size_t slot_capacity = 4096;
+
+    struct thread_slots {
+      // Only the owning thread writes, so a slot is updated with a load and a store rather than a
+      // locked read-modify-write, and readers on other threads see whole values.
+      std::array<std::atomic<std::uint64_t>, slot_capacity> values{};
+
+      void add(std::size_t slot, std::uint64_t n) noexcept {
+        auto& value = values[slot];
+        value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+      }
+    };
+
+    struct metric_entry {
+      std::string_view name;
+      metric_kind      kind;
+      std::size_t      offset;
+    };
+
+    /**
+     * @brief The metrics of the process and the slots of every thread that recorded one.
+     *
+     * The slots of a thread are folded into the retired totals when the thread exits.
+     */
+    class registry {
+      std::mutex                               m_mutex;
+      std::vector<metric_entry>                m_metrics;
+      std::size_t                              m_next_offset = histogram_slots;
+      std::vector<thread_slots*>               m_threads;
+      std::array<std::uint64_t, slot_capacity> m_retired{};
+
+    public:
+      // Never destroyed, so that threads that exit after main can still detach.
+      [[nodiscard]] static registry& instance() {
+        static auto* const registry_instance = new registry{};
+        return *registry_instance;
+      }
+
+      [[nodiscard]] std::size_t add(std::string_view name, metric_kind kind) {
+        const auto slots = kind == metric_kind::counter ? std::size_t{1} : histogram_slots;
+
+        std::lock_guard lock(m_mutex);
+        if (m_next_offset + slots > slot_capacity) {
+          return 0;
+        }
+        const auto offset = std::exchange(m_next_offset, m_next_offset + slots);
+        m_metrics.push_back({name, kind, offset});
+        return offset;
+      }
+
+      void attach(thread_slots* slots) {
+        std::lock_guard lock(m_mutex);
+        m_threads.push_back(slots);
+      }
+
+      void detach(thread_slots* slots) noexcept {
+        std::lock_guard lock(m_mutex);
+        for (auto i = std::size_t{0}; i < slot_capacity; ++i) {
+          m_retired[i] += slots->values[i].load(std::memory_order_relaxed);
+        }
+        std::erase(m_threads, slots);
+      }
+
+      [[nodiscard]] metrics_snapshot snapshot() {
+        std::lock_guard lock(m_mutex);
+
+        const auto total = [&](std::size_t slot) {
+          auto value = m_retired[slot];
+          for (const auto* thread : m_threads) {
+            value += thread->values[slot].load(std::memory_order_relaxed);
+          }
+          return value;
+        };
+
+        auto result = metrics_snapshot{};
+        result.metrics.reserve(m_metrics.size());
+        for (const auto& entry : m_metrics) {
+          auto& metric = result.metrics.emplace_back();
+          metric.name  = entry.name;
+          metric.kind  = entry.kind;
+          if (entry.kind == metric_kind::counter) {
+            metric.count = total(entry.offset);
+            metric.sum   = metric.count;
+          } else {
+            metric.count = total(entry.offset);
+            metric.sum   = total(entry.offset + 1);
+            for (auto k = std::size_t{0}; k < metric_snapshot::bucket_count; ++k) {
+              metric.buckets[k] = total(entry.offset + 2 + k);
+            }
+          }
+        }
+        return result;
+      }
+    };
+
+    // Takes the samples of threads whose slots could not be allocated, and is never reported.
+    inline thread_slots discarded_slots;
+
+    // Allocates the slots of a thread when it first records, and retires them when it exits.
+    class thread_slots_owner {
+      thread_slots* m_slots = nullptr;
+
+      void attach() noexcept {
+        auto slots = std::unique_ptr<thread_slots>(new (std::nothrow) thread_slots{});
+        if (slots == nullptr) {
+          return;
+        }
+        try {
+          registry::instance().attach(slots.get());
+        } catch (...) {
+          return;
+        }
+        m_slots = slots.release();
+      }
+
+    public:
+      thread_slots_owner() = default;
+
+      thread_slots_owner(const thread_slots_owner&)            = delete;
+      thread_slots_owner& operator=(const thread_slots_owner&) = delete;
+
+      ~thread_slots_owner() {
+        if (m_slots != nullptr) {
+          registry::instance().detach(m_slots);
+          delete m_slots;
+        }
+      }
+
+      // Recording never throws, so that it may be done from noexcept code: a thread whose slots
+      // cannot be allocated records into discarded_slots instead.
+      [[nodiscard]] thread_slots& get() noexcept {
+        if (m_slots == nullptr) [[unlikely]] {
+          attach();
+        }
+        return m_slots != nullptr ? *m_slots : discarded_slots;
+      }
+    };
+
+    inline thread_local thread_slots_owner local_slots;
+
+    inline void record(std::size_t slot, std::uint64_t n) noexcept {
+      local_slots.get().add(slot, n);
+    }
+
+    // Registers a metric and keeps its first slot. With metrics disabled there are no slots, and
+    // it is empty. Registering takes a lock, so it is never a constant expression, but being a
+    // template spares the constructors of the metrics from saying so.
+    template <bool Enabled = enabled>
+    class metric_offset {
+      std::size_t m_value;
+
+    public:
+      constexpr metric_offset(std::string_view name, metric_kind kind)
+        : m_value(registry::instance().add(name, kind)) {}
+
+      [[nodiscard]] constexpr std::size_t get() const noexcept {
+        return m_value;
+      }
+    };
+
+    template <>
+    class metric_offset<false> {
+    public:
+      constexpr metric_offset(std::string_view, metric_kind) noexcept {}
+
+      [[nodiscard]] constexpr std::size_t get() const noexcept {
+        return 0;
+      }
+    };
+
+  } // namespace detail
+
+  /**
+   * @brief A named total, added to from any thread.
+   *
+   * Metrics are meant to be defined once, as inline variables of namespace scope, with a name
+   * that outlives the program such as a string literal. Adding to a counter is an add to a
+   * thread-local slot; with metrics disabled it is nothing at all, and may be done in a constant
+   * expression.
+   */
+  class counter {
+    [[no_unique_address]] detail::metric_offset<> m_offset;
+
+  public:
+    [[nodiscard]] constexpr explicit counter(std::string_view name)
+      : m_offset(name, metric_kind::counter) {}
+
+    constexpr void add(std::uint64_t n = 1) const noexcept {
+      if constexpr (enabled) {
+        if !consteval {
+          detail::record(m_offset.get(), n);
+        }
+      }
+    }
+  };
+
+  /**
+   * @brief A named distribution of values, recorded from any thread into power-of-two buckets.
+   *
+   * See counter for how to define one and what recording costs.
+   */
+  class histogram {
+    [[no_unique_address]] detail::metric_offset<> m_offset;
+
+  public:
+    [[nodiscard]] constexpr explicit histogram(std::string_view name)
+      : m_offset(name, metric_kind::histogram) {}
+
+    constexpr void record(std::uint64_t value) const noexcept {
+      if constexpr (enabled) {
+        if !consteval {
+          auto&      slots  = detail::local_slots.get();
+          auto const offset = m_offset.get();
+          slots.add(offset, 1);
+          slots.add(offset + 1, value);
+          slots.add(offset + 2 + static_cast<std::size_t>(std::bit_width(value)), 1);
+        }
+      }
+    }
+  };
+
+  // With metrics disabled, a metric takes no storage and may be defined and recorded in a
+  // constant expression.
+  static_assert(enabled || (std::is_empty_v<counter> && std::is_empty_v<histogram>));
+  static_assert(
+    enabled || (counter{"vault.metrics.disabled"}.add(), histogram{"vault.metrics.disabled"}.record(1), true)
+  );
+
+  /**
+   * @brief Records the nanoseconds from its construction to its destruction into a histogram.
+   *
+   * With metrics disabled, no clock is read.
+   */
+  class scoped_timer {
+    using clock_t = std::chrono::steady_clock;
+
+    const histogram*    m_histogram;
+    clock_t::time_point m_start;
+
+  public:
+    [[nodiscard]] explicit scoped_timer(const histogram& target) noexcept
+      : m_histogram(&target)
+      , m_start(enabled ? clock_t::now() : clock_t::time_point{}) {}
+
+    scoped_timer(const scoped_timer&)            = delete;
+    scoped_timer& operator=(const scoped_timer&) = delete;
+
+    ~scoped_timer() {
+      if constexpr (enabled) {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_t::now() - m_start);
+        m_histogram->record(static_cast<std::uint64_t>(elapsed.count()));
+      }
+    }
+  };
+
+  /**
+   * @brief The totals of every metric registered so far, over every thread that recorded one,
+   * live or exited. Empty with metrics disabled.
+   *
+   * Threads may record while a snapshot is taken, so its metrics need not be of one instant, but
+   * each value is one that was recorded.
+   */
+  [[nodiscard]] inline metrics_snapshot snapshot() {
+    if constexpr (enabled) {
+      return detail::registry::instance().snapshot();
+    } else {
+      return {};
+    }
+  }
+
+  /**
+   * @brief Calls fn with every metric of a snapshot taken now, to hand them to a logging or
+   * monitoring system.
+   */
+  template <std::invocable<const metric_snapshot&> Fn>
+  void export_metrics(Fn&& fn) {
+    for (const auto& metric : snapshot().metrics) {
+      std::invoke(fn, metric);
+    }
+  }
+
+} // namespace vault::metrics
@@ -0,0 +1,511 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include <vault/segmented_vector/segment_growth.hpp>
+
+/**
+ * @brief concurrent_segmented_vector
+ * An append-only variant of segmented_vector that many threads can append
+ * to at once, without a lock, while others read.
+ *
+ * Blocks have the sizes of segmented_vector's and never move, so every
+ * element keeps its address. An append reserves an index with a fetch-add,
+ * installs the block holding it with a CAS if no other thread has yet, and
+ * constructs the element in place. If all elements before it are
+ * published, a CAS publishes it; otherwise it sets its bit in the ready
+ * bitmap of the block, and the append that publishes the elements before
+ * it publishes it too. No append waits for a slower one, and a reader may
+ * access every element below a size() it has loaded.
+ *
+ * The allocator is used concurrently and must be thread-safe.
+ *
+ * * Invariants Enforced:
+ * 1. InitialCapacity is always a power of 2.
+ * 2. m_published <= m_reserved.
+ * 3. Every element below m_published is constructed, as is every element
+ * at or above it whose ready bit is set.
+ * 4. An installed block and its bitmap stay installed until destruction.
+ */
+template <
+    typename T,
+    typename Allocator       = std::allocator<T>,
+    typename InitialCapacity = std::integral_constant<
+        std::size_t,
+        (sizeof(T) > 4096) ? 1 : std::bit_floor(4096 / sizeof(T))>>
+class concurrent_segmented_vector {
+  // -------------------------------------------------------------------------
+  // Compile-Time Assertions
+  // -------------------------------------------------------------------------
+  static_assert(
+      std::is_object_v<T>,
+      "concurrent_segmented_vector cannot hold references or void. Use "
+      "std::reference_wrapper for references."
+  );
+
+  static_assert(
+      std::has_single_bit(InitialCapacity::value),
+      "InitialCapacity must be a power of 2 for fast bitwise indexing."
+  );
+
+  static_assert(
+      std::is_same_v<typename std::allocator_traits<Allocator>::value_type, T>,
+      "Allocator::value_type must match the container's value_type T."
+  );
+
+  static constexpr std::size_t k_initial_cap = InitialCapacity::value;
+  static constexpr int k_initial_shift       = std::countr_zero(k_initial_cap);
+
+  // Enough blocks to address every size_t index.
+  static constexpr std::size_t k_max_blocks =
+      std::numeric_limits<std::size_t>::digits - k_initial_shift + 1;
+
+public:
+  using value_type      = T;
+  using allocator_type  = Allocator;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference       = value_type&;
+  using const_reference = const value_type&;
+
+  using AllocTraits = std::allocator_traits<Allocator>;
+
+private:
+  using Word           = std::atomic<std::uint64_t>;
+  using WordAllocator  = typename AllocTraits::template rebind_alloc<Word>;
+  using WordTraits     = std::allocator_traits<WordAllocator>;
+  static constexpr int k_word_bits = 64;
+
+  [[no_unique_address]] Allocator m_allocator;
+
+  std::array<std::atomic<T*>, k_max_blocks>    m_blocks{};
+  std::array<std::atomic<Word*>, k_max_blocks> m_ready{};
+
+  // Appends contend on both counters; separate lines keep a reservation
+  // from invalidating the line readers load the published size from.
+  alignas(64) std::atomic<size_type> m_reserved{0};
+  alignas(64) std::atomic<size_type> m_published{0};
+
+  // -------------------------------------------------------------------------
+  // Internal Helpers
+  // -------------------------------------------------------------------------
+
+  // The doubling layout of segmented_vector, over every index rather than
+  // the allocated ones. The fixed block table rules out capped growth.
+  using Layout = segment_layout<doubling_growth, sizeof(T), k_initial_cap>;
+
+  [[nodiscard]] [[gnu::always_inline]] static inline std::pair<
+      size_type,
+      size_type>
+  get_location(size_type index) noexcept
+  {
+    return Layout::location(index);
+  }
+
+  [[nodiscard]] static constexpr size_type
+  get_block_capacity(size_type block_idx) noexcept
+  {
+    assert(block_idx < k_max_blocks && "Block index out of range");
+    return Layout::block_capacity(block_idx);
+  }
+
+  [[nodiscard]] static constexpr size_type
+  get_word_count(size_type block_idx) noexcept
+  {
+    return (get_block_capacity(block_idx) + k_word_bits - 1) / k_word_bits;
+  }
+
+  // Returns the pointer in slot, first installing make() with a CAS if it
+  // is null. A thread that loses the race frees its own with drop().
+  template <typename P, typename Make, typename Drop>
+  static P* install(std::atomic<P*>& slot, Make make, Drop drop)
+  {
+    P* current = slot.load(std::memory_order_acquire);
+    if (current != nullptr) [[likely]] {
+      return current;
+    }
+
+    P* fresh = make();
+    if (slot.compare_exchange_strong(
+            current, fresh, std::memory_order_acq_rel, std::memory_order_acquire
+        )) {
+      return fresh;
+    }
+    drop(fresh);
+    return current;
+  }
+
+  // Installs block k and its bitmap. The bitmap goes first, so a thread
+  // that sees the block also sees the bitmap.
+  T* install_block(size_type k)
+  {
+    const size_type words = get_word_count(k);
+    install(
+        m_ready[k],
+        [&] {
+          WordAllocator alloc(m_allocator);
+          Word*         bitmap = WordTraits::allocate(alloc, words);
+          for (size_type i = 0; i < words; ++i) {
+            WordTraits::construct(alloc, bitmap + i, std::uint64_t{0});
+          }
+          return bitmap;
+        },
+        [&](Word* bitmap) {
+          WordAllocator alloc(m_allocator);
+          WordTraits::deallocate(alloc, bitmap, words);
+        }
+    );
+
+    const size_type capacity = get_block_capacity(k);
+    return install(
+        m_blocks[k],
+        [&] { return AllocTraits::allocate(m_allocator, capacity); },
+        [&](T* block) { AllocTraits::deallocate(m_allocator, block, capacity); }
+    );
+  }
+
+  // The number of ready elements from index on, up to the end of its
+  // bitmap word.
+  [[nodiscard]] size_type ready_run(size_type index) const noexcept
+  {
+    auto [k, off] = get_location(index);
+    const Word* bitmap = m_ready[k].load(std::memory_order_acquire);
+    if (bitmap == nullptr) {
+      return 0;
+    }
+    const std::uint64_t bits = bitmap[off / k_word_bits].load() >>
+                               (off % k_word_bits);
+    return static_cast<size_type>(std::countr_one(bits));
+  }
+
+  // Installs the block of the indices [off, off + count) of block k, and
+  // the next block if they cover the middle of this one, so that the
+  // appends that reach the next block rarely race to allocate it.
+  T* reserve_block(size_type k, size_type off, size_type count)
+  {
+    const size_type half = get_block_capacity(k) / 2;
+    if (off <= half && half < off + count && k + 1 < k_max_blocks)
+        [[unlikely]] {
+      install_block(k + 1);
+    }
+    return install_block(k);
+  }
+
+  // Sets the ready bits of the constructed indices [first, first + count).
+  void mark_ready(size_type first, size_type count) noexcept
+  {
+    while (count > 0) {
+      auto [k, off]       = get_location(first);
+      const size_type bit = off % k_word_bits;
+      const size_type n   = std::min(
+          {count, k_word_bits - bit, get_block_capacity(k) - off}
+      );
+      const std::uint64_t mask =
+          (n == k_word_bits ? ~std::uint64_t{0} : (std::uint64_t{1} << n) - 1)
+          << bit;
+      m_ready[k].load(std::memory_order_relaxed)[off / k_word_bits].fetch_or(
+          mask
+      );
+      first += n;
+      count -= n;
+    }
+  }
+
+  // Advances the published size from published past every ready element
+  // that follows it. The bits and the counter are accessed sequentially
+  // consistently: a thread that sets a bit and then loads the size either
+  // sees a size past the bit, or the thread whose CAS stopped short of it
+  // has loaded the bit after it was set.
+  void publish(size_type published) noexcept
+  {
+    for (;;) {
+      const size_type run = ready_run(published);
+      if (run == 0) {
+        return;
+      }
+      if (m_published.compare_exchange_weak(published, published + run)) {
+        published += run;
+      }
+    }
+  }
+
+  // Publishes the constructed indices [first, first + count). If all
+  // before them are published, a CAS publishes them directly, without
+  // their ready bits; otherwise they wait for those in the bitmap.
+  void commit(size_type first, size_type count) noexcept
+  {
+    size_type expected = first;
+    if (m_published.compare_exchange_strong(expected, first + count)) {
+      // The size was just written, so it is not loaded again: a load right
+      // after the CAS costs more than the rest of the append.
+      publish(first + count);
+    } else {
+      mark_ready(first, count);
+      publish(m_published.load());
+    }
+  }
+
+  // Invokes func(element) with every constructed element, whether or not
+  // it is published. Published elements may lack their ready bit.
+  template <typename Func> void for_each_constructed(Func&& func)
+  {
+    const size_type published = m_published.load(std::memory_order_relaxed);
+
+    // Blocks may be installed out of order, by appends that reserved an
+    // index in a later block first.
+    size_type start = 0;
+    for (size_type k = 0; k < k_max_blocks; start += get_block_capacity(k++)) {
+      T*              block    = m_blocks[k].load(std::memory_order_relaxed);
+      Word*           bitmap   = m_ready[k].load(std::memory_order_relaxed);
+      const size_type capacity = get_block_capacity(k);
+      if (block == nullptr) {
+        continue;
+      }
+
+      const size_type below =
+          published > start ? std::min(published - start, capacity) : 0;
+      for (size_type i = 0; i < below; ++i) {
+        func(block[i]);
+      }
+
+      for (size_type w = below / k_word_bits; w < get_word_count(k); ++w) {
+        std::uint64_t bits = bitmap[w].load(std::memory_order_relaxed);
+        if (w == below / k_word_bits) {
+          bits &= ~std::uint64_t{0} << (below % k_word_bits);
+        }
+        while (bits != 0) {
+          const int bit = std::countr_zero(bits);
+          bits &= bits - 1;
+          func(block[w * k_word_bits + static_cast<size_type>(bit)]);
+        }
+      }
+    }
+  }
+
+  void destroy_all() noexcept
+  {
+    for_each_constructed([this](T& element) {
+      AllocTraits::destroy(m_allocator, std::addressof(element));
+    });
+  }
+
+  void deallocate_all_blocks() noexcept
+  {
+    WordAllocator alloc(m_allocator);
+    for (size_type k = 0; k < k_max_blocks; ++k) {
+      if (T* block = m_blocks[k].exchange(nullptr)) {
+        AllocTraits::deallocate(m_allocator, block, get_block_capacity(k));
+      }
+      if (Word* bitmap = m_ready[k].exchange(nullptr)) {
+        WordTraits::deallocate(alloc, bitmap, get_word_count(k));
+      }
+    }
+  }
+
+public:
+  // -------------------------------------------------------------------------
+  // Constructors
+  // -------------------------------------------------------------------------
+
+  [[nodiscard]] concurrent_segmented_vector(
+  ) noexcept(std::is_nothrow_default_constructible_v<Allocator>)
+      : m_allocator()
+  {}
+
+  [[nodiscard]] explicit concurrent_segmented_vector(const Allocator& alloc)
+      : m_allocator(alloc)
+  {}
+
+  // The container is shared by its producers by reference, so it is
+  // neither copied nor moved.
+  concurrent_segmented_vector(const concurrent_segmented_vector&) = delete;
+  concurrent_segmented_vector&
+  operator=(const concurrent_segmented_vector&) = delete;
+
+  ~concurrent_segmented_vector()
+  {
+    destroy_all();
+    deallocate_all_blocks();
+  }
+
+  // -------------------------------------------------------------------------
+  // Concurrent Append
+  // -------------------------------------------------------------------------
+
+  void push_back(const T& value) { emplace_back(value); }
+
+  void push_back(T&& value) { emplace_back(std::move(value)); }
+
+  /**
+   * @brief Appends an element. Safe to call from any number of threads,
+   * concurrently with each other and with the readers.
+   *
+   * The element is published, i.e. below size(), once every element
+   * reserved before it is constructed. If the allocation or the
+   * constructor throws, the index it reserved is never published, and
+   * neither is any later one; the elements that were constructed are
+   * still destroyed with the container.
+   */
+  template <typename... Args> reference emplace_back(Args&&... args)
+  {
+    const size_type index = m_reserved.fetch_add(1, std::memory_order_relaxed);
+    auto [k, off]         = get_location(index);
+
+    T* slot = reserve_block(k, off, 1) + off;
+    AllocTraits::construct(m_allocator, slot, std::forward<Args>(args)...);
+    commit(index, 1);
+    return *slot;
+  }
+
+  /**
+   * @brief Appends the elements of range at consecutive indices, with one
+   * reservation and, when the elements before them are published, one
+   * publication for all of them. Safe to call like emplace_back.
+   *
+   * If an allocation or a constructor throws, the elements constructed
+   * before it are published, if the ones before them are, but the rest
+   * and every later index never are.
+   */
+  template <std::ranges::input_range R>
+    requires std::ranges::sized_range<R> &&
+             std::constructible_from<T, std::ranges::range_reference_t<R>>
+  void append_range(R&& range)
+  {
+    const auto count = static_cast<size_type>(std::ranges::size(range));
+    if (count == 0) {
+      return;
+    }
+    const size_type first =
+        m_reserved.fetch_add(count, std::memory_order_relaxed);
+    const size_type last = first + count;
+
+    auto      it    = std::ranges::begin(range);
+    size_type index = first;
+    try {
+      while (index < last) {
+        auto [k, off]        = get_location(index);
+        const size_type stop =
+            std::min(last, index + get_block_capacity(k) - off);
+        T* slot = reserve_block(k, off, stop - index) + off;
+        for (; index < stop; ++index, ++it, ++slot) {
+          AllocTraits::construct(m_allocator, slot, *it);
+        }
+      }
+    } catch (...) {
+      mark_ready(first, index - first);
+      publish(m_published.load());
+      throw;
+    }
+    commit(first, count);
+  }
+
+  // -------------------------------------------------------------------------
+  // Access & Size
+  // -------------------------------------------------------------------------
+
+  /**
+   * @brief The number of published elements. Every index below it may be
+   * accessed, from any thread, while appends continue.
+   */
+  [[nodiscard]] size_type size() const noexcept
+  {
+    return m_published.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+  [[nodiscard]] size_type max_size() const noexcept
+  {
+    return AllocTraits::max_size(m_allocator);
+  }
+
+  [[nodiscard]] reference operator[](size_type index) noexcept
+  {
+    assert(index < size() && "operator[] index out of bounds");
+    auto [k, off] = get_location(index);
+    // The block was installed before the element was published, so the
+    // acquire load in size() has already made it visible.
+    return m_blocks[k].load(std::memory_order_relaxed)[off];
+  }
+
+  [[nodiscard]] const_reference operator[](size_type index) const noexcept
+  {
+    assert(index < size() && "operator[] index out of bounds");
+    auto [k, off] = get_location(index);
+    return m_blocks[k].load(std::memory_order_relaxed)[off];
+  }
+
+  [[nodiscard]] reference at(size_type index)
+  {
+    if (index >= size()) {
+      throw std::out_of_range("concurrent_segmented_vector::at");
+    }
+    return (*this)[index];
+  }
+
+  [[nodiscard]] const_reference at(size_type index) const
+  {
+    if (index >= size()) {
+      throw std::out_of_range("concurrent_segmented_vector::at");
+    }
+    return (*this)[index];
+  }
+
+  [[nodiscard]] allocator_type get_allocator() const noexcept
+  {
+    return m_allocator;
+  }
+
+  /**
+   * @brief Destroys every element. Not thread-safe: no append or read may
+   * run concurrently. The blocks are kept for reuse.
+   */
+  void clear() noexcept
+  {
+    destroy_all();
+    for (size_type k = 0; k < k_max_blocks; ++k) {
+      if (Word* bitmap = m_ready[k].load(std::memory_order_relaxed)) {
+        for (size_type w = 0; w < get_word_count(k); ++w) {
+          bitmap[w].store(0, std::memory_order_relaxed);
+        }
+      }
+    }
+    m_reserved.store(0);
+    m_published.store(0);
+  }
+
+  // -------------------------------------------------------------------------
+  // High-Performance Block Iteration
+  // -------------------------------------------------------------------------
+
+  /**
+   * @brief Invokes func with every element below the size() loaded on
+   * entry, block by block. Safe to call while appends continue.
+   */
+  template <typename Func> void for_each_segment(Func&& func) const
+  {
+    size_type remaining = size();
+    for (size_type k = 0; remaining > 0; ++k) {
+      const T*        ptr   = m_blocks[k].load(std::memory_order_relaxed);
+      const size_type count = std::min(get_block_capacity(k), remaining);
+
+      for (size_type i = 0; i < count; ++i) {
+        func(ptr[i]);
+      }
+      remaining -= count;
+    }
+  }
+};
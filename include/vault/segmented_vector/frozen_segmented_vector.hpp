@@ -0,0 +1,422 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <vault/segmented_vector/segment_growth.hpp>
+
+template <
+    typename T,
+    typename Allocator,
+    typename InitialCapacity,
+    typename GrowthPolicy>
+class segmented_vector;
+
+/**
+ * @brief frozen_segmented_vector
+ * An immutable, cheaply copyable view of the blocks of a segmented_vector,
+ * made by segmented_vector::freeze() without copying an element.
+ *
+ * The blocks are owned by a reference-counted segment table, which destroys
+ * the elements and frees the blocks with the last copy of the view. Copies
+ * share the table, so publishing a frozen vector to readers costs a
+ * reference count, and every element keeps the address it had in the
+ * segmented_vector. Indexing uses the same block layout as segmented_vector.
+ *
+ * * Invariants Enforced:
+ * 1. InitialCapacity is always a power of 2, and it and GrowthPolicy match
+ * the segmented_vector the blocks came from.
+ * 2. m_blocks and m_size mirror the segment table of m_table.
+ */
+template <
+    typename T,
+    typename Allocator       = std::allocator<T>,
+    typename InitialCapacity = std::integral_constant<
+        std::size_t,
+        (sizeof(T) > 4096) ? 1 : std::bit_floor(4096 / sizeof(T))>,
+    typename GrowthPolicy = doubling_growth>
+class frozen_segmented_vector {
+  // -------------------------------------------------------------------------
+  // Compile-Time Assertions
+  // -------------------------------------------------------------------------
+  static_assert(
+      std::has_single_bit(InitialCapacity::value),
+      "InitialCapacity must be a power of 2 for fast bitwise indexing."
+  );
+
+  static constexpr std::size_t k_initial_cap = InitialCapacity::value;
+
+  using Layout = segment_layout<GrowthPolicy, sizeof(T), k_initial_cap>;
+
+  friend class segmented_vector<T, Allocator, InitialCapacity, GrowthPolicy>;
+
+public:
+  using value_type      = T;
+  using allocator_type  = Allocator;
+  using size_type       = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference       = const value_type&;
+  using const_reference = const value_type&;
+  using pointer         = const value_type*;
+  using const_pointer   = const value_type*;
+
+  class const_iterator;
+  using iterator               = const_iterator;
+  using reverse_iterator       = std::reverse_iterator<const_iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+private:
+  using AllocTraits    = std::allocator_traits<Allocator>;
+  using SpineAllocator = typename AllocTraits::template rebind_alloc<T*>;
+  using Spine          = std::vector<T*, SpineAllocator>;
+
+  // Owns the blocks, and the elements below size.
+  struct segment_table {
+    [[no_unique_address]] Allocator allocator;
+    Spine                           blocks;
+    size_type                       size;
+
+    segment_table(const Allocator& alloc, Spine&& spine, size_type count)
+        : allocator(alloc)
+        , blocks(std::move(spine))
+        , size(count)
+    {}
+
+    segment_table(const segment_table&)            = delete;
+    segment_table& operator=(const segment_table&) = delete;
+
+    ~segment_table()
+    {
+      for (size_type i = size; i > 0; --i) {
+        auto [k, off] = get_location(i - 1);
+        AllocTraits::destroy(allocator, blocks[k] + off);
+      }
+      for (size_type k = 0; k < blocks.size(); ++k) {
+        if (blocks[k]) {
+          AllocTraits::deallocate(allocator, blocks[k], get_block_capacity(k));
+        }
+      }
+    }
+  };
+
+  std::shared_ptr<const segment_table> m_table;
+  T* const*                            m_blocks = nullptr;
+  size_type                            m_size   = 0;
+
+  // -------------------------------------------------------------------------
+  // Internal Helpers
+  // -------------------------------------------------------------------------
+
+  [[nodiscard]] [[gnu::always_inline]] static inline std::pair<
+      size_type,
+      size_type>
+  get_location(size_type index) noexcept
+  {
+    return Layout::location(index);
+  }
+
+  [[nodiscard]] static constexpr size_type
+  get_block_capacity(size_type block_idx) noexcept
+  {
+    return Layout::block_capacity(block_idx);
+  }
+
+  // Takes ownership of the blocks of spine, of which the first count
+  // elements are constructed. If the table cannot be allocated, spine is
+  // left untouched.
+  frozen_segmented_vector(
+      const Allocator& alloc, Spine&& spine, size_type count
+  )
+      : m_table(std::allocate_shared<segment_table>(
+            alloc, alloc, std::move(spine), count
+        ))
+      , m_blocks(m_table->blocks.data())
+      , m_size(count)
+  {}
+
+public:
+  // -------------------------------------------------------------------------
+  // Constructors
+  // -------------------------------------------------------------------------
+
+  [[nodiscard]] frozen_segmented_vector() noexcept = default;
+
+  [[nodiscard]] frozen_segmented_vector(const frozen_segmented_vector&
+  ) noexcept = default;
+
+  [[nodiscard]] frozen_segmented_vector(frozen_segmented_vector&& other
+  ) noexcept
+      : m_table(std::move(other.m_table))
+      , m_blocks(std::exchange(other.m_blocks, nullptr))
+      , m_size(std::exchange(other.m_size, 0))
+  {}
+
+  frozen_segmented_vector&
+  operator=(const frozen_segmented_vector&) noexcept = default;
+
+  frozen_segmented_vector& operator=(frozen_segmented_vector&& other) noexcept
+  {
+    if (this != &other) {
+      m_table  = std::move(other.m_table);
+      m_blocks = std::exchange(other.m_blocks, nullptr);
+      m_size   = std::exchange(other.m_size, 0);
+    }
+    return *this;
+  }
+
+  // -------------------------------------------------------------------------
+  // Access & Size
+  // -------------------------------------------------------------------------
+
+  [[nodiscard]] size_type size() const noexcept { return m_size; }
+
+  [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+
+  /**
+   * @brief The number of blocks, including those past the last element.
+   */
+  [[nodiscard]] size_type segment_count() const noexcept
+  {
+    return m_table ? m_table->blocks.size() : 0;
+  }
+
+  [[nodiscard]] const_reference operator[](size_type index) const noexcept
+  {
+    assert(index < m_size && "operator[] index out of bounds");
+    auto [k, off] = get_location(index);
+    return m_blocks[k][off];
+  }
+
+  [[nodiscard]] const_reference at(size_type index) const
+  {
+    if (index >= m_size) {
+      throw std::out_of_range("frozen_segmented_vector::at");
+    }
+    return (*this)[index];
+  }
+
+  [[nodiscard]] const_reference front() const noexcept
+  {
+    assert(!empty() && "front() called on empty container");
+    return (*this)[0];
+  }
+
+  [[nodiscard]] const_reference back() const noexcept
+  {
+    assert(!empty() && "back() called on empty container");
+    return (*this)[m_size - 1];
+  }
+
+  [[nodiscard]] allocator_type get_allocator() const
+  {
+    return m_table ? m_table->allocator : allocator_type();
+  }
+
+  // -------------------------------------------------------------------------
+  // High-Performance Block Iteration
+  // -------------------------------------------------------------------------
+  template <typename Func> void for_each_segment(Func&& func) const
+  {
+    size_type remaining = m_size;
+    for (size_type k = 0; remaining > 0; ++k) {
+      const T*        ptr   = m_blocks[k];
+      const size_type count = std::min(get_block_capacity(k), remaining);
+
+      for (size_type i = 0; i < count; ++i) {
+        func(ptr[i]);
+      }
+      remaining -= count;
+    }
+  }
+
+  // -------------------------------------------------------------------------
+  // Iterator Factories
+  // -------------------------------------------------------------------------
+  [[nodiscard]] const_iterator begin() const noexcept
+  {
+    return const_iterator(this, 0);
+  }
+
+  [[nodiscard]] const_iterator end() const noexcept
+  {
+    return const_iterator(this, m_size);
+  }
+
+  [[nodiscard]] const_iterator cbegin() const noexcept { return begin(); }
+
+  [[nodiscard]] const_iterator cend() const noexcept { return end(); }
+
+  [[nodiscard]] const_reverse_iterator rbegin() const noexcept
+  {
+    return const_reverse_iterator(end());
+  }
+
+  [[nodiscard]] const_reverse_iterator rend() const noexcept
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  // -------------------------------------------------------------------------
+  // Iterator Implementation (Cached)
+  // -------------------------------------------------------------------------
+  class const_iterator {
+    friend class frozen_segmented_vector;
+
+    const frozen_segmented_vector* m_cont         = nullptr;
+    size_type                      m_global_index = 0;
+    const T*                       m_current_ptr   = nullptr;
+    const T*                       m_block_end_ptr = nullptr;
+
+    void update_cache() noexcept
+    {
+      if (!m_cont || m_global_index >= m_cont->m_size) {
+        m_current_ptr   = nullptr;
+        m_block_end_ptr = nullptr;
+        return;
+      }
+      auto [k, off]         = get_location(m_global_index);
+      const T* block_start = m_cont->m_blocks[k];
+      m_current_ptr        = block_start + off;
+      m_block_end_ptr      = block_start + get_block_capacity(k);
+    }
+
+    const_iterator(const frozen_segmented_vector* cont, size_type idx) noexcept
+        : m_cont(cont)
+        , m_global_index(idx)
+    {
+      update_cache();
+    }
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept  = std::random_access_iterator_tag;
+    using value_type        = T;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const T*;
+    using reference         = const T&;
+
+    [[nodiscard]] const_iterator() noexcept = default;
+
+    [[nodiscard]] reference operator*() const
+    {
+      assert(
+          m_current_ptr != nullptr && "Cannot dereference end/null iterator"
+      );
+      return *m_current_ptr;
+    }
+
+    [[nodiscard]] pointer operator->() const
+    {
+      assert(
+          m_current_ptr != nullptr && "Cannot dereference end/null iterator"
+      );
+      return m_current_ptr;
+    }
+
+    [[nodiscard]] reference operator[](difference_type n) const
+    {
+      assert(m_cont != nullptr);
+      return (*m_cont)[m_global_index + n];
+    }
+
+    const_iterator& operator++()
+    {
+      assert(m_current_ptr != nullptr && "Cannot increment end/null iterator");
+      ++m_global_index;
+      ++m_current_ptr;
+      if (m_current_ptr == m_block_end_ptr) [[unlikely]] {
+        update_cache();
+      }
+      return *this;
+    }
+
+    const_iterator operator++(int)
+    {
+      auto tmp = *this;
+      ++(*this);
+      return tmp;
+    }
+
+    const_iterator& operator--()
+    {
+      assert(m_global_index > 0 && "Cannot decrement begin iterator");
+      --m_global_index;
+      update_cache();
+      return *this;
+    }
+
+    const_iterator operator--(int)
+    {
+      auto tmp = *this;
+      --(*this);
+      return tmp;
+    }
+
+    const_iterator& operator+=(difference_type n)
+    {
+      m_global_index += n;
+      update_cache();
+      return *this;
+    }
+
+    const_iterator& operator-=(difference_type n) { return *this += -n; }
+
+    [[nodiscard]] friend const_iterator
+    operator+(const_iterator it, difference_type n)
+    {
+      return it += n;
+    }
+
+    [[nodiscard]] friend const_iterator
+    operator+(difference_type n, const_iterator it)
+    {
+      return it += n;
+    }
+
+    [[nodiscard]] friend const_iterator
+    operator-(const_iterator it, difference_type n)
+    {
+      return it -= n;
+    }
+
+    [[nodiscard]] friend difference_type
+    operator-(const const_iterator& lhs, const const_iterator& rhs)
+    {
+      assert(
+          lhs.m_cont == rhs.m_cont &&
+          "Cannot compare iterators from different containers"
+      );
+      return static_cast<difference_type>(lhs.m_global_index) -
+             static_cast<difference_type>(rhs.m_global_index);
+    }
+
+    [[nodiscard]] friend bool
+    operator==(const const_iterator& lhs, const const_iterator& rhs)
+    {
+      assert(
+          lhs.m_cont == rhs.m_cont &&
+          "Cannot compare iterators from different containers"
+      );
+      return lhs.m_global_index == rhs.m_global_index;
+    }
+
+    [[nodiscard]] friend std::strong_ordering
+    operator<=>(const const_iterator& lhs, const const_iterator& rhs)
+    {
+      assert(
+          lhs.m_cont == rhs.m_cont &&
+          "Cannot compare iterators from different containers"
+      );
+      return lhs.m_global_index <=> rhs.m_global_index;
+    }
+  };
+};
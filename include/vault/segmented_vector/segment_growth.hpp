@@ -0,0 +1,143 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+// -----------------------------------------------------------------------------
+// Growth Policies
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief The default growth policy of segmented_vector: the first two blocks
+ * hold InitialCapacity elements, and every later block doubles the last.
+ */
+struct doubling_growth {
+  // The capacity at which blocks stop growing, or zero if they never do.
+  template <std::size_t ElementSize, std::size_t InitialCapacity>
+  static constexpr std::size_t max_block_capacity = 0;
+};
+
+/**
+ * @brief A growth policy for blocks backed by huge pages.
+ *
+ * Blocks double until they span a whole number of PageBytes pages, and every
+ * later block has that same capacity. With an allocator that aligns large
+ * blocks to huge pages, such as static_data::hpallocator, each of those blocks
+ * covers its pages exactly: no huge page is shared by two blocks, or left
+ * partly unused at the end of one. The capped capacity is the smallest
+ * power of 2 that is a whole number of pages, i.e. one page of elements when
+ * sizeof(T) is a power of 2, and three pages of 24-byte elements.
+ *
+ * Equal-sized blocks are also what lets an allocator recycle them, see
+ * static_data::recycling_allocator.
+ *
+ * For 1 GiB pages use huge_page_growth<1024 * 1024 * 1024>, with an allocator
+ * that gets them from hugetlbfs: transparent huge pages are 2 MiB.
+ *
+ * @tparam PageBytes The huge page size, a power of 2.
+ */
+template <std::size_t PageBytes = 2 * 1024 * 1024> struct huge_page_growth {
+  static_assert(
+      std::has_single_bit(PageBytes), "PageBytes must be a power of 2."
+  );
+
+  static constexpr std::size_t page_bytes = PageBytes;
+
+  template <std::size_t ElementSize, std::size_t InitialCapacity>
+  static constexpr std::size_t max_block_capacity = std::max(
+      InitialCapacity, PageBytes / std::gcd(ElementSize, PageBytes)
+  );
+};
+
+// -----------------------------------------------------------------------------
+// Block Layout
+// -----------------------------------------------------------------------------
+
+/**
+ * @brief The capacity of every block of a segmented vector, and the block and
+ * offset of every index, under a growth policy.
+ *
+ * Blocks below the capped capacity follow the doubling layout, so the first
+ * capped block starts at the index equal to its capacity, and the location of
+ * any later index is one division by a power of 2.
+ */
+template <
+    typename GrowthPolicy,
+    std::size_t ElementSize,
+    std::size_t InitialCapacity>
+struct segment_layout {
+  static_assert(
+      std::has_single_bit(InitialCapacity),
+      "InitialCapacity must be a power of 2 for fast bitwise indexing."
+  );
+
+  static constexpr std::size_t initial_capacity = InitialCapacity;
+  static constexpr int initial_shift = std::countr_zero(InitialCapacity);
+
+  static constexpr std::size_t max_capacity =
+      GrowthPolicy::template max_block_capacity<ElementSize, InitialCapacity>;
+
+  static_assert(
+      max_capacity == 0 ||
+          (std::has_single_bit(max_capacity) &&
+           max_capacity >= InitialCapacity),
+      "The maximum block capacity must be a power of 2 no less than "
+      "InitialCapacity."
+  );
+
+  // The first block at the maximum capacity.
+  static constexpr std::size_t first_capped_block =
+      max_capacity == 0 ? 0 : std::countr_zero(max_capacity >> initial_shift) + 1;
+
+  static constexpr int capped_shift =
+      max_capacity == 0 ? 0 : std::countr_zero(max_capacity);
+
+  [[nodiscard]] [[gnu::always_inline]] static inline std::
+      pair<std::size_t, std::size_t>
+      location(std::size_t index) noexcept
+  {
+    if constexpr (max_capacity != 0) {
+      if (index >= max_capacity) {
+        return {
+            first_capped_block - 1 + (index >> capped_shift),
+            index & (max_capacity - 1)
+        };
+      }
+    }
+
+    const std::size_t scaled_index = index >> initial_shift;
+    const std::size_t k            = std::bit_width(scaled_index);
+
+    // Branchless block start calculation
+    const std::size_t safe_scaled      = scaled_index | std::size_t(1);
+    const std::size_t calculated_start = std::bit_floor(safe_scaled)
+                                         << initial_shift;
+    const std::size_t mask  = 0 - static_cast<std::size_t>(scaled_index != 0);
+    const std::size_t block_start = calculated_start & mask;
+
+    return {k, index ^ block_start};
+  }
+
+  [[nodiscard]] static constexpr std::size_t
+  block_capacity(std::size_t block_idx) noexcept
+  {
+    if constexpr (max_capacity != 0) {
+      if (block_idx >= first_capped_block) {
+        return max_capacity;
+      }
+    }
+    if (block_idx == 0) {
+      return InitialCapacity;
+    }
+    assert(
+        block_idx - 1 < std::numeric_limits<std::size_t>::digits &&
+        "Block index overflow"
+    );
+    return InitialCapacity << (block_idx - 1);
+  }
+};
@@ -3,14 +3,23 @@
 #include <cassert>
 #include <compare>
 #include <concepts>
+#include <cstddef>
+#include <functional>
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <numeric>
+#include <optional>
+#include <span>
 #include <stdexcept>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <vault/executor/thread_executor.hpp>
+#include <vault/segmented_vector/frozen_segmented_vector.hpp>
+#include <vault/segmented_vector/segment_growth.hpp>
+
 /**
  * @brief segmented_vector
  * A C++23 container with stable references, stable iterators, and fast random
@@ -21,13 +30,17 @@
  * m_current_block_idx.
  * 3. m_push_cursor is always within [m_current_block_begin, m_push_limit].
  * 4. m_capacity is the sum of all allocated block sizes.
+ *
+ * Block capacities follow GrowthPolicy: doubling_growth doubles them without
+ * bound, huge_page_growth stops once they span whole huge pages.
  */
 template <
     typename T,
     typename Allocator       = std::allocator<T>,
     typename InitialCapacity = std::integral_constant<
         std::size_t,
-        (sizeof(T) > 4096) ? 1 : std::bit_floor(4096 / sizeof(T))>>
+        (sizeof(T) > 4096) ? 1 : std::bit_floor(4096 / sizeof(T))>,
+    typename GrowthPolicy = doubling_growth>
 class segmented_vector {
   // -------------------------------------------------------------------------
   // Compile-Time Assertions
@@ -49,7 +62,8 @@ class segmented_vector {
   );
 
   static constexpr std::size_t k_initial_cap = InitialCapacity::value;
-  static constexpr int k_initial_shift       = std::countr_zero(k_initial_cap);
+
+  using Layout = segment_layout<GrowthPolicy, sizeof(T), k_initial_cap>;
 
 public:
   using value_type      = T;
@@ -69,6 +83,9 @@ public:
   using reverse_iterator       = std::reverse_iterator<iterator>;
   using const_reverse_iterator = std::reverse_iterator<const_iterator>;
 
+  using frozen_type =
+      frozen_segmented_vector<T, Allocator, InitialCapacity, GrowthPolicy>;
+
 private:
   using BlockPtr       = T*;
   using SpineAllocator = typename AllocTraits::template rebind_alloc<BlockPtr>;
@@ -98,36 +115,38 @@ private:
         "Index calculation out of bounds of allocated capacity"
     );
 
-    const size_type scaled_index = index >> k_initial_shift;
-    const size_type k            = std::bit_width(scaled_index);
-
-    const size_type safe_scaled      = scaled_index | size_type(1);
-    const size_type calculated_start = std::bit_floor(safe_scaled)
-                                       << k_initial_shift;
-    const size_type mask        = 0 - static_cast<size_type>(scaled_index != 0);
-    const size_type block_start = calculated_start & mask;
+    auto [k, off] = Layout::location(index);
 
     // Post-calculation check
     assert(k < m_spine.size() && "Calculated block index exceeds spine size");
     assert(m_spine[k] != nullptr && "Calculated block is null");
 
-    return {k, index ^ block_start};
+    return {k, off};
   }
 
   [[nodiscard]] constexpr size_type
   get_block_capacity(size_type block_idx) const noexcept
   {
-    if (block_idx == 0) {
-      return k_initial_cap;
-    }
+    return Layout::block_capacity(block_idx);
+  }
 
-    // Check for potential overflow in debug mode
-    assert(
-        block_idx < 64 &&
-        "Block index too large, capacity would overflow "
-        "size_t"
-    );
-    return k_initial_cap << (block_idx - 1);
+  // Invokes func(begin, end) with the contiguous part of every block that
+  // the indices [first, last) cover, in order, until func returns false.
+  // Returns whether func was never stopped.
+  template <typename Func>
+  bool visit_segments(size_type first, size_type last, Func&& func) const
+  {
+    while (first < last) {
+      auto [k, off] = get_location(first);
+      T*   begin    = m_spine[k] + off;
+      const size_type length =
+          std::min(get_block_capacity(k) - off, last - first);
+      if (!func(begin, begin + length)) {
+        return false;
+      }
+      first += length;
+    }
+    return true;
   }
 
   void reset_cursors()
@@ -579,6 +598,211 @@ public:
     }
   }
 
+  // -------------------------------------------------------------------------
+  // Freezing
+  // -------------------------------------------------------------------------
+
+  /**
+   * @brief Transfers the blocks into an immutable, shared frozen view,
+   * without copying or moving an element, and leaves the container empty.
+   *
+   * The cost is one allocation for the segment table, independent of
+   * size(). If it throws, the container is unchanged.
+   */
+  [[nodiscard]] frozen_type freeze() &&
+  {
+    frozen_type frozen(m_allocator, std::move(m_spine), size());
+
+    m_spine.clear();
+    m_capacity = 0;
+    reset_cursors();
+    assert(empty());
+    return frozen;
+  }
+
+  // -------------------------------------------------------------------------
+  // Parallel Segment Algorithms
+  // -------------------------------------------------------------------------
+
+  /**
+   * @brief Partitions the elements into contiguous runs, in order.
+   *
+   * Every run lies within one block, so it can be handed to a worker as a
+   * plain array, e.g. sorted on its own before a k-way merge. Blocks of
+   * up to max_length elements form one run each; the larger blocks of the
+   * tail are split into equal runs of at most max_length.
+   */
+  [[nodiscard]] std::vector<std::span<T>>
+  partition_segments(size_type max_length)
+  {
+    return split_segments(max_length);
+  }
+
+  [[nodiscard]] std::vector<std::span<const T>>
+  partition_segments(size_type max_length) const
+  {
+    auto runs = split_segments(max_length);
+    return {runs.begin(), runs.end()};
+  }
+
+  /**
+   * @brief Invokes func with every element, on the workers of executor.
+   *
+   * Each worker takes whole runs of partition_segments, so the elements
+   * it visits are contiguous.
+   */
+  template <
+      typename Func,
+      vault::algorithm::chunked_executor Executor =
+          vault::algorithm::thread_executor>
+    requires std::invocable<Func&, T&>
+  void parallel_for_each(Func&& func, const Executor& executor = Executor{})
+  {
+    auto runs = split_segments(parallel_run_length(executor.concurrency()));
+    for_each_run(executor, runs.size(), [&](size_type r) {
+      for (T& element : runs[r]) {
+        std::invoke(func, element);
+      }
+    });
+  }
+
+  template <
+      typename Func,
+      vault::algorithm::chunked_executor Executor =
+          vault::algorithm::thread_executor>
+    requires std::invocable<Func&, const T&>
+  void
+  parallel_for_each(Func&& func, const Executor& executor = Executor{}) const
+  {
+    auto runs = split_segments(parallel_run_length(executor.concurrency()));
+    for_each_run(executor, runs.size(), [&](size_type r) {
+      for (const T& element : runs[r]) {
+        std::invoke(func, element);
+      }
+    });
+  }
+
+  /**
+   * @brief Writes op(element) to out[i] for the element at every index i,
+   * on the workers of executor, and returns out + size().
+   */
+  template <
+      std::random_access_iterator OutputIt,
+      typename UnaryOp,
+      vault::algorithm::chunked_executor Executor =
+          vault::algorithm::thread_executor>
+    requires std::indirectly_writable<
+        OutputIt,
+        std::invoke_result_t<UnaryOp&, const T&>>
+  OutputIt parallel_transform(
+      OutputIt out, UnaryOp op, const Executor& executor = Executor{}
+  ) const
+  {
+    auto runs = split_segments(parallel_run_length(executor.concurrency()));
+
+    // The index of the first element of every run.
+    std::vector<size_type> offsets(runs.size());
+    size_type              offset = 0;
+    for (size_type r = 0; r < runs.size(); ++r) {
+      offsets[r] = offset;
+      offset += runs[r].size();
+    }
+
+    for_each_run(executor, runs.size(), [&](size_type r) {
+      auto target = out + static_cast<difference_type>(offsets[r]);
+      for (const T& element : runs[r]) {
+        *target++ = std::invoke(op, element);
+      }
+    });
+    return out + static_cast<difference_type>(size());
+  }
+
+  /**
+   * @brief Folds the elements with op, on the workers of executor.
+   *
+   * Each run is folded from its first element, and the results of the runs
+   * are folded into init in order, so op must be associative but need not
+   * be commutative.
+   */
+  template <
+      typename U,
+      typename BinaryOp,
+      vault::algorithm::chunked_executor Executor =
+          vault::algorithm::thread_executor>
+    requires std::constructible_from<U, const T&> &&
+             std::convertible_to<
+                 std::invoke_result_t<BinaryOp&, U, const T&>,
+                 U> &&
+             std::convertible_to<std::invoke_result_t<BinaryOp&, U, U>, U>
+  [[nodiscard]] U parallel_reduce(
+      U init, BinaryOp op, const Executor& executor = Executor{}
+  ) const
+  {
+    auto runs = split_segments(parallel_run_length(executor.concurrency()));
+
+    std::vector<std::optional<U>> partials(runs.size());
+    for_each_run(executor, runs.size(), [&](size_type r) {
+      auto first = runs[r].begin();
+      U    acc(*first);
+      for (++first; first != runs[r].end(); ++first) {
+        acc = std::invoke(op, std::move(acc), *first);
+      }
+      partials[r].emplace(std::move(acc));
+    });
+
+    for (auto& partial : partials) {
+      init = std::invoke(op, std::move(init), std::move(*partial));
+    }
+    return init;
+  }
+
+private:
+  [[nodiscard]] std::vector<std::span<T>>
+  split_segments(size_type max_length) const
+  {
+    max_length = std::max(max_length, size_type(1));
+
+    std::vector<std::span<T>> runs;
+    for (size_type k = 0; k < m_spine.size() && k <= m_current_block_idx;
+         ++k) {
+      T*        ptr   = m_spine[k];
+      size_type count = (k == m_current_block_idx)
+                            ? static_cast<size_type>(m_push_cursor - ptr)
+                            : get_block_capacity(k);
+
+      // Equal runs, the first count % pieces of them one longer.
+      const size_type pieces = (count + max_length - 1) / max_length;
+      for (size_type i = 0; i < pieces; ++i) {
+        const size_type length =
+            count / pieces + (i < count % pieces ? 1 : 0);
+        runs.emplace_back(ptr, length);
+        ptr += length;
+      }
+    }
+    return runs;
+  }
+
+  // Runs short enough to give every worker several, so that the workers
+  // that finish early balance the load, but no shorter than the first
+  // block.
+  [[nodiscard]] size_type
+  parallel_run_length(size_type concurrency) const noexcept
+  {
+    const size_type runs = 4 * std::max(concurrency, size_type(1));
+    return std::max(k_initial_cap, (size() + runs - 1) / runs);
+  }
+
+  template <typename Executor, typename Func>
+  static void for_each_run(const Executor& executor, size_type count, Func fn)
+  {
+    executor(count, 1, [&](size_type, size_type first, size_type last) {
+      for (size_type r = first; r < last; ++r) {
+        fn(r);
+      }
+    });
+  }
+
+public:
   // -------------------------------------------------------------------------
   // Iterator Factories
   // -------------------------------------------------------------------------
@@ -852,12 +1076,121 @@ public:
       );
       return lhs.m_global_index <=> rhs.m_global_index;
     }
+
+    // -----------------------------------------------------------------------
+    // Segmented Algorithms
+    // -----------------------------------------------------------------------
+    // Overloads of the standard algorithms, found by argument-dependent
+    // lookup of unqualified calls such as `copy(v.begin(), v.end(), out)`.
+    // They run the algorithm over each block as a plain pointer range, so
+    // the inner loops vectorize instead of paying for the block lookup of
+    // the iterator on every step.
+
+    template <std::output_iterator<const T&> OutputIt>
+    friend OutputIt copy(iterator_impl first, iterator_impl last, OutputIt out)
+    {
+      first.visit(last, [&](T* begin, T* end) {
+        out = std::copy(begin, end, std::move(out));
+        return true;
+      });
+      return out;
+    }
+
+    template <typename U>
+      requires(!IsConst) && std::assignable_from<T&, const U&>
+    friend void fill(iterator_impl first, iterator_impl last, const U& value)
+    {
+      first.visit(last, [&](T* begin, T* end) {
+        std::fill(begin, end, value);
+        return true;
+      });
+    }
+
+    template <typename Func>
+    friend Func for_each(iterator_impl first, iterator_impl last, Func func)
+    {
+      first.visit(last, [&](T* begin, T* end) {
+        for (; begin != end; ++begin) {
+          func(static_cast<reference>(*begin));
+        }
+        return true;
+      });
+      return func;
+    }
+
+    template <typename Pred>
+    [[nodiscard]] friend iterator_impl
+    find_if(iterator_impl first, iterator_impl last, Pred pred)
+    {
+      size_type index = first.m_global_index;
+      first.visit(last, [&](T* begin, T* end) {
+        T* hit = std::find_if(begin, end, [&](const T& element) {
+          return static_cast<bool>(pred(element));
+        });
+        index += static_cast<size_type>(hit - begin);
+        return hit == end;
+      });
+      return iterator_impl(first.m_cont, index);
+    }
+
+    template <typename U>
+    [[nodiscard]] friend iterator_impl
+    find(iterator_impl first, iterator_impl last, const U& value)
+    {
+      size_type index = first.m_global_index;
+      first.visit(last, [&](T* begin, T* end) {
+        T* hit = std::find(begin, end, value);
+        index += static_cast<size_type>(hit - begin);
+        return hit == end;
+      });
+      return iterator_impl(first.m_cont, index);
+    }
+
+    template <typename U>
+    [[nodiscard]] friend difference_type
+    count(iterator_impl first, iterator_impl last, const U& value)
+    {
+      difference_type total = 0;
+      first.visit(last, [&](T* begin, T* end) {
+        total += std::count(begin, end, value);
+        return true;
+      });
+      return total;
+    }
+
+    template <typename U, typename BinaryOp = std::plus<>>
+    [[nodiscard]] friend U accumulate(
+        iterator_impl first, iterator_impl last, U init, BinaryOp op = {}
+    )
+    {
+      first.visit(last, [&](T* begin, T* end) {
+        init = std::accumulate(begin, end, std::move(init), op);
+        return true;
+      });
+      return init;
+    }
+
+  private:
+    template <typename Func>
+    void visit(const iterator_impl& last, Func&& func) const
+    {
+      assert(
+          m_cont == last.m_cont &&
+          "Cannot compare iterators from different containers"
+      );
+      if (m_global_index < last.m_global_index) {
+        m_cont->visit_segments(
+            m_global_index, last.m_global_index, std::forward<Func>(func)
+        );
+      }
+    }
   };
 };
 
-template <typename T, typename Alloc, typename IC>
+template <typename T, typename Alloc, typename IC, typename GP>
 void swap(
-    segmented_vector<T, Alloc, IC>& lhs, segmented_vector<T, Alloc, IC>& rhs
+    segmented_vector<T, Alloc, IC, GP>& lhs,
+    segmented_vector<T, Alloc, IC, GP>& rhs
 ) noexcept(noexcept(lhs.swap(rhs)))
 {
   lhs.swap(rhs);
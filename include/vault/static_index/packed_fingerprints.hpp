@@ -0,0 +1,121 @@
+#ifndef VAULT_STATIC_INDEX_PACKED_FINGERPRINTS_HPP
+#define VAULT_STATIC_INDEX_PACKED_FINGERPRINTS_HPP
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <vault/frozen_vector/frozen_vector.hpp>
+#include <vault/frozen_vector/frozen_vector_builder.hpp>
+
+namespace vault::containers {
+
+  // A fingerprint of Bits bits, from 1 to 32, for static_index and
+  // static_index_builder. The fingerprints of such an index are packed
+  // back to back, so a 12-bit fingerprint takes 12 bits instead of the 16
+  // of the nearest integral type.
+  //
+  // The projection of the index must return an integral value, of which
+  // the fingerprint keeps the low Bits bits.
+  template <std::size_t Bits>
+    requires(Bits >= 1 && Bits <= 32)
+  struct packed_fingerprint {
+    static constexpr inline auto bits = Bits;
+    static constexpr inline auto mask = static_cast<std::uint32_t>((std::uint64_t{1} << Bits) - 1);
+
+    [[nodiscard]] static constexpr std::uint32_t of(std::integral auto value) noexcept {
+      return static_cast<std::uint32_t>(value) & mask;
+    }
+  };
+
+  template <typename T>
+  inline constexpr bool is_packed_fingerprint_v = false;
+
+  template <std::size_t Bits>
+  inline constexpr bool is_packed_fingerprint_v<packed_fingerprint<Bits>> = true;
+
+  // An immutable array of Bits-bit values stored back to back in 64-bit
+  // words. A value is read with two aligned loads and no branch, whether or
+  // not it straddles two words.
+  template <std::size_t Bits>
+    requires(Bits >= 1 && Bits <= 32)
+  class packed_fingerprint_array {
+    static constexpr auto mask = packed_fingerprint<Bits>::mask;
+
+    // One word more than the values need, so that the second load of the
+    // last value stays in bounds.
+    frozen::frozen_vector<std::uint64_t> words_;
+    std::size_t                          size_ = 0;
+
+    [[nodiscard]] static constexpr std::size_t word_count(std::size_t size) noexcept {
+      return ((size * Bits) + 63) / 64 + 1;
+    }
+
+  public:
+    static constexpr inline auto bits = Bits;
+
+    [[nodiscard]] packed_fingerprint_array() = default;
+
+    // Packs the low Bits bits of every value.
+    [[nodiscard]] explicit packed_fingerprint_array(std::span<std::uint32_t const> values)
+      : size_(values.size()) {
+      auto words = frozen::frozen_vector_builder<std::uint64_t>(word_count(values.size()), std::uint64_t{0});
+
+      for (auto i = std::size_t{0}; i < values.size(); ++i) {
+        auto const position = i * Bits;
+        auto const value    = std::uint64_t{values[i] & mask};
+        auto const offset   = position % 64;
+
+        words[position / 64] |= value << offset;
+
+        // The shift by one and then by 63 - offset is a shift by 64 -
+        // offset that is defined when offset is zero.
+        words[(position / 64) + 1] |= (value >> 1) >> (63 - offset);
+      }
+
+      words_ = std::move(words).freeze();
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept {
+      return size_;
+    }
+
+    [[nodiscard]] std::size_t size_in_bytes() const noexcept {
+      return words_.size() * sizeof(std::uint64_t);
+    }
+
+    [[nodiscard]] std::uint32_t operator[](std::size_t i) const noexcept {
+      assert(i < size_);
+
+      auto const  position = i * Bits;
+      auto const  offset   = position % 64;
+      auto const* word     = words_.data() + (position / 64);
+
+      auto const low  = word[0] >> offset;
+      auto const high = (word[1] << 1) << (63 - offset);
+      return static_cast<std::uint32_t>(low | high) & mask;
+    }
+
+    // The address of the word that holds the first bit of value i, for
+    // prefetching.
+    [[nodiscard]] std::uint64_t const* address_of(std::size_t i) const noexcept {
+      return words_.data() + ((i * Bits) / 64);
+    }
+
+    // Writes the value at positions[i] to values[i]. The loop has no
+    // branch and no dependency between iterations, so the compiler may
+    // vectorize it and the loads of different values overlap.
+    void extract_many(std::span<std::size_t const> positions, std::span<std::uint32_t> values) const noexcept {
+      assert(values.size() >= positions.size());
+
+      for (auto i = std::size_t{0}; i < positions.size(); ++i) {
+        values[i] = (*this)[positions[i]];
+      }
+    }
+  };
+
+} // namespace vault::containers
+
+#endif // VAULT_STATIC_INDEX_PACKED_FINGERPRINTS_HPP
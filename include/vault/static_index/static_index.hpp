@@ -1,22 +1,30 @@
 #ifndef VAULT_STATIC_INDEX_STATIC_INDEX_HPP
 #define VAULT_STATIC_INDEX_STATIC_INDEX_HPP
 
+#include <array>
 #include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <functional>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <optional>
 #include <ranges>
+#include <span>
+#include <string>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
 #include <function2/function2.hpp>
 
+#include <vault/executor/thread_executor.hpp>
 #include <vault/frozen_vector/frozen_vector.hpp>
 #include <vault/frozen_vector/frozen_vector_builder.hpp>
 
+#include <vault/static_index/packed_fingerprints.hpp>
 #include <vault/static_index/traits.hpp>
 
 namespace vault::containers {
@@ -34,21 +42,70 @@ namespace vault::containers {
     }
   };
 
-  template <typename Fingerprint, typename Proj, typename Comp>
+  // --- Perfect Hash Policies ---
+
+  // The encoding of the pilots of a perfect hash, from the fastest to
+  // evaluate to the smallest.
+  enum class phf_encoder : std::uint8_t { compact, dictionary_dictionary, elias_fano };
+
+  // How keys are spread over the buckets of a perfect hash. The opt
+  // bucketer needs fewer bits per key, and more time to build.
+  enum class phf_bucketer : std::uint8_t { skew, opt };
+
+  // Selects the perfect hash of an index. A minimal perfect hash maps n
+  // keys onto [0, n). A non-minimal one maps them onto a few percent more
+  // slots, and saves a remapping step on every lookup.
+  //
+  // Only default_phf_policy, fast_phf_policy and small_phf_policy are
+  // instantiated in the library.
+  template <
+    phf_encoder  Encoder  = phf_encoder::dictionary_dictionary,
+    phf_bucketer Bucketer = phf_bucketer::skew,
+    bool         Minimal  = true>
+  struct phf_policy {
+    static constexpr inline auto encoder  = Encoder;
+    static constexpr inline auto bucketer = Bucketer;
+    static constexpr inline auto minimal  = Minimal;
+  };
+
+  using default_phf_policy = phf_policy<>;
+  using fast_phf_policy    = phf_policy<phf_encoder::compact, phf_bucketer::skew, false>;
+  using small_phf_policy   = phf_policy<phf_encoder::elias_fano, phf_bucketer::opt, true>;
+
+  template <typename Fingerprint, typename Proj, typename Comp, typename Policy>
   class static_index_builder;
 
-  struct static_index_base {
+  // --- Build Options ---
+
+  struct static_index_build_options {
+    // The number of threads that build the perfect hash and place the
+    // fingerprints. Zero selects std::thread::hardware_concurrency().
+    std::size_t thread_count = 1;
+
+    // The average number of keys per partition of a partitioned perfect
+    // hash, whose partitions are built independently and in parallel. Zero
+    // builds a single perfect hash over all the keys.
+    std::size_t partition_size = 0;
+
+    // If nonzero, the perfect hash is built in external memory, with at
+    // most this many bytes of RAM, spilling to temporary_directory.
+    std::size_t ram_budget_bytes = 0;
+    std::string temporary_directory = ".";
+  };
+
+  template <typename Policy = default_phf_policy>
+  struct basic_static_index_base {
     static constexpr inline auto npos = std::numeric_limits<std::size_t>::max();
 
-    [[nodiscard]] static_index_base() = default;
+    [[nodiscard]] basic_static_index_base() = default;
 
-    [[nodiscard]] static_index_base(const static_index_base&)     = default;
-    [[nodiscard]] static_index_base(static_index_base&&) noexcept = default;
+    [[nodiscard]] basic_static_index_base(const basic_static_index_base&)     = default;
+    [[nodiscard]] basic_static_index_base(basic_static_index_base&&) noexcept = default;
 
-    static_index_base& operator=(const static_index_base&)     = default;
-    static_index_base& operator=(static_index_base&&) noexcept = default;
+    basic_static_index_base& operator=(const basic_static_index_base&)     = default;
+    basic_static_index_base& operator=(basic_static_index_base&&) noexcept = default;
 
-    ~static_index_base();
+    ~basic_static_index_base();
 
     // --- Generalized Lookup ---
 
@@ -58,20 +115,62 @@ namespace vault::containers {
     [[nodiscard]] std::pair<std::size_t, key_128> operator[](key_128) const;
     [[nodiscard]] std::pair<std::size_t, key_128> operator[](bytes_sequence_channel_t) const;
 
+    // --- Batched Lookup ---
+
+    // The number of keys static_index::lookup_many hashes before it looks
+    // any of them up.
+    static constexpr inline auto lookup_batch_size = std::size_t{64};
+
+    // Writes the slot of hashes[i] to slots[i]. The perfect hash of every
+    // key is evaluated before the caller touches any slot, so the cache
+    // misses of different keys overlap instead of being paid in turn.
+    void lookup_many(std::span<key_128 const> hashes, std::span<std::size_t> slots) const;
+
     [[nodiscard]] bool   empty() const noexcept;
     [[nodiscard]] size_t memory_usage_bytes() const noexcept;
 
-    [[nodiscard]] static key_128           hash(bytes_sequence_channel_t);
-    [[nodiscard]] static static_index_base build(std::span<key_128 const>);
+    // The number of slots the keys are mapped onto: the number of keys if
+    // the perfect hash is minimal, and a few percent more otherwise.
+    [[nodiscard]] size_t slot_count() const noexcept;
+
+    [[nodiscard]] static key_128 hash(bytes_sequence_channel_t);
+
+    // Hashes a key whose bytes are one contiguous block in a single call,
+    // without the callbacks and the streaming state of hash(channel). The
+    // result is the hash(channel) of a key with the same bytes.
+    [[nodiscard]] static key_128 hash_bytes(std::span<std::byte const>) noexcept;
+
+    // clang-format off
+    [[nodiscard]] static basic_static_index_base build
+      (std::span<key_128 const>, static_index_build_options const& = {});
+    // clang-format on
+
+    // --- Persistence ---
+
+    // Writes the perfect hash to `path`. Throws std::ios_base::failure if
+    // the file cannot be written.
+    void save(std::filesystem::path const&) const;
+
+    // Reads the perfect hash of an index written by `save`, so that it
+    // need not be built again. Throws std::system_error if the file cannot
+    // be opened or mapped, and std::runtime_error if it is not a
+    // static_index file.
+    [[nodiscard]] static basic_static_index_base open_mapped(std::filesystem::path const&);
 
   private:
     struct impl;
     std::shared_ptr<const impl> pimpl_;
 
-    [[nodiscard]] static_index_base(std::shared_ptr<const impl> ptr);
+    [[nodiscard]] basic_static_index_base(std::shared_ptr<const impl> ptr);
   };
 
-  template <typename Fingerprint>
+  using static_index_base = basic_static_index_base<>;
+
+  extern template class basic_static_index_base<default_phf_policy>;
+  extern template class basic_static_index_base<fast_phf_policy>;
+  extern template class basic_static_index_base<small_phf_policy>;
+
+  template <typename Fingerprint, typename Policy = default_phf_policy>
     requires std::is_integral_v<Fingerprint>
   struct specialized_static_index_base {
     static constexpr inline auto const npos = static_index_base::npos;
@@ -94,16 +193,43 @@ namespace vault::containers {
     [[nodiscard]] std::tuple<std::size_t, key_128, Fingerprint> operator[](key_128) const;
     [[nodiscard]] std::tuple<std::size_t, key_128, Fingerprint> operator[](bytes_sequence_channel_t) const;
 
+    // --- Batched Lookup ---
+
+    // Writes the slot of hashes[i] to slots[i] and its fingerprint to
+    // fingerprints[i]. The lookups run as AMAC jobs (see amac.hpp), so
+    // the fingerprint loads of up to 16 keys are in flight at once.
+    // clang-format off
+    void lookup_many
+      (std::span<key_128 const>, std::span<std::size_t>, std::span<Fingerprint>) const;
+    // clang-format on
+
     [[nodiscard]] bool   empty() const noexcept;
     [[nodiscard]] size_t memory_usage_bytes() const noexcept;
+    [[nodiscard]] size_t slot_count() const noexcept;
 
     [[nodiscard]] static key_128 hash(bytes_sequence_channel_t);
+    [[nodiscard]] static key_128 hash_bytes(std::span<std::byte const>) noexcept;
 
     // clang-format off
     [[nodiscard]] static specialized_static_index_base build
-      (std::span<key_128 const>, std::span<Fingerprint const>);
+      (std::span<key_128 const>, std::span<Fingerprint const>, static_index_build_options const& = {});
     // clang-format on
 
+    // --- Persistence ---
+
+    // Writes the perfect hash and the fingerprints to `path`, with the
+    // fingerprints page-aligned so that `open_mapped` can map them in
+    // place. Throws std::ios_base::failure if the file cannot be written.
+    void save(std::filesystem::path const&) const;
+
+    // Opens an index written by `save` for the same Fingerprint type. The
+    // perfect hash, a few bits per key, is read into memory; the
+    // fingerprints are mapped read-only and shared by every process that
+    // opens the file. Throws std::system_error if the file cannot be
+    // opened or mapped, and std::runtime_error if it is not a static_index
+    // file of this Fingerprint type.
+    [[nodiscard]] static specialized_static_index_base open_mapped(std::filesystem::path const&);
+
   private:
     struct impl;
     std::shared_ptr<const impl> pimpl_;
@@ -111,48 +237,118 @@ namespace vault::containers {
     [[nodiscard]] specialized_static_index_base(std::shared_ptr<const impl> ptr);
   };
 
-  extern template class specialized_static_index_base<bool>;
-  extern template class specialized_static_index_base<char>;
-  extern template class specialized_static_index_base<signed char>;
-  extern template class specialized_static_index_base<unsigned char>;
-  extern template class specialized_static_index_base<short>;
-  extern template class specialized_static_index_base<unsigned short>;
-  extern template class specialized_static_index_base<int>;
-  extern template class specialized_static_index_base<unsigned int>;
-  extern template class specialized_static_index_base<long>;
-  extern template class specialized_static_index_base<unsigned long>;
-  extern template class specialized_static_index_base<long long>;
-  extern template class specialized_static_index_base<unsigned long long>;
-
-  extern template class specialized_static_index_base<wchar_t>;
-  extern template class specialized_static_index_base<char8_t>;
-  extern template class specialized_static_index_base<char16_t>;
-  extern template class specialized_static_index_base<char32_t>;
-
-  template <typename Fingerprint = std::size_t, typename Proj = key_128_high, typename Comp = std::equal_to<>>
-  class static_index : private static_index_base {
+#define VAULT_STATIC_INDEX_EXTERN_TEMPLATES(Policy)                                \
+  extern template class specialized_static_index_base<bool, Policy>;               \
+  extern template class specialized_static_index_base<char, Policy>;               \
+  extern template class specialized_static_index_base<signed char, Policy>;        \
+  extern template class specialized_static_index_base<unsigned char, Policy>;      \
+  extern template class specialized_static_index_base<short, Policy>;              \
+  extern template class specialized_static_index_base<unsigned short, Policy>;     \
+  extern template class specialized_static_index_base<int, Policy>;                \
+  extern template class specialized_static_index_base<unsigned int, Policy>;       \
+  extern template class specialized_static_index_base<long, Policy>;               \
+  extern template class specialized_static_index_base<unsigned long, Policy>;      \
+  extern template class specialized_static_index_base<long long, Policy>;          \
+  extern template class specialized_static_index_base<unsigned long long, Policy>; \
+  extern template class specialized_static_index_base<wchar_t, Policy>;            \
+  extern template class specialized_static_index_base<char8_t, Policy>;            \
+  extern template class specialized_static_index_base<char16_t, Policy>;           \
+  extern template class specialized_static_index_base<char32_t, Policy>;
+
+  VAULT_STATIC_INDEX_EXTERN_TEMPLATES(default_phf_policy)
+  VAULT_STATIC_INDEX_EXTERN_TEMPLATES(fast_phf_policy)
+  VAULT_STATIC_INDEX_EXTERN_TEMPLATES(small_phf_policy)
+
+#undef VAULT_STATIC_INDEX_EXTERN_TEMPLATES
+
+  namespace detail {
+    // The hash of `item`. Keys whose bytes are one contiguous block, such as
+    // integers and strings, are hashed in a single call; other keys are
+    // streamed through their byte sequence visitor.
+    template <concepts::underlying_byte_sequences K>
+    [[nodiscard]] key_128 hash_of(K const& item) {
+      using traits_t = traits::underlying_byte_sequences<std::remove_cvref_t<K>>;
+
+      if constexpr (concepts::contiguous_byte_sequence<K>) {
+        return static_index_base::hash_bytes(traits_t::bytes(item));
+      } else {
+        return static_index_base::hash([&](concepts::byte_sequence_visitor auto visitor) {
+          traits_t::visit(item, visitor);
+        });
+      }
+    }
+
+    // Hashes `items` a batch at a time and calls `flush(cursors, hashes)`
+    // with the iterators and the hashes of every batch.
+    template <std::ranges::forward_range R, typename Flush>
+    void for_each_hashed_batch(R&& items, Flush&& flush) {
+      constexpr auto batch_size = static_index_base::lookup_batch_size;
+
+      auto cursors = std::array<std::ranges::iterator_t<R>, batch_size>{};
+      auto hashes  = std::array<key_128, batch_size>{};
+      auto count   = std::size_t{0};
+
+      for (auto cursor = std::ranges::begin(items); cursor != std::ranges::end(items); ++cursor) {
+        cursors[count] = cursor;
+        hashes[count]  = hash_of(*cursor);
+
+        if (++count == batch_size) {
+          flush(std::span{cursors}, std::span<key_128 const>{hashes});
+          count = 0;
+        }
+      }
+
+      if (count != 0) {
+        flush(std::span{cursors}.first(count), std::span<key_128 const>{hashes}.first(count));
+      }
+    }
+
+    // The type a builder keeps the fingerprints of its keys in.
+    template <typename Fingerprint>
+    struct fingerprint_value {
+      using type = Fingerprint;
+    };
+
+    template <std::size_t Bits>
+    struct fingerprint_value<packed_fingerprint<Bits>> {
+      using type = std::uint32_t;
+    };
+
+    template <typename Fingerprint>
+    using fingerprint_value_t = typename fingerprint_value<Fingerprint>::type;
+  } // namespace detail
+
+  template <
+    typename Fingerprint = std::size_t,
+    typename Proj        = key_128_high,
+    typename Comp        = std::equal_to<>,
+    typename Policy      = default_phf_policy>
+  class static_index : private basic_static_index_base<Policy> {
+    using base_t = basic_static_index_base<Policy>;
+
     frozen::frozen_vector<Fingerprint> fingerprints_;
 
     [[no_unique_address]] Comp comp_;
     [[no_unique_address]] Proj proj_;
 
     [[nodiscard]] static_index(
-      static_index_base                  base,
+      base_t                             base,
       frozen::frozen_vector<Fingerprint> fingerprints,
       Proj                               proj,
       Comp                               comp
     )
-      : static_index_base(std::move(base))
+      : base_t(std::move(base))
       , fingerprints_(std::move(fingerprints))
       , comp_(std::move(comp))
       , proj_(std::move(proj)) {}
 
-    friend class static_index_builder<Fingerprint, Proj, Comp>;
+    friend class static_index_builder<Fingerprint, Proj, Comp, Policy>;
 
   public:
-    using static_index_base::empty;
-    using static_index_base::memory_usage_bytes;
-    using static_index_base::npos;
+    using base_t::empty;
+    using base_t::memory_usage_bytes;
+    using base_t::npos;
+    using base_t::slot_count;
 
     template <concepts::underlying_byte_sequences K>
       requires std::predicate<
@@ -160,11 +356,7 @@ namespace vault::containers {
         std::invoke_result_t<Proj, K const&, key_128 const&>,
         std::invoke_result_t<Proj, K const&, key_128 const&>>
     [[nodiscard]] std::optional<std::size_t> operator[](K&& item) const noexcept {
-      auto byte_sequence_channel = [&](concepts::byte_sequence_visitor auto visitor) {
-        traits::underlying_byte_sequences<std::remove_cvref_t<K>>::visit(std::forward<K>(item), visitor);
-      };
-
-      auto [slot, hash] = static_index_base::operator[](byte_sequence_channel);
+      auto [slot, hash] = base_t::operator[](detail::hash_of(item));
 
       if (std::invoke(comp_, std::invoke(proj_, item, hash), fingerprints_[slot])) {
         return slot;
@@ -172,12 +364,43 @@ namespace vault::containers {
 
       return std::nullopt;
     }
+
+    // Looks up every item of `items` and writes the results to `out` in
+    // order. Items are hashed a batch at a time; the slots of a batch are
+    // then found, and their fingerprints prefetched, before any of them
+    // is compared, so that the cache misses of a batch overlap.
+    template <std::ranges::forward_range R, std::output_iterator<std::optional<std::size_t>> O>
+      requires concepts::underlying_byte_sequences<std::ranges::range_value_t<R>> &&
+               std::predicate<
+                 Comp,
+                 std::invoke_result_t<Proj, std::ranges::range_reference_t<R>, key_128 const&>,
+                 std::invoke_result_t<Proj, std::ranges::range_reference_t<R>, key_128 const&>>
+    O lookup_many(R&& items, O out) const {
+      detail::for_each_hashed_batch(items, [&](auto cursors, std::span<key_128 const> hashes) {
+        auto slots = std::array<std::size_t, static_index_base::lookup_batch_size>{};
+        base_t::lookup_many(hashes, slots);
+
+        for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+          if (slots[i] != npos) {
+            __builtin_prefetch(std::addressof(fingerprints_[slots[i]]), 0, 3);
+          }
+        }
+
+        for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+          auto const found = slots[i] != npos &&
+                             std::invoke(comp_, std::invoke(proj_, *cursors[i], hashes[i]), fingerprints_[slots[i]]);
+          *out++ = found ? std::optional{slots[i]} : std::nullopt;
+        }
+      });
+
+      return out;
+    }
   };
 
-  template <typename Fingerprint, typename Proj, typename Comp>
+  template <typename Fingerprint, typename Proj, typename Comp, typename Policy>
     requires std::is_integral_v<Fingerprint>
-  class static_index<Fingerprint, Proj, Comp> : private specialized_static_index_base<Fingerprint> {
-    using base_t = specialized_static_index_base<Fingerprint>;
+  class static_index<Fingerprint, Proj, Comp, Policy> : private specialized_static_index_base<Fingerprint, Policy> {
+    using base_t = specialized_static_index_base<Fingerprint, Policy>;
 
     [[no_unique_address]] Comp comp_;
     [[no_unique_address]] Proj proj_;
@@ -187,12 +410,21 @@ namespace vault::containers {
       , comp_(std::move(comp))
       , proj_(std::move(proj)) {}
 
-    friend class static_index_builder<Fingerprint, Proj, Comp>;
+    friend class static_index_builder<Fingerprint, Proj, Comp, Policy>;
 
   public:
     using base_t::empty;
     using base_t::memory_usage_bytes;
     using base_t::npos;
+    using base_t::save;
+    using base_t::slot_count;
+
+    // Opens an index written by `save`. Its keys are projected and
+    // compared with `proj` and `comp`, which must match the ones it was
+    // built with.
+    [[nodiscard]] static static_index open_mapped(std::filesystem::path const& path, Proj proj = {}, Comp comp = {}) {
+      return {base_t::open_mapped(path), std::move(proj), std::move(comp)};
+    }
 
     template <concepts::underlying_byte_sequences K>
       requires std::predicate<
@@ -200,11 +432,7 @@ namespace vault::containers {
         std::invoke_result_t<Proj, K const&, key_128 const&>,
         std::invoke_result_t<Proj, K const&, key_128 const&>>
     [[nodiscard]] std::optional<std::size_t> operator[](K&& item) const noexcept {
-      auto byte_sequence_channel = [&](concepts::byte_sequence_visitor auto visitor) {
-        traits::underlying_byte_sequences<std::remove_cvref_t<K>>::visit(std::forward<K>(item), visitor);
-      };
-
-      auto [slot, hash, fingerprint] = base_t::operator[](byte_sequence_channel);
+      auto [slot, hash, fingerprint] = base_t::operator[](detail::hash_of(item));
 
       if (std::invoke(comp_, std::invoke(proj_, item, hash), fingerprint)) {
         return slot;
@@ -212,12 +440,125 @@ namespace vault::containers {
 
       return std::nullopt;
     }
+
+    // Looks up every item of `items` and writes the results to `out` in
+    // order. Items are hashed a batch at a time, and the slots and
+    // fingerprints of a batch are then fetched together, so that their
+    // cache misses overlap.
+    template <std::ranges::forward_range R, std::output_iterator<std::optional<std::size_t>> O>
+      requires concepts::underlying_byte_sequences<std::ranges::range_value_t<R>> &&
+               std::predicate<
+                 Comp,
+                 std::invoke_result_t<Proj, std::ranges::range_reference_t<R>, key_128 const&>,
+                 std::invoke_result_t<Proj, std::ranges::range_reference_t<R>, key_128 const&>>
+    O lookup_many(R&& items, O out) const {
+      detail::for_each_hashed_batch(items, [&](auto cursors, std::span<key_128 const> hashes) {
+        auto slots        = std::array<std::size_t, static_index_base::lookup_batch_size>{};
+        auto fingerprints = std::array<Fingerprint, static_index_base::lookup_batch_size>{};
+        base_t::lookup_many(hashes, slots, fingerprints);
+
+        for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+          auto const found =
+            slots[i] != npos && std::invoke(comp_, std::invoke(proj_, *cursors[i], hashes[i]), fingerprints[i]);
+          *out++ = found ? std::optional{slots[i]} : std::nullopt;
+        }
+      });
+
+      return out;
+    }
+  };
+
+  template <std::size_t Bits, typename Proj, typename Comp, typename Policy>
+  class static_index<packed_fingerprint<Bits>, Proj, Comp, Policy> : private basic_static_index_base<Policy> {
+    using base_t        = basic_static_index_base<Policy>;
+    using fingerprint_t = packed_fingerprint<Bits>;
+
+    packed_fingerprint_array<Bits> fingerprints_;
+
+    [[no_unique_address]] Comp comp_;
+    [[no_unique_address]] Proj proj_;
+
+    [[nodiscard]] static_index(base_t base, packed_fingerprint_array<Bits> fingerprints, Proj proj, Comp comp)
+      : base_t(std::move(base))
+      , fingerprints_(std::move(fingerprints))
+      , comp_(std::move(comp))
+      , proj_(std::move(proj)) {}
+
+    friend class static_index_builder<fingerprint_t, Proj, Comp, Policy>;
+
+  public:
+    using base_t::empty;
+    using base_t::npos;
+    using base_t::slot_count;
+
+    // The bytes of the perfect hash and of the packed fingerprints.
+    [[nodiscard]] size_t memory_usage_bytes() const noexcept {
+      return base_t::memory_usage_bytes() + fingerprints_.size_in_bytes();
+    }
+
+    template <concepts::underlying_byte_sequences K>
+      requires std::integral<std::remove_cvref_t<std::invoke_result_t<Proj, K const&, key_128 const&>>> &&
+               std::predicate<Comp, std::uint32_t, std::uint32_t>
+    [[nodiscard]] std::optional<std::size_t> operator[](K&& item) const noexcept {
+      auto [slot, hash] = base_t::operator[](detail::hash_of(item));
+
+      if (slot != npos && std::invoke(comp_, fingerprint_t::of(std::invoke(proj_, item, hash)), fingerprints_[slot])) {
+        return slot;
+      }
+
+      return std::nullopt;
+    }
+
+    // Looks up every item of `items` and writes the results to `out` in
+    // order. Items are hashed a batch at a time; the slots of a batch are
+    // then found and their fingerprints prefetched, and the fingerprints
+    // are unpacked together before any of them is compared.
+    template <std::ranges::forward_range R, std::output_iterator<std::optional<std::size_t>> O>
+      requires concepts::underlying_byte_sequences<std::ranges::range_value_t<R>> &&
+               std::integral<std::remove_cvref_t<
+                 std::invoke_result_t<Proj, std::ranges::range_reference_t<R>, key_128 const&>>> &&
+               std::predicate<Comp, std::uint32_t, std::uint32_t>
+    O lookup_many(R&& items, O out) const {
+      detail::for_each_hashed_batch(items, [&](auto cursors, std::span<key_128 const> hashes) {
+        if (empty()) [[unlikely]] {
+          for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+            *out++ = std::nullopt;
+          }
+          return;
+        }
+
+        auto slots  = std::array<std::size_t, static_index_base::lookup_batch_size>{};
+        auto values = std::array<std::uint32_t, static_index_base::lookup_batch_size>{};
+        base_t::lookup_many(hashes, slots);
+
+        auto const batch_slots = std::span<std::size_t const>{slots}.first(hashes.size());
+
+        for (auto const slot : batch_slots) {
+          __builtin_prefetch(fingerprints_.address_of(slot), 0, 3);
+        }
+
+        fingerprints_.extract_many(batch_slots, values);
+
+        for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+          auto const fingerprint = fingerprint_t::of(std::invoke(proj_, *cursors[i], hashes[i]));
+          auto const found       = std::invoke(comp_, fingerprint, values[i]);
+          *out++                 = found ? std::optional{slots[i]} : std::nullopt;
+        }
+      });
+
+      return out;
+    }
   };
 
-  template <typename Fingerprint = std::size_t, typename Proj = key_128_high, typename Comp = std::equal_to<>>
+  template <
+    typename Fingerprint = std::size_t,
+    typename Proj        = key_128_high,
+    typename Comp        = std::equal_to<>,
+    typename Policy      = default_phf_policy>
   class static_index_builder {
-    std::vector<key_128>     hashes_;
-    std::vector<Fingerprint> fingerprints_;
+    std::vector<key_128>                                   hashes_;
+    std::vector<detail::fingerprint_value_t<Fingerprint>> fingerprints_;
+    static_index_build_options                             options_;
 
     [[no_unique_address]] Comp comp_;
     [[no_unique_address]] Proj proj_;
@@ -232,6 +573,12 @@ namespace vault::containers {
       : comp_(std::move(comp))
       , proj_(std::move(proj)) {}
 
+    template <typename Self>
+    Self with_options(this Self&& self, static_index_build_options options) {
+      self.options_ = std::move(options);
+      return std::forward<Self>(self);
+    }
+
     template <typename Self, std::ranges::input_range R>
       requires concepts::underlying_byte_sequences<std::remove_cvref_t<std::ranges::range_reference_t<R>>>
     Self add_n(this Self&& self, R&& items) {
@@ -245,9 +592,7 @@ namespace vault::containers {
     template <typename Self, typename T>
       requires concepts::underlying_byte_sequences<std::remove_cvref_t<T>>
     Self add_1(this Self&& self, T&& item) {
-      auto hash = static_index_base::hash([&](concepts::byte_sequence_visitor auto visitor) {
-        traits::underlying_byte_sequences<std::remove_cvref_t<T>>::visit(item, visitor);
-      });
+      auto hash = detail::hash_of(item);
 
       self.fingerprints_.emplace_back(std::invoke(self.proj_, std::forward<T>(item), hash));
 
@@ -261,34 +606,67 @@ namespace vault::containers {
       return std::forward<Self>(self);
     }
 
-    [[nodiscard]] static_index<Fingerprint, Proj, Comp> build() && {
-      auto base = static_index_base::build(hashes_);
+    [[nodiscard]] static_index<Fingerprint, Proj, Comp, Policy> build() && {
+      auto base = basic_static_index_base<Policy>::build(hashes_, options_);
 
       // Permute the fingerprints according to the perfect
       // hash. Otherwise they will not align with the indexes returned
-      // when we perofrm a lookup.
-      auto permuted_fingerprints = frozen::frozen_vector_builder<Fingerprint>(fingerprints_.size(), Fingerprint{});
-
-      for (auto const& [index, hash] : std::views::enumerate(hashes_)) {
-        permuted_fingerprints[base[hash].first] = std::move(fingerprints_[index]);
-      }
+      // when we perofrm a lookup. Every key has a slot of its own, so
+      // the threads never write to the same fingerprint. The slots are
+      // cleared on the same threads, which places their pages.
+      auto const executor              = algorithm::thread_executor{options_.thread_count};
+      auto       permuted_fingerprints = frozen::frozen_vector_builder<Fingerprint>();
+      permuted_fingerprints.parallel_generate(base.slot_count(), [](std::size_t) { return Fingerprint{}; }, executor);
+
+      constexpr auto permutation_grain = std::size_t{1} << 16;
+
+      executor(
+        hashes_.size(), permutation_grain, [&](std::size_t, std::size_t first, std::size_t last) {
+          for (auto index = first; index < last; ++index) {
+            permuted_fingerprints[base[hashes_[index]].first] = std::move(fingerprints_[index]);
+          }
+        }
+      );
 
       return {std::move(base), std::move(permuted_fingerprints).freeze(), std::move(proj_), std::move(comp_)};
     }
 
-    [[nodiscard]] static_index<Fingerprint, Proj, Comp> build() &&
+    [[nodiscard]] static_index<Fingerprint, Proj, Comp, Policy> build() &&
       requires std::is_integral_v<Fingerprint>
     {
-      auto base = specialized_static_index_base<Fingerprint>::build(hashes_, fingerprints_);
+      auto base = specialized_static_index_base<Fingerprint, Policy>::build(hashes_, fingerprints_, options_);
       return {std::move(base), std::move(proj_), std::move(comp_)};
     }
 
+    [[nodiscard]] static_index<Fingerprint, Proj, Comp, Policy> build() &&
+      requires is_packed_fingerprint_v<Fingerprint>
+    {
+      auto base = basic_static_index_base<Policy>::build(hashes_, options_);
+
+      // Permute the fingerprints into their slots before packing them, as
+      // threads that wrote packed fingerprints would share words.
+      auto permuted_fingerprints = std::vector<std::uint32_t>(base.slot_count());
+
+      constexpr auto permutation_grain = std::size_t{1} << 16;
+
+      algorithm::thread_executor{options_.thread_count}(
+        hashes_.size(), permutation_grain, [&](std::size_t, std::size_t first, std::size_t last) {
+          for (auto index = first; index < last; ++index) {
+            permuted_fingerprints[base[hashes_[index]].first] = fingerprints_[index];
+          }
+        }
+      );
+
+      auto packed = packed_fingerprint_array<Fingerprint::bits>(permuted_fingerprints);
+      return {std::move(base), std::move(packed), std::move(proj_), std::move(comp_)};
+    }
+
     template <std::invocable<std::size_t> Sink>
-    [[nodiscard]] std::pair<static_index<Fingerprint, Proj, Comp>, Sink> build(Sink sink) && {
+    [[nodiscard]] std::pair<static_index<Fingerprint, Proj, Comp, Policy>, Sink> build(Sink sink) && {
       auto self = std::move(*this).build();
 
       for (auto const& hash : hashes_) {
-        std::invoke(sink, static_cast<static_index_base const&>(self)[hash].first);
+        std::invoke(sink, static_cast<basic_static_index_base<Policy> const&>(self)[hash].first);
       }
 
       return {std::move(self), std::move(sink)};
@@ -296,13 +674,13 @@ namespace vault::containers {
 
     template <std::invocable<std::size_t> Sink>
       requires std::is_integral_v<Fingerprint>
-    [[nodiscard]] std::pair<static_index<Fingerprint, Proj, Comp>, Sink> build(Sink sink) && {
+    [[nodiscard]] std::pair<static_index<Fingerprint, Proj, Comp, Policy>, Sink> build(Sink sink) && {
       auto self = std::move(*this).build();
 
       for (auto const& hash : hashes_) {
 	// clang-format off
         auto [slot, _1, _2] = static_cast
-	  <specialized_static_index_base<Fingerprint> const&>(self)[hash];
+	  <specialized_static_index_base<Fingerprint, Policy> const&>(self)[hash];
         // clang-format on
         
         std::invoke(sink, slot);
@@ -312,7 +690,7 @@ namespace vault::containers {
     }
 
     template <std::output_iterator<std::size_t> O>
-    [[nodiscard]] std::pair<static_index<Fingerprint, Proj, Comp>, O> build(O out) && {
+    [[nodiscard]] std::pair<static_index<Fingerprint, Proj, Comp, Policy>, O> build(O out) && {
       auto [self, _] = std::move(*this).build([&](std::size_t target) { *out++ = target; });
       return {std::move(self), std::move(out)};
     }
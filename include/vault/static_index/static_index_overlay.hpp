@@ -0,0 +1,367 @@
+#ifndef VAULT_STATIC_INDEX_STATIC_INDEX_OVERLAY_HPP
+#define VAULT_STATIC_INDEX_STATIC_INDEX_OVERLAY_HPP
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <vault/executor/thread_executor.hpp>
+#include <vault/frozen_vector/frozen_vector.hpp>
+#include <vault/frozen_vector/frozen_vector_builder.hpp>
+
+#include <vault/static_index/static_index.hpp>
+#include <vault/static_index/traits.hpp>
+
+namespace vault::containers {
+
+  // A static_index that absorbs inserts and erases without rebuilding its
+  // perfect hash. Keys the index was built or compacted with keep their
+  // slot as their id; erasing one sets its tombstone. Inserted keys go to
+  // a small open-addressing table and get ids from slot_count() upwards.
+  // `compacted` rebuilds the perfect hash over the live keys once the
+  // overlay has grown, and reports the new id of every old one.
+  //
+  // The full 128-bit hash of every key stands in for the fingerprint of
+  // static_index: it is what a compaction rebuilds the perfect hash from,
+  // as the keys themselves are not kept.
+  //
+  // A lookup of a key that is not in the base tests one word of a blocked
+  // Bloom filter before it probes the overlay, so misses seldom touch the
+  // overlay table, and never while the overlay is empty.
+  //
+  // Const members may be called concurrently, so a compaction can run on
+  // another thread while lookups continue; inserts and erases need
+  // exclusive access.
+  template <typename Policy = default_phf_policy>
+  class static_index_overlay {
+    using base_t = basic_static_index_base<Policy>;
+
+    struct overlay_entry {
+      key_128     hash;
+      std::size_t id = npos_id;
+    };
+
+    static constexpr inline auto npos_id = base_t::npos;
+
+    // --- Base ---
+
+    base_t                         base_;
+    frozen::frozen_vector<key_128> slot_hashes_;
+    std::vector<std::uint64_t>     live_;
+    std::size_t                    base_size_  = 0;
+    std::size_t                    live_count_ = 0;
+
+    // --- Overlay ---
+
+    // Linear probing from hash.low, at most half full; a free entry has
+    // the id npos.
+    std::vector<overlay_entry> table_;
+    std::vector<std::uint64_t> filter_;
+    std::size_t                overlay_size_ = 0;
+    std::size_t                next_id_      = 0;
+
+    [[nodiscard]] static bool test(std::vector<std::uint64_t> const& bits, std::size_t i) noexcept {
+      return (bits[i / 64] >> (i % 64)) & 1;
+    }
+
+    // Two bits of one filter word, so a test is a single load.
+    [[nodiscard]] std::uint64_t filter_mask(key_128 const& hash) const noexcept {
+      return (std::uint64_t{1} << (hash.high % 64)) | (std::uint64_t{1} << ((hash.high >> 6) % 64));
+    }
+
+    [[nodiscard]] std::size_t filter_word(key_128 const& hash) const noexcept {
+      return (hash.high >> 12) & (filter_.size() - 1);
+    }
+
+    [[nodiscard]] std::size_t base_slot(key_128 const& hash) const noexcept {
+      auto const slot = base_[hash].first;
+      return slot != npos_id && slot_hashes_[slot] == hash ? slot : npos_id;
+    }
+
+    // The entry of `hash`, or the free entry where it would go.
+    [[nodiscard]] std::size_t probe(key_128 const& hash) const noexcept {
+      auto const mask = table_.size() - 1;
+
+      for (auto i = hash.low & mask;; i = (i + 1) & mask) {
+        if (table_[i].id == npos_id || table_[i].hash == hash) {
+          return i;
+        }
+      }
+    }
+
+    [[nodiscard]] std::size_t overlay_find(key_128 const& hash) const noexcept {
+      if (overlay_size_ == 0 || (filter_[filter_word(hash)] & filter_mask(hash)) == 0) {
+        return npos_id;
+      }
+
+      return table_[probe(hash)].id;
+    }
+
+    void rehash(std::size_t capacity) {
+      auto entries = std::exchange(table_, std::vector<overlay_entry>(capacity));
+      filter_.assign(std::max(std::size_t{1}, capacity / 8), 0);
+
+      for (auto const& entry : entries) {
+        if (entry.id != npos_id) {
+          table_[probe(entry.hash)] = entry;
+          filter_[filter_word(entry.hash)] |= filter_mask(entry.hash);
+        }
+      }
+    }
+
+    // Backward-shift deletion, which keeps every probe sequence unbroken
+    // without leaving tombstones in the table.
+    void overlay_erase_at(std::size_t hole) noexcept {
+      auto const mask = table_.size() - 1;
+
+      for (auto i = (hole + 1) & mask; table_[i].id != npos_id; i = (i + 1) & mask) {
+        auto const home = table_[i].hash.low & mask;
+
+        // Move the entry into the hole unless its home lies in (hole, i].
+        if (((i - home) & mask) >= ((i - hole) & mask)) {
+          table_[hole] = table_[i];
+          hole         = i;
+        }
+      }
+
+      table_[hole] = overlay_entry{};
+      --overlay_size_;
+    }
+
+    [[nodiscard]] std::optional<std::size_t> find(key_128 const& hash) const noexcept {
+      if (auto const slot = base_slot(hash); slot != npos_id) {
+        return test(live_, slot) ? std::optional{slot} : std::nullopt;
+      }
+
+      auto const id = overlay_find(hash);
+      return id != npos_id ? std::optional{id} : std::nullopt;
+    }
+
+    std::pair<std::size_t, bool> insert(key_128 const& hash) {
+      if (auto const slot = base_slot(hash); slot != npos_id) {
+        auto& word = live_[slot / 64];
+        auto  bit  = std::uint64_t{1} << (slot % 64);
+
+        if (word & bit) {
+          return {slot, false};
+        }
+
+        word |= bit;
+        ++live_count_;
+        return {slot, true};
+      }
+
+      if (auto const id = overlay_find(hash); id != npos_id) {
+        return {id, false};
+      }
+
+      if (2 * (overlay_size_ + 1) > table_.size()) {
+        rehash(std::max(std::size_t{16}, 2 * table_.size()));
+      }
+
+      auto const id       = next_id_++;
+      table_[probe(hash)] = overlay_entry{hash, id};
+
+      filter_[filter_word(hash)] |= filter_mask(hash);
+      ++overlay_size_;
+
+      return {id, true};
+    }
+
+    bool erase(key_128 const& hash) noexcept {
+      if (auto const slot = base_slot(hash); slot != npos_id) {
+        auto& word = live_[slot / 64];
+        auto  bit  = std::uint64_t{1} << (slot % 64);
+
+        if ((word & bit) == 0) {
+          return false;
+        }
+
+        word &= ~bit;
+        --live_count_;
+        return true;
+      }
+
+      if (overlay_find(hash) == npos_id) {
+        return false;
+      }
+
+      overlay_erase_at(probe(hash));
+      return true;
+    }
+
+    [[nodiscard]] static static_index_overlay from_hashes(
+      std::vector<key_128> const&       hashes,
+      static_index_build_options const& options
+    ) {
+      auto self  = static_index_overlay{};
+      self.base_ = base_t::build(hashes, options);
+
+      // Every key has a slot of its own, so the threads never write to the
+      // same hash. The live bits share words, and are set afterwards.
+      auto slots       = std::vector<std::size_t>(hashes.size());
+      auto slot_hashes = frozen::frozen_vector_builder<key_128>(self.base_.slot_count(), key_128{});
+
+      constexpr auto placement_grain = std::size_t{1} << 16;
+
+      algorithm::thread_executor{options.thread_count}(
+        hashes.size(), placement_grain, [&](std::size_t, std::size_t first, std::size_t last) {
+          for (auto index = first; index < last; ++index) {
+            slots[index]              = self.base_[hashes[index]].first;
+            slot_hashes[slots[index]] = hashes[index];
+          }
+        }
+      );
+
+      self.slot_hashes_ = std::move(slot_hashes).freeze();
+      self.live_.assign((self.base_.slot_count() + 63) / 64, 0);
+
+      for (auto const slot : slots) {
+        self.live_[slot / 64] |= std::uint64_t{1} << (slot % 64);
+      }
+
+      self.base_size_  = hashes.size();
+      self.live_count_ = hashes.size();
+      self.next_id_    = self.base_.slot_count();
+      return self;
+    }
+
+  public:
+    static constexpr inline auto npos = npos_id;
+
+    [[nodiscard]] static_index_overlay() = default;
+
+    // Builds the index of `items`, which must be distinct. The id of an
+    // item is its slot in the perfect hash.
+    template <std::ranges::input_range R>
+      requires concepts::underlying_byte_sequences<std::ranges::range_value_t<R>>
+    [[nodiscard]] static static_index_overlay build(R&& items, static_index_build_options const& options = {}) {
+      auto hashes = std::vector<key_128>{};
+      for (auto const& item : items) {
+        hashes.push_back(detail::hash_of(item));
+      }
+
+      return from_hashes(hashes, options);
+    }
+
+    // --- Lookup ---
+
+    // The id of `item`, or nullopt if it is not in the index.
+    template <concepts::underlying_byte_sequences K>
+    [[nodiscard]] std::optional<std::size_t> operator[](K const& item) const noexcept {
+      return find(detail::hash_of(item));
+    }
+
+    template <concepts::underlying_byte_sequences K>
+    [[nodiscard]] bool contains(K const& item) const noexcept {
+      return find(detail::hash_of(item)).has_value();
+    }
+
+    // --- Updates ---
+
+    // Adds `item` if it is not in the index. Returns its id, and whether
+    // it was added. A key of the base that was erased gets its old id
+    // back; any other key gets a new one.
+    template <concepts::underlying_byte_sequences K>
+    std::pair<std::size_t, bool> insert(K const& item) {
+      return insert(detail::hash_of(item));
+    }
+
+    // Removes `item`. Returns whether it was in the index.
+    template <concepts::underlying_byte_sequences K>
+    bool erase(K const& item) noexcept {
+      return erase(detail::hash_of(item));
+    }
+
+    // --- Compaction ---
+
+    // Builds a new index of the live keys, with no overlay and no
+    // tombstones, and calls `sink(old_id, new_id)` for every key.
+    template <std::invocable<std::size_t, std::size_t> Sink>
+    [[nodiscard]] std::pair<static_index_overlay, Sink> compacted(
+      Sink sink, static_index_build_options const& options = {}
+    ) const {
+      auto hashes = std::vector<key_128>{};
+      auto ids    = std::vector<std::size_t>{};
+
+      hashes.reserve(size());
+      ids.reserve(size());
+
+      for (auto slot = std::size_t{0}; slot < slot_hashes_.size(); ++slot) {
+        if (test(live_, slot)) {
+          hashes.push_back(slot_hashes_[slot]);
+          ids.push_back(slot);
+        }
+      }
+
+      for (auto const& entry : table_) {
+        if (entry.id != npos_id) {
+          hashes.push_back(entry.hash);
+          ids.push_back(entry.id);
+        }
+      }
+
+      auto self = from_hashes(hashes, options);
+
+      for (auto index = std::size_t{0}; index < hashes.size(); ++index) {
+        std::invoke(sink, ids[index], self.base_[hashes[index]].first);
+      }
+
+      return {std::move(self), std::move(sink)};
+    }
+
+    [[nodiscard]] static_index_overlay compacted(static_index_build_options const& options = {}) const {
+      return compacted([](std::size_t, std::size_t) {}, options).first;
+    }
+
+    // --- Observers ---
+
+    // The number of keys.
+    [[nodiscard]] std::size_t size() const noexcept {
+      return live_count_ + overlay_size_;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    // The number of slots of the perfect hash, and the first id of an
+    // inserted key.
+    [[nodiscard]] std::size_t slot_count() const noexcept {
+      return base_.slot_count();
+    }
+
+    // One more than the largest id handed out, for sizing an array of
+    // values indexed by id.
+    [[nodiscard]] std::size_t id_bound() const noexcept {
+      return next_id_;
+    }
+
+    // The number of inserted keys in the overlay. Together with the
+    // tombstone count, it tells how far the index has drifted from its
+    // perfect hash, and so when to compact it.
+    [[nodiscard]] std::size_t overlay_size() const noexcept {
+      return overlay_size_;
+    }
+
+    // The number of erased keys of the base.
+    [[nodiscard]] std::size_t tombstone_count() const noexcept {
+      return base_size_ - live_count_;
+    }
+
+    [[nodiscard]] std::size_t memory_usage_bytes() const noexcept {
+      return base_.memory_usage_bytes() + (slot_hashes_.size() * sizeof(key_128)) +
+             (live_.size() * sizeof(std::uint64_t)) + (table_.size() * sizeof(overlay_entry)) +
+             (filter_.size() * sizeof(std::uint64_t));
+    }
+  };
+
+} // namespace vault::containers
+
+#endif // VAULT_STATIC_INDEX_STATIC_INDEX_OVERLAY_HPP
@@ -0,0 +1,241 @@
+#ifndef VAULT_STATIC_INDEX_STATIC_MAP_HPP
+#define VAULT_STATIC_INDEX_STATIC_MAP_HPP
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <vault/executor/thread_executor.hpp>
+#include <vault/frozen_vector/frozen_vector.hpp>
+#include <vault/frozen_vector/frozen_vector_builder.hpp>
+
+#include <vault/static_index/static_index.hpp>
+#include <vault/static_index/traits.hpp>
+
+namespace vault::containers {
+
+  template <
+    typename Key,
+    typename Value,
+    typename Fingerprint = std::size_t,
+    typename Proj        = key_128_high,
+    typename Comp        = std::equal_to<>,
+    typename Policy      = default_phf_policy>
+  class static_map_builder;
+
+  // An immutable map from the keys it was built with to their values. The
+  // perfect hash of static_index selects a slot, and the slot holds the
+  // fingerprint of its key next to its value, so a lookup that hits costs
+  // one memory access after the perfect hash instead of one for the
+  // fingerprint and another for a separate value array. A slot whose size
+  // divides 64 never straddles a cache line.
+  //
+  // Like static_index, a key that was not in the map is only rejected by
+  // its fingerprint, and is found with a probability of about one in
+  // 2^bits of the fingerprint.
+  template <
+    typename Key,
+    typename Value,
+    typename Fingerprint = std::size_t,
+    typename Proj        = key_128_high,
+    typename Comp        = std::equal_to<>,
+    typename Policy      = default_phf_policy>
+  class static_map : private basic_static_index_base<Policy> {
+    using base_t = basic_static_index_base<Policy>;
+
+  public:
+    struct slot_type {
+      Fingerprint fingerprint;
+      Value       value;
+    };
+
+  private:
+    frozen::frozen_vector<slot_type> slots_;
+    std::size_t                      size_ = 0;
+
+    [[no_unique_address]] Comp comp_;
+    [[no_unique_address]] Proj proj_;
+
+    [[nodiscard]] static_map(
+      base_t                           base,
+      frozen::frozen_vector<slot_type> slots,
+      std::size_t                      size,
+      Proj                             proj,
+      Comp                             comp
+    )
+      : base_t(std::move(base))
+      , slots_(std::move(slots))
+      , size_(size)
+      , comp_(std::move(comp))
+      , proj_(std::move(proj)) {}
+
+    friend class static_map_builder<Key, Value, Fingerprint, Proj, Comp, Policy>;
+
+    template <typename K>
+    [[nodiscard]] bool matches(K const& item, key_128 const& hash, std::size_t slot) const {
+      return slot != npos && std::invoke(comp_, std::invoke(proj_, item, hash), slots_[slot].fingerprint);
+    }
+
+  public:
+    using key_type    = Key;
+    using mapped_type = Value;
+
+    using base_t::empty;
+    using base_t::npos;
+    using base_t::slot_count;
+
+    [[nodiscard]] static_map() = default;
+
+    // The number of keys.
+    [[nodiscard]] std::size_t size() const noexcept {
+      return size_;
+    }
+
+    // The bytes of the perfect hash and of the slots.
+    [[nodiscard]] std::size_t memory_usage_bytes() const noexcept {
+      return base_t::memory_usage_bytes() + (slots_.size() * sizeof(slot_type));
+    }
+
+    // The value of `item`, or nullptr if `item` is not in the map.
+    template <concepts::underlying_byte_sequences K>
+      requires std::predicate<
+        Comp,
+        std::invoke_result_t<Proj, K const&, key_128 const&>,
+        std::invoke_result_t<Proj, K const&, key_128 const&>>
+    [[nodiscard]] Value const* find(K const& item) const noexcept {
+      auto const hash = detail::hash_of(item);
+      auto const slot = base_t::operator[](hash).first;
+
+      return matches(item, hash, slot) ? std::addressof(slots_[slot].value) : nullptr;
+    }
+
+    template <concepts::underlying_byte_sequences K>
+      requires std::predicate<
+        Comp,
+        std::invoke_result_t<Proj, K const&, key_128 const&>,
+        std::invoke_result_t<Proj, K const&, key_128 const&>>
+    [[nodiscard]] bool contains(K const& item) const noexcept {
+      return find(item) != nullptr;
+    }
+
+    // Looks up every item of `items` and writes a pointer to its value, or
+    // nullptr, to `out` in order. Items are hashed a batch at a time; the
+    // slots of a batch are then found and prefetched before any of them is
+    // compared, so that the cache misses of a batch overlap.
+    template <std::ranges::forward_range R, std::output_iterator<Value const*> O>
+      requires concepts::underlying_byte_sequences<std::ranges::range_value_t<R>> &&
+               std::predicate<
+                 Comp,
+                 std::invoke_result_t<Proj, std::ranges::range_reference_t<R>, key_128 const&>,
+                 std::invoke_result_t<Proj, std::ranges::range_reference_t<R>, key_128 const&>>
+    O lookup_many(R&& items, O out) const {
+      detail::for_each_hashed_batch(items, [&](auto cursors, std::span<key_128 const> hashes) {
+        auto slots = std::array<std::size_t, static_index_base::lookup_batch_size>{};
+        base_t::lookup_many(hashes, slots);
+
+        for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+          if (slots[i] != npos) {
+            __builtin_prefetch(std::addressof(slots_[slots[i]]), 0, 3);
+          }
+        }
+
+        for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+          *out++ = matches(*cursors[i], hashes[i], slots[i]) ? std::addressof(slots_[slots[i]].value) : nullptr;
+        }
+      });
+
+      return out;
+    }
+  };
+
+  template <typename Key, typename Value, typename Fingerprint, typename Proj, typename Comp, typename Policy>
+  class static_map_builder {
+    using map_t  = static_map<Key, Value, Fingerprint, Proj, Comp, Policy>;
+    using slot_t = typename map_t::slot_type;
+
+    std::vector<key_128>       hashes_;
+    std::vector<slot_t>        slots_;
+    static_index_build_options options_;
+
+    [[no_unique_address]] Comp comp_;
+    [[no_unique_address]] Proj proj_;
+
+  public:
+    [[nodiscard]] static_map_builder() = default;
+
+    [[nodiscard]] explicit static_map_builder(Proj proj)
+      : proj_(std::move(proj)) {}
+
+    [[nodiscard]] static_map_builder(Proj proj, Comp comp)
+      : comp_(std::move(comp))
+      , proj_(std::move(proj)) {}
+
+    template <typename Self>
+    Self with_options(this Self&& self, static_index_build_options options) {
+      self.options_ = std::move(options);
+      return std::forward<Self>(self);
+    }
+
+    // Adds every (key, value) pair of `entries`.
+    template <typename Self, std::ranges::input_range R>
+    Self add_n(this Self&& self, R&& entries) {
+      for (auto&& [key, value] : entries) {
+        self.add_1(key, value);
+      }
+
+      return std::forward<Self>(self);
+    }
+
+    template <typename Self, typename K, typename V>
+      requires concepts::underlying_byte_sequences<std::remove_cvref_t<K>> && std::constructible_from<Value, V>
+    Self add_1(this Self&& self, K&& key, V&& value) {
+      auto hash = detail::hash_of(key);
+
+      auto fingerprint = static_cast<Fingerprint>(std::invoke(self.proj_, key, hash));
+      self.slots_.push_back(slot_t{std::move(fingerprint), Value(std::forward<V>(value))});
+
+      try {
+        self.hashes_.emplace_back(hash);
+      } catch (...) {
+        self.slots_.pop_back();
+        throw;
+      }
+
+      return std::forward<Self>(self);
+    }
+
+    [[nodiscard]] map_t build() &&
+      requires std::default_initializable<Value>
+    {
+      auto base = basic_static_index_base<Policy>::build(hashes_, options_);
+
+      // Every key has a slot of its own, so the threads never write to the
+      // same slot. The slots of a non-minimal perfect hash that no key maps
+      // to keep a default value.
+      auto permuted_slots = frozen::frozen_vector_builder<slot_t>(base.slot_count(), slot_t{});
+
+      constexpr auto permutation_grain = std::size_t{1} << 16;
+
+      algorithm::thread_executor{options_.thread_count}(
+        hashes_.size(), permutation_grain, [&](std::size_t, std::size_t first, std::size_t last) {
+          for (auto index = first; index < last; ++index) {
+            permuted_slots[base[hashes_[index]].first] = std::move(slots_[index]);
+          }
+        }
+      );
+
+      return {std::move(base), std::move(permuted_slots).freeze(), hashes_.size(), std::move(proj_), std::move(comp_)};
+    }
+  };
+
+} // namespace vault::containers
+
+#endif // VAULT_STATIC_INDEX_STATIC_MAP_HPP
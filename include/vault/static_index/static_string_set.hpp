@@ -0,0 +1,184 @@
+#ifndef VAULT_STATIC_INDEX_STATIC_STRING_SET_HPP
+#define VAULT_STATIC_INDEX_STATIC_STRING_SET_HPP
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <vault/algorithm/fsst_dictionary.hpp>
+#include <vault/executor/thread_executor.hpp>
+#include <vault/frozen_vector/frozen_vector.hpp>
+#include <vault/frozen_vector/frozen_vector_builder.hpp>
+
+#include <vault/static_index/static_index.hpp>
+
+namespace vault::containers {
+
+  // An immutable set of strings that maps each of them to a dense id, its
+  // slot in a static_index perfect hash, and stores them compressed in an
+  // fsst_dictionary. The fsst_key of every string is kept in slot order,
+  // and a lookup checks the string in its slot against the query in the
+  // compressed domain, so membership is exact without fingerprints or a
+  // raw copy of the strings.
+  //
+  // A string of up to 7 bytes is held in its key, and is compared without
+  // touching the dictionary.
+  template <typename Policy = default_phf_policy>
+  class static_string_set : private basic_static_index_base<Policy> {
+    using base_t = basic_static_index_base<Policy>;
+
+    algorithm::fsst_dictionary_base            dictionary_;
+    frozen::frozen_vector<algorithm::fsst_key> keys_;
+    std::size_t                                size_ = 0;
+
+    [[nodiscard]] static_string_set(
+      base_t                                     base,
+      algorithm::fsst_dictionary_base            dictionary,
+      frozen::frozen_vector<algorithm::fsst_key> keys,
+      std::size_t                                size
+    )
+      : base_t(std::move(base))
+      , dictionary_(std::move(dictionary))
+      , keys_(std::move(keys))
+      , size_(size) {}
+
+    [[nodiscard]] bool matches(std::string_view item, std::size_t slot) const {
+      if (slot == npos) {
+        return false;
+      }
+
+      auto const key = keys_[slot];
+
+      if (algorithm::fsst_dictionary_base::is_inline_candidate(item)) {
+        return key == algorithm::fsst_dictionary_base::make_inline_key(item);
+      }
+
+      return !algorithm::fsst_dictionary_base::is_inline_key(key) &&
+             dictionary_.equals(key, dictionary_.compress_probe(item));
+    }
+
+  public:
+    using base_t::empty;
+    using base_t::npos;
+    using base_t::slot_count;
+
+    [[nodiscard]] static_string_set() = default;
+
+    // Builds the set of `strings`, which must be distinct. The strings are
+    // read twice: once to hash them, and once to compress them.
+    template <std::ranges::forward_range R>
+      requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+    [[nodiscard]] static static_string_set build(
+      R&&                                           strings,
+      static_index_build_options const&             options = {},
+      algorithm::fsst_dictionary_base::sample_ratio ratio   = {}
+    ) {
+      auto hashes = std::vector<key_128>{};
+      for (auto&& item : strings) {
+        hashes.push_back(detail::hash_of(std::string_view{item}));
+      }
+
+      auto base = base_t::build(hashes, options);
+
+      auto [dictionary, keys] = algorithm::fsst_dictionary_base::build_from_unique(
+        strings, ratio, algorithm::fsst_dictionary_base::thread_count{options.thread_count}
+      );
+
+      // Every string has a slot of its own, so the threads never write to
+      // the same key. The slots of a non-minimal perfect hash that no
+      // string maps to hold a key that matches no query.
+      auto slot_keys =
+        frozen::frozen_vector_builder<algorithm::fsst_key>(base.slot_count(), algorithm::fsst_key{0});
+
+      constexpr auto permutation_grain = std::size_t{1} << 16;
+
+      algorithm::thread_executor{options.thread_count}(
+        hashes.size(), permutation_grain, [&](std::size_t, std::size_t first, std::size_t last) {
+          for (auto index = first; index < last; ++index) {
+            slot_keys[base[hashes[index]].first] = keys[index];
+          }
+        }
+      );
+
+      return {std::move(base), std::move(dictionary), std::move(slot_keys).freeze(), hashes.size()};
+    }
+
+    // --- Lookup ---
+
+    // The id of `item`, or nullopt if it is not in the set.
+    [[nodiscard]] std::optional<std::size_t> operator[](std::string_view item) const {
+      auto const slot = base_t::operator[](detail::hash_of(item)).first;
+      return matches(item, slot) ? std::optional{slot} : std::nullopt;
+    }
+
+    [[nodiscard]] bool contains(std::string_view item) const {
+      return (*this)[item].has_value();
+    }
+
+    // Looks up every item of `items` and writes its id, or nullopt, to
+    // `out` in order. The slots of a batch are found, and their keys
+    // prefetched, before any string is compared.
+    template <std::ranges::forward_range R, std::output_iterator<std::optional<std::size_t>> O>
+      requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+    O lookup_many(R&& items, O out) const {
+      auto views = std::ranges::views::transform(items, [](auto const& item) { return std::string_view{item}; });
+
+      detail::for_each_hashed_batch(views, [&](auto cursors, std::span<key_128 const> hashes) {
+        auto slots = std::array<std::size_t, static_index_base::lookup_batch_size>{};
+        base_t::lookup_many(hashes, slots);
+
+        for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+          if (slots[i] != npos) {
+            __builtin_prefetch(std::addressof(keys_[slots[i]]), 0, 3);
+          }
+        }
+
+        for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+          *out++ = matches(*cursors[i], slots[i]) ? std::optional{slots[i]} : std::nullopt;
+        }
+      });
+
+      return out;
+    }
+
+    // --- Access by Id ---
+
+    // The key of the string with id `slot` in dictionary().
+    [[nodiscard]] algorithm::fsst_key key(std::size_t slot) const noexcept {
+      return keys_[slot];
+    }
+
+    // The string with id `slot`, decompressed.
+    [[nodiscard]] std::string value(std::size_t slot) const {
+      return try_find<std::string>(dictionary_, keys_[slot]).value_or(std::string{});
+    }
+
+    [[nodiscard]] algorithm::fsst_dictionary_base const& dictionary() const noexcept {
+      return dictionary_;
+    }
+
+    // --- Observers ---
+
+    // The number of strings.
+    [[nodiscard]] std::size_t size() const noexcept {
+      return size_;
+    }
+
+    // The bytes of the perfect hash, the keys and the compressed strings.
+    [[nodiscard]] std::size_t memory_usage_bytes() const noexcept {
+      return base_t::memory_usage_bytes() + (keys_.size() * sizeof(algorithm::fsst_key)) +
+             dictionary_.size_in_bytes();
+    }
+  };
+
+} // namespace vault::containers
+
+#endif // VAULT_STATIC_INDEX_STATIC_STRING_SET_HPP
@@ -27,6 +27,14 @@ namespace vault::containers::concepts {
   concept underlying_byte_sequences = requires(const T& t) {
     traits::underlying_byte_sequences<std::remove_cvref_t<T>>::visit(t, [](std::span<std::byte const>) {});
   };
+
+  // --- Concept: Contiguous Byte Sequence ---
+  // A hashable type whose bytes are a single block, which can be hashed
+  // in one call instead of through a visitor.
+  template <typename T>
+  concept contiguous_byte_sequence = underlying_byte_sequences<T> && requires(const T& t) {
+    { traits::underlying_byte_sequences<std::remove_cvref_t<T>>::bytes(t) } -> std::same_as<std::span<std::byte const>>;
+  };
 } // namespace vault::containers::concepts
 
 namespace vault::containers::traits {
@@ -36,7 +44,11 @@ namespace vault::containers::traits {
   struct underlying_byte_sequences<T> {
     template <concepts::byte_sequence_visitor V>
     static void visit(const T& val, V&& v) {
-      v(std::as_bytes(std::span(&val, 1)));
+      v(bytes(val));
+    }
+
+    static std::span<std::byte const> bytes(const T& val) noexcept {
+      return std::as_bytes(std::span(&val, 1));
     }
   };
 
@@ -51,7 +63,11 @@ namespace vault::containers::traits {
     template <concepts::byte_sequence_visitor V>
     static void visit(const T& range, V&& v) {
       // Optimization: Hash the whole block at once
-      v(std::as_bytes(std::span(range)));
+      v(bytes(range));
+    }
+
+    static std::span<std::byte const> bytes(const T& range) noexcept {
+      return std::as_bytes(std::span(range));
     }
   };
 
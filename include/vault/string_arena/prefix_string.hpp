@@ -0,0 +1,302 @@
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <vault/frozen_vector/frozen_vector.hpp>
+#include <vault/string_arena/string_arena.hpp>
+
+namespace vault::arena {
+
+  /// # prefix_string
+  /// An immutable arena string whose first bytes are kept in its header, so
+  /// that most comparisons never dereference the arena.
+  ///
+  /// It utilizes a 16-byte memory footprint in the layout of the Umbra and
+  /// DuckDB strings: a 4-byte length, the first 4 bytes of the string, and
+  /// either the next 8 bytes inline or a pointer to the whole string in an
+  /// arena. Strings `inline_capacity` bytes or shorter are stored entirely
+  /// inline, padded with zeros, and are not null-terminated.
+  ///
+  /// Equality compares the two 8-byte halves of the headers, and only
+  /// dereferences indirect strings whose length and prefix are equal and
+  /// whose pointers differ. Ordering compares the prefixes as one big-endian
+  /// word first. Hashing reads the header alone for inline strings.
+  ///
+  /// **Constraints**
+  /// - Requires a 64-bit little-endian architecture.
+  /// - Strings must not exceed 2^32 - 1 bytes.
+  class prefix_string {
+  public:
+    using value_type      = char;
+    using pointer         = char const*;
+    using const_pointer   = char const*;
+    using reference       = char const&;
+    using const_reference = char const&;
+    using const_iterator  = char const*;
+    using iterator        = const_iterator;
+    using size_type       = std::size_t;
+    using difference_type = std::ptrdiff_t;
+
+    /// \brief The length of the prefix kept in the header of every string.
+    static constexpr auto prefix_size = std::size_t{4};
+
+    /// \brief The maximum number of bytes stored within the header.
+    static constexpr auto inline_capacity = std::size_t{12};
+
+    /// Constructs an empty, inline string.
+    [[nodiscard]] prefix_string() noexcept;
+
+    /// Constructs a prefix string from a raw pointer and explicit size. The
+    /// characters of an indirect string must outlive it.
+    ///
+    /// - `data`: Pointer to the raw character array.
+    /// - `size`: The length of the string.
+    [[nodiscard]] prefix_string(char const* data, std::size_t size) noexcept;
+
+    /// Returns a pointer to the underlying character array.
+    [[nodiscard]] auto data() const noexcept -> char const*;
+
+    /// Returns the active length of the string.
+    [[nodiscard]] auto size() const noexcept -> std::size_t;
+
+    /// Evaluates whether the string is stored entirely within the 16-byte struct.
+    [[nodiscard]] auto is_inline() const noexcept -> bool;
+
+    /// Evaluates if the string length is zero.
+    [[nodiscard]] auto empty() const noexcept -> bool;
+
+    [[nodiscard]] auto begin() const noexcept -> const_iterator;
+    [[nodiscard]] auto end() const noexcept -> const_iterator;
+    [[nodiscard]] auto cbegin() const noexcept -> const_iterator;
+    [[nodiscard]] auto cend() const noexcept -> const_iterator;
+
+    [[nodiscard]] auto operator[](std::size_t index) const noexcept -> char const&;
+
+    [[nodiscard]] explicit operator std::string_view() const noexcept;
+
+    /// Returns a hash of the characters, computed from the header alone for
+    /// inline strings.
+    [[nodiscard]] auto hash() const noexcept -> std::size_t;
+
+    friend auto operator==(prefix_string const& lhs, prefix_string const& rhs) noexcept -> bool;
+
+    friend auto operator<=>(prefix_string const& lhs, prefix_string const& rhs) noexcept
+      -> std::strong_ordering;
+
+  private:
+    /// The length and the prefix, as one word.
+    [[nodiscard]] auto head_word() const noexcept -> std::uint64_t;
+
+    /// The inline suffix or the pointer, as one word.
+    [[nodiscard]] auto tail_word() const noexcept -> std::uint64_t;
+
+    /// The prefix, as a word that orders like the bytes.
+    [[nodiscard]] auto prefix_key() const noexcept -> std::uint32_t;
+
+    /// The layout of an inline string: its characters, padded with zeros.
+    struct inline_layout {
+      std::uint32_t size;
+      char          chars[inline_capacity];
+    };
+
+    /// The layout of an indirect string: its prefix, and all of its
+    /// characters in the arena.
+    struct indirect_layout {
+      std::uint32_t size;
+      char          prefix[prefix_size];
+      char const*   data;
+    };
+
+    // Both layouts begin with the size, which may be read through either.
+    union {
+      inline_layout   inline_;
+      indirect_layout indirect_;
+    };
+  };
+
+  static_assert(sizeof(prefix_string) == 16, "vault::arena::prefix_string must be exactly 16 bytes.");
+
+  // -----------------------------------------------------------------------------
+  // prefix_string Inline Definitions
+  // -----------------------------------------------------------------------------
+
+  [[nodiscard]] inline prefix_string::prefix_string() noexcept
+    : inline_{} {}
+
+  [[nodiscard]] inline prefix_string::prefix_string(char const* data, std::size_t size) noexcept
+    : inline_{.size = static_cast<std::uint32_t>(size), .chars = {}} {
+    assert(size <= std::numeric_limits<std::uint32_t>::max() && "String size exceeds 32-bit capacity.");
+
+    if (size <= inline_capacity) {
+      std::memcpy(inline_.chars, data, size);
+    } else {
+      indirect_ = indirect_layout{.size = static_cast<std::uint32_t>(size), .prefix = {}, .data = data};
+      std::memcpy(indirect_.prefix, data, prefix_size);
+    }
+  }
+
+  [[nodiscard]] inline auto prefix_string::is_inline() const noexcept -> bool {
+    return inline_.size <= inline_capacity;
+  }
+
+  [[nodiscard]] inline auto prefix_string::size() const noexcept -> std::size_t {
+    return inline_.size;
+  }
+
+  [[nodiscard]] inline auto prefix_string::data() const noexcept -> char const* {
+    if (is_inline()) {
+      return inline_.chars;
+    } else {
+      return indirect_.data;
+    }
+  }
+
+  [[nodiscard]] inline auto prefix_string::empty() const noexcept -> bool {
+    return inline_.size == 0;
+  }
+
+  [[nodiscard]] inline auto prefix_string::begin() const noexcept -> const_iterator {
+    return data();
+  }
+
+  [[nodiscard]] inline auto prefix_string::end() const noexcept -> const_iterator {
+    return data() + size();
+  }
+
+  [[nodiscard]] inline auto prefix_string::cbegin() const noexcept -> const_iterator {
+    return data();
+  }
+
+  [[nodiscard]] inline auto prefix_string::cend() const noexcept -> const_iterator {
+    return data() + size();
+  }
+
+  [[nodiscard]] inline auto prefix_string::operator[](std::size_t index) const noexcept -> char const& {
+    assert(index < size() && "Index out of bounds.");
+    return data()[index];
+  }
+
+  [[nodiscard]] inline prefix_string::operator std::string_view() const noexcept {
+    return std::string_view{data(), size()};
+  }
+
+  [[nodiscard]] inline auto prefix_string::head_word() const noexcept -> std::uint64_t {
+    auto word = std::uint64_t{};
+    std::memcpy(&word, this, sizeof(word));
+    return word;
+  }
+
+  [[nodiscard]] inline auto prefix_string::tail_word() const noexcept -> std::uint64_t {
+    auto word = std::uint64_t{};
+    std::memcpy(&word, reinterpret_cast<char const*>(this) + sizeof(word), sizeof(word));
+    return word;
+  }
+
+  [[nodiscard]] inline auto prefix_string::prefix_key() const noexcept -> std::uint32_t {
+    // The prefix is the high half of the head word on a little-endian target.
+    return std::byteswap(static_cast<std::uint32_t>(head_word() >> 32));
+  }
+
+  [[nodiscard]] inline auto prefix_string::hash() const noexcept -> std::size_t {
+    if (!is_inline()) {
+      return std::hash<std::string_view>{}(std::string_view{*this});
+    }
+
+    // The finalizer of MurmurHash3 over both words. The padding of an inline
+    // string is zero, so equal strings have equal words.
+    auto h = head_word() ^ (tail_word() * 0x9e3779b97f4a7c15ULL);
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return static_cast<std::size_t>(h);
+  }
+
+  [[nodiscard]] inline auto operator==(prefix_string const& lhs, prefix_string const& rhs) noexcept -> bool {
+    if (lhs.head_word() != rhs.head_word()) {
+      return false;
+    }
+
+    // Equal inline strings have equal suffixes, and indirect strings that
+    // share their characters have equal pointers.
+    if (lhs.tail_word() == rhs.tail_word()) {
+      return true;
+    }
+
+    return !lhs.is_inline()
+        && std::memcmp(lhs.indirect_.data + prefix_string::prefix_size,
+             rhs.indirect_.data + prefix_string::prefix_size,
+             lhs.size() - prefix_string::prefix_size)
+             == 0;
+  }
+
+  [[nodiscard]] inline auto operator<=>(prefix_string const& lhs, prefix_string const& rhs) noexcept
+    -> std::strong_ordering {
+    if (auto const order = lhs.prefix_key() <=> rhs.prefix_key(); order != 0) {
+      return order;
+    }
+
+    // A prefix padded with zeros can equal the prefix of a longer string
+    // that contains zeros, so the tie is broken on the whole strings.
+    return std::string_view{lhs}.compare(std::string_view{rhs}) <=> 0;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builder Declarations
+  // -----------------------------------------------------------------------------
+
+  /// \brief Constructs an arena of prefix strings from a generator function.
+  ///
+  /// Behaves like `to_arena`, with the strings larger than
+  /// `prefix_string::inline_capacity` copied back to back into the buffer,
+  /// each followed by a null terminator.
+  ///
+  /// \param chars_source A generator function that accepts a reference to a sink
+  ///                     and invokes it exactly once per string.
+  /// \return A pair containing the populated vector of prefix strings and the
+  ///         owning shared memory buffer for any indirect strings.
+  [[nodiscard]] auto to_prefix_arena(std::function<void(chars_sink&)> chars_source)
+    -> std::pair<std::vector<prefix_string>, frozen::frozen_vector<char>>;
+
+  /// \brief Constructs an arena of prefix strings from an input range.
+  ///
+  /// Delegates directly to the generator overload.
+  ///
+  /// \tparam R The type of the input range.
+  /// \param range A range whose reference type is convertible to std::string_view.
+  /// \return A pair containing the populated vector of prefix strings and the
+  ///         owning shared memory buffer.
+  template <std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+  [[nodiscard]] auto to_prefix_arena(R&& range)
+    -> std::pair<std::vector<prefix_string>, frozen::frozen_vector<char>> {
+    auto chars_source = [&range](chars_sink& sink) {
+      for (auto const& item : range) {
+        sink(std::string_view{item});
+      }
+    };
+
+    return to_prefix_arena(std::move(chars_source));
+  }
+
+} // namespace vault::arena
+
+template <>
+struct std::hash<vault::arena::prefix_string> {
+  [[nodiscard]] auto operator()(vault::arena::prefix_string const& str) const noexcept -> std::size_t {
+    return str.hash();
+  }
+};
@@ -4,14 +4,19 @@
 #include <cassert>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <iterator>
+#include <numeric>
 #include <ranges>
 #include <span>
 #include <string_view>
 #include <utility>
 #include <vector>
 
+#include <vault/executor/thread_executor.hpp>
 #include <vault/frozen_vector/frozen_vector.hpp>
+#include <vault/frozen_vector/frozen_vector_builder.hpp>
 
 namespace vault::arena {
 
@@ -171,12 +176,83 @@ namespace vault::arena {
   }
 
   // -----------------------------------------------------------------------------
-  // Builder Declarations
+  // Sink Declarations
   // -----------------------------------------------------------------------------
 
   /// \brief A type-erased callback used to sink character ranges into the arena.
   using chars_sink = std::function<void(std::span<char const> chars)>;
 
+  /// # arena_sink
+  /// The sink that `to_arena` collects strings with.
+  ///
+  /// Every call appends one string: short strings are kept inline, and the
+  /// characters of long strings are copied back to back, each followed by a
+  /// null terminator, into a buffer that `finish` freezes. Generators that
+  /// take the sink by a deduced type call it directly rather than through a
+  /// `chars_sink`.
+  class arena_sink {
+  public:
+    /// Reserves room for `count` strings.
+    void reserve(std::size_t count);
+
+    /// Appends a string.
+    void operator()(std::span<char const> chars);
+
+    /// Returns the strings appended, in order, and the buffer of their
+    /// indirect strings.
+    [[nodiscard]] auto finish() && -> std::pair<std::vector<string>, frozen::frozen_vector<char>>;
+
+  private:
+    // Strings are exclusively either inline or indirect, so the union saves
+    // 8 bytes per element.
+    struct pending_string_info {
+      std::size_t size;
+
+      union {
+        std::size_t offset;
+        char        inline_data[max_inline_size];
+      };
+    };
+
+    frozen::frozen_vector_builder<char> buffer_;
+    std::vector<pending_string_info>    pending_strings_;
+  };
+
+  // -----------------------------------------------------------------------------
+  // arena_sink Inline Definitions
+  // -----------------------------------------------------------------------------
+
+  inline void arena_sink::reserve(std::size_t count) {
+    pending_strings_.reserve(count);
+  }
+
+  inline void arena_sink::operator()(std::span<char const> chars) {
+    auto pending = pending_string_info{.size = chars.size()};
+
+    if (chars.size() <= max_inline_size) {
+      std::copy(chars.begin(), chars.end(), pending.inline_data);
+    } else {
+      pending.offset = buffer_.size();
+      buffer_.append_range(chars);
+      buffer_.push_back('\0');
+    }
+
+    pending_strings_.push_back(pending);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Builder Declarations
+  // -----------------------------------------------------------------------------
+
+  namespace detail {
+    /// \brief Whether freezing a builder of storage policy `Policy` seals its
+    /// storage first, which may move it.
+    template <typename Policy>
+    constexpr auto seals_on_freeze = requires(typename Policy::mutable_handle_type& handle) {
+      Policy::seal(handle, std::size_t{});
+    };
+  } // namespace detail
+
   /// \brief Constructs an arena of strings from a generator function.
   ///
   /// This function utilizes a two-pass approach to guarantee pointer stability
@@ -191,9 +267,28 @@ namespace vault::arena {
   [[nodiscard]] auto to_arena(std::function<void(chars_sink&)> chars_source)
     -> std::pair<std::vector<string>, frozen::frozen_vector<char>>;
 
+  /// \brief Constructs an arena of strings from a generator that takes the
+  /// `arena_sink` itself.
+  ///
+  /// Behaves like the `chars_sink` overload, without a type-erased call per
+  /// string. Selected for generators that take the sink as `auto&`.
+  ///
+  /// \param chars_source A generator function that accepts a reference to a sink
+  ///                     and invokes it exactly once per string.
+  /// \return A pair containing the populated vector of arena strings and the
+  ///         owning shared memory buffer for any indirect strings.
+  template <typename Source>
+    requires std::invocable<Source&, arena_sink&>
+  [[nodiscard]] auto to_arena(Source&& chars_source)
+    -> std::pair<std::vector<string>, frozen::frozen_vector<char>> {
+    auto sink = arena_sink{};
+    chars_source(sink);
+    return std::move(sink).finish();
+  }
+
   /// \brief Constructs an arena of strings from an input range.
   ///
-  /// Delegates directly to the one-pass generator overload.
+  /// Feeds the strings of the range straight into an `arena_sink`.
   ///
   /// \tparam R The type of the input range.
   /// \param range A range whose reference type is convertible to std::string_view.
@@ -202,13 +297,228 @@ namespace vault::arena {
   template <std::ranges::input_range R>
     requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
   [[nodiscard]] auto to_arena(R&& range) -> std::pair<std::vector<string>, frozen::frozen_vector<char>> {
+    auto sink = arena_sink{};
+    if constexpr (std::ranges::sized_range<R>) {
+      sink.reserve(std::ranges::size(range));
+    }
+    for (auto const& item : range) {
+      sink(std::string_view{item});
+    }
+    return std::move(sink).finish();
+  }
+
+  /// \brief Constructs an arena of strings from a random-access range on the
+  /// workers of an executor.
+  ///
+  /// Builds the same arena as the serial overload in two parallel passes over
+  /// blocks of `arena_block_size` strings. The first sums the bytes of the long
+  /// strings of every block, and a prefix sum of the block totals sizes the
+  /// buffer and gives every block its offset in it. The second copies the long
+  /// strings into place and writes every `string` straight into the result.
+  /// The range is read twice, so converting an element to a string_view should
+  /// be cheap and must give the same string both times.
+  ///
+  /// \tparam R The type of the input range.
+  /// \param range A range whose reference type is convertible to std::string_view.
+  /// \param executor The chunked executor that runs both passes.
+  /// \return A pair containing the populated vector of arena strings and the
+  ///         owning shared memory buffer.
+  template <std::ranges::random_access_range R, vault::algorithm::chunked_executor Executor>
+    requires std::ranges::sized_range<R>
+          && std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+  [[nodiscard]] auto to_arena(R&& range, Executor const& executor)
+    -> std::pair<std::vector<string>, frozen::frozen_vector<char>> {
+    // Large enough to amortize a chunk's dispatch, small enough to balance
+    // strings of uneven lengths.
+    constexpr auto arena_block_size = std::size_t{4096};
+
+    auto const first       = std::ranges::begin(range);
+    auto const count       = static_cast<std::size_t>(std::ranges::size(range));
+    auto const block_count = (count + arena_block_size - 1) / arena_block_size;
+
+    auto const view_at = [&first](std::size_t i) {
+      return std::string_view{first[static_cast<std::ranges::range_difference_t<R>>(i)]};
+    };
+
+    // Pass 1: Sum the long-string bytes of every block, terminators included.
+    auto block_offsets = std::vector<std::size_t>(block_count + 1);
+    executor(block_count, 1, [&](std::size_t, std::size_t first_block, std::size_t last_block) {
+      for (auto block = first_block; block < last_block; ++block) {
+        auto const last  = std::min(count, (block + 1) * arena_block_size);
+        auto       bytes = std::size_t{0};
+        for (auto i = block * arena_block_size; i < last; ++i) {
+          auto const size = view_at(i).size();
+          bytes += size > max_inline_size ? size + 1 : 0;
+        }
+        block_offsets[block + 1] = bytes;
+      }
+    });
+
+    // Pass 2: Size the buffer from the prefix sum of the block totals.
+    std::inclusive_scan(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+
+    auto temp_buffer = frozen::frozen_vector_builder<char>{};
+    temp_buffer.reserve(block_offsets.back());
+    auto* const chars = temp_buffer.append_uninitialized(block_offsets.back());
+
+    // Pass 3: Copy the long strings into place and construct the strings.
+    auto result_strings = std::vector<string>(count);
+    executor(block_count, 1, [&](std::size_t, std::size_t first_block, std::size_t last_block) {
+      for (auto block = first_block; block < last_block; ++block) {
+        auto const last   = std::min(count, (block + 1) * arena_block_size);
+        auto       offset = block_offsets[block];
+        for (auto i = block * arena_block_size; i < last; ++i) {
+          auto const item = view_at(i);
+          if (item.size() <= max_inline_size) {
+            result_strings[i] = string(item.data(), item.size());
+          } else {
+            auto* const data_ptr = chars + offset;
+            std::copy(item.begin(), item.end(), data_ptr);
+            data_ptr[item.size()] = '\0';
+            result_strings[i]     = string(data_ptr, item.size());
+            offset += item.size() + 1;
+          }
+        }
+      }
+    });
+
+    // The long strings point into the builder's storage before it is
+    // frozen. Freezing hands the storage over where it is, unless the storage
+    // policy seals it first, which the default policy does not.
+    static_assert(
+      !detail::seals_on_freeze<frozen::shared_storage_policy<char>>,
+      "to_arena takes pointers into the buffer before freezing it."
+    );
+
+    auto shared_buffer = std::move(temp_buffer).freeze();
+    assert(shared_buffer.data() == chars && "Freezing must not move the buffer.");
+
+    return {std::move(result_strings), std::move(shared_buffer)};
+  }
+
+  /// \brief Constructs an arena of strings whose indirect strings share storage.
+  ///
+  /// Behaves like `to_arena`, except that the strings larger than
+  /// `max_inline_size` are not copied back to back. They are packed into their
+  /// greedy shortest common superstring instead, and every indirect string
+  /// points at its location in it. Equal strings, strings contained in others
+  /// and strings that overlap at their ends share bytes, so the buffer is never
+  /// larger than the one `to_arena` builds, and is much smaller for sets with
+  /// heavy prefix and suffix sharing.
+  ///
+  /// Indirect strings are **not** null-terminated, since the byte after a
+  /// string is usually the next byte of another one.
+  ///
+  /// \param chars_source A generator function that accepts a reference to a sink
+  ///                     and invokes it exactly once per string.
+  /// \return A pair containing the populated vector of arena strings and the
+  ///         owning shared memory buffer for any indirect strings.
+  [[nodiscard]] auto to_packed_arena(std::function<void(chars_sink&)> chars_source)
+    -> std::pair<std::vector<string>, frozen::frozen_vector<char>>;
+
+  /// \brief Constructs a packed arena of strings from an input range.
+  ///
+  /// Delegates directly to the generator overload.
+  ///
+  /// \tparam R The type of the input range.
+  /// \param range A range whose reference type is convertible to std::string_view.
+  /// \return A pair containing the populated vector of arena strings and the
+  ///         owning shared memory buffer.
+  template <std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+  [[nodiscard]] auto to_packed_arena(R&& range)
+    -> std::pair<std::vector<string>, frozen::frozen_vector<char>> {
+    auto chars_source = [&range](chars_sink& sink) {
+      for (auto const& item : range) {
+        sink(std::string_view{item});
+      }
+    };
+
+    return to_packed_arena(std::move(chars_source));
+  }
+
+  // -----------------------------------------------------------------------------
+  // Interning Declarations
+  // -----------------------------------------------------------------------------
+
+  /// \brief Options of `to_interned_arena`.
+  struct interning_options {
+    /// Whether to number the distinct strings. Short strings are then
+    /// deduplicated too, which costs a hash per short string.
+    bool dense_ids = false;
+  };
+
+  /// # interned_arena
+  /// An arena of strings in which equal indirect strings share their bytes.
+  struct interned_arena {
+    /// The strings, in input order.
+    std::vector<string> strings;
+
+    /// The owning buffer of the indirect strings, each distinct value stored
+    /// once and null-terminated.
+    frozen::frozen_vector<char> buffer;
+
+    /// With `interning_options::dense_ids`, the id of every string, in input
+    /// order: ids number the distinct strings by first appearance, so equal
+    /// strings, and only they, have equal ids. Empty otherwise.
+    std::vector<std::size_t> ids;
+
+    /// With `interning_options::dense_ids`, the first occurrence of every
+    /// distinct string, indexed by id. Its strings can be added to a
+    /// `static_index_builder` as they are, and the slot of an id looked up
+    /// once. Empty otherwise.
+    std::vector<string> distinct;
+
+    /// The number of indirect strings.
+    std::size_t indirect_count = 0;
+
+    /// The number of distinct indirect strings.
+    std::size_t distinct_indirect_count = 0;
+
+    /// The bytes the indirect strings would take in a `to_arena` buffer,
+    /// terminators included.
+    std::size_t indirect_bytes = 0;
+
+    /// The bytes of indirect strings that `to_arena` would store per byte
+    /// that is stored: 1 without duplicates, and 1 for an empty arena.
+    [[nodiscard]] auto dedup_ratio() const noexcept -> double {
+      return buffer.empty() ? 1.0 : static_cast<double>(indirect_bytes) / static_cast<double>(buffer.size());
+    }
+  };
+
+  /// \brief Constructs an arena of strings that stores every distinct
+  /// indirect string once.
+  ///
+  /// Behaves like `to_arena`, except that every string larger than
+  /// `max_inline_size` is hashed with the 128-bit XXH3 hash of
+  /// `static_index`, and its bytes are appended to the buffer only at its
+  /// first occurrence. Every later occurrence points at the same bytes.
+  ///
+  /// \param chars_source A generator function that accepts a reference to a sink
+  ///                     and invokes it exactly once per string.
+  /// \param options Whether to number the distinct strings.
+  /// \return The strings, their shared buffer and the interning statistics.
+  [[nodiscard]] auto to_interned_arena(
+    std::function<void(chars_sink&)> chars_source, interning_options const& options = {}) -> interned_arena;
+
+  /// \brief Constructs an interned arena of strings from an input range.
+  ///
+  /// Delegates directly to the generator overload.
+  ///
+  /// \tparam R The type of the input range.
+  /// \param range A range whose reference type is convertible to std::string_view.
+  /// \param options Whether to number the distinct strings.
+  /// \return The strings, their shared buffer and the interning statistics.
+  template <std::ranges::input_range R>
+    requires std::convertible_to<std::ranges::range_reference_t<R>, std::string_view>
+  [[nodiscard]] auto to_interned_arena(R&& range, interning_options const& options = {}) -> interned_arena {
     auto chars_source = [&range](chars_sink& sink) {
       for (auto const& item : range) {
-        sink(item);
+        sink(std::string_view{item});
       }
     };
 
-    return to_arena(std::move(chars_source));
+    return to_interned_arena(std::move(chars_source), options);
   }
 
 } // namespace vault::arena
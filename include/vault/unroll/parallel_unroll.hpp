@@ -0,0 +1,131 @@
+#ifndef VAULT_PARALLEL_UNROLL_HPP
+#define VAULT_PARALLEL_UNROLL_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <vault/executor/thread_executor.hpp>
+#include <vault/unroll/unroll.hpp>
+
+namespace vault::detail {
+
+  /// The cache line size that the chunks of `parallel_unroll_loop` are aligned to.
+  inline constexpr auto parallel_unroll_line_size = std::size_t{64};
+
+  /**
+   * The number of elements per cache line and the number of elements from
+   * `lb` to the next cache line boundary, for coordinates that address
+   * contiguous elements whose size divides a cache line. Other coordinates
+   * get one element per line and no lead, so their chunks are merely
+   * multiples of the unroll factor.
+   */
+  template <typename Coordinate>
+  [[nodiscard]] auto parallel_unroll_line_layout(Coordinate const& lb) noexcept -> std::pair<std::size_t, std::size_t> {
+    if constexpr (std::contiguous_iterator<Coordinate>) {
+      constexpr auto element_size = sizeof(std::iter_value_t<Coordinate>);
+      if constexpr (std::has_single_bit(element_size) && element_size <= parallel_unroll_line_size) {
+        auto const address = reinterpret_cast<std::uintptr_t>(std::to_address(lb));
+        if (address % element_size == 0) {
+          auto const misalignment = address % parallel_unroll_line_size;
+          auto const lead         = (parallel_unroll_line_size - misalignment) % parallel_unroll_line_size;
+          return {parallel_unroll_line_size / element_size, lead / element_size};
+        }
+      }
+    }
+    return {1, 0};
+  }
+
+} // namespace vault::detail
+
+namespace vault {
+
+  /// The default number of iterations per chunk of `parallel_unroll_loop`.
+  inline constexpr auto parallel_unroll_default_grain = std::size_t{16384};
+
+  /**
+   * Executes an unrolled loop over an affine coordinate range on the workers
+   * of a chunked executor.
+   *
+   * The range is cut into chunks whose lengths are multiples of both `K` and,
+   * for contiguous iterators, the elements of a cache line, with the chunk
+   * boundaries on cache line boundaries so that no two workers write to the
+   * same line. Each chunk runs through `unroll_loop<K>`, so only the first
+   * chunk, which ends at the first aligned boundary, and the last chunk run
+   * a logarithmic tail.
+   *
+   * The iterations run concurrently, in no particular order across chunks.
+   *
+   * ### Template Parameters
+   * - **K**: The unroll factor. Must be a power of 2.
+   * - **Coordinate**: The type of the lower and upper bounds, modeling an
+   * affine coordinate whose displacements are integers.
+   * - **Func**: The callable type representing the loop body.
+   * - **Executor**: The chunked executor that runs the chunks, by default a
+   * `thread_executor` over every hardware thread.
+   *
+   * ### Parameters
+   * - **lb**: The lower bound of the loop (inclusive).
+   * - **ub**: The upper bound of the loop (exclusive).
+   * - **func**: The callable to invoke for each iteration, concurrently. It
+   * accepts either the coordinate, or the index of the worker, in
+   * `[0, executor.concurrency())`, and the coordinate, to address per-worker
+   * scratch space.
+   * - **executor**: The executor that runs the chunks.
+   * - **grain**: The number of iterations per chunk, rounded up to a multiple
+   * of `K` and of the elements of a cache line.
+   *
+   * If `func` throws, the remaining chunks are abandoned as the executor
+   * specifies, and the exception is rethrown on the calling thread.
+   */
+  template <std::size_t K,
+    concepts::affine_coordinate        Coordinate,
+    typename Func,
+    vault::algorithm::chunked_executor Executor = vault::algorithm::thread_executor>
+    requires std::integral<decltype(std::declval<Coordinate>() - std::declval<Coordinate>())>
+          && (std::invocable<Func&, Coordinate> || std::invocable<Func&, std::size_t, Coordinate>)
+  void parallel_unroll_loop(Coordinate lb,
+    Coordinate                         ub,
+    Func&&                             func,
+    Executor const&                    executor = Executor{},
+    std::size_t                        grain    = parallel_unroll_default_grain) {
+    static_assert(std::has_single_bit(K), "The unroll factor K must be a power of 2.");
+    assert(lb <= ub && "The lower bound must not exceed the upper bound.");
+
+    using distance_t = decltype(ub - lb);
+
+    auto const count        = static_cast<std::size_t>(ub - lb);
+    auto const [line, lead] = detail::parallel_unroll_line_layout(lb);
+    auto const alignment    = std::max(K, line);
+    auto const aligned      = (std::max(grain, std::size_t{1}) + alignment - 1) / alignment * alignment;
+
+    // The executor cuts [0, offset + count) into chunks, and the first offset
+    // indices, which lie before lb, are dropped. The boundaries then fall at
+    // lb + lead plus multiples of a line.
+    auto const offset = (lead == 0 || lead >= count) ? std::size_t{0} : line - lead;
+
+    executor(offset + count, aligned, [&](std::size_t worker, std::size_t first, std::size_t last) {
+      first = std::max(first, offset) - offset;
+      last  = last - offset;
+
+      auto const chunk_lb = lb + static_cast<distance_t>(first);
+      auto const chunk_ub = lb + static_cast<distance_t>(last);
+
+      if constexpr (std::invocable<Func&, std::size_t, Coordinate>) {
+        unroll_loop<K>(chunk_lb, chunk_ub, [&](Coordinate c) { func(worker, c); });
+      } else {
+        unroll_loop<K>(chunk_lb, chunk_ub, func);
+      }
+    });
+  }
+
+} // namespace vault
+
+#endif // VAULT_PARALLEL_UNROLL_HPP
@@ -4,7 +4,10 @@
 #include <bit>
 #include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <utility>
 
 namespace vault::concepts {
@@ -113,6 +116,97 @@ namespace vault::detail {
 
 } // namespace vault::detail
 
+namespace vault {
+
+  /**
+   * A block of `N` consecutive coordinates of an unrolled loop, whose size is
+   * a compile-time constant.
+   *
+   * Passed whole to the body of `unroll_block_loop`, so that the body can
+   * process the block with a fixed-trip-count loop that the compiler can
+   * vectorize.
+   *
+   * ### Template Parameters
+   * - **Coordinate**: The affine coordinate type of the induction variable.
+   * - **N**: The number of coordinates in the block.
+   */
+  template <concepts::affine_coordinate Coordinate, std::size_t N>
+  struct unroll_block {
+    Coordinate first;
+
+    [[nodiscard]] static constexpr auto size() noexcept -> std::size_t {
+      return N;
+    }
+
+    [[nodiscard]] constexpr auto operator[](std::size_t i) const -> Coordinate {
+      using distance_t = decltype(first - first);
+      return first + static_cast<distance_t>(i);
+    }
+  };
+
+  /**
+   * The default address projection of the prefetching loops: the address a
+   * pointer or contiguous iterator coordinate refers to.
+   */
+  struct coordinate_address {
+    template <typename Coordinate>
+      requires requires(Coordinate const& c) { std::to_address(c); }
+    [[nodiscard]] constexpr auto operator()(Coordinate const& c) const noexcept {
+      return std::to_address(c);
+    }
+  };
+
+} // namespace vault
+
+namespace vault::detail {
+
+  /**
+   * Prefetches the coordinates `Distance`, `Distance + Stride`, ... up to
+   * `Distance + K` past `current`, that lie before the end of the loop, with
+   * `dist` the remaining distance.
+   */
+  template <std::size_t K,
+    std::size_t         Distance,
+    std::size_t         Stride,
+    vault::concepts::affine_coordinate Coordinate,
+    typename Distance_t,
+    typename Address>
+  constexpr void prefetch_group(Coordinate const& current, Distance_t const& dist, Address& address) {
+    if constexpr (Distance > 0) {
+      if !consteval {
+        [&]<std::size_t... Is>(std::index_sequence<Is...>) {
+          (..., [&] {
+            constexpr auto ahead = Distance + (Is * Stride);
+            // The coordinate is in bounds iff ahead < dist.
+            if (!(static_cast<Distance_t>(ahead) >= dist)) {
+              __builtin_prefetch(
+                static_cast<void const*>(std::invoke(address, current + static_cast<Distance_t>(ahead))), 0, 3);
+            }
+          }());
+        }(std::make_index_sequence<(K + Stride - 1) / Stride>{});
+      }
+    }
+  }
+
+  /**
+   * Recursively generates logarithmic tail blocks, as `unroll_tail` does, but
+   * invokes the body once per block with an `unroll_block` of size `Step`.
+   */
+  template <std::size_t Step, vault::concepts::affine_coordinate Coordinate, typename Distance, typename Func>
+  constexpr void unroll_block_tail(Coordinate& current, Distance& dist, Func&& func) {
+    if constexpr (Step > 0) {
+      auto step_dist = static_cast<Distance>(Step);
+      if (dist >= step_dist) {
+        func(unroll_block<Coordinate, Step>{current});
+        current += step_dist;
+        dist -= step_dist;
+      }
+      unroll_block_tail<Step / 2>(current, dist, std::forward<Func>(func));
+    }
+  }
+
+} // namespace vault::detail
+
 namespace vault {
 
   /**
@@ -152,6 +246,111 @@ namespace vault {
     detail::unroll_tail<K / 2>(current, dist, std::forward<Func>(func));
   }
 
+  /**
+   * Executes an unrolled loop, like `unroll_loop`, that prefetches the
+   * memory of the iterations `Distance` ahead of each unrolled group.
+   *
+   * Before each group of `K` iterations starting at `current`, the address of
+   * `current + Distance` is prefetched, and then every `Stride`-th coordinate
+   * after it within the group. The default `Stride` of `K` prefetches once per
+   * group, which suits contiguous access where a group shares a cache line; a
+   * `Stride` of 1 prefetches every element, which suits gathers through an
+   * index. Coordinates past the upper bound are never projected. The tail
+   * iterations issue no prefetches, having been covered by the last groups.
+   *
+   * ### Template Parameters
+   * - **K**: The unroll factor. Must be a power of 2.
+   * - **Distance**: How many iterations ahead to prefetch. 0 disables
+   * prefetching.
+   * - **Stride**: The distance between the prefetched coordinates of a group.
+   * - **Coordinate**: The type of the lower and upper bounds, modeling an affine coordinate.
+   * - **Func**: The callable type representing the loop body.
+   * - **Address**: The callable type projecting a coordinate to the address to prefetch.
+   *
+   * ### Parameters
+   * - **lb**: The lower bound of the loop (inclusive).
+   * - **ub**: The upper bound of the loop (exclusive).
+   * - **func**: The callable to invoke for each iteration. It must accept a single
+   * argument of type `Coordinate` by value.
+   * - **address**: Projects a coordinate to a pointer, e.g. `&data[index[i]]`
+   * for a gather. Defaults to the address of a pointer or contiguous iterator.
+   */
+  template <std::size_t K,
+    std::size_t         Distance,
+    std::size_t         Stride = K,
+    concepts::affine_coordinate Coordinate,
+    typename Func,
+    typename Address = coordinate_address>
+  constexpr void unroll_prefetch_loop(Coordinate lb, Coordinate ub, Func&& func, Address address = {}) {
+    static_assert(std::has_single_bit(K), "The unroll factor K must be a power of 2.");
+    static_assert(Stride > 0, "The prefetch stride must be positive.");
+    assert(lb <= ub && "The lower bound must not exceed the upper bound.");
+
+    using distance_t = decltype(ub - lb);
+    auto dist        = distance_t{ub - lb};
+    auto current     = Coordinate{lb};
+    auto k_dist      = static_cast<distance_t>(K);
+
+    while (dist >= k_dist) {
+      detail::prefetch_group<K, Distance, Stride>(current, dist, address);
+      detail::unroll_exact<K>(current, func);
+      dist -= k_dist;
+    }
+
+    detail::unroll_tail<K / 2>(current, dist, std::forward<Func>(func));
+  }
+
+  /**
+   * Executes a loop in blocks, invoking the body once per block of
+   * coordinates rather than once per coordinate.
+   *
+   * The body receives an `unroll_block<Coordinate, K>` for each full group,
+   * and then an `unroll_block` of each size `K/2`, `K/4`, ..., 1 that the
+   * remaining iterations call for, so every block has a compile-time size.
+   * Prefetching is as in `unroll_prefetch_loop`, and off by default.
+   *
+   * ### Template Parameters
+   * - **K**: The block size. Must be a power of 2.
+   * - **Distance**: How many iterations ahead to prefetch. 0 disables
+   * prefetching.
+   * - **Stride**: The distance between the prefetched coordinates of a block.
+   * - **Coordinate**: The type of the lower and upper bounds, modeling an affine coordinate.
+   * - **Func**: The callable type representing the loop body. It must accept an
+   * `unroll_block<Coordinate, N>` for every power of 2 `N` up to `K`.
+   * - **Address**: The callable type projecting a coordinate to the address to prefetch.
+   *
+   * ### Parameters
+   * - **lb**: The lower bound of the loop (inclusive).
+   * - **ub**: The upper bound of the loop (exclusive).
+   * - **func**: The callable to invoke for each block.
+   * - **address**: Projects a coordinate to a pointer to prefetch.
+   */
+  template <std::size_t K,
+    std::size_t         Distance = 0,
+    std::size_t         Stride   = K,
+    concepts::affine_coordinate Coordinate,
+    typename Func,
+    typename Address = coordinate_address>
+  constexpr void unroll_block_loop(Coordinate lb, Coordinate ub, Func&& func, Address address = {}) {
+    static_assert(std::has_single_bit(K), "The block size K must be a power of 2.");
+    static_assert(Stride > 0, "The prefetch stride must be positive.");
+    assert(lb <= ub && "The lower bound must not exceed the upper bound.");
+
+    using distance_t = decltype(ub - lb);
+    auto dist        = distance_t{ub - lb};
+    auto current     = Coordinate{lb};
+    auto k_dist      = static_cast<distance_t>(K);
+
+    while (dist >= k_dist) {
+      detail::prefetch_group<K, Distance, Stride>(current, dist, address);
+      func(unroll_block<Coordinate, K>{current});
+      current += k_dist;
+      dist -= k_dist;
+    }
+
+    detail::unroll_block_tail<K / 2>(current, dist, std::forward<Func>(func));
+  }
+
 } // namespace vault
 
 #endif // VAULT_UNROLL_HPP
@@ -13,12 +13,14 @@ Process:
     2. Inspects the schema for tables containing the 'nested_flatbuffer' attribute.
     3. Resolves the string type name (e.g., "Game.Monster") to its full C++ equivalent.
     4. Generates a C++ header file specializing 'vault::fb::traits::nested_type' for each valid field.
+    5. Specializes 'vault::fb::traits::field_verifier' for each field, so that tables created
+       with 'create_lazy' verify their fields one at a time, on first access.
 """
 
 import sys
 import os
 import argparse
-from typing import List, Dict, Optional, Set
+from typing import List, Dict, Optional, Set, Tuple
 
 # -----------------------------------------------------------------------------
 # Dependency Check
@@ -57,6 +59,23 @@ TRAITS_NAMESPACE = "vault::fb::traits"
 # C++ header file that defines the 'lazy_wrapper' and base traits.
 LAZY_WRAPPER_HEADER = "vault/flatbuffers/flatbuffers.hpp"
 
+# The C++ type and alignment that the generated 'Verify' checks scalar fields with.
+# Enums and bools are checked as their underlying type.
+SCALAR_FIELD_TYPES = {
+    reflection.BaseType.BaseType.UType:  ("uint8_t", 1),
+    reflection.BaseType.BaseType.Bool:   ("uint8_t", 1),
+    reflection.BaseType.BaseType.Byte:   ("int8_t", 1),
+    reflection.BaseType.BaseType.UByte:  ("uint8_t", 1),
+    reflection.BaseType.BaseType.Short:  ("int16_t", 2),
+    reflection.BaseType.BaseType.UShort: ("uint16_t", 2),
+    reflection.BaseType.BaseType.Int:    ("int32_t", 4),
+    reflection.BaseType.BaseType.UInt:   ("uint32_t", 4),
+    reflection.BaseType.BaseType.Long:   ("int64_t", 8),
+    reflection.BaseType.BaseType.ULong:  ("uint64_t", 8),
+    reflection.BaseType.BaseType.Float:  ("float", 4),
+    reflection.BaseType.BaseType.Double: ("double", 8),
+}
+
 
 # -----------------------------------------------------------------------------
 # Helper Functions
@@ -188,6 +207,61 @@ class SchemaAnalyzer:
         
         return True
 
+    def field_verifier_condition(self, field: reflection.Field.Field, cpp_table_name: str) -> Optional[Tuple[str, bool]]:
+        """
+        Builds the C++ condition that verifies a single field, mirroring the clause
+        that flatc emits for it in the table's generated 'Verify', except that
+        sub-tables, alone or in vectors, are verified down to their vtables only.
+        Their own fields are verified when they are read.
+
+        Returns:
+            The condition, and whether it takes time in the size of the field, so
+            that lazy tables memoize it. None for field types that cannot be verified
+            alone (vectors of unions, 64-bit vectors and fixed-size arrays).
+        """
+        BaseType = reflection.BaseType.BaseType
+
+        field_name = field.Name().decode("utf-8")
+        vtable_offset = f"{cpp_table_name}::VT_{field_name.upper()}"
+        type_obj = field.Type()
+        base_type = type_obj.BaseType()
+        offset = f"fields.VerifyOffset(verifier, {vtable_offset})"
+        value = f"table.{field_name}()"
+
+        if base_type in SCALAR_FIELD_TYPES:
+            cpp_type, align = SCALAR_FIELD_TYPES[base_type]
+            return f"fields.VerifyField<{cpp_type}>(verifier, {vtable_offset}, {align})", False
+
+        if base_type == BaseType.String:
+            return f"{offset} && verifier.VerifyString({value})", False
+
+        if base_type == BaseType.Obj:
+            obj = self.schema.Objects(type_obj.Index())
+            if obj.IsStruct():
+                cpp_struct = to_cpp_type(obj.Name().decode("utf-8"))
+                return f"fields.VerifyField<{cpp_struct}>(verifier, {vtable_offset}, {obj.Minalign()})", False
+            return f"{offset} && verify_shallow(verifier, {value})", False
+
+        if base_type == BaseType.Union:
+            union_name = self.schema.Enums(type_obj.Index()).Name().decode("utf-8")
+            namespace = get_namespace(union_name)
+            verify_union = f"Verify{union_name.split('.')[-1]}"
+            if namespace:
+                verify_union = f"{to_cpp_type(namespace)}::{verify_union}"
+            return f"{offset} && {verify_union}(verifier, {value}, table.{field_name}_type())", True
+
+        if base_type == BaseType.Vector:
+            element_type = type_obj.Element()
+            if element_type == BaseType.String:
+                return f"{offset} && verifier.VerifyVector({value}) && verifier.VerifyVectorOfStrings({value})", True
+            if element_type == BaseType.Obj and not self.schema.Objects(type_obj.Index()).IsStruct():
+                return f"{offset} && verify_shallow(verifier, {value})", True
+            if element_type == BaseType.Union:
+                return None
+            return f"{offset} && verifier.VerifyVector({value})", False
+
+        return None
+
     def extract_traits(self) -> List[str]:
         """
         Main pass: Iterates over all objects and fields to generate C++ trait definitions.
@@ -229,6 +303,30 @@ class SchemaAnalyzer:
                 field_name = field.Name().decode("utf-8")
                 target_type_raw = None
 
+                # Deprecated fields have no accessor.
+                if field.Deprecated():
+                    continue
+
+                # ---------------------------------------------------------------------
+                # Lazy Field Verification
+                # ---------------------------------------------------------------------
+
+                # Generated tables derive privately from flatbuffers::Table, whose
+                # members verify the fields, so the verifier reaches them through a cast.
+                verifier = self.field_verifier_condition(field, cpp_table_name)
+                if verifier:
+                    condition, memoize = verifier
+                    traits.append(
+                        f"template<>\n"
+                        f"struct field_verifier<&{cpp_table_name}::{field_name}> {{\n"
+                        + (f"    static constexpr bool memoize = true;\n\n" if memoize else "")
+                        + f"    static bool verify(flatbuffers::Verifier& verifier, const {cpp_table_name}& table) {{\n"
+                        f"        auto const& fields = reinterpret_cast<const flatbuffers::Table&>(table);\n"
+                        f"        return {condition};\n"
+                        f"    }}\n"
+                        f"}};"
+                    )
+
                 # ---------------------------------------------------------------------
                 # Attribute Detection
                 # ---------------------------------------------------------------------
@@ -338,7 +436,7 @@ def main():
             if traits_list:
                 f.write("\n".join(traits_list))
             else:
-                f.write(f"// No fields with '{NESTED_ATTRIBUTE_KEY}' found in this schema.\n")
+                f.write("// No tables with fields found in this schema.\n")
                 
             f.write(f"\n\n}} // namespace {TRAITS_NAMESPACE}\n")
             
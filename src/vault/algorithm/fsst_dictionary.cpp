@@ -1,17 +1,32 @@
 // SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
 
 #include <vault/algorithm/fsst_dictionary.hpp>
+#include <vault/algorithm/amac.hpp>
+#include <vault/executor/thread_executor.hpp>
 
 #include <algorithm>
+#include <array>
+#include <bit>
 #include <cassert>
+#include <cerrno>
 #include <cmath>
 #include <cstring>
-#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
 #include <numeric>
 #include <random>
+#include <ranges>
 #include <stdexcept>
+#include <string>
+#include <system_error>
 #include <vector>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <fsst.h>
 
 namespace vault::algorithm {
@@ -32,6 +47,53 @@ namespace vault::algorithm {
     constexpr auto kMaxPointerOffset = kPointerOffsetMask;
     constexpr auto kMaxInlineLength  = 7uz;
 
+    // --- File Layout ---
+    //
+    // | Position              | Contents                                 |
+    // |-----------------------|------------------------------------------|
+    // | 0                     | file_header                              |
+    // | symbol_table_position | the symbol table, as fsst_export wrote it |
+    // | blob_position         | the compressed strings                   |
+    //
+    // The compressed strings start on a page boundary so that they can be
+    // mapped and read in place. All integers are little-endian.
+    static_assert(std::endian::native == std::endian::little,
+      "The fsst_dictionary file format is little-endian.");
+
+    constexpr auto kFileVersion  = std::uint32_t{1};
+    constexpr auto kFilePageSize = std::uint64_t{4096};
+
+    struct file_header {
+      std::array<char, 8> magic = {'V', 'A', 'U', 'L', 'T', 'F', 'S', 'T'};
+      std::uint32_t             version               = kFileVersion;
+      std::uint32_t             symbol_table_size     = 0;
+      std::uint64_t             symbol_table_position = 0;
+      std::uint64_t             blob_position         = 0;
+      std::uint64_t             blob_size             = 0;
+      std::array<std::byte, 24> reserved{};
+    };
+
+    static_assert(sizeof(file_header) == 64);
+
+    [[noreturn]] void throw_file_error(
+      std::filesystem::path const& path, char const* what)
+    {
+      throw std::runtime_error(
+        "fsst_dictionary file " + path.string() + ": " + what);
+    }
+
+    // The fewest strings a worker compresses at once in a parallel build.
+    constexpr auto kMinChunkSize = 4096uz;
+
+    struct encoder_deleter {
+      void operator()(fsst_encoder_t* encoder) const noexcept
+      {
+        fsst_destroy(encoder);
+      }
+    };
+
+    using encoder_ptr = std::unique_ptr<fsst_encoder_t, encoder_deleter>;
+
     // --- Internal Helpers ---
 
     auto create_pointer_key(std::size_t offset, std::size_t length) -> fsst_key
@@ -76,24 +138,105 @@ namespace vault::algorithm {
       return {off, len};
     }
 
-    template <typename Func>
-    auto buffered_build_adapter(
-      fsst_dictionary_base::RValueGenerator gen, Func&& func)
-    {
-      auto stable_buffer = std::deque<std::string>{};
+    // --- Compressed-Domain Comparison ---
 
-      auto view_gen = [&]() mutable -> std::optional<std::string_view> {
-        auto opt_s = gen();
-        if (!opt_s) {
-          return std::nullopt;
+    constexpr auto kEscapeCode = 255u;
+
+    enum class prefix_match { mismatch, prefix, equal };
+
+    // Compares the compressed string `codes` with `text` from the front.
+    // `text_codes` is the encoding of `text` with the same symbol table, or
+    // empty if unknown. Symbols are skipped while the two encodings agree,
+    // since equal codes decode to equal bytes; from the first disagreement
+    // on, `codes` is decoded one symbol at a time and compared with `text`.
+    auto match_prefix(fsst_decoder_t const&  decoder,
+      std::span<unsigned char const>        codes,
+      std::string_view                      text,
+      std::span<unsigned char const>        text_codes) -> prefix_match
+    {
+      auto i       = std::size_t{0};
+      auto matched = std::size_t{0};
+
+      while (i < codes.size() && i < text_codes.size()) {
+        auto const unit = codes[i] == kEscapeCode ? 2uz : 1uz;
+        if (i + unit > codes.size() || i + unit > text_codes.size()
+          || std::memcmp(codes.data() + i, text_codes.data() + i, unit) != 0) {
+          break;
         }
-        stable_buffer.push_back(std::move(*opt_s));
-        return std::string_view{stable_buffer.back()};
+        matched += unit == 2 ? 1 : decoder.len[codes[i]];
+        i += unit;
+      }
+
+      auto compare = [&](unsigned char byte) {
+        return static_cast<unsigned char>(text[matched++]) == byte;
       };
 
-      return func(std::move(view_gen));
+      while (i < codes.size()) {
+        if (matched == text.size()) {
+          return prefix_match::prefix;
+        }
+
+        if (codes[i] == kEscapeCode) {
+          if (i + 1 == codes.size() || !compare(codes[i + 1])) {
+            return prefix_match::mismatch;
+          }
+          i += 2;
+          continue;
+        }
+
+        auto const symbol = decoder.symbol[codes[i]];
+        auto const length = decoder.len[codes[i]];
+        for (auto k = 0u; k < length; ++k) {
+          if (matched == text.size()) {
+            return prefix_match::prefix;
+          }
+          if (!compare(static_cast<unsigned char>(symbol >> (8 * k)))) {
+            return prefix_match::mismatch;
+          }
+        }
+        ++i;
+      }
+
+      return matched == text.size() ? prefix_match::equal
+                                    : prefix_match::mismatch;
     }
 
+    // An AMAC job that prefetches the compressed bytes of one key: the first
+    // cache line, and the last one if the bytes straddle a line boundary.
+    // Decoding happens in the reporter, once the bytes have arrived.
+    struct decompress_job {
+      std::size_t          index;
+      fsst_key             key;
+      unsigned char const* first  = nullptr;
+      std::size_t          length = 0;
+
+      [[nodiscard]] static constexpr auto fanout() noexcept -> std::size_t
+      {
+        return 2;
+      }
+
+      [[nodiscard]] auto init() const noexcept -> amac::job_step_result<2>
+      {
+        if (first == nullptr || length == 0) {
+          return {};
+        }
+
+        constexpr auto kCacheLine = std::uintptr_t{64};
+
+        auto const* const last = first + length - 1;
+        auto const same_line   = reinterpret_cast<std::uintptr_t>(first)
+            / kCacheLine
+          == reinterpret_cast<std::uintptr_t>(last) / kCacheLine;
+
+        return {{first, same_line ? nullptr : last}};
+      }
+
+      [[nodiscard]] static auto step() noexcept -> amac::job_step_result<2>
+      {
+        return {};
+      }
+    };
+
   } // namespace
 
   // --- Public Helper Implementations ---
@@ -120,13 +263,41 @@ namespace vault::algorithm {
     return fsst_key{payload};
   }
 
+  bool fsst_dictionary_base::is_inline_key(fsst_key k) noexcept
+  {
+    static_assert(kPointerOffsetMask == (1ULL << pointer_offset_bits) - 1);
+    return key_is_inline_raw(k);
+  }
+
+
   // --- Dictionary Implementation ---
 
   struct fsst_dictionary_base::impl {
-    std::vector<unsigned char> data_blob;
+    // The compressed strings: either a vector owned by `storage`, or a
+    // section of a file mapping that `storage` keeps alive.
+    std::span<unsigned char const> data_blob;
+    std::shared_ptr<void const>    storage;
+
+    // The symbol table in fsst_export format, which is what save() persists.
+    std::vector<unsigned char> symbol_table;
     fsst_decoder_t             decoder;
 
+    // The trained encoder, which compresses probes. A dictionary opened with
+    // open_mapped has none. fsst_compress uses scratch space inside the
+    // encoder, so calls are serialized.
+    encoder_ptr        encoder;
+    mutable std::mutex encoder_mutex;
+
     impl() { std::memset(&decoder, 0, sizeof(decoder)); }
+
+    void own(std::vector<unsigned char> blob)
+    {
+      blob.shrink_to_fit();
+      auto owned =
+        std::make_shared<std::vector<unsigned char> const>(std::move(blob));
+      data_blob = *owned;
+      storage   = std::move(owned);
+    }
   };
 
   fsst_dictionary_base::fsst_dictionary_base()
@@ -150,10 +321,229 @@ namespace vault::algorithm {
     return p_impl ? p_impl->data_blob.size() : 0;
   }
 
+  // --- Persistence ---
+
+  void fsst_dictionary_base::save(std::filesystem::path const& path) const
+  {
+    auto const blob = p_impl ? p_impl->data_blob
+                             : std::span<unsigned char const>{};
+    auto const symbol_table = p_impl
+      ? std::span<unsigned char const>{p_impl->symbol_table}
+      : std::span<unsigned char const>{};
+
+    auto header                  = file_header{};
+    header.symbol_table_size =
+      static_cast<std::uint32_t>(symbol_table.size());
+    header.symbol_table_position = sizeof(header);
+    header.blob_position =
+      (sizeof(header) + symbol_table.size() + kFilePageSize - 1)
+      / kFilePageSize * kFilePageSize;
+    header.blob_size = blob.size();
+
+    auto file = std::ofstream{};
+    file.exceptions(std::ios::failbit | std::ios::badbit);
+    file.open(path, std::ios::binary | std::ios::trunc);
+
+    auto const padding = std::vector<char>(
+      header.blob_position - sizeof(header) - symbol_table.size());
+
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const*>(symbol_table.data()),
+      static_cast<std::streamsize>(symbol_table.size()));
+    file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+    file.write(reinterpret_cast<char const*>(blob.data()),
+      static_cast<std::streamsize>(blob.size()));
+  }
+
+  auto fsst_dictionary_base::open_mapped(std::filesystem::path const& path)
+    -> fsst_dictionary_base
+  {
+    auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), path.string());
+    }
+
+    struct stat status{};
+    if (::fstat(fd, &status) != 0) {
+      auto const error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), path.string());
+    }
+
+    auto const file_size = static_cast<std::uint64_t>(status.st_size);
+    if (file_size < sizeof(file_header)) {
+      ::close(fd);
+      throw_file_error(path, "truncated header");
+    }
+
+    auto* const address = ::mmap(nullptr,
+      static_cast<std::size_t>(file_size),
+      PROT_READ,
+      MAP_SHARED,
+      fd,
+      0);
+    auto const error = errno;
+    ::close(fd);
+
+    if (address == MAP_FAILED) {
+      throw std::system_error(error, std::generic_category(), path.string());
+    }
+
+    auto mapping = std::shared_ptr<unsigned char const>(
+      static_cast<unsigned char const*>(address),
+      [file_size](unsigned char const* p) {
+        ::munmap(
+          const_cast<unsigned char*>(p), static_cast<std::size_t>(file_size));
+      });
+
+    auto header = file_header{};
+    std::memcpy(&header, mapping.get(), sizeof(header));
+
+    if (header.magic != file_header{}.magic) {
+      throw_file_error(path, "bad magic");
+    }
+    if (header.version != kFileVersion) {
+      throw_file_error(path, "unsupported version");
+    }
+    if (header.symbol_table_size > FSST_MAXHEADER
+      || header.symbol_table_position > file_size
+      || header.symbol_table_size > file_size - header.symbol_table_position
+      || header.blob_position > file_size
+      || header.blob_size > file_size - header.blob_position) {
+      throw_file_error(path, "section out of bounds");
+    }
+    if (header.blob_size != 0 && header.symbol_table_size == 0) {
+      throw_file_error(path, "missing symbol table");
+    }
+
+    auto impl_ptr = std::make_shared<fsst_dictionary_base::impl>();
+
+    auto const* const symbol_table =
+      mapping.get() + header.symbol_table_position;
+    impl_ptr->symbol_table.assign(
+      symbol_table, symbol_table + header.symbol_table_size);
+
+    if (header.symbol_table_size != 0) {
+      // fsst_import takes a mutable buffer, so decode the table from a copy
+      // rather than from the read-only mapping.
+      alignas(8) unsigned char buf[FSST_MAXHEADER] = {};
+      std::ranges::copy(impl_ptr->symbol_table, buf);
+      if (fsst_import(&impl_ptr->decoder, buf) == 0) {
+        throw_file_error(path, "corrupt symbol table");
+      }
+    }
+
+    impl_ptr->data_blob = std::span<unsigned char const>{
+      mapping.get() + header.blob_position,
+      static_cast<std::size_t>(header.blob_size)};
+    impl_ptr->storage = std::move(mapping);
+
+    return fsst_dictionary_base(std::move(impl_ptr));
+  }
+
+  // --- Compressed-Domain Comparison ---
+
+  auto fsst_dictionary_base::compress_probe(std::string_view query) const
+    -> fsst_probe
+  {
+    auto probe   = fsst_probe{};
+    probe.m_text = query;
+
+    if (!p_impl || !p_impl->encoder) {
+      return probe;
+    }
+
+    probe.m_codes.resize(2 * query.size() + 16);
+
+    auto  src_len = query.size();
+    auto* src_ptr = reinterpret_cast<unsigned char const*>(query.data());
+    auto  dst_len = std::size_t{0};
+    auto* dst_ptr = static_cast<unsigned char*>(nullptr);
+
+    {
+      auto const lock = std::lock_guard{p_impl->encoder_mutex};
+      fsst_compress(p_impl->encoder.get(),
+        1,
+        &src_len,
+        &src_ptr,
+        probe.m_codes.size(),
+        probe.m_codes.data(),
+        &dst_len,
+        &dst_ptr);
+    }
+
+    assert(dst_ptr == probe.m_codes.data());
+    probe.m_codes.resize(dst_len);
+    probe.m_source = p_impl.get();
+    return probe;
+  }
+
+  auto fsst_dictionary_base::equals(fsst_key key, fsst_probe const& probe) const
+    -> bool
+  {
+    if (key_is_inline_raw(key)) {
+      char buf[kMaxInlineLength];
+      auto const len = extract_inline_into(key, buf, sizeof(buf));
+      return std::string_view{buf, static_cast<std::size_t>(len)}
+        == probe.m_text;
+    }
+
+    // Every string short enough to be stored inline is.
+    if (is_inline_candidate(probe.m_text) || empty()) {
+      return false;
+    }
+
+    auto const [offset, length] = decode_pointer_key(key);
+    if (offset + length > p_impl->data_blob.size()) {
+      return false;
+    }
+
+    auto const codes      = p_impl->data_blob.subspan(offset, length);
+    auto const text_codes = probe.m_source == p_impl.get()
+      ? std::span<unsigned char const>{probe.m_codes}
+      : std::span<unsigned char const>{};
+
+    if (!text_codes.empty() && std::ranges::equal(codes, text_codes)) {
+      return true;
+    }
+
+    return match_prefix(p_impl->decoder, codes, probe.m_text, text_codes)
+      == prefix_match::equal;
+  }
+
+  auto fsst_dictionary_base::starts_with(
+    fsst_key key, fsst_probe const& probe) const -> bool
+  {
+    if (key_is_inline_raw(key)) {
+      char buf[kMaxInlineLength];
+      auto const len = extract_inline_into(key, buf, sizeof(buf));
+      return std::string_view{buf, static_cast<std::size_t>(len)}.starts_with(
+        probe.m_text);
+    }
+
+    if (empty()) {
+      return false;
+    }
+
+    auto const [offset, length] = decode_pointer_key(key);
+    if (offset + length > p_impl->data_blob.size()) {
+      return false;
+    }
+
+    auto const codes      = p_impl->data_blob.subspan(offset, length);
+    auto const text_codes = probe.m_source == p_impl.get()
+      ? std::span<unsigned char const>{probe.m_codes}
+      : std::span<unsigned char const>{};
+
+    return match_prefix(p_impl->decoder, codes, probe.m_text, text_codes)
+      != prefix_match::mismatch;
+  }
+
   // --- Private Helpers for Friends ---
 
   auto fsst_dictionary_base::is_inline_key_internal(fsst_key k) const -> bool
   {
+    static_assert(inline_key_flag == (1ULL << kInlineFlagShift));
     return key_is_inline_raw(k);
   }
 
@@ -195,12 +585,57 @@ namespace vault::algorithm {
     return static_cast<std::ptrdiff_t>(actual_size);
   }
 
+  auto fsst_dictionary_base::decompress_many(std::span<fsst_key const> keys,
+    std::function<void(std::size_t, std::string_view)> const& sink) const
+    -> std::size_t
+  {
+    auto const* const blob_data = p_impl ? p_impl->data_blob.data() : nullptr;
+    auto const        blob_size = size_in_bytes();
+
+    auto make_job = [&](std::size_t i) {
+      auto job = decompress_job{.index = i, .key = keys[i]};
+      if (!key_is_inline_raw(job.key)) {
+        auto const [offset, length] = decode_pointer_key(job.key);
+        if (offset + length <= blob_size) {
+          job.first  = blob_data + offset;
+          job.length = length;
+        }
+      }
+      return job;
+    };
+
+    auto scratch = std::string{};
+    auto found   = std::size_t{0};
+
+    amac::coordinator_fn<16>{}(
+      std::views::iota(std::size_t{0}, keys.size())
+        | std::views::transform(make_job),
+      [&](decompress_job&& job) {
+        auto const limit = get_conservative_length(job.key);
+        if (scratch.size() < limit) {
+          scratch.resize(limit);
+        }
+
+        auto const res = decompress_into(job.key, scratch.data(), limit);
+        if (res < 0) {
+          return;
+        }
+
+        ++found;
+        sink(job.index,
+          std::string_view{scratch.data(), static_cast<std::size_t>(res)});
+      });
+
+    return found;
+  }
+
   // --- Core FSST Compression ---
 
   auto fsst_dictionary_base::compress_core(std::size_t count,
     std::size_t*                                       lens,
     unsigned char const**                              ptrs,
-    float                                              sample_ratio)
+    float                                              sample_ratio,
+    std::size_t                                        threads)
     -> std::pair<std::shared_ptr<impl>, std::vector<fsst_key>>
   {
     if (sample_ratio <= 0.0f || sample_ratio > 1.0f) {
@@ -210,13 +645,13 @@ namespace vault::algorithm {
       return {std::make_shared<fsst_dictionary_base::impl>(), {}};
     }
 
-    auto* encoder = static_cast<fsst_encoder_t*>(nullptr);
-    auto  target_samples =
+    auto encoder        = encoder_ptr{};
+    auto target_samples =
       static_cast<std::size_t>(std::ceil(count * sample_ratio));
     target_samples = std::max(target_samples, std::size_t{1024});
 
     if (target_samples >= count) {
-      encoder = fsst_create(count, lens, ptrs, 0);
+      encoder.reset(fsst_create(count, lens, ptrs, 0));
     } else {
       auto indices = std::vector<std::size_t>(count);
       std::iota(indices.begin(), indices.end(), 0);
@@ -240,8 +675,8 @@ namespace vault::algorithm {
         training_ptrs.push_back(ptrs[idx]);
         training_lens.push_back(lens[idx]);
       }
-      encoder = fsst_create(
-        target_samples, training_lens.data(), training_ptrs.data(), 0);
+      encoder.reset(fsst_create(
+        target_samples, training_lens.data(), training_ptrs.data(), 0));
     }
 
     if (!encoder) {
@@ -251,236 +686,304 @@ namespace vault::algorithm {
     auto impl_ptr = std::make_shared<fsst_dictionary_base::impl>();
 
     alignas(8) unsigned char buf[FSST_MAXHEADER];
-    fsst_export(encoder, buf);
+    auto const symbol_table_size = fsst_export(encoder.get(), buf);
     fsst_import(&impl_ptr->decoder, buf);
-
-    auto total_input_size = std::size_t{0};
-    auto max_len          = std::size_t{0};
-    for (auto i = std::size_t{0}; i < count; ++i) {
-      total_input_size += lens[i];
-      max_len = std::max(max_len, lens[i]);
+    impl_ptr->symbol_table.assign(buf, buf + symbol_table_size);
+
+    // The symbol table is immutable after training, but fsst_compress
+    // uses scratch space inside the encoder, so every worker compresses
+    // with its own duplicate. Each chunk of strings is compressed into its
+    // own buffer, and the buffers are concatenated in input order, so the
+    // dictionary does not depend on the number of threads.
+    auto const executor = thread_executor{threads};
+    auto const workers  = executor.concurrency();
+    auto const grain    = workers == 1
+         ? count
+         : std::max(kMinChunkSize, (count + workers * 8 - 1) / (workers * 8));
+    auto const chunk_count = (count + grain - 1) / grain;
+
+    auto encoders = std::vector<encoder_ptr>{};
+    encoders.reserve(workers);
+    encoders.push_back(std::move(encoder));
+    while (encoders.size() < workers) {
+      encoders.emplace_back(fsst_duplicate(encoders.front().get()));
+      if (!encoders.back()) {
+        throw std::runtime_error("Failed to duplicate FSST encoder");
+      }
     }
 
-    impl_ptr->data_blob.reserve(total_input_size + 1024);
+    auto keys   = std::vector<fsst_key>(count);
+    auto chunks = std::vector<std::vector<unsigned char>>(chunk_count);
 
-    auto keys = std::vector<fsst_key>{};
-    keys.reserve(count);
+    executor(count,
+      grain,
+      [&](std::size_t worker, std::size_t first, std::size_t last) {
+        auto const size = last - first;
 
-    auto const buffer_req = 2 * max_len + 16;
-    auto aligned_buf = std::vector<unsigned long long>((buffer_req + 7) / 8);
-    unsigned char* comp_buf_ptr =
-      reinterpret_cast<unsigned char*>(aligned_buf.data());
-    auto const comp_buf_len = aligned_buf.size() * 8;
+        auto input_size = std::size_t{0};
+        for (auto i = first; i < last; ++i) {
+          if (lens[i] > kMaxPointerLength) {
+            throw std::length_error("String too large");
+          }
+          input_size += lens[i];
+        }
 
-    for (auto i = std::size_t{0}; i < count; ++i) {
-      if (impl_ptr->data_blob.size() >= kMaxPointerOffset) {
-        fsst_destroy(encoder);
-        throw std::length_error("fsst_dictionary: Dictionary size limit");
-      }
+        // FSST expands a string by at most a factor of two.
+        auto& chunk = chunks[first / grain];
+        chunk.resize(2 * input_size + 16);
+
+        auto dst_lens = std::vector<std::size_t>(size);
+        auto dst_ptrs = std::vector<unsigned char*>(size);
+
+        auto const compressed = fsst_compress(encoders[worker].get(),
+          size,
+          lens + first,
+          ptrs + first,
+          chunk.size(),
+          chunk.data(),
+          dst_lens.data(),
+          dst_ptrs.data());
+        if (compressed != size) {
+          throw std::runtime_error("fsst_dictionary: FSST output overflow");
+        }
 
-      auto  src_len = lens[i];
-      auto  src_ptr = ptrs[i];
-      auto  dst_len = std::size_t{0};
-      auto* dst_ptr = static_cast<unsigned char*>(nullptr);
+        auto used = std::size_t{0};
+        for (auto i = std::size_t{0}; i < compressed; ++i) {
+          if (dst_lens[i] > kMaxPointerLength) {
+            throw std::length_error("fsst_dictionary: Compressed string limit");
+          }
+          auto const offset =
+            static_cast<std::size_t>(dst_ptrs[i] - chunk.data());
+          if (offset >= kMaxPointerOffset) {
+            throw std::length_error("fsst_dictionary: Dictionary size limit");
+          }
+          keys[first + i] = create_pointer_key(offset, dst_lens[i]);
+          used            = offset + dst_lens[i];
+        }
+        chunk.resize(used);
+      });
 
-      fsst_compress(encoder,
-        1,
-        &src_len,
-        &src_ptr,
-        comp_buf_len,
-        comp_buf_ptr,
-        &dst_len,
-        &dst_ptr);
+    impl_ptr->encoder = std::move(encoders.front());
 
-      if (dst_len > kMaxPointerLength) {
-        fsst_destroy(encoder);
-        throw std::length_error("fsst_dictionary: Compressed string limit");
-      }
+    if (chunk_count == 1) {
+      impl_ptr->own(std::move(chunks.front()));
+      return {std::move(impl_ptr), std::move(keys)};
+    }
+
+    auto bases = std::vector<std::size_t>(chunk_count);
+    auto total = std::size_t{0};
+    for (auto chunk = std::size_t{0}; chunk < chunk_count; ++chunk) {
+      bases[chunk] = total;
+      total += chunks[chunk].size();
+    }
 
-      auto const offset = impl_ptr->data_blob.size();
+    auto blob = std::vector<unsigned char>(total);
 
-      impl_ptr->data_blob.insert(
-        impl_ptr->data_blob.end(), comp_buf_ptr, comp_buf_ptr + dst_len);
+    // Rebase the keys of every chunk onto the concatenated blob.
+    executor(count,
+      grain,
+      [&](std::size_t, std::size_t first, std::size_t last) {
+        auto const chunk = first / grain;
+        auto const base  = bases[chunk];
 
-      keys.push_back(create_pointer_key(offset, dst_len));
-    }
+        std::ranges::copy(chunks[chunk], blob.begin() + base);
+        std::vector<unsigned char>{}.swap(chunks[chunk]);
 
-    impl_ptr->data_blob.shrink_to_fit();
+        for (auto i = first; i < last; ++i) {
+          auto const [offset, length] = decode_pointer_key(keys[i]);
+          if (base + offset >= kMaxPointerOffset) {
+            throw std::length_error("fsst_dictionary: Dictionary size limit");
+          }
+          keys[i] = create_pointer_key(base + offset, length);
+        }
+      });
 
-    fsst_destroy(encoder);
+    impl_ptr->own(std::move(blob));
     return {std::move(impl_ptr), std::move(keys)};
   }
 
-  // --- Factories: View-Based (Zero Copy) ---
+  // --- Streaming Compression ---
 
-  auto fsst_dictionary_base::build(Generator gen,
-    Deduplicator                             dedup,
-    std::function<void(fsst_key)>            emit_key,
-    sample_ratio                             ratio) -> fsst_dictionary_base
+  fsst_dictionary_base::stream_compressor::stream_compressor(
+    std::vector<std::string> sample)
+      : m_impl{std::make_shared<fsst_dictionary_base::impl>()}
   {
-    auto instructions     = std::vector<std::uint64_t>{};
-    auto compression_ptrs = std::vector<unsigned char const*>{};
-    auto compression_lens = std::vector<std::size_t>{};
-
-    while (true) {
-      auto opt_sv = gen();
-      if (!opt_sv) {
-        break;
-      }
-
-      auto const sv = *opt_sv;
-
-      if (is_inline_candidate(sv)) {
-        auto const k = make_inline_key(sv);
-        instructions.push_back(k.value);
-      } else {
-        auto const [idx, is_new] = dedup(sv);
-
-        if (is_new) {
-          if (sv.size() > kMaxPointerLength) {
-            throw std::length_error("String too large");
-          }
-          compression_ptrs.push_back(
-            reinterpret_cast<unsigned char const*>(sv.data()));
-          compression_lens.push_back(sv.size());
-        }
-        instructions.push_back(idx);
-      }
+    if (sample.empty()) {
+      return;
     }
 
-    auto [impl_ptr, large_keys] = compress_core(compression_ptrs.size(),
-      compression_lens.data(),
-      compression_ptrs.data(),
-      ratio.value);
+    auto training_ptrs = std::vector<unsigned char const*>{};
+    auto training_lens = std::vector<std::size_t>{};
+    training_ptrs.reserve(sample.size());
+    training_lens.reserve(sample.size());
 
-    auto result_dict = fsst_dictionary_base(std::move(impl_ptr));
+    for (auto const& s : sample) {
+      training_ptrs.push_back(reinterpret_cast<unsigned char const*>(s.data()));
+      training_lens.push_back(s.size());
+    }
 
-    for (auto const val : instructions) {
-      if (val & (1ULL << kInlineFlagShift)) {
-        emit_key(fsst_key{val});
-      } else {
-        emit_key(large_keys[static_cast<std::size_t>(val)]);
-      }
+    m_impl->encoder.reset(fsst_create(
+      sample.size(), training_lens.data(), training_ptrs.data(), 0));
+    if (!m_impl->encoder) {
+      throw std::runtime_error("Failed to create FSST encoder");
     }
 
-    return result_dict;
+    alignas(8) unsigned char buf[FSST_MAXHEADER];
+    auto const symbol_table_size = fsst_export(m_impl->encoder.get(), buf);
+    fsst_import(&m_impl->decoder, buf);
+    m_impl->symbol_table.assign(buf, buf + symbol_table_size);
   }
 
-  auto fsst_dictionary_base::build_from_unique(
-    Generator gen, std::function<void(fsst_key)> emit_key, sample_ratio ratio)
-    -> fsst_dictionary_base
+  auto fsst_dictionary_base::stream_compressor::compress(std::string_view sv)
+    -> fsst_key
   {
-    auto instructions     = std::vector<std::uint64_t>{};
-    auto compression_ptrs = std::vector<unsigned char const*>{};
-    auto compression_lens = std::vector<std::size_t>{};
-    auto current_ptr_idx  = std::size_t{0};
-
-    while (true) {
-      auto opt_sv = gen();
-      if (!opt_sv) {
-        break;
-      }
-
-      auto const sv = *opt_sv;
+    if (!m_impl->encoder) {
+      throw std::invalid_argument(
+        "fsst_dictionary: streaming passes yield different strings");
+    }
+    if (sv.size() > kMaxPointerLength) {
+      throw std::length_error("String too large");
+    }
+    if (m_blob.size() >= kMaxPointerOffset) {
+      throw std::length_error("fsst_dictionary: Dictionary size limit");
+    }
 
-      if (is_inline_candidate(sv)) {
-        auto const k = make_inline_key(sv);
-        instructions.push_back(k.value);
-      } else {
-        if (sv.size() > kMaxPointerLength) {
-          throw std::length_error("String too large");
-        }
-        compression_ptrs.push_back(
-          reinterpret_cast<unsigned char const*>(sv.data()));
-        compression_lens.push_back(sv.size());
+    m_buffer.resize(std::max(m_buffer.size(), 2 * sv.size() + 16));
+
+    auto  src_len = sv.size();
+    auto* src_ptr = reinterpret_cast<unsigned char const*>(sv.data());
+    auto  dst_len = std::size_t{0};
+    auto* dst_ptr = static_cast<unsigned char*>(nullptr);
+
+    auto const compressed = fsst_compress(m_impl->encoder.get(),
+      1,
+      &src_len,
+      &src_ptr,
+      m_buffer.size(),
+      m_buffer.data(),
+      &dst_len,
+      &dst_ptr);
+    if (compressed != 1) {
+      throw std::runtime_error("fsst_dictionary: FSST output overflow");
+    }
 
-        instructions.push_back(current_ptr_idx++);
-      }
+    if (dst_len > kMaxPointerLength) {
+      throw std::length_error("fsst_dictionary: Compressed string limit");
     }
 
-    auto [impl_ptr, large_keys] = compress_core(compression_ptrs.size(),
-      compression_lens.data(),
-      compression_ptrs.data(),
-      ratio.value);
+    auto const key = create_pointer_key(m_blob.size(), dst_len);
+    m_blob.insert(m_blob.end(), dst_ptr, dst_ptr + dst_len);
+    return key;
+  }
 
-    auto result_dict = fsst_dictionary_base(std::move(impl_ptr));
+  auto fsst_dictionary_base::stream_compressor::finish() &&
+    -> fsst_dictionary_base
+  {
+    m_impl->own(std::move(m_blob));
+    return fsst_dictionary_base(std::move(m_impl));
+  }
 
-    for (auto const val : instructions) {
-      if (val & (1ULL << kInlineFlagShift)) {
-        emit_key(fsst_key{val});
-      } else {
-        emit_key(large_keys[static_cast<std::size_t>(val)]);
-      }
-    }
+  // --- Factories: std::function Wrappers ---
+  //
+  // Each forwards to the template factories in the header.
 
-    return result_dict;
+  auto fsst_dictionary_base::build(Generator gen,
+    Deduplicator                             dedup,
+    std::function<void(fsst_key)>            emit_key,
+    sample_ratio                             ratio,
+    thread_count threads) -> fsst_dictionary_base
+  {
+    return build_with(gen, dedup, emit_key, ratio, threads);
   }
 
-  // --- Factories: R-Value Based (Stable Buffer) ---
+  auto fsst_dictionary_base::build_from_unique(Generator gen,
+    std::function<void(fsst_key)>                        emit_key,
+    sample_ratio                                         ratio,
+    thread_count threads) -> fsst_dictionary_base
+  {
+    auto unique = all_unique{};
+    return build_with(gen, unique, emit_key, ratio, threads);
+  }
 
   auto fsst_dictionary_base::build(RValueGenerator gen,
     Deduplicator                                   dedup,
     std::function<void(fsst_key)>                  emit_key,
-    sample_ratio ratio) -> fsst_dictionary_base
+    sample_ratio                                   ratio,
+    thread_count threads) -> fsst_dictionary_base
   {
-    return buffered_build_adapter(std::move(gen), [&](Generator view_gen) {
-      return build(
-        std::move(view_gen), std::move(dedup), std::move(emit_key), ratio);
-    });
+    return build_with(gen, dedup, emit_key, ratio, threads);
   }
 
   auto fsst_dictionary_base::build_from_unique(RValueGenerator gen,
     std::function<void(fsst_key)>                              emit_key,
-    sample_ratio ratio) -> fsst_dictionary_base
+    sample_ratio                                               ratio,
+    thread_count threads) -> fsst_dictionary_base
   {
-    return buffered_build_adapter(std::move(gen), [&](Generator view_gen) {
-      return build_from_unique(std::move(view_gen), std::move(emit_key), ratio);
-    });
+    auto unique = all_unique{};
+    return build_with(gen, unique, emit_key, ratio, threads);
   }
 
-  // --- Convenience Overloads (View) ---
-
   auto fsst_dictionary_base::build(
-    Generator gen, Deduplicator dedup, sample_ratio ratio)
+    Generator gen, Deduplicator dedup, sample_ratio ratio, thread_count threads)
     -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>
   {
     auto keys = std::vector<fsst_key>{};
-    auto dict = build(
-      std::move(gen),
-      std::move(dedup),
-      [&keys](fsst_key k) { keys.push_back(k); },
-      ratio);
+    auto emit = [&keys](fsst_key k) { keys.push_back(k); };
+    auto dict = build_with(gen, dedup, emit, ratio, threads);
     return {std::move(dict), std::move(keys)};
   }
 
   auto fsst_dictionary_base::build_from_unique(
-    Generator gen, sample_ratio ratio)
+    Generator gen, sample_ratio ratio, thread_count threads)
     -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>
   {
-    auto keys = std::vector<fsst_key>{};
-    auto dict = build_from_unique(
-      std::move(gen), [&keys](fsst_key k) { keys.push_back(k); }, ratio);
+    auto keys   = std::vector<fsst_key>{};
+    auto emit   = [&keys](fsst_key k) { keys.push_back(k); };
+    auto unique = all_unique{};
+    auto dict   = build_with(gen, unique, emit, ratio, threads);
     return {std::move(dict), std::move(keys)};
   }
 
-  // --- Convenience Overloads (R-Value) ---
-
-  auto fsst_dictionary_base::build(
-    RValueGenerator gen, Deduplicator dedup, sample_ratio ratio)
+  auto fsst_dictionary_base::build(RValueGenerator gen,
+    Deduplicator                                   dedup,
+    sample_ratio                                   ratio,
+    thread_count                                   threads)
     -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>
   {
-    return buffered_build_adapter(std::move(gen), [&](Generator view_gen) {
-      return build(std::move(view_gen), std::move(dedup), ratio);
-    });
+    auto keys = std::vector<fsst_key>{};
+    auto emit = [&keys](fsst_key k) { keys.push_back(k); };
+    auto dict = build_with(gen, dedup, emit, ratio, threads);
+    return {std::move(dict), std::move(keys)};
   }
 
   auto fsst_dictionary_base::build_from_unique(
-    RValueGenerator gen, sample_ratio ratio)
+    RValueGenerator gen, sample_ratio ratio, thread_count threads)
     -> std::pair<fsst_dictionary_base, std::vector<fsst_key>>
   {
-    return buffered_build_adapter(std::move(gen), [&](Generator view_gen) {
-      return build_from_unique(std::move(view_gen), ratio);
-    });
+    auto keys   = std::vector<fsst_key>{};
+    auto emit   = [&keys](fsst_key k) { keys.push_back(k); };
+    auto unique = all_unique{};
+    auto dict   = build_with(gen, unique, emit, ratio, threads);
+    return {std::move(dict), std::move(keys)};
+  }
+
+  // --- Factories: Streaming (Bounded Memory) ---
+
+  auto fsst_dictionary_base::build_streaming(RValueGeneratorFactory passes,
+    Deduplicator                                                    dedup,
+    std::function<void(fsst_key)>                                   emit_key,
+    reservoir_size sample) -> fsst_dictionary_base
+  {
+    return compress_stream(passes, dedup, emit_key, sample);
+  }
+
+  auto fsst_dictionary_base::build_from_unique_streaming(
+    RValueGeneratorFactory        passes,
+    std::function<void(fsst_key)> emit_key,
+    reservoir_size                sample) -> fsst_dictionary_base
+  {
+    auto unique = all_unique{};
+    return compress_stream(passes, unique, emit_key, sample);
   }
 
 } // namespace vault::algorithm
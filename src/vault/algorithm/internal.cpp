@@ -2,9 +2,21 @@
 
 #include <vault/algorithm/internal.hpp>
 
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
 // clang-format off
 
 namespace {
+  // Reads a text from the data directory, or nothing if it is missing.
+  std::string read_corpus(char const* name) {
+    auto file = std::ifstream{
+      std::string{PROJECT_DATA_DIR} + "/" + name, std::ios::binary};
+    return { std::istreambuf_iterator<char>{file}, {} };
+  }
+
   char const * const random_words[10000] = {
     "israeli",        "rewards",        "uniprotkb",      "integrating",    "dancing",        "finance",        "stainless",      "compact",        
     "morning",        "email",          "bangkok",        "jesus",          "hundred",        "actions",        "agents",         "subsequent",     
@@ -1267,6 +1279,16 @@ namespace vault::internal {
   std::span<char const * const> random_words_10k() {
     return { ::random_words };
   }
+
+  std::string_view democracy_in_america() {
+    static auto const corpus = read_corpus("democracy_in_america.txt");
+    return corpus;
+  }
+
+  std::string_view democracy_and_education() {
+    static auto const corpus = read_corpus("democracy_and_education.txt");
+    return corpus;
+  }
 }
 
 // clang-format on
@@ -4,10 +4,16 @@
 #define VAULT_ALGORITHM_SHORTEST_COMMON_SUPERSTRING_INTERNAL_HPP
 
 #include <span>
+#include <string_view>
 
 namespace vault::internal {
   std::span<char const* const> random_words_1k();
   std::span<char const* const> random_words_10k();
+
+  // The texts in the data directory, read on first use. Empty if the
+  // file cannot be read.
+  std::string_view democracy_in_america();
+  std::string_view democracy_and_education();
 } // namespace vault::internal
 
 #endif
@@ -1,10 +1,15 @@
 #include <bit>
 #include <cassert> // Added for assertions
+#include <cstdint>
 #include <limits>
+#include <string_view>
+#include <type_traits>
 #include <vault/flat_map/implicit_btree_layout_policy.hpp>
 
-#ifdef LAYOUT_USE_AVX2
+#if defined(__x86_64__) && defined(__GNUC__)
 #include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
 #endif
 
 namespace eytzinger::detail {
@@ -256,284 +261,423 @@ namespace eytzinger::detail {
   }
 
   // -----------------------------------------------------------------------------
-  // SIMD IMPLEMENTATIONS
+  // Block Search Kernels
   // -----------------------------------------------------------------------------
+  //
+  // A kernel searches one full block of 64 bytes: 8 keys of 64 bits, 16 of
+  // 32 bits, 32 of 16 bits or 64 of 8 bits, integers or floating point.
+  // The keys of a block are sorted by the comparator, so the lower bound
+  // of `k` is the number of keys ordered before it and the upper bound is
+  // the number of keys not ordered after it. Each instruction set provides
+  // `count_gt`, the number of keys `v` of the block with `v > k` (or
+  // `k > v` when `KeyFirst`), and the kernels are the same for every
+  // instruction set. Floating-point keys use ordered comparisons, false
+  // when either side is NaN, like the scalar `>`.
+  //
+  // Every instruction set the compiler can target is built into this file,
+  // each with its own target attribute, and the fastest one the host
+  // supports is selected once, on first use.
+
+  template <typename T>
+  inline constexpr std::size_t block_keys = 64 / sizeof(T);
+
+  // --- Scalar ---
+
+  struct scalar_isa {
+    static constexpr inline auto const name = std::string_view{"scalar"};
+
+    template <typename T, bool KeyFirst>
+    [[nodiscard]] static std::size_t count_gt(const T* b, T k)
+    {
+      std::size_t n = 0;
+      for (std::size_t i = 0; i < block_keys<T>; ++i) {
+        n += KeyFirst ? (k > b[i]) : (b[i] > k);
+      }
+      return n;
+    }
+  };
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define LAYOUT_HAS_X86_KERNELS 1
+#define LAYOUT_TARGET_AVX2 __attribute__((target("avx2")))
+#define LAYOUT_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+
+  // --- AVX2 ---
+
+  struct avx2_isa {
+    static constexpr inline auto const name = std::string_view{"avx2"};
+
+    template <typename T>
+    [[nodiscard]] LAYOUT_TARGET_AVX2 static __m256i set1(T k)
+    {
+      if constexpr (sizeof(T) == 8) {
+        return _mm256_set1_epi64x(static_cast<long long>(k));
+      } else if constexpr (sizeof(T) == 4) {
+        return _mm256_set1_epi32(static_cast<int>(k));
+      } else if constexpr (sizeof(T) == 2) {
+        return _mm256_set1_epi16(static_cast<short>(k));
+      } else {
+        return _mm256_set1_epi8(static_cast<char>(k));
+      }
+    }
 
-#ifdef LAYOUT_USE_AVX2
+    // AVX2 only compares signed integers. Flipping the sign bit of
+    // unsigned keys maps their order onto the signed order.
+    template <typename T>
+    [[nodiscard]] LAYOUT_TARGET_AVX2 static __m256i bias(__m256i v)
+    {
+      if constexpr (std::is_signed_v<T>) {
+        return v;
+      } else {
+        constexpr auto sign = T{1} << (8 * sizeof(T) - 1);
+        return _mm256_xor_si256(v, set1<T>(sign));
+      }
+    }
 
-  // --- Helper: XOR Sign Bit ---
-  template <typename T> [[nodiscard]] __m256i xor_sign_bit(__m256i v)
-  {
-    if constexpr (sizeof(T) == 8) {
-      return _mm256_xor_si256(v, _mm256_set1_epi64x(0x8000000000000000ULL));
-    } else if constexpr (sizeof(T) == 4) {
-      return _mm256_xor_si256(v, _mm256_set1_epi32(0x80000000));
-    } else if constexpr (sizeof(T) == 2) {
-      return _mm256_xor_si256(v, _mm256_set1_epi16(static_cast<short>(0x8000)));
-    } else if constexpr (sizeof(T) == 1) {
-      return _mm256_xor_si256(v, _mm256_set1_epi8(static_cast<char>(0x80)));
+    template <typename T>
+    [[nodiscard]] LAYOUT_TARGET_AVX2 static __m256i cmpgt(__m256i a, __m256i b)
+    {
+      if constexpr (sizeof(T) == 8) {
+        return _mm256_cmpgt_epi64(a, b);
+      } else if constexpr (sizeof(T) == 4) {
+        return _mm256_cmpgt_epi32(a, b);
+      } else if constexpr (sizeof(T) == 2) {
+        return _mm256_cmpgt_epi16(a, b);
+      } else {
+        return _mm256_cmpgt_epi8(a, b);
+      }
     }
-  }
 
-// --- Macros for SIMD Comparisons ---
+    // A block is two 32-byte vectors. Every lane that compares greater
+    // sets sizeof(T) bits of the byte mask, or one bit of the lane mask
+    // for floating point.
+    template <typename T, bool KeyFirst>
+    [[nodiscard]] LAYOUT_TARGET_AVX2 static std::size_t count_gt(
+        const T* b, T k
+    )
+    {
+      if constexpr (std::is_floating_point_v<T>) {
+        return count_gt_fp<KeyFirst>(b, k);
+      } else {
+        auto const kv = bias<T>(set1<T>(k));
+        auto       n  = 0;
+
+        for (std::size_t i = 0; i < 2; ++i) {
+          auto const v = bias<T>(_mm256_loadu_si256(
+              reinterpret_cast<const __m256i*>(b + (i * block_keys<T> / 2))
+          ));
+          auto const m = KeyFirst ? cmpgt<T>(kv, v) : cmpgt<T>(v, kv);
+          n += std::popcount(static_cast<uint32_t>(_mm256_movemask_epi8(m)));
+        }
 
-// 64-bit (int64/uint64)
-#define IMPL_LB_64(NAME, T, CAST, CMP_INTRIN, PRE_OP)                          \
-  [[nodiscard]] std::size_t NAME(const T* b, T k)                              \
-  {                                                                            \
-    assert(b != nullptr);                                                      \
-    assert(                                                                    \
-        (reinterpret_cast<uintptr_t>(b) % alignof(T) == 0) && "SIMD align"     \
-    );                                                                         \
-    __m256i kv = PRE_OP(T, _mm256_set1_epi64x(static_cast<long long>(k)));     \
-    __m256i v0 =                                                               \
-        PRE_OP(T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));    \
-    __m256i v1 = PRE_OP(                                                       \
-        T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 4))         \
-    );                                                                         \
-    int m =                                                                    \
-        _mm256_movemask_pd(_mm256_castsi256_pd(CMP_INTRIN(kv, v0))) |          \
-        (_mm256_movemask_pd(_mm256_castsi256_pd(CMP_INTRIN(kv, v1))) << 4);    \
-    return static_cast<std::size_t>(std::popcount(static_cast<uint32_t>(m)));  \
-  }
+        return static_cast<std::size_t>(n) / sizeof(T);
+      }
+    }
 
-#define IMPL_UB_64(NAME, T, CAST, CMP_INTRIN, PRE_OP)                          \
-  [[nodiscard]] std::size_t NAME(const T* b, T k)                              \
-  {                                                                            \
-    assert(b != nullptr);                                                      \
-    assert(                                                                    \
-        (reinterpret_cast<uintptr_t>(b) % alignof(T) == 0) && "SIMD align"     \
-    );                                                                         \
-    __m256i kv = PRE_OP(T, _mm256_set1_epi64x(static_cast<long long>(k)));     \
-    __m256i v0 =                                                               \
-        PRE_OP(T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));    \
-    __m256i v1 = PRE_OP(                                                       \
-        T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 4))         \
-    );                                                                         \
-    int m =                                                                    \
-        _mm256_movemask_pd(_mm256_castsi256_pd(CMP_INTRIN(v0, kv))) |          \
-        (_mm256_movemask_pd(_mm256_castsi256_pd(CMP_INTRIN(v1, kv))) << 4);    \
-    return static_cast<std::size_t>(                                           \
-        std::countr_zero(static_cast<uint32_t>(m | (1 << 8)))                  \
-    );                                                                         \
-  }
+  private:
+    template <bool KeyFirst>
+    [[nodiscard]] LAYOUT_TARGET_AVX2 static std::size_t count_gt_fp(
+        const float* b, float k
+    )
+    {
+      auto const kv = _mm256_set1_ps(k);
+      auto       n  = 0;
+
+      for (std::size_t i = 0; i < 2; ++i) {
+        auto const v = _mm256_loadu_ps(b + (i * 8));
+        auto const m = KeyFirst ? _mm256_cmp_ps(kv, v, _CMP_GT_OQ)
+                                : _mm256_cmp_ps(v, kv, _CMP_GT_OQ);
+        n += std::popcount(static_cast<uint32_t>(_mm256_movemask_ps(m)));
+      }
 
-// 32-bit (int32/uint32)
-#define IMPL_LB_32(NAME, T, CAST, CMP_INTRIN, PRE_OP)                          \
-  [[nodiscard]] std::size_t NAME(const T* b, T k)                              \
-  {                                                                            \
-    assert(b != nullptr);                                                      \
-    assert(                                                                    \
-        (reinterpret_cast<uintptr_t>(b) % alignof(T) == 0) && "SIMD align"     \
-    );                                                                         \
-    __m256i kv = PRE_OP(T, _mm256_set1_epi32(static_cast<int>(k)));            \
-    __m256i v0 =                                                               \
-        PRE_OP(T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));    \
-    __m256i v1 = PRE_OP(                                                       \
-        T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 8))         \
-    );                                                                         \
-    int m =                                                                    \
-        _mm256_movemask_ps(_mm256_castsi256_ps(CMP_INTRIN(kv, v0))) |          \
-        (_mm256_movemask_ps(_mm256_castsi256_ps(CMP_INTRIN(kv, v1))) << 8);    \
-    return static_cast<std::size_t>(std::popcount(static_cast<uint32_t>(m)));  \
-  }
+      return static_cast<std::size_t>(n);
+    }
 
-#define IMPL_UB_32(NAME, T, CAST, CMP_INTRIN, PRE_OP)                          \
-  [[nodiscard]] std::size_t NAME(const T* b, T k)                              \
-  {                                                                            \
-    assert(b != nullptr);                                                      \
-    assert(                                                                    \
-        (reinterpret_cast<uintptr_t>(b) % alignof(T) == 0) && "SIMD align"     \
-    );                                                                         \
-    __m256i kv = PRE_OP(T, _mm256_set1_epi32(static_cast<int>(k)));            \
-    __m256i v0 =                                                               \
-        PRE_OP(T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));    \
-    __m256i v1 = PRE_OP(                                                       \
-        T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 8))         \
-    );                                                                         \
-    int m =                                                                    \
-        _mm256_movemask_ps(_mm256_castsi256_ps(CMP_INTRIN(v0, kv))) |          \
-        (_mm256_movemask_ps(_mm256_castsi256_ps(CMP_INTRIN(v1, kv))) << 8);    \
-    return static_cast<std::size_t>(                                           \
-        std::countr_zero(static_cast<uint32_t>(m | (1 << 16)))                 \
-    );                                                                         \
-  }
+    template <bool KeyFirst>
+    [[nodiscard]] LAYOUT_TARGET_AVX2 static std::size_t count_gt_fp(
+        const double* b, double k
+    )
+    {
+      auto const kv = _mm256_set1_pd(k);
+      auto       n  = 0;
+
+      for (std::size_t i = 0; i < 2; ++i) {
+        auto const v = _mm256_loadu_pd(b + (i * 4));
+        auto const m = KeyFirst ? _mm256_cmp_pd(kv, v, _CMP_GT_OQ)
+                                : _mm256_cmp_pd(v, kv, _CMP_GT_OQ);
+        n += std::popcount(static_cast<uint32_t>(_mm256_movemask_pd(m)));
+      }
 
-// 16-bit (int16/uint16)
-#define IMPL_LB_16(NAME, T, CAST, CMP_INTRIN, PRE_OP)                          \
-  [[nodiscard]] std::size_t NAME(const T* b, T k)                              \
-  {                                                                            \
-    assert(b != nullptr);                                                      \
-    assert(                                                                    \
-        (reinterpret_cast<uintptr_t>(b) % alignof(T) == 0) && "SIMD align"     \
-    );                                                                         \
-    __m256i kv = PRE_OP(T, _mm256_set1_epi16(static_cast<short>(k)));          \
-    __m256i v0 =                                                               \
-        PRE_OP(T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));    \
-    __m256i v1 = PRE_OP(                                                       \
-        T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 16))        \
-    );                                                                         \
-    uint32_t m0 =                                                              \
-        static_cast<uint32_t>(_mm256_movemask_epi8(CMP_INTRIN(kv, v0)));       \
-    uint32_t m1 =                                                              \
-        static_cast<uint32_t>(_mm256_movemask_epi8(CMP_INTRIN(kv, v1)));       \
-    return static_cast<std::size_t>(                                           \
-        (std::popcount(m0) + std::popcount(m1)) / 2                            \
-    );                                                                         \
-  }
+      return static_cast<std::size_t>(n);
+    }
+  };
+
+  // --- AVX-512 ---
+
+  struct avx512_isa {
+    static constexpr inline auto const name = std::string_view{"avx512"};
+
+    // A block is one 64-byte vector, compared in one instruction that
+    // yields a mask of one bit per key. AVX-512 compares unsigned
+    // integers directly.
+    template <typename T, bool KeyFirst>
+    [[nodiscard]] LAYOUT_TARGET_AVX512 static std::size_t count_gt(
+        const T* b, T k
+    )
+    {
+      if constexpr (std::is_same_v<T, float>) {
+        auto const v  = _mm512_loadu_ps(b);
+        auto const kv = _mm512_set1_ps(k);
+        return static_cast<std::size_t>(std::popcount(
+            KeyFirst ? _mm512_cmp_ps_mask(kv, v, _CMP_GT_OQ)
+                     : _mm512_cmp_ps_mask(v, kv, _CMP_GT_OQ)
+        ));
+      } else if constexpr (std::is_same_v<T, double>) {
+        auto const v  = _mm512_loadu_pd(b);
+        auto const kv = _mm512_set1_pd(k);
+        return static_cast<std::size_t>(std::popcount(
+            KeyFirst ? _mm512_cmp_pd_mask(kv, v, _CMP_GT_OQ)
+                     : _mm512_cmp_pd_mask(v, kv, _CMP_GT_OQ)
+        ));
+      } else {
+        auto const v   = _mm512_loadu_si512(b);
+        auto const kv  = set1<T>(k);
+        auto const lhs = KeyFirst ? kv : v;
+        auto const rhs = KeyFirst ? v : kv;
 
-#define IMPL_UB_16(NAME, T, CAST, CMP_INTRIN, PRE_OP)                          \
-  [[nodiscard]] std::size_t NAME(const T* b, T k)                              \
-  {                                                                            \
-    assert(b != nullptr);                                                      \
-    assert(                                                                    \
-        (reinterpret_cast<uintptr_t>(b) % alignof(T) == 0) && "SIMD align"     \
-    );                                                                         \
-    __m256i kv = PRE_OP(T, _mm256_set1_epi16(static_cast<short>(k)));          \
-    __m256i v0 =                                                               \
-        PRE_OP(T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));    \
-    __m256i v1 = PRE_OP(                                                       \
-        T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 16))        \
-    );                                                                         \
-    uint32_t m0 =                                                              \
-        static_cast<uint32_t>(_mm256_movemask_epi8(CMP_INTRIN(v0, kv)));       \
-    uint32_t m1 =                                                              \
-        static_cast<uint32_t>(_mm256_movemask_epi8(CMP_INTRIN(v1, kv)));       \
-    uint64_t fm = static_cast<uint64_t>(m0) |                                  \
-                  (static_cast<uint64_t>(m1) << 32);                           \
-    if (fm == 0)                                                               \
-      return 32;                                                               \
-    return static_cast<std::size_t>(std::countr_zero(fm) / 2);                 \
-  }
+        return static_cast<std::size_t>(std::popcount(mask<T>(lhs, rhs)));
+      }
+    }
 
-// 8-bit (int8/uint8)
-#define IMPL_LB_8(NAME, T, CAST, CMP_INTRIN, PRE_OP)                           \
-  [[nodiscard]] std::size_t NAME(const T* b, T k)                              \
-  {                                                                            \
-    assert(b != nullptr);                                                      \
-    assert(                                                                    \
-        (reinterpret_cast<uintptr_t>(b) % alignof(T) == 0) && "SIMD align"     \
-    );                                                                         \
-    __m256i kv = PRE_OP(T, _mm256_set1_epi8(static_cast<char>(k)));            \
-    __m256i v0 =                                                               \
-        PRE_OP(T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));    \
-    __m256i v1 = PRE_OP(                                                       \
-        T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 32))        \
-    );                                                                         \
-    uint32_t m0 =                                                              \
-        static_cast<uint32_t>(_mm256_movemask_epi8(CMP_INTRIN(kv, v0)));       \
-    uint32_t m1 =                                                              \
-        static_cast<uint32_t>(_mm256_movemask_epi8(CMP_INTRIN(kv, v1)));       \
-    return static_cast<std::size_t>(std::popcount(m0) + std::popcount(m1));    \
+  private:
+    template <typename T>
+    [[nodiscard]] LAYOUT_TARGET_AVX512 static __m512i set1(T k)
+    {
+      if constexpr (sizeof(T) == 8) {
+        return _mm512_set1_epi64(static_cast<long long>(k));
+      } else if constexpr (sizeof(T) == 4) {
+        return _mm512_set1_epi32(static_cast<int>(k));
+      } else if constexpr (sizeof(T) == 2) {
+        return _mm512_set1_epi16(static_cast<short>(k));
+      } else {
+        return _mm512_set1_epi8(static_cast<char>(k));
+      }
+    }
+
+    template <typename T>
+    [[nodiscard]] LAYOUT_TARGET_AVX512 static uint64_t mask(
+        __m512i a, __m512i b
+    )
+    {
+      if constexpr (sizeof(T) == 8) {
+        return std::is_signed_v<T> ? _mm512_cmpgt_epi64_mask(a, b)
+                                   : _mm512_cmpgt_epu64_mask(a, b);
+      } else if constexpr (sizeof(T) == 4) {
+        return std::is_signed_v<T> ? _mm512_cmpgt_epi32_mask(a, b)
+                                   : _mm512_cmpgt_epu32_mask(a, b);
+      } else if constexpr (sizeof(T) == 2) {
+        return std::is_signed_v<T> ? _mm512_cmpgt_epi16_mask(a, b)
+                                   : _mm512_cmpgt_epu16_mask(a, b);
+      } else {
+        return std::is_signed_v<T> ? _mm512_cmpgt_epi8_mask(a, b)
+                                   : _mm512_cmpgt_epu8_mask(a, b);
+      }
+    }
+  };
+#endif
+
+#if defined(__aarch64__)
+#define LAYOUT_HAS_NEON_KERNELS 1
+
+  // --- NEON ---
+
+  // Overloads that pick the NEON intrinsic of each key type.
+  namespace neon {
+    // clang-format off
+    inline int8x16_t   load(const int8_t* p)   { return vld1q_s8(p); }
+    inline uint8x16_t  load(const uint8_t* p)  { return vld1q_u8(p); }
+    inline int16x8_t   load(const int16_t* p)  { return vld1q_s16(p); }
+    inline uint16x8_t  load(const uint16_t* p) { return vld1q_u16(p); }
+    inline int32x4_t   load(const int32_t* p)  { return vld1q_s32(p); }
+    inline uint32x4_t  load(const uint32_t* p) { return vld1q_u32(p); }
+    inline int64x2_t   load(const int64_t* p)  { return vld1q_s64(p); }
+    inline uint64x2_t  load(const uint64_t* p) { return vld1q_u64(p); }
+    inline float32x4_t load(const float* p)    { return vld1q_f32(p); }
+    inline float64x2_t load(const double* p)   { return vld1q_f64(p); }
+
+    inline int8x16_t   dup(int8_t k)   { return vdupq_n_s8(k); }
+    inline uint8x16_t  dup(uint8_t k)  { return vdupq_n_u8(k); }
+    inline int16x8_t   dup(int16_t k)  { return vdupq_n_s16(k); }
+    inline uint16x8_t  dup(uint16_t k) { return vdupq_n_u16(k); }
+    inline int32x4_t   dup(int32_t k)  { return vdupq_n_s32(k); }
+    inline uint32x4_t  dup(uint32_t k) { return vdupq_n_u32(k); }
+    inline int64x2_t   dup(int64_t k)  { return vdupq_n_s64(k); }
+    inline uint64x2_t  dup(uint64_t k) { return vdupq_n_u64(k); }
+    inline float32x4_t dup(float k)    { return vdupq_n_f32(k); }
+    inline float64x2_t dup(double k)   { return vdupq_n_f64(k); }
+
+    inline uint8x16_t  cmpgt(int8x16_t a, int8x16_t b)   { return vcgtq_s8(a, b); }
+    inline uint8x16_t  cmpgt(uint8x16_t a, uint8x16_t b) { return vcgtq_u8(a, b); }
+    inline uint16x8_t  cmpgt(int16x8_t a, int16x8_t b)   { return vcgtq_s16(a, b); }
+    inline uint16x8_t  cmpgt(uint16x8_t a, uint16x8_t b) { return vcgtq_u16(a, b); }
+    inline uint32x4_t  cmpgt(int32x4_t a, int32x4_t b)   { return vcgtq_s32(a, b); }
+    inline uint32x4_t  cmpgt(uint32x4_t a, uint32x4_t b) { return vcgtq_u32(a, b); }
+    inline uint64x2_t  cmpgt(int64x2_t a, int64x2_t b)   { return vcgtq_s64(a, b); }
+    inline uint64x2_t  cmpgt(uint64x2_t a, uint64x2_t b) { return vcgtq_u64(a, b); }
+    inline uint32x4_t  cmpgt(float32x4_t a, float32x4_t b) { return vcgtq_f32(a, b); }
+    inline uint64x2_t  cmpgt(float64x2_t a, float64x2_t b) { return vcgtq_f64(a, b); }
+
+    // The number of lanes of a comparison mask that are set.
+    inline std::size_t count(uint8x16_t m)  { return vaddvq_u8(vshrq_n_u8(m, 7)); }
+    inline std::size_t count(uint16x8_t m)  { return vaddvq_u16(vshrq_n_u16(m, 15)); }
+    inline std::size_t count(uint32x4_t m)  { return vaddvq_u32(vshrq_n_u32(m, 31)); }
+    inline std::size_t count(uint64x2_t m)  { return vaddvq_u64(vshrq_n_u64(m, 63)); }
+    // clang-format on
+  } // namespace neon
+
+  struct neon_isa {
+    static constexpr inline auto const name = std::string_view{"neon"};
+
+    // A block is four 16-byte vectors.
+    template <typename T, bool KeyFirst>
+    [[nodiscard]] static std::size_t count_gt(const T* b, T k)
+    {
+      constexpr auto lanes = block_keys<T> / 4;
+
+      auto const  kv = neon::dup(k);
+      std::size_t n  = 0;
+
+      for (std::size_t i = 0; i < 4; ++i) {
+        auto const v = neon::load(b + (i * lanes));
+        n += neon::count(KeyFirst ? neon::cmpgt(kv, v) : neon::cmpgt(v, kv));
+      }
+
+      return n;
+    }
+  };
+#endif
+
+  // --- Kernels ---
+
+  // The keys of a block ordered before `k` are those less than it for
+  // std::less, and greater than it for std::greater.
+  template <typename Isa, typename T, bool Greater>
+  [[nodiscard]] std::size_t block_lb(const T* b, T k)
+  {
+    assert(b != nullptr);
+    return Isa::template count_gt<T, !Greater>(b, k);
   }
 
-#define IMPL_UB_8(NAME, T, CAST, CMP_INTRIN, PRE_OP)                           \
-  [[nodiscard]] std::size_t NAME(const T* b, T k)                              \
-  {                                                                            \
-    assert(b != nullptr);                                                      \
-    assert(                                                                    \
-        (reinterpret_cast<uintptr_t>(b) % alignof(T) == 0) && "SIMD align"     \
-    );                                                                         \
-    __m256i kv = PRE_OP(T, _mm256_set1_epi8(static_cast<char>(k)));            \
-    __m256i v0 =                                                               \
-        PRE_OP(T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b)));    \
-    __m256i v1 = PRE_OP(                                                       \
-        T, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + 32))        \
-    );                                                                         \
-    uint32_t m0 =                                                              \
-        static_cast<uint32_t>(_mm256_movemask_epi8(CMP_INTRIN(v0, kv)));       \
-    uint32_t m1 =                                                              \
-        static_cast<uint32_t>(_mm256_movemask_epi8(CMP_INTRIN(v1, kv)));       \
-    uint64_t fm = static_cast<uint64_t>(m0) |                                  \
-                  (static_cast<uint64_t>(m1) << 32);                           \
-    if (fm == 0)                                                               \
-      return 64;                                                               \
-    return static_cast<std::size_t>(std::countr_zero(fm));                     \
+  template <typename Isa, typename T, bool Greater>
+  [[nodiscard]] std::size_t block_ub(const T* b, T k)
+  {
+    assert(b != nullptr);
+    return block_keys<T> - Isa::template count_gt<T, Greater>(b, k);
   }
 
-#define NO_OP(T, x) x
-#define XOR_SIGN(T, x) xor_sign_bit<T>(x)
+  // The kernels of every key type and order, as X(TYPE, ORDER, GREATER).
+#define LAYOUT_BLOCK_KERNELS(X)                                                \
+  X(int64, less, false)                                                        \
+  X(uint64, less, false)                                                       \
+  X(int64, greater, true)                                                      \
+  X(uint64, greater, true)                                                     \
+  X(int32, less, false)                                                        \
+  X(uint32, less, false)                                                       \
+  X(int32, greater, true)                                                      \
+  X(uint32, greater, true)                                                     \
+  X(int16, less, false)                                                        \
+  X(uint16, less, false)                                                       \
+  X(int16, greater, true)                                                      \
+  X(uint16, greater, true)                                                     \
+  X(int8, less, false)                                                         \
+  X(uint8, less, false)                                                        \
+  X(int8, greater, true)                                                       \
+  X(uint8, greater, true)                                                      \
+  X(float64, less, false)                                                      \
+  X(float64, greater, true)                                                    \
+  X(float32, less, false)                                                      \
+  X(float32, greater, true)
+
+  // The kernels of one instruction set.
+  struct block_kernel_table {
+    std::string_view name;
+
+#define LAYOUT_KERNEL_SLOTS(TYPE, ORDER, GREATER)                              \
+  std::size_t (*lb_##TYPE##_##ORDER)(const TYPE##_t*, TYPE##_t);               \
+  std::size_t (*ub_##TYPE##_##ORDER)(const TYPE##_t*, TYPE##_t);
+
+    LAYOUT_BLOCK_KERNELS(LAYOUT_KERNEL_SLOTS)
+
+#undef LAYOUT_KERNEL_SLOTS
+  };
+
+  template <typename Isa>
+  [[nodiscard]] constexpr block_kernel_table make_kernel_table()
+  {
+#define LAYOUT_KERNEL_ENTRIES(TYPE, ORDER, GREATER)                            \
+  &block_lb<Isa, TYPE##_t, GREATER>, &block_ub<Isa, TYPE##_t, GREATER>,
 
-  // --- Instantiations (32 total) ---
+    return {Isa::name, LAYOUT_BLOCK_KERNELS(LAYOUT_KERNEL_ENTRIES)};
 
-  // int64 (B=8)
-  IMPL_LB_64(simd_lb_int64_less, int64_t, long long, _mm256_cmpgt_epi64, NO_OP)
-  IMPL_UB_64(simd_ub_int64_less, int64_t, long long, _mm256_cmpgt_epi64, NO_OP)
-  IMPL_LB_64(
-      simd_lb_int64_greater, int64_t, long long, _mm256_cmpgt_epi64, NO_OP
-  ) // Note: Logic same, just inverted call in UB/LB macro use
-  IMPL_UB_64(
-      simd_ub_int64_greater, int64_t, long long, _mm256_cmpgt_epi64, NO_OP
-  )
+#undef LAYOUT_KERNEL_ENTRIES
+  }
 
-  // uint64 (B=8)
-  IMPL_LB_64(
-      simd_lb_uint64_less, uint64_t, long long, _mm256_cmpgt_epi64, XOR_SIGN
-  )
-  IMPL_UB_64(
-      simd_ub_uint64_less, uint64_t, long long, _mm256_cmpgt_epi64, XOR_SIGN
-  )
-  IMPL_LB_64(
-      simd_lb_uint64_greater, uint64_t, long long, _mm256_cmpgt_epi64, XOR_SIGN
-  )
-  IMPL_UB_64(
-      simd_ub_uint64_greater, uint64_t, long long, _mm256_cmpgt_epi64, XOR_SIGN
-  )
+  [[nodiscard]] static block_kernel_table select_kernel_table()
+  {
+#if defined(LAYOUT_HAS_X86_KERNELS)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")
+        && __builtin_cpu_supports("avx512bw")) {
+      return make_kernel_table<avx512_isa>();
+    }
+    if (__builtin_cpu_supports("avx2")) {
+      return make_kernel_table<avx2_isa>();
+    }
+#elif defined(LAYOUT_HAS_NEON_KERNELS)
+    // Every AArch64 processor has NEON.
+    return make_kernel_table<neon_isa>();
+#endif
+    return make_kernel_table<scalar_isa>();
+  }
 
-  // int32 (B=16)
-  IMPL_LB_32(simd_lb_int32_less, int32_t, int, _mm256_cmpgt_epi32, NO_OP)
-  IMPL_UB_32(simd_ub_int32_less, int32_t, int, _mm256_cmpgt_epi32, NO_OP)
-  IMPL_LB_32(simd_lb_int32_greater, int32_t, int, _mm256_cmpgt_epi32, NO_OP)
-  IMPL_UB_32(simd_ub_int32_greater, int32_t, int, _mm256_cmpgt_epi32, NO_OP)
-
-  // uint32 (B=16)
-  IMPL_LB_32(simd_lb_uint32_less, uint32_t, int, _mm256_cmpgt_epi32, XOR_SIGN)
-  IMPL_UB_32(simd_ub_uint32_less, uint32_t, int, _mm256_cmpgt_epi32, XOR_SIGN)
-  IMPL_LB_32(
-      simd_lb_uint32_greater, uint32_t, int, _mm256_cmpgt_epi32, XOR_SIGN
-  )
-  IMPL_UB_32(
-      simd_ub_uint32_greater, uint32_t, int, _mm256_cmpgt_epi32, XOR_SIGN
-  )
+  // Resolved on first use, so that a call from a static initializer of
+  // another translation unit still finds it.
+  [[nodiscard]] static block_kernel_table const& kernels()
+  {
+    static auto const table = select_kernel_table();
+    return table;
+  }
 
-  // int16 (B=32)
-  IMPL_LB_16(simd_lb_int16_less, int16_t, short, _mm256_cmpgt_epi16, NO_OP)
-  IMPL_UB_16(simd_ub_int16_less, int16_t, short, _mm256_cmpgt_epi16, NO_OP)
-  IMPL_LB_16(simd_lb_int16_greater, int16_t, short, _mm256_cmpgt_epi16, NO_OP)
-  IMPL_UB_16(simd_ub_int16_greater, int16_t, short, _mm256_cmpgt_epi16, NO_OP)
-
-  // uint16 (B=32)
-  IMPL_LB_16(simd_lb_uint16_less, uint16_t, short, _mm256_cmpgt_epi16, XOR_SIGN)
-  IMPL_UB_16(simd_ub_uint16_less, uint16_t, short, _mm256_cmpgt_epi16, XOR_SIGN)
-  IMPL_LB_16(
-      simd_lb_uint16_greater, uint16_t, short, _mm256_cmpgt_epi16, XOR_SIGN
-  )
-  IMPL_UB_16(
-      simd_ub_uint16_greater, uint16_t, short, _mm256_cmpgt_epi16, XOR_SIGN
-  )
+#define LAYOUT_KERNEL_FUNCTIONS(TYPE, ORDER, GREATER)                          \
+  [[nodiscard]] std::size_t simd_lb_##TYPE##_##ORDER(                          \
+      const TYPE##_t* b, TYPE##_t k                                            \
+  )                                                                            \
+  {                                                                            \
+    return kernels().lb_##TYPE##_##ORDER(b, k);                                \
+  }                                                                            \
+  [[nodiscard]] std::size_t simd_ub_##TYPE##_##ORDER(                          \
+      const TYPE##_t* b, TYPE##_t k                                            \
+  )                                                                            \
+  {                                                                            \
+    return kernels().ub_##TYPE##_##ORDER(b, k);                                \
+  }
 
-  // int8 (B=64)
-  IMPL_LB_8(simd_lb_int8_less, int8_t, char, _mm256_cmpgt_epi8, NO_OP)
-  IMPL_UB_8(simd_ub_int8_less, int8_t, char, _mm256_cmpgt_epi8, NO_OP)
-  IMPL_LB_8(simd_lb_int8_greater, int8_t, char, _mm256_cmpgt_epi8, NO_OP)
-  IMPL_UB_8(simd_ub_int8_greater, int8_t, char, _mm256_cmpgt_epi8, NO_OP)
+  LAYOUT_BLOCK_KERNELS(LAYOUT_KERNEL_FUNCTIONS)
 
-  // uint8 (B=64)
-  IMPL_LB_8(simd_lb_uint8_less, uint8_t, char, _mm256_cmpgt_epi8, XOR_SIGN)
-  IMPL_UB_8(simd_ub_uint8_less, uint8_t, char, _mm256_cmpgt_epi8, XOR_SIGN)
-  IMPL_LB_8(simd_lb_uint8_greater, uint8_t, char, _mm256_cmpgt_epi8, XOR_SIGN)
-  IMPL_UB_8(simd_ub_uint8_greater, uint8_t, char, _mm256_cmpgt_epi8, XOR_SIGN)
+#undef LAYOUT_KERNEL_FUNCTIONS
 
   // -----------------------------------------------------------------------------
   // Fast Path Loops (64-bit Less)
   // -----------------------------------------------------------------------------
 
-#define IMPL_FAST_PATH_LOOPS(SUFFIX, TYPE, SIMD_LB, SIMD_UB)                   \
+  // The kernel is looked up once per search rather than once per block.
+#define IMPL_FAST_PATH_LOOPS(SUFFIX, TYPE)                                     \
   [[nodiscard]] std::size_t search_loop_lb_##SUFFIX(                           \
       const TYPE* base, std::size_t n, TYPE key, std::size_t B                 \
   )                                                                            \
   {                                                                            \
     assert(base != nullptr);                                                   \
+    auto const  search     = kernels().lb_##SUFFIX;                            \
     std::size_t k          = 0;                                                \
     std::size_t result_idx = n;                                                \
     while (true) {                                                             \
@@ -543,12 +687,10 @@ namespace eytzinger::detail {
       assert(k < n && "Runaway index");                                        \
       std::size_t child_start = child_block_index(k, 0, B) * B;                \
       if (child_start < n) {                                                   \
-        _mm_prefetch(                                                          \
-            reinterpret_cast<const char*>(base + child_start), _MM_HINT_T0     \
-        );                                                                     \
+        LAYOUT_PREFETCH(base + child_start);                                   \
       }                                                                        \
       if (block_start + B <= n) {                                              \
-        std::size_t idx_in_block = SIMD_LB(base + block_start, key);           \
+        std::size_t idx_in_block = search(base + block_start, key);            \
         if (idx_in_block < B)                                                  \
           result_idx = block_start + idx_in_block;                             \
         k = child_block_index(k, idx_in_block, B);                             \
@@ -572,6 +714,7 @@ namespace eytzinger::detail {
   )                                                                            \
   {                                                                            \
     assert(base != nullptr);                                                   \
+    auto const  search     = kernels().ub_##SUFFIX;                            \
     std::size_t k          = 0;                                                \
     std::size_t result_idx = n;                                                \
     while (true) {                                                             \
@@ -581,12 +724,10 @@ namespace eytzinger::detail {
       assert(k < n && "Runaway index");                                        \
       std::size_t child_start = child_block_index(k, 0, B) * B;                \
       if (child_start < n) {                                                   \
-        _mm_prefetch(                                                          \
-            reinterpret_cast<const char*>(base + child_start), _MM_HINT_T0     \
-        );                                                                     \
+        LAYOUT_PREFETCH(base + child_start);                                   \
       }                                                                        \
       if (block_start + B <= n) {                                              \
-        std::size_t idx_in_block = SIMD_UB(base + block_start, key);           \
+        std::size_t idx_in_block = search(base + block_start, key);            \
         if (idx_in_block < B)                                                  \
           result_idx = block_start + idx_in_block;                             \
         k = child_block_index(k, idx_in_block, B);                             \
@@ -606,25 +747,19 @@ namespace eytzinger::detail {
     return result_idx;                                                         \
   }
 
-  IMPL_FAST_PATH_LOOPS(
-      uint64_less, uint64_t, simd_lb_uint64_less, simd_ub_uint64_less
-  )
-  IMPL_FAST_PATH_LOOPS(
-      int64_less, int64_t, simd_lb_int64_less, simd_ub_int64_less
-  )
+  IMPL_FAST_PATH_LOOPS(uint64_less, uint64_t)
+  IMPL_FAST_PATH_LOOPS(int64_less, int64_t)
 
 #undef IMPL_FAST_PATH_LOOPS
-#undef IMPL_LB_64
-#undef IMPL_UB_64
-#undef IMPL_LB_32
-#undef IMPL_UB_32
-#undef IMPL_LB_16
-#undef IMPL_UB_16
-#undef IMPL_LB_8
-#undef IMPL_UB_8
-#undef NO_OP
-#undef XOR_SIGN
-
-#endif // LAYOUT_USE_AVX2
+#undef LAYOUT_BLOCK_KERNELS
 
 } // namespace eytzinger::detail
+
+namespace eytzinger {
+
+  [[nodiscard]] std::string_view block_search_isa() noexcept
+  {
+    return detail::kernels().name;
+  }
+
+} // namespace eytzinger
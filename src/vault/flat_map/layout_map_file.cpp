@@ -0,0 +1,161 @@
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <vector>
+#include <vault/flat_map/layout_map_file.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace eytzinger::detail {
+
+  // -----------------------------------------------------------------------------
+  // Helpers
+  // -----------------------------------------------------------------------------
+
+  // Sections start on a page, so that the arrays of a mapped file are
+  // aligned for any key or value type.
+  static constexpr std::uint64_t file_page_size = 4096;
+
+  [[nodiscard]] static std::uint64_t page_align(std::uint64_t position)
+  {
+    return (position + file_page_size - 1) / file_page_size * file_page_size;
+  }
+
+  [[noreturn]] static void throw_file_error(
+      const std::filesystem::path& path, const char* what
+  )
+  {
+    throw std::runtime_error("layout_map file " + path.string() + ": " + what);
+  }
+
+  // -----------------------------------------------------------------------------
+  // Exposed Functions
+  // -----------------------------------------------------------------------------
+
+  void write_layout_file(
+      const std::filesystem::path& path,
+      layout_file_header           header,
+      std::span<const std::byte>   keys,
+      std::span<const std::byte>   values
+  )
+  {
+    header.keys_position   = page_align(sizeof(header));
+    header.values_position = page_align(header.keys_position + keys.size());
+
+    std::ofstream file;
+    file.exceptions(std::ios::failbit | std::ios::badbit);
+    file.open(path, std::ios::binary | std::ios::trunc);
+
+    const std::vector<char> padding(file_page_size);
+    auto pad_to = [&](std::uint64_t position) {
+      const auto current = static_cast<std::uint64_t>(file.tellp());
+      file.write(
+          padding.data(), static_cast<std::streamsize>(position - current)
+      );
+    };
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    pad_to(header.keys_position);
+    file.write(
+        reinterpret_cast<const char*>(keys.data()),
+        static_cast<std::streamsize>(keys.size())
+    );
+    pad_to(header.values_position);
+    file.write(
+        reinterpret_cast<const char*>(values.data()),
+        static_cast<std::streamsize>(values.size())
+    );
+  }
+
+  [[nodiscard]] mapped_layout_file map_layout_file(
+      const std::filesystem::path& path, const layout_file_header& expected
+  )
+  {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      throw std::system_error(errno, std::generic_category(), path.string());
+    }
+
+    struct stat status {};
+    if (::fstat(fd, &status) != 0) {
+      const int error = errno;
+      ::close(fd);
+      throw std::system_error(error, std::generic_category(), path.string());
+    }
+
+    const auto file_size = static_cast<std::uint64_t>(status.st_size);
+    if (file_size < sizeof(layout_file_header)) {
+      ::close(fd);
+      throw_file_error(path, "truncated header");
+    }
+
+    void* const address = ::mmap(
+        nullptr, static_cast<std::size_t>(file_size), PROT_READ, MAP_SHARED,
+        fd, 0
+    );
+    const int error = errno;
+    ::close(fd);
+
+    if (address == MAP_FAILED) {
+      throw std::system_error(error, std::generic_category(), path.string());
+    }
+
+    mapped_layout_file mapping{
+        .data = std::shared_ptr<const unsigned char>(
+            static_cast<const unsigned char*>(address),
+            [file_size](const unsigned char* p) {
+              ::munmap(
+                  const_cast<unsigned char*>(p),
+                  static_cast<std::size_t>(file_size)
+              );
+            }
+        ),
+        .header = {},
+    };
+
+    std::memcpy(&mapping.header, mapping.data.get(), sizeof(layout_file_header));
+    const auto& header = mapping.header;
+
+    if (header.magic != expected.magic) {
+      throw_file_error(path, "bad magic");
+    }
+    if (header.version != expected.version) {
+      throw_file_error(path, "unsupported version");
+    }
+    if (header.policy_kind != expected.policy_kind
+        || header.policy_parameter != expected.policy_parameter) {
+      throw_file_error(path, "layout policy mismatch");
+    }
+    if (header.key_type != expected.key_type
+        || header.value_type != expected.value_type) {
+      throw_file_error(path, "key or value type mismatch");
+    }
+
+    // The size of each element is the low bits of its type tag.
+    const std::uint64_t key_size   = header.key_type & 0xFFFFF;
+    const std::uint64_t value_size = header.value_type & 0xFFFFF;
+
+    auto fits = [&](std::uint64_t position, std::uint64_t element_size) {
+      return position % file_page_size == 0 && position <= file_size
+          && header.size <= (file_size - position) / element_size;
+    };
+    if (!fits(header.keys_position, key_size)
+        || !fits(header.values_position, value_size)) {
+      throw_file_error(path, "section out of bounds");
+    }
+
+    return mapping;
+  }
+
+} // namespace eytzinger::detail
@@ -0,0 +1,149 @@
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <vault/flat_map/numa_replicated_map.hpp>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+namespace eytzinger::detail {
+
+  // -----------------------------------------------------------------------------
+  // Topology (Linux sysfs)
+  // -----------------------------------------------------------------------------
+
+  // Parses a sysfs list such as "0-3,8,10-11" into its numbers.
+  [[nodiscard]] static std::vector<std::size_t> parse_list(
+      const std::string& list
+  )
+  {
+    std::vector<std::size_t> values;
+    std::stringstream        stream(list);
+    std::string              item;
+
+    while (std::getline(stream, item, ',')) {
+      if (item.empty() || item == "\n") {
+        continue;
+      }
+      const auto  dash  = item.find('-');
+      std::size_t first = std::stoul(item.substr(0, dash));
+      std::size_t last =
+          dash == std::string::npos ? first : std::stoul(item.substr(dash + 1));
+      for (std::size_t v = first; v <= last; ++v) {
+        values.push_back(v);
+      }
+    }
+    return values;
+  }
+
+  [[nodiscard]] static std::vector<std::size_t> read_list(
+      const std::string& path
+  )
+  {
+    std::ifstream file(path);
+    std::string   line;
+    if (!file || !std::getline(file, line)) {
+      return {};
+    }
+    try {
+      return parse_list(line);
+    } catch (...) {
+      return {};
+    }
+  }
+
+  struct numa_topology {
+    std::size_t                           nodes = 1;
+    std::vector<std::uint32_t>            cpu_node;  // Node of every CPU.
+    std::vector<std::vector<std::size_t>> node_cpus; // CPUs of every node.
+  };
+
+  [[nodiscard]] static numa_topology read_topology()
+  {
+    numa_topology topology;
+
+#if defined(__linux__)
+    const auto online = read_list("/sys/devices/system/node/online");
+    if (online.empty()) {
+      return topology;
+    }
+
+    topology.nodes = online.back() + 1;
+    topology.node_cpus.resize(topology.nodes);
+
+    for (const auto node : online) {
+      auto cpus = read_list(
+          "/sys/devices/system/node/node" + std::to_string(node) + "/cpulist"
+      );
+      for (const auto cpu : cpus) {
+        if (cpu >= topology.cpu_node.size()) {
+          topology.cpu_node.resize(cpu + 1, 0);
+        }
+        topology.cpu_node[cpu] = static_cast<std::uint32_t>(node);
+      }
+      topology.node_cpus[node] = std::move(cpus);
+    }
+#endif
+
+    return topology;
+  }
+
+  [[nodiscard]] static const numa_topology& topology()
+  {
+    static const numa_topology instance = read_topology();
+    return instance;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Exposed Functions
+  // -----------------------------------------------------------------------------
+
+  [[nodiscard]] std::size_t numa_node_count() noexcept
+  {
+    try {
+      return topology().nodes;
+    } catch (...) {
+      return 1;
+    }
+  }
+
+  [[nodiscard]] std::size_t numa_current_node() noexcept
+  {
+#if defined(__linux__)
+    // sched_getcpu is served by the vDSO, without a system call.
+    const int   cpu      = ::sched_getcpu();
+    const auto& cpu_node = topology().cpu_node;
+    if (cpu >= 0 && static_cast<std::size_t>(cpu) < cpu_node.size()) {
+      return cpu_node[static_cast<std::size_t>(cpu)];
+    }
+#endif
+    return 0;
+  }
+
+  bool numa_bind_current_thread(std::size_t node) noexcept
+  {
+#if defined(__linux__)
+    const auto& node_cpus = topology().node_cpus;
+    if (node >= node_cpus.size() || node_cpus[node].empty()) {
+      return false;
+    }
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (const auto cpu : node_cpus[node]) {
+      if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, &set);
+      }
+    }
+    return ::sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+  }
+
+} // namespace eytzinger::detail
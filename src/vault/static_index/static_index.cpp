@@ -1,17 +1,37 @@
 #include <xxhash.h>
+#include <fcntl.h>
 #include <sys/mman.h>
-
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <fstream>
 #include <memory>
 #include <new>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
 #include <utility>
+#include <variant>
+#include <vector>
 
 #include <function2/function2.hpp>
 
 #include <vault/pthash/pthash.hpp>
 #include <vault/pthash/utils/hasher.hpp>
 
+#include <vault/algorithm/amac.hpp>
+#include <vault/executor/thread_executor.hpp>
+#include <vault/metrics/metrics.hpp>
 #include <vault/static_index/static_index.hpp>
 
 namespace vault::containers {
@@ -19,6 +39,9 @@ namespace vault::containers {
 
     // --- Internal Helpers ---
 
+    // Nanoseconds per build of an index of either kind, for vault::metrics.
+    const metrics::histogram build_metric{"static_index.build_ns"};
+
     struct hasher_128 {
       using hash_type = pthash::hash128;
 
@@ -35,6 +58,389 @@ namespace vault::containers {
       }
     };
 
+    // --- Perfect Hash ---
+
+    template <phf_encoder Encoder>
+    struct encoder_of;
+
+    template <>
+    struct encoder_of<phf_encoder::compact> {
+      using type = pthash::compact;
+    };
+
+    template <>
+    struct encoder_of<phf_encoder::dictionary_dictionary> {
+      using type = pthash::dictionary_dictionary;
+    };
+
+    template <>
+    struct encoder_of<phf_encoder::elias_fano> {
+      using type = pthash::elias_fano;
+    };
+
+    template <phf_bucketer Bucketer>
+    struct bucketer_of;
+
+    template <>
+    struct bucketer_of<phf_bucketer::skew> {
+      using type = pthash::skew_bucketer;
+    };
+
+    template <>
+    struct bucketer_of<phf_bucketer::opt> {
+      using type = pthash::opt_bucketer;
+    };
+
+    template <typename Policy>
+    using single_phf_t = pthash::single_phf<
+      hasher_128,
+      typename bucketer_of<Policy::bucketer>::type,
+      typename encoder_of<Policy::encoder>::type,
+      Policy::minimal>;
+
+    template <typename Policy>
+    using partitioned_phf_t = pthash::partitioned_phf<
+      hasher_128,
+      typename bucketer_of<Policy::bucketer>::type,
+      typename encoder_of<Policy::encoder>::type,
+      Policy::minimal>;
+
+    // A single or a partitioned perfect hash, as the build options chose.
+    template <typename Policy>
+    struct perfect_hash {
+      std::variant<single_phf_t<Policy>, partitioned_phf_t<Policy>> function;
+
+      [[nodiscard]] std::size_t operator()(key_128 const& key) const {
+        if (auto const* single = std::get_if<single_phf_t<Policy>>(&function)) [[likely]] {
+          return (*single)(key);
+        }
+        return std::get<partitioned_phf_t<Policy>>(function)(key);
+      }
+
+      [[nodiscard]] std::size_t num_bits() const {
+        return std::visit([](auto const& f) -> std::size_t { return f.num_bits(); }, function);
+      }
+
+      [[nodiscard]] std::size_t table_size() const {
+        if constexpr (Policy::minimal) {
+          return std::visit([](auto const& f) -> std::size_t { return f.num_keys(); }, function);
+        } else {
+          return std::visit([](auto const& f) -> std::size_t { return f.table_size(); }, function);
+        }
+      }
+    };
+
+    [[nodiscard]] std::size_t resolve_thread_count(std::size_t thread_count) {
+      return thread_count != 0 ? thread_count : std::max(std::size_t{1}, std::size_t{std::thread::hardware_concurrency()});
+    }
+
+    template <typename Policy>
+    [[nodiscard]] perfect_hash<Policy>
+    build_perfect_hash(std::span<key_128 const> keys, static_index_build_options const& options) {
+      pthash::build_configuration config;
+
+      config.alpha       = 0.94;
+      config.lambda      = 3.5;
+      config.verbose     = false;
+      config.num_threads = resolve_thread_count(options.thread_count);
+
+      if (options.partition_size != 0) {
+        config.avg_partition_size = options.partition_size;
+      }
+
+      if (options.ram_budget_bytes != 0) {
+        config.ram     = options.ram_budget_bytes;
+        config.tmp_dir = options.temporary_directory;
+      }
+
+      auto build = [&](auto function) {
+        if (options.ram_budget_bytes != 0) {
+          function.build_in_external_memory(keys.begin(), keys.size(), config);
+        } else {
+          function.build_in_internal_memory(keys.begin(), keys.size(), config);
+        }
+        return perfect_hash<Policy>{std::move(function)};
+      };
+
+      return options.partition_size != 0 ? build(partitioned_phf_t<Policy>{}) : build(single_phf_t<Policy>{});
+    }
+
+    // The fewest keys a thread places at once when fingerprints are
+    // permuted into their slots.
+    constexpr auto permutation_grain = std::size_t{1} << 16;
+
+    // --- Huge Pages ---
+
+    constexpr auto huge_page_size = std::size_t{2} * 1024 * 1024;
+
+    // Asks the kernel to back [ptr, ptr + bytes) with huge pages. The
+    // advice is only worth giving for a region of at least one huge page.
+    void advise_huge_pages(void* ptr, std::size_t bytes) {
+      if (bytes < huge_page_size) {
+        return;
+      }
+
+#if defined(MADV_COLLAPSE)
+      ::madvise(ptr, bytes, MADV_COLLAPSE);
+#elif defined(MADV_HUGEPAGE)
+      ::madvise(ptr, bytes, MADV_HUGEPAGE);
+#endif
+    }
+
+    // --- Persistence ---
+
+    static_assert(std::endian::native == std::endian::little, "The static_index file format is little-endian.");
+
+    constexpr auto file_version   = std::uint32_t{1};
+    constexpr auto file_page_size = std::uint64_t{4096};
+
+    struct file_header {
+      std::array<char, 8> magic   = {'V', 'A', 'U', 'L', 'T', 'S', 'I', 'X'};
+      std::uint32_t       version = file_version;
+
+      // Zero if the file holds no fingerprints, and fingerprint_type_tag
+      // of their type otherwise.
+      std::uint32_t fingerprint_type = 0;
+
+      // The index of the perfect hash in perfect_hash::function, and the
+      // phf_policy_tag of its policy.
+      std::uint32_t phf_kind   = 0;
+      std::uint32_t phf_policy = 0;
+
+      std::uint64_t slot_count            = 0;
+      std::uint64_t phf_position          = 0;
+      std::uint64_t phf_size              = 0;
+      std::uint64_t fingerprints_position = 0;
+
+      std::array<std::byte, 8> reserved{};
+    };
+
+    static_assert(sizeof(file_header) == 64);
+
+    template <typename Fingerprint>
+    constexpr auto fingerprint_type_tag = static_cast<std::uint32_t>(
+      sizeof(Fingerprint) | (std::is_signed_v<Fingerprint> << 8) | (std::is_same_v<Fingerprint, bool> << 9)
+    );
+
+    template <typename Policy>
+    constexpr auto phf_policy_tag = static_cast<std::uint32_t>(
+      static_cast<std::uint32_t>(Policy::encoder) | (static_cast<std::uint32_t>(Policy::bucketer) << 8) |
+      (std::uint32_t{Policy::minimal} << 16)
+    );
+
+    [[noreturn]] void throw_file_error(std::filesystem::path const& path, char const* what) {
+      throw std::runtime_error("static_index file " + path.string() + ": " + what);
+    }
+
+    // Appends the members of a pthash structure to `bytes`, in the order
+    // its visit() walks them.
+    struct phf_saver {
+      std::vector<char>& bytes;
+
+      template <typename T>
+      void visit(T const& value) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+          auto const* first = reinterpret_cast<char const*>(&value);
+          bytes.insert(bytes.end(), first, first + sizeof(T));
+        } else {
+          value.visit(*this);
+        }
+      }
+
+      template <typename T>
+      void visit(std::vector<T> const& values) {
+        visit(std::uint64_t{values.size()});
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+          auto const* first = reinterpret_cast<char const*>(values.data());
+          bytes.insert(bytes.end(), first, first + (values.size() * sizeof(T)));
+        } else {
+          for (auto const& value : values) {
+            visit(value);
+          }
+        }
+      }
+    };
+
+    // Reads back the members of a pthash structure written by phf_saver.
+    struct phf_loader {
+      std::span<unsigned char const> bytes;
+      std::filesystem::path const&   path;
+
+      void read(void* target, std::size_t size) {
+        if (size > bytes.size()) {
+          throw_file_error(path, "truncated perfect hash");
+        }
+
+        std::memcpy(target, bytes.data(), size);
+        bytes = bytes.subspan(size);
+      }
+
+      template <typename T>
+      void visit(T& value) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+          read(&value, sizeof(T));
+        } else {
+          value.visit(*this);
+        }
+      }
+
+      template <typename T>
+      void visit(std::vector<T>& values) {
+        auto size = std::uint64_t{0};
+        visit(size);
+
+        // Every element takes at least a byte, so a larger size is corrupt
+        // and must not be allocated.
+        if (size > bytes.size()) {
+          throw_file_error(path, "truncated perfect hash");
+        }
+
+        values.resize(size);
+
+        if constexpr (std::is_trivially_copyable_v<T>) {
+          read(values.data(), values.size() * sizeof(T));
+        } else {
+          for (auto& value : values) {
+            visit(value);
+          }
+        }
+      }
+    };
+
+    template <typename Policy>
+    [[nodiscard]] std::vector<char> serialize_perfect_hash(perfect_hash<Policy> const& hash) {
+      auto bytes = std::vector<char>{};
+      auto saver = phf_saver{bytes};
+
+      std::visit([&](auto const& function) { function.visit(saver); }, hash.function);
+      return bytes;
+    }
+
+    template <typename Policy>
+    [[nodiscard]] perfect_hash<Policy> deserialize_perfect_hash(
+      file_header const&             header,
+      std::span<unsigned char const> bytes,
+      std::filesystem::path const&   path
+    ) {
+      if (header.phf_policy != phf_policy_tag<Policy>) {
+        throw_file_error(path, "perfect hash policy mismatch");
+      }
+
+      auto loader = phf_loader{bytes, path};
+
+      auto load = [&](auto function) {
+        function.visit(loader);
+        return perfect_hash<Policy>{std::move(function)};
+      };
+
+      auto result = [&] {
+        switch (header.phf_kind) {
+        case 0:
+          return load(single_phf_t<Policy>{});
+        case 1:
+          return load(partitioned_phf_t<Policy>{});
+        default:
+          throw_file_error(path, "unknown perfect hash");
+        }
+      }();
+
+      // Slots index the fingerprints unchecked, so the perfect hash must
+      // map into exactly the slots the header, and so the fingerprint
+      // section, holds.
+      if (result.table_size() != header.slot_count) {
+        throw_file_error(path, "perfect hash does not match slot count");
+      }
+
+      return result;
+    }
+
+    // Writes `header`, the perfect hash, and the fingerprints, page-aligned
+    // so that they can be mapped in place, to `path`.
+    void write_file(
+      std::filesystem::path const& path,
+      file_header                  header,
+      std::span<char const>        phf,
+      std::span<std::byte const>   fingerprints
+    ) {
+      header.phf_position          = sizeof(header);
+      header.phf_size              = phf.size();
+      header.fingerprints_position = (sizeof(header) + phf.size() + file_page_size - 1) / file_page_size * file_page_size;
+
+      auto file = std::ofstream{};
+      file.exceptions(std::ios::failbit | std::ios::badbit);
+      file.open(path, std::ios::binary | std::ios::trunc);
+
+      auto const padding = std::vector<char>(header.fingerprints_position - sizeof(header) - phf.size());
+
+      file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+      file.write(phf.data(), static_cast<std::streamsize>(phf.size()));
+      file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+      file.write(reinterpret_cast<char const*>(fingerprints.data()), static_cast<std::streamsize>(fingerprints.size()));
+    }
+
+    struct mapped_file {
+      std::shared_ptr<unsigned char const> data;
+      std::uint64_t                        size = 0;
+      file_header                          header;
+    };
+
+    // Maps `path` read-only and checks its header and perfect hash section.
+    [[nodiscard]] mapped_file map_file(std::filesystem::path const& path) {
+      auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+      if (fd < 0) {
+        throw std::system_error(errno, std::generic_category(), path.string());
+      }
+
+      struct stat status {};
+      if (::fstat(fd, &status) != 0) {
+        auto const error = errno;
+        ::close(fd);
+        throw std::system_error(error, std::generic_category(), path.string());
+      }
+
+      auto const file_size = static_cast<std::uint64_t>(status.st_size);
+      if (file_size < sizeof(file_header)) {
+        ::close(fd);
+        throw_file_error(path, "truncated header");
+      }
+
+      auto* const address = ::mmap(nullptr, static_cast<std::size_t>(file_size), PROT_READ, MAP_SHARED, fd, 0);
+      auto const  error   = errno;
+      ::close(fd);
+
+      if (address == MAP_FAILED) {
+        throw std::system_error(error, std::generic_category(), path.string());
+      }
+
+      auto mapping = mapped_file{
+        .data = std::shared_ptr<unsigned char const>(
+          static_cast<unsigned char const*>(address),
+          [file_size](unsigned char const* p) {
+            ::munmap(const_cast<unsigned char*>(p), static_cast<std::size_t>(file_size));
+          }
+        ),
+        .size   = file_size,
+        .header = {},
+      };
+
+      std::memcpy(&mapping.header, mapping.data.get(), sizeof(file_header));
+      auto const& header = mapping.header;
+
+      if (header.magic != file_header{}.magic) {
+        throw_file_error(path, "bad magic");
+      }
+      if (header.version != file_version) {
+        throw_file_error(path, "unsupported version");
+      }
+      if (header.phf_position > file_size || header.phf_size > file_size - header.phf_position ||
+          header.fingerprints_position > file_size || header.fingerprints_position % file_page_size != 0) {
+        throw_file_error(path, "section out of bounds");
+      }
+
+      return mapping;
+    }
+
     // --- Custom Deleter ---
 
     struct impl_deleter {
@@ -58,12 +464,35 @@ namespace vault::containers {
       return state.get();
     }
 
+    // An AMAC job that prefetches the fingerprint of a key whose slot is
+    // known, while the coordinator evaluates the perfect hash of the keys
+    // after it.
+    template <typename Fingerprint>
+    struct fingerprint_job {
+      std::size_t        index;
+      std::size_t        slot;
+      Fingerprint const* fingerprint;
+
+      [[nodiscard]] static constexpr auto fanout() noexcept -> std::size_t {
+        return 1;
+      }
+
+      [[nodiscard]] auto init() const noexcept -> amac::job_step_result<1> {
+        return {{fingerprint}};
+      }
+
+      [[nodiscard]] static auto step() noexcept -> amac::job_step_result<1> {
+        return {};
+      }
+    };
+
   } // namespace
 
   // --- The Implementation Struct ---
 
-  struct static_index_base::impl {
-    pthash::single_phf<hasher_128, pthash::skew_bucketer, pthash::dictionary_dictionary, true> mph_function;
+  template <typename Policy>
+  struct basic_static_index_base<Policy>::impl {
+    perfect_hash<Policy> mph_function;
 
     [[nodiscard]] std::pair<size_t, key_128> lookup(key_128 h) const {
       return {mph_function(h), h};
@@ -74,14 +503,17 @@ namespace vault::containers {
     }
   };
 
-  // --- static_index_base Implementation ---
+  // --- basic_static_index_base Implementation ---
 
-  static_index_base::~static_index_base() = default;
+  template <typename Policy>
+  basic_static_index_base<Policy>::~basic_static_index_base() = default;
 
-  static_index_base::static_index_base(std::shared_ptr<const impl> ptr)
+  template <typename Policy>
+  basic_static_index_base<Policy>::basic_static_index_base(std::shared_ptr<const impl> ptr)
     : pimpl_(std::move(ptr)) {}
 
-  std::pair<size_t, key_128> static_index_base::operator[](key_128 hash) const {
+  template <typename Policy>
+  std::pair<size_t, key_128> basic_static_index_base<Policy>::operator[](key_128 hash) const {
     if (!pimpl_) [[unlikely]] {
       return {npos, hash};
     } else {
@@ -89,19 +521,44 @@ namespace vault::containers {
     }
   }
 
-  std::pair<size_t, key_128> static_index_base::operator[](bytes_sequence_channel_t visitor) const {
+  template <typename Policy>
+  std::pair<size_t, key_128> basic_static_index_base<Policy>::operator[](bytes_sequence_channel_t visitor) const {
     return operator[](hash(visitor));
   }
 
-  size_t static_index_base::memory_usage_bytes() const noexcept {
+  template <typename Policy>
+  void basic_static_index_base<Policy>::lookup_many(std::span<key_128 const> hashes, std::span<std::size_t> slots) const {
+    assert(slots.size() >= hashes.size());
+
+    if (!pimpl_) [[unlikely]] {
+      std::ranges::fill(slots.first(hashes.size()), npos);
+      return;
+    }
+
+    // The iterations are independent, so the out-of-order core overlaps
+    // the loads of several evaluations.
+    for (auto i = std::size_t{0}; i < hashes.size(); ++i) {
+      slots[i] = pimpl_->mph_function(hashes[i]);
+    }
+  }
+
+  template <typename Policy>
+  size_t basic_static_index_base<Policy>::memory_usage_bytes() const noexcept {
     return pimpl_ ? pimpl_->memory_usage() : 0;
   }
 
-  bool static_index_base::empty() const noexcept {
+  template <typename Policy>
+  bool basic_static_index_base<Policy>::empty() const noexcept {
     return !pimpl_;
   }
 
-  key_128 static_index_base::hash(bytes_sequence_channel_t channel) {
+  template <typename Policy>
+  size_t basic_static_index_base<Policy>::slot_count() const noexcept {
+    return pimpl_ ? pimpl_->mph_function.table_size() : 0;
+  }
+
+  template <typename Policy>
+  key_128 basic_static_index_base<Policy>::hash(bytes_sequence_channel_t channel) {
     auto* state = get_thread_local_state();
     XXH3_128bits_reset(state);
 
@@ -114,49 +571,43 @@ namespace vault::containers {
     return key_128_from_xxhash(XXH3_128bits_digest(state));
   }
 
+  template <typename Policy>
+  key_128 basic_static_index_base<Policy>::hash_bytes(std::span<std::byte const> bytes) noexcept {
+    return key_128_from_xxhash(XXH3_128bits(bytes.data(), bytes.size_bytes()));
+  }
+
   // --- static_index_builder Implementation ---
 
-  static_index_base static_index_base::build(std::span<key_128 const> keys) {
+  template <typename Policy>
+  basic_static_index_base<Policy>
+  basic_static_index_base<Policy>::build(std::span<key_128 const> keys, static_index_build_options const& options) {
     if (keys.empty()) {
       return {};
     }
 
-    // 1. Build PTHash structure temporarily
-    auto temp_mph = pthash::single_phf<hasher_128, pthash::skew_bucketer, pthash::dictionary_dictionary, true>();
+    auto const timer = metrics::scoped_timer{build_metric};
 
-    {
-      pthash::build_configuration config;
-
-      config.alpha   = 0.94;
-      config.lambda  = 3.5;
-      config.verbose = false;
-
-      temp_mph.build_in_internal_memory(keys.begin(), keys.size(), config);
-    }
+    // 1. Build PTHash structure temporarily
+    auto temp_mph = build_perfect_hash<Policy>(keys, options);
 
     // 2. Allocate Memory
-    size_t total_bytes = sizeof(static_index_base::impl);
+    size_t total_bytes = sizeof(impl);
 
     void* ptr = nullptr;
 
-    if (total_bytes >= 2 * 1024 * 1024) {
-      posix_memalign(&ptr, 2 * 1024 * 1024, total_bytes);
-
-#if defined(MADV_COLLAPSE)
-      ::madvise(ptr, total_bytes, MADV_COLLAPSE);
-#elif defined(MADV_HUGEPAGE)
-      ::madvise(ptr, total_bytes, MADV_HUGEPAGE);
-#endif
+    if (total_bytes >= huge_page_size) {
+      posix_memalign(&ptr, huge_page_size, total_bytes);
+      advise_huge_pages(ptr, total_bytes);
     } else {
       ptr = malloc(total_bytes);
     }
 
     try {
-      auto* impl_ptr = new (ptr) static_index_base::impl();
+      auto* impl_ptr = new (ptr) impl();
 
       try {
         impl_ptr->mph_function = std::move(temp_mph);
-        return static_index_base(std::shared_ptr<const static_index_base::impl>(impl_ptr, impl_deleter{}));
+        return basic_static_index_base(std::shared_ptr<const impl>(impl_ptr, impl_deleter{}));
       } catch (...) {
         std::destroy_at(impl_ptr);
         throw;
@@ -167,51 +618,108 @@ namespace vault::containers {
     }
   }
 
+  // --- Persistence ---
+
+  template <typename Policy>
+  void basic_static_index_base<Policy>::save(std::filesystem::path const& path) const {
+    auto header       = file_header{};
+    header.phf_policy = phf_policy_tag<Policy>;
+
+    auto phf = std::vector<char>{};
+
+    if (pimpl_) {
+      header.phf_kind   = static_cast<std::uint32_t>(pimpl_->mph_function.function.index());
+      header.slot_count = pimpl_->mph_function.table_size();
+      phf               = serialize_perfect_hash(pimpl_->mph_function);
+    }
+
+    write_file(path, header, phf, {});
+  }
+
+  template <typename Policy>
+  basic_static_index_base<Policy> basic_static_index_base<Policy>::open_mapped(std::filesystem::path const& path) {
+    auto const mapping = map_file(path);
+    auto const& header = mapping.header;
+
+    if (header.slot_count == 0) {
+      return {};
+    }
+
+    auto const phf = std::span{mapping.data.get() + header.phf_position, static_cast<std::size_t>(header.phf_size)};
+
+    auto impl_ptr          = std::make_shared<impl>();
+    impl_ptr->mph_function = deserialize_perfect_hash<Policy>(header, phf, path);
+
+    return basic_static_index_base(std::move(impl_ptr));
+  }
+
+  template class basic_static_index_base<default_phf_policy>;
+  template class basic_static_index_base<fast_phf_policy>;
+  template class basic_static_index_base<small_phf_policy>;
+
 } // namespace vault::containers
 
 // --- Specialized Static Index for Integral Type Fingerprints ---
 
 namespace vault::containers {
-  template <typename Fingerprint>
+  template <typename Fingerprint, typename Policy>
     requires std::is_integral_v<Fingerprint>
-  struct specialized_static_index_base<Fingerprint>::impl {
-    pthash::single_phf<hasher_128, pthash::skew_bucketer, pthash::dictionary_dictionary, true> mph_function;
+  struct specialized_static_index_base<Fingerprint, Policy>::impl {
+    perfect_hash<Policy> mph_function;
 
+    // The number of slots, one fingerprint each.
     std::size_t nfingerprints = 0;
-    Fingerprint fingerprints[];
+
+    // The fingerprints, which are in `storage` if the index was opened
+    // from a file, and in `owned` if it was built.
+    Fingerprint const*                   fingerprints = nullptr;
+    std::shared_ptr<unsigned char const> storage;
+    Fingerprint                          owned[];
   };
 
-  template <typename Fingerprint>
+  template <typename Fingerprint, typename Policy>
     requires std::is_integral_v<Fingerprint>
-  specialized_static_index_base<Fingerprint>::specialized_static_index_base(std::shared_ptr<impl const> pimpl)
+  specialized_static_index_base<Fingerprint, Policy>::specialized_static_index_base(std::shared_ptr<impl const> pimpl)
     : pimpl_(std::move(pimpl)) {}
 
-  template <typename Fingerprint>
+  template <typename Fingerprint, typename Policy>
     requires std::is_integral_v<Fingerprint>
-  specialized_static_index_base<Fingerprint>::~specialized_static_index_base() = default;
+  specialized_static_index_base<Fingerprint, Policy>::~specialized_static_index_base() = default;
 
-  template <typename Fingerprint>
+  template <typename Fingerprint, typename Policy>
     requires std::is_integral_v<Fingerprint>
-  bool specialized_static_index_base<Fingerprint>::empty() const noexcept {
+  bool specialized_static_index_base<Fingerprint, Policy>::empty() const noexcept {
     return pimpl_->nfingerprints == 0;
   }
 
-  template <typename Fingerprint>
+  template <typename Fingerprint, typename Policy>
     requires std::is_integral_v<Fingerprint>
-  size_t specialized_static_index_base<Fingerprint>::memory_usage_bytes() const noexcept {
+  size_t specialized_static_index_base<Fingerprint, Policy>::slot_count() const noexcept {
+    return pimpl_ ? pimpl_->nfingerprints : 0;
+  }
+
+  template <typename Fingerprint, typename Policy>
+    requires std::is_integral_v<Fingerprint>
+  size_t specialized_static_index_base<Fingerprint, Policy>::memory_usage_bytes() const noexcept {
     return (pimpl_->mph_function.num_bits() / 8) + sizeof(pimpl_->nfingerprints) +
            (pimpl_->nfingerprints * sizeof(Fingerprint));
   }
 
-  template <typename Fingerprint>
+  template <typename Fingerprint, typename Policy>
+    requires std::is_integral_v<Fingerprint>
+  key_128 specialized_static_index_base<Fingerprint, Policy>::hash(bytes_sequence_channel_t channel) {
+    return basic_static_index_base<Policy>::hash(channel);
+  }
+
+  template <typename Fingerprint, typename Policy>
     requires std::is_integral_v<Fingerprint>
-  key_128 specialized_static_index_base<Fingerprint>::hash(bytes_sequence_channel_t channel) {
-    return static_index_base::hash(channel);
+  key_128 specialized_static_index_base<Fingerprint, Policy>::hash_bytes(std::span<std::byte const> bytes) noexcept {
+    return basic_static_index_base<Policy>::hash_bytes(bytes);
   }
 
-  template <typename Fingerprint>
+  template <typename Fingerprint, typename Policy>
     requires std::is_integral_v<Fingerprint>
-  std::tuple<std::size_t, key_128, Fingerprint> specialized_static_index_base<Fingerprint>::operator[](key_128 hash
+  std::tuple<std::size_t, key_128, Fingerprint> specialized_static_index_base<Fingerprint, Policy>::operator[](key_128 hash
   ) const {
     if (!pimpl_) [[unlikely]] {
       return {npos, hash, {}};
@@ -221,49 +729,68 @@ namespace vault::containers {
     }
   }
 
-  template <typename Fingerprint>
+  template <typename Fingerprint, typename Policy>
     requires std::is_integral_v<Fingerprint>
   std::tuple<std::size_t, key_128, Fingerprint>
-  specialized_static_index_base<Fingerprint>::operator[](bytes_sequence_channel_t channel) const {
+  specialized_static_index_base<Fingerprint, Policy>::operator[](bytes_sequence_channel_t channel) const {
     return operator[](hash(channel));
   }
 
-  template <typename Fingerprint>
+  template <typename Fingerprint, typename Policy>
+    requires std::is_integral_v<Fingerprint>
+  void specialized_static_index_base<Fingerprint, Policy>::lookup_many(
+    std::span<key_128 const> hashes,
+    std::span<std::size_t>   slots,
+    std::span<Fingerprint>   fingerprints
+  ) const {
+    assert(slots.size() >= hashes.size());
+    assert(fingerprints.size() >= hashes.size());
+
+    if (!pimpl_) [[unlikely]] {
+      std::ranges::fill(slots.first(hashes.size()), npos);
+      std::ranges::fill(fingerprints.first(hashes.size()), Fingerprint{});
+      return;
+    }
+
+    auto make_job = [this, hashes](std::size_t i) {
+      auto const slot = pimpl_->mph_function(hashes[i]);
+      return fingerprint_job<Fingerprint>{i, slot, pimpl_->fingerprints + slot};
+    };
+
+    amac::coordinator_fn<16>{}(
+      std::views::iota(std::size_t{0}, hashes.size()) | std::views::transform(make_job),
+      [&](fingerprint_job<Fingerprint>&& job) {
+        slots[job.index]        = job.slot;
+        fingerprints[job.index] = *job.fingerprint;
+      }
+    );
+  }
+
+  template <typename Fingerprint, typename Policy>
     requires std::is_integral_v<Fingerprint>
-  specialized_static_index_base<Fingerprint> specialized_static_index_base<Fingerprint>::build(
-    std::span<key_128 const>     hashes,
-    std::span<Fingerprint const> fingerprints
+  specialized_static_index_base<Fingerprint, Policy> specialized_static_index_base<Fingerprint, Policy>::build(
+    std::span<key_128 const>          hashes,
+    std::span<Fingerprint const>      fingerprints,
+    static_index_build_options const& options
   ) {
     if (hashes.size() == 0) {
       return {};
     }
 
-    // 1. Build PTHash structure temporarily
-    auto temp_mph = pthash::single_phf<hasher_128, pthash::skew_bucketer, pthash::dictionary_dictionary, true>();
-
-    {
-      pthash::build_configuration config;
-
-      config.alpha   = 0.94;
-      config.lambda  = 3.5;
-      config.verbose = false;
+    auto const timer = metrics::scoped_timer{build_metric};
 
-      temp_mph.build_in_internal_memory(hashes.begin(), hashes.size(), config);
-    }
+    // 1. Build PTHash structure temporarily
+    auto temp_mph = build_perfect_hash<Policy>(hashes, options);
 
     // 2. Allocate Memory
-    size_t total_bytes = sizeof(impl) + (hashes.size() * sizeof(Fingerprint));
+    auto const slots       = temp_mph.table_size();
+    size_t     total_bytes = sizeof(impl) + (slots * sizeof(Fingerprint));
 
     void* ptr = nullptr;
 
-    if (total_bytes >= 2 * 1024 * 1024) {
-      posix_memalign(&ptr, 2 * 1024 * 1024, total_bytes);
-
-#if defined(MADV_COLLAPSE)
-      ::madvise(ptr, total_bytes, MADV_COLLAPSE);
-#elif defined(MADV_HUGEPAGE)
-      ::madvise(ptr, total_bytes, MADV_HUGEPAGE);
-#endif
+    if (total_bytes >= huge_page_size) {
+      posix_memalign(&ptr, huge_page_size, total_bytes);
+      advise_huge_pages(ptr, total_bytes);
     } else {
       ptr = malloc(total_bytes);
     }
@@ -273,15 +800,96 @@ namespace vault::containers {
 
       try {
         impl_ptr->mph_function  = std::move(temp_mph);
-        impl_ptr->nfingerprints = hashes.size();
+        impl_ptr->nfingerprints = slots;
 
-        Fingerprint* raw_data = impl_ptr->fingerprints;
+        Fingerprint* raw_data  = impl_ptr->owned;
+        impl_ptr->fingerprints = raw_data;
 
-        for (auto const& h : hashes) {
-          auto slot      = impl_ptr->mph_function(h);
-          raw_data[slot] = static_cast<Fingerprint>(h.high);
+        // A non-minimal perfect hash leaves some slots without a key.
+        if (slots != hashes.size()) {
+          std::uninitialized_fill_n(raw_data, slots, Fingerprint{});
         }
 
+        // Every key has a slot of its own, so the threads never write to
+        // the same fingerprint.
+        algorithm::thread_executor{options.thread_count}(
+          hashes.size(), permutation_grain, [&](std::size_t, std::size_t first, std::size_t last) {
+            for (auto i = first; i < last; ++i) {
+              raw_data[impl_ptr->mph_function(hashes[i])] = fingerprints[i];
+            }
+          }
+        );
+
+        return specialized_static_index_base(std::shared_ptr<const impl>(impl_ptr, impl_deleter{}));
+      } catch (...) {
+        std::destroy_at(impl_ptr);
+        throw;
+      }
+    } catch (...) {
+      free(ptr);
+      throw;
+    }
+  }
+
+  template <typename Fingerprint, typename Policy>
+    requires std::is_integral_v<Fingerprint>
+  void specialized_static_index_base<Fingerprint, Policy>::save(std::filesystem::path const& path) const {
+    auto header             = file_header{};
+    header.fingerprint_type = fingerprint_type_tag<Fingerprint>;
+    header.phf_policy       = phf_policy_tag<Policy>;
+
+    auto phf          = std::vector<char>{};
+    auto fingerprints = std::span<Fingerprint const>{};
+
+    if (pimpl_) {
+      header.phf_kind   = static_cast<std::uint32_t>(pimpl_->mph_function.function.index());
+      header.slot_count = pimpl_->nfingerprints;
+      phf               = serialize_perfect_hash(pimpl_->mph_function);
+      fingerprints      = {pimpl_->fingerprints, pimpl_->nfingerprints};
+    }
+
+    write_file(path, header, phf, std::as_bytes(fingerprints));
+  }
+
+  template <typename Fingerprint, typename Policy>
+    requires std::is_integral_v<Fingerprint>
+  specialized_static_index_base<Fingerprint, Policy>
+  specialized_static_index_base<Fingerprint, Policy>::open_mapped(std::filesystem::path const& path) {
+    auto mapping       = map_file(path);
+    auto const& header = mapping.header;
+
+    if (header.fingerprint_type != fingerprint_type_tag<Fingerprint>) {
+      throw_file_error(path, "fingerprint type mismatch");
+    }
+    if (header.slot_count > (mapping.size - header.fingerprints_position) / sizeof(Fingerprint)) {
+      throw_file_error(path, "section out of bounds");
+    }
+    if (header.slot_count == 0) {
+      return {};
+    }
+
+    auto const phf = std::span{mapping.data.get() + header.phf_position, static_cast<std::size_t>(header.phf_size)};
+
+    auto* const fingerprints = mapping.data.get() + header.fingerprints_position;
+    auto const  nbytes       = static_cast<std::size_t>(header.slot_count * sizeof(Fingerprint));
+
+    // The section is page-aligned in the file, and so in the mapping.
+    advise_huge_pages(const_cast<unsigned char*>(fingerprints), nbytes);
+
+    void* ptr = malloc(sizeof(impl));
+    if (!ptr) {
+      throw std::bad_alloc();
+    }
+
+    try {
+      auto* impl_ptr = new (ptr) impl();
+
+      try {
+        impl_ptr->mph_function  = deserialize_perfect_hash<Policy>(header, phf, path);
+        impl_ptr->nfingerprints = header.slot_count;
+        impl_ptr->fingerprints  = reinterpret_cast<Fingerprint const*>(fingerprints);
+        impl_ptr->storage       = std::move(mapping.data);
+
         return specialized_static_index_base(std::shared_ptr<const impl>(impl_ptr, impl_deleter{}));
       } catch (...) {
         std::destroy_at(impl_ptr);
@@ -293,21 +901,27 @@ namespace vault::containers {
     }
   }
 
-  template class specialized_static_index_base<bool>;
-  template class specialized_static_index_base<char>;
-  template class specialized_static_index_base<signed char>;
-  template class specialized_static_index_base<unsigned char>;
-  template class specialized_static_index_base<short>;
-  template class specialized_static_index_base<unsigned short>;
-  template class specialized_static_index_base<int>;
-  template class specialized_static_index_base<unsigned int>;
-  template class specialized_static_index_base<long>;
-  template class specialized_static_index_base<unsigned long>;
-  template class specialized_static_index_base<long long>;
-  template class specialized_static_index_base<unsigned long long>;
-
-  template class specialized_static_index_base<wchar_t>;
-  template class specialized_static_index_base<char8_t>;
-  template class specialized_static_index_base<char16_t>;
-  template class specialized_static_index_base<char32_t>;
+#define VAULT_STATIC_INDEX_TEMPLATES(Policy)                                \
+  template class specialized_static_index_base<bool, Policy>;               \
+  template class specialized_static_index_base<char, Policy>;               \
+  template class specialized_static_index_base<signed char, Policy>;        \
+  template class specialized_static_index_base<unsigned char, Policy>;      \
+  template class specialized_static_index_base<short, Policy>;              \
+  template class specialized_static_index_base<unsigned short, Policy>;     \
+  template class specialized_static_index_base<int, Policy>;                \
+  template class specialized_static_index_base<unsigned int, Policy>;       \
+  template class specialized_static_index_base<long, Policy>;               \
+  template class specialized_static_index_base<unsigned long, Policy>;      \
+  template class specialized_static_index_base<long long, Policy>;          \
+  template class specialized_static_index_base<unsigned long long, Policy>; \
+  template class specialized_static_index_base<wchar_t, Policy>;            \
+  template class specialized_static_index_base<char8_t, Policy>;            \
+  template class specialized_static_index_base<char16_t, Policy>;           \
+  template class specialized_static_index_base<char32_t, Policy>;
+
+  VAULT_STATIC_INDEX_TEMPLATES(default_phf_policy)
+  VAULT_STATIC_INDEX_TEMPLATES(fast_phf_policy)
+  VAULT_STATIC_INDEX_TEMPLATES(small_phf_policy)
+
+#undef VAULT_STATIC_INDEX_TEMPLATES
 } // namespace vault::containers
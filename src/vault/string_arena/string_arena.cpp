@@ -1,44 +1,287 @@
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <span>
+
+#include <vault/algorithm/shortest_common_superstring.hpp>
 
 #include <vault/frozen_vector/frozen_vector_builder.hpp>
+#include <vault/static_index/static_index.hpp>
+#include <vault/string_arena/prefix_string.hpp>
 #include <vault/string_arena/string_arena.hpp>
 
 namespace vault::arena {
 
+  [[nodiscard]] auto arena_sink::finish() && -> std::pair<std::vector<string>, frozen::frozen_vector<char>> {
+    // Freezing keeps the buffer where it is, so the offsets become pointers.
+    auto shared_buffer = std::move(buffer_).freeze();
+
+    auto result_strings = std::vector<string>{};
+    result_strings.reserve(pending_strings_.size());
+
+    for (auto const& pending : pending_strings_) {
+      if (pending.size <= max_inline_size) {
+        result_strings.emplace_back(pending.inline_data, pending.size);
+      } else {
+        auto const* data_ptr = shared_buffer.data() + pending.offset;
+        result_strings.emplace_back(data_ptr, pending.size);
+      }
+    }
+
+    pending_strings_.clear();
+    return {std::move(result_strings), std::move(shared_buffer)};
+  }
+
   [[nodiscard]] auto to_arena(std::function<void(chars_sink&)> chars_source)
     -> std::pair<std::vector<string>, frozen::frozen_vector<char>> {
     assert(chars_source && "The character source function must not be empty.");
 
-    // Internal metadata to track string extents prior to final allocation.
-    // Utilizes a union to save 8 bytes per element, as strings are exclusively
-    // either inline or indirect.
+    auto arena = arena_sink{};
+    auto sink  = chars_sink{std::ref(arena)};
+
+    chars_source(sink);
+
+    return std::move(arena).finish();
+  }
+
+  [[nodiscard]] auto to_packed_arena(std::function<void(chars_sink&)> chars_source)
+    -> std::pair<std::vector<string>, frozen::frozen_vector<char>> {
+    assert(chars_source && "The character source function must not be empty.");
+
+    // Short strings are kept as they come. Long strings are collected back to
+    // back, and remembered by their index among the long strings.
     struct pending_string_info {
       std::size_t size;
 
       union {
-        std::size_t offset;
+        std::size_t index;
         char        inline_data[max_inline_size];
       };
     };
 
-    auto temp_buffer     = frozen::frozen_vector_builder<char>{};
+    auto long_chars      = std::vector<char>{};
+    auto long_sizes      = std::vector<std::size_t>{};
     auto pending_strings = std::vector<pending_string_info>{};
 
-    auto sink_impl = [&temp_buffer, &pending_strings](std::span<char const> chars) {
-      // Use designated initializers for structural clarity.
+    auto sink_impl = [&](std::span<char const> chars) {
       auto pending = pending_string_info{.size = chars.size()};
 
       if (chars.size() <= max_inline_size) {
         std::copy(chars.begin(), chars.end(), pending.inline_data);
       } else {
-        pending.offset = temp_buffer.size();
+        pending.index = long_sizes.size();
+        long_chars.insert(long_chars.end(), chars.begin(), chars.end());
+        long_sizes.push_back(chars.size());
+      }
+
+      pending_strings.push_back(pending);
+    };
+
+    auto sink = chars_sink{sink_impl};
+
+    // Pass 1: Accumulate metadata and long-string characters.
+    chars_source(sink);
+
+    // Pass 2: Pack the long strings into their superstring.
+    auto long_strings = std::vector<std::span<char const>>{};
+    long_strings.reserve(long_sizes.size());
+    for (auto offset = std::size_t{0}; auto const size : long_sizes) {
+      long_strings.emplace_back(long_chars.data() + offset, size);
+      offset += size;
+    }
+
+    using offset_t = algorithm::superstring_offset<std::uint64_t>;
+
+    auto offsets = std::vector<offset_t>{};
+    offsets.reserve(long_strings.size());
+
+    auto packed = algorithm::greedy_shortest_common_superstring(
+      algorithm::aho_corasick_overlap_engine,
+      long_strings,
+      algorithm::superstring_offsets<std::uint64_t>(std::back_inserter(offsets)));
+
+    auto temp_buffer = frozen::frozen_vector_builder<char>{};
+    temp_buffer.append_range(packed.superstring);
+
+    auto shared_buffer = std::move(temp_buffer).freeze();
+
+    // Pass 3: Construct the final, immutable string instances.
+    auto result_strings = std::vector<string>{};
+    result_strings.reserve(pending_strings.size());
+
+    for (auto const& pending : pending_strings) {
+      if (pending.size <= max_inline_size) {
+        result_strings.emplace_back(pending.inline_data, pending.size);
+      } else {
+        auto const& location = offsets[pending.index];
+        assert(location.length == pending.size);
+
+        auto const* data_ptr = shared_buffer.data() + location.offset;
+        result_strings.emplace_back(data_ptr, pending.size);
+      }
+    }
+
+    return {std::move(result_strings), std::move(shared_buffer)};
+  }
+
+  [[nodiscard]] auto to_interned_arena(std::function<void(chars_sink&)> chars_source, interning_options const& options)
+    -> interned_arena {
+    assert(chars_source && "The character source function must not be empty.");
+
+    // A distinct string: its characters inline, or its offset in the buffer.
+    struct distinct_string_info {
+      std::size_t size;
+
+      union {
+        std::size_t offset;
+        char        inline_data[max_inline_size];
+      };
+    };
+
+    // An open-addressing table of the distinct strings, by the low half of
+    // their hash. Empty slots hold npos.
+    struct table_slot {
+      std::uint64_t hash;
+      std::size_t   id;
+    };
+
+    static constexpr auto npos = std::numeric_limits<std::size_t>::max();
+
+    auto temp_buffer = frozen::frozen_vector_builder<char>{};
+    auto distinct    = std::vector<distinct_string_info>{};
+    auto table       = std::vector<table_slot>(64, table_slot{0, npos});
+    auto ids         = std::vector<std::size_t>{};
+    auto result      = interned_arena{};
+
+    auto const chars_of = [&](distinct_string_info const& info) {
+      return info.size <= max_inline_size ? std::span<char const>{info.inline_data, info.size}
+                                          : std::span<char const>{temp_buffer.data() + info.offset, info.size};
+    };
+
+    // Rehashes into twice the slots once the table is half full.
+    auto const grow = [&table] {
+      auto old_table = std::exchange(table, std::vector<table_slot>(table.size() * 2, table_slot{0, npos}));
+      auto mask      = table.size() - 1;
+      for (auto const& slot : old_table) {
+        if (slot.id != npos) {
+          auto index = slot.hash & mask;
+          while (table[index].id != npos) {
+            index = (index + 1) & mask;
+          }
+          table[index] = slot;
+        }
+      }
+    };
+
+    auto const add_distinct = [&](std::span<char const> chars) {
+      auto info = distinct_string_info{.size = chars.size()};
+
+      if (chars.size() <= max_inline_size) {
+        std::copy(chars.begin(), chars.end(), info.inline_data);
+      } else {
+        info.offset = temp_buffer.size();
+        temp_buffer.append_range(chars);
+        temp_buffer.push_back('\0');
+        ++result.distinct_indirect_count;
+      }
+
+      distinct.push_back(info);
+      return distinct.size() - 1;
+    };
+
+    auto sink_impl = [&](std::span<char const> chars) {
+      auto const is_inline = chars.size() <= max_inline_size;
+      if (!is_inline) {
+        ++result.indirect_count;
+        result.indirect_bytes += chars.size() + 1;
+      }
 
-        // Reverted to element-wise push_back.
-        for (auto c : chars) {
-          temp_buffer.push_back(c);
+      if (is_inline && !options.dense_ids) {
+        ids.push_back(add_distinct(chars));
+        return;
+      }
+
+      auto const hash =
+        containers::basic_static_index_base<>::hash_bytes(std::as_bytes(chars)).low;
+      auto const mask  = table.size() - 1;
+      auto       index = hash & mask;
+      for (; table[index].id != npos; index = (index + 1) & mask) {
+        if (table[index].hash == hash && std::ranges::equal(chars_of(distinct[table[index].id]), chars)) {
+          ids.push_back(table[index].id);
+          return;
         }
+      }
+
+      auto const id = add_distinct(chars);
+      table[index]  = table_slot{hash, id};
+      ids.push_back(id);
+
+      auto const hashed = options.dense_ids ? distinct.size() : result.distinct_indirect_count;
+      if (2 * hashed >= table.size()) {
+        grow();
+      }
+    };
+
+    auto sink = chars_sink{sink_impl};
+
+    // Pass 1: Intern the strings, appending each distinct long string once.
+    chars_source(sink);
+
+    // Pass 2: Freeze the buffer and construct the distinct strings.
+    result.buffer = std::move(temp_buffer).freeze();
 
+    auto distinct_strings = std::vector<string>{};
+    distinct_strings.reserve(distinct.size());
+
+    for (auto const& info : distinct) {
+      if (info.size <= max_inline_size) {
+        distinct_strings.emplace_back(info.inline_data, info.size);
+      } else {
+        distinct_strings.emplace_back(result.buffer.data() + info.offset, info.size);
+      }
+    }
+
+    // Pass 3: Every string is a copy of its distinct string.
+    result.strings.reserve(ids.size());
+    for (auto const id : ids) {
+      result.strings.push_back(distinct_strings[id]);
+    }
+
+    if (options.dense_ids) {
+      result.ids      = std::move(ids);
+      result.distinct = std::move(distinct_strings);
+    }
+
+    return result;
+  }
+
+  [[nodiscard]] auto to_prefix_arena(std::function<void(chars_sink&)> chars_source)
+    -> std::pair<std::vector<prefix_string>, frozen::frozen_vector<char>> {
+    assert(chars_source && "The character source function must not be empty.");
+
+    struct pending_string_info {
+      std::size_t size;
+
+      union {
+        std::size_t offset;
+        char        inline_data[prefix_string::inline_capacity];
+      };
+    };
+
+    auto temp_buffer     = frozen::frozen_vector_builder<char>{};
+    auto pending_strings = std::vector<pending_string_info>{};
+
+    auto sink_impl = [&temp_buffer, &pending_strings](std::span<char const> chars) {
+      auto pending = pending_string_info{.size = chars.size()};
+
+      if (chars.size() <= prefix_string::inline_capacity) {
+        std::copy(chars.begin(), chars.end(), pending.inline_data);
+      } else {
+        pending.offset = temp_buffer.size();
+        temp_buffer.append_range(chars);
         temp_buffer.push_back('\0');
       }
 
@@ -54,15 +297,14 @@ namespace vault::arena {
     auto shared_buffer = std::move(temp_buffer).freeze();
 
     // Pass 3: Construct the final, immutable string instances.
-    auto result_strings = std::vector<string>{};
+    auto result_strings = std::vector<prefix_string>{};
     result_strings.reserve(pending_strings.size());
 
     for (auto const& pending : pending_strings) {
-      if (pending.size <= max_inline_size) {
+      if (pending.size <= prefix_string::inline_capacity) {
         result_strings.emplace_back(pending.inline_data, pending.size);
       } else {
-        auto const* data_ptr = shared_buffer.data() + pending.offset;
-        result_strings.emplace_back(data_ptr, pending.size);
+        result_strings.emplace_back(shared_buffer.data() + pending.offset, pending.size);
       }
     }
 
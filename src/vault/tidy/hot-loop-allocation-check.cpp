@@ -0,0 +1,170 @@
+#include <cassert>
+
+#include <clang/AST/ASTContext.h>
+#include <clang/AST/Attr.h>
+#include <clang/AST/StmtCXX.h>
+#include <clang/ASTMatchers/ASTMatchFinder.h>
+#include <clang/ASTMatchers/ASTMatchers.h>
+
+#include "hot-loop-allocation-check.hpp"
+
+namespace custom_tidy_checks {
+
+  namespace {
+
+    /// Matches functions declared with `[[gnu::hot]]` or annotated with `vault::hot`.
+    AST_MATCHER(clang::FunctionDecl, isHotFunction) {
+      if (Node.hasAttr<clang::HotAttr>()) {
+        return true;
+      }
+      for (auto const* annotation : Node.specific_attrs<clang::AnnotateAttr>()) {
+        if (annotation->getAnnotation() == "vault::hot") {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    /// Matches statements that run on every iteration of an enclosing loop of
+    /// the same function: anything but the init statement of a for loop and the
+    /// range, begin and end statements of a range-based for.
+    AST_MATCHER(clang::Stmt, isRepeatedInLoop) {
+      auto& context = Finder->getASTContext();
+
+      for (auto child = clang::DynTypedNode::create(Node);;) {
+        auto const parents = context.getParents(child);
+        if (parents.empty()) {
+          return false;
+        }
+
+        auto const& parent = parents[0];
+        if (parent.get<clang::FunctionDecl>() != nullptr || parent.get<clang::LambdaExpr>() != nullptr) {
+          return false;
+        }
+
+        auto const* statement = child.get<clang::Stmt>();
+        if (auto const* for_loop = parent.get<clang::ForStmt>()) {
+          if (statement != for_loop->getInit()) {
+            return true;
+          }
+        } else if (auto const* range_loop = parent.get<clang::CXXForRangeStmt>()) {
+          if (statement == range_loop->getBody() || statement == range_loop->getLoopVarStmt()) {
+            return true;
+          }
+        } else if (parent.get<clang::WhileStmt>() != nullptr || parent.get<clang::DoStmt>() != nullptr) {
+          return true;
+        }
+
+        child = parent;
+      }
+    }
+
+  } // namespace
+
+  hot_loop_allocation_check::hot_loop_allocation_check(llvm::StringRef name, clang::tidy::ClangTidyContext* context)
+    : clang::tidy::ClangTidyCheck(name, context) {}
+
+  [[nodiscard]] bool hot_loop_allocation_check::isLanguageVersionSupported(clang::LangOptions const& lang_opts) const {
+    return lang_opts.CPlusPlus11;
+  }
+
+  void hot_loop_allocation_check::registerMatchers(clang::ast_matchers::MatchFinder* finder) {
+    assert(finder != nullptr && "MatchFinder must not be null");
+
+    using namespace clang::ast_matchers;
+
+    auto const in_hot_loop = allOf(isRepeatedInLoop(), forFunction(functionDecl(isHotFunction())));
+
+    auto const callable_record = cxxRecordDecl(hasAnyName("::std::function", "::std::move_only_function"));
+
+    // Containers whose allocator is std::allocator, which allocate from the heap.
+    auto const container_record = classTemplateSpecializationDecl(
+      hasAnyName(
+        "::std::basic_string",
+        "::std::vector",
+        "::std::deque",
+        "::std::list",
+        "::std::forward_list",
+        "::std::set",
+        "::std::multiset",
+        "::std::map",
+        "::std::multimap",
+        "::std::unordered_set",
+        "::std::unordered_multiset",
+        "::std::unordered_map",
+        "::std::unordered_multimap"
+      ),
+      hasAnyTemplateArgument(
+        refersToType(hasCanonicalType(qualType(hasDeclaration(classTemplateSpecializationDecl(hasName("::std::allocator"))))))
+      )
+    );
+
+    // Moves only hand the storage over.
+    auto const allocating_construction = unless(hasDeclaration(cxxConstructorDecl(isMoveConstructor())));
+
+    auto const callable_construct_matcher =
+      cxxConstructExpr(
+        hasType(hasCanonicalType(qualType(hasDeclaration(callable_record)))), allocating_construction, in_hot_loop
+      )
+        .bind("callable_construct");
+
+    auto const callable_call_matcher =
+      cxxOperatorCallExpr(
+        hasOverloadedOperatorName("()"), callee(cxxMethodDecl(ofClass(callable_record))), in_hot_loop
+      )
+        .bind("callable_call");
+
+    auto const container_construct_matcher =
+      cxxConstructExpr(
+        hasType(hasCanonicalType(qualType(hasDeclaration(container_record)))), allocating_construction, in_hot_loop
+      )
+        .bind("container_construct");
+
+    finder->addMatcher(callable_construct_matcher, this);
+    finder->addMatcher(callable_call_matcher, this);
+    finder->addMatcher(container_construct_matcher, this);
+  }
+
+  void hot_loop_allocation_check::check(clang::ast_matchers::MatchFinder::MatchResult const& result) {
+    assert(result.Context != nullptr && "ASTContext must not be null");
+    assert(result.SourceManager != nullptr && "SourceManager must not be null");
+
+    auto const* callable_construct = result.Nodes.getNodeAs<clang::CXXConstructExpr>("callable_construct");
+    auto const* callable_call      = result.Nodes.getNodeAs<clang::CXXOperatorCallExpr>("callable_call");
+    auto const* container_construct = result.Nodes.getNodeAs<clang::CXXConstructExpr>("container_construct");
+
+    auto const* matched_expr = callable_construct != nullptr ? static_cast<clang::Expr const*>(callable_construct)
+                             : callable_call != nullptr      ? static_cast<clang::Expr const*>(callable_call)
+                                                             : static_cast<clang::Expr const*>(container_construct);
+    if (matched_expr == nullptr) {
+      return;
+    }
+
+    auto const source_location = clang::SourceLocation{matched_expr->getBeginLoc()};
+    if (source_location.isInvalid() || result.SourceManager->isInSystemHeader(source_location)) {
+      return;
+    }
+
+    if (callable_construct != nullptr) {
+      diag(
+        source_location,
+        "type-erased callable constructed in a loop of a hot function; it may allocate on every iteration, so "
+        "construct it once outside the loop or take the callable as a template parameter"
+      );
+    } else if (callable_call != nullptr) {
+      diag(
+        source_location,
+        "type-erased callable invoked in a loop of a hot function; the indirect call cannot be inlined, so take the "
+        "callable as a template parameter"
+      );
+    } else {
+      diag(
+        source_location,
+        "%0 constructed in a loop of a hot function; it allocates from the heap on every iteration, so hoist it out "
+        "of the loop and reuse its storage, or give it an arena allocator"
+      )
+        << container_construct->getType().getUnqualifiedType();
+    }
+  }
+
+} // namespace custom_tidy_checks
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <clang-tidy/ClangTidyCheck.h>
+
+namespace custom_tidy_checks {
+
+  /// # Hot Loop Allocation Check
+  ///
+  /// Flags type-erased callables and heap-allocating containers that are
+  /// constructed or invoked on every iteration of a loop, inside functions
+  /// annotated as hot with `[[gnu::hot]]` or `[[clang::annotate("vault::hot")]]`.
+  ///
+  /// The loop body, condition and increment are checked, as is the variable
+  /// of a range-based for, but not the statements that run once before the
+  /// loop. Containers are flagged only when they use `std::allocator`, so
+  /// those on an arena or pool allocator pass. Lambdas defined in a hot
+  /// function are not hot themselves.
+  class hot_loop_allocation_check : public clang::tidy::ClangTidyCheck {
+  public:
+    [[nodiscard]] hot_loop_allocation_check(llvm::StringRef name, clang::tidy::ClangTidyContext* context);
+
+    void registerMatchers(clang::ast_matchers::MatchFinder* finder) override;
+    void check(clang::ast_matchers::MatchFinder::MatchResult const& result) override;
+
+    [[nodiscard]] bool isLanguageVersionSupported(clang::LangOptions const& lang_opts) const override;
+  };
+
+} // namespace custom_tidy_checks
@@ -2,6 +2,7 @@
 #include <clang-tidy/ClangTidyModuleRegistry.h>
 
 #include "callable-observation-check.hpp"
+#include "hot-loop-allocation-check.hpp"
 #include "multiple-bool-parameters-check.hpp"
 #include "pass-by-small-value-check.hpp"
 #include "pointer-chasing-type-check.hpp"
@@ -37,6 +38,7 @@ namespace custom_tidy_checks {
       check_factories.registerCheck<require_out_inout_decorators_check>("vault-require-in-out-decorators");
       check_factories.registerCheck<require_borrowed_ptr_decorator_check>("vault-require-borrowed-ptr-decorator-check");
       check_factories.registerCheck<require_mut_tag_check>("vault-require-mut-tag");
+      check_factories.registerCheck<hot_loop_allocation_check>("vault-hot-loop-allocation");
     }
   };
 } // namespace custom_tidy_checks
@@ -2,9 +2,23 @@
 #include <catch2/generators/catch_generators.hpp>
 
 #include <vault/algorithm/amac.hpp>
-
+#include <vault/algorithm/amac_coroutine.hpp>
+#include <vault/algorithm/amac_sinks.hpp>
+#include <vault/algorithm/batch_knuth_morris_pratt_search.hpp>
+#include <vault/algorithm/knuth_morris_pratt_searcher.hpp>
+#include <vault/algorithm/parallel_amac.hpp>
+#include <vault/algorithm/perf_counters.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <numeric>
 #include <random>
+#include <stdexcept>
 #include <ranges>
+#include <string>
+#include <utility>
 #include <vector>
 
 // --- Test Job Definition ---
@@ -124,6 +138,476 @@ TEST_CASE("AMAC Coordinator: Batch Size Sensitivity", "[amac][batch_size]")
   }
 }
 
+TEST_CASE("AMAC Coordinator: Stats", "[amac][stats]")
+{
+  const size_t num_jobs = GENERATE(0, 1, 17, 1000);
+
+  std::vector<int> start_counts;
+  for (size_t i = 0; i < num_jobs; ++i) {
+    start_counts.push_back(static_cast<int>(i % 7));
+  }
+
+  auto jobs = start_counts
+    | std::views::transform([](int count) { return CountdownJob(count); });
+
+  auto counters = vault::algorithm::perf_counters{};
+  auto stats    = vault::amac::coordinator_stats{.hardware = &counters};
+
+  size_t reported_count = 0;
+  vault::amac::coordinator<16>(
+    jobs, [&](CountdownJob&&) { reported_count++; }, stats);
+
+  // A job counting down from c takes c + 1 transitions, all but the last
+  // of which prefetch one address.
+  auto const total = static_cast<uint64_t>(
+    std::accumulate(start_counts.begin(), start_counts.end(), 0));
+
+  CHECK(reported_count == num_jobs);
+  CHECK(stats.batches == 1);
+  CHECK(stats.jobs == num_jobs);
+  CHECK(stats.steps == total + num_jobs);
+  CHECK(stats.prefetches == total);
+  CHECK(stats.average_live_jobs() <= 16.0);
+  if (num_jobs >= 16) {
+    CHECK(stats.average_live_jobs() > 1.0);
+  }
+
+  // Counts accumulate over calls.
+  vault::amac::coordinator<16>(jobs, [](CountdownJob&&) {}, stats);
+  CHECK(stats.batches == 2);
+  CHECK(stats.jobs == 2 * num_jobs);
+
+  using event = vault::algorithm::perf_counters::event;
+  if (counters.available(event::instructions) && num_jobs > 0) {
+    CHECK(stats.hardware_per_job(event::instructions) > 0.0);
+  }
+}
+
+TEST_CASE("Perf Counters: Intervals", "[amac][stats]")
+{
+  using vault::algorithm::perf_counters;
+
+  auto counters = perf_counters{};
+
+  volatile uint64_t sink = 0;
+  counters.start();
+  for (uint64_t i = 0; i < 100000; ++i) {
+    sink = sink + i;
+  }
+  counters.stop();
+
+  for (size_t e = 0; e < perf_counters::event_count; ++e) {
+    auto const event = static_cast<perf_counters::event>(e);
+    CHECK(perf_counters::name(event) != "unknown");
+    if (!counters.available(event)) {
+      CHECK(counters.total(event) == 0);
+    }
+  }
+  if (counters.available(perf_counters::instructions)) {
+    CHECK(counters.total(perf_counters::instructions) >= 100000);
+  }
+
+  counters.reset();
+  CHECK(counters.total(perf_counters::instructions) == 0);
+}
+
+TEST_CASE("AMAC Adaptive Coordinator: Countdown Integrity", "[amac][adaptive]")
+{
+  const size_t num_jobs        = GENERATE(0, 1, 17, 100, 10000);
+  const int    max_start_count = GENERATE(0, 1, 10);
+
+  std::vector<int> start_counts;
+  start_counts.reserve(num_jobs);
+
+  std::mt19937                       rng(42);
+  std::uniform_int_distribution<int> dist(0, max_start_count);
+
+  for (size_t i = 0; i < num_jobs; ++i) {
+    start_counts.push_back(dist(rng));
+  }
+
+  size_t reported_count = 0;
+  size_t unfinished     = 0;
+  auto   reporter       = [&](CountdownJob&& job) {
+    reported_count++;
+    unfinished += job.counter() != 0 ? 1 : 0;
+  };
+
+  auto jobs = start_counts
+    | std::views::transform([](int count) { return CountdownJob(count); });
+
+  SECTION("Batch Size = 16")
+  {
+    vault::amac::adaptive_coordinator<16>(jobs, reporter);
+  }
+
+  SECTION("Batch Size = 1")
+  {
+    vault::amac::adaptive_coordinator<1>(jobs, reporter);
+  }
+
+  CHECK(reported_count == num_jobs);
+  CHECK(unfinished == 0);
+}
+
+TEST_CASE("AMAC Adaptive Coordinator: Stats", "[amac][adaptive][stats]")
+{
+  const size_t num_jobs = GENERATE(0, 1, 17, 1000);
+
+  std::vector<int> start_counts;
+  for (size_t i = 0; i < num_jobs; ++i) {
+    start_counts.push_back(static_cast<int>(i % 7));
+  }
+
+  auto jobs = start_counts
+    | std::views::transform([](int count) { return CountdownJob(count); });
+
+  auto stats = vault::amac::coordinator_stats{};
+
+  size_t reported_count = 0;
+  vault::amac::adaptive_coordinator<16>(
+    jobs, [&](CountdownJob&&) { reported_count++; }, stats);
+
+  // The same transitions as for the fixed coordinator, whatever the slot
+  // count.
+  auto const total = static_cast<uint64_t>(
+    std::accumulate(start_counts.begin(), start_counts.end(), 0));
+
+  CHECK(reported_count == num_jobs);
+  CHECK(stats.batches == 1);
+  CHECK(stats.jobs == num_jobs);
+  CHECK(stats.steps == total + num_jobs);
+  CHECK(stats.prefetches == total);
+  CHECK(stats.average_live_jobs() <= 16.0);
+
+  vault::amac::adaptive_coordinator<16>(jobs, [](CountdownJob&&) {}, stats);
+  CHECK(stats.batches == 2);
+  CHECK(stats.jobs == 2 * num_jobs);
+}
+
+TEST_CASE("AMAC Adaptive Coordinator: Slot Controller", "[amac][adaptive]")
+{
+  auto controller = vault::amac::detail::slot_controller<16>{};
+  REQUIRE(controller.active() == 16);
+
+  // Feeds the controller windows whose cost is a function of the active
+  // slot count, and returns the counts it visits.
+  auto run = [&](auto cost) {
+    std::vector<size_t> visited;
+    for (int window = 0; window < 40; ++window) {
+      controller.observe(cost(static_cast<double>(controller.active())));
+      visited.push_back(controller.active());
+    }
+    return visited;
+  };
+
+  SECTION("Cache-resident jobs settle on few slots")
+  {
+    auto visited = run([](double slots) { return 10.0 + slots; });
+    for (size_t active : visited | std::views::drop(20)) {
+      CHECK(active <= 4);
+    }
+  }
+
+  SECTION("DRAM-bound jobs settle on many slots")
+  {
+    auto visited = run([](double slots) { return 200.0 / slots; });
+    for (size_t active : visited | std::views::drop(20)) {
+      CHECK(active >= 12);
+    }
+  }
+
+  SECTION("A minimum between the bounds is tracked")
+  {
+    auto visited = run([](double slots) { return (slots - 8) * (slots - 8); });
+    for (size_t active : visited | std::views::drop(20)) {
+      CHECK(active >= 6);
+      CHECK(active <= 10);
+    }
+  }
+}
+
+TEST_CASE("AMAC Parallel Coordinator: Countdown Integrity", "[amac][parallel]")
+{
+  const size_t num_jobs = GENERATE(0, 1, 100, 10000);
+
+  std::vector<int> start_counts;
+  for (size_t i = 0; i < num_jobs; ++i) {
+    start_counts.push_back(static_cast<int>(i % 11));
+  }
+
+  auto jobs = start_counts
+    | std::views::transform([](int count) { return CountdownJob(count); });
+
+  auto executor = vault::algorithm::thread_executor{4};
+
+  SECTION("Serialized reporting")
+  {
+    // The reporter is never invoked concurrently, so it needs no atomics.
+    size_t reported_count = 0;
+    size_t unfinished     = 0;
+
+    vault::amac::parallel_coordinator<16>{executor, 64}(
+      jobs, [&](CountdownJob&& job) {
+        reported_count++;
+        unfinished += job.counter() != 0 ? 1 : 0;
+      });
+
+    CHECK(reported_count == num_jobs);
+    CHECK(unfinished == 0);
+  }
+
+  SECTION("Concurrent reporting per worker")
+  {
+    std::vector<size_t> per_worker(executor.concurrency());
+    std::atomic<size_t> unfinished{0};
+
+    vault::amac::parallel_coordinator<16,
+      vault::amac::report_mode::concurrent>{executor, 64}(
+      jobs, [&](size_t worker, CountdownJob&& job) {
+        per_worker[worker]++;
+        if (job.counter() != 0) {
+          unfinished++;
+        }
+      });
+
+    CHECK(std::accumulate(per_worker.begin(), per_worker.end(), size_t{0})
+      == num_jobs);
+    CHECK(unfinished == 0);
+  }
+
+  SECTION("Input ranges run on the calling thread")
+  {
+    size_t reported_count = 0;
+
+    auto input = jobs | std::views::filter([](auto const&) { return true; });
+    vault::amac::parallel_coordinator<16>{executor, 64}(
+      input, [&](CountdownJob&&) { reported_count++; });
+
+    CHECK(reported_count == num_jobs);
+  }
+}
+
+// --- Coroutine Jobs ---
+
+// The coroutine counterpart of CountdownJob, which yields `count` times and
+// returns its count.
+static vault::amac::coroutine_job<int> countdown(int count)
+{
+  for (int i = 0; i < count; ++i) {
+    co_await vault::amac::prefetch(&count);
+  }
+  co_return count;
+}
+
+static_assert(vault::amac::concepts::job<vault::amac::coroutine_job<int>>);
+static_assert(vault::amac::concepts::job<vault::amac::coroutine_job<int, 2>>);
+
+TEST_CASE("AMAC Coroutine Job: Countdown Integrity", "[amac][coroutine]")
+{
+  const size_t num_jobs = GENERATE(0, 1, 17, 1000);
+
+  std::vector<int> start_counts;
+  for (size_t i = 0; i < num_jobs; ++i) {
+    start_counts.push_back(static_cast<int>(i % 7));
+  }
+
+  std::vector<int> results;
+  vault::amac::coordinator<16>(
+    start_counts | std::views::transform(countdown), [&](auto&& job) {
+      REQUIRE(job.done());
+      results.push_back(job.result());
+    });
+
+  std::ranges::sort(results);
+  std::ranges::sort(start_counts);
+  CHECK(results == start_counts);
+}
+
+TEST_CASE("AMAC Coroutine Job: Binary Search", "[amac][coroutine]")
+{
+  std::vector<int> haystack;
+  for (int i = 0; i < 5000; ++i) {
+    haystack.push_back(i * 2);
+  }
+
+  // A lower bound that prefetches both halves before every probe.
+  auto lower_bound =
+    [&](int needle) -> vault::amac::coroutine_job<std::pair<int, size_t>, 2> {
+    size_t first = 0;
+    size_t count = haystack.size();
+    while (count > 0) {
+      size_t half = count / 2;
+      co_await vault::amac::prefetch(
+        &haystack[first + half / 2], &haystack[first + half + (count - half) / 2]);
+      if (haystack[first + half] < needle) {
+        first += half + 1;
+        count -= half + 1;
+      } else {
+        count = half;
+      }
+    }
+    co_return std::pair{needle, first};
+  };
+
+  std::vector<int> needles;
+  for (int i = -3; i < 10003; i += 3) {
+    needles.push_back(i);
+  }
+
+  size_t reported = 0;
+  auto   check    = [&](auto&& job) {
+    auto [needle, index] = job.result();
+    REQUIRE(index
+      == static_cast<size_t>(
+        std::ranges::lower_bound(haystack, needle) - haystack.begin()));
+    reported++;
+  };
+
+  SECTION("Batch Size = 1")
+  {
+    vault::amac::coordinator<1>(needles | std::views::transform(lower_bound),
+      check);
+  }
+
+  SECTION("Batch Size = 16")
+  {
+    vault::amac::coordinator<16>(needles | std::views::transform(lower_bound),
+      check);
+  }
+
+  CHECK(reported == needles.size());
+}
+
+TEST_CASE("AMAC Coroutine Job: Exceptions", "[amac][coroutine]")
+{
+  auto job = [](int i) -> vault::amac::coroutine_job<int> {
+    co_await vault::amac::prefetch(&i);
+    if (i == 40) {
+      throw std::runtime_error("job failed");
+    }
+    co_return i;
+  };
+
+  std::vector<int> inputs(100);
+  std::iota(inputs.begin(), inputs.end(), 0);
+
+  CHECK_THROWS_AS(vault::amac::coordinator<16>(
+                    inputs | std::views::transform(job), [](auto&&) {}),
+    std::runtime_error);
+}
+
+// --- Result Sinks ---
+
+TEST_CASE("AMAC Sinks: Reorder Buffer", "[amac][sinks]")
+{
+  using job_t = vault::amac::coroutine_job<size_t>;
+
+  const size_t num_jobs = GENERATE(0, 1, 17, 1000);
+
+  // The job of input position i takes a different number of steps than its
+  // neighbours, so the jobs complete out of order.
+  auto job = [](size_t i) -> job_t {
+    for (size_t steps = (i * 7) % 13; steps > 0; --steps) {
+      co_await vault::amac::prefetch(&i);
+    }
+    co_return i;
+  };
+
+  std::vector<size_t> emitted;
+
+  auto sequence = [](job_t const& job) { return job.result(); };
+  auto sink     = [&](job_t&& job) { emitted.push_back(job.result()); };
+
+  // A small ring, so that results arriving far ahead make it grow.
+  auto in_order =
+    vault::amac::reorder_buffer<job_t, decltype(sequence), decltype(sink)>{
+      sequence, sink, 4};
+
+  auto jobs =
+    std::views::iota(size_t{0}, num_jobs) | std::views::transform(job);
+
+  SECTION("Coordinator")
+  {
+    vault::amac::coordinator<16>(jobs, in_order);
+  }
+
+  SECTION("Adaptive coordinator")
+  {
+    vault::amac::adaptive_coordinator<16>(jobs, in_order);
+  }
+
+  std::vector<size_t> expected(num_jobs);
+  std::iota(expected.begin(), expected.end(), size_t{0});
+
+  CHECK(emitted == expected);
+  CHECK(in_order.next() == num_jobs);
+  CHECK(in_order.pending() == 0);
+}
+
+// A result of any size, filled from its position so that misplaced bytes
+// show.
+template <size_t Bytes> struct blob {
+  std::array<unsigned char, Bytes> bytes;
+
+  explicit blob(size_t i)
+  {
+    for (size_t b = 0; b < Bytes; ++b) {
+      bytes[b] = static_cast<unsigned char>(i * 31 + b);
+    }
+  }
+
+  bool operator==(blob const&) const = default;
+};
+
+template <typename T> static void check_streaming_sink(size_t count)
+{
+  // Offsets move the destination across the lines, so the first line is
+  // staged from the middle.
+  for (size_t offset = 0; offset < 4; ++offset) {
+    std::vector<T> out(offset + count, T(~size_t{0}));
+    {
+      auto sink = vault::amac::streaming_sink<T>{out.data() + offset};
+      for (size_t i = 0; i < count; ++i) {
+        sink(T(i));
+      }
+      CHECK(sink.size() == count);
+    }
+
+    for (size_t i = 0; i < offset; ++i) {
+      CHECK(out[i] == T(~size_t{0}));
+    }
+    for (size_t i = 0; i < count; ++i) {
+      CHECK(out[offset + i] == T(i));
+    }
+  }
+}
+
+TEST_CASE("AMAC Sinks: Streaming Sink", "[amac][sinks]")
+{
+  const size_t count = GENERATE(0, 1, 15, 16, 17, 1000);
+
+  check_streaming_sink<uint32_t>(count);
+  check_streaming_sink<blob<12>>(count);
+  check_streaming_sink<blob<24>>(count);
+  check_streaming_sink<blob<64>>(count);
+  check_streaming_sink<blob<100>>(count);
+}
+
+TEST_CASE("AMAC Sinks: Sink Iterator", "[amac][sinks]")
+{
+  std::vector<int> out(100);
+  {
+    auto sink = vault::amac::streaming_sink<int>{out.data()};
+    std::ranges::copy(
+      std::views::iota(0, 100), vault::amac::sink_iterator(sink));
+  }
+
+  std::vector<int> expected(100);
+  std::iota(expected.begin(), expected.end(), 0);
+  CHECK(out == expected);
+}
+
 TEST_CASE(
   "AMAC Coordinator: Immediate Completion Edge Cases", "[amac][edge_cases]")
 {
@@ -246,3 +730,80 @@ TEST_CASE(
   // 4. Verify
   CHECK(reported_count == num_jobs);
 }
+
+TEST_CASE("AMAC Coordinator: Batched KMP Search", "[amac][kmp]")
+{
+  using namespace std::literals;
+
+  auto const text =
+    "the quick brown fox jumps over the lazy dog, then the quick brown "
+    "fox naps while the lazy dog keeps watch over the brown fox"s;
+
+  auto check = [&](auto const& executor, auto const& patterns) {
+    using pattern_iterator = decltype(patterns.begin());
+    using match_t          = std::ranges::subrange<std::string::const_iterator>;
+
+    auto results = std::vector<std::pair<pattern_iterator, match_t>>{};
+    vault::algorithm::batch_knuth_morris_pratt_search(
+      executor, text, patterns, std::back_inserter(results));
+
+    REQUIRE(results.size() == patterns.size());
+
+    auto seen = std::vector<bool>(patterns.size(), false);
+    for (auto const& [pattern, match] : results) {
+      auto const i = static_cast<std::size_t>(pattern - patterns.begin());
+      CHECK(!seen[i]);
+      seen[i] = true;
+
+      auto const [first, last] =
+        vault::algorithm::knuth_morris_pratt_searcher{*pattern}(text);
+      CHECK(match.begin() == first);
+      CHECK(match.end() == last);
+    }
+  };
+
+  auto const patterns = std::vector<std::string>{"fox",
+    "lazy dog",
+    "",
+    "cat",
+    "watch over the brown fox",
+    "the quick brown fox naps",
+    "x",
+    "brown fox jumps over the lazy dog, then",
+    "g",
+    "the the"};
+
+  SECTION("Batch Size = 1")
+  {
+    check(vault::amac::coordinator_fn<1>{}, patterns);
+  }
+
+  SECTION("Batch Size = 4")
+  {
+    check(vault::amac::coordinator_fn<4>{}, patterns);
+  }
+
+  SECTION("Batch Size = 16")
+  {
+    check(vault::amac::coordinator<16>, patterns);
+  }
+
+  SECTION("Random substrings")
+  {
+    auto rng    = std::mt19937{7};
+    auto offset = std::uniform_int_distribution<std::size_t>{0, text.size()};
+    auto length = std::uniform_int_distribution<std::size_t>{0, 12};
+
+    auto many = std::vector<std::string>{};
+    for (auto i = 0; i < 500; ++i) {
+      auto const first = offset(rng);
+      auto       s     = text.substr(first, length(rng));
+      if (i % 3 == 0 && !s.empty()) {
+        s.back() = '#';
+      }
+      many.push_back(std::move(s));
+    }
+
+    check(vault::amac::coordinator_fn<8>{}, many);
+  }
+}
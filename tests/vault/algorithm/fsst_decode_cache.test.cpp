@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <catch2/catch_test_macros.hpp>
+#include <vault/algorithm/fsst_decode_cache.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace vault::algorithm;
+
+using StringDict = fsst_dictionary<std::string>;
+
+namespace {
+  auto generate_strings(std::size_t count) -> std::vector<std::string>
+  {
+    auto result = std::vector<std::string>{};
+    result.reserve(count);
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      result.push_back("cached_entry_" + std::to_string(i));
+    }
+    return result;
+  }
+} // namespace
+
+TEST_CASE("fsst_decode_cache lookups", "[fsst][cache]")
+{
+  auto const inputs = generate_strings(1'000);
+  auto [dict, keys] = StringDict::build_from_unique(inputs);
+  REQUIRE(keys.size() == inputs.size());
+
+  SECTION("Repeated lookups hit")
+  {
+    auto cache = fsst_decode_cache{dict};
+
+    for (auto round = 0; round < 3; ++round) {
+      for (auto i = std::size_t{0}; i < 10; ++i) {
+        auto const value = cache.find(keys[i]);
+        REQUIRE(value.has_value());
+        CHECK(*value == inputs[i]);
+      }
+    }
+
+    CHECK(cache.stats().misses == 10);
+    CHECK(cache.stats().hits == 20);
+    CHECK(cache.stats().evictions == 0);
+    CHECK(cache.size() == 10);
+  }
+
+  SECTION("The budget bounds the cached bytes")
+  {
+    auto const budget = 16 * (fsst_decode_cache::entry_overhead + 20);
+    auto       cache =
+      fsst_decode_cache{dict, fsst_decode_cache::byte_budget{budget}};
+
+    for (auto i = std::size_t{0}; i < inputs.size(); ++i) {
+      auto const value = cache.find(keys[i]);
+      REQUIRE(value.has_value());
+      REQUIRE(*value == inputs[i]);
+      REQUIRE(cache.size_in_bytes() <= budget);
+    }
+
+    CHECK(cache.size() <= 16);
+    CHECK(cache.stats().evictions == inputs.size() - cache.size());
+  }
+
+  SECTION("Hot keys survive a scan of cold ones")
+  {
+    auto const budget = 16 * (fsst_decode_cache::entry_overhead + 20);
+    auto       cache =
+      fsst_decode_cache{dict, fsst_decode_cache::byte_budget{budget}};
+
+    for (auto i = std::size_t{100}; i < inputs.size(); ++i) {
+      REQUIRE(cache.find(keys[i % 4]) == inputs[i % 4]);
+      REQUIRE(cache.find(keys[i]) == inputs[i]);
+    }
+
+    CHECK(cache.stats().hits == inputs.size() - 100 - 4);
+  }
+
+  SECTION("Values larger than the budget are returned but not cached")
+  {
+    auto cache = fsst_decode_cache{dict, fsst_decode_cache::byte_budget{8}};
+    CHECK(cache.find(keys[0]) == inputs[0]);
+    CHECK(cache.find(keys[0]) == inputs[0]);
+    CHECK(cache.size() == 0);
+    CHECK(cache.stats().misses == 2);
+  }
+
+  SECTION("Inline keys and missing keys")
+  {
+    auto cache = fsst_decode_cache{dict};
+    CHECK(cache.find(StringDict::make_inline_key("short")) == "short");
+
+    auto const empty_dict  = StringDict{};
+    auto       empty_cache = fsst_decode_cache{empty_dict};
+    CHECK_FALSE(empty_cache.find(keys[0]).has_value());
+    CHECK(empty_cache.size() == 0);
+  }
+
+  SECTION("clear drops values and counters")
+  {
+    auto cache = fsst_decode_cache{dict};
+    CHECK(cache.find(keys[0]) == inputs[0]);
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK(cache.size_in_bytes() == 0);
+    CHECK(cache.stats().misses == 0);
+    CHECK(cache.find(keys[0]) == inputs[0]);
+  }
+}
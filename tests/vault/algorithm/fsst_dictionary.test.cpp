@@ -5,9 +5,14 @@
 
 #include <algorithm>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iterator>
 #include <list>
+#include <memory>
+#include <optional>
 #include <string>
+#include <system_error>
 #include <unordered_map>
 #include <vector>
 
@@ -27,6 +32,34 @@ namespace {
     };
   }
 
+  // Streaming builds pass views that die after the call, so the map has to
+  // own its keys.
+  auto make_owning_dedup() -> fsst_dictionary_base::Deduplicator
+  {
+    auto map =
+      std::make_shared<std::unordered_map<std::string, std::uint64_t>>();
+    return [map](std::string_view s) -> std::pair<std::uint64_t, bool> {
+      auto [it, inserted] = map->emplace(s, map->size());
+      return {it->second, inserted};
+    };
+  }
+
+  // Repeatable passes over `inputs` that hand out copies.
+  auto make_passes(std::vector<std::string> const& inputs)
+    -> fsst_dictionary_base::RValueGeneratorFactory
+  {
+    return [&inputs] {
+      return fsst_dictionary_base::RValueGenerator{
+        [it = inputs.begin(), end = inputs.end()]() mutable
+        -> std::optional<std::string> {
+          if (it == end) {
+            return std::nullopt;
+          }
+          return *it++;
+        }};
+    };
+  }
+
   auto generate_strings(std::size_t count) -> std::vector<std::string>
   {
     auto result = std::vector<std::string>{};
@@ -119,6 +152,49 @@ TEST_CASE("fsst_dictionary construction strategies", "[fsst][build]")
     REQUIRE(keys.size() == 5);
     CHECK(*dict[keys[0]] == "apple");
   }
+
+  SECTION("Template overloads accept callables that are not std::function")
+  {
+    // A move-only generator, which std::function could not hold.
+    auto const long_inputs = generate_strings(100);
+    auto gen = [it = std::make_unique<std::size_t>(0), &long_inputs]() mutable
+      -> std::optional<std::string_view> {
+      if (*it == long_inputs.size()) {
+        return std::nullopt;
+      }
+      return long_inputs[(*it)++];
+    };
+
+    auto seen  = std::unordered_map<std::string_view, std::uint64_t>{};
+    auto dedup = [&seen](std::string_view s) {
+      auto [it, inserted] = seen.emplace(s, seen.size());
+      return std::pair<std::uint64_t, bool>{it->second, inserted};
+    };
+
+    auto keys = std::vector<fsst_key>{};
+    auto dict = StringDict::build(
+      std::move(gen), dedup, [&keys](fsst_key k) { keys.push_back(k); });
+
+    REQUIRE(keys.size() == long_inputs.size());
+    for (auto i = std::size_t{0}; i < long_inputs.size(); ++i) {
+      CHECK(dict[keys[i]] == long_inputs[i]);
+    }
+  }
+
+  SECTION("Template overloads buffer generators that return strings")
+  {
+    auto i   = std::size_t{0};
+    auto gen = [&]() -> std::optional<std::string> {
+      if (i == inputs.size()) {
+        return std::nullopt;
+      }
+      return inputs[i++] + "_suffix";
+    };
+
+    auto [dict, keys] = StringDict::build_from_unique(gen);
+    REQUIRE(keys.size() == 5);
+    CHECK(*dict[keys[3]] == "cherry_suffix");
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -244,6 +320,40 @@ TEST_CASE("fsst_dictionary configuration", "[fsst][config]")
   }
 }
 
+TEST_CASE("fsst_dictionary parallel build", "[fsst][config]")
+{
+  auto       inputs  = generate_strings(50'000);
+  auto const repeats = generate_strings(10'000);
+  inputs.insert(inputs.end(), repeats.begin(), repeats.end());
+
+  auto const ratio = fsst_dictionary_base::sample_ratio{1.0f};
+
+  SECTION("Deduplicated keys span several chunks")
+  {
+    auto [dict, keys] = StringDict::build(
+      inputs, make_dedup(), ratio, fsst_dictionary_base::thread_count{4});
+
+    REQUIRE(keys.size() == inputs.size());
+    for (auto i = std::size_t{0}; i < inputs.size(); ++i) {
+      REQUIRE(dict[keys[i]] == inputs[i]);
+    }
+    for (auto i = std::size_t{0}; i < 10'000; ++i) {
+      REQUIRE(keys[50'000 + i] == keys[i]);
+    }
+  }
+
+  SECTION("Hardware concurrency")
+  {
+    auto [dict, keys] = StringDict::build_from_unique(
+      inputs, ratio, fsst_dictionary_base::thread_count{0});
+
+    REQUIRE(keys.size() == inputs.size());
+    for (auto i = std::size_t{0}; i < inputs.size(); ++i) {
+      REQUIRE(dict[keys[i]] == inputs[i]);
+    }
+  }
+}
+
 // -----------------------------------------------------------------------------
 // 6. Rule of Five & Lifecycle
 // -----------------------------------------------------------------------------
@@ -362,3 +472,287 @@ TEST_CASE("fsst_dictionary try_find API", "[fsst][lookup]")
     CHECK(buffer == "apple");
   }
 }
+
+TEST_CASE("fsst_dictionary try_find_many API", "[fsst][lookup]")
+{
+  auto const inputs = generate_strings(10'000);
+  auto [dict, keys] = StringDict::build_from_unique(inputs);
+
+  SECTION("Every key is reported once with its index")
+  {
+    auto results = std::vector<std::string>(keys.size());
+    auto calls   = std::size_t{0};
+
+    auto const found =
+      try_find_many(dict, keys, [&](std::size_t i, std::string_view value) {
+        results[i] = value;
+        ++calls;
+      });
+
+    CHECK(found == keys.size());
+    CHECK(calls == keys.size());
+    CHECK(results == inputs);
+  }
+
+  SECTION("Keys that are not found are skipped")
+  {
+    auto batch = std::vector<fsst_key>{keys[42],
+      fsst_key{0x0000'0000'FFFF'FFFF},
+      fsst_dictionary_base::make_inline_key("tiny"),
+      keys[9'999]};
+
+    auto results = std::vector<std::pair<std::size_t, std::string>>{};
+    auto const found =
+      try_find_many(dict, batch, [&](std::size_t i, std::string_view value) {
+        results.emplace_back(i, value);
+      });
+
+    std::ranges::sort(results);
+    CHECK(found == 3);
+    CHECK(results
+      == std::vector<std::pair<std::size_t, std::string>>{
+        {0, inputs[42]}, {2, "tiny"}, {3, inputs[9'999]}});
+  }
+
+  SECTION("Empty dictionary and empty batch")
+  {
+    // Only the inline keys can be resolved without the dictionary.
+    auto const empty = StringDict{};
+    auto const found =
+      try_find_many(empty, keys, [](std::size_t, std::string_view) {});
+    CHECK(found
+      == static_cast<std::size_t>(std::ranges::count_if(
+        inputs, &fsst_dictionary_base::is_inline_candidate)));
+    CHECK(try_find_many(dict,
+            std::span<fsst_key const>{},
+            [](std::size_t, std::string_view) {})
+      == 0);
+  }
+}
+
+TEST_CASE("fsst_dictionary persistence", "[fsst][file]")
+{
+  auto const inputs = generate_strings(5'000);
+  auto const path =
+    std::filesystem::temp_directory_path() / "vault.fsst_dictionary.test.fsst";
+
+  SECTION("Keys stay valid for the mapped dictionary")
+  {
+    auto keys = std::vector<fsst_key>{};
+    {
+      auto [dict, built_keys] = StringDict::build(inputs, make_dedup());
+      dict.save(path);
+      keys = std::move(built_keys);
+    }
+
+    auto const mapped = StringDict::open_mapped(path);
+    CHECK_FALSE(mapped.empty());
+
+    REQUIRE(keys.size() == inputs.size());
+    for (auto i = std::size_t{0}; i < inputs.size(); ++i) {
+      REQUIRE(mapped[keys[i]] == inputs[i]);
+    }
+
+    auto const found = try_find_many(
+      mapped, keys, [&](std::size_t i, std::string_view value) {
+        CHECK(value == inputs[i]);
+      });
+    CHECK(found == inputs.size());
+  }
+
+  SECTION("A mapped dictionary can be saved again")
+  {
+    auto [dict, keys] = StringDict::build_from_unique(inputs);
+    dict.save(path);
+
+    auto const copy = std::filesystem::temp_directory_path()
+      / "vault.fsst_dictionary.copy.fsst";
+    StringDict::open_mapped(path).save(copy);
+
+    auto const mapped = StringDict::open_mapped(copy);
+    CHECK(mapped.size_in_bytes() == dict.size_in_bytes());
+    CHECK(mapped[keys.back()] == inputs.back());
+    std::filesystem::remove(copy);
+  }
+
+  SECTION("Empty dictionary")
+  {
+    StringDict{}.save(path);
+    auto const mapped = StringDict::open_mapped(path);
+    CHECK(mapped.empty());
+    CHECK(mapped[fsst_dictionary_base::make_inline_key("tiny")] == "tiny");
+  }
+
+  SECTION("Bad magic throws")
+  {
+    StringDict{}.save(path);
+    {
+      auto file =
+        std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+      file.write("NOTFSST!", 8);
+    }
+    CHECK_THROWS_AS(StringDict::open_mapped(path), std::runtime_error);
+  }
+
+  SECTION("Missing file throws")
+  {
+    CHECK_THROWS_AS(
+      StringDict::open_mapped(path / "missing"), std::system_error);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("fsst_dictionary streaming build", "[fsst][build]")
+{
+  auto       inputs  = generate_strings(20'000);
+  auto const repeats = generate_strings(2'000);
+  inputs.insert(inputs.end(), repeats.begin(), repeats.end());
+
+  SECTION("build_streaming() deduplicates across the stream")
+  {
+    auto keys = std::vector<fsst_key>{};
+    auto dict = StringDict::build_streaming(make_passes(inputs),
+      make_owning_dedup(),
+      [&keys](fsst_key k) { keys.push_back(k); },
+      fsst_dictionary_base::reservoir_size{512});
+
+    REQUIRE(keys.size() == inputs.size());
+    for (auto i = std::size_t{0}; i < inputs.size(); ++i) {
+      REQUIRE(dict[keys[i]] == inputs[i]);
+    }
+    for (auto i = std::size_t{0}; i < repeats.size(); ++i) {
+      REQUIRE(keys[20'000 + i] == keys[i]);
+    }
+  }
+
+  SECTION("build_from_unique_streaming() compresses every string")
+  {
+    auto keys = std::vector<fsst_key>{};
+    auto dict = StringDict::build_from_unique_streaming(
+      make_passes(inputs), [&keys](fsst_key k) { keys.push_back(k); });
+
+    REQUIRE(keys.size() == inputs.size());
+    for (auto i = std::size_t{0}; i < inputs.size(); ++i) {
+      REQUIRE(dict[keys[i]] == inputs[i]);
+    }
+    CHECK(keys[20'000 + 1'999] != keys[1'999]);
+  }
+
+  SECTION("Template overloads accept callables that are not std::function")
+  {
+    // Passes that yield views, and a move-only sink.
+    auto const passes = [&inputs] {
+      return [it = inputs.begin(), end = inputs.end()]() mutable
+        -> std::optional<std::string_view> {
+        if (it == end) {
+          return std::nullopt;
+        }
+        return *it++;
+      };
+    };
+
+    auto seen  = std::unordered_map<std::string, std::uint64_t>{};
+    auto dedup = [&seen](std::string_view s) {
+      auto [it, inserted] = seen.emplace(s, seen.size());
+      return std::pair<std::uint64_t, bool>{it->second, inserted};
+    };
+
+    auto keys = std::vector<fsst_key>{};
+    auto dict = StringDict::build_streaming(passes,
+      dedup,
+      [&keys, owner = std::make_unique<int>()](
+        fsst_key k) { keys.push_back(k); },
+      fsst_dictionary_base::reservoir_size{512});
+
+    REQUIRE(keys.size() == inputs.size());
+    for (auto i = std::size_t{0}; i < inputs.size(); ++i) {
+      REQUIRE(dict[keys[i]] == inputs[i]);
+    }
+    CHECK(keys[20'000 + 1'999] == keys[1'999]);
+
+    auto unique_keys = std::vector<fsst_key>{};
+    auto unique      = StringDict::build_from_unique_streaming(
+      passes, [&unique_keys](fsst_key k) { unique_keys.push_back(k); });
+
+    REQUIRE(unique_keys.size() == inputs.size());
+    CHECK(unique[unique_keys.back()] == inputs.back());
+  }
+
+  SECTION("Only inline strings")
+  {
+    auto const tiny = std::vector<std::string>{"a", "bb", "ccc"};
+    auto       keys = std::vector<fsst_key>{};
+    auto       dict = StringDict::build_from_unique_streaming(
+      make_passes(tiny), [&keys](fsst_key k) { keys.push_back(k); });
+
+    CHECK(dict.empty());
+    REQUIRE(keys.size() == 3);
+    CHECK(dict[keys[2]] == "ccc");
+  }
+}
+
+TEST_CASE("fsst_dictionary compressed-domain comparison", "[fsst][probe]")
+{
+  auto inputs = generate_strings(2'000);
+  inputs.insert(inputs.end(),
+    {"apple", "apple pie", "apple pie with cream", "banana", "entr", "en", "",
+      "entry_", "entry_12", "xentry_12", std::string{"entry\0_1", 8}});
+
+  auto [dict, keys] = StringDict::build_from_unique(inputs);
+  REQUIRE(keys.size() == inputs.size());
+
+  auto const queries = std::vector<std::string>{"entry_1", "entry_12",
+    "entry_123", "entry_1999", "entr", "en", "e", "", "apple pie",
+    "apple pie with", "banana", "x", "entry_\xff", std::string{"entry\0", 6}};
+
+  auto check_all = [&](StringDict const& d, auto make_probe) {
+    for (auto const& query : queries) {
+      auto const probe = make_probe(query);
+      CHECK(probe.text() == query);
+      for (auto i = std::size_t{0}; i < inputs.size(); ++i) {
+        auto const& value = inputs[i];
+        REQUIRE(d.equals(keys[i], probe) == (value == query));
+        REQUIRE(d.starts_with(keys[i], probe) == value.starts_with(query));
+      }
+    }
+  };
+
+  SECTION("Probes compressed by the same dictionary")
+  {
+    check_all(dict, [&](std::string const& q) {
+      return dict.compress_probe(q);
+    });
+  }
+
+  SECTION("Probes from another dictionary fall back to decoding")
+  {
+    auto const [other, other_keys] =
+      StringDict::build_from_unique(generate_strings(10));
+    check_all(dict, [&](std::string const& q) {
+      return other.compress_probe(q);
+    });
+  }
+
+  SECTION("A mapped dictionary compares by decoding")
+  {
+    auto const path = std::filesystem::temp_directory_path()
+      / "vault.fsst_dictionary.probe.fsst";
+    dict.save(path);
+
+    auto const mapped = StringDict::open_mapped(path);
+    check_all(mapped, [&](std::string const& q) {
+      return mapped.compress_probe(q);
+    });
+  }
+
+  SECTION("Keys that are not found compare false")
+  {
+    auto const empty_dict = StringDict{};
+    auto const probe      = dict.compress_probe("entry_1000");
+    CHECK_FALSE(empty_dict.equals(keys[1000], probe));
+    CHECK_FALSE(empty_dict.starts_with(keys[1000], probe));
+    CHECK(empty_dict.starts_with(
+      StringDict::make_inline_key("abc"), empty_dict.compress_probe("ab")));
+  }
+}
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+#include <catch2/catch_test_macros.hpp>
+#include <vault/algorithm/fsst_segmented_dictionary.hpp>
+#include <vault/executor/thread_executor.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace vault::algorithm;
+
+using StringDict          = fsst_dictionary<std::string>;
+using SegmentedStringDict = fsst_segmented_dictionary<std::string>;
+
+namespace {
+  auto generate_strings(std::string const& prefix, std::size_t count)
+    -> std::vector<std::string>
+  {
+    auto result = std::vector<std::string>{};
+    result.reserve(count);
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      result.push_back(prefix + std::to_string(i));
+    }
+    return result;
+  }
+} // namespace
+
+TEST_CASE("fsst_segmented_dictionary lookups", "[fsst][segments]")
+{
+  auto const urls  = generate_strings("https://example.com/item/", 2'000);
+  auto const words = generate_strings("entry_", 2'000);
+
+  auto dict = SegmentedStringDict{};
+  CHECK(dict.empty());
+  CHECK(dict.segment_count() == 0);
+
+  auto [url_segment, url_keys]   = StringDict::build_from_unique(urls);
+  auto [word_segment, word_keys] = StringDict::build_from_unique(words);
+
+  CHECK(dict.append(std::move(url_segment), url_keys) == 0);
+  CHECK(dict.append(std::move(word_segment), word_keys) == 1);
+  CHECK(dict.segment_count() == 2);
+  CHECK_FALSE(dict.empty());
+
+  SECTION("Keys of every segment resolve to their values")
+  {
+    for (auto i = std::size_t{0}; i < urls.size(); ++i) {
+      REQUIRE(dict[url_keys[i]] == urls[i]);
+      REQUIRE(dict[word_keys[i]] == words[i]);
+    }
+  }
+
+  SECTION("Appending keeps earlier keys valid")
+  {
+    auto const more      = generate_strings("appended_", 500);
+    auto [segment, keys] = StringDict::build_from_unique(more);
+    CHECK(dict.append(std::move(segment), keys) == 2);
+
+    for (auto i = std::size_t{0}; i < more.size(); ++i) {
+      REQUIRE(dict[keys[i]] == more[i]);
+    }
+    for (auto i = std::size_t{0}; i < urls.size(); ++i) {
+      REQUIRE(dict[url_keys[i]] == urls[i]);
+    }
+  }
+
+  SECTION("Inline keys are unchanged")
+  {
+    CHECK(word_keys[0] == StringDict::make_inline_key("entry_0"));
+    CHECK(dict[StringDict::make_inline_key("abc")] == "abc");
+  }
+
+  SECTION("Keys of a missing segment are not found")
+  {
+    auto other           = SegmentedStringDict{};
+    auto [segment, keys] = StringDict::build_from_unique(urls);
+    other.append(std::move(segment), keys);
+
+    CHECK_FALSE(other[word_keys.back()].has_value());
+    CHECK(other[keys.back()] == urls.back());
+  }
+
+  SECTION("size_in_bytes sums the segments")
+  {
+    CHECK(dict.size_in_bytes()
+      == dict.segment(0).size_in_bytes() + dict.segment(1).size_in_bytes());
+  }
+}
+
+TEST_CASE("fsst_segmented_dictionary parallel segments", "[fsst][segments]")
+{
+  constexpr auto segment_count = std::size_t{8};
+
+  auto inputs = std::vector<std::vector<std::string>>{};
+  for (auto s = std::size_t{0}; s < segment_count; ++s) {
+    inputs.push_back(
+      generate_strings("segment_" + std::to_string(s) + "_value_", 1'000));
+  }
+
+  auto segments = std::vector<StringDict>(segment_count);
+  auto keys     = std::vector<std::vector<fsst_key>>(segment_count);
+
+  thread_executor{4}(segment_count,
+    1,
+    [&](std::size_t, std::size_t first, std::size_t last) {
+      for (auto s = first; s < last; ++s) {
+        std::tie(segments[s], keys[s]) =
+          StringDict::build_from_unique(inputs[s]);
+      }
+    });
+
+  auto dict = SegmentedStringDict{};
+  for (auto s = std::size_t{0}; s < segment_count; ++s) {
+    dict.append(std::move(segments[s]), keys[s]);
+  }
+
+  for (auto s = std::size_t{0}; s < segment_count; ++s) {
+    for (auto i = std::size_t{0}; i < inputs[s].size(); ++i) {
+      REQUIRE(dict[keys[s][i]] == inputs[s][i]);
+    }
+  }
+}
+
+TEST_CASE("fsst_segmented_dictionary limits", "[fsst][segments]")
+{
+  auto dict = SegmentedStringDict{};
+  auto keys = std::vector<fsst_key>{};
+
+  for (auto s = std::size_t{0}; s < SegmentedStringDict::max_segments; ++s) {
+    dict.append(StringDict{}, keys);
+  }
+
+  CHECK_THROWS_AS(dict.append(StringDict{}, keys), std::length_error);
+}
@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <vault/algorithm/proxy_sort.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+  // Strings over a small alphabet that includes the zero byte, so that
+  // proxies collide often and padding is indistinguishable from data.
+  // Every string starts with `prefix`, so that runs of equal proxies are
+  // refined on later bytes.
+  auto random_strings(std::size_t count,
+    std::size_t                   max_length,
+    std::string_view              prefix = {}) -> std::vector<std::string>
+  {
+    auto rng     = std::mt19937{42};
+    auto result  = std::vector<std::string>{};
+    auto symbols = std::string_view{"ab\0\xff", 4};
+    result.reserve(count);
+    for (auto i = std::size_t{0}; i < count; ++i) {
+      auto s = std::string(rng() % (max_length + 1), 'a');
+      for (auto& c : s) {
+        c = symbols[rng() % symbols.size()];
+      }
+      result.push_back(std::string{prefix} + s);
+    }
+    return result;
+  }
+
+} // namespace
+
+TEST_CASE("proxy_sort: string_proxy orders like the strings",
+  "[proxy_sort]")
+{
+  using vault::algorithm::string_proxy;
+
+  REQUIRE(string_proxy("") == 0);
+  REQUIRE(string_proxy("a") < string_proxy("b"));
+  REQUIRE(string_proxy("abcdefgh") == string_proxy("abcdefghij"));
+  REQUIRE(string_proxy("\xff") > string_proxy("a"));
+  REQUIRE(string_proxy("ab") == string_proxy(std::string_view{"ab\0", 3}));
+}
+
+TEST_CASE("proxy_sort: Sorts Like std::stable_sort", "[proxy_sort]")
+{
+  auto const count      = GENERATE(std::size_t{0}, 1, 100, 255, 256, 5000);
+  auto const max_length = GENERATE(std::size_t{3}, 12, 40);
+  auto const prefix     = GENERATE(std::string_view{},
+    std::string_view{"shared_prefix_of_20_"},
+    std::string_view{"ab\0\0\0\0\0\0\0\0\0\0", 12});
+
+  auto const strings = random_strings(count, max_length, prefix);
+
+  SECTION("Strings")
+  {
+    auto sorted   = strings;
+    auto expected = strings;
+    std::ranges::stable_sort(expected);
+
+    vault::algorithm::proxy_sort(sorted);
+    REQUIRE(sorted == expected);
+  }
+
+  SECTION("Key-Value Pairs Are Stable")
+  {
+    auto pairs = std::vector<std::pair<std::string_view, std::size_t>>{};
+    for (auto i = std::size_t{0}; i < strings.size(); ++i) {
+      pairs.emplace_back(strings[i], i);
+    }
+
+    auto expected = pairs;
+    std::ranges::stable_sort(expected, {}, &decltype(pairs)::value_type::first);
+
+    auto const end = vault::algorithm::proxy_sort(
+      pairs, &decltype(pairs)::value_type::first);
+    REQUIRE(end == pairs.end());
+    REQUIRE(pairs == expected);
+  }
+
+  SECTION("Move-Only Payloads and Keys Projected by Value")
+  {
+    auto items = std::vector<std::unique_ptr<std::string>>{};
+    for (auto const& s : strings) {
+      items.push_back(std::make_unique<std::string>(s));
+    }
+
+    vault::algorithm::proxy_sort(
+      items, [](auto const& item) { return std::string(*item); });
+
+    auto expected = strings;
+    std::ranges::stable_sort(expected);
+    REQUIRE(std::ranges::equal(
+      items, expected, {}, [](auto const& item) { return *item; }));
+  }
+}
+
+TEST_CASE("proxy_sort: Zipped Keys and Values", "[proxy_sort]")
+{
+  auto keys   = random_strings(1000, 20);
+  auto values = std::vector<std::size_t>(keys.size());
+  for (auto i = std::size_t{0}; i < values.size(); ++i) {
+    values[i] = i;
+  }
+
+  auto const original = keys;
+  auto       zipped   = std::views::zip(keys, values);
+  vault::algorithm::proxy_sort(
+    zipped, [](auto const& kv) -> std::string const& { return std::get<0>(kv); });
+
+  REQUIRE(std::ranges::is_sorted(keys));
+  for (auto i = std::size_t{0}; i < keys.size(); ++i) {
+    REQUIRE(original[values[i]] == keys[i]);
+  }
+}
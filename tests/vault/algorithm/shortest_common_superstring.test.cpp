@@ -5,23 +5,44 @@
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <deque>
+#include <filesystem>
 #include <forward_list>
+#include <fstream>
+#include <functional>
 #include <iterator>
 #include <list>
+#include <memory_resource>
+#include <random>
 #include <ranges>
 #include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <vault/algorithm/internal.hpp>
+#include <vault/frozen_vector/frozen_vector_builder.hpp>
 
+#include <vault/algorithm/aho_corasick_automaton.hpp>
 #include <vault/algorithm/knuth_morris_pratt_failure_function.hpp>
 #include <vault/algorithm/knuth_morris_pratt_overlap.hpp>
 #include <vault/algorithm/knuth_morris_pratt_searcher.hpp>
+#include <vault/algorithm/overlap_graph.hpp>
+#include <vault/algorithm/sharded_shortest_common_superstring.hpp>
 #include <vault/algorithm/shortest_common_superstring.hpp>
+#include <vault/algorithm/superstring_builder.hpp>
+#include <vault/algorithm/superstring_file.hpp>
 
 using namespace std::literals::string_literals;
 using namespace std::literals::string_view_literals;
@@ -129,6 +150,42 @@ TEST_CASE("shortest_common_superstring_integration", "[scs][integration]")
   }
 }
 
+TEST_CASE("shortest_common_superstring_filtering", "[scs][filter]")
+{
+  using subrange_type = std::ranges::subrange<std::vector<char>::iterator>;
+  using bounds_type   = std::vector<subrange_type>;
+
+  SECTION("duplicates_and_substrings")
+  {
+    auto input  = std::vector{"abc"s, "b"s, "xabcx"s, "abc"s, "xabcx"s};
+    auto bounds = bounds_type{};
+
+    auto [in, out, superstring, overlap] =
+      val::shortest_common_superstring(input, std::back_inserter(bounds));
+
+    // Every string but one copy of "xabcx" is removed by the filter and
+    // accounted for in full.
+    CHECK(overlap == 3 + 1 + 3 + 5);
+    CHECK(std::ranges::equal(superstring, "xabcx"sv));
+
+    for (auto i = std::size_t{0}; i < input.size(); ++i) {
+      CHECK(std::ranges::equal(bounds[i], input[i]));
+    }
+  }
+
+  SECTION("duplicates_under_comparator")
+  {
+    auto input  = std::vector{"ABC"s, "abc"s, "Bc"s};
+    auto bounds = bounds_type{};
+
+    auto result = val::shortest_common_superstring(
+      input, std::back_inserter(bounds), case_insensitive_eq{});
+
+    CHECK(result.total_overlap == 3 + 2);
+    CHECK(result.superstring.size() == 3);
+  }
+}
+
 TEST_CASE("shortest_common_superstring_advanced_features", "[scs][advanced]")
 {
 
@@ -190,3 +247,1270 @@ TEST_CASE("shortest_common_superstring_advanced_features", "[scs][advanced]")
     }
   }
 }
+
+TEST_CASE("aho_corasick_automaton", "[aho_corasick]")
+{
+  auto patterns  = std::vector{"he"s, "she"s, "his"s, "hers"s};
+  auto automaton = val::aho_corasick_automaton{patterns};
+
+  CHECK(automaton.pattern_count() == 4);
+
+  for (auto i = std::size_t{0}; i < patterns.size(); ++i) {
+    auto const node = automaton.pattern_node(i);
+    CHECK(automaton.depth(node) == patterns[i].size());
+    CHECK(automaton.terminal(node) == i);
+  }
+
+  // "she" fails to "he", which is itself a pattern.
+  auto const she = automaton.pattern_node(1);
+  CHECK(automaton.failure(she) == automaton.pattern_node(0));
+  CHECK(automaton.dictionary_suffix(she) == automaton.pattern_node(0));
+
+  // Scanning a text reports every occurrence through the dictionary
+  // suffix links.
+  auto matches = std::vector<std::size_t>{};
+  auto state   = automaton.root();
+  for (auto c : "ushers"sv) {
+    state = automaton.transition(state, c);
+    for (auto v = automaton.terminal(state) != automaton.npos
+           ? state
+           : automaton.dictionary_suffix(state);
+      v != automaton.npos;
+      v = automaton.dictionary_suffix(v)) {
+      matches.push_back(automaton.terminal(v));
+    }
+  }
+  std::ranges::sort(matches);
+  CHECK(matches == std::vector<std::size_t>{0, 1, 3});
+}
+
+TEST_CASE("overlap_engines_agree", "[scs][aho_corasick]")
+{
+  auto collect = [](auto const& engine, auto const& strings, auto comp) {
+    auto edges = std::vector<val::overlap_edge>{};
+    engine(strings, comp, std::back_inserter(edges));
+    std::ranges::sort(
+      edges, {}, [](auto const& e) { return std::pair{e.lhs, e.rhs}; });
+    return edges;
+  };
+
+  SECTION("bespoke_set")
+  {
+    auto input = std::vector{"abcab"s, "cabd"s, "bdab"s, "aba"s, "dabc"s};
+
+    auto kmp =
+      collect(val::knuth_morris_pratt_overlap_engine, input, std::equal_to<>{});
+    auto ac = collect(val::aho_corasick_overlap_engine, input, std::equal_to<>{});
+
+    CHECK(!kmp.empty());
+    CHECK(kmp == ac);
+  }
+
+  SECTION("parallel_knuth_morris_pratt")
+  {
+    auto input = vault::internal::random_words_1k()
+      | ::ranges::views::transform(
+        [](auto w) { return std::vector<char>(w, w + std::strlen(w)); })
+      | ::ranges::to<std::vector>();
+
+    auto sequential =
+      collect(val::knuth_morris_pratt_overlap_engine, input, std::equal_to<>{});
+
+    for (auto threads : {1uz, 3uz, 8uz}) {
+      auto parallel =
+        collect(val::parallel_knuth_morris_pratt_overlap_engine{
+                  val::thread_executor{threads}, 7},
+          input,
+          std::equal_to<>{});
+      CHECK(parallel == sequential);
+    }
+  }
+
+  SECTION("case_insensitive")
+  {
+    auto input = std::vector{"FOOba"s, "BArz"s, "rZfo"s};
+
+    auto kmp = collect(
+      val::knuth_morris_pratt_overlap_engine, input, case_insensitive_eq{});
+    auto ac =
+      collect(val::aho_corasick_overlap_engine, input, case_insensitive_eq{});
+
+    CHECK(kmp.size() == 3);
+    CHECK(kmp == ac);
+
+    auto const lower_hash = [](char c) {
+      return std::hash<char>{}(
+        static_cast<char>(std::tolower(static_cast<unsigned char>(c))));
+    };
+    auto kr = collect(val::karp_rabin_overlap_engine{lower_hash},
+      input,
+      case_insensitive_eq{});
+
+    CHECK(kmp == kr);
+  }
+
+  SECTION("karp_rabin")
+  {
+    auto input = vault::internal::random_words_1k()
+      | ::ranges::views::transform(
+        [](auto w) { return std::vector<char>(w, w + std::strlen(w)); })
+      | ::ranges::to<std::vector>();
+
+    // Unlike the Aho-Corasick engine, this one needs no filtering, so
+    // the raw words with their duplicates and substrings are fine.
+    auto kmp =
+      collect(val::knuth_morris_pratt_overlap_engine, input, std::equal_to<>{});
+    auto kr =
+      collect(val::karp_rabin_overlap_engine{}, input, std::equal_to<>{});
+
+    CHECK(kmp == kr);
+  }
+
+  SECTION("min_score")
+  {
+    auto input = vault::internal::random_words_1k()
+      | ::ranges::views::transform(
+        [](auto w) { return std::vector<char>(w, w + std::strlen(w)); })
+      | ::ranges::to<std::vector>();
+
+    auto expected =
+      collect(val::knuth_morris_pratt_overlap_engine, input, std::equal_to<>{});
+    std::erase_if(expected, [](auto const& e) { return e.score < 3; });
+
+    auto collect_bounded = [&](auto const& engine) {
+      auto edges = std::vector<val::overlap_edge>{};
+      engine(input,
+        std::equal_to<>{},
+        std::back_inserter(edges),
+        val::overlap_bounds{.min_score = 3});
+      std::ranges::sort(
+        edges, {}, [](auto const& e) { return std::pair{e.lhs, e.rhs}; });
+      return edges;
+    };
+
+    CHECK(!expected.empty());
+    CHECK(collect_bounded(val::knuth_morris_pratt_overlap_engine) == expected);
+    CHECK(collect_bounded(val::parallel_knuth_morris_pratt_overlap_engine{
+            val::thread_executor{3}, 7})
+      == expected);
+    CHECK(collect_bounded(val::karp_rabin_overlap_engine{}) == expected);
+  }
+}
+
+TEST_CASE("shortest_common_superstring_engines", "[scs][aho_corasick]")
+{
+  using subrange_type = std::ranges::subrange<std::vector<char>::iterator>;
+  using bounds_type   = std::vector<subrange_type>;
+
+  SECTION("empty_range")
+  {
+    auto bounds = bounds_type{};
+    auto input  = std::vector<std::string>{};
+
+    auto result = val::shortest_common_superstring(
+      val::aho_corasick_overlap_engine, input, std::back_inserter(bounds));
+
+    CHECK(result.superstring.empty());
+    CHECK(bounds.empty());
+  }
+
+  SECTION("random_words_10k")
+  {
+    auto words = vault::internal::random_words_1k()
+      | ::ranges::to<std::vector<std::string>>();
+
+    auto bounds = bounds_type{};
+
+    auto [in, out, superstring, overlap] = val::shortest_common_superstring(
+      val::aho_corasick_overlap_engine, words, std::back_inserter(bounds));
+
+    CHECK(overlap == 1636);
+    CHECK(superstring.size() == 4790);
+
+    for (auto i = std::size_t{0}; i < words.size(); ++i) {
+      CHECK(std::ranges::equal(bounds[i], words[i]));
+    }
+  }
+
+  SECTION("karp_rabin")
+  {
+    auto words = vault::internal::random_words_1k()
+      | ::ranges::to<std::vector<std::string>>();
+
+    auto bounds = bounds_type{};
+
+    auto [in, out, superstring, overlap] = val::shortest_common_superstring(
+      val::karp_rabin_overlap_engine{}, words, std::back_inserter(bounds));
+
+    CHECK(overlap == 1636);
+    CHECK(superstring.size() == 4790);
+
+    for (auto i = std::size_t{0}; i < words.size(); ++i) {
+      CHECK(std::ranges::equal(bounds[i], words[i]));
+    }
+  }
+
+  SECTION("parallel_knuth_morris_pratt")
+  {
+    auto words = vault::internal::random_words_1k()
+      | ::ranges::to<std::vector<std::string>>();
+
+    auto bounds = bounds_type{};
+    auto engine =
+      val::parallel_knuth_morris_pratt_overlap_engine{val::thread_executor{4}};
+
+    auto [in, out, superstring, overlap] = val::shortest_common_superstring(
+      engine, words, std::back_inserter(bounds));
+
+    CHECK(overlap == 1636);
+    CHECK(superstring.size() == 4790);
+  }
+
+  SECTION("custom_projection_struct_member")
+  {
+    using int_subrange_type = std::ranges::subrange<std::vector<int>::iterator>;
+    auto input              = std::vector<std::vector<widget>>{
+      {{1, "A"}, {2, "B"}, {3, "C"}}, {{3, "Z"}, {4, "D"}, {5, "E"}}};
+
+    auto bounds = std::vector<int_subrange_type>{};
+
+    auto result =
+      val::shortest_common_superstring(val::aho_corasick_overlap_engine,
+        input,
+        std::back_inserter(bounds),
+        [](const widget& w) { return w.id; });
+
+    CHECK(result.superstring == std::vector{1, 2, 3, 4, 5});
+  }
+}
+
+TEST_CASE("overlap_graphs", "[scs][overlap_graph]")
+{
+  using edges_type = std::vector<val::overlap_edge>;
+
+  SECTION("bucket_queue_pop_order_and_merge")
+  {
+    auto graph = val::bucket_queue_overlap_graph{4,
+      edges_type{
+        {0, 1, 3}, {0, 2, 2}, {1, 2, 3}, {1, 3, 1}, {2, 0, 2}, {2, 3, 2}}};
+
+    CHECK(graph.pop() == val::overlap_edge{0, 1, 3});
+    graph.merge(0, 1);
+
+    // 1 -> 2 and 1 -> 3 now leave the chain headed by 0.
+    CHECK(graph.pop() == val::overlap_edge{0, 2, 3});
+    graph.merge(0, 2);
+
+    // 2 -> 0 would close a cycle and is gone; 2 -> 3 moves to 0.
+    CHECK(graph.pop() == val::overlap_edge{0, 3, 2});
+    graph.merge(0, 3);
+
+    CHECK_FALSE(graph.pop().has_value());
+  }
+
+  SECTION("empty")
+  {
+    auto bucket = val::bucket_queue_overlap_graph{3, edges_type{}};
+    auto multi  = val::multi_index_overlap_graph{3, edges_type{}};
+
+    CHECK_FALSE(bucket.pop().has_value());
+    CHECK_FALSE(multi.pop().has_value());
+  }
+
+  SECTION("multi_index_superstring")
+  {
+    using subrange_type = std::ranges::subrange<std::vector<char>::iterator>;
+
+    auto words = vault::internal::random_words_1k()
+      | ::ranges::to<std::vector<std::string>>();
+
+    auto bounds = std::vector<subrange_type>{};
+    auto scs    = val::basic_greedy_shortest_common_superstring_fn<
+      val::multi_index_overlap_graph>{};
+
+    auto [in, out, superstring, overlap] =
+      scs(val::aho_corasick_overlap_engine, words, std::back_inserter(bounds));
+
+    CHECK(overlap == 1636);
+    CHECK(superstring.size() == 4790);
+
+    for (auto i = std::size_t{0}; i < words.size(); ++i) {
+      CHECK(std::ranges::equal(bounds[i], words[i]));
+    }
+  }
+}
+
+TEST_CASE("pruned_overlap_engine", "[scs][pruning]")
+{
+  using subrange_type = std::ranges::subrange<std::vector<char>::iterator>;
+
+  auto words = vault::internal::random_words_1k()
+    | ::ranges::to<std::vector<std::string>>();
+
+  SECTION("keeps_the_best_edges_per_string")
+  {
+    auto strings = std::vector<std::vector<char>>{
+      {'a', 'b', 'c'}, {'b', 'c', 'd'}, {'c', 'd', 'e'}, {'c', 'x', 'y'}};
+
+    auto all = std::vector<val::overlap_edge>{};
+    val::knuth_morris_pratt_overlap_engine(
+      strings, std::equal_to<>{}, std::back_inserter(all));
+
+    auto engine = val::pruned_overlap_engine{
+      val::knuth_morris_pratt_overlap_engine, val::overlap_pruning{1}};
+
+    auto kept = std::vector<val::overlap_edge>{};
+    engine(strings, std::equal_to<>{}, std::back_inserter(kept));
+
+    // 0 -> 1 (2) and 1 -> 2 (2) are the best out-edges of 0 and 1 and
+    // the best in-edges of 1 and 2; 0 -> 3 (1) is the only in-edge of
+    // 3. 0 -> 2 (1) is neither.
+    std::ranges::sort(kept, {}, [](auto const& e) {
+      return std::pair{e.lhs, e.rhs};
+    });
+
+    CHECK(kept
+      == std::vector<val::overlap_edge>{{0, 1, 2}, {0, 3, 1}, {1, 2, 2}});
+
+    for (auto const& e : kept) {
+      CHECK(std::ranges::find(all, e) != all.end());
+    }
+  }
+
+  SECTION("min_overlap")
+  {
+    auto engine =
+      val::pruned_overlap_engine{val::aho_corasick_overlap_engine,
+        val::overlap_pruning{.min_overlap = 2}};
+
+    auto bounds = std::vector<subrange_type>{};
+
+    auto [in, out, superstring, overlap] = val::shortest_common_superstring(
+      engine, words, std::back_inserter(bounds));
+
+    auto total_length = std::size_t{0};
+    for (auto const& w : words) {
+      total_length += w.size();
+    }
+
+    CHECK(superstring.size() + overlap == total_length);
+
+    for (auto i = std::size_t{0}; i < words.size(); ++i) {
+      CHECK(std::ranges::equal(bounds[i], words[i]));
+    }
+  }
+
+  SECTION("unbounded_is_exact")
+  {
+    auto engine = val::pruned_overlap_engine{val::aho_corasick_overlap_engine};
+
+    auto bounds = std::vector<subrange_type>{};
+
+    auto [in, out, superstring, overlap] = val::shortest_common_superstring(
+      engine, words, std::back_inserter(bounds));
+
+    CHECK(overlap == 1636);
+    CHECK(superstring.size() == 4790);
+  }
+
+  SECTION("top_k_recovers_pruned_neighbours")
+  {
+    for (auto const k : {std::size_t{0}, std::size_t{1}, std::size_t{4}}) {
+      auto engine = val::pruned_overlap_engine{
+        val::aho_corasick_overlap_engine, val::overlap_pruning{k}};
+
+      auto bounds = std::vector<subrange_type>{};
+
+      auto [in, out, superstring, overlap] = val::shortest_common_superstring(
+        engine, words, std::back_inserter(bounds));
+
+      // Refilling from the chain ends keeps merging until no chains
+      // overlap, so a single edge per string already comes close to
+      // the exact result. Without any edges the survivors are simply
+      // concatenated.
+      if (k > 0) {
+        CHECK(superstring.size() < 4790 + 4790 / 10);
+      }
+
+      for (auto i = std::size_t{0}; i < words.size(); ++i) {
+        CHECK(std::ranges::equal(bounds[i], words[i]));
+      }
+    }
+  }
+
+  SECTION("refill_matches_greedy")
+  {
+    // With one edge per string, the refill over the chain ends finds
+    // overlaps from heads onto heads and tails onto tails as well. They
+    // cannot be merged, and must not take the place of the tail-to-head
+    // overlaps that can, or the pruned result falls short of greedy.
+    auto const strings = std::vector<std::string>{
+      "bbab", "abbb", "abaab", "abbaab", "baab"};
+
+    auto exact_bounds  = std::vector<subrange_type>{};
+    auto pruned_bounds = std::vector<subrange_type>{};
+
+    auto const exact = val::shortest_common_superstring(
+      val::knuth_morris_pratt_overlap_engine,
+      strings,
+      std::back_inserter(exact_bounds));
+    auto const pruned = val::shortest_common_superstring(
+      val::pruned_overlap_engine{
+        val::knuth_morris_pratt_overlap_engine, val::overlap_pruning{1}},
+      strings,
+      std::back_inserter(pruned_bounds));
+
+    CHECK(pruned.total_overlap == exact.total_overlap);
+    CHECK(pruned.superstring == exact.superstring);
+
+    for (auto i = std::size_t{0}; i < strings.size(); ++i) {
+      CHECK(std::ranges::equal(pruned_bounds[i], strings[i]));
+    }
+  }
+
+  SECTION("within_budget")
+  {
+    auto const pruning = val::overlap_pruning::within_budget(1000, 1 << 20);
+
+    CHECK(pruning.edges_per_string
+      == (1 << 20) / (2 * val::overlap_pruning::bytes_per_edge * 1000));
+    CHECK(val::overlap_pruning::within_budget(1000, 0).edges_per_string == 1);
+  }
+}
+
+TEST_CASE("superstring_builder", "[scs][builder]")
+{
+  auto words = vault::internal::random_words_1k()
+    | ::ranges::to<std::vector<std::string>>();
+
+  auto total_length = std::size_t{0};
+  for (auto const& w : words) {
+    total_length += w.size();
+  }
+
+  auto check = [&](auto const& builder, auto const& strings) {
+    auto const [superstring, offsets] = builder.materialize();
+
+    REQUIRE(offsets.size() == strings.size());
+    for (auto i = std::size_t{0}; i < strings.size(); ++i) {
+      auto const first = std::ranges::next(superstring.begin(), offsets[i]);
+      CHECK(std::ranges::equal(
+        std::ranges::subrange(first, first + strings[i].size()), strings[i]));
+    }
+
+    return superstring.size();
+  };
+
+  SECTION("empty")
+  {
+    auto builder = val::superstring_builder<char>{};
+    builder.add(std::vector<std::string>{});
+
+    CHECK(builder.materialize().superstring.empty());
+    CHECK(builder.chain_count() == 0);
+  }
+
+  SECTION("batches")
+  {
+    auto builder = val::superstring_builder<char>{};
+
+    CHECK(builder.materialize().superstring.empty());
+
+    builder.add(std::vector<std::string>{"xabc", "abcx"});
+    CHECK(check(builder, std::vector<std::string>{"xabc", "abcx"}) == 5);
+
+    // "abc" is contained, "cxa" joins both ends into one chain.
+    builder.add(std::vector<std::string>{"abc", "cxa"});
+    CHECK(builder.chain_count() == 1);
+    CHECK(builder.materialize().superstring.size() == 6);
+    CHECK(check(builder,
+            std::vector<std::string>{"xabc", "abcx", "abc", "cxa"})
+      == 6);
+  }
+
+  SECTION("one_batch_matches_greedy")
+  {
+    auto builder = val::superstring_builder<char>{};
+    builder.add(words);
+
+    auto const size = check(builder, words);
+
+    CHECK(size + builder.total_overlap() == total_length);
+    CHECK(size < 4790 + 4790 / 20);
+  }
+
+  SECTION("many_batches")
+  {
+    auto builder = val::superstring_builder<char>{};
+
+    for (auto first = std::size_t{0}; first < words.size(); first += 100) {
+      builder.add(std::span{words}.subspan(first, 100));
+    }
+
+    auto const size = check(builder, words);
+
+    CHECK(builder.size() == words.size());
+    CHECK(size + builder.total_overlap() == total_length);
+    CHECK(size < 4790 + 4790 / 5);
+  }
+
+  SECTION("containment")
+  {
+    auto builder = val::superstring_builder<char>{};
+
+    builder.add(std::vector<std::string>{"", "abcd"});
+    CHECK(check(builder, std::vector<std::string>{"", "abcd"}) == 4);
+
+    // Duplicates, strings within the previous batch, within this one,
+    // and within a string that is itself contained.
+    auto const batch =
+      std::vector<std::string>{"bc", "xbcdx", "", "cdx", "bc", "bcd", "abcd"};
+    builder.add(batch);
+
+    auto all = std::vector<std::string>{"", "abcd"};
+    all.insert(all.end(), batch.begin(), batch.end());
+
+    CHECK(check(builder, all) == 9);
+    CHECK(builder.chain_count() == 2);
+    CHECK(builder.total_overlap() + 9 == 23);
+  }
+
+  SECTION("add_is_all_or_nothing")
+  {
+    auto builder = val::superstring_builder<char>{};
+    builder.add(std::vector<std::string>{"xabc", "abcx"});
+
+    auto const before = builder.materialize();
+
+    auto throwing = std::views::iota(0, 3)
+      | std::views::transform([](int i) -> std::string {
+          if (i == 2) {
+            throw std::runtime_error{"batch"};
+          }
+          return i == 0 ? "cxa" : "bcxab";
+        });
+
+    CHECK_THROWS_AS(builder.add(throwing), std::runtime_error);
+
+    auto const after = builder.materialize();
+
+    CHECK(builder.size() == 2);
+    CHECK(builder.chain_count() == 1);
+    CHECK(builder.total_overlap() == 3);
+    CHECK(after.superstring == before.superstring);
+    CHECK(after.offsets == before.offsets);
+
+    builder.add(std::vector<std::string>{"cxa"});
+    CHECK(check(builder, std::vector<std::string>{"xabc", "abcx", "cxa"})
+      == 6);
+  }
+
+  SECTION("comparator")
+  {
+    auto builder = val::superstring_builder<char, case_insensitive_eq>{};
+
+    builder.add(std::vector<std::string>{"HELLO", "loworld"});
+    builder.add(std::vector<std::string>{"hell"});
+
+    auto const [superstring, offsets] = builder.materialize();
+
+    CHECK(superstring.size() == 10);
+    CHECK(offsets == std::vector<std::size_t>{0, 3, 0});
+  }
+}
+
+TEST_CASE("sharded_shortest_common_superstring", "[scs][sharded]")
+{
+  using subrange_type = std::ranges::subrange<std::vector<char>::iterator>;
+
+  auto words = vault::internal::random_words_1k()
+    | ::ranges::to<std::vector<std::string>>();
+
+  SECTION("empty_range")
+  {
+    auto bounds = std::vector<subrange_type>{};
+    auto scs    = val::sharded_shortest_common_superstring{};
+
+    auto result = scs(std::vector<std::string>{}, std::back_inserter(bounds));
+
+    CHECK(result.superstring.empty());
+    CHECK(bounds.empty());
+  }
+
+  SECTION("single_shard_is_exact")
+  {
+    auto bounds = std::vector<subrange_type>{};
+    auto scs    = val::sharded_shortest_common_superstring{
+      val::superstring_sharding{.shard_count = 1}};
+
+    auto [in, out, superstring, overlap] =
+      scs(words, std::back_inserter(bounds));
+
+    CHECK(overlap == 1636);
+    CHECK(superstring.size() == 4790);
+  }
+
+  SECTION("many_shards")
+  {
+    for (auto const shards : {2, 7, 32}) {
+      auto bounds = std::vector<subrange_type>{};
+      auto scs    = val::sharded_shortest_common_superstring{
+        val::superstring_sharding{.shard_count = std::size_t(shards)},
+        val::thread_executor{3},
+        val::aho_corasick_overlap_engine};
+
+      auto [in, out, superstring, overlap] =
+        scs(words, std::back_inserter(bounds));
+
+      REQUIRE(bounds.size() == words.size());
+      for (auto i = std::size_t{0}; i < words.size(); ++i) {
+        CHECK(std::ranges::equal(bounds[i], words[i]));
+      }
+
+      auto total_length = std::size_t{0};
+      for (auto const& w : words) {
+        total_length += w.size();
+      }
+
+      CHECK(superstring.size() + overlap == total_length);
+      CHECK(superstring.size() < 4790 + 4790 / 2);
+    }
+  }
+
+  SECTION("custom_hash")
+  {
+    // A hash that maps every symbol alike, over k-mers of one symbol,
+    // puts every string in one shard, however many there are.
+    auto bounds = std::vector<subrange_type>{};
+    auto scs    = val::sharded_shortest_common_superstring{
+      val::superstring_sharding{.shard_count = 32, .key_length = 1},
+      val::inline_executor{},
+      val::knuth_morris_pratt_overlap_engine,
+      [](char) { return std::size_t{0}; }};
+
+    auto [in, out, superstring, overlap] =
+      scs(words, std::back_inserter(bounds));
+
+    CHECK(overlap == 1636);
+    CHECK(superstring.size() == 4790);
+  }
+
+  SECTION("overlap_across_shards")
+  {
+    // Strings with an 'x' go to one shard and the others to the other,
+    // so "abc" is only found when merging the shard results, at the end
+    // of a shard superstring longer than any input string.
+    auto input  = std::vector<std::string>{"abcyyyy", "xxxxxxxx", "xxxxxabc"};
+    auto bounds = std::vector<subrange_type>{};
+    auto scs    = val::sharded_shortest_common_superstring{
+      val::superstring_sharding{.shard_count = 2, .key_length = 1},
+      val::inline_executor{},
+      val::knuth_morris_pratt_overlap_engine,
+      [](char c) { return std::size_t{c == 'x'}; }};
+
+    auto [in, out, superstring, overlap] =
+      scs(input, std::back_inserter(bounds));
+
+    CHECK(std::string(superstring.begin(), superstring.end())
+      == "xxxxxxxxabcyyyy");
+    CHECK(overlap == 8);
+
+    REQUIRE(bounds.size() == input.size());
+    for (auto i = std::size_t{0}; i < input.size(); ++i) {
+      CHECK(std::ranges::equal(bounds[i], input[i]));
+    }
+  }
+
+  SECTION("custom_comparator_case_insensitive")
+  {
+    auto input  = std::vector<std::string>{"HELLO", "loworld", "WORLDS"};
+    auto bounds = std::vector<subrange_type>{};
+    auto scs    = val::sharded_shortest_common_superstring{
+      val::superstring_sharding{.shard_count = 2}, val::inline_executor{}};
+
+    auto result = scs(input, std::back_inserter(bounds), case_insensitive_eq{});
+
+    for (auto i = std::size_t{0}; i < input.size(); ++i) {
+      CHECK(std::ranges::equal(bounds[i], input[i], case_insensitive_eq{}));
+    }
+  }
+}
+
+TEST_CASE("shortest_common_superstring_offsets", "[scs][offsets]")
+{
+  using subrange_type = std::ranges::subrange<std::vector<char>::iterator>;
+
+  auto words = vault::internal::random_words_1k()
+    | ::ranges::to<std::vector<std::string>>();
+
+  auto bounds = std::vector<subrange_type>{};
+  auto const expected =
+    val::shortest_common_superstring(words, std::back_inserter(bounds));
+
+  SECTION("matches_subranges")
+  {
+    using offset_type = val::superstring_offset<std::uint32_t>;
+
+    auto offsets = std::vector<offset_type>{};
+    auto result =
+      val::shortest_common_superstring(val::aho_corasick_overlap_engine,
+        words,
+        val::superstring_offsets<std::uint32_t>(std::back_inserter(offsets)));
+
+    CHECK(result.superstring == expected.superstring);
+    CHECK(sizeof(offset_type) == 8);
+
+    REQUIRE(offsets.size() == words.size());
+    for (auto i = std::size_t{0}; i < words.size(); ++i) {
+      CHECK(offsets[i].offset
+        == bounds[i].begin() - expected.superstring.begin());
+      CHECK(offsets[i].length == words[i].size());
+    }
+  }
+
+  SECTION("frozen_vector_storage")
+  {
+    using offset_type = val::superstring_offset<std::uint16_t>;
+
+    auto builder = frozen::frozen_vector_builder<offset_type>{};
+    auto result  = val::shortest_common_superstring(words,
+      val::superstring_offsets<std::uint16_t>(std::back_inserter(builder)));
+
+    auto const offsets = std::move(builder).freeze();
+
+    REQUIRE(offsets.size() == words.size());
+    for (auto i = std::size_t{0}; i < words.size(); ++i) {
+      auto const first =
+        std::ranges::next(result.superstring.begin(), offsets[i].offset);
+      CHECK(std::ranges::equal(
+        std::ranges::subrange(first, first + offsets[i].length), words[i]));
+    }
+  }
+
+  SECTION("projection_and_sharding")
+  {
+    auto input = std::vector<std::vector<widget>>{
+      {{1, "A"}, {2, "B"}, {3, "C"}}, {{3, "Z"}, {4, "D"}, {5, "E"}}};
+
+    auto offsets = std::vector<val::superstring_offset<>>{};
+    auto result  = val::shortest_common_superstring(input,
+      val::superstring_offsets<>(std::back_inserter(offsets)),
+      [](const widget& w) { return w.id; });
+
+    CHECK(result.superstring == std::vector{1, 2, 3, 4, 5});
+    CHECK(offsets == std::vector<val::superstring_offset<>>{{0, 3}, {2, 3}});
+
+    auto sharded = std::vector<val::superstring_offset<>>{};
+    auto scs     = val::sharded_shortest_common_superstring{
+      val::superstring_sharding{.shard_count = 4}, val::inline_executor{}};
+    auto shard_result =
+      scs(words, val::superstring_offsets<>(std::back_inserter(sharded)));
+
+    REQUIRE(sharded.size() == words.size());
+    for (auto i = std::size_t{0}; i < words.size(); ++i) {
+      auto const first =
+        std::ranges::next(shard_result.superstring.begin(), sharded[i].offset);
+      CHECK(std::ranges::equal(
+        std::ranges::subrange(first, first + sharded[i].length), words[i]));
+    }
+  }
+}
+
+TEST_CASE("superstring_file", "[scs][file]")
+{
+  auto words = vault::internal::random_words_1k()
+    | ::ranges::to<std::vector<std::string>>();
+
+  auto offsets = std::vector<val::superstring_offset<std::uint32_t>>{};
+  auto const result = val::shortest_common_superstring(
+    words, val::superstring_offsets<std::uint32_t>(std::back_inserter(offsets)));
+
+  auto const path = std::filesystem::temp_directory_path()
+    / "vault.superstring_file.test.scs";
+  val::save_superstring(path, result.superstring, offsets);
+
+  SECTION("round_trip")
+  {
+    auto const table = val::open_mapped_superstring<>(path);
+
+    CHECK(std::ranges::equal(table.superstring, result.superstring));
+    REQUIRE(table.size() == words.size());
+    for (auto i = std::size_t{0}; i < words.size(); ++i) {
+      CHECK(table[i] == words[i]);
+    }
+
+    auto const address = reinterpret_cast<std::uintptr_t>(table.offsets.data());
+    CHECK(address % val::superstring_file_header::alignment == 0);
+  }
+
+  SECTION("outlives_copies")
+  {
+    auto superstring = val::open_mapped_superstring<>(path).superstring;
+    CHECK(std::ranges::equal(superstring, result.superstring));
+  }
+
+  SECTION("width_mismatch")
+  {
+    CHECK_THROWS_AS(
+      val::open_mapped_superstring<std::uint64_t>(path), std::runtime_error);
+  }
+
+  SECTION("bad_magic")
+  {
+    {
+      auto file =
+        std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+      file.write("NOTSCS!!", 8);
+    }
+    CHECK_THROWS_AS(val::open_mapped_superstring<>(path), std::runtime_error);
+  }
+
+  SECTION("corrupt_offset_count")
+  {
+    // So large that the size of the offset table wraps around.
+    {
+      auto const count = std::uint64_t{1} << 62;
+      auto file =
+        std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+      file.seekp(offsetof(val::superstring_file_header, offset_count));
+      file.write(reinterpret_cast<char const*>(&count), sizeof(count));
+    }
+    CHECK_THROWS_AS(val::open_mapped_superstring<>(path), std::runtime_error);
+  }
+
+  SECTION("corrupt_offset")
+  {
+    // The last string, moved to end one byte past the superstring.
+    {
+      auto const last = val::superstring_offset<std::uint32_t>{
+        static_cast<std::uint32_t>(result.superstring.size()) - 1, 2};
+      auto file =
+        std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+      file.seekp(static_cast<std::streamoff>(
+        std::filesystem::file_size(path) - sizeof(last)));
+      file.write(reinterpret_cast<char const*>(&last), sizeof(last));
+    }
+    CHECK_THROWS_AS(val::open_mapped_superstring<>(path), std::runtime_error);
+  }
+
+  SECTION("missing")
+  {
+    CHECK_THROWS_AS(val::open_mapped_superstring<>(path / "missing"),
+      std::system_error);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("knuth_morris_pratt_failure_tables", "[scs][kmp]")
+{
+  auto const patterns =
+    std::vector<std::string>{"ababaca", "", "aaaa", "abcab", "x"};
+
+  SECTION("match_the_failure_function")
+  {
+    auto const tables = val::knuth_morris_pratt_failure_tables{patterns};
+
+    REQUIRE(tables.size() == patterns.size());
+    CHECK(tables.offset(tables.size()) == 17);
+
+    for (auto i = std::size_t{0}; i < patterns.size(); ++i) {
+      CHECK(std::ranges::equal(
+        tables[i], val::knuth_morris_pratt_failure_function(patterns[i])));
+    }
+  }
+
+  SECTION("assign_in_any_order")
+  {
+    auto tables = val::knuth_morris_pratt_failure_tables{
+      patterns | std::views::transform(&std::string::size)};
+
+    for (auto i = patterns.size(); i-- > 0;) {
+      tables.assign(i, patterns[i], case_insensitive_eq{});
+    }
+
+    for (auto i = std::size_t{0}; i < patterns.size(); ++i) {
+      CHECK(std::ranges::equal(
+        tables[i], val::knuth_morris_pratt_failure_function(patterns[i])));
+    }
+  }
+
+  SECTION("compact")
+  {
+    // One pattern per entry width, with periodic tails so that the
+    // entries actually need the width.
+    auto mixed = patterns;
+    mixed.push_back(std::string(256, 'a'));
+    mixed.push_back("b" + std::string(300, 'a'));
+    mixed.push_back(std::string(65536, 'a'));
+    mixed.push_back("x");
+    mixed.push_back(std::string(70000, 'a'));
+    mixed.push_back("ab");
+
+    auto const tables = val::compact_knuth_morris_pratt_failure_tables{mixed};
+
+    REQUIRE(tables.size() == mixed.size());
+    CHECK(tables.offset(0) == 0);
+    CHECK(tables.size_bytes() == tables.offset(tables.size()));
+
+    for (auto i = std::size_t{0}; i < mixed.size(); ++i) {
+      CHECK(tables.offset(i) % (mixed[i].size() <= 256 ? 1 : 2) == 0);
+      CHECK(std::ranges::equal(
+        tables[i], val::knuth_morris_pratt_failure_function(mixed[i])));
+    }
+
+    // The word-sized patterns take one byte per entry, the next one two
+    // bytes after a byte of padding.
+    CHECK(tables.offset(5) == 17);
+    CHECK(tables.offset(6) == 17 + 256 + 1);
+  }
+}
+
+TEST_CASE("shortest_common_superstring_memory_resource", "[scs][pmr]")
+{
+  using bounds_type =
+    std::vector<std::ranges::subrange<std::vector<char>::iterator>>;
+
+  auto words = vault::internal::random_words_1k()
+    | ::ranges::to<std::vector<std::string>>();
+
+  auto buffer   = std::vector<std::byte>(1 << 20);
+  auto arena    = std::pmr::monotonic_buffer_resource{
+    buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+  auto const scs = val::greedy_shortest_common_superstring_fn{&arena};
+
+  CHECK(scs.resource() == &arena);
+
+  auto bounds = bounds_type{};
+  auto [in, out, superstring, overlap] =
+    scs(val::aho_corasick_overlap_engine, words, std::back_inserter(bounds));
+
+  CHECK(overlap == 1636);
+  CHECK(superstring.size() == 4790);
+
+  for (auto i = std::size_t{0}; i < words.size(); ++i) {
+    CHECK(std::ranges::equal(bounds[i], words[i]));
+  }
+}
+
+TEST_CASE("shortest_common_superstring_statistics", "[scs][statistics]")
+{
+  using bounds_type =
+    std::vector<std::ranges::subrange<std::vector<char>::iterator>>;
+
+  auto words = vault::internal::random_words_1k()
+    | ::ranges::to<std::vector<std::string>>();
+
+  auto stats = val::superstring_statistics{};
+  auto const scs =
+    val::greedy_shortest_common_superstring_with_statistics_fn{nullptr, stats};
+
+  CHECK(&scs.statistics() == &stats);
+  CHECK(stats.compression_ratio() == 1.0);
+
+  auto bounds = bounds_type{};
+  auto [in, out, superstring, overlap] =
+    scs(val::aho_corasick_overlap_engine, words, std::back_inserter(bounds));
+
+  auto input_length = std::size_t{0};
+  for (auto const& w : words) {
+    input_length += w.size();
+  }
+
+  CHECK(superstring.size() == 4790);
+  CHECK(stats.strings == words.size());
+  CHECK(stats.removed_strings > 0);
+  CHECK(stats.removed_strings < words.size());
+  CHECK(stats.edges > 0);
+  CHECK(stats.peak_edges == stats.edges);
+  CHECK(stats.allocations > 0);
+  CHECK(stats.input_length == input_length);
+  CHECK(stats.superstring_length == superstring.size());
+  CHECK(stats.input_length - stats.superstring_length == overlap);
+  CHECK(stats.compression_ratio() < 1.0);
+
+  SECTION("accumulates_over_calls")
+  {
+    auto const first = stats;
+
+    bounds.clear();
+    std::ignore =
+      scs(val::aho_corasick_overlap_engine, words, std::back_inserter(bounds));
+
+    CHECK(stats.strings == 2 * first.strings);
+    CHECK(stats.edges == 2 * first.edges);
+    CHECK(stats.peak_edges == first.peak_edges);
+    CHECK(stats.superstring_length == 2 * first.superstring_length);
+    CHECK(stats.compression_ratio() == first.compression_ratio());
+  }
+
+  SECTION("pruning_rounds")
+  {
+    stats = {};
+
+    bounds.clear();
+    std::ignore = scs(val::pruned_overlap_engine{val::aho_corasick_overlap_engine,
+                        val::overlap_pruning{.edges_per_string = 1}},
+      words,
+      std::back_inserter(bounds));
+
+    CHECK(stats.edges >= stats.peak_edges);
+    CHECK(stats.superstring_length >= 4790);
+  }
+
+  SECTION("without_statistics")
+  {
+    using plain_fn = val::greedy_shortest_common_superstring_fn;
+
+    // Nothing but the resource: no statistics to point to.
+    STATIC_REQUIRE(sizeof(plain_fn) == sizeof(std::pmr::memory_resource*));
+    STATIC_REQUIRE_FALSE(std::is_default_constructible_v<
+      val::greedy_shortest_common_superstring_with_statistics_fn>);
+  }
+}
+
+TEST_CASE("knuth_morris_pratt_overlap_bytes", "[scs][kmp]")
+{
+  // A comparator the byte path does not recognize, to get the automaton.
+  auto const generic_eq = [](char a, char b) { return a == b; };
+
+  auto check = [&](std::string const& lhs, std::string const& rhs) {
+    auto const fast    = val::knuth_morris_pratt_overlap(lhs, rhs);
+    auto const generic = val::knuth_morris_pratt_overlap(lhs, rhs, generic_eq);
+
+    CHECK(fast.score == generic.score);
+    CHECK(fast.lhs_first == generic.lhs_first);
+    CHECK(fast.lhs_last == lhs.end());
+    CHECK(fast.rhs_last == generic.rhs_last);
+  };
+
+  SECTION("small_alphabet")
+  {
+    auto rng  = std::mt19937{42};
+    auto len  = std::uniform_int_distribution<std::size_t>{0, 24};
+    auto coin = std::uniform_int_distribution<int>{0, 1};
+
+    auto random_string = [&] {
+      auto s = std::string(len(rng), 'a');
+      for (auto& c : s) {
+        c = coin(rng) != 0 ? 'b' : 'a';
+      }
+      return s;
+    };
+
+    for (auto i = 0; i < 2000; ++i) {
+      check(random_string(), random_string());
+    }
+  }
+
+  SECTION("periodic_inputs_fall_back")
+  {
+    auto const lhs = std::string(200, 'a');
+    auto const rhs = std::string(100, 'a') + "b" + std::string(99, 'a');
+
+    CHECK(val::knuth_morris_pratt_overlap(lhs, rhs).score == 100);
+    check(lhs, rhs);
+    check(rhs, lhs);
+  }
+
+  SECTION("other_byte_types")
+  {
+    auto const lhs = std::vector<std::uint8_t>{1, 2, 3, 4};
+    auto const rhs = std::vector<std::uint8_t>{3, 4, 5};
+
+    CHECK(val::knuth_morris_pratt_overlap(lhs, rhs, std::ranges::equal_to{})
+            .score
+      == 2);
+  }
+}
+
+TEST_CASE("knuth_morris_pratt_searcher_bytes", "[scs][kmp]")
+{
+  // A comparator the byte path does not recognize, to get the automaton.
+  auto const generic_eq = [](char a, char b) { return a == b; };
+
+  auto check = [&](std::string const& text, std::string const& pattern) {
+    auto const [fast_first, fast_last] =
+      val::knuth_morris_pratt_searcher{pattern}(text);
+    auto const [generic_first, generic_last] =
+      val::knuth_morris_pratt_searcher{pattern, generic_eq}(text);
+
+    CHECK(fast_first == generic_first);
+    CHECK(fast_last == generic_last);
+    CHECK(fast_first == std::ranges::search(text, pattern).begin());
+  };
+
+  SECTION("small_alphabet")
+  {
+    auto rng    = std::mt19937{42};
+    auto len    = std::uniform_int_distribution<std::size_t>{0, 6};
+    auto symbol = std::uniform_int_distribution<int>{0, 2};
+
+    auto random_string = [&](std::size_t n) {
+      auto s = std::string(n, 'a');
+      for (auto& c : s) {
+        c = static_cast<char>('a' + symbol(rng));
+      }
+      return s;
+    };
+
+    for (auto i = 0; i < 2000; ++i) {
+      check(random_string(8 * len(rng)), random_string(len(rng)));
+    }
+  }
+
+  SECTION("sparse_first_symbol")
+  {
+    auto const text = std::string(300, '.') + "xy" + std::string(300, '.')
+      + "xyz" + std::string(10, '.');
+
+    check(text, "xyz");
+    check(text, "xy");
+    check(text, "q");
+    check(text, ".x");
+  }
+
+  SECTION("other_byte_types")
+  {
+    auto const text    = std::vector<std::uint8_t>{9, 1, 2, 1, 2, 3, 4};
+    auto const pattern = std::vector<std::uint8_t>{1, 2, 3};
+
+    auto const [first, last] =
+      val::knuth_morris_pratt_searcher{pattern, std::ranges::equal_to{}}(text);
+    CHECK(first == text.begin() + 3);
+    CHECK(last == text.begin() + 6);
+  }
+}
+
+TEST_CASE("knuth_morris_pratt_fixed_size", "[scs][kmp]")
+{
+  SECTION("constant_evaluation")
+  {
+    static_assert(val::knuth_morris_pratt_failure_function("abab"sv)
+      == std::vector{0, 0, 1, 2});
+    static_assert(val::fixed_knuth_morris_pratt_failure_function<6>("aabaab"sv)
+      == std::array{0, 1, 0, 1, 2, 3});
+
+    static constexpr auto searcher = val::knuth_morris_pratt_searcher{"abab"};
+    static_assert(
+      std::same_as<decltype(searcher),
+        val::fixed_knuth_morris_pratt_searcher<std::string_view, 4> const>);
+
+    static constexpr auto text = "abaababab"sv;
+    static_assert(searcher(text).first == text.begin() + 3);
+    static_assert(searcher(text).second == text.begin() + 7);
+
+    static constexpr auto miss = "abbaaba"sv;
+    static_assert(searcher(miss).first == miss.end());
+  }
+
+  SECTION("matches_the_dynamic_searcher")
+  {
+    auto rng    = std::mt19937{7};
+    auto symbol = std::uniform_int_distribution<int>{0, 1};
+
+    auto const pattern = "abbab"s;
+    auto const fixed   = val::fixed_knuth_morris_pratt_searcher<std::string,
+        5,
+        case_insensitive_eq>{pattern, case_insensitive_eq{}};
+    auto const dynamic =
+      val::knuth_morris_pratt_searcher{pattern, case_insensitive_eq{}};
+
+    for (auto i = 0; i < 500; ++i) {
+      auto text = std::string(32, 'a');
+      for (auto& c : text) {
+        c = symbol(rng) != 0 ? 'B' : 'a';
+      }
+
+      CHECK(fixed(text) == dynamic(text));
+    }
+  }
+}
+
+TEST_CASE("knuth_morris_pratt_overlap_bounds", "[scs][kmp]")
+{
+  auto const generic_eq = [](char a, char b) { return a == b; };
+
+  // The longest suffix of lhs that is a prefix of rhs and at most
+  // max_score long, or 0 if that is shorter than min_score.
+  auto brute_force = [](std::string const& lhs,
+                       std::string const& rhs,
+                       val::overlap_bounds bounds) {
+    auto const longest = std::min({lhs.size(),
+      rhs.size(),
+      static_cast<std::size_t>(bounds.max_score)});
+    for (auto l = longest; l > 0; --l) {
+      if (lhs.ends_with(std::string_view{rhs}.substr(0, l))) {
+        return std::cmp_less(l, bounds.min_score) ? 0uz : l;
+      }
+    }
+    return 0uz;
+  };
+
+  auto check = [&](std::string const& lhs,
+                 std::string const& rhs,
+                 val::overlap_bounds bounds) {
+    auto const expected = brute_force(lhs, rhs, bounds);
+    auto const table    = val::knuth_morris_pratt_failure_function(rhs);
+
+    auto const fast = val::knuth_morris_pratt_overlap(lhs, rhs, table, bounds);
+    auto const generic =
+      val::knuth_morris_pratt_overlap(lhs, rhs, table, bounds, generic_eq);
+
+    CHECK(std::cmp_equal(fast.score, expected));
+    CHECK(std::cmp_equal(generic.score, expected));
+    CHECK(fast.lhs_first == lhs.end() - fast.score);
+    CHECK(generic.lhs_first == lhs.end() - generic.score);
+    CHECK(fast.lhs_last == lhs.end());
+    CHECK(generic.lhs_last == lhs.end());
+    CHECK(generic.rhs_last == rhs.begin() + generic.score);
+  };
+
+  SECTION("fixed")
+  {
+    auto const lhs = "xxabcabc"s;
+    auto const rhs = "abcabcd"s;
+
+    check(lhs, rhs, {});
+    check(lhs, rhs, {.max_score = 5});
+    check(lhs, rhs, {.max_score = 3});
+    check(lhs, rhs, {.max_score = 2});
+    check(lhs, rhs, {.min_score = 6});
+    check(lhs, rhs, {.min_score = 7});
+    check(lhs, rhs, {.min_score = 4, .max_score = 5});
+
+    CHECK(val::knuth_morris_pratt_overlap(lhs,
+            rhs,
+            val::knuth_morris_pratt_failure_function(rhs),
+            val::overlap_bounds{.max_score = 5})
+            .score
+      == 3);
+  }
+
+  SECTION("small_alphabet")
+  {
+    auto rng  = std::mt19937{7};
+    auto len  = std::uniform_int_distribution<std::size_t>{0, 24};
+    auto cap  = std::uniform_int_distribution<std::ptrdiff_t>{0, 26};
+    auto coin = std::uniform_int_distribution<int>{0, 1};
+
+    auto random_string = [&] {
+      auto s = std::string(len(rng), 'a');
+      for (auto& c : s) {
+        c = coin(rng) != 0 ? 'b' : 'a';
+      }
+      return s;
+    };
+
+    for (auto i = 0; i < 2000; ++i) {
+      auto const lhs = random_string();
+      auto const rhs = random_string();
+      auto const min = cap(rng);
+      auto const max = cap(rng);
+
+      check(lhs, rhs, {.min_score = min});
+      check(lhs, rhs, {.max_score = max});
+      check(lhs, rhs, {.min_score = min, .max_score = max});
+    }
+  }
+}
@@ -1,11 +1,17 @@
 #include <cstdint>
+#include <cstring>
 #include <string>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
 #include <catch2/matchers/catch_matchers_all.hpp>
 
 #include <vault/allocators/hpallocator.hpp>
+#include <vault/allocators/hugepage_pool.hpp>
+#include <vault/allocators/numa_hpallocator.hpp>
+#include <vault/allocators/recycling_allocator.hpp>
+#include <vault/allocators/stats_allocator.hpp>
 
 using namespace static_data;
 
@@ -159,3 +165,294 @@ TEST_CASE("hpallocator with standard containers", "[allocators][hpallocator][int
     }
   }
 }
+
+TEST_CASE("recycling_allocator reuses freed blocks", "[allocators][recycling_allocator]") {
+  constexpr size_t large = segment_cache::default_min_bytes / sizeof(uint64_t);
+
+  auto                           cache = std::make_shared<segment_cache>(4 * segment_cache::default_min_bytes);
+  recycling_allocator<uint64_t> alloc(cache);
+
+  SECTION("a large block is handed back to an allocation of the same size") {
+    uint64_t* first = alloc.allocate(large);
+    alloc.deallocate(first, large);
+    CHECK(cache->cached_count() == 1);
+    CHECK(cache->cached_bytes() == segment_cache::default_min_bytes);
+
+    uint64_t* again = alloc.allocate(large);
+    CHECK(again == first);
+    CHECK(cache->cached_count() == 0);
+
+    // A different size misses the cache.
+    uint64_t* other = alloc.allocate(2 * large);
+    CHECK(other != first);
+
+    alloc.deallocate(again, large);
+    alloc.deallocate(other, 2 * large);
+    CHECK(cache->cached_count() == 2);
+  }
+
+  SECTION("small blocks bypass the cache") {
+    uint64_t* small = alloc.allocate(16);
+    alloc.deallocate(small, 16);
+    CHECK(cache->cached_count() == 0);
+  }
+
+  SECTION("the capacity evicts the oldest blocks") {
+    std::vector<uint64_t*> blocks;
+    for (int i = 0; i < 6; ++i) {
+      blocks.push_back(alloc.allocate(large));
+    }
+    for (uint64_t* block : blocks) {
+      alloc.deallocate(block, large);
+    }
+    CHECK(cache->cached_count() == 4);
+    CHECK(cache->cached_bytes() == cache->capacity());
+
+    // The most recently freed block comes back first.
+    uint64_t* reused = alloc.allocate(large);
+    CHECK(reused == blocks.back());
+    alloc.deallocate(reused, large);
+
+    cache->trim(segment_cache::default_min_bytes);
+    CHECK(cache->cached_count() == 1);
+    cache->trim();
+    CHECK(cache->cached_bytes() == 0);
+  }
+
+  SECTION("rebound copies share the cache") {
+    recycling_allocator<char> bytes(alloc);
+    CHECK(bytes == alloc);
+    CHECK(bytes.cache() == cache);
+    CHECK(recycling_allocator<uint64_t>() != alloc);
+
+    std::vector<uint64_t, recycling_allocator<uint64_t>> vec(alloc);
+    vec.resize(large);
+    CHECK(vec.get_allocator() == alloc);
+  }
+}
+
+TEST_CASE("hugepage_pool size classes", "[allocators][hugepage_pool]") {
+  constexpr size_t page = hugepage_pool::huge_page_size;
+
+  CHECK(hugepage_pool::size_class(1) == page);
+  CHECK(hugepage_pool::size_class(page) == page);
+  CHECK(hugepage_pool::size_class(page + 1) == 2 * page);
+  CHECK(hugepage_pool::size_class(8 * page) == 8 * page);
+  CHECK(hugepage_pool::size_class(9 * page) == 10 * page);
+  CHECK(hugepage_pool::size_class(11 * page) == 12 * page);
+  CHECK(hugepage_pool::size_class(17 * page) == 20 * page);
+  CHECK(hugepage_pool::size_class(100 * page) == 112 * page);
+
+  // No class wastes more than a quarter of the request.
+  for (size_t pages = 1; pages < 1000; ++pages) {
+    const size_t size = hugepage_pool::size_class(pages * page);
+    REQUIRE(size >= pages * page);
+    REQUIRE(4 * size <= 5 * pages * page);
+  }
+}
+
+TEST_CASE("hugepage_pool recycles freed regions", "[allocators][hugepage_pool][linux]") {
+  constexpr size_t page = hugepage_pool::huge_page_size;
+
+  hugepage_pool pool({.max_pooled_bytes = 4 * page, .populate = true});
+
+  void* first = pool.allocate(page);
+  REQUIRE(first != nullptr);
+  CHECK(reinterpret_cast<std::uintptr_t>(first) % page == 0);
+  std::memset(first, 0xab, page);
+  pool.deallocate(first, page);
+
+  auto stats = pool.stats();
+  CHECK(stats.maps == 1);
+  CHECK(stats.pooled_bytes == page);
+  CHECK(stats.mapped_bytes == page);
+
+  SECTION("a freed region is handed back to its size class") {
+    // 1.5 pages round up to the same class as 2.
+    void* two = pool.allocate(2 * page);
+    pool.deallocate(two, 2 * page);
+    void* again = pool.allocate(page + page / 2);
+    CHECK(again == two);
+
+    void* reused = pool.allocate(page);
+    CHECK(reused == first);
+    CHECK(static_cast<unsigned char*>(reused)[page - 1] == 0xab);
+
+    stats = pool.stats();
+    CHECK(stats.allocations == 4);
+    CHECK(stats.reuses == 2);
+    CHECK(stats.maps == 2);
+    CHECK(stats.pooled_bytes == 0);
+    CHECK(stats.peak_mapped_bytes == 3 * page);
+
+    pool.deallocate(again, page + page / 2);
+    pool.deallocate(reused, page);
+  }
+
+  SECTION("regions freed past the cap are unmapped") {
+    void* large = pool.allocate(4 * page);
+    pool.deallocate(large, 4 * page);
+
+    stats = pool.stats();
+    CHECK(stats.unmaps == 1);
+    CHECK(stats.pooled_bytes == page);
+    CHECK(stats.mapped_bytes == page);
+
+    pool.trim();
+    stats = pool.stats();
+    CHECK(stats.unmaps == 2);
+    CHECK(stats.pooled_bytes == 0);
+    CHECK(stats.mapped_bytes == 0);
+  }
+}
+
+TEST_CASE("pooled_hpallocator with standard containers", "[allocators][hugepage_pool][integration]") {
+  auto pool = std::make_shared<hugepage_pool>();
+
+  const uint64_t* previous = nullptr;
+  for (int round = 0; round < 3; ++round) {
+    std::vector<uint64_t, pooled_hpallocator<uint64_t>> vec(1024 * 1024, uint64_t(round), pooled_hpallocator<uint64_t>(pool));
+    CHECK(vec.back() == uint64_t(round));
+    CHECK(reinterpret_cast<std::uintptr_t>(vec.data()) % hugepage_pool::huge_page_size == 0);
+
+    // Every rebuild after the first reuses the region of the one before.
+    if (previous != nullptr) {
+      CHECK(vec.data() == previous);
+    }
+    previous = vec.data();
+
+    // Small allocations do not reach the pool.
+    std::vector<uint64_t, pooled_hpallocator<uint64_t>> small(16, 0, vec.get_allocator());
+    CHECK(small.get_allocator() == vec.get_allocator());
+  }
+
+  auto stats = pool->stats();
+  CHECK(stats.maps == 1);
+  CHECK(stats.reuses == 2);
+  CHECK(pooled_hpallocator<char>() != pooled_hpallocator<char>(pool));
+}
+
+TEST_CASE("numa_hpallocator placements", "[allocators][numa]") {
+  constexpr size_t large = 4 * hpallocator<std::byte>::huge_page_threshold;
+
+  const auto placement = GENERATE(
+    numa_placement::first_touch(), numa_placement::on_node(0), numa_placement::on_current_node(),
+    numa_placement::interleaved()
+  );
+  numa_hpallocator<std::byte> alloc(placement);
+
+  SECTION("large allocations are huge-page aligned and usable") {
+    std::byte* ptr = alloc.allocate(large);
+    REQUIRE(ptr != nullptr);
+    CHECK(reinterpret_cast<std::uintptr_t>(ptr) % hpallocator<std::byte>::huge_page_threshold == 0);
+    std::memset(ptr, 0x5a, large);
+    CHECK(ptr[large - 1] == std::byte{0x5a});
+
+    // Every host has node 0, so a page bound there is placed there, unless the kernel refuses
+    // NUMA policies altogether.
+    if (placement == numa_placement::on_node(0)) {
+      const int node = numa_node_of(ptr);
+      CHECK((node == 0 || node == -1));
+    }
+    alloc.deallocate(ptr, large);
+  }
+
+  SECTION("small allocations fall back to hpallocator") {
+    std::byte* ptr = alloc.allocate(64);
+    REQUIRE(ptr != nullptr);
+    alloc.deallocate(ptr, 64);
+  }
+}
+
+TEST_CASE("numa_hpallocator with standard containers", "[allocators][numa][integration]") {
+  using alloc_t = numa_hpallocator<uint64_t>;
+
+  std::vector<uint64_t, alloc_t> vec(alloc_t(numa_placement::on_current_node()));
+  vec.resize(1024 * 1024, 7);
+  CHECK(vec.back() == 7);
+  CHECK(vec.get_allocator().placement() == numa_placement::on_current_node());
+
+  // Rebound copies keep the placement.
+  numa_hpallocator<char> bytes(vec.get_allocator());
+  CHECK(bytes.placement().kind() == numa_placement::mode::current_node);
+  CHECK(bytes == vec.get_allocator());
+  CHECK(bytes != numa_hpallocator<char>(numa_placement::on_node(1)));
+  CHECK(current_numa_node() < 1024);
+}
+
+TEST_CASE("stats_allocator counts allocations", "[allocators][stats]") {
+  allocation_stats                 stats;
+  stats_allocator<uint64_t>        alloc(stats);
+  const allocation_snapshot global = global_allocation_stats().snapshot();
+
+  uint64_t* a = alloc.allocate(8);    // 64 bytes, size class 7
+  uint64_t* b = alloc.allocate(1000); // 8000 bytes, size class 13
+  alloc.deallocate(a, 8);
+
+  auto s = stats.snapshot();
+  CHECK(s.allocations == 2);
+  CHECK(s.deallocations == 1);
+  CHECK(s.allocated_bytes == 8064);
+  CHECK(s.live_bytes == 8000);
+  CHECK(s.peak_bytes == 8064);
+  CHECK(s.size_classes[7] == 1);
+  CHECK(s.size_classes[13] == 1);
+  CHECK(s.allocated_huge_page_bytes == 0);
+  CHECK(s.huge_page_coverage() == 0.0);
+
+  // The global statistics record the same allocations.
+  CHECK(global_allocation_stats().snapshot().allocations >= global.allocations + 2);
+
+  SECTION("reset keeps the live bytes") {
+    stats.reset();
+    s = stats.snapshot();
+    CHECK(s.allocations == 0);
+    CHECK(s.allocated_bytes == 0);
+    CHECK(s.live_bytes == 8000);
+    CHECK(s.peak_bytes == 8000);
+  }
+
+  alloc.deallocate(b, 1000);
+  CHECK(stats.snapshot().live_bytes == 0);
+}
+
+TEST_CASE("stats_allocator keeps per-instance statistics apart", "[allocators][stats]") {
+  allocation_stats first;
+  allocation_stats second;
+
+  std::vector<int, stats_allocator<int>> a(100, 0, stats_allocator<int>(first));
+  std::vector<int, stats_allocator<int>> b{stats_allocator<int>(second)};
+  b.resize(10);
+
+  CHECK(first.snapshot().live_bytes == 400);
+  CHECK(second.snapshot().live_bytes == 40);
+  CHECK(a.get_allocator() != b.get_allocator());
+  CHECK(a.get_allocator().stats() == &first);
+  CHECK(stats_allocator<int>().stats() == nullptr);
+
+  // Rebound copies record in the same statistics.
+  stats_allocator<char> bytes(a.get_allocator());
+  CHECK(bytes == a.get_allocator());
+  bytes.deallocate(bytes.allocate(24), 24);
+  CHECK(first.snapshot().allocations == 2);
+}
+
+TEST_CASE("stats_allocator measures huge page coverage", "[allocators][stats][linux]") {
+  allocation_stats                                   stats;
+  stats_allocator<std::byte, hpallocator<std::byte>> alloc(stats);
+
+  constexpr size_t large = 2 * allocation_stats::huge_page_size;
+  std::byte*       ptr   = alloc.allocate(large);
+  std::memset(ptr, 0, large);
+
+  // hpallocator aligns large blocks to huge pages, so they cover them exactly.
+  auto s = stats.snapshot();
+  CHECK(s.allocated_huge_page_bytes == large);
+  CHECK(s.live_huge_page_bytes == large);
+  CHECK(s.huge_page_coverage() == 1.0);
+
+  alloc.deallocate(ptr, large);
+  CHECK(stats.snapshot().live_huge_page_bytes == 0);
+
+  CHECK(allocation_stats::huge_page_bytes(reinterpret_cast<void*>(4096), large) == allocation_stats::huge_page_size);
+}
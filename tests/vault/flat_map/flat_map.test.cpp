@@ -3,19 +3,35 @@
 #include <catch2/generators/catch_generators.hpp>
 
 #include <vault/algorithm/amac.hpp>
+#include <vault/algorithm/amac_sinks.hpp>
+#include <vault/algorithm/parallel_amac.hpp>
+#include <vault/executor/thread_executor.hpp>
 
 #include <vault/flat_map/aliases.hpp>
+#include <vault/flat_map/compressed_btree_keys.hpp>
+#include <vault/flat_map/delta_layout_map.hpp>
 #include <vault/flat_map/eytzinger_layout_policy.hpp>
 #include <vault/flat_map/implicit_btree_layout_policy.hpp>
+#include <vault/flat_map/layout_map_file.hpp>
+#include <vault/flat_map/layout_tuner.hpp>
+#include <vault/flat_map/numa_replicated_map.hpp>
 #include <vault/flat_map/sorted_layout_policy.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <cstdint>
 #include <deque>
+#include <filesystem>
 #include <limits>
+#include <map>
+#include <optional>
 #include <random>
 #include <set>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <type_traits>
 #include <vector>
 
@@ -195,6 +211,107 @@ template <typename MapType> struct MapTestDriver {
     for (auto [nit, mit] : results) {
       check_iterators(mit, map.upper_bound(*nit), *nit, "Batch UpperBound");
     }
+
+    // 4. Batch Find on several threads, with a grain small enough to split
+    // the needles.
+    results.clear();
+    map.batch_find(
+      vault::amac::parallel_coordinator<>{
+        vault::algorithm::thread_executor{4}, 16},
+      needles,
+      std::back_inserter(results));
+    REQUIRE(results.size() == needles.size());
+    for (auto [nit, mit] : results) {
+      check_iterators(mit, map.find(*nit), *nit, "Parallel Batch Find");
+    }
+
+    // 5. Batch Find with an adaptive number of jobs in flight.
+    results.clear();
+    map.batch_find(vault::amac::adaptive_coordinator<>,
+      needles,
+      std::back_inserter(results));
+    REQUIRE(results.size() == needles.size());
+    for (auto [nit, mit] : results) {
+      check_iterators(mit, map.find(*nit), *nit, "Adaptive Batch Find");
+    }
+
+    // 6. Batch Lower Bound in needle order, streamed to the results.
+    results.assign(needles.size(), ResultPair{});
+    {
+      auto stream   = vault::amac::streaming_sink<ResultPair>{results.data()};
+      auto sequence = [&](const ResultPair& result) {
+        return result.first - needles.begin();
+      };
+      auto in_order = vault::amac::reorder_buffer<ResultPair,
+        decltype(sequence),
+        std::reference_wrapper<decltype(stream)>>{sequence, std::ref(stream)};
+
+      map.batch_lower_bound(vault::amac::coordinator<>,
+        needles,
+        vault::amac::sink_iterator(in_order));
+      REQUIRE(stream.size() == needles.size());
+    }
+    for (size_t i = 0; i < results.size(); ++i) {
+      auto [nit, mit] = results[i];
+      CHECK(nit == needles.begin() + static_cast<std::ptrdiff_t>(i));
+      check_iterators(mit, map.lower_bound(*nit), *nit, "Ordered LowerBound");
+    }
+  }
+
+  void verify_sorted_lookups()
+  {
+    using ResultPair = std::pair<typename std::vector<KeyT>::iterator,
+      typename MapType::const_iterator>;
+
+    // Many needles merge with the keys; a few are searched for one by one.
+    for (size_t n_needles : {keys.size() * 2 + 3, size_t{5}}) {
+      auto needles = generate_unique_data<KeyT>(n_needles, 321);
+      if (!keys.empty()) {
+        needles.push_back(keys.front());
+        needles.push_back(keys.back());
+      }
+      std::ranges::sort(needles);
+
+      std::vector<ResultPair> results;
+      map.lower_bound_sorted(needles, std::back_inserter(results));
+
+      REQUIRE(results.size() == needles.size());
+      for (size_t i = 0; i < results.size(); ++i) {
+        auto [nit, mit] = results[i];
+        CHECK(nit == needles.begin() + static_cast<std::ptrdiff_t>(i));
+        check_iterators(mit, map.lower_bound(*nit), *nit, "Sorted LowerBound");
+      }
+    }
+  }
+
+  void verify_range_scans()
+  {
+    using Item = std::pair<KeyT, ValT>;
+
+    std::vector<Item> expected(map.begin(), map.end());
+    std::vector<Item> copied;
+    map.copy_sorted(std::back_inserter(copied));
+    CHECK(copied == expected);
+
+    auto bounds = generate_unique_data<KeyT>(8, 654);
+    for (size_t i = 0; i < std::min<size_t>(keys.size(), 8); ++i) {
+      bounds.push_back(keys[i]);
+    }
+
+    for (const auto& lo : bounds) {
+      for (const auto& hi : bounds) {
+        std::vector<Item> scanned;
+        map.for_each_in_range(lo, hi, [&](const KeyT& k, const ValT& v) {
+          scanned.emplace_back(k, v);
+        });
+
+        std::vector<Item> walked;
+        if (!(hi < lo)) {
+          walked.assign(map.lower_bound(lo), map.lower_bound(hi));
+        }
+        CHECK(scanned == walked);
+      }
+    }
   }
 };
 
@@ -224,6 +341,8 @@ TEMPLATE_TEST_CASE("Layout Map: Correctness",
   }
   SECTION("Single Lookup") { driver.verify_lookups(); }
   SECTION("Batch Operations") { driver.verify_batch_operations(); }
+  SECTION("Sorted Lookup") { driver.verify_sorted_lookups(); }
+  SECTION("Range Scan") { driver.verify_range_scans(); }
 }
 
 TEMPLATE_TEST_CASE("Layout Map: Key Types",
@@ -242,6 +361,57 @@ TEMPLATE_TEST_CASE("Layout Map: Key Types",
   driver.verify_batch_operations();
 }
 
+TEMPLATE_TEST_CASE("Layout Map: String Keys",
+  "[map][types][proxy]",
+  (eytzinger::btree_map<std::string, int>),
+  (eytzinger::eytzinger_map<std::string, int>))
+{
+  size_t                  n = GENERATE(0, 16, 64, 1000);
+  MapTestDriver<TestType> driver(n);
+  driver.verify_lookups();
+  driver.verify_batch_operations();
+
+  SECTION("Shared prefixes")
+  {
+    // Keys that share their first 8 bytes have equal proxies, and are
+    // ordered by the strings themselves.
+    std::vector<std::pair<std::string, int>> input;
+    for (int i = 0; i < 500; ++i) {
+      input.emplace_back("customer/" + std::to_string(i * 3), i);
+      input.emplace_back("cust" + std::to_string(i), i);
+    }
+    input.emplace_back("", 0);
+    input.emplace_back(std::string("cust\0", 5), 0);
+
+    TestType map(input.begin(), input.end());
+
+    std::vector<std::string> sorted;
+    for (const auto& [k, v] : input) {
+      sorted.push_back(k);
+    }
+    std::ranges::sort(sorted);
+
+    auto rank_of = [&](auto it) {
+      return it == map.end()
+        ? sorted.size()
+        : static_cast<size_t>(std::distance(map.begin(), it));
+    };
+
+    for (int i = 0; i < 1600; ++i) {
+      for (const std::string& needle :
+        {"customer/" + std::to_string(i), "cust" + std::to_string(i)}) {
+        auto lb = std::ranges::lower_bound(sorted, needle) - sorted.begin();
+        auto ub = std::ranges::upper_bound(sorted, needle) - sorted.begin();
+        CHECK(rank_of(map.lower_bound(needle)) == static_cast<size_t>(lb));
+        CHECK(rank_of(map.upper_bound(std::string_view{needle}))
+          == static_cast<size_t>(ub));
+        CHECK(
+          map.contains(needle) == std::ranges::binary_search(sorted, needle));
+      }
+    }
+  }
+}
+
 TEMPLATE_TEST_CASE("Layout Map: Deque Storage",
   "[map][deque]",
   (eytzinger::layout_map<int,
@@ -263,6 +433,274 @@ TEMPLATE_TEST_CASE("Layout Map: Deque Storage",
   driver.verify_lookups();
 }
 
+TEMPLATE_TEST_CASE("Layout Map: Parallel Construction",
+  "[map][parallel]",
+  SortedBinary,
+  Eytzinger6,
+  BTree8)
+{
+  using MapType = eytzinger::layout_map<int64_t, int, std::less<>, TestType>;
+
+  // Large enough to split the sort and the permutation across workers.
+  std::vector<std::pair<int64_t, int>> input;
+  for (int i = 0; i < 300000; ++i) {
+    input.emplace_back((static_cast<int64_t>(i) * 7919) % 300000, i);
+  }
+
+  MapType serial(input.begin(), input.end());
+  MapType parallel(
+    vault::algorithm::thread_executor{4}, input.begin(), input.end());
+
+  REQUIRE(parallel.size() == serial.size());
+  CHECK(parallel.unordered_keys() == serial.unordered_keys());
+  CHECK(std::ranges::equal(
+    parallel, serial, [](const auto& a, const auto& b) { return a == b; }));
+}
+
+TEMPLATE_TEST_CASE(
+  "Layout Map: Mapped Files", "[map][file]", SortedBinary, Eytzinger6, BTree8)
+{
+  using MapType = eytzinger::layout_map<int64_t, int, std::less<>, TestType>;
+
+  auto path = std::filesystem::temp_directory_path()
+    / "vault.flat_map.test.layout_map";
+
+  SECTION("The mapped map has the layout and lookups of the saved one")
+  {
+    std::vector<std::pair<int64_t, int>> input;
+    for (int i = 0; i < 10000; ++i) {
+      input.emplace_back(static_cast<int64_t>(i) * 3, i);
+    }
+    MapType map(input.begin(), input.end());
+
+    eytzinger::save_layout_map(path, map);
+    auto mapped = eytzinger::open_mapped_layout_map<MapType>(path);
+
+    REQUIRE(mapped.size() == map.size());
+    CHECK(std::ranges::equal(mapped.unordered_keys(), map.unordered_keys()));
+    CHECK(std::ranges::equal(
+      mapped.unordered_values(), map.unordered_values()));
+
+    for (const auto& [k, v] : input) {
+      auto it = mapped.find(k);
+      REQUIRE(it != mapped.end());
+      CHECK(it->second == map.at(k));
+    }
+    CHECK_FALSE(mapped.contains(int64_t{1}));
+    CHECK(mapped.lower_bound(int64_t{4})->first == 6);
+
+    // The file stays mapped while any copy of the map lives.
+    auto first = std::make_optional(mapped);
+    auto copy  = *first;
+    first.reset();
+    CHECK(copy.contains(int64_t{29997}));
+  }
+
+  SECTION("An empty map")
+  {
+    eytzinger::save_layout_map(path, MapType{});
+    CHECK(eytzinger::open_mapped_layout_map<MapType>(path).empty());
+  }
+
+  SECTION("A file is only opened with its own policy and types")
+  {
+    MapType map{{1, 2}, {3, 4}};
+    eytzinger::save_layout_map(path, map);
+
+    using OtherPolicy = std::conditional_t<std::same_as<TestType, BTree8>,
+      Eytzinger6,
+      BTree8>;
+    using OtherLayout =
+      eytzinger::layout_map<int64_t, int, std::less<>, OtherPolicy>;
+    using OtherValue =
+      eytzinger::layout_map<int64_t, int64_t, std::less<>, TestType>;
+
+    CHECK_THROWS_AS(eytzinger::open_mapped_layout_map<OtherLayout>(path),
+      std::runtime_error);
+    CHECK_THROWS_AS(eytzinger::open_mapped_layout_map<OtherValue>(path),
+      std::runtime_error);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("Delta Layout Map: Updates", "[map][delta]")
+{
+  using MapType = eytzinger::btree_map<int64_t, int>;
+
+  bool background = GENERATE(false, true);
+
+  std::vector<std::pair<int64_t, int>> input;
+  for (int i = 0; i < 2000; ++i) {
+    input.emplace_back(static_cast<int64_t>(i) * 2, i);
+  }
+
+  eytzinger::delta_layout_map<MapType> map(MapType(input.begin(), input.end()),
+    {.merge_threshold = 64, .background_merge = background});
+  std::map<int64_t, int> oracle(input.begin(), input.end());
+
+  std::mt19937_64 rng(7);
+  for (int step = 0; step < 20000; ++step) {
+    auto key = static_cast<int64_t>(rng() % 6000);
+    if (rng() % 3 == 0) {
+      REQUIRE(map.erase(key) == (oracle.erase(key) == 1));
+    } else {
+      auto value = static_cast<int>(rng() % 1000);
+      REQUIRE(map.insert_or_assign(key, value)
+        == oracle.insert_or_assign(key, value).second);
+    }
+
+    auto probe = static_cast<int64_t>(rng() % 6000);
+    auto found = oracle.find(probe);
+    if (found == oracle.end()) {
+      REQUIRE_FALSE(map.contains(probe));
+    } else {
+      REQUIRE(map.at(probe) == found->second);
+    }
+    REQUIRE(map.size() == oracle.size());
+  }
+
+  map.merge();
+  CHECK_FALSE(map.merging());
+  CHECK(map.delta_size() == 0);
+  CHECK(std::ranges::equal(
+    map.base(), oracle, [](auto const& a, auto const& b) {
+      return a.first == b.first && a.second == b.second;
+    }));
+}
+
+namespace {
+  // While fail_copies is set, copying throws on every thread but
+  // test_thread, which fails a background merge and nothing else.
+  std::atomic<bool> fail_copies{false};
+  std::thread::id   test_thread;
+
+  struct flaky_value {
+    int value = 0;
+
+    flaky_value() = default;
+    flaky_value(int v) : value(v) {}
+
+    flaky_value(const flaky_value& other) : value(other.value)
+    {
+      if (fail_copies && std::this_thread::get_id() != test_thread) {
+        throw std::runtime_error("flaky_value: copy failed");
+      }
+    }
+
+    flaky_value(flaky_value&&) noexcept            = default;
+    flaky_value& operator=(const flaky_value&)     = default;
+    flaky_value& operator=(flaky_value&&) noexcept = default;
+  };
+} // namespace
+
+TEST_CASE("Delta Layout Map: Failed background merge", "[map][delta]")
+{
+  using MapType = eytzinger::btree_map<int64_t, flaky_value>;
+
+  std::vector<std::pair<int64_t, flaky_value>> input;
+  for (int i = 0; i < 100; ++i) {
+    input.emplace_back(static_cast<int64_t>(i), i);
+  }
+
+  eytzinger::delta_layout_map<MapType> map(MapType(input.begin(), input.end()),
+    {.merge_threshold = 8, .background_merge = true});
+  std::map<int64_t, int> oracle;
+  for (int i = 0; i < 100; ++i) {
+    oracle.emplace(i, i);
+  }
+
+  // The eighth update starts a merge that fails. Updates go on until one
+  // of them finds it finished and throws, without being applied.
+  test_thread = std::this_thread::get_id();
+  fail_copies = true;
+  auto key    = int64_t{1000};
+  for (bool failed = false; !failed; ++key) {
+    try {
+      map.insert_or_assign(key, static_cast<int>(key));
+      oracle.emplace(key, static_cast<int>(key));
+    } catch (const std::runtime_error&) {
+      failed = true;
+      CHECK_FALSE(map.contains(key));
+    }
+    REQUIRE(map.size() == oracle.size());
+  }
+  fail_copies = false;
+
+  CHECK_FALSE(map.merging());
+  REQUIRE(map.erase(int64_t{1000}));
+  oracle.erase(1000);
+  REQUIRE(map.size() == oracle.size());
+
+  map.merge();
+  CHECK(map.delta_size() == 0);
+  REQUIRE(map.base().size() == oracle.size());
+  for (const auto& [k, v] : oracle) {
+    REQUIRE(map.at(k).value == v);
+  }
+}
+
+TEST_CASE("Layout Map: NUMA Replicas", "[map][numa]")
+{
+  std::vector<std::pair<int64_t, int>> input;
+  for (int i = 0; i < 10000; ++i) {
+    input.emplace_back(static_cast<int64_t>(i) * 3, i);
+  }
+
+  eytzinger::numa_btree_map<int64_t, int> map(
+    eytzinger::numa_btree_map<int64_t, int>::map_type(
+      input.begin(), input.end()));
+
+  REQUIRE(map.replica_count() >= 1);
+  REQUIRE(map.replica_count() == eytzinger::detail::numa_node_count());
+  CHECK(eytzinger::detail::numa_current_node() < map.replica_count());
+
+  for (std::size_t node = 0; node < map.replica_count(); ++node) {
+    const auto& replica = map.replica(node);
+    REQUIRE(replica.size() == input.size());
+    CHECK(std::ranges::equal(replica.unordered_keys(),
+      map.local().unordered_keys()));
+  }
+
+  const auto& local = map.local();
+  for (const auto& [k, v] : input) {
+    REQUIRE(local.contains(k));
+    CHECK(local.at(k) == v);
+  }
+  CHECK_FALSE(local.contains(int64_t{1}));
+}
+
+TEST_CASE("Layout Tuner: Configurations", "[map][tuner]")
+{
+  std::vector<int64_t> keys;
+  for (int64_t i = 0; i < 5000; ++i) {
+    keys.push_back((i * 7919) % 5000);
+  }
+
+  auto results = eytzinger::tune_layout<int64_t>(
+    keys, {.needles = 512, .repetitions = 1});
+
+  // sorted, 7 prefetch distances and 4 block sizes, each with one find per
+  // key and 4 AMAC fanouts.
+  REQUIRE(results.size() == (1 + 7 + 4) * 5);
+  CHECK(std::ranges::is_sorted(
+    results, {}, &eytzinger::layout_config::ns_per_lookup));
+
+  for (const auto& config : results) {
+    CHECK(config.ns_per_lookup > 0);
+    CHECK((config.layout == eytzinger::layout_kind::btree)
+      == (config.block_size != 0));
+    CHECK((config.layout == eytzinger::layout_kind::eytzinger)
+      == (config.prefetch_distance != 0));
+  }
+
+  std::ostringstream line;
+  line << results.front();
+  CHECK(line.str().starts_with("layout="));
+
+  CHECK(eytzinger::tune_layout<int64_t>(std::span<const int64_t>{}).empty());
+}
+
 TEST_CASE("Sorted Layout: Topology Identity", "[layout][topology]")
 {
   using P_K2 = eytzinger::sorted_layout_policy<2>;
@@ -271,3 +709,147 @@ TEST_CASE("Sorted Layout: Topology Identity", "[layout][topology]")
     CHECK(P_K2::sorted_rank_to_index(i, n) == i);
   }
 }
+
+// Each key type gets the block size whose blocks fill one cache line, so
+// every full block goes through the SIMD kernels.
+template <typename T, typename Comp>
+void verify_btree_block_search()
+{
+  using Policy = eytzinger::implicit_btree_layout_policy<64 / sizeof(T)>;
+  using Limits = std::numeric_limits<T>;
+
+  std::mt19937 rng(42);
+  auto random_key = [&] {
+    if constexpr (std::is_floating_point_v<T>) {
+      return std::uniform_real_distribution<T>(-1e6, 1e6)(rng);
+    } else {
+      return static_cast<T>(std::uniform_int_distribution<int64_t>(
+        static_cast<int64_t>(Limits::min()) / 2, Limits::max() / 2)(rng));
+    }
+  };
+
+  size_t n = GENERATE(1, 100, 1000);
+
+  // Duplicates and both extremes, which catch an unsigned comparison that
+  // is done as a signed one.
+  std::vector<T> sorted;
+  for (size_t i = 0; i < n; ++i) {
+    sorted.push_back(random_key());
+  }
+  sorted.push_back(Limits::lowest());
+  sorted.push_back(Limits::max());
+  sorted.push_back(sorted.front());
+  if constexpr (std::is_floating_point_v<T>) {
+    sorted.push_back(-Limits::infinity());
+    sorted.push_back(Limits::infinity());
+    sorted.push_back(T(0));
+  }
+  std::ranges::sort(sorted, Comp{});
+
+  std::vector<T> layout = sorted;
+  Policy::permute(layout);
+
+  std::vector<T> probes = sorted;
+  for (size_t i = 0; i < 200; ++i) {
+    probes.push_back(random_key());
+  }
+  probes.push_back(Limits::lowest());
+  probes.push_back(Limits::max());
+  if constexpr (std::is_floating_point_v<T>) {
+    // -0.0 equals 0.0, and every ordered comparison with NaN is false.
+    probes.push_back(T(-0.0));
+    probes.push_back(Limits::quiet_NaN());
+  }
+
+  auto rank_of = [&](auto it) {
+    return it == layout.end()
+      ? layout.size()
+      : Policy::index_to_sorted_rank(
+        static_cast<size_t>(it - layout.begin()), layout.size());
+  };
+
+  for (T key : probes) {
+    auto lb = std::ranges::lower_bound(sorted, key, Comp{}) - sorted.begin();
+    auto ub = std::ranges::upper_bound(sorted, key, Comp{}) - sorted.begin();
+    REQUIRE(rank_of(Policy::lower_bound(
+              layout.begin(), layout.end(), key, Comp{}))
+      == static_cast<size_t>(lb));
+    REQUIRE(rank_of(Policy::upper_bound(
+              layout.begin(), layout.end(), key, Comp{}))
+      == static_cast<size_t>(ub));
+  }
+}
+
+TEMPLATE_TEST_CASE("BTree Layout: Block Search Kernels",
+  "[layout][btree][simd]",
+  int8_t,
+  uint8_t,
+  int16_t,
+  uint16_t,
+  int32_t,
+  uint32_t,
+  int64_t,
+  uint64_t,
+  float,
+  double)
+{
+  SECTION("Less") { verify_btree_block_search<TestType, std::less<>>(); }
+  SECTION("Greater") { verify_btree_block_search<TestType, std::greater<>>(); }
+}
+
+TEST_CASE("BTree Layout: Kernel Selection", "[layout][btree][simd]")
+{
+  auto const isa = eytzinger::block_search_isa();
+  CHECK((isa == "avx512" || isa == "avx2" || isa == "neon" || isa == "scalar"));
+}
+
+TEMPLATE_TEST_CASE("Compressed BTree Keys: Lookup",
+  "[layout][btree][compressed]",
+  uint8_t,
+  uint16_t,
+  uint32_t)
+{
+  using Keys = eytzinger::compressed_btree_keys<TestType>;
+
+  size_t n = GENERATE(0, 1, 100, 5000);
+
+  // Timestamps a few units apart, with jumps that force some blocks to
+  // keep their keys at full width, and both ends of the key range.
+  std::mt19937_64       rng(7);
+  std::vector<uint64_t> sorted;
+  uint64_t              t = 1'700'000'000'000;
+  for (size_t i = 0; i < n; ++i) {
+    t += (i % 97 == 0) ? (rng() >> 20) : (rng() % 3);
+    sorted.push_back(t);
+  }
+  if (n > 0) {
+    sorted.front() = 0;
+    sorted.back()  = std::numeric_limits<uint64_t>::max();
+  }
+
+  auto keys = Keys::build(sorted);
+  REQUIRE(keys.size() == sorted.size());
+
+  for (size_t i = 0; i < sorted.size(); ++i) {
+    REQUIRE(keys[i] == sorted[i]);
+  }
+
+  std::vector<uint64_t> probes = sorted;
+  for (size_t i = 0; i < 500; ++i) {
+    probes.push_back(sorted.empty() ? rng() : sorted[rng() % n] + 1);
+  }
+  probes.push_back(0);
+  probes.push_back(std::numeric_limits<uint64_t>::max());
+
+  for (uint64_t key : probes) {
+    auto lb = std::ranges::lower_bound(sorted, key) - sorted.begin();
+    auto ub = std::ranges::upper_bound(sorted, key) - sorted.begin();
+    REQUIRE(keys.lower_bound(key) == static_cast<size_t>(lb));
+    REQUIRE(keys.upper_bound(key) == static_cast<size_t>(ub));
+    REQUIRE(keys.contains(key) == std::ranges::binary_search(sorted, key));
+  }
+
+  if (n == 5000) {
+    CHECK(keys.memory_usage_bytes() < n * sizeof(uint64_t));
+  }
+}
@@ -3,6 +3,17 @@
  * @brief Comprehensive tests for table functionality, policies, and
  * transitive resolution.
  */
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <thread>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -97,6 +108,24 @@ TEST_CASE("table core features", "[table]") {
 
     REQUIRE(zone->get_list<&Game::World::Zone::minions>().size() == 10);
   }
+
+  SECTION("batch iteration over sub-tables") {
+    auto zone = vault::fb::table<Game::World::Zone>::create(buffer.data(), buffer.size());
+
+    auto tables = 0;
+    zone->for_each_in_list<&Game::World::Zone::minions>([&](auto const& minion) {
+      tables += minion->name()->str() == "Minion";
+    });
+    REQUIRE(tables == 10);
+
+    auto hp = 0;
+    zone->for_each_in_list<&Game::World::Zone::minions, 4>([&](Game::Monster const* minion) { hp += minion->hp(); });
+    REQUIRE(hp == 5000);
+
+    auto raw = zone->get_raw_list<&Game::World::Zone::minions>();
+    REQUIRE(raw.size() == 10);
+    REQUIRE(raw[3] == zone->get_list<&Game::World::Zone::minions>()[3].get());
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -116,6 +145,140 @@ TEST_CASE("table policy variations", "[table][policy]") {
     REQUIRE(monster.has_value());
     REQUIRE(monster->get()->name()->str() == "Dragon");
   }
+
+  SECTION("lock-free policy (concurrent readers)") {
+    using shared_zone = vault::fb::table<Game::World::Zone, vault::fb::lock_free_t>;
+
+    auto zone = shared_zone::create(buffer.data(), buffer.size());
+    REQUIRE(zone.has_value());
+
+    auto failures = std::atomic<int>{0};
+    {
+      auto readers = std::vector<std::jthread>{};
+      for (auto t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+          for (auto i = 0; i < 100; ++i) {
+            auto monster = zone->get_nested<&Game::World::Zone::boss>();
+            auto gear    = monster ? monster->get_nested<&Game::Monster::equipped_gear>() : std::nullopt;
+            if (not gear or gear->get()->damage() != 99) {
+              failures.fetch_add(1, std::memory_order_relaxed);
+            }
+          }
+        });
+      }
+    }
+
+    REQUIRE(failures.load() == 0);
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Lazy Verification
+// -----------------------------------------------------------------------------
+
+TEST_CASE("lazy per-field verification", "[table][lazy]") {
+  const auto buffer = create_test_buffer();
+
+  SECTION("fields, sub-tables and nested buffers") {
+    auto zone = vault::fb::table<Game::World::Zone>::create_lazy(buffer.data(), buffer.size());
+    REQUIRE(zone.has_value());
+    REQUIRE(zone->is_lazy());
+
+    auto name = zone->field<&Game::World::Zone::name>();
+    REQUIRE(name.has_value());
+    REQUIRE((*name)->str() == "Forbidden Forest");
+
+    for (auto&& minion : zone->get_list<&Game::World::Zone::minions>()) {
+      REQUIRE(minion.is_lazy());
+      REQUIRE(minion.field<&Game::Monster::hp>() == 500);
+    }
+    REQUIRE(zone->get_list<&Game::World::Zone::minions>().size() == 10);
+
+    auto lazy_minions = 0;
+    zone->for_each_in_list<&Game::World::Zone::minions>([&](auto const& minion) {
+      lazy_minions += minion.is_lazy() && minion.template field<&Game::Monster::name>().has_value();
+    });
+    REQUIRE(lazy_minions == 10);
+
+    auto monster = zone->get_nested<&Game::World::Zone::boss>();
+    REQUIRE(monster.has_value());
+    REQUIRE(monster->is_lazy());
+    REQUIRE((*monster->field<&Game::Monster::name>())->str() == "Dragon");
+
+    auto gear = monster->get_nested<&Game::Monster::equipped_gear>();
+    REQUIRE(gear.has_value());
+    REQUIRE(gear->field<&Game::Equipment::damage>() == 99);
+  }
+
+  SECTION("a corrupt field fails alone") {
+    auto corrupt = buffer;
+    auto title   = std::ranges::search(corrupt, std::string_view{"Forbidden Forest"});
+    REQUIRE(not title.empty());
+
+    // The length prefix of the zone's name now runs past the buffer.
+    auto const length = std::uint32_t{1} << 20;
+    std::memcpy(std::to_address(title.begin()) - sizeof(length), &length, sizeof(length));
+
+    REQUIRE(not vault::fb::table<Game::World::Zone>::create(corrupt.data(), corrupt.size()).has_value());
+
+    auto zone = vault::fb::table<Game::World::Zone>::create_lazy(corrupt.data(), corrupt.size());
+    REQUIRE(zone.has_value());
+    REQUIRE(not zone->field<&Game::World::Zone::name>().has_value());
+
+    auto monster = zone->get_nested<&Game::World::Zone::boss>();
+    REQUIRE(monster.has_value());
+    REQUIRE(monster->field<&Game::Monster::hp>() == 500);
+  }
+
+  SECTION("eager tables read fields as they are") {
+    auto zone = vault::fb::table<Game::World::Zone>::create(buffer.data(), buffer.size());
+    REQUIRE(not zone->is_lazy());
+    REQUIRE((*zone->field<&Game::World::Zone::name>())->str() == "Forbidden Forest");
+  }
+}
+
+// -----------------------------------------------------------------------------
+// Mapped Files
+// -----------------------------------------------------------------------------
+
+TEST_CASE("tables over mapped files", "[table][mapped]") {
+  const auto buffer = create_test_buffer();
+  const auto path   = std::filesystem::temp_directory_path() / "vault.flatbuffers.mapped.bin";
+  std::ofstream(path, std::ios::binary).write(reinterpret_cast<const char*>(buffer.data()), buffer.size());
+
+  SECTION("tables keep the mapping alive") {
+    auto mapped = vault::fb::mapped_buffer::open(path);
+    REQUIRE(mapped.size() == buffer.size());
+
+    auto zone = vault::fb::table<Game::World::Zone>::create(mapped);
+    REQUIRE(zone.has_value());
+
+    auto monster = zone->get_nested<&Game::World::Zone::boss>();
+    REQUIRE(monster.has_value());
+
+    mapped = {};
+    zone.reset();
+    REQUIRE(monster->get()->name()->str() == "Dragon");
+  }
+
+  SECTION("lazy tables with every policy") {
+    auto const mapped = vault::fb::mapped_buffer::open(path, {.access = vault::fb::map_access::will_need});
+
+    auto zone = vault::fb::table<Game::World::Zone>::create_lazy(mapped);
+    REQUIRE(zone.has_value());
+    REQUIRE((*zone->field<&Game::World::Zone::name>())->str() == "Forbidden Forest");
+
+    REQUIRE(vault::fb::table<Game::World::Zone, vault::fb::unsynchronized_t>::create_lazy(mapped).has_value());
+    REQUIRE(vault::fb::table<Game::World::Zone, vault::fb::lock_free_t>::create_lazy(mapped).has_value());
+  }
+
+  SECTION("empty and missing files") {
+    std::ofstream(path, std::ios::trunc);
+    REQUIRE(not vault::fb::table<Game::World::Zone>::create(vault::fb::mapped_buffer::open(path)).has_value());
+    REQUIRE_THROWS_AS(vault::fb::mapped_buffer::open(path / "missing"), std::system_error);
+  }
+
+  std::filesystem::remove(path);
 }
 
 // -----------------------------------------------------------------------------
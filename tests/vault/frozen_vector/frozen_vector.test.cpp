@@ -1,15 +1,25 @@
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <numeric>
+#include <stdexcept>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include <vault/frozen_vector/arena_storage_policy.hpp>
 #include <vault/frozen_vector/frozen_vector.hpp>
 #include <vault/frozen_vector/frozen_vector_builder.hpp>
 #include <vault/frozen_vector/local_shared_ptr.hpp>
 #include <vault/frozen_vector/local_shared_storage_policy.hpp>
+#include <vault/frozen_vector/mmap_storage_policy.hpp>
 #include <vault/frozen_vector/shared_storage_policy.hpp>
 #include <vault/frozen_vector/unique_storage_policy.hpp>
 
@@ -175,6 +185,84 @@ TEST_CASE("local_shared_ptr: Type Conversion", "[local_ptr]")
   }
 }
 
+TEST_CASE("local_shared_ptr: Promotion to Concurrent Owners", "[local_ptr]")
+{
+  Tracker::count = 0;
+
+  SECTION("The last concurrent owner frees the object")
+  {
+    concurrent_shared_ptr<Tracker> shared;
+    local_weak_ptr<Tracker>        weak;
+    {
+      auto local = make_local_shared<Tracker>();
+      shared     = local.share();
+      weak       = local;
+      REQUIRE(local.use_count() == 1);
+      REQUIRE(shared.use_count() == 2);
+    }
+    REQUIRE(Tracker::count == 1);
+    REQUIRE(shared.use_count() == 1);
+
+    // The object is alive, but it has no local owner left to lock.
+    REQUIRE(weak.expired());
+    REQUIRE(!weak.lock());
+
+    // Catch assertions are not thread-safe, so the threads count mismatches.
+    std::atomic<int>          mismatches{0};
+    std::vector<std::jthread> threads;
+    for (int t = 0; t < 4; ++t) {
+      threads.emplace_back([&mismatches, copy = shared] {
+        for (int i = 0; i < 10000; ++i) {
+          auto again = copy;
+          if (again->padding != "payload") {
+            ++mismatches;
+          }
+        }
+      });
+    }
+    threads.clear();
+    REQUIRE(mismatches == 0);
+    shared.reset();
+    REQUIRE(Tracker::count == 0);
+  }
+
+  SECTION("The last local owner frees the object")
+  {
+    auto                    local = make_local_shared<Tracker>();
+    local_weak_ptr<Tracker> weak  = local;
+    {
+      auto shared = local.share();
+      auto copy   = local;
+      REQUIRE(local.use_count() == 2);
+    }
+    REQUIRE(Tracker::count == 1);
+    local.reset();
+    REQUIRE(Tracker::count == 0);
+    REQUIRE(weak.expired());
+  }
+}
+
+TEST_CASE("frozen_vector: Publishing a Local Vector", "[vector]")
+{
+  using LocalBuilder =
+      frozen_vector_builder<int, local_shared_storage_policy<int>>;
+
+  LocalBuilder builder;
+  for (int i = 0; i < 1000; ++i) {
+    builder.push_back(i);
+  }
+  auto local = std::move(builder).freeze();
+
+  frozen_vector<int, concurrent_shared_ptr<const int[]>> published(local);
+  REQUIRE(published.data() == local.data());
+  REQUIRE(published.size() == 1000);
+
+  local     = {};
+  int value = 0;
+  std::jthread([published, &value] { value = published[999]; }).join();
+  REQUIRE(value == 999);
+}
+
 // ============================================================================
 // PART 2: frozen_vector TESTS
 // ============================================================================
@@ -283,3 +371,258 @@ TEST_CASE("Memory Leak Check", "[memory]")
   }
   REQUIRE(Tracker::count == 0);
 }
+
+TEST_CASE("frozen_vector_builder: Uninitialized Growth", "[builder]")
+{
+  SECTION("append_uninitialized")
+  {
+    UniqueBuilder builder;
+    builder.push_back(7);
+    int* tail = builder.append_uninitialized(1000);
+    REQUIRE(tail == builder.data() + 1);
+    REQUIRE(builder.size() == 1001);
+    std::iota(tail, tail + 1000, 0);
+
+    auto vec = std::move(builder).freeze();
+    REQUIRE(vec[0] == 7);
+    REQUIRE(vec[1] == 0);
+    REQUIRE(vec[1000] == 999);
+  }
+
+  SECTION("resize_and_overwrite")
+  {
+    SharedBuilder builder;
+    builder.push_back(1);
+    builder.push_back(2);
+    builder.resize_and_overwrite(100, [](int* data, size_t count) {
+      REQUIRE(data[0] == 1);
+      REQUIRE(data[1] == 2);
+      std::iota(data + 2, data + count, 3);
+      return count / 2;
+    });
+    REQUIRE(builder.size() == 50);
+    REQUIRE(builder.capacity() >= 100);
+    REQUIRE(builder[49] == 50);
+
+    builder.resize_and_overwrite(0, [](int*, size_t) { return size_t{0}; });
+    REQUIRE(builder.empty());
+  }
+}
+
+TEST_CASE("frozen_vector_builder: Parallel Fill", "[builder]")
+{
+  const vault::algorithm::thread_executor executor(4);
+
+  SECTION("parallel_append_range")
+  {
+    std::vector<int> source(3'000'000);
+    std::iota(source.begin(), source.end(), 0);
+
+    SharedBuilder builder;
+    builder.push_back(-1);
+    builder.parallel_append_range(source, executor);
+    REQUIRE(builder.size() == source.size() + 1);
+
+    auto vec = std::move(builder).freeze();
+    REQUIRE(vec[0] == -1);
+    REQUIRE(std::equal(source.begin(), source.end(), vec.begin() + 1));
+  }
+
+  SECTION("parallel_generate")
+  {
+    UniqueBuilder builder;
+    builder.parallel_generate(
+        1'000'000, [](size_t i) { return static_cast<int>(i * 2); }, executor
+    );
+    builder.parallel_generate(10, [](size_t) { return 7; });
+    REQUIRE(builder.size() == 1'000'010);
+    REQUIRE(builder[999'999] == 1'999'998);
+    REQUIRE(builder.back() == 7);
+  }
+
+  SECTION("a throwing generator leaves the size unchanged")
+  {
+    SharedBuilder builder;
+    builder.push_back(1);
+    REQUIRE_THROWS_AS(
+        builder.parallel_generate(
+            2'000'000,
+            [](size_t i) {
+              if (i == 1'500'000) {
+                throw std::runtime_error("generator");
+              }
+              return 0;
+            },
+            executor
+        ),
+        std::runtime_error
+    );
+    REQUIRE(builder.size() == 1);
+    REQUIRE(builder[0] == 1);
+  }
+}
+
+TEST_CASE("arena_storage_policy: Many Small Vectors", "[arena]")
+{
+  using ArenaBuilder =
+      frozen_vector_builder<int, arena_storage_policy<int>, arena_allocator<int>>;
+
+  auto arena = std::make_shared<frozen_arena>(4096);
+  std::weak_ptr<frozen_arena> watch = arena;
+
+  std::vector<frozen_vector<int>> vectors;
+  for (int v = 0; v < 200; ++v) {
+    ArenaBuilder builder{arena_allocator<int>(arena)};
+    builder.reserve(10);
+    for (int i = 0; i < 10; ++i) {
+      builder.push_back(v * 10 + i);
+    }
+    vectors.push_back(std::move(builder).freeze());
+  }
+
+  // 200 vectors of 40 bytes fill one 4 KiB slab and most of the next.
+  REQUIRE(arena->slab_count() == 2);
+  REQUIRE(arena->allocated_bytes() == 8192);
+
+  // A large vector gets a slab of its own.
+  ArenaBuilder large{arena_allocator<int>(arena)};
+  large.resize(10000);
+  REQUIRE(arena->slab_count() == 3);
+  REQUIRE(reinterpret_cast<std::uintptr_t>(large.data()) % alignof(int) == 0);
+
+  // A builder copy is carved from the same arena.
+  ArenaBuilder copy = large;
+  REQUIRE(copy.get_allocator() == large.get_allocator());
+  REQUIRE(arena->slab_count() == 4);
+
+  for (int v = 0; v < 200; ++v) {
+    REQUIRE(vectors[v].size() == 10);
+    REQUIRE(vectors[v][9] == v * 10 + 9);
+  }
+
+  // The vectors keep the arena alive, and the last one frees it.
+  arena.reset();
+  large = ArenaBuilder{arena_allocator<int>(std::make_shared<frozen_arena>())};
+  copy  = large;
+  REQUIRE(!watch.expired());
+  auto last = vectors.back();
+  vectors.clear();
+  REQUIRE(!watch.expired());
+  REQUIRE(last[0] == 1990);
+  last = {};
+  REQUIRE(watch.expired());
+}
+
+// ============================================================================
+// PART 3: MAPPED STORAGE
+// ============================================================================
+
+using MmapBuilder =
+    frozen_vector_builder<int, mmap_storage_policy<int>, mmap_allocator<int>>;
+
+TEST_CASE("mmap_storage_policy: Anonymous Mapping", "[mmap]")
+{
+  MmapBuilder builder(mmap_allocator<int>(
+      mmap_options{.access = mmap_access::random, .huge_pages = true}
+  ));
+  for (int i = 0; i < 10000; ++i) {
+    builder.push_back(i);
+  }
+  auto vec = std::move(builder).freeze();
+
+  static_assert(std::is_same_v<
+                typename decltype(vec)::handle_type,
+                mmap_handle<const int>>);
+  REQUIRE(vec.size() == 10000);
+  REQUIRE(vec[0] == 0);
+  REQUIRE(vec.back() == 9999);
+
+  // Copies share the mapping.
+  auto copy = vec;
+  REQUIRE(copy.data() == vec.data());
+}
+
+TEST_CASE("mmap_storage_policy: File Round Trip", "[mmap]")
+{
+  const auto path = std::filesystem::temp_directory_path() /
+                    ("frozen_vector_mmap_" + std::to_string(::getpid()));
+
+  {
+    MmapBuilder builder{mmap_allocator<int>(path)};
+    builder.reserve(4096);
+    for (int i = 0; i < 1000; ++i) {
+      builder.push_back(i * 3);
+    }
+    auto vec = std::move(builder).freeze();
+    REQUIRE(vec.size() == 1000);
+    REQUIRE(vec[999] == 2997);
+  }
+
+  // Freezing cut the file to the elements written.
+  REQUIRE(std::filesystem::file_size(path) == 1000 * sizeof(int));
+
+  SECTION("Whole file")
+  {
+    auto vec = map_file<int>(path, {.access = mmap_access::sequential});
+    REQUIRE(vec.size() == 1000);
+    std::vector<int> expected(1000);
+    std::ranges::generate(expected, [i = 0]() mutable { return 3 * i++; });
+    REQUIRE(std::ranges::equal(vec, expected));
+  }
+
+  SECTION("From an offset")
+  {
+    auto vec = map_file<int>(path, {}, 10 * sizeof(int));
+    REQUIRE(vec.size() == 990);
+    REQUIRE(vec[0] == 30);
+  }
+
+  SECTION("Errors")
+  {
+    REQUIRE_THROWS_AS(map_file<int>(path, {}, 2), std::invalid_argument);
+    REQUIRE_THROWS_AS(map_file<std::int64_t>(path, {}, 4), std::invalid_argument);
+    REQUIRE_THROWS_AS(
+        map_file<int>(path.string() + ".missing"), std::system_error
+    );
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("mmap_storage_policy: Empty File", "[mmap]")
+{
+  const auto path = std::filesystem::temp_directory_path() /
+                    ("frozen_vector_empty_" + std::to_string(::getpid()));
+  std::ofstream(path).close();
+
+  auto vec = map_file<int>(path);
+  REQUIRE(vec.empty());
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("mmap_storage_policy: Types Without a Default Constructor", "[mmap]")
+{
+  struct point {
+    point(int x, int y)
+        : x(x)
+        , y(y)
+    {}
+
+    int x;
+    int y;
+  };
+
+  frozen_vector_builder<point, mmap_storage_policy<point>, mmap_allocator<point>>
+      builder;
+  builder.push_back(point(1, 2));
+  point* tail = builder.append_uninitialized(99);
+  for (int i = 0; i < 99; ++i) {
+    tail[i] = point(i, -i);
+  }
+
+  auto vec = std::move(builder).freeze();
+  REQUIRE(vec.size() == 100);
+  REQUIRE(vec[0].y == 2);
+  REQUIRE(vec[99].x == 98);
+}
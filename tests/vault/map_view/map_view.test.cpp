@@ -8,7 +8,10 @@
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "vault/flat_map/layout_map.hpp"
 #include "vault/map_view/map_view.hpp"
 
 using namespace lib;
@@ -138,6 +141,162 @@ TEMPLATE_TEST_CASE("map_view: Heterogeneous Lookup (Polyfilled)",
   }
 }
 
+// =============================================================================
+// Test Suite: map_view (Batched and Devirtualized)
+// =============================================================================
+
+TEMPLATE_TEST_CASE("map_view: Batched lookup via .find_many()",
+  "[map_view][batch]",
+  (std::map<std::string, int>),
+  (std::unordered_map<std::string, int>),
+  (boost::container::flat_map<std::string, int>))
+{
+  using container_t  = TestType;
+  auto container     = container_t{};
+  container["alpha"] = 10;
+  container["beta"]  = 20;
+  container["gamma"] = 30;
+
+  auto view = map_view<std::string, int>{container};
+
+  auto keys = std::vector<std::string>{"gamma", "delta", "alpha", "beta", ""};
+  auto out  = std::vector<int*>(keys.size());
+  view.find_many(keys, out);
+
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    CHECK(out[i] == view.find(keys[i]));
+  }
+  verify_entry(out[0], 30);
+  CHECK(out[1] == nullptr);
+}
+
+TEST_CASE("map_view: Batched lookup via the AMAC batch_find of layout_map",
+  "[map_view][batch][layout_map]")
+{
+  auto input = std::vector<std::pair<int, int>>{};
+  for (int i = 0; i < 1000; ++i) {
+    input.emplace_back(i * 2, i);
+  }
+  auto container = eytzinger::layout_map<int, int>(input.begin(), input.end());
+
+  auto view = map_view<int, const int>{container};
+
+  // Even keys are present, odd keys are not.
+  auto keys = std::vector<int>{};
+  for (int i = 1999; i >= -1; i -= 3) {
+    keys.push_back(i);
+  }
+  auto out = std::vector<const int*>(keys.size());
+  view.find_many(keys, out);
+
+  for (std::size_t i = 0; i < keys.size(); ++i) {
+    CHECK(out[i] == view.find(keys[i]));
+    CHECK((out[i] != nullptr) == (keys[i] >= 0 && keys[i] % 2 == 0));
+  }
+}
+
+TEST_CASE("map_view: Devirtualized access via .target() and .visit()",
+  "[map_view][visit]")
+{
+  auto container = std::map<std::string, int>{{"alpha", 10}, {"beta", 20}};
+  auto view      = map_view<std::string, int>{container};
+
+  CHECK(view.target<std::map<std::string, int>>() == &container);
+  CHECK(view.target<std::unordered_map<std::string, int>>() == nullptr);
+
+  auto sum     = 0;
+  auto visited = view.visit<std::unordered_map<std::string, int>,
+    std::map<std::string, int>>([&](auto& c) {
+    for (const auto& [key, value] : c) {
+      sum += value;
+    }
+  });
+  CHECK(visited);
+  CHECK(sum == 30);
+
+  CHECK_FALSE(view.visit<std::unordered_map<std::string, int>>(
+    [](auto&) { FAIL("Visited a container of the wrong type"); }));
+}
+
+// =============================================================================
+// Test Suite: Prehashed Keys
+// =============================================================================
+
+/**
+ * @brief Transparent hasher that counts its invocations.
+ */
+struct counting_hash : string_view_hash {
+  inline static int calls = 0;
+
+  using string_view_hash::operator();
+
+  [[nodiscard]] auto operator()(std::string_view sv) const noexcept
+    -> std::size_t
+  {
+    ++calls;
+    return string_view_hash::operator()(sv);
+  }
+
+  [[nodiscard]] auto operator()(const std::string& s) const noexcept
+    -> std::size_t
+  {
+    ++calls;
+    return string_view_hash::operator()(s);
+  }
+};
+
+using prehashed_unordered_map = std::unordered_map<std::string,
+  int,
+  prehashed_hash<counting_hash>,
+  prehashed_equal<>>;
+
+TEST_CASE("map_view: Prehashed lookup skips rehashing", "[map_view][prehashed]")
+{
+  auto first  = prehashed_unordered_map{{"alpha", 10}, {"beta", 20}};
+  auto second = prehashed_unordered_map{{"alpha", 11}, {"gamma", 30}};
+
+  // A key is hashed once and probed in several views.
+  auto views = std::vector<map_view<std::string_view, int>>{
+    map_view<std::string_view, int>{first},
+    map_view<std::string_view, int>{second}};
+  auto mutable_view = mutable_map_view<std::string, int>{second};
+
+  const auto alpha = std::string_view{"alpha"};
+  const auto gamma = std::string{"gamma"};
+
+  counting_hash::calls = 0;
+  const auto key       = views.front().prehash(alpha);
+  CHECK(counting_hash::calls == 1);
+  CHECK(key.hash() == string_view_hash{}(alpha));
+
+  verify_entry(views[0].find(key), 10);
+  verify_entry(views[1].find(key), 11);
+  CHECK(views[1].contains(key));
+  CHECK(counting_hash::calls == 1);
+
+  const auto mutable_key = mutable_view.prehash(gamma);
+  verify_entry(mutable_view.find(mutable_key), 30);
+  CHECK_FALSE(views[0].contains(views[0].prehash("gamma")));
+  CHECK(counting_hash::calls == 3);
+}
+
+TEMPLATE_TEST_CASE("map_view: Prehashed lookup falls back to .find()",
+  "[map_view][prehashed]",
+  transparent_map,
+  transparent_flat_map,
+  transparent_unordered_map)
+{
+  auto container = TestType{{"alpha", 10}, {"beta", 20}};
+  auto view      = map_view<std::string_view, int>{container};
+
+  const auto alpha = std::string_view{"alpha"};
+  const auto delta = std::string_view{"delta"};
+
+  verify_entry(view.find(view.prehash(alpha)), 10);
+  CHECK(view.find(view.prehash(delta)) == nullptr);
+  CHECK_FALSE(view.contains(view.prehash(delta)));
+}
+
 // =============================================================================
 // Test Suite: mutable_map_view (Read-Write)
 // =============================================================================
@@ -0,0 +1,117 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vault/metrics/metrics.hpp>
+
+using namespace vault::metrics;
+
+namespace {
+  const counter   test_counter{"tests.counter"};
+  const histogram test_histogram{"tests.histogram"};
+  const histogram test_timer{"tests.timer"};
+} // namespace
+
+TEST_CASE("metrics are enabled in the tests", "[metrics]") {
+  STATIC_REQUIRE(enabled);
+}
+
+TEST_CASE("counter totals what every thread adds", "[metrics][counter]") {
+  const auto before = snapshot();
+
+  test_counter.add();
+  test_counter.add(4);
+
+  SECTION("on this thread") {
+    const auto  recorded = snapshot().since(before);
+    const auto* metric   = recorded.find("tests.counter");
+    REQUIRE(metric != nullptr);
+    REQUIRE(metric->kind == metric_kind::counter);
+    REQUIRE(metric->count == 5);
+    REQUIRE(metric->sum == 5);
+  }
+
+  SECTION("including threads that have exited") {
+    auto threads = std::vector<std::thread>{};
+    for (auto i = 0; i < 4; ++i) {
+      threads.emplace_back([] {
+        for (auto j = 0; j < 1000; ++j) {
+          test_counter.add();
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    const auto  recorded = snapshot().since(before);
+    const auto* metric   = recorded.find("tests.counter");
+    REQUIRE(metric != nullptr);
+    REQUIRE(metric->count == 4005);
+  }
+}
+
+TEST_CASE("counter can be added to in a constant expression", "[metrics][counter]") {
+  constexpr auto sum = [] {
+    auto total = 0;
+    for (auto i = 0; i < 3; ++i) {
+      test_counter.add();
+      total += i;
+    }
+    return total;
+  }();
+  STATIC_REQUIRE(sum == 3);
+}
+
+TEST_CASE("histogram buckets values by their bit width", "[metrics][histogram]") {
+  const auto before = snapshot();
+
+  for (const auto value : {std::uint64_t{0}, std::uint64_t{1}, std::uint64_t{5}, std::uint64_t{6}, std::uint64_t{1000}}) {
+    test_histogram.record(value);
+  }
+
+  const auto  recorded = snapshot().since(before);
+  const auto* metric   = recorded.find("tests.histogram");
+  REQUIRE(metric != nullptr);
+  REQUIRE(metric->kind == metric_kind::histogram);
+  REQUIRE(metric->count == 5);
+  REQUIRE(metric->sum == 1012);
+  REQUIRE(metric->buckets[0] == 1);
+  REQUIRE(metric->buckets[1] == 1);
+  REQUIRE(metric->buckets[3] == 2);
+  REQUIRE(metric->buckets[10] == 1);
+  REQUIRE(metric->mean() == 1012.0 / 5);
+
+  REQUIRE(metric->quantile(0.0) == 0);
+  REQUIRE(metric->quantile(0.5) == 7);
+  REQUIRE(metric->quantile(1.0) == 1023);
+}
+
+TEST_CASE("scoped_timer records one sample per scope", "[metrics][scoped_timer]") {
+  const auto before = snapshot();
+
+  for (auto i = 0; i < 3; ++i) {
+    const auto timer = scoped_timer{test_timer};
+    std::this_thread::sleep_for(std::chrono::microseconds{10});
+  }
+
+  const auto  recorded = snapshot().since(before);
+  const auto* metric   = recorded.find("tests.timer");
+  REQUIRE(metric != nullptr);
+  REQUIRE(metric->count == 3);
+  REQUIRE(metric->sum >= 30'000);
+}
+
+TEST_CASE("export_metrics visits every registered metric", "[metrics]") {
+  auto names = std::vector<std::string_view>{};
+  export_metrics([&](const metric_snapshot& metric) { names.push_back(metric.name); });
+
+  REQUIRE(std::ranges::find(names, "tests.counter") != names.end());
+  REQUIRE(std::ranges::find(names, "tests.histogram") != names.end());
+  REQUIRE(std::ranges::find(names, "tests.timer") != names.end());
+}
@@ -0,0 +1,239 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <vault/segmented_vector/concurrent_segmented_vector.hpp>
+
+// -----------------------------------------------------------------------------
+// Helper Types for Testing
+// -----------------------------------------------------------------------------
+
+namespace {
+
+  using SmallBlocks = concurrent_segmented_vector<
+      size_t,
+      std::allocator<size_t>,
+      std::integral_constant<size_t, 4>>;
+
+  // Counts live instances, and throws when constructed from a poisoned
+  // value.
+  struct Tracked {
+    static std::atomic<int> live;
+    static constexpr size_t poison = static_cast<size_t>(-1);
+
+    size_t value;
+
+    explicit Tracked(size_t v)
+        : value(v)
+    {
+      if (v == poison) {
+        throw std::runtime_error("Simulated Construction Failure");
+      }
+      live++;
+    }
+
+    Tracked(const Tracked&)            = delete;
+    Tracked& operator=(const Tracked&) = delete;
+
+    ~Tracked() { live--; }
+  };
+
+  std::atomic<int> Tracked::live{0};
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Test Cases
+// -----------------------------------------------------------------------------
+
+TEST_CASE("Concurrent Append: Single Thread", "[concurrent]")
+{
+  SmallBlocks v;
+  CHECK(v.empty());
+
+  for (size_t i = 0; i < 1000; ++i) {
+    auto& ref = v.emplace_back(i);
+    REQUIRE(&ref == &v[i]);
+    REQUIRE(v.size() == i + 1);
+  }
+
+  for (size_t i = 0; i < 1000; ++i) {
+    REQUIRE(v[i] == i);
+  }
+  CHECK_THROWS_AS(v.at(1000), std::out_of_range);
+
+  size_t next = 0;
+  v.for_each_segment([&](const size_t& value) { REQUIRE(value == next++); });
+  CHECK(next == 1000);
+
+  v.clear();
+  CHECK(v.empty());
+  v.push_back(7);
+  CHECK(v.size() == 1);
+  CHECK(v[0] == 7);
+}
+
+TEST_CASE("Concurrent Append: Many Producers", "[concurrent]")
+{
+  const size_t threads    = GENERATE(2, 8);
+  const size_t per_thread = 20000;
+
+  SmallBlocks                v;
+  std::vector<const size_t*> addresses(threads * per_thread);
+  std::atomic<bool>          go{false};
+
+  {
+    std::vector<std::jthread> producers;
+    for (size_t t = 0; t < threads; ++t) {
+      producers.emplace_back([&, t] {
+        while (!go.load()) {
+        }
+        for (size_t i = 0; i < per_thread; ++i) {
+          const size_t value = t * per_thread + i;
+          addresses[value]   = &v.emplace_back(value);
+        }
+      });
+    }
+    go = true;
+  }
+
+  REQUIRE(v.size() == threads * per_thread);
+
+  // Every value arrives exactly once, and stays where it was constructed.
+  std::vector<size_t> seen(threads * per_thread, 0);
+  for (size_t i = 0; i < v.size(); ++i) {
+    seen[v[i]]++;
+    REQUIRE(addresses[v[i]] == &v[i]);
+  }
+  for (size_t count : seen) {
+    REQUIRE(count == 1);
+  }
+
+  // The values of one producer keep its order.
+  std::vector<size_t> last(threads, 0);
+  v.for_each_segment([&](const size_t& value) {
+    const size_t t = value / per_thread;
+    REQUIRE(value >= last[t]);
+    last[t] = value;
+  });
+}
+
+TEST_CASE("Concurrent Append: Readers See Published Elements", "[concurrent]")
+{
+  // The reader accesses every element as soon as it is published, with
+  // plain loads, so an element published before its construction is a
+  // data race that ThreadSanitizer reports, and usually a wrong value.
+  constexpr size_t threads    = 4;
+  constexpr size_t per_thread = 20000;
+
+  SmallBlocks       v;
+  std::atomic<bool> done{false};
+  size_t            out_of_range = 0;
+
+  std::jthread reader([&] {
+    size_t checked = 0;
+    while (!done.load() || checked < v.size()) {
+      const size_t size = v.size();
+      for (; checked < size; ++checked) {
+        if (v[checked] >= per_thread) {
+          out_of_range++;
+        }
+      }
+    }
+  });
+
+  {
+    std::vector<std::jthread> producers;
+    for (size_t t = 0; t < threads; ++t) {
+      producers.emplace_back([&] {
+        for (size_t i = 0; i < per_thread; ++i) {
+          v.emplace_back(i);
+        }
+      });
+    }
+  }
+  done = true;
+  reader.join();
+
+  CHECK(out_of_range == 0);
+  CHECK(v.size() == threads * per_thread);
+}
+
+TEST_CASE("Concurrent Append: Ranges", "[concurrent]")
+{
+  // Ranges longer than the first blocks, so that most span several.
+  constexpr size_t threads = 4;
+  constexpr size_t ranges  = 200;
+  const size_t     length  = GENERATE(1, 7, 100);
+
+  SmallBlocks v;
+  v.append_range(std::vector<size_t>{});
+  CHECK(v.empty());
+
+  {
+    std::vector<std::jthread> producers;
+    for (size_t t = 0; t < threads; ++t) {
+      producers.emplace_back([&, t] {
+        std::vector<size_t> values(length);
+        for (size_t r = 0; r < ranges; ++r) {
+          std::iota(values.begin(), values.end(), (t * ranges + r) * length);
+          v.append_range(values);
+        }
+      });
+    }
+  }
+
+  REQUIRE(v.size() == threads * ranges * length);
+
+  // Every range lands at consecutive indices.
+  std::vector<size_t> seen(v.size(), 0);
+  for (size_t i = 0; i < v.size(); i += length) {
+    REQUIRE(v[i] % length == 0);
+    for (size_t j = 0; j < length; ++j) {
+      REQUIRE(v[i + j] == v[i] + j);
+      seen[v[i + j]]++;
+    }
+  }
+  for (size_t count : seen) {
+    REQUIRE(count == 1);
+  }
+}
+
+TEST_CASE("Concurrent Append: Throwing Constructor", "[concurrent]")
+{
+  {
+    concurrent_segmented_vector<Tracked> v;
+    v.emplace_back(0);
+    v.emplace_back(1);
+    CHECK_THROWS_AS(v.emplace_back(Tracked::poison), std::runtime_error);
+
+    // The failed index is never published, and holds back the ones after
+    // it.
+    v.emplace_back(3);
+    CHECK(v.size() == 2);
+    CHECK(v[1].value == 1);
+    CHECK(Tracked::live == 3);
+  }
+  CHECK(Tracked::live == 0);
+
+  {
+    // The elements of a range before the one that failed are published.
+    concurrent_segmented_vector<Tracked> v;
+    CHECK_THROWS_AS(
+        v.append_range(std::vector<size_t>{0, 1, Tracked::poison, 3}),
+        std::runtime_error
+    );
+    CHECK(v.size() == 2);
+    CHECK(v[1].value == 1);
+    CHECK(Tracked::live == 2);
+  }
+  CHECK(Tracked::live == 0);
+}
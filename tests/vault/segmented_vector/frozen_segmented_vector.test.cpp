@@ -0,0 +1,171 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <vault/segmented_vector/segmented_vector.hpp>
+
+// -----------------------------------------------------------------------------
+// Helper Types for Testing
+// -----------------------------------------------------------------------------
+
+namespace {
+
+  using SmallBlocks = segmented_vector<
+      size_t,
+      std::allocator<size_t>,
+      std::integral_constant<size_t, 4>>;
+
+  // Counts live instances, to verify that the last view destroys them.
+  struct Tracked {
+    static int live;
+    size_t     value;
+
+    Tracked(size_t v)
+        : value(v)
+    {
+      live++;
+    }
+
+    Tracked(const Tracked& other)
+        : value(other.value)
+    {
+      live++;
+    }
+
+    ~Tracked() { live--; }
+  };
+
+  int Tracked::live = 0;
+
+} // namespace
+
+// -----------------------------------------------------------------------------
+// Test Cases
+// -----------------------------------------------------------------------------
+
+TEST_CASE("Freeze: Elements Stay in Place", "[frozen]")
+{
+  const size_t N = GENERATE(0, 1, 4, 5, 100, 10000);
+
+  SmallBlocks          sv;
+  std::vector<size_t*> addresses;
+  for (size_t i = 0; i < N; ++i) {
+    addresses.push_back(&sv.emplace_back(i));
+  }
+  const size_t segments = N == 0 ? 0 : std::bit_width((N - 1) / 4) + 1;
+
+  auto frozen = std::move(sv).freeze();
+  CHECK(sv.empty());
+  CHECK(sv.capacity() == 0);
+
+  REQUIRE(frozen.size() == N);
+  CHECK(frozen.segment_count() == segments);
+  for (size_t i = 0; i < N; ++i) {
+    REQUIRE(frozen[i] == i);
+    REQUIRE(&frozen[i] == addresses[i]);
+  }
+  CHECK_THROWS_AS(frozen.at(N), std::out_of_range);
+
+  CHECK(std::ranges::equal(frozen, std::views::iota(size_t{0}, N)));
+  CHECK(std::ranges::equal(
+      frozen | std::views::reverse,
+      std::views::iota(size_t{0}, N) | std::views::reverse
+  ));
+
+  size_t next = 0;
+  frozen.for_each_segment([&](const size_t& value) {
+    REQUIRE(value == next++);
+  });
+  CHECK(next == N);
+
+  // The source is reusable after a freeze.
+  sv.push_back(42);
+  CHECK(sv.size() == 1);
+  CHECK(sv[0] == 42);
+}
+
+TEST_CASE("Freeze: Iterator Compliance", "[frozen]")
+{
+  using Frozen = SmallBlocks::frozen_type;
+  static_assert(std::random_access_iterator<Frozen::const_iterator>);
+  static_assert(std::ranges::random_access_range<Frozen>);
+  static_assert(std::is_same_v<std::iter_reference_t<Frozen::iterator>,
+                               const size_t&>);
+
+  SmallBlocks sv;
+  for (size_t i = 0; i < 100; ++i) {
+    sv.push_back(i);
+  }
+  auto frozen = std::move(sv).freeze();
+
+  auto it = frozen.begin() + 10;
+  CHECK(*it == 10);
+  CHECK(it[5] == 15);
+  CHECK(*(it - 3) == 7);
+  CHECK(frozen.end() - it == 90);
+  CHECK(std::ranges::is_sorted(frozen));
+  CHECK(std::ranges::lower_bound(frozen, size_t{57}) - frozen.begin() == 57);
+}
+
+TEST_CASE("Freeze: Shared Ownership", "[frozen]")
+{
+  Tracked::live = 0;
+  {
+    segmented_vector<Tracked> sv;
+    for (size_t i = 0; i < 1000; ++i) {
+      sv.emplace_back(i);
+    }
+    const Tracked* first = &sv[0];
+
+    // The spare capacity of a cleared block is handed over too.
+    sv.clear();
+    for (size_t i = 0; i < 500; ++i) {
+      sv.emplace_back(i);
+    }
+    CHECK(Tracked::live == 500);
+
+    auto frozen = std::move(sv).freeze();
+    CHECK(Tracked::live == 500);
+    CHECK(&frozen[0] == first);
+
+    auto copy = frozen;
+    CHECK(&copy[499] == &frozen[499]);
+
+    frozen = {};
+    CHECK(frozen.empty());
+    CHECK(Tracked::live == 500);
+
+    // Readers on other threads hold their own copies.
+    std::atomic<size_t>       mismatches{0};
+    std::vector<std::jthread> readers;
+    for (int r = 0; r < 4; ++r) {
+      readers.emplace_back([&mismatches, view = copy] {
+        for (size_t i = 0; i < view.size(); ++i) {
+          if (view[i].value != i) {
+            mismatches++;
+          }
+        }
+      });
+    }
+    readers.clear();
+    CHECK(mismatches == 0);
+
+    auto moved = std::move(copy);
+    CHECK(copy.empty());
+    CHECK(moved.size() == 500);
+    CHECK(Tracked::live == 500);
+  }
+  CHECK(Tracked::live == 0);
+}
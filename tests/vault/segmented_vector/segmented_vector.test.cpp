@@ -3,10 +3,19 @@
 #include <catch2/matchers/catch_matchers_vector.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iterator>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 // Assuming the class is defined in this header
+#include <vault/allocators/hpallocator.hpp>
 #include <vault/segmented_vector/segmented_vector.hpp>
 
 // -----------------------------------------------------------------------------
@@ -174,6 +183,88 @@ TEST_CASE("Growth Strategy Verification", "[growth]")
   REQUIRE(sv.capacity() == 64); // 32 + 32
 }
 
+TEST_CASE("Huge Page Growth", "[growth]")
+{
+  // 24-byte elements fill whole 2 MiB pages in blocks of 3 pages, and 4-byte
+  // ones in blocks of one.
+  struct Triple {
+    uint64_t a, b, c;
+  };
+  static_assert(huge_page_growth<>::max_block_capacity<24, 128> == 262144);
+  static_assert(huge_page_growth<>::max_block_capacity<4, 1024> == 524288);
+  static_assert(huge_page_growth<256>::max_block_capacity<1024, 4> == 4);
+
+  SECTION("Blocks double up to whole pages, then stay")
+  {
+    // With 256-byte pages: 8, 8, 16, 32, then 32 (3 pages) from there on.
+    segmented_vector<
+        Triple,
+        std::allocator<Triple>,
+        std::integral_constant<size_t, 8>,
+        huge_page_growth<256>>
+        sv;
+
+    std::vector<size_t> capacities;
+    for (uint64_t i = 0; i < 200; ++i) {
+      sv.push_back({i, i + 1, i + 2});
+      if (capacities.empty() || capacities.back() != sv.capacity()) {
+        capacities.push_back(sv.capacity());
+      }
+    }
+    REQUIRE_THAT(
+        capacities,
+        Catch::Matchers::Equals(
+            std::vector<size_t>{8, 16, 32, 64, 96, 128, 160, 192, 224}
+        )
+    );
+
+    // Indexing and iteration agree across the switch to capped blocks.
+    uint64_t next = 0;
+    for (const Triple& t : sv) {
+      REQUIRE(t.a == next);
+      REQUIRE(&t == &sv[next]);
+      REQUIRE(t.c == next + 2);
+      ++next;
+    }
+    CHECK(next == 200);
+
+    size_t visited = 0;
+    sv.for_each_segment([&](const Triple& t) { REQUIRE(t.a == visited++); });
+    CHECK(visited == 200);
+
+    auto frozen = std::move(sv).freeze();
+    for (uint64_t i = 0; i < 200; ++i) {
+      REQUIRE(frozen[i].a == i);
+    }
+  }
+
+  SECTION("Capped blocks are huge-page aligned with hpallocator")
+  {
+    using Page = huge_page_growth<>;
+    segmented_vector<
+        int,
+        static_data::hpallocator<int>,
+        std::integral_constant<size_t, 1024>,
+        Page>
+        sv;
+
+    constexpr size_t block = Page::max_block_capacity<sizeof(int), 1024>;
+    for (size_t i = 0; i < 3 * block; ++i) {
+      sv.push_back(static_cast<int>(i));
+    }
+    REQUIRE(sv.capacity() == 3 * block);
+
+    // The first capped block starts at index block, the next at 2 * block.
+    for (size_t start : {block, 2 * block}) {
+      REQUIRE(sv[start] == static_cast<int>(start));
+      REQUIRE(
+          reinterpret_cast<std::uintptr_t>(&sv[start]) % Page::page_bytes == 0
+      );
+      REQUIRE(&sv[start + block - 1] == &sv[start] + block - 1);
+    }
+  }
+}
+
 TEST_CASE("Reference Stability", "[stability]")
 {
   segmented_vector<int> sv;
@@ -428,3 +519,239 @@ TEST_CASE("Large Scale / Block Boundary Stress", "[stress]")
     }
   }
 }
+
+TEST_CASE("Parallel Segment Algorithms", "[parallel]")
+{
+  using SmallBlocks = segmented_vector<
+      size_t,
+      std::allocator<size_t>,
+      std::integral_constant<size_t, 4>>;
+
+  const size_t N = GENERATE(0, 1, 4, 5, 100, 10000);
+
+  SmallBlocks sv;
+  for (size_t i = 0; i < N; ++i) {
+    sv.push_back(i);
+  }
+
+  const auto executor = vault::algorithm::thread_executor{4};
+
+  SECTION("Partition covers every element in order")
+  {
+    for (size_t max_length : {1, 3, 4, 64, 1 << 20}) {
+      auto runs = sv.partition_segments(max_length);
+
+      size_t next = 0;
+      for (auto run : runs) {
+        REQUIRE_FALSE(run.empty());
+        REQUIRE(run.size() <= max_length);
+        for (size_t value : run) {
+          REQUIRE(value == next++);
+        }
+      }
+      REQUIRE(next == N);
+    }
+  }
+
+  SECTION("Partition keeps whole blocks up to the maximum")
+  {
+    // 64 elements fill blocks of 4, 4, 8, 16 and 32 elements: a maximum
+    // of 8 keeps the first three whole and splits the others into runs of
+    // exactly 8.
+    SmallBlocks full;
+    for (size_t i = 0; i < 64; ++i) {
+      full.push_back(i);
+    }
+
+    std::vector<size_t> lengths;
+    for (auto run : std::as_const(full).partition_segments(8)) {
+      lengths.push_back(run.size());
+    }
+    CHECK(lengths == std::vector<size_t>{4, 4, 8, 8, 8, 8, 8, 8, 8});
+  }
+
+  SECTION("Runs sort independently")
+  {
+    SmallBlocks reversed;
+    for (size_t i = 0; i < N; ++i) {
+      reversed.push_back(N - i);
+    }
+    auto runs = reversed.partition_segments(16);
+    for (auto run : runs) {
+      std::ranges::sort(run);
+      CHECK(std::ranges::is_sorted(run));
+    }
+  }
+
+  SECTION("for_each")
+  {
+    sv.parallel_for_each([](size_t& value) { value *= 2; }, executor);
+    for (size_t i = 0; i < N; ++i) {
+      REQUIRE(sv[i] == 2 * i);
+    }
+
+    std::atomic<size_t> visited{0};
+    std::as_const(sv).parallel_for_each(
+        [&](const size_t&) { visited++; }, executor
+    );
+    CHECK(visited == N);
+  }
+
+  SECTION("transform")
+  {
+    std::vector<size_t> out(N);
+    auto                last = sv.parallel_transform(
+        out.begin(), [](size_t value) { return value + 1; }, executor
+    );
+    CHECK(last == out.end());
+    for (size_t i = 0; i < N; ++i) {
+      REQUIRE(out[i] == i + 1);
+    }
+  }
+
+  SECTION("reduce")
+  {
+    CHECK(sv.parallel_reduce(size_t{7}, std::plus<>{}, executor) ==
+          7 + N * (N - (N > 0 ? 1 : 0)) / 2);
+
+    // Concatenation is associative but not commutative, so this fails if
+    // the runs are combined out of order.
+    segmented_vector<
+        std::string,
+        std::allocator<std::string>,
+        std::integral_constant<size_t, 4>>
+                digit_strings;
+    std::string expected;
+    for (size_t i = 0; i < N; ++i) {
+      digit_strings.push_back(std::to_string(i % 10));
+      expected += digit_strings.back();
+    }
+    auto digits =
+        digit_strings.parallel_reduce(std::string{}, std::plus<>{}, executor);
+    CHECK(digits == expected);
+  }
+
+  SECTION("Default executor")
+  {
+    CHECK(
+        sv.parallel_reduce(size_t{0}, std::plus<>{}) ==
+        N * (N - (N > 0 ? 1 : 0)) / 2
+    );
+  }
+}
+
+TEST_CASE("Segmented Algorithms", "[algorithm]")
+{
+  using SmallBlocks = segmented_vector<
+      size_t,
+      std::allocator<size_t>,
+      std::integral_constant<size_t, 4>>;
+
+  const size_t N = GENERATE(0, 1, 4, 5, 100, 1000);
+
+  SmallBlocks         sv;
+  std::vector<size_t> reference;
+  for (size_t i = 0; i < N; ++i) {
+    sv.push_back(i % 7);
+    reference.push_back(i % 7);
+  }
+
+  // Subranges that start and end inside, at and across block boundaries.
+  const size_t first = GENERATE(0, 3, 4, 9);
+  const size_t last  = GENERATE(0, 8, 13, 1000);
+  if (first > last || last > N) {
+    return;
+  }
+
+  auto sv_first = sv.begin() + first;
+  auto sv_last  = sv.begin() + last;
+  auto it_first = reference.begin() + first;
+  auto it_last  = reference.begin() + last;
+
+  // The calls are unqualified, as the overloads are found by
+  // argument-dependent lookup.
+  SECTION("copy")
+  {
+    std::vector<size_t> out(last - first);
+    auto                end = copy(sv_first, sv_last, out.begin());
+    CHECK(end == out.end());
+    CHECK(std::equal(out.begin(), out.end(), it_first, it_last));
+
+    std::vector<size_t> appended;
+    copy(sv_first, sv_last, std::back_inserter(appended));
+    CHECK(appended == out);
+  }
+
+  SECTION("fill")
+  {
+    fill(sv_first, sv_last, 42);
+    std::fill(it_first, it_last, 42);
+    CHECK(std::equal(sv.begin(), sv.end(), reference.begin(), reference.end()));
+  }
+
+  SECTION("for_each")
+  {
+    size_t visited = 0;
+    for_each(sv_first, sv_last, [&](size_t& value) {
+      value += 1;
+      ++visited;
+    });
+    CHECK(visited == last - first);
+    for (size_t i = first; i < last; ++i) {
+      REQUIRE(sv[i] == reference[i] + 1);
+    }
+  }
+
+  SECTION("find")
+  {
+    for (size_t needle : {0, 3, 6, 7}) {
+      auto found    = find(sv_first, sv_last, needle);
+      auto expected = std::find(it_first, it_last, needle);
+      REQUIRE(found - sv.begin() == expected - reference.begin());
+    }
+
+    auto odd = find_if(sv_first, sv_last, [](size_t v) { return v % 2; });
+    auto expected_odd =
+        std::find_if(it_first, it_last, [](size_t v) { return v % 2; });
+    CHECK(odd - sv.begin() == expected_odd - reference.begin());
+  }
+
+  SECTION("count")
+  {
+    CHECK(count(sv_first, sv_last, 3) == std::count(it_first, it_last, 3));
+  }
+
+  SECTION("accumulate")
+  {
+    CHECK(
+        accumulate(sv_first, sv_last, size_t{5}) ==
+        std::accumulate(it_first, it_last, size_t{5})
+    );
+
+    // The fold is sequential, so a non-associative operation matches too.
+    auto digits = [](std::string acc, size_t v) {
+      return acc + std::to_string(v);
+    };
+    CHECK(
+        accumulate(sv_first, sv_last, std::string{}, digits) ==
+        std::accumulate(it_first, it_last, std::string{}, digits)
+    );
+  }
+
+  SECTION("const iterators")
+  {
+    const SmallBlocks& csv    = sv;
+    auto               cfirst = csv.begin() + first;
+    auto               clast  = csv.begin() + last;
+
+    CHECK(
+        accumulate(cfirst, clast, size_t{0}) ==
+        std::accumulate(it_first, it_last, size_t{0})
+    );
+    auto found = find(cfirst, clast, size_t{6});
+    CHECK(
+        found - csv.begin() ==
+        std::find(it_first, it_last, 6) - reference.begin()
+    );
+  }
+}
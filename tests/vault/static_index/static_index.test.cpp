@@ -1,5 +1,16 @@
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
 #include <iterator>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 
 #include <catch2/catch_test_macros.hpp>
@@ -18,6 +29,14 @@ namespace {
     }
     return items;
   }
+
+  // Projects the whole hash, so that the fingerprints are not integral and
+  // the index keeps them in a frozen_vector of its own.
+  struct key_128_full {
+    [[nodiscard]] key_128 operator()(auto const&, key_128 const& key) const noexcept {
+      return key;
+    }
+  };
 } // namespace
 
 TEST_CASE("StaticIndex: Basic Functionality", "[static_index]") {
@@ -111,3 +130,345 @@ TEST_CASE("StaticIndex: Permutation Verification", "[static_index][permutation]"
     }
   }
 }
+
+TEST_CASE("StaticIndex: Batched Lookup", "[static_index][batch]") {
+  // Not a multiple of the batch size, so that the last batch is partial.
+  auto items = generate_items(300);
+
+  auto queries = items;
+  for (size_t i = 0; i < 100; ++i) {
+    queries.push_back("missing_" + std::to_string(i));
+  }
+
+  auto check = [&](auto const& index) {
+    auto results = std::vector<std::optional<size_t>>{};
+    index.lookup_many(queries, std::back_inserter(results));
+
+    REQUIRE(results.size() == queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+      REQUIRE(results[i] == index[queries[i]]);
+    }
+    for (size_t i = 0; i < items.size(); ++i) {
+      REQUIRE(results[i].has_value());
+    }
+
+    auto none = std::vector<std::string>{};
+    index.lookup_many(none, std::back_inserter(results));
+    REQUIRE(results.size() == queries.size());
+  };
+
+  SECTION("Integral fingerprints") {
+    static_index_builder builder;
+    builder.add_n(items);
+    check(std::move(builder).build());
+  }
+
+  SECTION("Non-integral fingerprints") {
+    auto builder = static_index_builder<key_128, key_128_full>{};
+    builder.add_n(items);
+    check(std::move(builder).build());
+  }
+}
+
+TEST_CASE("StaticIndex: Build Options", "[static_index][options]") {
+  auto items = generate_items(5000);
+
+  auto options = GENERATE(
+    static_index_build_options{.thread_count = 4},
+    static_index_build_options{.thread_count = 4, .partition_size = 1000},
+    static_index_build_options{.thread_count = 0, .partition_size = 1000}
+  );
+
+  auto check = [&](auto builder) {
+    builder.add_n(items).with_options(options);
+
+    std::vector<size_t> permutation;
+    auto [index, _] = std::move(builder).build(std::back_inserter(permutation));
+
+    REQUIRE(permutation.size() == items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+      auto slot = index[items[i]];
+      REQUIRE(slot.has_value());
+      REQUIRE(*slot == permutation[i]);
+    }
+
+    REQUIRE_FALSE(index["non_existent"].has_value());
+  };
+
+  SECTION("Integral fingerprints") {
+    check(static_index_builder{});
+  }
+
+  SECTION("Non-integral fingerprints") {
+    check(static_index_builder<key_128, key_128_full>{});
+  }
+}
+
+TEST_CASE("StaticIndex: Persistence", "[static_index][file]") {
+  auto items = generate_items(5000);
+  auto path  = std::filesystem::temp_directory_path() / "vault.static_index.test.index";
+
+  SECTION("Slots are the same for the mapped index") {
+    static_index_builder builder;
+    builder.add_n(items);
+
+    std::vector<size_t> permutation;
+    auto [index, _] = std::move(builder).build(std::back_inserter(permutation));
+    index.save(path);
+
+    auto mapped = static_index<>::open_mapped(path);
+    REQUIRE_FALSE(mapped.empty());
+    REQUIRE(mapped.memory_usage_bytes() == index.memory_usage_bytes());
+
+    for (size_t i = 0; i < items.size(); ++i) {
+      auto slot = mapped[items[i]];
+      REQUIRE(slot.has_value());
+      REQUIRE(*slot == permutation[i]);
+    }
+
+    REQUIRE_FALSE(mapped["non_existent"].has_value());
+  }
+
+  SECTION("A partitioned index can be saved") {
+    static_index_builder<std::uint32_t> builder;
+    builder.add_n(items).with_options({.partition_size = 1000});
+
+    auto index = std::move(builder).build();
+    index.save(path);
+
+    auto mapped = static_index<std::uint32_t>::open_mapped(path);
+    for (auto const& item : items) {
+      REQUIRE(mapped[item] == index[item]);
+    }
+  }
+
+  SECTION("The perfect hash alone can be saved") {
+    auto hashes = std::vector<key_128>{};
+    for (auto const& item : items) {
+      hashes.push_back(static_index_base::hash([&](auto visitor) {
+        traits::underlying_byte_sequences<std::string>::visit(item, visitor);
+      }));
+    }
+
+    auto base = static_index_base::build(hashes);
+    base.save(path);
+
+    auto mapped = static_index_base::open_mapped(path);
+    for (auto const& hash : hashes) {
+      REQUIRE(mapped[hash].first == base[hash].first);
+    }
+  }
+
+  SECTION("Empty index") {
+    static_index_base{}.save(path);
+    REQUIRE(static_index_base::open_mapped(path).empty());
+  }
+
+  SECTION("Fingerprint type mismatch throws") {
+    static_index_builder builder;
+    builder.add_n(items);
+    std::move(builder).build().save(path);
+
+    REQUIRE_THROWS_AS(static_index<std::uint32_t>::open_mapped(path), std::runtime_error);
+  }
+
+  SECTION("Bad magic throws") {
+    static_index_base{}.save(path);
+    {
+      auto file = std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+      file.write("NOTINDEX", 8);
+    }
+    REQUIRE_THROWS_AS(static_index_base::open_mapped(path), std::runtime_error);
+  }
+
+  SECTION("A slot count that does not match the perfect hash throws") {
+    static_index_builder<std::uint32_t> builder;
+    builder.add_n(items);
+    std::move(builder).build().save(path);
+
+    // The slot count follows the magic, the version and three tags.
+    {
+      auto const slot_count = std::uint64_t{1};
+      auto       file       = std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+      file.seekp(24);
+      file.write(reinterpret_cast<char const*>(&slot_count), sizeof(slot_count));
+    }
+    REQUIRE_THROWS_AS(static_index<std::uint32_t>::open_mapped(path), std::runtime_error);
+    REQUIRE_THROWS_AS(static_index_base::open_mapped(path), std::runtime_error);
+  }
+
+  SECTION("Missing file throws") {
+    REQUIRE_THROWS_AS(static_index_base::open_mapped(path / "missing"), std::system_error);
+  }
+
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("StaticIndex: Perfect Hash Policies", "[static_index][policy]") {
+  auto items = generate_items(5000);
+
+  auto check = [&](auto builder) {
+    builder.add_n(items);
+
+    std::vector<size_t> permutation;
+    auto [index, _] = std::move(builder).build(std::back_inserter(permutation));
+
+    REQUIRE(index.slot_count() >= items.size());
+    for (size_t i = 0; i < items.size(); ++i) {
+      auto slot = index[items[i]];
+      REQUIRE(slot.has_value());
+      REQUIRE(*slot == permutation[i]);
+      REQUIRE(*slot < index.slot_count());
+    }
+
+    REQUIRE_FALSE(index["non_existent"].has_value());
+  };
+
+  SECTION("Fast policy") {
+    check(static_index_builder<std::size_t, key_128_high, std::equal_to<>, fast_phf_policy>{});
+    check(static_index_builder<key_128, key_128_full, std::equal_to<>, fast_phf_policy>{});
+  }
+
+  SECTION("Small policy") {
+    check(static_index_builder<std::size_t, key_128_high, std::equal_to<>, small_phf_policy>{});
+    check(static_index_builder<key_128, key_128_full, std::equal_to<>, small_phf_policy>{});
+  }
+
+  SECTION("A file is only opened with its own policy") {
+    auto path = std::filesystem::temp_directory_path() / "vault.static_index.test.policy.index";
+
+    static_index_builder<std::size_t, key_128_high, std::equal_to<>, fast_phf_policy> builder;
+    builder.add_n(items);
+
+    auto index = std::move(builder).build();
+    index.save(path);
+
+    using fast_index = static_index<std::size_t, key_128_high, std::equal_to<>, fast_phf_policy>;
+
+    auto mapped = fast_index::open_mapped(path);
+    REQUIRE(mapped.slot_count() == index.slot_count());
+    REQUIRE(mapped[items.front()] == index[items.front()]);
+
+    REQUIRE_THROWS_AS(static_index<>::open_mapped(path), std::runtime_error);
+    std::filesystem::remove(path);
+  }
+}
+
+TEST_CASE("StaticIndex: Packed Fingerprints", "[static_index][packed]") {
+  SECTION("Values of every width round-trip") {
+    auto check = [](auto array_tag) {
+      using array_t  = decltype(array_tag);
+      auto rng       = std::mt19937{42};
+      auto values    = std::vector<std::uint32_t>(1000);
+      std::ranges::generate(values, [&] { return static_cast<std::uint32_t>(rng()); });
+
+      auto const packed = array_t(values);
+      REQUIRE(packed.size() == values.size());
+
+      auto positions = std::vector<std::size_t>{};
+      for (size_t i = 0; i < values.size(); ++i) {
+        positions.push_back((i * 7) % values.size());
+      }
+
+      auto extracted = std::vector<std::uint32_t>(positions.size());
+      packed.extract_many(positions, extracted);
+
+      for (size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(packed[i] == (values[i] & packed_fingerprint<array_t::bits>::mask));
+        REQUIRE(extracted[i] == packed[positions[i]]);
+      }
+    };
+
+    check(packed_fingerprint_array<1>{});
+    check(packed_fingerprint_array<7>{});
+    check(packed_fingerprint_array<12>{});
+    check(packed_fingerprint_array<31>{});
+    check(packed_fingerprint_array<32>{});
+  }
+
+  SECTION("An index with 12-bit fingerprints") {
+    auto items = generate_items(5000);
+
+    static_index_builder<packed_fingerprint<12>> builder;
+    builder.add_n(items);
+
+    std::vector<size_t> permutation;
+    auto [index, _] = std::move(builder).build(std::back_inserter(permutation));
+
+    for (size_t i = 0; i < items.size(); ++i) {
+      auto slot = index[items[i]];
+      REQUIRE(slot.has_value());
+      REQUIRE(*slot == permutation[i]);
+    }
+
+    auto misses = generate_items(20000);
+    for (auto& miss : misses) {
+      miss += "_missing";
+    }
+
+    std::vector<std::optional<size_t>> results;
+    index.lookup_many(misses, std::back_inserter(results));
+
+    auto false_positives = std::ranges::count_if(results, [](auto const& r) { return r.has_value(); });
+    REQUIRE(false_positives < 40); // About 5 expected at 1 in 4096.
+
+    results.clear();
+    index.lookup_many(items, std::back_inserter(results));
+    REQUIRE(std::ranges::equal(results | std::views::transform([](auto r) { return *r; }), permutation));
+  }
+
+  SECTION("An empty index finds nothing") {
+    auto index = static_index_builder<packed_fingerprint<12>>{}.build();
+    REQUIRE(index.empty());
+    REQUIRE_FALSE(index["anything"].has_value());
+
+    std::vector<std::optional<size_t>> results;
+    index.lookup_many(generate_items(3), std::back_inserter(results));
+    REQUIRE(results == std::vector<std::optional<size_t>>(3));
+  }
+}
+
+TEST_CASE("StaticIndex: Contiguous Key Hashing", "[static_index][hash]") {
+  auto channel_hash = [](auto const& key) {
+    return static_index_base::hash([&](concepts::byte_sequence_visitor auto visitor) {
+      traits::underlying_byte_sequences<std::remove_cvref_t<decltype(key)>>::visit(key, visitor);
+    });
+  };
+
+  SECTION("One-shot and streamed hashes agree") {
+    STATIC_REQUIRE(concepts::contiguous_byte_sequence<std::string>);
+    STATIC_REQUIRE(concepts::contiguous_byte_sequence<std::string_view>);
+    STATIC_REQUIRE(concepts::contiguous_byte_sequence<std::uint64_t>);
+    STATIC_REQUIRE_FALSE(concepts::contiguous_byte_sequence<std::vector<std::string>>);
+
+    for (auto const& item : generate_items(100)) {
+      REQUIRE(detail::hash_of(item) == channel_hash(item));
+      REQUIRE(detail::hash_of(std::string_view{item}) == channel_hash(item));
+    }
+
+    for (auto value = std::uint64_t{0}; value < 100; ++value) {
+      REQUIRE(detail::hash_of(value) == channel_hash(value));
+    }
+
+    REQUIRE(detail::hash_of(std::string{}) == channel_hash(std::string{}));
+  }
+
+  SECTION("Keys of several blocks are streamed") {
+    auto keys = std::vector<std::vector<std::string>>{};
+    for (auto i = 0; i < 300; ++i) {
+      keys.push_back({"part_" + std::to_string(i), "rest_" + std::to_string(i)});
+    }
+
+    static_index_builder builder;
+    builder.add_n(keys);
+    auto index = std::move(builder).build();
+
+    for (auto const& key : keys) {
+      REQUIRE(index[key].has_value());
+    }
+    REQUIRE_FALSE(index[std::vector<std::string>{"part_0", "rest_1"}].has_value());
+
+    // The bytes of a key are hashed as one sequence, however they are split.
+    REQUIRE(detail::hash_of(std::vector<std::string>{"ab", "c"}) == detail::hash_of(std::string{"abc"}));
+  }
+}
@@ -2,6 +2,8 @@
 #include <catch2/catch_test_macros.hpp>
 
 #include <algorithm>
+#include <iterator>
+#include <optional>
 #include <random>
 #include <string>
 #include <vector>
@@ -101,5 +103,13 @@ TEST_CASE("StaticIndex: Laptop Cache Hierarchy Analysis", "[benchmark][laptop]")
       }
       return checksum;
     };
+
+    std::vector<std::optional<size_t>> results(query_keys.size());
+
+    BENCHMARK("Batched Lookup DRAM Bound")
+    {
+      index.lookup_many(query_keys, results.begin());
+      return std::ranges::count_if(results, [](auto const& r) { return r.has_value(); });
+    };
   }
 }
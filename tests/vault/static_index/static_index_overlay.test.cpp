@@ -0,0 +1,141 @@
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vault/static_index/static_index_overlay.hpp>
+
+using namespace vault::containers;
+
+namespace {
+  std::vector<std::string> generate_items(std::string const& prefix, size_t n) {
+    std::vector<std::string> items;
+    items.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      items.push_back(prefix + std::to_string(i));
+    }
+    return items;
+  }
+} // namespace
+
+TEST_CASE("StaticIndexOverlay: Updates", "[static_index][overlay]") {
+  auto base_items = generate_items("base_", 2000);
+  auto index      = static_index_overlay<>::build(base_items);
+
+  REQUIRE(index.size() == base_items.size());
+  REQUIRE(index.overlay_size() == 0);
+  REQUIRE(index.tombstone_count() == 0);
+
+  for (auto const& item : base_items) {
+    auto id = index[item];
+    REQUIRE(id.has_value());
+    REQUIRE(*id < index.slot_count());
+  }
+  REQUIRE_FALSE(index[std::string{"missing"}].has_value());
+
+  SECTION("Inserted keys get new ids") {
+    auto added = generate_items("added_", 500);
+
+    for (auto const& item : added) {
+      auto [id, inserted] = index.insert(item);
+      REQUIRE(inserted);
+      REQUIRE(id >= index.slot_count());
+      REQUIRE(index[item] == id);
+    }
+
+    REQUIRE(index.size() == base_items.size() + added.size());
+    REQUIRE(index.overlay_size() == added.size());
+    REQUIRE(index.id_bound() == index.slot_count() + added.size());
+
+    auto [id, inserted] = index.insert(added.front());
+    REQUIRE_FALSE(inserted);
+    REQUIRE(id == index.slot_count());
+
+    REQUIRE_FALSE(index.insert(base_items.front()).second);
+  }
+
+  SECTION("Erased keys are not found") {
+    auto added = generate_items("added_", 100);
+    for (auto const& item : added) {
+      index.insert(item);
+    }
+
+    auto const first_slot = index[base_items[0]];
+
+    for (size_t i = 0; i < 1000; ++i) {
+      REQUIRE(index.erase(base_items[i]));
+    }
+    for (size_t i = 0; i < 50; ++i) {
+      REQUIRE(index.erase(added[i]));
+    }
+
+    REQUIRE_FALSE(index.erase(base_items[0]));
+    REQUIRE_FALSE(index.erase(std::string{"missing"}));
+    REQUIRE(index.tombstone_count() == 1000);
+    REQUIRE(index.overlay_size() == 50);
+
+    for (size_t i = 0; i < base_items.size(); ++i) {
+      REQUIRE(index.contains(base_items[i]) == (i >= 1000));
+    }
+    for (size_t i = 0; i < added.size(); ++i) {
+      REQUIRE(index.contains(added[i]) == (i >= 50));
+    }
+
+    // A key of the base that comes back keeps its slot.
+    auto [id, inserted] = index.insert(base_items[0]);
+    REQUIRE(inserted);
+    REQUIRE(id == first_slot);
+    REQUIRE(index.tombstone_count() == 999);
+  }
+
+  SECTION("Compaction folds the overlay into the perfect hash") {
+    auto added = generate_items("added_", 300);
+    auto ids   = std::vector<size_t>{};
+    for (auto const& item : added) {
+      ids.push_back(index.insert(item).first);
+    }
+    for (size_t i = 0; i < 200; ++i) {
+      index.erase(base_items[i]);
+    }
+
+    auto remap                = std::vector<size_t>(index.id_bound(), static_index_overlay<>::npos);
+    auto [compacted, ignored] = index.compacted(
+      [&](size_t old_id, size_t new_id) { remap[old_id] = new_id; }, {.thread_count = 2}
+    );
+
+    REQUIRE(compacted.size() == index.size());
+    REQUIRE(compacted.overlay_size() == 0);
+    REQUIRE(compacted.tombstone_count() == 0);
+
+    for (size_t i = 0; i < base_items.size(); ++i) {
+      auto old_id = index[base_items[i]];
+      auto new_id = compacted[base_items[i]];
+      REQUIRE(old_id.has_value() == new_id.has_value());
+      if (new_id) {
+        REQUIRE(remap[*old_id] == *new_id);
+      }
+    }
+
+    for (size_t i = 0; i < added.size(); ++i) {
+      REQUIRE(compacted[added[i]] == remap[ids[i]]);
+    }
+  }
+}
+
+TEST_CASE("StaticIndexOverlay: Empty", "[static_index][overlay]") {
+  static_index_overlay<> index;
+
+  REQUIRE(index.empty());
+  REQUIRE_FALSE(index[std::string{"a"}].has_value());
+  REQUIRE_FALSE(index.erase(std::string{"a"}));
+
+  auto [id, inserted] = index.insert(std::string{"a"});
+  REQUIRE(inserted);
+  REQUIRE(id == 0);
+  REQUIRE(index[std::string{"a"}] == 0);
+  REQUIRE(index.size() == 1);
+
+  REQUIRE(index.erase(std::string{"a"}));
+  REQUIRE(index.empty());
+}
@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vault/static_index/static_map.hpp>
+
+using namespace vault::containers;
+
+namespace {
+  std::vector<std::pair<std::string, std::uint32_t>> generate_entries(size_t n) {
+    std::vector<std::pair<std::string, std::uint32_t>> entries;
+    entries.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      entries.emplace_back("key_" + std::to_string(i), static_cast<std::uint32_t>(i * 7));
+    }
+    return entries;
+  }
+} // namespace
+
+TEST_CASE("StaticMap: Lookup", "[static_map]") {
+  auto entries = generate_entries(1000);
+
+  static_map_builder<std::string, std::uint32_t> builder;
+  builder.add_n(entries);
+  auto map = std::move(builder).build();
+
+  REQUIRE(map.size() == entries.size());
+  REQUIRE_FALSE(map.empty());
+  REQUIRE(map.memory_usage_bytes() >= map.slot_count() * sizeof(decltype(map)::slot_type));
+
+  SECTION("Every key finds its value") {
+    for (auto const& [key, value] : entries) {
+      auto const* found = map.find(key);
+      REQUIRE(found != nullptr);
+      REQUIRE(*found == value);
+      REQUIRE(map.contains(std::string_view{key}));
+    }
+  }
+
+  SECTION("Missing keys are not found") {
+    REQUIRE(map.find(std::string{"missing"}) == nullptr);
+    REQUIRE_FALSE(map.contains(std::string{"key_1000"}));
+  }
+
+  SECTION("Batched lookup matches single lookups") {
+    auto keys = std::vector<std::string>{};
+    for (auto const& [key, _] : entries) {
+      keys.push_back(key);
+      keys.push_back(key + "_missing");
+    }
+
+    auto results = std::vector<std::uint32_t const*>{};
+    map.lookup_many(keys, std::back_inserter(results));
+
+    REQUIRE(results.size() == keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+      REQUIRE(results[i] == map.find(keys[i]));
+    }
+  }
+}
+
+TEST_CASE("StaticMap: Build Options", "[static_map][options]") {
+  auto entries = generate_entries(5000);
+
+  static_map_builder<std::string, std::string, std::uint64_t, key_128_high, std::equal_to<>, fast_phf_policy> builder;
+  for (auto const& [key, value] : entries) {
+    builder.add_1(key, std::to_string(value));
+  }
+  builder.with_options({.thread_count = 4, .partition_size = 1000});
+  auto map = std::move(builder).build();
+
+  REQUIRE(map.slot_count() >= map.size());
+  for (auto const& [key, value] : entries) {
+    auto const* found = map.find(key);
+    REQUIRE(found != nullptr);
+    REQUIRE(*found == std::to_string(value));
+  }
+}
+
+TEST_CASE("StaticMap: Empty", "[static_map]") {
+  auto map = static_map_builder<std::string, int>{}.build();
+
+  REQUIRE(map.empty());
+  REQUIRE(map.size() == 0);
+  REQUIRE(map.find(std::string{"anything"}) == nullptr);
+
+  auto results = std::vector<int const*>{};
+  map.lookup_many(std::vector<std::string>{"a", "b"}, std::back_inserter(results));
+  REQUIRE(results == std::vector<int const*>(2, nullptr));
+}
@@ -0,0 +1,89 @@
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vault/static_index/static_string_set.hpp>
+
+using namespace vault::containers;
+
+namespace {
+  std::vector<std::string> generate_items(std::string const& prefix, size_t n) {
+    std::vector<std::string> items;
+    items.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+      items.push_back(prefix + std::to_string(i));
+    }
+    return items;
+  }
+} // namespace
+
+TEST_CASE("StaticStringSet: Lookup", "[static_index][string_set]") {
+  auto items = generate_items("https://example.com/item/", 2000);
+  items.push_back("short");
+  items.push_back("");
+
+  auto set = static_string_set<>::build(items);
+
+  REQUIRE(set.size() == items.size());
+  REQUIRE_FALSE(set.empty());
+
+  SECTION("Every string maps to its own id") {
+    auto seen = std::vector<bool>(set.slot_count());
+    for (auto const& item : items) {
+      auto id = set[item];
+      REQUIRE(id.has_value());
+      REQUIRE(*id < set.slot_count());
+      REQUIRE_FALSE(seen[*id]);
+      seen[*id] = true;
+      REQUIRE(set.value(*id) == item);
+    }
+  }
+
+  SECTION("Membership is exact") {
+    REQUIRE_FALSE(set.contains("https://example.com/item/2000"));
+    REQUIRE_FALSE(set.contains("https://example.com/item/"));
+    REQUIRE_FALSE(set.contains("shor"));
+    REQUIRE_FALSE(set.contains("short!"));
+
+    for (auto const& item : generate_items("https://example.org/item/", 2000)) {
+      REQUIRE_FALSE(set.contains(item));
+    }
+  }
+
+  SECTION("Batched lookup matches single lookups") {
+    auto queries = items;
+    for (auto const& item : generate_items("missing_", 500)) {
+      queries.push_back(item);
+    }
+
+    auto results = std::vector<std::optional<size_t>>{};
+    set.lookup_many(queries, std::back_inserter(results));
+
+    REQUIRE(results.size() == queries.size());
+    for (size_t i = 0; i < queries.size(); ++i) {
+      REQUIRE(results[i] == set[queries[i]]);
+    }
+  }
+
+  SECTION("Non-minimal perfect hash") {
+    auto fast = static_string_set<fast_phf_policy>::build(items, {.thread_count = 2});
+    REQUIRE(fast.slot_count() >= items.size());
+
+    for (auto const& item : items) {
+      REQUIRE(fast.contains(item));
+    }
+    REQUIRE_FALSE(fast.contains(std::string_view{"missing"}));
+  }
+}
+
+TEST_CASE("StaticStringSet: Empty", "[static_index][string_set]") {
+  auto set = static_string_set<>::build(std::vector<std::string>{});
+
+  REQUIRE(set.empty());
+  REQUIRE_FALSE(set.contains("anything"));
+}
@@ -0,0 +1,83 @@
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vault/string_arena/prefix_string.hpp>
+
+using namespace vault::arena;
+
+TEST_CASE("prefix_string keeps short strings inline", "[prefix_string]") {
+  // Lengths around the prefix and the inline capacity.
+  auto const input = std::vector<std::string>{
+    "",
+    "abcd",
+    "abcde",
+    "abcdefghijkl",
+    "abcdefghijklm",
+  };
+  REQUIRE(input[3].size() == prefix_string::inline_capacity);
+
+  for (auto const& value : input) {
+    auto const str = prefix_string{value.data(), value.size()};
+
+    CHECK(str.size() == value.size());
+    CHECK(str.empty() == value.empty());
+    CHECK(std::string_view{str} == value);
+    CHECK(str.is_inline() == (value.size() <= prefix_string::inline_capacity));
+
+    if (str.is_inline()) {
+      // The characters are copied into the string itself.
+      auto const* first = reinterpret_cast<char const*>(&str);
+      CHECK(str.data() >= first);
+      CHECK(str.data() + str.size() <= first + sizeof(prefix_string));
+    } else {
+      CHECK(str.data() == value.data());
+    }
+
+    auto const copy = std::string{value};
+    CHECK(str == prefix_string{copy.data(), copy.size()});
+    CHECK(str.hash() == prefix_string{copy.data(), copy.size()}.hash());
+  }
+
+  CHECK(std::string_view{prefix_string{}}.empty());
+  CHECK(prefix_string{} == prefix_string{input[0].data(), 0});
+}
+
+TEST_CASE("prefix_string compares like its characters", "[prefix_string]") {
+  auto const input = std::vector<std::string>{
+    "",
+    "abcd",
+    "abcde",
+    "abcdefghijkl",
+    "abcdefghijklm",
+    "abcdefghijkln",
+    "abce",
+    std::string{"ab\0d", 4},
+  };
+
+  for (auto const& lhs : input) {
+    for (auto const& rhs : input) {
+      auto const lhs_str = prefix_string{lhs.data(), lhs.size()};
+      auto const rhs_str = prefix_string{rhs.data(), rhs.size()};
+
+      CHECK((lhs_str == rhs_str) == (lhs == rhs));
+      CHECK((lhs_str <=> rhs_str) == (std::string_view{lhs} <=> std::string_view{rhs}));
+    }
+  }
+}
+
+TEST_CASE("to_prefix_arena round-trips its strings", "[prefix_string]") {
+  auto const input = std::vector<std::string>{"", "abcd", "abcdefghijkl", "abcdefghijklm", "abcdefghijklm"};
+
+  auto const [strings, buffer] = to_prefix_arena(input);
+
+  REQUIRE(strings.size() == input.size());
+  for (auto i = std::size_t{0}; i < input.size(); ++i) {
+    CHECK(std::string_view{strings[i]} == input[i]);
+  }
+  CHECK(strings[3] == strings[4]);
+  CHECK(buffer.size() == 2 * (input[3].size() + 1));
+}
@@ -0,0 +1,171 @@
+#include <cstddef>
+#include <random>
+#include <string>
+#include <set>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <vault/executor/thread_executor.hpp>
+#include <vault/string_arena/string_arena.hpp>
+
+using namespace vault::arena;
+
+namespace {
+  // Whether the characters of an indirect string lie in the arena buffer.
+  [[nodiscard]] auto points_into(string const& str, frozen::frozen_vector<char> const& buffer) -> bool {
+    return str.data() >= buffer.data() && str.data() + str.size() <= buffer.data() + buffer.size();
+  }
+} // namespace
+
+TEST_CASE("to_arena on an executor builds the serial arena", "[string_arena][parallel]") {
+  // Enough strings for several blocks, of lengths on both sides of
+  // max_inline_size.
+  auto rng   = std::mt19937_64{7};
+  auto input = std::vector<std::string>{};
+  for (auto i = std::size_t{0}; i < 10'000; ++i) {
+    input.emplace_back(rng() % 40, static_cast<char>('a' + (i % 26)));
+  }
+
+  auto const [serial, serial_buffer] = to_arena(input);
+
+  for (auto const threads : {std::size_t{1}, std::size_t{4}}) {
+    auto const [strings, buffer] = to_arena(input, vault::algorithm::thread_executor{threads});
+
+    REQUIRE(strings.size() == serial.size());
+    REQUIRE(std::string_view{buffer.data(), buffer.size()} == std::string_view{serial_buffer.data(), serial_buffer.size()});
+
+    for (auto i = std::size_t{0}; i < input.size(); ++i) {
+      REQUIRE(std::string_view{strings[i]} == input[i]);
+      REQUIRE(strings[i].is_inline() == serial[i].is_inline());
+      if (!strings[i].is_inline()) {
+        REQUIRE(points_into(strings[i], buffer));
+        REQUIRE(strings[i].data() - buffer.data() == serial[i].data() - serial_buffer.data());
+      }
+    }
+  }
+
+  SECTION("of no strings") {
+    auto const [strings, buffer] = to_arena(std::vector<std::string>{}, vault::algorithm::thread_executor{2});
+
+    CHECK(strings.empty());
+    CHECK(buffer.empty());
+  }
+}
+
+TEST_CASE("to_packed_arena round-trips its strings", "[string_arena][packed]") {
+  SECTION("of no strings") {
+    auto const [strings, buffer] = to_packed_arena(std::vector<std::string>{});
+
+    CHECK(strings.empty());
+    CHECK(buffer.empty());
+  }
+
+  SECTION("of empty and short strings only") {
+    auto const input = std::vector<std::string>{"", "a", "", "fifteen_chars__"};
+
+    auto const [strings, buffer] = to_packed_arena(input);
+
+    REQUIRE(strings.size() == input.size());
+    for (auto i = std::size_t{0}; i < input.size(); ++i) {
+      CHECK(strings[i].is_inline());
+      CHECK(std::string_view{strings[i]} == input[i]);
+    }
+    CHECK(strings[0].empty());
+    CHECK(buffer.empty());
+  }
+
+  SECTION("of overlapping long strings") {
+    auto const input = std::vector<std::string>{
+      "the quick brown fox jumps",
+      "",
+      "fox jumps over the lazy dog",
+      "short",
+      "over the lazy dog and the cat",
+      "quick brown fox jumps",
+      "the quick brown fox jumps",
+    };
+
+    auto const [strings, buffer] = to_packed_arena(input);
+
+    REQUIRE(strings.size() == input.size());
+    for (auto i = std::size_t{0}; i < input.size(); ++i) {
+      CHECK(std::string_view{strings[i]} == input[i]);
+      CHECK(strings[i].is_inline() == (input[i].size() <= max_inline_size));
+      if (!strings[i].is_inline()) {
+        CHECK(points_into(strings[i], buffer));
+      }
+    }
+
+    // Duplicates and contained strings take no bytes of their own, and the
+    // overlaps at the ends are stored once.
+    auto const [plain, plain_buffer] = to_arena(input);
+    CHECK(buffer.size() < plain_buffer.size());
+    CHECK(std::string_view{buffer.data(), buffer.size()} == "the quick brown fox jumps over the lazy dog and the cat");
+  }
+
+  SECTION("through a generator") {
+    auto const [strings, buffer] = to_packed_arena([](chars_sink& sink) {
+      sink(std::string_view{"a string longer than inline"});
+      sink(std::string_view{""});
+      sink(std::string_view{"longer than inline, and more"});
+    });
+
+    REQUIRE(strings.size() == 3);
+    CHECK(std::string_view{strings[0]} == "a string longer than inline");
+    CHECK(strings[1].empty());
+    CHECK(std::string_view{strings[2]} == "longer than inline, and more");
+    CHECK(buffer.size() < strings[0].size() + strings[2].size());
+  }
+}
+
+TEST_CASE("to_interned_arena stores every distinct string once", "[string_arena][interned]") {
+  auto const input = std::vector<std::string>{
+    "a string longer than inline",
+    "short",
+    "another string longer than inline",
+    "a string longer than inline",
+    "short",
+    "",
+    "another string longer than inline",
+    "a string longer than inline",
+  };
+
+  auto const arena = to_interned_arena(input);
+
+  REQUIRE(arena.strings.size() == input.size());
+  for (auto i = std::size_t{0}; i < input.size(); ++i) {
+    CHECK(std::string_view{arena.strings[i]} == input[i]);
+    if (!arena.strings[i].is_inline()) {
+      CHECK(points_into(arena.strings[i], arena.buffer));
+    }
+  }
+
+  // Equal indirect strings share their bytes.
+  CHECK(arena.strings[3].data() == arena.strings[0].data());
+  CHECK(arena.strings[7].data() == arena.strings[0].data());
+  CHECK(arena.strings[6].data() == arena.strings[2].data());
+  CHECK(arena.strings[2].data() != arena.strings[0].data());
+
+  // One null-terminated copy of every distinct indirect string.
+  auto distinct_bytes = std::size_t{0};
+  for (auto const& value : std::set<std::string>{input.begin(), input.end()}) {
+    if (value.size() > max_inline_size) {
+      distinct_bytes += value.size() + 1;
+    }
+  }
+  CHECK(arena.buffer.size() == distinct_bytes);
+  CHECK(arena.indirect_count == 5);
+  CHECK(arena.distinct_indirect_count == 2);
+  CHECK(arena.indirect_bytes > arena.buffer.size());
+
+  SECTION("with dense ids") {
+    auto const numbered = to_interned_arena(input, {.dense_ids = true});
+
+    CHECK(numbered.ids == std::vector<std::size_t>{0, 1, 2, 0, 1, 3, 2, 0});
+    REQUIRE(numbered.distinct.size() == 4);
+    CHECK(std::string_view{numbered.distinct[2]} == input[2]);
+    CHECK(numbered.buffer.size() == distinct_bytes);
+  }
+}
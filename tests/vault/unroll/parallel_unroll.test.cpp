@@ -0,0 +1,136 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <vault/executor/thread_executor.hpp>
+#include <vault/unroll/parallel_unroll.hpp>
+
+namespace {
+
+  // ============================================================================
+  // Recording Executor
+  // ============================================================================
+
+  // Runs inline, and records the chunks it hands out.
+  struct recording_executor {
+    std::vector<std::pair<std::size_t, std::size_t>>* chunks;
+
+    [[nodiscard]] static constexpr auto concurrency() noexcept -> std::size_t {
+      return 1;
+    }
+
+    template <typename F>
+    void operator()(std::size_t count, std::size_t grain, F&& fn) const {
+      vault::algorithm::inline_executor{}(count, grain, [&](std::size_t worker, std::size_t first, std::size_t last) {
+        chunks->emplace_back(first, last);
+        fn(worker, first, last);
+      });
+    }
+  };
+
+} // namespace
+
+// ============================================================================
+// Catch2 Test Cases
+// ============================================================================
+
+TEST_CASE("parallel_unroll_loop visits every integral coordinate exactly once", "[unroll][parallel]") {
+  auto visits = std::vector<std::atomic<int>>(100003);
+
+  vault::parallel_unroll_loop<8>(
+    std::size_t{0}, visits.size(), [&](std::size_t i) { visits[i].fetch_add(1); }, vault::algorithm::thread_executor{4}, 1000);
+
+  REQUIRE(std::ranges::all_of(visits, [](auto const& v) { return v.load() == 1; }));
+}
+
+TEST_CASE("parallel_unroll_loop writes through contiguous iterators", "[unroll][parallel][iterator]") {
+  auto data     = std::vector<std::uint32_t>(50001);
+  auto expected = std::vector<std::uint32_t>(data.size());
+  std::iota(expected.begin(), expected.end(), std::uint32_t{0});
+
+  vault::parallel_unroll_loop<4>(
+    data.begin() + 3,
+    data.end(),
+    [&](auto it) { *it = static_cast<std::uint32_t>(it - data.begin()); },
+    vault::algorithm::thread_executor{4},
+    512);
+
+  REQUIRE(std::equal(data.begin() + 3, data.end(), expected.begin() + 3));
+  REQUIRE(data[0] == 0);
+}
+
+TEST_CASE("parallel_unroll_loop aligns chunks to cache lines and the unroll factor", "[unroll][parallel][chunks]") {
+  auto data   = std::vector<std::uint64_t>(10000);
+  auto chunks = std::vector<std::pair<std::size_t, std::size_t>>{};
+  auto starts = std::vector<std::uint64_t*>{};
+  auto sizes  = std::vector<std::size_t>{};
+
+  // One element past the start of the allocation, which is aligned to 16
+  // bytes, so the range does not start on a cache line boundary.
+  auto const lb = data.data() + 1;
+  auto const ub = data.data() + data.size();
+
+  // The recording executor runs the chunks in order, so a chunk starts where
+  // the number of calls recorded for it is still zero.
+  vault::parallel_unroll_loop<16>(
+    lb,
+    ub,
+    [&](std::uint64_t* p) {
+      if (starts.size() < chunks.size()) {
+        starts.push_back(p);
+        sizes.push_back(0);
+      }
+      ++sizes.back();
+    },
+    recording_executor{&chunks},
+    1000);
+
+  REQUIRE(std::reduce(sizes.begin(), sizes.end()) == data.size() - 1);
+  REQUIRE(starts.front() == lb);
+  REQUIRE(starts.size() > 2);
+
+  for (auto i = std::size_t{1}; i < starts.size(); ++i) {
+    REQUIRE(reinterpret_cast<std::uintptr_t>(starts[i]) % 64 == 0);
+    if (i + 1 < starts.size()) {
+      REQUIRE(sizes[i] % 16 == 0);
+      REQUIRE(sizes[i] >= 1000);
+    }
+  }
+}
+
+TEST_CASE("parallel_unroll_loop passes the worker index to binary bodies", "[unroll][parallel][worker]") {
+  auto const executor = vault::algorithm::thread_executor{4};
+  auto       sums     = std::vector<std::size_t>(executor.concurrency());
+
+  vault::parallel_unroll_loop<8>(
+    std::size_t{0}, std::size_t{100000}, [&](std::size_t worker, std::size_t i) { sums[worker] += i; }, executor, 4096);
+
+  REQUIRE(std::reduce(sums.begin(), sums.end()) == std::size_t{100000} * 99999 / 2);
+}
+
+TEST_CASE("parallel_unroll_loop rethrows the exception of a body", "[unroll][parallel][exception]") {
+  auto const body = [](std::size_t i) {
+    if (i == 7777) {
+      throw std::runtime_error("body failed");
+    }
+  };
+
+  REQUIRE_THROWS_AS(
+    vault::parallel_unroll_loop<8>(std::size_t{0}, std::size_t{100000}, body, vault::algorithm::thread_executor{4}, 1024),
+    std::runtime_error);
+}
+
+TEST_CASE("parallel_unroll_loop processes empty ranges without executing", "[unroll][parallel][edge_case]") {
+  auto executions = std::atomic<int>{0};
+
+  vault::parallel_unroll_loop<8>(std::size_t{10}, std::size_t{10}, [&](std::size_t) { executions++; });
+
+  REQUIRE(executions.load() == 0);
+}
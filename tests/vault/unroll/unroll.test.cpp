@@ -1,5 +1,7 @@
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <numeric>
 #include <vector>
@@ -87,6 +89,20 @@ namespace {
 
   static_assert(test_integral_unroll_compile_time() == 105);
 
+  [[nodiscard]] constexpr auto test_block_unroll_compile_time() -> int {
+    auto sum = int{0};
+
+    vault::unroll_block_loop<8>(int{0}, int{15}, [&](auto block) {
+      for (auto j = std::size_t{0}; j < block.size(); ++j) {
+        sum += block[j];
+      }
+    });
+
+    return sum;
+  }
+
+  static_assert(test_block_unroll_compile_time() == 105);
+
 } // namespace
 
 // ============================================================================
@@ -140,3 +156,80 @@ TEST_CASE("unroll_loop processes empty ranges correctly without executing", "[un
 
   REQUIRE(executions == 0);
 }
+
+TEST_CASE("unroll_prefetch_loop visits every coordinate in order", "[unroll][prefetch]") {
+  auto data    = std::vector<int>(1000);
+  auto visited = std::vector<int>{};
+  std::iota(data.begin(), data.end(), 0);
+
+  vault::unroll_prefetch_loop<8, 64>(data.begin(), data.end(), [&](auto it) { visited.push_back(*it); });
+
+  REQUIRE(visited == data);
+}
+
+TEST_CASE("unroll_prefetch_loop projects only coordinates within bounds", "[unroll][prefetch]") {
+  auto data     = std::vector<int>(100);
+  auto index    = std::vector<std::size_t>(37); // 4x8 main loop, 1x4, 1x1 tail loop.
+  auto sum      = int{0};
+  auto max_seen = std::size_t{0};
+  std::iota(data.begin(), data.end(), 0);
+  for (auto i = std::size_t{0}; i < index.size(); ++i) {
+    index[i] = (i * 7) % data.size();
+  }
+
+  vault::unroll_prefetch_loop<8, 16, 1>(
+    std::size_t{0},
+    index.size(),
+    [&](auto i) { sum += data[index[i]]; },
+    [&](std::size_t i) {
+      max_seen = std::max(max_seen, i);
+      return &data[index.at(i)];
+    });
+
+  auto expected_sum = int{0};
+  for (auto i : index) {
+    expected_sum += data[i];
+  }
+
+  REQUIRE(sum == expected_sum);
+  REQUIRE(max_seen == index.size() - 1);
+}
+
+TEST_CASE("unroll_block_loop passes full blocks and logarithmic tail blocks", "[unroll][block]") {
+  auto sizes  = std::vector<std::size_t>{};
+  auto firsts = std::vector<std::size_t>{};
+
+  vault::unroll_block_loop<8>(std::size_t{3}, std::size_t{26}, [&](auto block) {
+    sizes.push_back(block.size());
+    firsts.push_back(block.first);
+  });
+
+  REQUIRE(sizes == std::vector<std::size_t>{8, 8, 4, 2, 1});
+  REQUIRE(firsts == std::vector<std::size_t>{3, 11, 19, 23, 25});
+}
+
+TEST_CASE("unroll_block_loop prefetches through contiguous iterators", "[unroll][block][prefetch]") {
+  auto data          = std::vector<int>(23, 1);
+  auto expected_data = std::vector<int>(23, 2);
+
+  vault::unroll_block_loop<8, 16>(data.begin(), data.end(), [](auto block) {
+    for (auto j = std::size_t{0}; j < block.size(); ++j) {
+      *block[j] *= 2;
+    }
+  });
+
+  REQUIRE(data == expected_data);
+}
+
+TEST_CASE("unroll_block_loop processes custom affine coordinates", "[unroll][block][custom_coordinate]") {
+  auto iterations = int{0};
+
+  vault::unroll_block_loop<4>(custom_coordinate{10}, custom_coordinate{17}, [&](auto block) {
+    for (auto j = std::size_t{0}; j < block.size(); ++j) {
+      REQUIRE(block[j].value == 10 + iterations);
+      iterations++;
+    }
+  });
+
+  REQUIRE(iterations == 7);
+}